@@ -0,0 +1,289 @@
+/**
+ * @file Benchmark.c
+ * @brief Firmware วัดเวลา hot paths ของ SimpleHAL เป็น CPU cycles (SysTick CNT)
+ * @version 1.0
+ * @date 2026-10-15
+ *
+ * @details
+ * วัดแต่ละ operation ทีละครั้งด้วย SysTick (นับที่ HCLK: 1 tick = 1 cycle)
+ * หักต้นทุนของการอ่านเวลาเอง แล้วพิมพ์ผลเป็นตาราง CSV ทาง USART
+ * เพื่อเทียบผลระหว่าง release ด้วย bench_compare.py
+ *
+ * **รูปแบบ output:**
+ * ```
+ * #BENCH,1.9.0,48000000,31          <- version, SystemCoreClock, overhead (cycles)
+ * #name,size,iters,min,avg,max,bytes_per_s
+ * BENCH,gpio_digitalWrite,1,256,38,39,52,0
+ * ...
+ * #END
+ * ```
+ * - min/avg/max: cycles ต่อครั้ง (หัก overhead แล้ว)
+ * - bytes_per_s: size × SystemCoreClock / avg (0 = ไม่ใช่ throughput)
+ * - บรรทัดที่ขึ้นต้นด้วย '#' เป็นข้อมูลประกอบ parser ข้ามได้
+ *
+ * **การต่อวงจร:**
+ * - USART TX: PD5 (115200 8N1)
+ * - SPI: PC5/PC6/PC7 (ไม่ต้องต่อ device, วัดแค่การส่ง)
+ * - I2C: PC1/PC2 + pull-up (มี device ที่ BENCH_I2C_ADDR จะวัด read จริง
+ *   ไม่มีจะวัดเวลาถึง NACK และพิมพ์หมายเหตุ)
+ * - PC0: ขา output ของ GPIO benchmark
+ *
+ * @note ทุกครั้งที่ได้รับ byte ทาง USART จะวัดใหม่ทั้งชุด
+ * @note Flash benchmark เขียน FLASH_DATA_PAGE (ข้อมูลเดิมใน page นั้นหาย)
+ */
+
+#include "SimpleHAL/SimpleHAL.h"
+#include <string.h>
+
+/* ========== Configuration ========== */
+
+#ifndef BENCH_ITERS
+#define BENCH_ITERS       256     // จำนวนครั้งต่อ operation (สั้น)
+#endif
+
+#ifndef BENCH_ITERS_SLOW
+#define BENCH_ITERS_SLOW  16      // operation ยาว (SPI/I2C buffer, USART)
+#endif
+
+#ifndef BENCH_ITERS_FLASH
+#define BENCH_ITERS_FLASH 4       // จำกัดรอบ erase/write ของ flash
+#endif
+
+#ifndef BENCH_I2C_ADDR
+#define BENCH_I2C_ADDR    0x68    // เช่น MPU6050 / DS3231
+#endif
+
+#define BENCH_GPIO_PIN    PC0
+#define BENCH_BUF_SIZE    256
+
+/* ========== Measurement ========== */
+
+static uint32_t bench_ticks_per_ms;
+static uint32_t bench_overhead = 0;
+
+static uint32_t bench_min, bench_max, bench_sum;
+
+static uint8_t bench_src[BENCH_BUF_SIZE] __attribute__((aligned(4)));
+static uint8_t bench_dst[BENCH_BUF_SIZE] __attribute__((aligned(4)));
+
+/**
+ * @brief เวลาปัจจุบันเป็น cycles (millis × ticks/ms + ticks ใน ms)
+ * @note Get_CurrentMsTicks() อ่านคู่ ms/ticks แบบ atomic ได้ทั้งโหมด 1 ms และ tickless
+ */
+static uint32_t __attribute__((noinline)) Bench_Cycles(void) {
+    uint32_t ticks;
+    uint32_t ms = Get_CurrentMsTicks(&ticks);
+    return ms * bench_ticks_per_ms + ticks;
+}
+
+static void Bench_Begin(void) {
+    bench_min = 0xFFFFFFFFUL;
+    bench_max = 0;
+    bench_sum = 0;
+}
+
+static void Bench_Add(uint32_t cycles) {
+    cycles = cycles > bench_overhead ? cycles - bench_overhead : 0;
+    if (cycles < bench_min) bench_min = cycles;
+    if (cycles > bench_max) bench_max = cycles;
+    bench_sum += cycles;
+}
+
+/**
+ * @brief พิมพ์ผล 1 แถว แล้วรอ USART ส่งหมด (ไม่ให้ TX แทรกการวัดถัดไป)
+ */
+static void Bench_Report(const char* name, uint16_t size, uint16_t iters) {
+    uint32_t avg = (bench_sum + iters / 2) / iters;
+    uint32_t bps = 0;
+
+    if (size > 1 && avg) {
+        bps = (uint32_t)(((uint64_t)size * SystemCoreClock) / avg);
+    }
+
+    SimpleHAL_printf("BENCH,%s,%u,%u,%u,%u,%u,%u\r\n",
+                     name, size, iters, bench_min, avg, bench_max, bps);
+    USART_FlushTx();
+}
+
+/**
+ * @brief วัด stmt ทีละครั้ง iters รอบ
+ */
+#define BENCH_RUN(name, size, iters, stmt)                  \
+    do {                                                    \
+        Bench_Begin();                                      \
+        for (uint16_t bench_i = 0; bench_i < (iters); bench_i++) { \
+            uint32_t bench_t0 = Bench_Cycles();             \
+            stmt;                                           \
+            Bench_Add(Bench_Cycles() - bench_t0);           \
+        }                                                   \
+        Bench_Report(name, size, iters);                    \
+    } while (0)
+
+/**
+ * @brief ต้นทุนของการอ่านเวลาคู่หนึ่ง (ค่าต่ำสุด) ใช้หักออกจากทุกผล
+ */
+static void Bench_Calibrate(void) {
+    uint32_t best = 0xFFFFFFFFUL;
+    for (uint16_t i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = Bench_Cycles();
+        uint32_t dt = Bench_Cycles() - t0;
+        if (dt < best) best = dt;
+    }
+    bench_overhead = best;
+}
+
+/* ========== Benchmarks ========== */
+
+static void Bench_GPIO(void) {
+    volatile uint8_t sink;
+
+    BENCH_RUN("gpio_digitalWrite", 1, BENCH_ITERS, digitalWrite(BENCH_GPIO_PIN, bench_i & 1));
+    BENCH_RUN("gpio_digitalRead", 1, BENCH_ITERS, sink = digitalRead(BENCH_GPIO_PIN));
+    BENCH_RUN("gpio_digitalWriteFast", 1, BENCH_ITERS, digitalWriteFast(BENCH_GPIO_PIN, bench_i & 1));
+    BENCH_RUN("gpio_digitalReadFast", 1, BENCH_ITERS, sink = digitalReadFast(BENCH_GPIO_PIN));
+    (void)sink;
+}
+
+static void Bench_SPI(void) {
+    static const uint16_t sizes[] = {1, 16, 64, 256};
+
+    for (uint8_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        BENCH_RUN("spi_TransferBuffer_8MHz", sizes[i], BENCH_ITERS_SLOW,
+                  SPI_TransferBuffer(bench_src, bench_dst, sizes[i]));
+    }
+}
+
+static void Bench_I2C(void) {
+    static const uint16_t sizes[] = {1, 6, 16};
+    I2C_Status status = I2C_OK;
+
+    for (uint8_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        BENCH_RUN("i2c_ReadRegMulti_400kHz", sizes[i], BENCH_ITERS_SLOW,
+                  status = I2C_ReadRegMulti(BENCH_I2C_ADDR, 0x00, bench_dst, sizes[i]));
+    }
+
+    if (status != I2C_OK) {
+        SimpleHAL_printf("#i2c: no response from 0x%02X (status %u), times are to NACK\r\n",
+                         BENCH_I2C_ADDR, status);
+        USART_FlushTx();
+    }
+}
+
+static void Bench_ADC(void) {
+    volatile uint16_t sink;
+    BENCH_RUN("adc_Read", 1, BENCH_ITERS, sink = ADC_Read(ADC_CH_PA2));
+    (void)sink;
+}
+
+static void Bench_Copy(void) {
+    static const uint16_t sizes[] = {16, 64, 256};
+
+    for (uint8_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        BENCH_RUN("dma_MemCopy", sizes[i], BENCH_ITERS_SLOW,
+                  DMA_MemCopy(bench_dst, bench_src, sizes[i]));
+        BENCH_RUN("memcpy", sizes[i], BENCH_ITERS_SLOW,
+                  memcpy(bench_dst, bench_src, sizes[i]));
+    }
+}
+
+static void Bench_Flash(void) {
+    static const uint16_t sizes[] = {8, 32, FLASH_PAGE_SIZE};
+
+    BENCH_RUN("flash_ErasePage", FLASH_PAGE_SIZE, BENCH_ITERS_FLASH,
+              Flash_ErasePage(FLASH_DATA_PAGE));
+
+    for (uint8_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        // Erase อยู่นอกช่วงวัด (ต้อง erase ก่อนเขียนทุกครั้ง)
+        Bench_Begin();
+        for (uint16_t n = 0; n < BENCH_ITERS_FLASH; n++) {
+            Flash_ErasePage(FLASH_DATA_PAGE);
+            uint32_t t0 = Bench_Cycles();
+            Flash_WriteStruct(FLASH_DATA_ADDR, bench_src, sizes[i]);
+            Bench_Add(Bench_Cycles() - t0);
+        }
+        Bench_Report("flash_WriteStruct", sizes[i], BENCH_ITERS_FLASH);
+    }
+}
+
+static void Bench_USART(void) {
+    // Queue ว่างก่อนทุกครั้ง: วัดต้นทุน CPU ของการส่ง ไม่ใช่เวลาบนสาย
+    Bench_Begin();
+    for (uint16_t n = 0; n < BENCH_ITERS_SLOW; n++) {
+        USART_FlushTx();
+        uint32_t t0 = Bench_Cycles();
+        USART_Print("#0123456789ABC\r\n");
+        Bench_Add(Bench_Cycles() - t0);
+    }
+    USART_FlushTx();
+    Bench_Report("usart_Print", 16, BENCH_ITERS_SLOW);
+}
+
+static void Bench_CRC(void) {
+    static const uint16_t sizes[] = {16, 256};
+    volatile uint32_t sink;
+
+    for (uint8_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        uint16_t n = sizes[i];
+        BENCH_RUN("crc_CRC8_Maxim", n, BENCH_ITERS_SLOW, sink = CRC8_Maxim(bench_src, n));
+        BENCH_RUN("crc_CRC16_CCITT", n, BENCH_ITERS_SLOW, sink = CRC16_CCITT(bench_src, n));
+        BENCH_RUN("crc_CRC16_Modbus", n, BENCH_ITERS_SLOW, sink = CRC16_Modbus(bench_src, n));
+        BENCH_RUN("crc_CRC32", n, BENCH_ITERS_SLOW, sink = CRC32(bench_src, n));
+    }
+    (void)sink;
+}
+
+/**
+ * @brief วัดทั้งชุด
+ */
+static void Bench_RunAll(void) {
+    Bench_Calibrate();
+
+    SimpleHAL_printf("#BENCH,%u.%u.%u,%u,%u\r\n",
+                     SIMPLE_HAL_VERSION_MAJOR, SIMPLE_HAL_VERSION_MINOR, SIMPLE_HAL_VERSION_PATCH,
+                     SystemCoreClock, bench_overhead);
+    SimpleHAL_printf("#name,size,iters,min,avg,max,bytes_per_s\r\n");
+    USART_FlushTx();
+
+    Bench_GPIO();
+    Bench_SPI();
+    Bench_I2C();
+    Bench_ADC();
+    Bench_Copy();
+    Bench_Flash();
+    Bench_USART();
+    Bench_CRC();
+
+    SimpleHAL_printf("#END\r\n");
+    USART_FlushTx();
+}
+
+int main(void) {
+    SystemCoreClockUpdate();
+    Timer_Init();
+    bench_ticks_per_ms = Get_TicksPerMs();
+
+    USART_SimpleInit(BAUD_115200, USART_PINS_DEFAULT);
+    Printf_SetOutput(Printf_OutputUSART);
+
+    pinMode(BENCH_GPIO_PIN, PIN_MODE_OUTPUT);
+    SPI_SimpleInit(SPI_MODE0, SPI_8MHZ, SPI_PINS_DEFAULT_NO_CS);
+    I2C_SimpleInit(I2C_400KHZ, I2C_PINS_DEFAULT);
+
+    ADC_Channel adc_channel = ADC_CH_PA2;
+    ADC_SimpleInitChannels(&adc_channel, 1);
+
+    Flash_Init();
+
+    for (uint16_t i = 0; i < BENCH_BUF_SIZE; i++) {
+        bench_src[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    Bench_RunAll();
+
+    while (1) {
+        if (USART_Available()) {
+            while (USART_Available()) USART_Read();
+            Bench_RunAll();
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""
+เทียบผล Benchmark.c สองชุด (log จาก USART) แล้วแสดงความต่างของ cycles
+
+ใช้งาน:
+    python3 bench_compare.py old.log new.log [--metric min|avg|max] [--threshold 5]
+
+    # เก็บ log: ต่อ USART แล้วบันทึกจนเจอ #END
+    python3 bench_compare.py --capture /dev/ttyUSB0 new.log
+
+exit code 1 ถ้ามีแถวที่ช้าลงเกิน threshold (%) ใช้ใน CI ได้
+"""
+
+import argparse
+import sys
+
+COLUMNS = ("min", "avg", "max")
+
+
+def parse(path):
+    """คืน (header, {(name, size): {"min", "avg", "max", "bps"}})"""
+    header = None
+    rows = {}
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("#BENCH,"):
+                header = line[1:]
+                rows.clear()   # เก็บเฉพาะชุดล่าสุดใน log
+                continue
+            if not line.startswith("BENCH,"):
+                continue
+            parts = line.split(",")
+            if len(parts) != 8:
+                continue
+            _, name, size, _iters, mn, avg, mx, bps = parts
+            rows[(name, int(size))] = {
+                "min": int(mn), "avg": int(avg), "max": int(mx), "bps": int(bps),
+            }
+    return header, rows
+
+
+def capture(port, out_path, baud):
+    import serial  # pyserial
+
+    with serial.Serial(port, baud, timeout=30) as ser, open(out_path, "w") as out:
+        ser.write(b"r")   # firmware วัดใหม่เมื่อได้รับ byte
+        while True:
+            line = ser.readline().decode("utf-8", errors="replace")
+            if not line:
+                sys.exit("timeout: ไม่ได้รับ #END")
+            out.write(line)
+            print(line, end="")
+            if line.startswith("#END"):
+                return
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("old", help="log ชุดเดิม (หรือ port เมื่อใช้ --capture)")
+    ap.add_argument("new", help="log ชุดใหม่")
+    ap.add_argument("--metric", choices=COLUMNS, default="min")
+    ap.add_argument("--threshold", type=float, default=5.0,
+                    help="%% ที่ถือว่าช้าลง (default 5)")
+    ap.add_argument("--capture", action="store_true",
+                    help="อ่านจาก serial port (old) เขียนลง new")
+    ap.add_argument("--baud", type=int, default=115200)
+    args = ap.parse_args()
+
+    if args.capture:
+        capture(args.old, args.new, args.baud)
+        return 0
+
+    old_header, old = parse(args.old)
+    new_header, new = parse(args.new)
+    print(f"old: {old_header}")
+    print(f"new: {new_header}")
+    print()
+    print(f"{'name':32} {'size':>5} {'old':>9} {'new':>9} {'delta':>8}")
+
+    regressions = 0
+    for key in sorted(set(old) | set(new)):
+        name, size = key
+        a = old.get(key, {}).get(args.metric)
+        b = new.get(key, {}).get(args.metric)
+        if a is None or b is None:
+            print(f"{name:32} {size:5} {a if a is not None else '-':>9} "
+                  f"{b if b is not None else '-':>9} {'':>8}")
+            continue
+
+        delta = (b - a) * 100.0 / a if a else 0.0
+        mark = ""
+        if delta > args.threshold:
+            mark = "  SLOWER"
+            regressions += 1
+        elif delta < -args.threshold:
+            mark = "  faster"
+        print(f"{name:32} {size:5} {a:9} {b:9} {delta:+7.1f}%{mark}")
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -28,12 +28,12 @@ int main(void) {
     }
     
     // ตั้งค่า DMA สำหรับ SPI
-    DMA_SPI_Init(DMA_CH4, DMA_CH5);
+    DMA_SPI_Init(DMA_CH3, DMA_CH2);  // SPI1: TX=CH3, RX=CH2
     
     printf("Transferring %d bytes via SPI+DMA...\r\n", TRANSFER_SIZE);
     
     // ส่งและรับข้อมูล
-    DMA_SPI_TransferBuffer(DMA_CH4, DMA_CH5, tx_data, rx_data, TRANSFER_SIZE);
+    DMA_SPI_TransferBuffer(DMA_CH3, DMA_CH2, tx_data, rx_data, TRANSFER_SIZE);
     
     printf("Transfer complete!\r\n");
     printf("Received data: ");
@@ -53,13 +53,15 @@ int main(void) {
         // คำนวณค่าเฉลี่ย (ใช้ helper function)
         uint16_t average = DMA_analogReadAverage(adc_buffer, BUFFER_SIZE);
         
-        // แปลงเป็น voltage
-        float voltage_latest = ADC_ToVoltage(latest, 3.3);
-        float voltage_avg = ADC_ToVoltage(average, 3.3);
+        // แปลงเป็น voltage แบบ fixed-point (mV) ไม่ใช้ float
+        char v_latest[FORMAT_FIXED_SIZE];
+        char v_avg[FORMAT_FIXED_SIZE];
+        Format_Fixed(v_latest, ((uint32_t)latest * 3300) >> 10, 3);
+        Format_Fixed(v_avg, ((uint32_t)average * 3300) >> 10, 3);
         
         // แสดงผล
-        printf("Latest: %4d (%.3fV)  |  Average: %4d (%.3fV)\r\n", 
-               latest, voltage_latest, average, voltage_avg);
+        printf("Latest: %4d (%sV)  |  Average: %4d (%sV)\r\n", 
+               latest, v_latest, average, v_avg);
         
         Delay_Ms(500);
     }
@@ -0,0 +1,56 @@
+/**
+ * @file 10_USART_DMA_IdleFrame.c
+ * @brief ตัวอย่างการรับ packet ความยาวไม่คงที่ด้วย DMA + USART IDLE interrupt
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * DMA CH5 เขียนข้อมูลลง circular buffer ตลอดเวลา เมื่อสายว่าง 1 character time
+ * USART IDLE interrupt จะส่ง frame (pointer + length) ให้ callback ทันที
+ * ไม่ต้อง poll และไม่มี interrupt ต่อ byte
+ *
+ * ทดสอบ: ส่งข้อความจาก terminal (เช่น "hello") จะได้ความยาว frame และข้อความกลับมา
+ */
+
+#include "SimpleHAL/SimpleHAL.h"
+#include <stdio.h>
+
+#define RX_DMA_SIZE 128
+#define PACKET_MAX  64
+
+static uint8_t rx_dma_buf[RX_DMA_SIZE];
+
+static uint8_t packet[PACKET_MAX];
+static volatile uint16_t packet_len = 0;
+static volatile uint8_t packet_ready = 0;
+
+/**
+ * @brief เรียกจาก interrupt เมื่อได้รับ frame ครบ
+ */
+void on_frame(const USART_Frame_t* frame) {
+    if (packet_ready) return;  // main loop ยังไม่ได้ประมวลผล packet ก่อนหน้า
+
+    // Copy ออกจาก circular buffer (รวมส่วนที่ wrap around)
+    packet_len = USART_FrameCopy(frame, packet, PACKET_MAX);
+    packet_ready = 1;
+}
+
+int main(void) {
+    SystemCoreClockUpdate();
+
+    USART_SimpleInit(BAUD_115200, USART_PINS_DEFAULT);
+
+    printf("\r\n=== USART DMA Idle-line Frames ===\r\n");
+    printf("Send a packet to see its length\r\n\r\n");
+
+    USART_BeginFrameRx(rx_dma_buf, RX_DMA_SIZE, on_frame);
+
+    while (1) {
+        if (packet_ready) {
+            printf("Frame %u bytes: ", packet_len);
+            USART_WriteBytes(packet, packet_len);
+            printf("\r\n");
+            packet_ready = 0;
+        }
+    }
+}
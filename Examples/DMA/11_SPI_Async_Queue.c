@@ -0,0 +1,70 @@
+/**
+ * @file 11_SPI_Async_Queue.c
+ * @brief ตัวอย่างคิว SPI transaction แบบ asynchronous (2 devices ใช้ bus ร่วมกัน)
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * Display (CS=PC3, mode 0, 12 MHz) รับ frame ต่อเนื่องจาก callback
+ * ขณะที่ SPI flash (CS=PC4, mode 3, 8 MHz) ถูกอ่าน JEDEC ID ทุก 1 วินาที
+ * DMA ต่อ transaction จาก interrupt เอง main loop ไม่ต้องรอ bus
+ */
+
+#include "SimpleHAL/SimpleHAL.h"
+#include <stdio.h>
+
+#define FRAME_SIZE 128
+
+static uint8_t frame[FRAME_SIZE];
+static volatile uint32_t frames_sent = 0;
+
+static const uint8_t jedec_cmd[4] = {0x9F, 0xFF, 0xFF, 0xFF};
+static uint8_t jedec_reply[4];
+
+static SPI_Transaction lcd;
+static SPI_Transaction flash;
+
+/**
+ * @brief Frame ส่งเสร็จ: ส่งซ้ำทันที (เรียกจาก DMA interrupt)
+ */
+void lcd_done(SPI_Transaction* t) {
+    frames_sent++;
+    SPI_AsyncSubmit(t);
+}
+
+int main(void) {
+    SystemCoreClockUpdate();
+
+    USART_SimpleInit(BAUD_115200, USART_PINS_DEFAULT);
+    SPI_SimpleInit(SPI_MODE0, SPI_12MHZ, SPI_PINS_DEFAULT_NO_CS);
+    SPI_AsyncInit();
+
+    printf("\r\n=== SPI Async Transaction Queue ===\r\n\r\n");
+
+    for (uint16_t i = 0; i < FRAME_SIZE; i++) {
+        frame[i] = (uint8_t)i;
+    }
+
+    SPI_AsyncSetup(&lcd, PC3, SPI_MODE0, SPI_12MHZ);
+    lcd.tx = frame;
+    lcd.length = FRAME_SIZE;
+    lcd.callback = lcd_done;
+
+    SPI_AsyncSetup(&flash, PC4, SPI_MODE3, SPI_8MHZ);
+    flash.tx = jedec_cmd;
+    flash.rx = jedec_reply;
+    flash.length = sizeof(jedec_reply);
+
+    SPI_AsyncSubmit(&lcd);
+
+    while (1) {
+        Delay_Ms(1000);
+
+        // แทรกเข้าคิวระหว่าง frame ของ display
+        SPI_AsyncSubmit(&flash);
+        SPI_AsyncWait(&flash);
+
+        printf("frames=%lu  JEDEC=%02X %02X %02X\r\n",
+               (unsigned long)frames_sent, jedec_reply[1], jedec_reply[2], jedec_reply[3]);
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file 07_ZeroCross_Dimmer.c
+ * @brief ตัวอย่างตรวจจุดตัดศูนย์ของไฟ AC และยิง triac แบบ phase-angle
+ * @version 1.0
+ * @date 2026-10-15
+ *
+ * @details
+ * ใช้ OPAMP เป็น comparator เทียบสัญญาณ AC (ลดทอนแล้ว) กับ Vcc/2
+ * SimpleZeroCross จับทุกขอบของ comparator ด้วย TIM2 input capture (µs)
+ * แล้วยิง gate pulse ที่ PC0 หลังจุดตัดตามมุมที่ต้องการด้วย timer compare
+ *
+ * **วงจร:**
+ * ```
+ * AC (ผ่านหม้อแปลง/ตัวต้านทานลดทอน + bias Vcc/2) -> PA2 (CHP0)
+ * Vcc/2 (ตัวต้านทานแบ่งแรงดัน 2 ตัว)             -> PA1 (CHN0)
+ * PD4 (OPAMP output = TIM2_CH1)                   -> ปล่อยลอย (ใช้ภายใน)
+ * PC0 (TIM2_CH3)                                  -> opto-triac driver (MOC3021)
+ * PC1                                             -> ปุ่มปรับความสว่าง (ต่อลง GND)
+ * ```
+ *
+ * **การทำงาน:**
+ * - ค่า delay มาก = เปิด triac ช้าในครึ่งคาบ = พลังงานน้อย
+ * - กดปุ่มเพื่อเพิ่มความสว่างทีละ 10% (วนกลับ)
+ */
+
+#include "debug.h"
+#include "SimpleHAL/SimpleZeroCross.h"
+#include "SimpleHAL/SimpleGPIO.h"
+
+#define GATE_PULSE_US  100
+
+static volatile uint32_t crossings = 0;
+
+/**
+ * @brief เรียกทุกจุดตัด (จาก interrupt)
+ */
+static void on_crossing(uint32_t zero_us, uint8_t rising) {
+    (void)zero_us;
+    (void)rising;
+    crossings++;
+}
+
+int main(void) {
+    SystemCoreClockUpdate();
+    Delay_Init();
+
+    USART_Printf_Init(115200);
+    printf("\r\n=== Zero-crossing Dimmer Example ===\r\n");
+
+    pinMode(PC1, PIN_MODE_INPUT_PULLUP);
+
+    ZeroCross_Init(OPAMP_CHP0, OPAMP_CHN0);
+    ZeroCross_AttachCallback(on_crossing);
+
+    uint8_t level = 5;   // 0-10 (x 10%)
+    uint8_t prev_button = 1;
+
+    while (1) {
+        uint8_t button = digitalRead(PC1);
+        if (prev_button && !button) {
+            level = (uint8_t)((level + 1) % 11);
+        }
+        prev_button = button;
+
+        uint32_t period = ZeroCross_GetPeriodUs();
+        if (period) {
+            // ครึ่งคาบ × (100% - level) เผื่อท้ายครึ่งคาบให้ pulse จบก่อนจุดตัดถัดไป
+            uint32_t half = period / 2;
+            uint32_t delay = half * (10 - level) / 10;
+            if (delay + GATE_PULSE_US >= half) delay = half - GATE_PULSE_US - 1;
+
+            ZeroCross_SetFiring((uint16_t)delay, GATE_PULSE_US,
+                                level ? ZEROCROSS_FIRE_BOTH : ZEROCROSS_FIRE_OFF);
+        }
+
+        uint32_t hz = ZeroCross_GetFrequencyHz_x100();
+        printf("Lock:%d  %lu.%02lu Hz  skew:%d us  level:%d0%%  crossings:%lu\r\n",
+               ZeroCross_IsLocked(), hz / 100, hz % 100,
+               ZeroCross_GetSkewUs(), level, crossings);
+
+        Delay_Ms(200);
+    }
+}
@@ -15,7 +15,7 @@
  * Expected Behavior:
  * - LED blinks 3 times at startup
  * - System enters standby mode for 5 seconds
- * - System wakes up and resets (main() restarts)
+ * - System wakes up and continues after PWR_Standby()
  * - LED blinks 3 times again
  * - Cycle repeats indefinitely
  * 
@@ -60,24 +60,25 @@ void main(void)
         Delay_Ms(1000);
     }
     
-    // Enter standby mode for 5 seconds
-    // System will reset after wake-up and main() will restart
-    PWR_Standby(5000);
-    
-    // This point should never be reached
-    while(1);
+    while (1) {
+        // Enter standby mode for 5 seconds
+        // RAM is kept: execution continues here, millis advanced by ~5000 ms
+        PWR_Standby(5000);
+        
+        BlinkLED(3);
+    }
 }
 
 /*
  * Important Notes:
  * 
- * 1. RAM Contents Lost:
- *    - All variables are reset after wake-up
- *    - Use backup registers if you need to preserve data
+ * 1. RAM Contents Kept:
+ *    - Variables keep their values across standby
+ *    - Peripherals are stopped while asleep
  * 
- * 2. System Reset:
- *    - Wake-up from standby causes a system reset
- *    - main() function will restart from the beginning
+ * 2. Timekeeping:
+ *    - SysTick stops in standby; PWR_Standby() advances millis from the AWU window
+ *    - PWR_WasStandbyWakeup() still reports reset causes after a real reset
  * 
  * 3. Power Savings:
  *    - Standby mode: ~5 uA
@@ -86,7 +87,7 @@ void main(void)
  * 
  * 4. Wake-up Time:
  *    - Wake-up takes ~1-2ms
- *    - System clock must be re-initialized
+ *    - System clock (HSE/PLL) is restored by PWR_Standby()
  * 
  * Battery Life Example:
  * - 1000mAh battery
@@ -0,0 +1,90 @@
+/********************************** SimplePWR Example *******************************
+ * Example Name       : 08_BrownoutSave.c
+ * Description        : Keep counters across power loss with SimpleBrownout
+ *                      PVD interrupt writes a RAM snapshot to a pre-erased flash slot
+ **********************************************************************************/
+
+#include "ch32v00x.h"
+#include "SimpleHAL.h"
+
+/*
+ * Hardware Setup:
+ * - Button on PC0 to GND (counts presses)
+ * - LED connected to PD6
+ * - 100-470 uF capacitor on VDD (longer hold-up time after PVD trips)
+ * 
+ * Expected Behavior:
+ * - Each press increments the counter (LED blinks)
+ * - Unplug power: PVD fires, counter is saved without a page erase
+ * - Re-apply power: LED blinks <count> times, counting continues
+ */
+
+#define LED_PIN         PD6
+#define BUTTON_PIN      PC0
+
+typedef struct {
+    uint32_t presses;
+    uint16_t boots;
+} Counters;
+
+static Counters counters;
+
+void BlinkLED(uint32_t times)
+{
+    for (uint32_t i = 0; i < times && i < 20; i++) {
+        digitalWrite(LED_PIN, HIGH);
+        Delay_Ms(150);
+        digitalWrite(LED_PIN, LOW);
+        Delay_Ms(150);
+    }
+}
+
+int main(void)
+{
+    SystemCoreClockUpdate();
+    Timer_Init();
+    
+    pinMode(LED_PIN, PIN_MODE_OUTPUT);
+    pinMode(BUTTON_PIN, PIN_MODE_INPUT_PULLUP);
+    
+    // Restore the snapshot from the last power loss, then arm PVD at 3.1V
+    Brownout_Init(&counters, sizeof(counters), PWR_PVD_3V1);
+    if (Brownout_Restored()) {
+        BlinkLED(counters.presses);
+    }
+    counters.boots++;
+    
+    uint8_t last = HIGH;
+    while(1)
+    {
+        uint8_t now = digitalRead(BUTTON_PIN);
+        if (last == HIGH && now == LOW) {
+            counters.presses++;     // RAM only: no flash write per press
+            digitalWrite(LED_PIN, HIGH);
+            Delay_Ms(50);
+            digitalWrite(LED_PIN, LOW);
+        }
+        last = now;
+        
+        // Supply dipped below 3.1V and recovered without reset: prepare a new slot
+        Brownout_Service();
+        Delay_Ms(10);
+    }
+}
+
+/*
+ * Important Notes:
+ * 
+ * 1. Hold-up Time:
+ *    - Saving programs (size / 2 + 2) half-words, no erase
+ *    - VDD must stay above the flash minimum voltage meanwhile
+ *    - Pick the highest PVD threshold the supply never dips below normally
+ * 
+ * 2. Snapshot Size:
+ *    - Up to SIMPLE_BROWNOUT_MAX_SIZE bytes (default 16)
+ *    - Put everything worth keeping in one struct
+ * 
+ * 3. Flash Wear:
+ *    - One slot per power loss, pages are erased at boot when all slots are used
+ *    - -DSIMPLE_BROWNOUT_PAGE_COUNT=4 spreads erases over more slots
+ */
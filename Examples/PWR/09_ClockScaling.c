@@ -0,0 +1,89 @@
+/********************************** SimplePWR Example *******************************
+ * Example Name       : 09_ClockScaling.c
+ * Description        : Change the system clock at runtime with SimpleSysClock
+ *                      USART, PWM and millis keep their timing at every frequency
+ **********************************************************************************/
+
+#include "ch32v00x.h"
+#include "SimpleHAL.h"
+
+/*
+ * Hardware Setup:
+ * - USB-Serial RX to PD5 (115200 baud)
+ * - LED connected to PD6
+ * - Scope / logic analyzer on PD2 (PWM1_CH1)
+ * 
+ * Expected Behavior:
+ * - Every 2 s the clock steps 48 -> 24 -> 12 -> 8 -> 6 -> 3 MHz and back to 48
+ * - Each step prints the new SystemCoreClock and millis at 115200 baud
+ * - LED blinks at 1 Hz without a hiccup across changes
+ * - PD2 stays at 1 kHz, 25% duty at every frequency
+ */
+
+#define LED_PIN         PD6
+
+static const SysClock_Freq steps[] = {
+    SYSCLK_HSI_48M, SYSCLK_HSI_24M, SYSCLK_HSI_12M,
+    SYSCLK_HSI_8M, SYSCLK_HSI_6M, SYSCLK_HSI_3M
+};
+
+int main(void)
+{
+    SystemCoreClockUpdate();
+    Timer_Init();
+    
+    USART_SimpleInit(BAUD_115200, USART_PINS_DEFAULT);
+    pinMode(LED_PIN, PIN_MODE_OUTPUT);
+    
+    PWM_Init(PWM1_CH1, 1000);
+    PWM_SetDutyCycle(PWM1_CH1, 25);
+    PWM_Start(PWM1_CH1);
+    
+    uint8_t step = 0;
+    uint32_t last_step = Get_CurrentMs();
+    uint32_t last_blink = last_step;
+    
+    while(1)
+    {
+        uint32_t now = Get_CurrentMs();
+        
+        if (ELAPSED_TIME(last_blink, now) >= 500) {
+            last_blink += 500;
+            digitalToggle(LED_PIN);
+        }
+        
+        if (ELAPSED_TIME(last_step, now) >= 2000) {
+            last_step += 2000;
+            step = (step + 1) % (sizeof(steps) / sizeof(steps[0]));
+            
+            // Waits for pending TX, then retimes SysTick, USART and TIM1
+            SimpleHAL_SetSysClock(steps[step]);
+            
+            USART_Print("HCLK = ");
+            USART_PrintNum(SystemCoreClock);
+            USART_Print(" Hz, millis = ");
+            USART_PrintNum(Get_CurrentMs());
+            USART_Print("\r\n");
+        }
+    }
+}
+
+/*
+ * Important Notes:
+ * 
+ * 1. Frequencies:
+ *    - 48 MHz uses the PLL (1 flash wait state), 24-3 MHz divide HSI with HPRE
+ *    - LSI cannot drive SYSCLK: below 3 MHz use PWR_Sleep()/PWR_StandbyTimed()
+ * 
+ * 2. What Follows the Clock:
+ *    - SysTick keeps the partial millisecond, millis/micros never jump
+ *    - USART BRR, I2C timing, SPI prescaler, PWM/TIM prescalers, dead-time,
+ *      soft I2C/SPI delays are recomputed (SIMPLE_SYSCLOCK_RETIME = 1)
+ *    - 1 kHz PWM at 48 MHz has PSC 0 / ATRLR 47999: other clocks rescale the
+ *      period and compare, a 1 MHz timer tick only changes PSC
+ * 
+ * 3. Limits:
+ *    - Call from the main loop, not from an interrupt
+ *    - WS2812, Timestamp, Capture timeout and ADC sample time need a re-init
+ *    - Own modules can follow the clock with SysClock_AddHook()
+ */
@@ -18,6 +18,18 @@
 #include "SimpleHAL.h"
 #include <stdio.h>
 
+/**
+ * @brief อ่าน ADC แล้วแสดงค่า raw และ voltage (integer mV ไม่ใช้ float)
+ */
+static void print_pin(const char* name, uint8_t pin) {
+    uint16_t raw = analogRead(pin);
+    uint32_t cv = ((uint32_t)raw * 330) >> 10;  // 0.01 V (≈ raw * 330 / 1023)
+    
+    char volt[FORMAT_FIXED_SIZE];
+    Format_Fixed(volt, cv, 2);  // 329 -> "3.29"
+    printf("  %s: %4u (%sV)\n", name, raw, volt);
+}
+
 int main(void) {
     NVIC_PriorityGroupConfig(NVIC_PriorityGroup_1);
     SystemCoreClockUpdate();
@@ -34,35 +46,12 @@ int main(void) {
     while(1) {
         printf("ADC Readings:\n");
         
-        // Test PD2 (ADC Channel 3)
-        uint16_t pd2 = analogRead(PD2);
-        float v_pd2 = (pd2 / 1023.0) * 3.3;
-        printf("  PD2: %4u (%.2fV)\n", pd2, v_pd2);
-        
-        // Test PD3 (ADC Channel 4)
-        uint16_t pd3 = analogRead(PD3);
-        float v_pd3 = (pd3 / 1023.0) * 3.3;
-        printf("  PD3: %4u (%.2fV)\n", pd3, v_pd3);
-        
-        // Test PD4 (ADC Channel 7)
-        uint16_t pd4 = analogRead(PD4);
-        float v_pd4 = (pd4 / 1023.0) * 3.3;
-        printf("  PD4: %4u (%.2fV)\n", pd4, v_pd4);
-        
-        // Test PD5 (ADC Channel 5)
-        uint16_t pd5 = analogRead(PD5);
-        float v_pd5 = (pd5 / 1023.0) * 3.3;
-        printf("  PD5: %4u (%.2fV)\n", pd5, v_pd5);
-        
-        // Test PD6 (ADC Channel 6)
-        uint16_t pd6 = analogRead(PD6);
-        float v_pd6 = (pd6 / 1023.0) * 3.3;
-        printf("  PD6: %4u (%.2fV)\n", pd6, v_pd6);
-        
-        // Test PD7 (ADC Channel 0)
-        uint16_t pd7 = analogRead(PD7);
-        float v_pd7 = (pd7 / 1023.0) * 3.3;
-        printf("  PD7: %4u (%.2fV)\n", pd7, v_pd7);
+        print_pin("PD2", PD2);  // ADC Channel 3
+        print_pin("PD3", PD3);  // ADC Channel 4
+        print_pin("PD4", PD4);  // ADC Channel 7
+        print_pin("PD5", PD5);  // ADC Channel 5
+        print_pin("PD6", PD6);  // ADC Channel 6
+        print_pin("PD7", PD7);  // ADC Channel 0
         
         printf("\n");
         
@@ -0,0 +1,55 @@
+/**
+ * @file 01_Trace_ISR_Timing.c
+ * @brief ตัวอย่าง binary trace log จาก timer interrupt
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * ISR บันทึก event ลง RAM ด้วย TRACE1() (ไม่กี่สิบ cycles)
+ * main loop ส่ง record แบบ binary ออก USART ผ่าน Trace_Drain()
+ *
+ * ดูผลบน PC:
+ *   python3 trace_decode.py trace_events.h /dev/ttyUSB0 --baud 115200
+ *
+ * ตัวอย่าง output:
+ *   [     12.345 ms] tick isr enter count=12
+ *   [     12.347 ms] tick isr exit count=12
+ */
+
+#include "SimpleHAL/SimpleHAL.h"
+#include "trace_events.h"
+
+static volatile uint32_t tick_count = 0;
+
+/**
+ * @brief Timer callback (ทำงานใน interrupt)
+ */
+void on_tick(void) {
+    TRACE1(TR_TICK_ENTER, tick_count);
+    tick_count++;
+    TRACE1(TR_TICK_EXIT, tick_count);
+}
+
+int main(void) {
+    SystemCoreClockUpdate();
+    USART_SimpleInit(BAUD_115200, USART_PINS_DEFAULT);
+
+    Trace_Init();
+    TRACE0(TR_BOOT);
+
+    TIM_SimpleInit(TIM_2, 100);  // 100 Hz
+    TIM_AttachInterrupt(TIM_2, on_tick);
+    TIM_Start(TIM_2);
+
+    uint32_t last_ms = Get_CurrentMs();
+
+    while (1) {
+        // ส่งทีละไม่กี่ entries ให้ main loop ไม่ถูกบล็อกนาน
+        Trace_Drain(Printf_OutputUSART, 4);
+
+        if (Get_CurrentMs() - last_ms >= 1000) {
+            last_ms = Get_CurrentMs();
+            TRACE2(TR_LOOP, Trace_Available(), Trace_Overruns());
+        }
+    }
+}
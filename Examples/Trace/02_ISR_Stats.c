@@ -0,0 +1,72 @@
+/**
+ * @file 02_ISR_Stats.c
+ * @brief ตัวอย่างหา handler ที่ทำให้ worst-case response แย่ที่สุด
+ * @version 1.0
+ * @date 2026-10-15
+ *
+ * @details
+ * TIM2 callback ทำงานหนัก (จำลองด้วย Delay_Us) และปุ่มที่ PC1 ทำงานสั้น
+ * ทุก 5 วินาที main loop พิมพ์สถิติของทุก handler แล้วเริ่มช่วงวัดใหม่
+ *
+ * Build ทั้ง project (รวม library) ด้วย:
+ *   -DSIMPLE_ISR_STATS=1
+ *
+ * ดูบน logic analyzer:
+ *   PC3 = HIGH ระหว่าง TIM2_IRQHandler
+ *   PC4 = HIGH ระหว่าง SysTick_Handler
+ *
+ * ตัวอย่าง output:
+ *   ISR        count  lat_max lat_avg exec_max exec_avg  load%
+ *   SysTick     5000       14       9       96       71   0.14
+ *   EXTI           3        0       0      188      180   0.00
+ *   TIM2         500       41      33    24130    24102   5.02
+ *   Worst-case blocker: TIM2 (24130 cycles = 502 us)
+ */
+
+#include "SimpleHAL/SimpleHAL.h"
+
+#if !SIMPLE_ISR_STATS
+#warning "SIMPLE_ISR_STATS = 0: report จะว่าง (build ด้วย -DSIMPLE_ISR_STATS=1)"
+#endif
+
+static volatile uint32_t presses = 0;
+
+/**
+ * @brief Timer callback ที่ใช้เวลานานเกินควร (ใน interrupt)
+ */
+void on_tick(void) {
+    Delay_Us(500);
+}
+
+/**
+ * @brief ปุ่ม (ใน interrupt)
+ */
+void on_button(void) {
+    presses++;
+}
+
+int main(void) {
+    SystemCoreClockUpdate();
+    USART_SimpleInit(BAUD_115200, USART_PINS_DEFAULT);
+
+    ISR_StatSetTracePin(ISR_STAT_TIM2, PC3);
+    ISR_StatSetTracePin(ISR_STAT_SYSTICK, PC4);
+
+    TIM_SimpleInit(TIM_2, 100);  // 100 Hz
+    TIM_AttachInterrupt(TIM_2, on_tick);
+    TIM_Start(TIM_2);
+
+    pinMode(PC1, PIN_MODE_INPUT_PULLUP);
+    attachInterrupt(PC1, on_button, FALLING);
+
+    ISR_StatReset();
+    uint32_t last_ms = Get_CurrentMs();
+
+    while (1) {
+        if (Get_CurrentMs() - last_ms >= 5000) {
+            last_ms = Get_CurrentMs();
+            ISR_StatReport();
+            ISR_StatReset();
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+trace_decode.py - แปลง binary trace ของ SimpleTrace เป็นข้อความ
+
+String table สร้างจาก X(NAME, "format") ใน header ของ application
+(ID = ลำดับในรายการ) แล้ว decode record 16 bytes:
+
+    uint16 id, uint16 ticks, uint32 ms, uint32 arg0, uint32 arg1  (little-endian)
+
+Sync record (id = 0xFFFF, ticks = 0xA55A) ให้ ticks_per_ms และจำนวน event ที่หาย
+
+Usage:
+    python3 trace_decode.py trace_events.h capture.bin
+    python3 trace_decode.py trace_events.h /dev/ttyUSB0 --baud 115200   (ต้องมี pyserial)
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+RECORD = struct.Struct("<HHIII")
+SYNC_ID = 0xFFFF
+SYNC_MAGIC = 0xA55A
+SYNC_BYTES = struct.pack("<HH", SYNC_ID, SYNC_MAGIC)
+
+EVENT_RE = re.compile(r'\bX\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+SPEC_RE = re.compile(r"%[-0 ]*\d*l*([diuxXc%])")
+
+
+def load_table(header_path):
+    """อ่าน X(NAME, "format") ตามลำดับ -> list ของ (name, format)"""
+    with open(header_path, encoding="utf-8") as f:
+        return EVENT_RE.findall(f.read())
+
+
+def to_signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def format_event(fmt, args):
+    """แทน specifier ใน format ด้วย arg0, arg1 ตามลำดับ"""
+    values = iter(args)
+
+    def repl(match):
+        conv = match.group(1)
+        if conv == "%":
+            return "%"
+        spec = match.group(0).replace("l", "")
+        value = next(values, 0)
+        if conv in "di":
+            return spec.replace("i", "d") % to_signed(value)
+        if conv == "c":
+            return chr(value & 0xFF)
+        return spec.replace("u", "d") % value
+
+    return SPEC_RE.sub(repl, fmt)
+
+
+def decode_stream(data_iter, table, out=sys.stdout):
+    buf = b""
+    synced = False
+    ticks_per_ms = 48000
+
+    for chunk in data_iter:
+        buf += chunk
+        while True:
+            if not synced:
+                pos = buf.find(SYNC_BYTES)
+                if pos < 0:
+                    buf = buf[-3:]
+                    break
+                buf = buf[pos:]
+                synced = True
+
+            if len(buf) < RECORD.size:
+                break
+
+            rec, buf = buf[:RECORD.size], buf[RECORD.size:]
+            ev_id, ticks, ms, arg0, arg1 = RECORD.unpack(rec)
+
+            if ev_id == SYNC_ID:
+                if ticks != SYNC_MAGIC:
+                    synced = False  # หลุด alignment: หา sync ใหม่
+                    continue
+                ticks_per_ms = arg0 or ticks_per_ms
+                out.write("--- sync: %u ticks/ms, %u events dropped ---\n" % (ticks_per_ms, arg1))
+                continue
+
+            t_ms = ms + ticks / ticks_per_ms
+            if ev_id < len(table):
+                name, fmt = table[ev_id]
+                text = format_event(fmt, (arg0, arg1))
+            else:
+                text = "unknown id %u args=0x%08X 0x%08X" % (ev_id, arg0, arg1)
+            out.write("[%12.3f ms] %s\n" % (t_ms, text))
+        out.flush()
+
+
+def file_chunks(path):
+    with open(path, "rb") as f:
+        while True:
+            chunk = f.read(4096)
+            if not chunk:
+                return
+            yield chunk
+
+
+def serial_chunks(port, baud):
+    import serial  # pyserial
+
+    with serial.Serial(port, baud, timeout=0.1) as ser:
+        while True:
+            chunk = ser.read(256)
+            if chunk:
+                yield chunk
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode SimpleTrace binary logs")
+    parser.add_argument("header", help="header ที่มี X(NAME, \"format\") entries")
+    parser.add_argument("source", help="ไฟล์ capture หรือ serial port")
+    parser.add_argument("--baud", type=int, default=0, help="อ่านจาก serial port ที่ baud นี้")
+    args = parser.parse_args()
+
+    table = load_table(args.header)
+    chunks = serial_chunks(args.source, args.baud) if args.baud else file_chunks(args.source)
+
+    try:
+        decode_stream(chunks, table)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
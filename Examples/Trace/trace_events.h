@@ -0,0 +1,24 @@
+/**
+ * @file trace_events.h
+ * @brief รายการ trace event ของตัวอย่าง (trace_decode.py อ่านไฟล์นี้เป็น string table)
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @note ID = ลำดับในรายการ (เริ่มที่ 0) เพิ่ม event ใหม่ต่อท้ายเพื่อให้ log เก่ายัง decode ได้
+ * @note Format ใช้ %u %d %x ได้สูงสุด 2 ตัว (arg0, arg1)
+ */
+
+#ifndef __TRACE_EVENTS_H
+#define __TRACE_EVENTS_H
+
+#include "SimpleHAL/SimpleTrace.h"
+
+#define TRACE_EVENTS(X) \
+    X(TR_BOOT,       "boot") \
+    X(TR_TICK_ENTER, "tick isr enter count=%u") \
+    X(TR_TICK_EXIT,  "tick isr exit count=%u") \
+    X(TR_LOOP,       "main loop pending=%u overruns=%u")
+
+TRACE_DEFINE_IDS(TRACE_EVENTS)
+
+#endif  // __TRACE_EVENTS_H
@@ -18,6 +18,29 @@
 #define DEBUG_DATA0_ADDRESS ((volatile uint32_t *)0xE00000F4) // ที่อยู่ debug data0
 #define DEBUG_DATA1_ADDRESS ((volatile uint32_t *)0xE00000F8) // ที่อยู่ debug data1
 
+#if (SDI_PRINT == SDI_PR_OPEN) && (SDI_PRINT_BUFFER_SIZE > 0)
+#define SDI_BUFFER_MASK (SDI_PRINT_BUFFER_SIZE - 1)
+
+static uint8_t sdi_buffer[SDI_PRINT_BUFFER_SIZE];
+static volatile uint16_t sdi_head = 0;   // เขียนโดย _write (ทุก context)
+static volatile uint16_t sdi_tail = 0;   // เขียนโดย SDI_Printf_Flush (และ overwrite)
+static volatile uint32_t sdi_dropped = 0;
+static Timer_TickHook_t sdi_flush_hook;  // ระบาย buffer จาก SysTick
+
+/* ปิด IRQ และจำสถานะเดิม (_write เรียกจาก ISR ได้) */
+static inline uint32_t sdi_irq_save(void) {
+  uint32_t mstatus;
+  __asm volatile("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+  return mstatus;
+}
+
+static inline void sdi_irq_restore(uint32_t mstatus) {
+  if (mstatus & 0x8) {
+    __asm volatile("csrsi mstatus, 0x8");
+  }
+}
+#endif
+
 /*********************************************************************
  * @fn      USART_Printf_Init
  *
@@ -98,6 +121,81 @@ void USART_Printf_Init(uint32_t baudrate) {
 void SDI_Printf_Enable(void) {
   *(DEBUG_DATA0_ADDRESS) = 0;
   Delay_Ms(1);
+#if (SDI_PRINT == SDI_PR_OPEN) && (SDI_PRINT_BUFFER_SIZE > 0)
+  Timer_AddTickHook(&sdi_flush_hook, SDI_PRINT_FLUSH_MS, SDI_Printf_Flush);
+#endif
+}
+
+/*********************************************************************
+ * @fn      SDI_Printf_Flush
+ *
+ * @brief   Send buffered SDI printf data while the probe is ready.
+ *          Never waits: returns as soon as the probe has not yet read
+ *          the previous packet (or no probe is attached).
+ *
+ * @note    _write() calls this after each printf and SDI_Printf_Enable()
+ *          registers it as a SysTick hook (every SDI_PRINT_FLUSH_MS), so
+ *          the remaining tail drains without further printf calls.
+ *
+ * @return  None
+ */
+void SDI_Printf_Flush(void) {
+#if (SDI_PRINT == SDI_PR_OPEN) && (SDI_PRINT_BUFFER_SIZE > 0)
+  // data0 = 0 แปลว่า probe อ่าน packet ก่อนหน้าไปแล้ว
+  // ถือ IRQ ตลอด packet เพื่อให้เรียกซ้อนจาก ISR (ผ่าน _write) ได้
+  while (1) {
+    uint8_t b[7] = {0};
+    uint32_t mstatus = sdi_irq_save();
+    uint16_t count = (uint16_t)(sdi_head - sdi_tail);
+
+    if (count == 0 || *(DEBUG_DATA0_ADDRESS) != 0u) {
+      sdi_irq_restore(mstatus);
+      break;
+    }
+    if (count > 7) {
+      count = 7;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+      b[i] = sdi_buffer[(sdi_tail + i) & SDI_BUFFER_MASK];
+    }
+    sdi_tail += count;
+
+    *(DEBUG_DATA1_ADDRESS) = b[3] | (b[4] << 8) | (b[5] << 16) | (b[6] << 24);
+    *(DEBUG_DATA0_ADDRESS) = count | (b[0] << 8) | (b[1] << 16) | (b[2] << 24);
+    sdi_irq_restore(mstatus);
+  }
+#endif
+}
+
+/*********************************************************************
+ * @fn      SDI_Printf_Pending
+ *
+ * @brief   Number of bytes waiting in the SDI buffer.
+ *
+ * @return  Pending byte count (0 when unbuffered)
+ */
+uint16_t SDI_Printf_Pending(void) {
+#if (SDI_PRINT == SDI_PR_OPEN) && (SDI_PRINT_BUFFER_SIZE > 0)
+  return (uint16_t)(sdi_head - sdi_tail);
+#else
+  return 0;
+#endif
+}
+
+/*********************************************************************
+ * @fn      SDI_Printf_Dropped
+ *
+ * @brief   Number of bytes lost because the SDI buffer was full.
+ *
+ * @return  Dropped byte count (new bytes for SDI_OVERFLOW_DROP,
+ *          oldest bytes for SDI_OVERFLOW_OVERWRITE)
+ */
+uint32_t SDI_Printf_Dropped(void) {
+#if (SDI_PRINT == SDI_PR_OPEN) && (SDI_PRINT_BUFFER_SIZE > 0)
+  return sdi_dropped;
+#else
+  return 0;
+#endif
 }
 
 /*********************************************************************
@@ -114,7 +212,30 @@ __attribute__((used)) int _write(int fd, char *buf, int size) {
   int i = 0;
   int writeSize = size;
 
-#if (SDI_PRINT == SDI_PR_OPEN)
+#if (SDI_PRINT == SDI_PR_OPEN) && (SDI_PRINT_BUFFER_SIZE > 0)
+  // copy ลง ring buffer เท่านั้น การส่งจริงอยู่ใน SDI_Printf_Flush()
+  uint32_t mstatus = sdi_irq_save();
+
+  for (i = 0; i < size; i++) {
+    if ((uint16_t)(sdi_head - sdi_tail) >= SDI_PRINT_BUFFER_SIZE) {
+#if (SDI_PRINT_OVERFLOW == SDI_OVERFLOW_OVERWRITE)
+      sdi_tail++;
+      sdi_dropped++;
+#else
+      sdi_dropped += (uint32_t)(size - i);
+      break;
+#endif
+    }
+    sdi_buffer[sdi_head & SDI_BUFFER_MASK] = (uint8_t)buf[i];
+    sdi_head++;
+  }
+
+  sdi_irq_restore(mstatus);
+  SDI_Printf_Flush(); // ส่งเท่าที่ probe พร้อมรับ ไม่รอ
+  (void)writeSize;
+  return size;
+
+#elif (SDI_PRINT == SDI_PR_OPEN)
   do {
 
     /**
@@ -39,8 +39,39 @@ extern "C" {
 #define SDI_PRINT SDI_PR_OPEN
 #endif
 
+/* SDI Buffer Definition
+ * printf ลง RAM ring buffer แล้วส่งทีละ packet ใน SDI_Printf_Flush()
+ * (main loop หรือ timer tick) ไม่ต้องรอ probe ขณะ printf
+ * 0 = เขียนตรงและรอ probe ทุก 7 bytes แบบเดิม
+ */
+#ifndef SDI_PRINT_BUFFER_SIZE
+#define SDI_PRINT_BUFFER_SIZE 128 // ต้องเป็นเลขยกกำลัง 2
+#endif
+
+#if (SDI_PRINT_BUFFER_SIZE & (SDI_PRINT_BUFFER_SIZE - 1)) != 0
+#error "SDI_PRINT_BUFFER_SIZE must be a power of 2"
+#endif
+
+/* SDI Overflow Policy (เมื่อ buffer เต็ม) */
+#define SDI_OVERFLOW_DROP 0      // ทิ้งข้อความใหม่
+#define SDI_OVERFLOW_OVERWRITE 1 // เขียนทับข้อความเก่าสุด
+
+#ifndef SDI_PRINT_OVERFLOW
+#define SDI_PRINT_OVERFLOW SDI_OVERFLOW_DROP
+#endif
+
+/* SDI Flush Interval: SDI_Printf_Enable() ลงทะเบียน tick hook
+ * ระบาย ring buffer ทุก SDI_PRINT_FLUSH_MS (ms) แม้ไม่มี printf ตามมา
+ */
+#ifndef SDI_PRINT_FLUSH_MS
+#define SDI_PRINT_FLUSH_MS 1
+#endif
+
 void USART_Printf_Init(uint32_t baudrate);
 void SDI_Printf_Enable(void);
+void SDI_Printf_Flush(void);
+uint16_t SDI_Printf_Pending(void);
+uint32_t SDI_Printf_Dropped(void);
 
 #ifdef __cplusplus
 }
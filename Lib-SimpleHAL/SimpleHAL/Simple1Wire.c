@@ -1,23 +1,155 @@
 /**
  * @file Simple1Wire.c
  * @brief Simple 1-Wire Protocol Library Implementation
- * @version 1.0
- * @date 2025-12-22
+ * @version 1.3
+ * @date 2026-10-15
  */
 
 #include "Simple1Wire.h"
+#include "SimpleCRC.h"
 #include <string.h>
 
+#if SIMPLE_1WIRE_USART
+#include "SimpleClock.h"
+#include "SimpleDMA.h"
+
+/* ========== Private Definitions ========== */
+
+#define ONEWIRE_USART_TX_DMA   DMA_CH4   // USART1_TX (fixed request mapping)
+#define ONEWIRE_USART_RX_DMA   DMA_CH5   // USART1_RX
+#define ONEWIRE_SLOT_RESET     0xF0      // 9600 baud: ต่ำ 520 µs แล้วฟัง presence
+#define ONEWIRE_SLOT_ONE       0xFF      // 115200 baud: ต่ำ 8.7 µs (write 1 / read)
+#define ONEWIRE_SLOT_ZERO      0x00      // 115200 baud: ต่ำ 78 µs (write 0)
+#endif
+
+#if SIMPLE_1WIRE_ASYNC
+#include "SimpleTIM.h"
+
+#define ONEWIRE_ASYNC_TIMx  ((SIMPLE_1WIRE_ASYNC_TIMER == TIM_1) ? TIM1 : TIM2)
+#define ONEWIRE_ASYNC_CCR   (&ONEWIRE_ASYNC_TIMx->CH1CVR + (SIMPLE_1WIRE_ASYNC_CHANNEL - 1))
+#define ONEWIRE_ASYNC_MIN   2  // compare ขั้นต่ำจาก counter ปัจจุบัน (µs) ไม่ให้หลุดรอบ 16-bit
+
+// งานของ async engine
+enum {
+    ONEWIRE_OP_RESET = 0,
+    ONEWIRE_OP_WRITE,
+    ONEWIRE_OP_READ,
+    ONEWIRE_OP_SEARCH
+};
+
+// ขั้นถัดไปของ slot ที่กำลังทำ (compare interrupt ครั้งหน้า)
+enum {
+    ONEWIRE_STEP_SLOT_END = 0,      // slot จบแล้ว -> เริ่ม slot ถัดไป
+    ONEWIRE_STEP_RESET_RELEASE,     // ปล่อยสายหลัง reset pulse 480 µs
+    ONEWIRE_STEP_RESET_SAMPLE,      // อ่าน presence
+    ONEWIRE_STEP_WRITE0_RELEASE     // ปล่อยสายหลัง write 0 low 60 µs
+};
+
+// ลำดับของงาน (reset / search)
+enum {
+    ONEWIRE_PHASE_START = 0,
+    ONEWIRE_PHASE_PRESENCE,
+    ONEWIRE_PHASE_COMMAND,
+    ONEWIRE_PHASE_ID_BIT,
+    ONEWIRE_PHASE_CMP_BIT,
+    ONEWIRE_PHASE_DIRECTION,
+    ONEWIRE_PHASE_DONE
+};
+#endif
+
+/* ========== Private Types ========== */
+
+/**
+ * @brief ตำแหน่งระหว่าง ROM search (ใช้ร่วมกันทั้ง blocking และ async)
+ */
+typedef struct {
+    uint8_t id_bit_number;
+    uint8_t last_zero;
+    uint8_t rom_byte_number;
+    uint8_t rom_byte_mask;
+} OneWire_SearchState;
+
+#if SIMPLE_1WIRE_ASYNC
+/**
+ * @brief สถานะของ async engine (ทีละ 1 งานทุก bus)
+ */
+typedef struct {
+    OneWire_Bus* bus;
+    OneWire_AsyncCallback callback;
+    const uint8_t* tx;              // ข้อมูลที่กำลังเขียน
+    uint8_t* rx;                    // buffer ที่กำลังอ่าน
+    OneWire_SearchState search;
+    uint8_t op;                     // ONEWIRE_OP_*
+    uint8_t phase;                  // ONEWIRE_PHASE_*
+    uint8_t step;                   // ONEWIRE_STEP_*
+    uint8_t len;                    // bytes ที่เหลือ
+    uint8_t bit;                    // ตำแหน่ง bit ใน byte ปัจจุบัน
+    uint8_t data;                   // byte ที่กำลังอ่าน
+    uint8_t id_bit;                 // search: bit และ complement ที่อ่านได้
+    uint8_t cmp_id_bit;
+    uint8_t command;                // search: 0xF0 / 0xEC
+    bool result;                    // presence / ผลของ search
+    bool timer_on;
+    volatile bool active;
+} OneWire_AsyncState;
+#endif
+
 /* ========== Private Variables ========== */
 
 static OneWire_Bus onewire_buses[ONEWIRE_MAX_BUSES];
 static uint8_t onewire_bus_count = 0;
 
+#if SIMPLE_1WIRE_USART
+static OneWire_Bus* onewire_usart_bus = NULL;  // bus ที่ถือ USART1 อยู่
+static uint16_t onewire_clocks = 0;
+static uint16_t onewire_brr_data = 0;          // BRR ที่ 115200 baud
+static uint16_t onewire_brr_od = 0;            // BRR ที่ 1 Mbaud (overdrive slot)
+static uint8_t onewire_slots[SIMPLE_1WIRE_USART_CHUNK * 8];  // TX slots และ RX echo ใช้ buffer เดียวกัน
+#endif
+
+#if SIMPLE_1WIRE_ASYNC
+static OneWire_AsyncState onewire_async;
+#endif
+
+// Bus table + USART slot buffer + async engine (SimpleHAL_RamReport())
+const uint16_t onewire_ram_bytes = sizeof(onewire_buses)
+#if SIMPLE_1WIRE_USART
+    + sizeof(onewire_slots)
+#endif
+#if SIMPLE_1WIRE_ASYNC
+    + sizeof(onewire_async)
+#endif
+    ;
+
 /* ========== Private Function Prototypes ========== */
 
 static bool OneWire_SearchInternal(OneWire_Bus* bus, uint8_t command);
+static uint8_t OneWire_SearchDirection(OneWire_Bus* bus, OneWire_SearchState* s,
+                                       uint8_t id_bit, uint8_t cmp_id_bit);
+static bool OneWire_SearchFinish(OneWire_Bus* bus, const OneWire_SearchState* s);
+static void OneWire_SetSpeed(OneWire_Bus* bus, bool overdrive);
+static bool OneWire_OdReset(OneWire_Bus* bus);
+static void OneWire_OdWriteBit(OneWire_Bus* bus, uint8_t bit);
+static uint8_t OneWire_OdReadBit(OneWire_Bus* bus);
 static void OneWire_DisableInterrupts(void);
 static void OneWire_EnableInterrupts(void);
+#if SIMPLE_1WIRE_USART
+static void OneWire_UsartInit(uint8_t pin);
+static uint8_t OneWire_UsartClaimDma(void);
+static uint8_t OneWire_UsartSlot(uint8_t slot);
+static void OneWire_UsartTransfer(const uint8_t* tx, uint8_t* rx, uint8_t len);
+#endif
+#if SIMPLE_1WIRE_ASYNC
+static bool OneWire_AsyncBegin(OneWire_Bus* bus, uint8_t op, OneWire_AsyncCallback callback);
+static void OneWire_AsyncStart(OneWire_AsyncState* a);
+static void OneWire_AsyncSchedule(uint16_t delay_us);
+static void OneWire_AsyncSlotReset(OneWire_AsyncState* a);
+static void OneWire_AsyncSlotWrite(OneWire_AsyncState* a, uint8_t bit);
+static uint8_t OneWire_AsyncSlotRead(OneWire_AsyncState* a);
+static void OneWire_AsyncIsr(void* context, uint16_t value);
+static void OneWire_AsyncNext(OneWire_AsyncState* a);
+static void OneWire_AsyncFinish(OneWire_AsyncState* a, bool result);
+#endif
 
 /* ========== Initialization ========== */
 
@@ -45,6 +177,16 @@ OneWire_Bus* OneWire_Init(uint8_t pin) {
     bus->pin = pin;
     bus->initialized = true;
     
+#if SIMPLE_1WIRE_USART
+    // PD5/PD6 เป็น USART1 TX ได้: ใช้ hardware สร้าง slot (bus แรกเท่านั้น)
+    if ((pin == PD5 || pin == PD6) && !onewire_usart_bus && OneWire_UsartClaimDma()) {
+        bus->backend = ONEWIRE_BACKEND_USART;
+        onewire_usart_bus = bus;
+        OneWire_UsartInit(pin);
+        return bus;
+    }
+#endif
+    
     // ตั้งค่า GPIO เป็น input (pull-up ภายนอก)
     pinMode(pin, PIN_MODE_INPUT);
     
@@ -59,6 +201,25 @@ OneWire_Bus* OneWire_Init(uint8_t pin) {
 bool OneWire_Reset(OneWire_Bus* bus) {
     if (!bus || !bus->initialized) return false;
     
+#if SIMPLE_1WIRE_USART
+    if (bus->backend == ONEWIRE_BACKEND_USART) {
+        // Reset slot ที่ 9600 baud (115200 / 12) หรือ 76800 (overdrive) แล้วกลับไป slot baud
+        uint16_t slot_brr = bus->overdrive ? onewire_brr_od : onewire_brr_data;
+        while (!(USART1->STATR & USART_FLAG_TC));
+        USART1->BRR = bus->overdrive ? onewire_brr_data * 3 / 2 : onewire_brr_data * 12;
+        uint8_t echo = OneWire_UsartSlot(ONEWIRE_SLOT_RESET);
+        while (!(USART1->STATR & USART_FLAG_TC));
+        USART1->BRR = slot_brr;
+        
+        // Device ดึงสายลงระหว่าง bit 4-7 -> echo ไม่ตรงกับที่ส่ง
+        return (echo != ONEWIRE_SLOT_RESET);
+    }
+#endif
+    
+    if (bus->overdrive) {
+        return OneWire_OdReset(bus);
+    }
+    
     bool presence;
     
     OneWire_DisableInterrupts();
@@ -89,6 +250,18 @@ bool OneWire_Reset(OneWire_Bus* bus) {
 void OneWire_WriteBit(OneWire_Bus* bus, uint8_t bit) {
     if (!bus || !bus->initialized) return;
     
+#if SIMPLE_1WIRE_USART
+    if (bus->backend == ONEWIRE_BACKEND_USART) {
+        OneWire_UsartSlot((bit & 1) ? ONEWIRE_SLOT_ONE : ONEWIRE_SLOT_ZERO);
+        return;
+    }
+#endif
+    
+    if (bus->overdrive) {
+        OneWire_OdWriteBit(bus, bit);
+        return;
+    }
+    
     OneWire_DisableInterrupts();
     
     if (bit & 1) {
@@ -119,6 +292,17 @@ void OneWire_WriteBit(OneWire_Bus* bus, uint8_t bit) {
 uint8_t OneWire_ReadBit(OneWire_Bus* bus) {
     if (!bus || !bus->initialized) return 0;
     
+#if SIMPLE_1WIRE_USART
+    if (bus->backend == ONEWIRE_BACKEND_USART) {
+        // Device ส่ง 0 โดยดึงสายค้างไว้ -> echo ไม่ใช่ 0xFF
+        return (OneWire_UsartSlot(ONEWIRE_SLOT_ONE) == ONEWIRE_SLOT_ONE);
+    }
+#endif
+    
+    if (bus->overdrive) {
+        return OneWire_OdReadBit(bus);
+    }
+    
     uint8_t bit;
     
     OneWire_DisableInterrupts();
@@ -149,6 +333,13 @@ uint8_t OneWire_ReadBit(OneWire_Bus* bus) {
 void OneWire_WriteByte(OneWire_Bus* bus, uint8_t data) {
     if (!bus || !bus->initialized) return;
     
+#if SIMPLE_1WIRE_USART
+    if (bus->backend == ONEWIRE_BACKEND_USART) {
+        OneWire_UsartTransfer(&data, NULL, 1);
+        return;
+    }
+#endif
+    
     // เขียนทีละ bit (LSB first)
     for (uint8_t i = 0; i < 8; i++) {
         OneWire_WriteBit(bus, data & 0x01);
@@ -164,6 +355,13 @@ uint8_t OneWire_ReadByte(OneWire_Bus* bus) {
     
     uint8_t data = 0;
     
+#if SIMPLE_1WIRE_USART
+    if (bus->backend == ONEWIRE_BACKEND_USART) {
+        OneWire_UsartTransfer(NULL, &data, 1);
+        return data;
+    }
+#endif
+    
     // อ่านทีละ bit (LSB first)
     for (uint8_t i = 0; i < 8; i++) {
         data >>= 1;
@@ -181,6 +379,13 @@ uint8_t OneWire_ReadByte(OneWire_Bus* bus) {
 void OneWire_WriteBytes(OneWire_Bus* bus, const uint8_t* data, uint8_t len) {
     if (!bus || !bus->initialized || !data) return;
     
+#if SIMPLE_1WIRE_USART
+    if (bus->backend == ONEWIRE_BACKEND_USART) {
+        OneWire_UsartTransfer(data, NULL, len);
+        return;
+    }
+#endif
+    
     for (uint8_t i = 0; i < len; i++) {
         OneWire_WriteByte(bus, data[i]);
     }
@@ -192,6 +397,13 @@ void OneWire_WriteBytes(OneWire_Bus* bus, const uint8_t* data, uint8_t len) {
 void OneWire_ReadBytes(OneWire_Bus* bus, uint8_t* buffer, uint8_t len) {
     if (!bus || !bus->initialized || !buffer) return;
     
+#if SIMPLE_1WIRE_USART
+    if (bus->backend == ONEWIRE_BACKEND_USART) {
+        OneWire_UsartTransfer(NULL, buffer, len);
+        return;
+    }
+#endif
+    
     for (uint8_t i = 0; i < len; i++) {
         buffer[i] = OneWire_ReadByte(bus);
     }
@@ -286,6 +498,35 @@ bool OneWire_AlarmSearch(OneWire_Bus* bus) {
     return OneWire_SearchInternal(bus, ONEWIRE_CMD_ALARM_SEARCH);
 }
 
+/**
+ * @brief ตรวจว่า device ที่มี ROM นี้ยังอยู่บน bus
+ * @note Maxim AN187: ตั้ง last_discrepancy = 64 ให้ search เดินตาม ROM นี้ทุก discrepancy
+ */
+bool OneWire_Verify(OneWire_Bus* bus, const uint8_t* rom) {
+    if (!bus || !bus->initialized || !rom) return false;
+    
+    // เก็บ search state เดิม (ผู้เรียกอาจอยู่ระหว่าง OneWire_Search loop)
+    uint8_t saved_rom[8];
+    uint8_t saved_discrepancy = bus->last_discrepancy;
+    uint8_t saved_family = bus->last_family_discrepancy;
+    bool saved_last = bus->last_device_flag;
+    memcpy(saved_rom, bus->rom, 8);
+    
+    memcpy(bus->rom, rom, 8);
+    bus->last_discrepancy = 64;
+    bus->last_device_flag = false;
+    
+    bool found = OneWire_SearchInternal(bus, ONEWIRE_CMD_SEARCH_ROM) &&
+                 (memcmp(bus->rom, rom, 8) == 0);
+    
+    memcpy(bus->rom, saved_rom, 8);
+    bus->last_discrepancy = saved_discrepancy;
+    bus->last_family_discrepancy = saved_family;
+    bus->last_device_flag = saved_last;
+    
+    return found;
+}
+
 /**
  * @brief ดึง ROM address ที่พบจาก search
  */
@@ -298,26 +539,12 @@ void OneWire_GetAddress(OneWire_Bus* bus, uint8_t* rom) {
 
 /**
  * @brief คำนวณ CRC8 (Dallas/Maxim)
- * @note Polynomial: x^8 + x^5 + x^4 + 1 (0x8C)
+ * @note Polynomial: x^8 + x^5 + x^4 + 1 (0x8C), table-driven ผ่าน CRC8_Maxim()
  */
 uint8_t OneWire_CRC8(const uint8_t* data, uint8_t len) {
     if (!data) return 0;
     
-    uint8_t crc = 0;
-    
-    for (uint8_t i = 0; i < len; i++) {
-        uint8_t inbyte = data[i];
-        for (uint8_t j = 0; j < 8; j++) {
-            uint8_t mix = (crc ^ inbyte) & 0x01;
-            crc >>= 1;
-            if (mix) {
-                crc ^= 0x8C;
-            }
-            inbyte >>= 1;
-        }
-    }
-    
-    return crc;
+    return CRC8_Maxim(data, len);
 }
 
 /**
@@ -338,6 +565,7 @@ bool OneWire_VerifyCRC(const uint8_t* data, uint8_t len) {
  */
 void OneWire_Depower(OneWire_Bus* bus) {
     if (!bus || !bus->initialized) return;
+    if (bus->backend == ONEWIRE_BACKEND_USART || bus->overdrive) return;  // open-drain ปล่อยสายอยู่แล้ว
     pinMode(bus->pin, PIN_MODE_INPUT);
 }
 
@@ -353,6 +581,138 @@ OneWire_Bus* OneWire_GetBusByPin(uint8_t pin) {
     return NULL;
 }
 
+/* ========== Overdrive Functions ========== */
+
+/**
+ * @brief ส่ง Overdrive Skip ROM แล้วสลับ bus เป็น overdrive
+ */
+bool OneWire_OverdriveSkip(OneWire_Bus* bus) {
+    if (!bus || !bus->initialized) return false;
+    
+    // คำสั่ง overdrive ต้องส่งที่ standard speed หลัง standard reset
+    OneWire_SetSpeed(bus, false);
+    if (!OneWire_Reset(bus)) {
+        return false;
+    }
+    OneWire_WriteByte(bus, ONEWIRE_CMD_OD_SKIP_ROM);
+    OneWire_SetSpeed(bus, true);
+    
+    return true;
+}
+
+/**
+ * @brief ส่ง Overdrive Match ROM แล้วสลับ bus เป็น overdrive
+ */
+bool OneWire_OverdriveSelect(OneWire_Bus* bus, const uint8_t* rom) {
+    if (!bus || !bus->initialized || !rom) return false;
+    
+    OneWire_SetSpeed(bus, false);
+    if (!OneWire_Reset(bus)) {
+        return false;
+    }
+    OneWire_WriteByte(bus, ONEWIRE_CMD_OD_MATCH_ROM);
+    
+    // ROM ส่งที่ overdrive speed
+    OneWire_SetSpeed(bus, true);
+    OneWire_WriteBytes(bus, rom, 8);
+    
+    return true;
+}
+
+/**
+ * @brief กลับ standard speed
+ */
+bool OneWire_StandardSpeed(OneWire_Bus* bus) {
+    if (!bus || !bus->initialized) return false;
+    
+    // Standard reset (480 µs) ทำให้ทุก device กลับ standard speed
+    OneWire_SetSpeed(bus, false);
+    return OneWire_Reset(bus);
+}
+
+/**
+ * @brief ตรวจว่า device รองรับ overdrive หรือไม่
+ */
+bool OneWire_SupportsOverdrive(const uint8_t* rom) {
+    // DS2430A, DS2423, DS2433, DS2408, DS2431, DS2413, DS28EC20
+    static const uint8_t families[] = {0x14, 0x1D, 0x23, 0x29, 0x2D, 0x3A, 0x43};
+    
+    if (!rom) return false;
+    
+    for (uint8_t i = 0; i < sizeof(families); i++) {
+        if (rom[0] == families[i]) return true;
+    }
+    return false;
+}
+
+#if SIMPLE_1WIRE_ASYNC
+
+/* ========== Async Functions ========== */
+
+/**
+ * @brief ส่ง reset pulse แบบ non-blocking
+ */
+bool OneWire_ResetAsync(OneWire_Bus* bus, OneWire_AsyncCallback callback) {
+    if (!OneWire_AsyncBegin(bus, ONEWIRE_OP_RESET, callback)) return false;
+    OneWire_AsyncStart(&onewire_async);
+    return true;
+}
+
+/**
+ * @brief เขียนหลาย bytes แบบ non-blocking
+ */
+bool OneWire_WriteBytesAsync(OneWire_Bus* bus, const uint8_t* data, uint8_t len,
+                             OneWire_AsyncCallback callback) {
+    if (!data) return false;
+    if (!OneWire_AsyncBegin(bus, ONEWIRE_OP_WRITE, callback)) return false;
+    onewire_async.tx = data;
+    onewire_async.len = len;
+    OneWire_AsyncStart(&onewire_async);
+    return true;
+}
+
+/**
+ * @brief อ่านหลาย bytes แบบ non-blocking
+ */
+bool OneWire_ReadBytesAsync(OneWire_Bus* bus, uint8_t* buffer, uint8_t len,
+                            OneWire_AsyncCallback callback) {
+    if (!buffer) return false;
+    if (!OneWire_AsyncBegin(bus, ONEWIRE_OP_READ, callback)) return false;
+    onewire_async.rx = buffer;
+    onewire_async.len = len;
+    OneWire_AsyncStart(&onewire_async);
+    return true;
+}
+
+/**
+ * @brief ค้นหา device ถัดไปแบบ non-blocking
+ */
+bool OneWire_SearchAsync(OneWire_Bus* bus, OneWire_AsyncCallback callback) {
+    if (!OneWire_AsyncBegin(bus, ONEWIRE_OP_SEARCH, callback)) return false;
+    onewire_async.command = ONEWIRE_CMD_SEARCH_ROM;
+    OneWire_AsyncStart(&onewire_async);
+    return true;
+}
+
+/**
+ * @brief Alarm search แบบ non-blocking
+ */
+bool OneWire_AlarmSearchAsync(OneWire_Bus* bus, OneWire_AsyncCallback callback) {
+    if (!OneWire_AsyncBegin(bus, ONEWIRE_OP_SEARCH, callback)) return false;
+    onewire_async.command = ONEWIRE_CMD_ALARM_SEARCH;
+    OneWire_AsyncStart(&onewire_async);
+    return true;
+}
+
+/**
+ * @brief ตรวจว่า async engine กำลังทำงานอยู่หรือไม่
+ */
+bool OneWire_AsyncBusy(void) {
+    return onewire_async.active;
+}
+
+#endif  // SIMPLE_1WIRE_ASYNC
+
 /* ========== Private Functions ========== */
 
 /**
@@ -376,14 +736,10 @@ static bool OneWire_SearchInternal(OneWire_Bus* bus, uint8_t command) {
     // ส่ง search command
     OneWire_WriteByte(bus, command);
     
-    uint8_t id_bit_number = 1;
-    uint8_t last_zero = 0;
-    uint8_t rom_byte_number = 0;
-    uint8_t rom_byte_mask = 1;
-    bool search_result = false;
+    OneWire_SearchState s = {1, 0, 0, 1};
     
     // Loop through all 64 bits
-    while (rom_byte_number < 8) {
+    while (s.rom_byte_number < 8) {
         // อ่าน bit และ complement bit
         uint8_t id_bit = OneWire_ReadBit(bus);
         uint8_t cmp_id_bit = OneWire_ReadBit(bus);
@@ -394,59 +750,77 @@ static bool OneWire_SearchInternal(OneWire_Bus* bus, uint8_t command) {
             break;
         }
         
-        uint8_t search_direction;
-        
-        if (id_bit != cmp_id_bit) {
-            // ทุก devices มีค่า bit เหมือนกัน
-            search_direction = id_bit;
-        } else {
-            // มี discrepancy (devices มีค่า bit ต่างกัน)
-            if (id_bit_number < bus->last_discrepancy) {
-                // ใช้ค่าเดิมจาก ROM
-                search_direction = ((bus->rom[rom_byte_number] & rom_byte_mask) > 0);
-            } else {
-                // เลือก 1 ถ้าเป็น last_discrepancy, ไม่งั้นเลือก 0
-                search_direction = (id_bit_number == bus->last_discrepancy);
-            }
-            
-            // บันทึก last zero position
-            if (search_direction == 0) {
-                last_zero = id_bit_number;
-                
-                // Check for last family discrepancy
-                if (last_zero < 9) {
-                    bus->last_family_discrepancy = last_zero;
-                }
-            }
-        }
-        
-        // บันทึก bit ใน ROM
-        if (search_direction) {
-            bus->rom[rom_byte_number] |= rom_byte_mask;
+        // ส่ง search direction bit
+        OneWire_WriteBit(bus, OneWire_SearchDirection(bus, &s, id_bit, cmp_id_bit));
+    }
+    
+    return OneWire_SearchFinish(bus, &s);
+}
+
+/**
+ * @brief เลือกทิศทางของ bit ปัจจุบัน บันทึกลง ROM และเลื่อนไป bit ถัดไป
+ * @return search direction bit ที่ต้องเขียนกลับไปยัง bus
+ */
+static uint8_t OneWire_SearchDirection(OneWire_Bus* bus, OneWire_SearchState* s,
+                                       uint8_t id_bit, uint8_t cmp_id_bit) {
+    uint8_t search_direction;
+    
+    if (id_bit != cmp_id_bit) {
+        // ทุก devices มีค่า bit เหมือนกัน
+        search_direction = id_bit;
+    } else {
+        // มี discrepancy (devices มีค่า bit ต่างกัน)
+        if (s->id_bit_number < bus->last_discrepancy) {
+            // ใช้ค่าเดิมจาก ROM
+            search_direction = ((bus->rom[s->rom_byte_number] & s->rom_byte_mask) > 0);
         } else {
-            bus->rom[rom_byte_number] &= ~rom_byte_mask;
+            // เลือก 1 ถ้าเป็น last_discrepancy, ไม่งั้นเลือก 0
+            search_direction = (s->id_bit_number == bus->last_discrepancy);
         }
         
-        // ส่ง search direction bit
-        OneWire_WriteBit(bus, search_direction);
-        
-        // เพิ่ม bit counter
-        id_bit_number++;
-        rom_byte_mask <<= 1;
-        
-        // ถ้าครบ byte แล้ว
-        if (rom_byte_mask == 0) {
-            rom_byte_number++;
-            rom_byte_mask = 1;
+        // บันทึก last zero position
+        if (search_direction == 0) {
+            s->last_zero = s->id_bit_number;
+            
+            // Check for last family discrepancy
+            if (s->last_zero < 9) {
+                bus->last_family_discrepancy = s->last_zero;
+            }
         }
     }
     
+    // บันทึก bit ใน ROM
+    if (search_direction) {
+        bus->rom[s->rom_byte_number] |= s->rom_byte_mask;
+    } else {
+        bus->rom[s->rom_byte_number] &= ~s->rom_byte_mask;
+    }
+    
+    // เพิ่ม bit counter
+    s->id_bit_number++;
+    s->rom_byte_mask <<= 1;
+    
+    // ถ้าครบ byte แล้ว
+    if (s->rom_byte_mask == 0) {
+        s->rom_byte_number++;
+        s->rom_byte_mask = 1;
+    }
+    
+    return search_direction;
+}
+
+/**
+ * @brief สรุปผล search หลังเดินครบ (หรือหยุดกลางทาง) และอัพเดท search state
+ */
+static bool OneWire_SearchFinish(OneWire_Bus* bus, const OneWire_SearchState* s) {
+    bool search_result = false;
+    
     // ตรวจสอบว่า search สำเร็จหรือไม่
-    if (id_bit_number >= 65) {
+    if (s->id_bit_number >= 65) {
         // ตรวจสอบ CRC
         if (OneWire_VerifyCRC(bus->rom, 8)) {
             // อัพเดท search state
-            bus->last_discrepancy = last_zero;
+            bus->last_discrepancy = s->last_zero;
             
             // ตรวจสอบว่าเป็น device สุดท้ายหรือไม่
             if (bus->last_discrepancy == 0) {
@@ -466,6 +840,91 @@ static bool OneWire_SearchInternal(OneWire_Bus* bus, uint8_t command) {
     return search_result;
 }
 
+/**
+ * @brief สลับ timing ของ master (ไม่ส่งอะไรบน bus)
+ */
+static void OneWire_SetSpeed(OneWire_Bus* bus, bool overdrive) {
+    if (bus->overdrive == overdrive) return;
+    bus->overdrive = overdrive;
+    
+#if SIMPLE_1WIRE_USART
+    if (bus->backend == ONEWIRE_BACKEND_USART) {
+        while (!(USART1->STATR & USART_FLAG_TC));
+        USART1->BRR = overdrive ? onewire_brr_od : onewire_brr_data;
+        return;
+    }
+#endif
+    
+    if (overdrive) {
+        // Open-drain ค้าง HIGH (ปล่อยสาย): slot เหลือแค่ BCR/BSHR/INDR ไม่ต้องเรียก pinMode()
+        digitalWrite(bus->pin, HIGH);
+        pinMode(bus->pin, PIN_MODE_OUTPUT_OD);
+    } else {
+        pinMode(bus->pin, PIN_MODE_INPUT);
+    }
+}
+
+/**
+ * @brief Reset pulse ที่ overdrive speed (70 µs)
+ */
+static bool OneWire_OdReset(OneWire_Bus* bus) {
+    GPIO_TypeDef* port = GPIO_PIN_PORT(bus->pin);
+    uint16_t mask = GPIO_PIN_MASK(bus->pin);
+    bool presence;
+    
+    OneWire_DisableInterrupts();
+    port->BCR = mask;
+    Delay_Us(ONEWIRE_OD_RESET_PULSE);
+    port->BSHR = mask;
+    Delay_Us(ONEWIRE_OD_PRESENCE_WAIT);
+    presence = !(port->INDR & mask);
+    OneWire_EnableInterrupts();
+    
+    Delay_Us(ONEWIRE_OD_PRESENCE_TIMEOUT);
+    
+    return presence;
+}
+
+/**
+ * @brief เขียน 1 bit ที่ overdrive speed (slot 10 µs)
+ */
+static void OneWire_OdWriteBit(OneWire_Bus* bus, uint8_t bit) {
+    GPIO_TypeDef* port = GPIO_PIN_PORT(bus->pin);
+    uint16_t mask = GPIO_PIN_MASK(bus->pin);
+    uint8_t low = (bit & 1) ? ONEWIRE_OD_WRITE_1_LOW : ONEWIRE_OD_WRITE_0_LOW;
+    
+    OneWire_DisableInterrupts();
+    port->BCR = mask;
+    Delay_Us(low);
+    port->BSHR = mask;
+    OneWire_EnableInterrupts();
+    
+    // Recovery: interrupt ตรงนี้แค่ทำให้ slot ยาวขึ้น
+    Delay_Us(ONEWIRE_OD_SLOT_TIME - low);
+}
+
+/**
+ * @brief อ่าน 1 bit ที่ overdrive speed
+ * @note อ่านทันทีหลังปล่อยสาย (device ค้างค่าไว้ถึง ~2 µs หลังขอบลง)
+ *       จึงต้องใช้ pull-up แรงพอให้สายขึ้นทัน (แนะนำ 2.2kΩ)
+ */
+static uint8_t OneWire_OdReadBit(OneWire_Bus* bus) {
+    GPIO_TypeDef* port = GPIO_PIN_PORT(bus->pin);
+    uint16_t mask = GPIO_PIN_MASK(bus->pin);
+    uint8_t bit;
+    
+    OneWire_DisableInterrupts();
+    port->BCR = mask;
+    Delay_Us(ONEWIRE_OD_WRITE_1_LOW);
+    port->BSHR = mask;
+    bit = (port->INDR & mask) ? 1 : 0;
+    OneWire_EnableInterrupts();
+    
+    Delay_Us(ONEWIRE_OD_SLOT_TIME - ONEWIRE_OD_WRITE_1_LOW);
+    
+    return bit;
+}
+
 /**
  * @brief ปิด interrupts (critical section)
  */
@@ -479,3 +938,418 @@ static void OneWire_DisableInterrupts(void) {
 static void OneWire_EnableInterrupts(void) {
     __enable_irq();
 }
+
+#if SIMPLE_1WIRE_USART
+
+/**
+ * @brief จอง DMA CH4/CH5 ของ USART1 (ไม่ได้ = ใช้ bit-bang แทน)
+ */
+static uint8_t OneWire_UsartClaimDma(void) {
+    if (DMA_AllocChannel(DMA_REQ_USART1_TX) == DMA_CH_NONE) return 0;
+    if (DMA_AllocChannel(DMA_REQ_USART1_RX) == DMA_CH_NONE) {
+        DMA_FreeChannel(ONEWIRE_USART_TX_DMA);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief ตั้งค่า USART1 เป็น half-duplex single-wire บน PD5 หรือ PD6
+ */
+static void OneWire_UsartInit(uint8_t pin) {
+    GPIO_InitTypeDef GPIO_InitStructure = {0};
+    USART_InitTypeDef USART_InitStructure = {0};
+    
+    Clock_AcquireOnce(CLOCK_GPIOD, &onewire_clocks);
+    Clock_AcquireOnce(CLOCK_AFIO, &onewire_clocks);
+    Clock_AcquireOnce(CLOCK_USART1, &onewire_clocks);
+    
+    // TX = PD5 (default) หรือ PD6 (remap 2), open-drain ใช้ pull-up ภายนอก
+    if (pin == PD6) {
+        GPIO_PinRemapConfig(GPIO_PartialRemap2_USART1, ENABLE);
+    }
+    GPIO_InitStructure.GPIO_Pin = (pin == PD6) ? GPIO_Pin_6 : GPIO_Pin_5;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_OD;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_Init(GPIOD, &GPIO_InitStructure);
+    
+    USART_InitStructure.USART_BaudRate = 115200;
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode = USART_Mode_Tx | USART_Mode_Rx;
+    USART_Init(USART1, &USART_InitStructure);
+    USART_HalfDuplexCmd(USART1, ENABLE);
+    USART_Cmd(USART1, ENABLE);
+    
+    // เก็บ BRR ไว้สลับ baud โดยไม่ต้องคำนวณใหม่ (115200 / 9600 = 12 พอดี)
+    onewire_brr_data = USART1->BRR;
+    onewire_brr_od = (uint16_t)(((uint32_t)onewire_brr_data * 1152 + 5000) / 10000);  // x 115200 / 1M
+    
+    DMA_USART_InitTx(ONEWIRE_USART_TX_DMA, onewire_slots, 0);
+    DMA_USART_InitRx(ONEWIRE_USART_RX_DMA, onewire_slots, 0, 0);
+}
+
+/**
+ * @brief ส่ง 1 slot และรอ echo (ใช้กับ reset และ bit เดี่ยวของ search)
+ */
+static uint8_t OneWire_UsartSlot(uint8_t slot) {
+    (void)USART1->DATAR;  // ล้าง echo เก่า
+    USART1->DATAR = slot;
+    while (!(USART1->STATR & USART_FLAG_RXNE));
+    return (uint8_t)USART1->DATAR;
+}
+
+/**
+ * @brief ส่ง/อ่านหลาย bytes เป็นชุด slot ผ่าน DMA
+ * @param tx ข้อมูลที่เขียน (NULL = read slot ทั้งหมด)
+ * @param rx buffer รับข้อมูล (NULL = ไม่เก็บ)
+ * @param len จำนวน bytes
+ */
+static void OneWire_UsartTransfer(const uint8_t* tx, uint8_t* rx, uint8_t len) {
+    DMA_Channel_TypeDef* rx_ch = DMA_GetChannelBase(ONEWIRE_USART_RX_DMA);
+    
+    while (len) {
+        uint8_t n = (len > SIMPLE_1WIRE_USART_CHUNK) ? SIMPLE_1WIRE_USART_CHUNK : len;
+        uint8_t* slot = onewire_slots;
+        
+        // 1 bit = 1 slot byte (LSB first)
+        for (uint8_t i = 0; i < n; i++) {
+            uint8_t data = tx ? tx[i] : 0xFF;
+            for (uint8_t b = 0; b < 8; b++) {
+                *slot++ = (data & 0x01) ? ONEWIRE_SLOT_ONE : ONEWIRE_SLOT_ZERO;
+                data >>= 1;
+            }
+        }
+        
+        // RX ต้องพร้อมก่อน TX เริ่ม; echo ของ slot i มาหลัง DMA อ่าน slot i ไปแล้ว
+        (void)USART1->DATAR;
+        DMA_Cmd(rx_ch, DISABLE);
+        rx_ch->MADDR = (uint32_t)onewire_slots;
+        rx_ch->CNTR = (uint16_t)n * 8;
+        DMA_Start(ONEWIRE_USART_RX_DMA);
+        DMA_USART_Transmit(ONEWIRE_USART_TX_DMA, onewire_slots, (uint16_t)n * 8);
+        
+        // Timing ทำโดย hardware: interrupt เกิดระหว่างนี้ได้โดย slot ไม่เพี้ยน
+        while (DMA_GetStatus(ONEWIRE_USART_RX_DMA) == DMA_STATUS_BUSY);
+        
+        if (rx) {
+            slot = onewire_slots;
+            for (uint8_t i = 0; i < n; i++) {
+                uint8_t data = 0;
+                for (uint8_t b = 0; b < 8; b++) {
+                    data >>= 1;
+                    if (*slot++ == ONEWIRE_SLOT_ONE) {
+                        data |= 0x80;
+                    }
+                }
+                rx[i] = data;
+            }
+            rx += n;
+        }
+        
+        if (tx) tx += n;
+        len -= n;
+    }
+}
+
+#endif  // SIMPLE_1WIRE_USART
+
+#if SIMPLE_1WIRE_ASYNC
+
+/**
+ * @brief จอง async engine และล้างสถานะของงานก่อนหน้า
+ */
+static bool OneWire_AsyncBegin(OneWire_Bus* bus, uint8_t op, OneWire_AsyncCallback callback) {
+    if (!bus || !bus->initialized) return false;
+    
+    OneWire_AsyncState* a = &onewire_async;
+    
+    // Callback ของงานก่อนหน้า (ใน ISR) อาจเริ่มงานใหม่พร้อมกับ main loop
+    OneWire_DisableInterrupts();
+    if (a->active) {
+        OneWire_EnableInterrupts();
+        return false;
+    }
+    a->active = true;
+    OneWire_EnableInterrupts();
+    
+    a->bus = bus;
+    a->callback = callback;
+    a->tx = NULL;
+    a->rx = NULL;
+    a->op = op;
+    a->phase = ONEWIRE_PHASE_START;
+    a->step = ONEWIRE_STEP_SLOT_END;
+    a->len = 0;
+    a->bit = 0;
+    a->data = 0;
+    a->result = false;
+    
+    return true;
+}
+
+/**
+ * @brief เริ่มงาน: USART backend ทำ blocking ทันที, GPIO ให้ compare interrupt เดินต่อ
+ */
+static void OneWire_AsyncStart(OneWire_AsyncState* a) {
+    if (a->bus->backend == ONEWIRE_BACKEND_USART || a->bus->overdrive) {
+        // USART: slot สร้างโดย hardware อยู่แล้ว, overdrive: slot 10 µs สั้นกว่ารอบ ISR
+        bool result = true;
+        switch (a->op) {
+            case ONEWIRE_OP_RESET:  result = OneWire_Reset(a->bus); break;
+            case ONEWIRE_OP_WRITE:  OneWire_WriteBytes(a->bus, a->tx, a->len); break;
+            case ONEWIRE_OP_READ:   OneWire_ReadBytes(a->bus, a->rx, a->len); break;
+            default:                result = OneWire_SearchInternal(a->bus, a->command); break;
+        }
+        OneWire_AsyncFinish(a, result);
+        return;
+    }
+    
+    // Timer 1 MHz free-running: compare = CNT + µs
+    if (!a->timer_on) {
+        TIM_AdvancedInit(SIMPLE_1WIRE_ASYNC_TIMER,
+                         (uint16_t)(SystemCoreClock / 1000000 - 1), 0xFFFF, TIM_MODE_UP);
+        TIM_Start(SIMPLE_1WIRE_ASYNC_TIMER);
+        a->timer_on = true;
+    }
+    
+    // Slot แรกเริ่มใน ISR เหมือน slot อื่นๆ (ตั้ง compare หลัง attach ที่ล้าง flag)
+    OneWire_DisableInterrupts();
+    TIM_AttachChannelCallback(SIMPLE_1WIRE_ASYNC_TIMER, SIMPLE_1WIRE_ASYNC_CHANNEL,
+                              OneWire_AsyncIsr, a);
+    OneWire_AsyncSchedule(ONEWIRE_ASYNC_MIN);
+    OneWire_EnableInterrupts();
+}
+
+/**
+ * @brief ตั้ง compare interrupt ครั้งถัดไปนับจาก counter ปัจจุบัน
+ * @note นับจาก CNT (ไม่ใช่ compare ก่อนหน้า) ISR ที่มาช้าทำให้ slot ยาวขึ้นเท่านั้น
+ *       ซึ่ง 1-Wire ยอมรับได้ ไม่มีทางตั้ง compare ย้อนหลังจนรอครบรอบ 16-bit
+ */
+static void OneWire_AsyncSchedule(uint16_t delay_us) {
+    if (delay_us < ONEWIRE_ASYNC_MIN) delay_us = ONEWIRE_ASYNC_MIN;
+    *ONEWIRE_ASYNC_CCR = (uint16_t)(ONEWIRE_ASYNC_TIMx->CNT + delay_us);
+}
+
+/**
+ * @brief Compare interrupt: จบช่วงรอยาวของ slot ปัจจุบัน
+ */
+static void OneWire_AsyncIsr(void* context, uint16_t value) {
+    OneWire_AsyncState* a = (OneWire_AsyncState*)context;
+    (void)value;
+    
+    switch (a->step) {
+        case ONEWIRE_STEP_RESET_RELEASE:
+            // ปล่อยสายหลัง reset pulse แล้วรอก่อนอ่าน presence
+            pinMode(a->bus->pin, PIN_MODE_INPUT);
+            a->step = ONEWIRE_STEP_RESET_SAMPLE;
+            OneWire_AsyncSchedule(ONEWIRE_PRESENCE_WAIT);
+            break;
+            
+        case ONEWIRE_STEP_RESET_SAMPLE:
+            a->result = !digitalRead(a->bus->pin);
+            a->step = ONEWIRE_STEP_SLOT_END;
+            OneWire_AsyncSchedule(ONEWIRE_RESET_PULSE - ONEWIRE_PRESENCE_WAIT);
+            break;
+            
+        case ONEWIRE_STEP_WRITE0_RELEASE:
+            pinMode(a->bus->pin, PIN_MODE_INPUT);
+            a->step = ONEWIRE_STEP_SLOT_END;
+            OneWire_AsyncSchedule(ONEWIRE_SLOT_TIME - ONEWIRE_WRITE_0_LOW + ONEWIRE_WRITE_RECOVERY);
+            break;
+            
+        default:
+            OneWire_AsyncNext(a);
+            break;
+    }
+}
+
+/**
+ * @brief เริ่ม slot ถัดไปของงาน (หรือจบงาน)
+ */
+static void OneWire_AsyncNext(OneWire_AsyncState* a) {
+    switch (a->op) {
+        case ONEWIRE_OP_RESET:
+            if (a->phase == ONEWIRE_PHASE_START) {
+                a->phase = ONEWIRE_PHASE_DONE;
+                OneWire_AsyncSlotReset(a);
+            } else {
+                OneWire_AsyncFinish(a, a->result);
+            }
+            return;
+            
+        case ONEWIRE_OP_WRITE:
+            if (!a->len) {
+                OneWire_AsyncFinish(a, true);
+                return;
+            }
+            OneWire_AsyncSlotWrite(a, (*a->tx >> a->bit) & 0x01);
+            if (++a->bit == 8) {
+                a->bit = 0;
+                a->tx++;
+                a->len--;
+            }
+            return;
+            
+        case ONEWIRE_OP_READ:
+            if (!a->len) {
+                OneWire_AsyncFinish(a, true);
+                return;
+            }
+            // LSB first
+            a->data >>= 1;
+            if (OneWire_AsyncSlotRead(a)) {
+                a->data |= 0x80;
+            }
+            if (++a->bit == 8) {
+                a->bit = 0;
+                *a->rx++ = a->data;
+                a->len--;
+            }
+            return;
+            
+        default:
+            break;
+    }
+    
+    // ONEWIRE_OP_SEARCH: ลำดับเดียวกับ OneWire_SearchInternal()
+    OneWire_Bus* bus = a->bus;
+    
+    switch (a->phase) {
+        case ONEWIRE_PHASE_START:
+            if (bus->last_device_flag) {
+                OneWire_AsyncFinish(a, false);
+                return;
+            }
+            a->phase = ONEWIRE_PHASE_PRESENCE;
+            OneWire_AsyncSlotReset(a);
+            return;
+            
+        case ONEWIRE_PHASE_PRESENCE:
+            if (!a->result) {
+                OneWire_ResetSearch(bus);
+                OneWire_AsyncFinish(a, false);
+                return;
+            }
+            a->search.id_bit_number = 1;
+            a->search.last_zero = 0;
+            a->search.rom_byte_number = 0;
+            a->search.rom_byte_mask = 1;
+            a->phase = ONEWIRE_PHASE_COMMAND;
+            // fall through
+            
+        case ONEWIRE_PHASE_COMMAND:
+            OneWire_AsyncSlotWrite(a, (a->command >> a->bit) & 0x01);
+            if (++a->bit == 8) {
+                a->bit = 0;
+                a->phase = ONEWIRE_PHASE_ID_BIT;
+            }
+            return;
+            
+        case ONEWIRE_PHASE_ID_BIT:
+            if (a->search.rom_byte_number >= 8) {
+                OneWire_AsyncFinish(a, OneWire_SearchFinish(bus, &a->search));
+                return;
+            }
+            a->id_bit = OneWire_AsyncSlotRead(a);
+            a->phase = ONEWIRE_PHASE_CMP_BIT;
+            return;
+            
+        case ONEWIRE_PHASE_CMP_BIT:
+            a->cmp_id_bit = OneWire_AsyncSlotRead(a);
+            a->phase = ONEWIRE_PHASE_DIRECTION;
+            return;
+            
+        default:
+            // ONEWIRE_PHASE_DIRECTION
+            if (a->id_bit && a->cmp_id_bit) {
+                // ไม่มี device ตอบกลับ
+                OneWire_AsyncFinish(a, OneWire_SearchFinish(bus, &a->search));
+                return;
+            }
+            OneWire_AsyncSlotWrite(a, OneWire_SearchDirection(bus, &a->search,
+                                                              a->id_bit, a->cmp_id_bit));
+            a->phase = ONEWIRE_PHASE_ID_BIT;
+            return;
+    }
+}
+
+/**
+ * @brief เริ่ม reset slot: ดึงสายลงแล้วรอ 480 µs ด้วย compare
+ */
+static void OneWire_AsyncSlotReset(OneWire_AsyncState* a) {
+    pinMode(a->bus->pin, PIN_MODE_OUTPUT);
+    digitalWrite(a->bus->pin, LOW);
+    a->step = ONEWIRE_STEP_RESET_RELEASE;
+    OneWire_AsyncSchedule(ONEWIRE_RESET_PULSE);
+}
+
+/**
+ * @brief เริ่ม write slot
+ * @note Write 1 ต้องปล่อยสายภายใน 15 µs จึงรอในนี้ (ปิด interrupt 10 µs)
+ *       Write 0 รอ 60 µs ด้วย compare (มาช้าได้ถึง 120 µs)
+ */
+static void OneWire_AsyncSlotWrite(OneWire_AsyncState* a, uint8_t bit) {
+    uint8_t pin = a->bus->pin;
+    
+    if (bit) {
+        OneWire_DisableInterrupts();
+        pinMode(pin, PIN_MODE_OUTPUT);
+        digitalWrite(pin, LOW);
+        Delay_Us(ONEWIRE_WRITE_1_LOW);
+        pinMode(pin, PIN_MODE_INPUT);
+        OneWire_EnableInterrupts();
+        
+        a->step = ONEWIRE_STEP_SLOT_END;
+        OneWire_AsyncSchedule(ONEWIRE_SLOT_TIME - ONEWIRE_WRITE_1_LOW + ONEWIRE_WRITE_RECOVERY);
+    } else {
+        pinMode(pin, PIN_MODE_OUTPUT);
+        digitalWrite(pin, LOW);
+        
+        a->step = ONEWIRE_STEP_WRITE0_RELEASE;
+        OneWire_AsyncSchedule(ONEWIRE_WRITE_0_LOW);
+    }
+}
+
+/**
+ * @brief Read slot: ช่วง 13 µs จนถึงจุดอ่านทำในนี้ (ปิด interrupt)
+ *        เวลาที่เหลือของ slot รอด้วย compare
+ */
+static uint8_t OneWire_AsyncSlotRead(OneWire_AsyncState* a) {
+    uint8_t pin = a->bus->pin;
+    uint8_t bit;
+    
+    OneWire_DisableInterrupts();
+    pinMode(pin, PIN_MODE_OUTPUT);
+    digitalWrite(pin, LOW);
+    Delay_Us(ONEWIRE_READ_LOW);
+    pinMode(pin, PIN_MODE_INPUT);
+    Delay_Us(ONEWIRE_READ_WAIT);
+    bit = digitalRead(pin);
+    OneWire_EnableInterrupts();
+    
+    a->step = ONEWIRE_STEP_SLOT_END;
+    OneWire_AsyncSchedule(ONEWIRE_READ_RECOVERY);
+    
+    return bit;
+}
+
+/**
+ * @brief จบงาน: คืน compare channel แล้วเรียก callback
+ * @note ปล่อย engine ก่อนเรียก callback เพื่อให้ callback เริ่มงานถัดไปได้
+ */
+static void OneWire_AsyncFinish(OneWire_AsyncState* a, bool result) {
+    OneWire_Bus* bus = a->bus;
+    OneWire_AsyncCallback callback = a->callback;
+    
+    TIM_DetachChannelCallback(SIMPLE_1WIRE_ASYNC_TIMER, SIMPLE_1WIRE_ASYNC_CHANNEL);
+    a->active = false;
+    
+    if (callback) {
+        callback(bus, result);
+    }
+}
+
+#endif  // SIMPLE_1WIRE_ASYNC
@@ -1,8 +1,8 @@
 /**
  * @file Simple1Wire.h
  * @brief Simple 1-Wire Protocol Library สำหรับ CH32V003
- * @version 1.0
- * @date 2025-12-22
+ * @version 1.3
+ * @date 2026-10-15
  * 
  * @details
  * Library นี้ใช้สำหรับการสื่อสารด้วย 1-Wire protocol
@@ -15,6 +15,7 @@
  * - CRC8 calculation และ validation
  * - รองรับทุก GPIO pins ของ CH32V003
  * - Interrupt-safe critical sections
+ * - USART half-duplex backend (DMA) สำหรับ PD5/PD6 (เลือกอัตโนมัติตอน OneWire_Init)
  * 
  * **Hardware Requirements:**
  * - Pull-up resistor 4.7kΩ ระหว่าง data line และ VCC
@@ -34,6 +35,35 @@
  *    GND
  * ```
  * 
+ * **USART Backend (SIMPLE_1WIRE_USART = 1):**
+ * - ใช้ USART1 แบบ half-duplex single-wire (TX pin แบบ open-drain, RX ต่อภายใน)
+ * - 1 UART byte = 1 time slot: reset = 0xF0 ที่ 9600 baud,
+ *   bit = 0xFF (เขียน 1 / อ่าน) หรือ 0x00 (เขียน 0) ที่ 115200 baud
+ * - Byte/Bytes ส่งเป็นชุด slot ผ่าน DMA (CH4 TX, CH5 RX echo) เช่นอ่าน ROM 8 bytes
+ *   หรือ scratchpad 9 bytes ในครั้งเดียว timing ทำโดย hardware ไม่ต้องปิด interrupt
+ * - OneWire_Init() เลือก backend นี้ให้ bus แรกที่อยู่บน PD5 (default) หรือ PD6 (remap 2)
+ *   bus อื่นใช้ GPIO bit-bang ตามเดิม
+ * - ระหว่างใช้ USART1 ถูกจองโดย 1-Wire (ห้ามใช้ SimpleUSART พร้อมกัน)
+ * - จอง DMA CH4/CH5 ด้วย DMA_AllocChannel() ถ้าถูกจองไปแล้วจะใช้ bit-bang แทน
+ * 
+ * **Async Engine (SIMPLE_1WIRE_ASYNC = 1):**
+ * - Timer 1 MHz free-running + compare interrupt เดิน state machine ทีละ slot
+ * - ช่วงรอยาว (reset 480 µs, write 0 60 µs, recovery) รอด้วย compare ไม่ใช้ CPU
+ * - ปิด interrupt เฉพาะช่วงสั้นใน ISR: write 1 (10 µs) และ read (13 µs)
+ * - OneWire_ResetAsync / WriteBytesAsync / ReadBytesAsync / SearchAsync
+ *   เรียก callback (จาก ISR) เมื่อจบ ทำได้ทีละ 1 งาน (OneWire_AsyncBusy())
+ * - Bus ที่ใช้ USART backend ทำงานแบบ blocking (DMA) แล้วเรียก callback ทันที
+ * 
+ * **Overdrive Speed:**
+ * - OneWire_OverdriveSkip() / OneWire_OverdriveSelect() ส่งคำสั่งที่ standard speed
+ *   แล้วสลับ bus เป็น overdrive (slot 10 µs, reset 70 µs เร็วกว่าเดิม ~8 เท่า)
+ * - เฉพาะ devices ที่รองรับ (OneWire_SupportsOverdrive() จาก family code)
+ *   DS18B20 ไม่รองรับ: ใช้ OneWire_OverdriveSelect() เลือกเฉพาะตัวที่รองรับ
+ * - GPIO backend: pin เป็น open-drain ระหว่าง overdrive (เขียน/อ่าน register ตรง)
+ *   แนะนำ pull-up 2.2kΩ ให้สายขึ้นทันจุดอ่าน
+ * - USART backend: slot 1 Mbaud, reset 76800 baud
+ * - OneWire_StandardSpeed() ส่ง standard reset ให้ทุก device กลับ standard speed
+ * 
  * @example
  * #include "Simple1Wire.h"
  * 
@@ -63,6 +93,7 @@ extern "C" {
 #endif
 
 #include <ch32v00x.h>
+#include "SimpleHAL_Config.h"
 #include "SimpleGPIO.h"
 #include "SimpleDelay.h"
 #include <stdint.h>
@@ -70,7 +101,47 @@ extern "C" {
 
 /* ========== Configuration ========== */
 
-#define ONEWIRE_MAX_BUSES  4  /**< จำนวน 1-Wire buses สูงสุด */
+#define ONEWIRE_MAX_BUSES  SIMPLE_1WIRE_MAX_BUSES  /**< จำนวน 1-Wire buses สูงสุด (SimpleHAL_Config.h) */
+
+/**
+ * @brief เปิดใช้ USART half-duplex backend สำหรับ bus บน PD5/PD6
+ * @note 0 = GPIO bit-bang ทุก bus (ไม่ link SimpleDMA)
+ */
+#ifndef SIMPLE_1WIRE_USART
+#define SIMPLE_1WIRE_USART 0
+#endif
+
+/**
+ * @brief จำนวน bytes สูงสุดต่อ 1 DMA transfer ของ USART backend
+ * @note ใช้ RAM 8 bytes ต่อ 1 byte ข้อมูล (ค่าเริ่มต้น 9 = scratchpad DS18B20)
+ */
+#ifndef SIMPLE_1WIRE_USART_CHUNK
+#define SIMPLE_1WIRE_USART_CHUNK 9
+#endif
+
+/**
+ * @brief เปิดใช้ async engine (OneWire_*Async)
+ * @note 0 = ไม่ link SimpleTIM
+ */
+#ifndef SIMPLE_1WIRE_ASYNC
+#define SIMPLE_1WIRE_ASYNC 0
+#endif
+
+/**
+ * @brief Timer ของ async engine (TIM_1 หรือ TIM_2)
+ * @note ถูกตั้งเป็น 1 MHz free-running ตอนเริ่มงานแรก ใช้ channel อื่นเป็น
+ *       deadline ร่วมกันได้ แต่ห้ามเปลี่ยน prescaler/period หรือใช้ทำ PWM
+ */
+#ifndef SIMPLE_1WIRE_ASYNC_TIMER
+#define SIMPLE_1WIRE_ASYNC_TIMER TIM_2
+#endif
+
+/**
+ * @brief Compare channel (1-4) ที่ async engine ใช้
+ */
+#ifndef SIMPLE_1WIRE_ASYNC_CHANNEL
+#define SIMPLE_1WIRE_ASYNC_CHANNEL 4
+#endif
 
 /* ========== 1-Wire Timing (microseconds) ========== */
 
@@ -89,6 +160,17 @@ extern "C" {
 #define ONEWIRE_READ_RECOVERY     55    /**< Recovery time after read (55 µs) */
 #define ONEWIRE_SLOT_TIME         65    /**< Total time slot (60-120 µs) */
 
+/**
+ * @brief 1-Wire Timing Constants (Overdrive Speed)
+ * @note ปัดเป็น µs เต็มจากค่าแนะนำของ Maxim AN126 (เช่น 7.5 -> 8, 8.5 -> 9)
+ */
+#define ONEWIRE_OD_RESET_PULSE      70  /**< Reset pulse duration (48-80 µs) */
+#define ONEWIRE_OD_PRESENCE_WAIT    9   /**< Wait before sampling presence (8.5 µs) */
+#define ONEWIRE_OD_PRESENCE_TIMEOUT 40  /**< รอ presence pulse จบ */
+#define ONEWIRE_OD_WRITE_0_LOW      8   /**< Write 0 low time (7.5-15 µs) */
+#define ONEWIRE_OD_WRITE_1_LOW      1   /**< Write 1 / read initiation low time (1-2 µs) */
+#define ONEWIRE_OD_SLOT_TIME        10  /**< Total time slot (รวม recovery) */
+
 /* ========== ROM Commands ========== */
 
 /**
@@ -99,9 +181,19 @@ extern "C" {
 #define ONEWIRE_CMD_MATCH_ROM     0x55  /**< Match ROM (select specific device) */
 #define ONEWIRE_CMD_SEARCH_ROM    0xF0  /**< Search ROM (find all devices) */
 #define ONEWIRE_CMD_ALARM_SEARCH  0xEC  /**< Alarm search (find devices with alarm) */
+#define ONEWIRE_CMD_OD_SKIP_ROM   0x3C  /**< Overdrive Skip ROM (ทุก device ที่รองรับเข้า overdrive) */
+#define ONEWIRE_CMD_OD_MATCH_ROM  0x69  /**< Overdrive Match ROM (ROM ส่งที่ overdrive speed) */
 
 /* ========== Structures ========== */
 
+/**
+ * @brief วิธีสร้าง time slot ของ bus
+ */
+typedef enum {
+    ONEWIRE_BACKEND_GPIO = 0,  /**< GPIO bit-bang + Delay_Us */
+    ONEWIRE_BACKEND_USART      /**< USART1 half-duplex + DMA */
+} OneWire_Backend;
+
 /**
  * @brief 1-Wire Bus Instance Structure
  */
@@ -111,9 +203,21 @@ typedef struct {
     uint8_t last_discrepancy;           /**< Last discrepancy position (search state) */
     uint8_t last_family_discrepancy;    /**< Last family discrepancy (search state) */
     bool last_device_flag;              /**< Last device found flag */
+    uint8_t backend;                    /**< OneWire_Backend ที่เลือกตอน Init */
+    bool overdrive;                     /**< ใช้ overdrive timing อยู่ */
     bool initialized;                   /**< Initialization flag */
 } OneWire_Bus;
 
+/**
+ * @brief Callback เมื่องาน async จบ (เรียกจาก timer ISR)
+ * @param bus bus ที่ทำงาน
+ * @param result Reset: มี presence, Write/Read: true เสมอ,
+ *               Search: พบ device (ROM อยู่ใน bus->rom)
+ *
+ * @note เริ่มงาน async ถัดไปจากใน callback ได้ (เช่น Reset -> Write -> Read)
+ */
+typedef void (*OneWire_AsyncCallback)(OneWire_Bus* bus, bool result);
+
 /* ========== Function Prototypes ========== */
 
 /* === Initialization === */
@@ -124,6 +228,8 @@ typedef struct {
  * @return ตัวชี้ไปยัง OneWire_Bus instance หรือ NULL ถ้าเต็ม
  * 
  * @note ต้องมี pull-up resistor 4.7kΩ ภายนอก
+ * @note เมื่อ SIMPLE_1WIRE_USART = 1 และ pin เป็น PD5/PD6 จะใช้ USART backend
+ *       (ตรวจได้จาก bus->backend)
  * 
  * @example
  * OneWire_Bus* bus = OneWire_Init(PD2);
@@ -342,6 +448,23 @@ bool OneWire_Search(OneWire_Bus* bus);
  */
 bool OneWire_AlarmSearch(OneWire_Bus* bus);
 
+/**
+ * @brief ตรวจว่า device ที่มี ROM นี้ยังอยู่บน bus
+ * @param bus ตัวชี้ไปยัง OneWire_Bus instance
+ * @param rom ROM address 8 bytes
+ * @return true = device ตอบกลับครบทั้ง 64 bits
+ *
+ * @details Match ROM ไม่มีการตอบกลับจาก device จึงใช้ search ที่บังคับทางเดิน
+ * ตาม ROM นี้ (Maxim AN187 "Verify") 1 รอบ ไม่ต้องเดินทั้ง ROM tree
+ * @note Search state ของ bus (OneWire_Search) ไม่ถูกเปลี่ยน
+ *
+ * @example
+ * if (!OneWire_Verify(bus, saved_rom)) {
+ *     // sensor ถูกถอดออก: ค้นหาใหม่
+ * }
+ */
+bool OneWire_Verify(OneWire_Bus* bus, const uint8_t* rom);
+
 /**
  * @brief ดึง ROM address ที่พบจาก search
  * @param bus ตัวชี้ไปยัง OneWire_Bus instance
@@ -422,6 +545,136 @@ void OneWire_Depower(OneWire_Bus* bus);
  */
 OneWire_Bus* OneWire_GetBusByPin(uint8_t pin);
 
+/* === Overdrive Functions === */
+
+/**
+ * @brief ส่ง Overdrive Skip ROM แล้วสลับ bus เป็น overdrive
+ * @param bus ตัวชี้ไปยัง OneWire_Bus instance
+ * @return true = มี device ตอบ presence (ก่อนสลับ speed)
+ *
+ * @note ใช้เมื่อทุก device บน bus รองรับ overdrive
+ * @note ต่อจากนี้ Reset, Select, Read/Write ใช้ overdrive timing
+ *
+ * @example
+ * if (OneWire_OverdriveSkip(bus)) {
+ *     OneWire_Select(bus, rom);        // reset 70 µs + Match ROM ~0.8 ms
+ *     OneWire_WriteByte(bus, 0xF0);    // Read memory (DS2431)
+ * }
+ */
+bool OneWire_OverdriveSkip(OneWire_Bus* bus);
+
+/**
+ * @brief ส่ง Overdrive Match ROM แล้วสลับ bus เป็น overdrive
+ * @param bus ตัวชี้ไปยัง OneWire_Bus instance
+ * @param rom ROM address 8 bytes (ส่งที่ overdrive speed)
+ * @return true = มี device ตอบ presence
+ *
+ * @note เฉพาะ device ที่ถูกเลือกเข้า overdrive ตัวอื่นอยู่ standard และเงียบ
+ *       จนกว่าจะมี standard reset
+ */
+bool OneWire_OverdriveSelect(OneWire_Bus* bus, const uint8_t* rom);
+
+/**
+ * @brief กลับ standard speed: สลับ timing แล้วส่ง standard reset
+ * @param bus ตัวชี้ไปยัง OneWire_Bus instance
+ * @return true = มี device ตอบ presence
+ */
+bool OneWire_StandardSpeed(OneWire_Bus* bus);
+
+/**
+ * @brief ตรวจว่า device รองรับ overdrive หรือไม่ (จาก family code)
+ * @param rom ROM address (ใช้ rom[0])
+ * @return true = family อยู่ในรายการที่รองรับ (DS2431, DS2433, DS2408, DS2413, ...)
+ */
+bool OneWire_SupportsOverdrive(const uint8_t* rom);
+
+#if SIMPLE_1WIRE_ASYNC
+
+/* === Async Functions (SIMPLE_1WIRE_ASYNC) === */
+
+/**
+ * @brief ส่ง reset pulse แบบ non-blocking
+ * @param bus ตัวชี้ไปยัง OneWire_Bus instance
+ * @param callback เรียกเมื่อจบ (result = มี presence)
+ * @return true = เริ่มงานแล้ว, false = engine ไม่ว่างหรือ bus ไม่ถูกต้อง
+ *
+ * @example
+ * static uint8_t scratchpad[9];
+ * static const uint8_t cmd[] = {ONEWIRE_CMD_SKIP_ROM, 0xBE};
+ *
+ * static void on_read(OneWire_Bus* bus, bool ok) {
+ *     scratchpad_ready = OneWire_VerifyCRC(scratchpad, 9);
+ * }
+ * static void on_cmd(OneWire_Bus* bus, bool ok) {
+ *     OneWire_ReadBytesAsync(bus, scratchpad, 9, on_read);
+ * }
+ * static void on_reset(OneWire_Bus* bus, bool present) {
+ *     if (present) OneWire_WriteBytesAsync(bus, cmd, 2, on_cmd);
+ * }
+ *
+ * OneWire_ResetAsync(bus, on_reset);
+ * while (!scratchpad_ready) {
+ *     // main loop ทำงานต่อระหว่าง ~6 ms ของ bus traffic
+ * }
+ */
+bool OneWire_ResetAsync(OneWire_Bus* bus, OneWire_AsyncCallback callback);
+
+/**
+ * @brief เขียนหลาย bytes แบบ non-blocking
+ * @param bus ตัวชี้ไปยัง OneWire_Bus instance
+ * @param data ข้อมูล (ต้องคงอยู่จนงานจบ)
+ * @param len จำนวน bytes
+ * @param callback เรียกเมื่อจบ (NULL = ไม่ต้องแจ้ง)
+ * @return true = เริ่มงานแล้ว, false = engine ไม่ว่างหรือ bus ไม่ถูกต้อง
+ */
+bool OneWire_WriteBytesAsync(OneWire_Bus* bus, const uint8_t* data, uint8_t len,
+                             OneWire_AsyncCallback callback);
+
+/**
+ * @brief อ่านหลาย bytes แบบ non-blocking
+ * @param bus ตัวชี้ไปยัง OneWire_Bus instance
+ * @param buffer buffer รับข้อมูล (ต้องคงอยู่จนงานจบ)
+ * @param len จำนวน bytes
+ * @param callback เรียกเมื่อจบ
+ * @return true = เริ่มงานแล้ว, false = engine ไม่ว่างหรือ bus ไม่ถูกต้อง
+ */
+bool OneWire_ReadBytesAsync(OneWire_Bus* bus, uint8_t* buffer, uint8_t len,
+                            OneWire_AsyncCallback callback);
+
+/**
+ * @brief ค้นหา device ถัดไปแบบ non-blocking (Search ROM 0xF0)
+ * @param bus ตัวชี้ไปยัง OneWire_Bus instance
+ * @param callback เรียกเมื่อจบ (result = พบ device, ROM อยู่ใน bus->rom)
+ * @return true = เริ่มงานแล้ว, false = engine ไม่ว่างหรือ bus ไม่ถูกต้อง
+ *
+ * @note ใช้ search state เดียวกับ OneWire_Search() (เรียก OneWire_ResetSearch() ก่อน)
+ *
+ * @example
+ * static void on_found(OneWire_Bus* bus, bool found) {
+ *     if (found) {
+ *         OneWire_GetAddress(bus, roms[rom_count++]);
+ *         OneWire_SearchAsync(bus, on_found);  // หาตัวถัดไป
+ *     }
+ * }
+ * OneWire_ResetSearch(bus);
+ * OneWire_SearchAsync(bus, on_found);
+ */
+bool OneWire_SearchAsync(OneWire_Bus* bus, OneWire_AsyncCallback callback);
+
+/**
+ * @brief Alarm search แบบ non-blocking (0xEC)
+ * @see OneWire_SearchAsync()
+ */
+bool OneWire_AlarmSearchAsync(OneWire_Bus* bus, OneWire_AsyncCallback callback);
+
+/**
+ * @brief ตรวจว่า async engine กำลังทำงานอยู่หรือไม่
+ * @return true = มีงานค้าง
+ */
+bool OneWire_AsyncBusy(void);
+
+#endif  // SIMPLE_1WIRE_ASYNC
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,114 @@
+/**
+ * @file Simple1Wire_Cache.c
+ * @brief Cached 1-Wire Device Enumeration Implementation
+ * @version 1.0
+ * @date 2026-10-15
+ */
+
+#include "Simple1Wire_Cache.h"
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief จำนวน keys ที่รายการใช้
+ */
+static uint8_t OneWire_CacheKeys(uint8_t max_devices) {
+    return (uint8_t)((max_devices + ONEWIRE_CACHE_ROMS_PER_KEY - 1) / ONEWIRE_CACHE_ROMS_PER_KEY);
+}
+
+/**
+ * @brief อ่านรายการจาก KV
+ * @return จำนวน ROM ที่อ่านได้ (0 = ไม่มี cache)
+ */
+static uint8_t OneWire_CacheLoad(uint8_t kv_key, uint8_t (*roms)[8], uint8_t max_devices) {
+    uint8_t count = 0;
+
+    while (count < max_devices) {
+        uint8_t room = max_devices - count;
+        if (room > ONEWIRE_CACHE_ROMS_PER_KEY) room = ONEWIRE_CACHE_ROMS_PER_KEY;
+
+        uint8_t len = KV_Get(kv_key++, roms[count], (uint8_t)(room * 8));
+        if (len > room * 8) len = (uint8_t)(room * 8);  // ค่าถูกตัด (buffer เล็กกว่าตอนบันทึก)
+
+        count += len / 8;
+        if (len < ONEWIRE_CACHE_ROMS_PER_KEY * 8) break;
+    }
+
+    return count;
+}
+
+/**
+ * @brief บันทึกรายการลง KV (KV_Set ข้าม key ที่ค่าเดิมเหมือนกัน)
+ */
+static void OneWire_CacheSave(uint8_t kv_key, uint8_t (*roms)[8], uint8_t count,
+                              uint8_t max_devices) {
+    uint8_t keys = OneWire_CacheKeys(max_devices);
+
+    for (uint8_t k = 0; k < keys; k++) {
+        uint8_t first = (uint8_t)(k * ONEWIRE_CACHE_ROMS_PER_KEY);
+
+        if (first >= count) {
+            // key ว่าง = จุดจบของรายการ
+            KV_Delete((uint8_t)(kv_key + k));
+            break;
+        }
+
+        uint8_t n = count - first;
+        if (n > ONEWIRE_CACHE_ROMS_PER_KEY) n = ONEWIRE_CACHE_ROMS_PER_KEY;
+        KV_Set((uint8_t)(kv_key + k), roms[first], (uint8_t)(n * 8));
+    }
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief โหลดรายการ ROM จาก KV และตรวจว่าทุกตัวยังอยู่
+ */
+uint8_t OneWire_CacheEnumerate(OneWire_Bus* bus, uint8_t kv_key,
+                               uint8_t (*roms)[8], uint8_t max_devices) {
+    if (!bus || !bus->initialized || !roms || max_devices == 0) return 0;
+
+    uint8_t count = OneWire_CacheLoad(kv_key, roms, max_devices);
+    if (count == 0) {
+        return OneWire_CacheRediscover(bus, kv_key, roms, max_devices);
+    }
+
+    // ตรวจเฉพาะ ROM ที่รู้จัก: ตัวใดหายไป = รายการไม่ตรง ต้อง search ใหม่
+    for (uint8_t i = 0; i < count; i++) {
+        if (!OneWire_Verify(bus, roms[i])) {
+            return OneWire_CacheRediscover(bus, kv_key, roms, max_devices);
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Search ทั้ง bus แล้วบันทึกรายการลง KV
+ */
+uint8_t OneWire_CacheRediscover(OneWire_Bus* bus, uint8_t kv_key,
+                                uint8_t (*roms)[8], uint8_t max_devices) {
+    if (!bus || !bus->initialized || !roms || max_devices == 0) return 0;
+
+    uint8_t count = 0;
+
+    OneWire_ResetSearch(bus);
+    while (count < max_devices && OneWire_Search(bus)) {
+        OneWire_GetAddress(bus, roms[count++]);
+    }
+
+    OneWire_CacheSave(kv_key, roms, count, max_devices);
+
+    return count;
+}
+
+/**
+ * @brief ลบรายการที่บันทึกไว้
+ */
+void OneWire_CacheClear(uint8_t kv_key, uint8_t max_devices) {
+    uint8_t keys = OneWire_CacheKeys(max_devices);
+
+    for (uint8_t k = 0; k < keys; k++) {
+        KV_Delete((uint8_t)(kv_key + k));
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * @file Simple1Wire_Cache.h
+ * @brief เก็บรายการ ROM ของ 1-Wire bus ใน SimpleKV แล้วตรวจตอน boot แทนการ search ใหม่
+ * @version 1.0
+ * @date 2026-10-15
+ *
+ * @details
+ * OneWire_Search() เดินทั้ง ROM tree ทุกครั้งที่ boot และรายการที่ได้หายไปเมื่อ reset
+ * module นี้บันทึกรายการลง KV store แล้วตอน boot ตรวจเฉพาะ ROM ที่รู้จักด้วย
+ * OneWire_Verify() (เดินทางเดียวของแต่ละ ROM) และ search ทั้ง bus เฉพาะเมื่อไม่ตรง
+ *
+ * **รูปแบบข้อมูล:**
+ * - ROM 8 bytes ต่อ device เรียงต่อกัน ONEWIRE_CACHE_ROMS_PER_KEY ตัวต่อ key
+ * - รายการยาวกว่านั้นใช้ keys ถัดไป (kv_key, kv_key + 1, ...)
+ * - key สุดท้ายที่ไม่เต็ม (หรือ key ที่ไม่มีค่า) บอกจุดจบของรายการ
+ *
+ * **Rediscovery:**
+ * - ROM ที่บันทึกไว้หายไปสักตัว -> search ใหม่ทั้ง bus แล้วบันทึกผล
+ * - Device ที่เพิ่มเข้ามาใหม่ตรวจไม่ได้จาก cache: เรียก OneWire_CacheRediscover()
+ *   เมื่อต้องการ (เช่นกดปุ่ม หรือตามรอบเวลา)
+ *
+ * @example
+ * enum { KEY_CONFIG, KEY_ROMS_BUS_A };   // ใช้ KEY_ROMS_BUS_A ถึง +2 (16 ROMs)
+ *
+ * static uint8_t roms[16][8];
+ * OneWire_Bus* bus = OneWire_Init(PC1);
+ *
+ * uint8_t n = OneWire_CacheEnumerate(bus, KEY_ROMS_BUS_A, roms, 16);
+ * for (uint8_t i = 0; i < n; i++) {
+ *     DS18B20_Add(bus, roms[i], 12);
+ * }
+ *
+ * @note Keys ที่ใช้: ceil(max_devices / ONEWIRE_CACHE_ROMS_PER_KEY) ตัวจาก kv_key
+ * @note การเขียน flash หยุด CPU ระหว่างทำงาน (เรียกตอน init ไม่ใช่ใน ISR)
+ */
+
+#ifndef __SIMPLE_1WIRE_CACHE_H
+#define __SIMPLE_1WIRE_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SimpleHAL_Config.h"
+#include "Simple1Wire.h"
+#include "SimpleKV.h"
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief จำนวน ROM ต่อ 1 KV key (ค่ายาวสุดของ KV / 8)
+ */
+#define ONEWIRE_CACHE_ROMS_PER_KEY  (KV_MAX_VALUE_SIZE / 8)
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief โหลดรายการ ROM จาก KV และตรวจว่าทุกตัวยังอยู่ (search ใหม่ถ้าไม่ตรง)
+ * @param bus ตัวชี้ไปยัง OneWire_Bus instance
+ * @param kv_key key แรกของรายการ
+ * @param roms buffer ROM 8 bytes ต่อ device
+ * @param max_devices จำนวน ROM สูงสุดใน buffer
+ * @return จำนวน devices ที่อยู่บน bus
+ *
+ * @note Cache ตรงกับ bus: ~1 search pass ต่อ device และไม่เขียน flash
+ */
+uint8_t OneWire_CacheEnumerate(OneWire_Bus* bus, uint8_t kv_key,
+                               uint8_t (*roms)[8], uint8_t max_devices);
+
+/**
+ * @brief Search ทั้ง bus แล้วบันทึกรายการลง KV (เขียนเฉพาะ key ที่ค่าเปลี่ยน)
+ * @param bus ตัวชี้ไปยัง OneWire_Bus instance
+ * @param kv_key key แรกของรายการ
+ * @param roms buffer ROM 8 bytes ต่อ device
+ * @param max_devices จำนวน ROM สูงสุดใน buffer
+ * @return จำนวน devices ที่พบ
+ */
+uint8_t OneWire_CacheRediscover(OneWire_Bus* bus, uint8_t kv_key,
+                                uint8_t (*roms)[8], uint8_t max_devices);
+
+/**
+ * @brief ลบรายการที่บันทึกไว้ (boot ถัดไปจะ search ใหม่)
+ * @param kv_key key แรกของรายการ
+ * @param max_devices ค่าเดียวกับที่ใช้ตอน enumerate
+ */
+void OneWire_CacheClear(uint8_t kv_key, uint8_t max_devices);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_1WIRE_CACHE_H
@@ -1,12 +1,50 @@
 /**
  * @file SimpleADC.c
  * @brief Simple ADC Library Implementation
- * @version 1.0
- * @date 2025-12-12
+ * @version 1.9
+ * @date 2026-10-14
  */
 
 #include "SimpleADC.h"
 #include "SimpleDelay.h"
+#include "SimpleClock.h"
+#include "SimpleDMA.h"
+#include "SimpleTIM.h"
+#include "SimpleISRStat.h"
+
+/* ========== Private Variables ========== */
+
+static uint16_t adc_clocks = 0;  // Clock ที่ SimpleADC ถืออยู่
+static uint8_t adc_calibrated = 0;  // reset + calibrate แล้ว (ทำครั้งเดียว)
+
+// Timer-triggered sampling
+static ADC_SampleCallback sampling_callback = NULL;
+static uint16_t* sampling_buffer = NULL;
+static uint16_t sampling_length = 0;
+static volatile uint8_t sampling_active = 0;
+
+// Oversampling: accumulator + result queue (เขียนจาก DMA interrupt)
+static uint8_t os_bits = 0;
+static uint32_t os_acc = 0;
+static uint16_t os_remaining = 0;
+static volatile uint16_t os_queue[SIMPLE_ADC_OVERSAMPLE_QUEUE];
+static volatile uint8_t os_head = 0;
+static volatile uint8_t os_tail = 0;
+static volatile uint16_t os_dropped = 0;
+
+// Oversampling result queue (SimpleHAL_RamReport())
+const uint16_t adc_ram_bytes = sizeof(os_queue);
+
+// Deinterleaved scan: view ต่อ channel (เขียนจาก DMA interrupt)
+static ADC_ScanView* scan_views = NULL;
+static uint8_t scan_count = 0;
+static uint16_t scan_frames = 0;  // frames ต่อครึ่ง buffer
+
+#if SIMPLE_ADC_WATCHDOG_IRQ
+// Analog watchdog
+static ADC_WatchdogCallback watchdog_callback = NULL;
+static ADC_Channel watchdog_channel = ADC_CH_0;
+#endif
 
 /* ========== Private Helper Functions ========== */
 
@@ -55,38 +93,109 @@ static uint16_t GetGPIOPin(ADC_Channel channel) {
   }
 }
 
+/**
+ * @brief Regular sequence กำลังถูกใช้โดย DMA stream หรือไม่
+ */
+static inline uint8_t ADC_RegularBusy(void) {
+  return (ADC1->CTLR2 & ADC_DMA) ? 1 : 0;
+}
+
+/**
+ * @brief Channel อยู่ใน regular sequence ปัจจุบันหรือไม่
+ */
+static uint8_t ADC_InRegularSequence(uint8_t adc_channel) {
+  uint8_t length = (uint8_t)(((ADC1->RSQR1 >> 20) & 0x0F) + 1);
+
+  for (uint8_t rank = 0; rank < length; rank++) {
+    uint32_t rsqr = (rank < 6) ? ADC1->RSQR3 : (rank < 12) ? ADC1->RSQR2 : ADC1->RSQR1;
+    uint8_t shift = (uint8_t)(5 * (rank % 6));
+    if (((rsqr >> shift) & 0x1F) == adc_channel) return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief แปลง 1 channel ผ่าน injected group (แทรก regular conversion ได้)
+ */
+static uint16_t ADC_ConvertInjected(uint8_t adc_channel, uint8_t sample_time) {
+  // Channel ที่ stream ใช้อยู่: คง sample time เดิมไว้ (SAMPTR ใช้ร่วมกับ regular)
+  if (ADC_RegularBusy() && ADC_InRegularSequence(adc_channel)) {
+    sample_time = (uint8_t)((ADC1->SAMPTR2 >> (3 * adc_channel)) & 0x07);
+  }
+
+  ADC_InjectedSequencerLengthConfig(ADC1, 1);
+  ADC_InjectedChannelConfig(ADC1, adc_channel, 1, sample_time);
+  ADC_ExternalTrigInjectedConvConfig(ADC1, ADC_ExternalTrigInjecConv_None);
+  ADC_ExternalTrigInjectedConvCmd(ADC1, ENABLE);
+
+  ADC_ClearFlag(ADC1, ADC_FLAG_JEOC);
+  ADC_SoftwareStartInjectedConvCmd(ADC1, ENABLE);
+
+  while (!ADC_GetFlagStatus(ADC1, ADC_FLAG_JEOC))
+    ;
+  ADC_ClearFlag(ADC1, ADC_FLAG_JEOC);
+
+  return ADC_GetInjectedConversionValue(ADC1, ADC_InjectedChannel_1);
+}
+
+/**
+ * @brief Reset + calibrate (ADC ต้องมี clock และ ADON แล้ว)
+ */
+static void ADC_RunCalibration(void) {
+  ADC_ResetCalibration(ADC1);
+  while (ADC_GetResetCalibrationStatus(ADC1))
+    ;
+  ADC_StartCalibration(ADC1);
+  while (ADC_GetCalibrationStatus(ADC1))
+    ;
+  adc_calibrated = 1;
+}
+
 /* ========== Public Functions ========== */
 
 /**
- * @brief เริ่มต้น ADC peripheral (internal)
+ * @brief Calibrate ADC ใหม่
  */
-static void ADC_InitPeripheral(void) {
+void ADC_Calibrate(void) {
+  if (!adc_calibrated) {
+    // ยังไม่เคย configure: เปิด clock + ADON และ calibrate ใน ADC_Configure()
+    ADC_Configure(ADC_ExternalTrigConv_None, 1, 0);
+    return;
+  }
+  ADC_RunCalibration();
+}
+
+/**
+ * @brief ตั้งค่าโหมดของ regular sequence (reset + calibrate เฉพาะครั้งแรก)
+ */
+void ADC_Configure(uint32_t trigger, uint8_t count, uint8_t continuous) {
   ADC_InitTypeDef ADC_InitStructure = {0};
 
-  // เปิด Clock สำหรับ ADC
-  RCC_APB2PeriphClockCmd(RCC_APB2Periph_ADC1, ENABLE);
-  RCC_ADCCLKConfig(RCC_PCLK2_Div8); // ADC Clock = PCLK2/8
+  if (!adc_calibrated) {
+    // เปิด Clock สำหรับ ADC
+    Clock_AcquireOnce(CLOCK_ADC1, &adc_clocks);
+    RCC_ADCCLKConfig(RCC_PCLK2_Div8); // ADC Clock = PCLK2/8
+    ADC_DeInit(ADC1);
+  } else {
+    // ปล่อย DMA/external trigger ของ stream ก่อนหน้า
+    ADC1->CTLR2 &= ~(ADC_DMA | ADC_EXTTRIG | ADC_CONT);
+  }
 
-  // ตั้งค่า ADC
-  ADC_DeInit(ADC1);
+  // ตั้งค่า ADC (เขียน CTLR1/CTLR2/RSQR1 เท่านั้น)
   ADC_InitStructure.ADC_Mode = ADC_Mode_Independent;
-  ADC_InitStructure.ADC_ScanConvMode = DISABLE;
-  ADC_InitStructure.ADC_ContinuousConvMode = DISABLE;
-  ADC_InitStructure.ADC_ExternalTrigConv = ADC_ExternalTrigConv_None;
+  ADC_InitStructure.ADC_ScanConvMode = (count > 1) ? ENABLE : DISABLE;
+  ADC_InitStructure.ADC_ContinuousConvMode = continuous ? ENABLE : DISABLE;
+  ADC_InitStructure.ADC_ExternalTrigConv = trigger;
   ADC_InitStructure.ADC_DataAlign = ADC_DataAlign_Right;
-  ADC_InitStructure.ADC_NbrOfChannel = 1;
+  ADC_InitStructure.ADC_NbrOfChannel = count;
   ADC_Init(ADC1, &ADC_InitStructure);
 
   // เปิดใช้งาน ADC
   ADC_Cmd(ADC1, ENABLE);
 
-  // Calibrate ADC
-  ADC_ResetCalibration(ADC1);
-  while (ADC_GetResetCalibrationStatus(ADC1))
-    ;
-  ADC_StartCalibration(ADC1);
-  while (ADC_GetCalibrationStatus(ADC1))
-    ;
+  if (!adc_calibrated) {
+    ADC_RunCalibration();
+  }
 }
 
 /**
@@ -98,13 +207,7 @@ void ADC_EnableChannel(ADC_Channel channel) {
   uint16_t gpio_pin = GetGPIOPin(channel);
 
   // เปิด Clock สำหรับ GPIO port ที่เกี่ยวข้อง
-  if (gpio_port == GPIOA) {
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);
-  } else if (gpio_port == GPIOC) {
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC, ENABLE);
-  } else if (gpio_port == GPIOD) {
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOD, ENABLE);
-  }
+  Clock_AcquireOnce(Clock_GPIOPeriph(gpio_port), &adc_clocks);
 
   // ตั้งค่า GPIO เป็น Analog Input
   GPIO_InitStructure.GPIO_Pin = gpio_pin;
@@ -117,7 +220,7 @@ void ADC_EnableChannel(ADC_Channel channel) {
  */
 void ADC_SimpleInitChannels(ADC_Channel *channels, uint8_t count) {
   // เริ่มต้น ADC peripheral
-  ADC_InitPeripheral();
+  ADC_Configure(ADC_ExternalTrigConv_None, 1, 0);
 
   // เปิดใช้งานเฉพาะ channels ที่ระบุ
   for (uint8_t i = 0; i < count; i++) {
@@ -149,6 +252,11 @@ void ADC_SimpleInit(void) {
 uint16_t ADC_Read(ADC_Channel channel) {
   uint8_t adc_channel = GetADCChannel(channel);
 
+  // DMA stream ถือ regular sequence อยู่: อ่านผ่าน injected แทนการตั้งค่าใหม่
+  if (ADC_RegularBusy()) {
+    return ADC_ConvertInjected(adc_channel, ADC_SampleTime_241Cycles);
+  }
+
   // ตั้งค่า channel และ sample time
   ADC_RegularChannelConfig(ADC1, adc_channel, 1, ADC_SampleTime_241Cycles);
 
@@ -163,6 +271,13 @@ uint16_t ADC_Read(ADC_Channel channel) {
   return ADC_GetConversionValue(ADC1);
 }
 
+/**
+ * @brief อ่านค่า ADC ผ่าน injected group
+ */
+uint16_t ADC_ReadInjected(ADC_Channel channel) {
+  return ADC_ConvertInjected(GetADCChannel(channel), ADC_SampleTime_241Cycles);
+}
+
 /**
  * @brief อ่านค่า ADC จากหลายช่อง
  */
@@ -172,6 +287,7 @@ void ADC_ReadMultiple(ADC_Channel *channels, uint16_t *values, uint8_t count) {
   }
 }
 
+#if SIMPLE_ADC_FLOAT
 /**
  * @brief แปลงค่า ADC เป็น voltage
  */
@@ -186,6 +302,7 @@ float ADC_ReadVoltage(ADC_Channel channel, float vref) {
   uint16_t adc_value = ADC_Read(channel);
   return ADC_ToVoltage(adc_value, vref);
 }
+#endif
 
 /**
  * @brief อ่านค่า ADC แบบ average หลายครั้ง
@@ -201,12 +318,14 @@ uint16_t ADC_ReadAverage(ADC_Channel channel, uint8_t samples) {
   return (uint16_t)(sum / samples);
 }
 
+#if SIMPLE_ADC_FLOAT
 /**
  * @brief แปลงค่า ADC เป็นเปอร์เซ็นต์
  */
 float ADC_ToPercent(uint16_t adc_value) {
   return ((float)adc_value / (float)ADC_MAX_VALUE) * 100.0f;
 }
+#endif
 
 /* ========== Internal Channel Functions ========== */
 
@@ -214,6 +333,10 @@ float ADC_ToPercent(uint16_t adc_value) {
  * @brief อ่านค่า Internal Reference Voltage (Vrefint)
  */
 uint16_t ADC_ReadVrefInt(void) {
+  if (ADC_RegularBusy()) {
+    return ADC_ConvertInjected(ADC_Channel_Vrefint, ADC_SampleTime_241Cycles);
+  }
+
   // ตั้งค่า channel และ sample time สำหรับ internal channel
   // Internal channels ต้องใช้ sample time ที่นานกว่า (241 cycles)
   ADC_RegularChannelConfig(ADC1, ADC_Channel_Vrefint, 1, ADC_SampleTime_241Cycles);
@@ -230,16 +353,24 @@ uint16_t ADC_ReadVrefInt(void) {
 }
 
 /**
- * @brief คำนวณแรงดัน VDD จริงจาก Vrefint
+ * @brief อ่านค่า Vrefint เฉลี่ย 10 ครั้ง
  */
-float ADC_GetVDD(void) {
-  // อ่านค่า Vrefint หลายครั้งและหาค่าเฉลี่ย
+static uint16_t ADC_ReadVrefIntAverage(void) {
   uint32_t sum = 0;
   for (uint8_t i = 0; i < 10; i++) {
     sum += ADC_ReadVrefInt();
     Delay_Us(100);
   }
-  uint16_t vrefint_adc = (uint16_t)(sum / 10);
+  return (uint16_t)(sum / 10);
+}
+
+#if SIMPLE_ADC_FLOAT
+/**
+ * @brief คำนวณแรงดัน VDD จริงจาก Vrefint
+ */
+float ADC_GetVDD(void) {
+  // อ่านค่า Vrefint หลายครั้งและหาค่าเฉลี่ย
+  uint16_t vrefint_adc = ADC_ReadVrefIntAverage();
 
   // คำนวณ VDD: VDD = VREFINT_VOLTAGE × ADC_MAX_VALUE / vrefint_adc
   // ถ้า vrefint_adc = 0 ให้คืนค่า default 3.3V
@@ -281,3 +412,504 @@ float ADC_GetBatteryPercent(float vdd, float v_min, float v_max) {
 
   return percent;
 }
+#endif
+
+/* ========== Fixed-Point Functions ========== */
+
+/**
+ * @brief คำนวณแรงดัน VDD จริงจาก Vrefint (mV)
+ */
+uint16_t ADC_GetVDD_mV(void) {
+  uint16_t vrefint_adc = ADC_ReadVrefIntAverage();
+
+  if (vrefint_adc == 0) {
+    return 3300;
+  }
+
+  // VDD = VREFINT_MV × ADC_MAX_VALUE / vrefint_adc (ปัดเศษ)
+  return (uint16_t)(((uint32_t)ADC_VREFINT_MV * ADC_MAX_VALUE + (vrefint_adc >> 1)) / vrefint_adc);
+}
+
+/**
+ * @brief อ่านค่า ADC พร้อมชดเชยความผันผวนของ VDD (mV)
+ */
+uint16_t ADC_ReadMillivoltsCompensated(ADC_Channel channel) {
+  uint16_t vrefint_adc = ADC_ReadVrefIntAverage();
+  uint16_t adc_value = ADC_Read(channel);
+
+  if (vrefint_adc == 0) {
+    return ADC_ToMillivolts(adc_value, 3300);
+  }
+
+  // mV = adc × VDD / 1023 = adc × VREFINT_MV / vrefint_adc
+  return (uint16_t)(((uint32_t)adc_value * ADC_VREFINT_MV + (vrefint_adc >> 1)) / vrefint_adc);
+}
+
+/**
+ * @brief คำนวณเปอร์เซ็นต์แบตเตอรี่ (หน่วย 0.1%)
+ */
+uint16_t ADC_GetBatteryPercent_x10(uint16_t vdd_mv, uint16_t v_min_mv, uint16_t v_max_mv) {
+  if (vdd_mv <= v_min_mv || v_max_mv <= v_min_mv) {
+    return 0;
+  }
+  if (vdd_mv >= v_max_mv) {
+    return 1000;
+  }
+
+  return (uint16_t)(((uint32_t)(vdd_mv - v_min_mv) * 1000) / (uint16_t)(v_max_mv - v_min_mv));
+}
+
+/* ========== Timer-Triggered Sampling ========== */
+
+/**
+ * @brief เลือก sample time ที่ยาวที่สุดที่ทันกับ budget (ADC clocks ต่อ channel)
+ * @return ADC_SampleTime_x หรือ 0xFF ถ้าเร็วเกินไป
+ */
+static uint8_t ADC_PickSampleTime(uint32_t budget) {
+  static const uint8_t cycles[] = {3, 9, 15, 30, 43, 57, 73, 241};
+
+  // Conversion = sample time + 11 ADC clocks (10-bit)
+  for (int8_t i = 7; i >= 0; i--) {
+    if ((uint32_t)cycles[i] + 11 <= budget) {
+      return (uint8_t)i;  // ADC_SampleTime_x เรียงตาม index
+    }
+  }
+  return 0xFF;
+}
+
+/**
+ * @brief DMA ครบ buffer: ส่งต่อให้ callback ของผู้ใช้
+ */
+static void ADC_SamplingDmaDone(DMA_Channel channel) {
+  (void)channel;
+  if (sampling_active && sampling_callback != NULL) {
+    sampling_callback(sampling_buffer, sampling_length);
+  }
+}
+
+/**
+ * @brief ตั้งค่า ADC + DMA + timer สำหรับสุ่มตัวอย่าง (DMA ยังไม่มี callback)
+ * @return 1 = สำเร็จ, 0 = parameter ผิด
+ */
+static uint8_t ADC_SamplingSetup(const ADC_Channel* channels, uint8_t count, uint32_t sample_rate_hz,
+                                 uint16_t* buffer, uint16_t length) {
+  if (channels == NULL || buffer == NULL || count == 0 || count > 16 || sample_rate_hz == 0) {
+    return 0;
+  }
+
+  // buffer ต้องเก็บได้ครบทุก sequence
+  length -= length % count;
+  if (length == 0) return 0;
+
+  uint8_t sample_time = ADC_PickSampleTime((SystemCoreClock / 8) / (sample_rate_hz * count));
+  if (sample_time == 0xFF) return 0;
+
+  ADC_StopSampling();
+
+  // CH1 เป็น channel ตายตัวของ ADC1 request: ไม่ว่างถ้า DMA_analogReadStart() ถืออยู่
+  if (DMA_AllocChannel(DMA_REQ_ADC1) == DMA_CH_NONE) return 0;
+
+  TIM_Instance timer = SIMPLE_ADC_SAMPLING_TIMER;
+  TIM_TypeDef* TIMx = (timer == TIM_1) ? TIM1 : TIM2;
+  uint32_t trigger = (timer == TIM_1) ? ADC_ExternalTrigConv_T1_TRGO : ADC_ExternalTrigConv_T2_TRGO;
+
+  // ADC: regular sequence ทั้งหมดต่อ 1 trigger
+  for (uint8_t i = 0; i < count; i++) {
+    ADC_EnableChannel(channels[i]);
+  }
+  ADC_Configure(trigger, count, 0);
+  for (uint8_t i = 0; i < count; i++) {
+    ADC_RegularChannelConfig(ADC1, GetADCChannel(channels[i]), i + 1, sample_time);
+  }
+  ADC_ExternalTrigConvCmd(ADC1, ENABLE);
+
+  sampling_buffer = buffer;
+  sampling_length = length;
+  sampling_active = 1;
+
+  // DMA: circular
+  DMA_ADC_Init(DMA_CH1, buffer, length, 1);
+
+  // Timer: update event -> TRGO -> ADC trigger (เริ่มใน ADC_SamplingRun)
+  TIM_SimpleInit(timer, sample_rate_hz);
+  TIM_SelectOutputTrigger(TIMx, TIM_TRGOSource_Update);
+
+  return 1;
+}
+
+/**
+ * @brief เริ่ม DMA และ timer หลังตั้ง callback แล้ว
+ */
+static void ADC_SamplingRun(void) {
+  DMA_Start(DMA_CH1);
+  TIM_Start(SIMPLE_ADC_SAMPLING_TIMER);
+}
+
+/**
+ * @brief เริ่มสุ่มตัวอย่าง ADC ด้วยอัตราคงที่ (timer TRGO + DMA)
+ */
+uint8_t ADC_StartSampling(const ADC_Channel* channels, uint8_t count, uint32_t sample_rate_hz,
+                          uint16_t* buffer, uint16_t length, ADC_SampleCallback callback) {
+  if (!ADC_SamplingSetup(channels, count, sample_rate_hz, buffer, length)) return 0;
+
+  // interrupt เฉพาะเมื่อครบ buffer
+  sampling_callback = callback;
+  if (callback != NULL) {
+    DMA_SetTransferCompleteCallback(DMA_CH1, ADC_SamplingDmaDone);
+  }
+
+  ADC_SamplingRun();
+  return 1;
+}
+
+/**
+ * @brief หยุดการสุ่มตัวอย่าง
+ */
+void ADC_StopSampling(void) {
+  if (!sampling_active) return;
+
+  TIM_Stop(SIMPLE_ADC_SAMPLING_TIMER);
+  ADC_ExternalTrigConvCmd(ADC1, DISABLE);
+  ADC_DMACmd(ADC1, DISABLE);
+  DMA_ITConfig(DMA1_Channel1, DMA_IT_TC, DISABLE);
+  DMA_SetHalfTransferCallback(DMA_CH1, NULL);
+  DMA_Stop(DMA_CH1);
+  DMA_FreeChannel(DMA_CH1);
+  sampling_active = 0;
+  sampling_callback = NULL;
+
+  // กลับไปโหมด software trigger สำหรับ ADC_Read()
+  ADC_Configure(ADC_ExternalTrigConv_None, 1, 0);
+}
+
+/**
+ * @brief ตรวจสอบว่ากำลังสุ่มตัวอย่างอยู่หรือไม่
+ */
+uint8_t ADC_SamplingBusy(void) {
+  return sampling_active;
+}
+
+/**
+ * @brief ตำแหน่งที่ DMA จะเขียนถัดไปใน buffer
+ */
+uint16_t ADC_SamplingPosition(void) {
+  if (!sampling_active) return 0;
+  return sampling_length - DMA_GetRemainingCount(DMA_CH1);
+}
+
+/* ========== Oversampling / Decimation ========== */
+
+/**
+ * @brief สะสม samples ของครึ่ง buffer แล้วส่งผลลัพธ์เข้า queue
+ */
+static void ADC_OversampleBlock(const uint16_t* samples, uint16_t n) {
+  uint32_t acc = os_acc;
+  uint16_t remaining = os_remaining;
+
+  while (n--) {
+    acc += *samples++;
+    if (--remaining == 0) {
+      uint8_t next = (uint8_t)((os_head + 1) & (SIMPLE_ADC_OVERSAMPLE_QUEUE - 1));
+      if (next != os_tail) {
+        os_queue[os_head] = (uint16_t)(acc >> os_bits);
+        os_head = next;
+      } else {
+        os_dropped++;
+      }
+      acc = 0;
+      remaining = (uint16_t)(1u << (2 * os_bits));
+    }
+  }
+
+  os_acc = acc;
+  os_remaining = remaining;
+}
+
+/**
+ * @brief DMA ครบครึ่งแรก
+ */
+static void ADC_OversampleHalf(DMA_Channel channel) {
+  (void)channel;
+  if (!sampling_active) return;
+  ADC_OversampleBlock(sampling_buffer, sampling_length >> 1);
+}
+
+/**
+ * @brief DMA ครบครึ่งหลัง
+ */
+static void ADC_OversampleFull(DMA_Channel channel) {
+  (void)channel;
+  if (!sampling_active) return;
+  uint16_t half = sampling_length >> 1;
+  ADC_OversampleBlock(sampling_buffer + half, half);
+}
+
+/**
+ * @brief เริ่ม oversampling แบบ streaming
+ */
+uint8_t ADC_StartOversampling(ADC_Channel channel, uint32_t sample_rate_hz, uint8_t extra_bits,
+                              uint16_t* dma_buffer, uint16_t dma_length) {
+  if (extra_bits == 0 || extra_bits > ADC_OVERSAMPLE_MAX_BITS) return 0;
+
+  // ครึ่ง buffer ต้องเท่ากันพอดี
+  dma_length &= (uint16_t)~1u;
+  if (!ADC_SamplingSetup(&channel, 1, sample_rate_hz, dma_buffer, dma_length)) return 0;
+
+  os_bits = extra_bits;
+  os_acc = 0;
+  os_remaining = (uint16_t)(1u << (2 * extra_bits));
+  os_head = 0;
+  os_tail = 0;
+  os_dropped = 0;
+
+  DMA_SetHalfTransferCallback(DMA_CH1, ADC_OversampleHalf);
+  DMA_SetTransferCompleteCallback(DMA_CH1, ADC_OversampleFull);
+
+  ADC_SamplingRun();
+  return 1;
+}
+
+/**
+ * @brief จำนวนผลลัพธ์ที่รออ่านใน queue
+ */
+uint8_t ADC_OversampleAvailable(void) {
+  return (uint8_t)((os_head - os_tail) & (SIMPLE_ADC_OVERSAMPLE_QUEUE - 1));
+}
+
+/**
+ * @brief อ่านผลลัพธ์ที่เก่าที่สุดจาก queue
+ */
+uint8_t ADC_OversampleRead(uint16_t* value) {
+  uint8_t tail = os_tail;
+
+  if (tail == os_head) return 0;
+
+  *value = os_queue[tail];
+  os_tail = (uint8_t)((tail + 1) & (SIMPLE_ADC_OVERSAMPLE_QUEUE - 1));
+  return 1;
+}
+
+/**
+ * @brief จำนวนผลลัพธ์ที่หายเพราะ queue เต็ม
+ */
+uint16_t ADC_OversampleDropped(void) {
+  return os_dropped;
+}
+
+/* ========== Deinterleaved Scan ========== */
+
+/**
+ * @brief ปิด IRQ และจำสถานะเดิม
+ */
+static inline uint32_t ADC_Lock(void) {
+  uint32_t mstatus;
+  __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+  return mstatus;
+}
+
+static inline void ADC_Unlock(uint32_t mstatus) {
+  if (mstatus & 0x8) {
+    __asm volatile ("csrsi mstatus, 0x8");
+  }
+}
+
+/**
+ * @brief แยก frames ของครึ่ง buffer ลง view ของแต่ละ channel
+ */
+static void ADC_ScanBlock(const uint16_t* samples, uint16_t frames) {
+  ADC_ScanView* views = scan_views;
+  uint8_t count = scan_count;
+
+  while (frames--) {
+    for (uint8_t i = 0; i < count; i++) {
+      ADC_ScanView* view = &views[i];
+      uint16_t sample = *samples++;
+      uint16_t mask = (uint16_t)((1u << view->shift) - 1);
+
+      if (!view->primed) {
+        // sample แรกเติมทั้ง ring (ค่าเฉลี่ยไม่ ramp จาก 0)
+        for (uint16_t j = 0; j <= mask; j++) {
+          view->ring[j] = sample;
+        }
+        view->sum = (uint32_t)sample << view->shift;
+        view->primed = 1;
+      }
+
+      uint16_t index = view->head & mask;
+      view->sum += (uint32_t)sample - view->ring[index];
+      view->ring[index] = sample;
+      view->head++;
+      view->latest = sample;
+      if (sample < view->min) view->min = sample;
+      if (sample > view->max) view->max = sample;
+    }
+  }
+}
+
+/**
+ * @brief DMA ครบครึ่งแรก
+ */
+static void ADC_ScanHalf(DMA_Channel channel) {
+  (void)channel;
+  if (!sampling_active) return;
+  ADC_ScanBlock(sampling_buffer, scan_frames);
+}
+
+/**
+ * @brief DMA ครบครึ่งหลัง
+ */
+static void ADC_ScanFull(DMA_Channel channel) {
+  (void)channel;
+  if (!sampling_active) return;
+  ADC_ScanBlock(sampling_buffer + (sampling_length >> 1), scan_frames);
+}
+
+/**
+ * @brief เริ่มต้น view ของ channel
+ */
+void ADC_ScanViewInit(ADC_ScanView* view, uint16_t* ring, uint8_t shift) {
+  if (shift > 8) shift = 8;
+
+  view->ring = ring;
+  view->shift = shift;
+  view->head = 0;
+  view->sum = 0;
+  view->latest = 0;
+  view->primed = 0;
+  view->min = 0xFFFF;
+  view->max = 0;
+}
+
+/**
+ * @brief เริ่ม scan หลาย channels แยกใส่ view ของแต่ละ channel
+ */
+uint8_t ADC_StartScan(const ADC_Channel* channels, uint8_t count, uint32_t sample_rate_hz,
+                      uint16_t* dma_buffer, uint16_t dma_length, ADC_ScanView* views) {
+  if (views == NULL || count == 0) return 0;
+
+  for (uint8_t i = 0; i < count; i++) {
+    if (views[i].ring == NULL) return 0;
+  }
+
+  // ครึ่ง buffer ต้องมี frames ครบ (คำนวณครั้งเดียวตอนเริ่ม)
+  uint16_t frame2 = (uint16_t)count * 2;
+  dma_length -= dma_length % frame2;
+  if (!ADC_SamplingSetup(channels, count, sample_rate_hz, dma_buffer, dma_length)) return 0;
+
+  scan_views = views;
+  scan_count = count;
+  scan_frames = dma_length / frame2;
+
+  DMA_SetHalfTransferCallback(DMA_CH1, ADC_ScanHalf);
+  DMA_SetTransferCompleteCallback(DMA_CH1, ADC_ScanFull);
+
+  ADC_SamplingRun();
+  return 1;
+}
+
+/**
+ * @brief Copy samples ล่าสุดของ view (เก่าสุดก่อน)
+ */
+uint16_t ADC_ScanCopy(const ADC_ScanView* view, uint16_t* out, uint16_t n) {
+  uint16_t size = (uint16_t)(1u << view->shift);
+  uint16_t mask = size - 1;
+
+  if (n > size) n = size;
+
+  uint32_t mstatus = ADC_Lock();
+  if (!view->primed) n = 0;
+  uint16_t index = (uint16_t)(view->head - n);
+  for (uint16_t i = 0; i < n; i++) {
+    out[i] = view->ring[(index + i) & mask];
+  }
+  ADC_Unlock(mstatus);
+
+  return n;
+}
+
+/**
+ * @brief ล้าง min/max ของ view
+ */
+void ADC_ScanResetMinMax(ADC_ScanView* view) {
+  uint32_t mstatus = ADC_Lock();
+  view->min = 0xFFFF;
+  view->max = 0;
+  ADC_Unlock(mstatus);
+}
+
+/* ========== Analog Watchdog ========== */
+
+/**
+ * @brief ตั้งค่า analog watchdog
+ */
+void ADC_SetWatchdog(ADC_Channel channel, uint16_t low, uint16_t high, ADC_WatchdogCallback callback) {
+  ADC_ITConfig(ADC1, ADC_IT_AWD, DISABLE);
+
+#if SIMPLE_ADC_WATCHDOG_IRQ
+  watchdog_channel = channel;
+  watchdog_callback = callback;
+#else
+  (void)callback;  // ไม่มี ADC1_IRQHandler: ใช้ ADC_WatchdogTriggered()
+#endif
+
+  // เฝ้าทั้ง regular (ADC_Read, DMA stream) และ injected (ADC_ReadInjected)
+  ADC_AnalogWatchdogThresholdsConfig(ADC1, high, low);
+  ADC_AnalogWatchdogSingleChannelConfig(ADC1, GetADCChannel(channel));
+  ADC_AnalogWatchdogCmd(ADC1, ADC_AnalogWatchdog_SingleRegOrInjecEnable);
+
+#if SIMPLE_ADC_WATCHDOG_IRQ
+  if (callback != NULL) {
+    ADC_WatchdogRearm();
+    NVIC_EnableIRQ(ADC_IRQn);
+  }
+#endif
+}
+
+/**
+ * @brief เปิด watchdog interrupt อีกครั้งหลังจาก callback
+ */
+void ADC_WatchdogRearm(void) {
+  ADC_ClearFlag(ADC1, ADC_FLAG_AWD);
+  ADC_ITConfig(ADC1, ADC_IT_AWD, ENABLE);
+}
+
+/**
+ * @brief ปิด analog watchdog
+ */
+void ADC_ClearWatchdog(void) {
+  ADC_ITConfig(ADC1, ADC_IT_AWD, DISABLE);
+  ADC_AnalogWatchdogCmd(ADC1, ADC_AnalogWatchdog_None);
+  ADC_ClearFlag(ADC1, ADC_FLAG_AWD);
+#if SIMPLE_ADC_WATCHDOG_IRQ
+  watchdog_callback = NULL;
+#endif
+}
+
+/**
+ * @brief ตรวจสอบ (และล้าง) flag ของ watchdog แบบ polling
+ */
+uint8_t ADC_WatchdogTriggered(void) {
+  if (!ADC_GetFlagStatus(ADC1, ADC_FLAG_AWD)) return 0;
+  ADC_ClearFlag(ADC1, ADC_FLAG_AWD);
+  return 1;
+}
+
+#if SIMPLE_ADC_WATCHDOG_IRQ
+/**
+ * @brief ADC interrupt handler (analog watchdog)
+ */
+void ADC1_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+void ADC1_IRQHandler(void) {
+  ISR_STAT_ENTER(ISR_STAT_ADC);
+  if (ADC_GetITStatus(ADC1, ADC_IT_AWD) != RESET) {
+    // Latch: ปิด interrupt จนกว่าจะ ADC_WatchdogRearm() (ไม่ท่วม ISR ระหว่าง stream)
+    ADC_ITConfig(ADC1, ADC_IT_AWD, DISABLE);
+    ADC_ClearITPendingBit(ADC1, ADC_IT_AWD);
+
+    if (watchdog_callback != NULL) {
+      watchdog_callback(watchdog_channel);
+    }
+  }
+  ISR_STAT_EXIT(ISR_STAT_ADC);
+}
+#endif  // SIMPLE_ADC_WATCHDOG_IRQ
@@ -1,8 +1,8 @@
 /**
  * @file SimpleADC.h
  * @brief Simple ADC Library สำหรับ CH32V003 แบบ Arduino-style
- * @version 1.0
- * @date 2025-12-12
+ * @version 1.2
+ * @date 2026-10-14
  * 
  * @details
  * Library นี้ห่อหุ้ม Hardware ADC ให้ใช้งานง่ายแบบ Arduino analogRead()
@@ -13,6 +13,13 @@
  * - แปลงค่าเป็น voltage อัตโนมัติ
  * - รองรับ 10-bit resolution
  * - API แบบ Arduino analogRead()
+ * - สุ่มตัวอย่างอัตราคงที่ด้วย timer trigger + DMA (ADC_StartSampling)
+ * - Scan หลาย channels แยกเป็น view ต่อ channel (latest/min/max/average + ring)
+ * - อ่านแทรกระหว่าง DMA stream ผ่าน injected group (ADC_ReadInjected)
+ * - แปลงเป็น mV / 0.1% แบบ integer (ไม่ดึง soft-float เข้ามา)
+ * - Oversampling แบบ streaming จาก DMA half/full interrupts (11-14 bits)
+ * - Reset + calibrate ครั้งเดียว การเปลี่ยนโหมด/channel ภายหลังเขียนแค่ registers
+ * - Analog watchdog: interrupt ทันทีเมื่อค่าออกนอกช่วง (ไม่ต้อง poll)
  * 
  * **ADC Channels ของ CH32V003:**
  * - Channel 0 (PA2) - GPIOA Pin 2
@@ -57,6 +64,33 @@ extern "C" {
 
 #include <ch32v00x.h>
 #include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief Timer ที่ใช้ trigger ADC_StartSampling() (TIM_1 หรือ TIM_2)
+ * @note Timer นี้ถูกใช้เต็มตัวระหว่างสุ่มตัวอย่าง (ห้ามใช้ทำ PWM พร้อมกัน)
+ */
+#ifndef SIMPLE_ADC_SAMPLING_TIMER
+#define SIMPLE_ADC_SAMPLING_TIMER  TIM_2
+#endif
+
+/**
+ * @brief เปิด/ปิดฟังก์ชันแบบ float (0 = compile ออก เหลือเฉพาะแบบ mV)
+ * @note Soft-float บน RV32EC ใช้หลายร้อย cycles ต่อครั้งและ flash หลาย KB
+ * @note ค่าเริ่มต้นตาม SIMPLE_HAL_FLOAT (SimpleHAL_Config.h)
+ */
+#ifndef SIMPLE_ADC_FLOAT
+#define SIMPLE_ADC_FLOAT SIMPLE_HAL_FLOAT
+#endif
+
+/**
+ * @brief ขนาด queue ผลลัพธ์ของ oversampling (ต้องเป็นกำลังของ 2, เก็บได้ขนาด - 1)
+ */
+#ifndef SIMPLE_ADC_OVERSAMPLE_QUEUE
+#define SIMPLE_ADC_OVERSAMPLE_QUEUE 16
+#endif
 
 /* ========== Enumerations ========== */
 
@@ -118,6 +152,45 @@ typedef enum {
  */
 #define ADC_VREFINT_VOLTAGE  1.2f   /**< Internal Vref voltage (V) - typical 1.2V */
 #define ADC_VREFINT_CAL      512    /**< Typical Vrefint ADC value at 3.3V VDD */
+#define ADC_VREFINT_MV       1200   /**< Internal Vref voltage (mV) */
+
+/**
+ * @brief จำนวนบิตเพิ่มสูงสุดของ oversampling (4 bits = 256 samples ต่อผลลัพธ์ = 14-bit)
+ */
+#define ADC_OVERSAMPLE_MAX_BITS  4
+
+/**
+ * @brief Scale factor Q16 สำหรับแปลงค่า ADC เป็น mV (adc × scale >> 16)
+ * @note ค่าคงที่ถูกคำนวณตอน compile เมื่อ vref_mv เป็นค่าคงที่
+ */
+#define ADC_MV_SCALE_Q16(vref_mv)  ((((uint32_t)(vref_mv) << 16) + (ADC_MAX_VALUE / 2)) / ADC_MAX_VALUE)
+
+/**
+ * @brief Callback เมื่อ DMA เขียนครบ buffer (เรียกจาก DMA interrupt)
+ * @param buffer buffer ของ ADC_StartSampling()
+ * @param length จำนวน samples ใน buffer
+ */
+typedef void (*ADC_SampleCallback)(uint16_t* buffer, uint16_t length);
+
+/**
+ * @brief Callback เมื่อค่าออกนอกช่วงของ analog watchdog (เรียกจาก ADC interrupt)
+ * @param channel channel ที่ถูกเฝ้าอยู่
+ */
+typedef void (*ADC_WatchdogCallback)(ADC_Channel channel);
+
+/**
+ * @brief ข้อมูลของ channel หนึ่งใน ADC_StartScan() (เขียนจาก DMA interrupt)
+ */
+typedef struct {
+    uint16_t* ring;           /**< ring ของผู้เรียก [1 << shift] */
+    volatile uint32_t sum;    /**< ผลรวมของ ring (moving average) */
+    volatile uint16_t head;   /**< จำนวน samples ที่เขียนแล้ว (index = head & mask) */
+    volatile uint16_t latest; /**< sample ล่าสุด */
+    volatile uint16_t min;    /**< ค่าต่ำสุดตั้งแต่ reset */
+    volatile uint16_t max;    /**< ค่าสูงสุดตั้งแต่ reset */
+    uint8_t shift;            /**< log2 ของขนาด ring (0-8) */
+    volatile uint8_t primed;  /**< มี sample แล้ว */
+} ADC_ScanView;
 
 /* ========== Function Prototypes ========== */
 
@@ -145,6 +218,26 @@ void ADC_SimpleInit(void);
  */
 void ADC_SimpleInitChannels(ADC_Channel* channels, uint8_t count);
 
+/**
+ * @brief ตั้งค่าโหมดของ regular sequence
+ * @param trigger ADC_ExternalTrigConv_x (ADC_ExternalTrigConv_None = software start)
+ * @param count จำนวน channels ใน sequence (>1 = scan mode)
+ * @param continuous 1 = continuous conversion
+ * 
+ * @note ครั้งแรก: เปิด clock, reset และ calibrate ADC
+ *       ครั้งถัดไป: เขียนแค่ CTLR1/CTLR2/RSQR1 (ไม่มี busy-wait) และปิด DMA/external trigger เดิม
+ * @note ไม่ต้องเรียกเองถ้าใช้ ADC_SimpleInit() หรือ DMA_analogReadStart()
+ */
+void ADC_Configure(uint32_t trigger, uint8_t count, uint8_t continuous);
+
+/**
+ * @brief Calibrate ADC ใหม่ (เช่นหลังอุณหภูมิหรือ VDD เปลี่ยนมาก)
+ * 
+ * @note ADC_Configure() calibrate ให้ครั้งแรกอยู่แล้ว ค่านี้ถูก cache ไว้จนกว่าจะเรียกใหม่
+ * @note ถ้าเรียกก่อน ADC_Configure() จะ configure แบบ single conversion ให้ก่อน (เปิด clock แล้วจึง calibrate)
+ */
+void ADC_Calibrate(void);
+
 /**
  * @brief เปิดใช้งาน ADC channel เพิ่มเติม
  * @param channel ADC channel ที่ต้องการเปิด
@@ -162,11 +255,31 @@ void ADC_EnableChannel(ADC_Channel channel);
  * @param channel ADC channel ที่ต้องการอ่าน
  * @return ค่า ADC (0-1023)
  * 
+ * @note ระหว่าง DMA stream (ADC_StartSampling, DMA_analogReadStart)
+ *       จะอ่านผ่าน ADC_ReadInjected() อัตโนมัติ
+ * 
  * @example
  * uint16_t value = ADC_Read(ADC_CH_A0);
  */
 uint16_t ADC_Read(ADC_Channel channel);
 
+/**
+ * @brief อ่านค่า ADC ผ่าน injected group
+ * @param channel ADC channel ที่ต้องการอ่าน
+ * @return ค่า ADC (0-1023)
+ * 
+ * @details Injected conversion แทรก regular conversion ที่กำลังทำอยู่
+ *          แล้ว regular sequence ทำต่อเอง ไม่ต้องหยุดหรือตั้งค่า DMA stream ใหม่
+ * 
+ * @note Regular conversion ที่ถูกแทรกจะเริ่มใหม่ (sample นั้นช้าลง 1 conversion)
+ * @note Channel ที่อยู่ใน stream ใช้ sample time เดิมของ stream
+ * 
+ * @example
+ * ADC_StartSampling(ch, 1, 8000, audio, 256, on_block);
+ * uint16_t battery = ADC_ReadInjected(ADC_CH_PA2);  // stream ไม่สะดุด
+ */
+uint16_t ADC_ReadInjected(ADC_Channel channel);
+
 /**
  * @brief อ่านค่า ADC จากหลายช่อง
  * @param channels array ของ channels ที่ต้องการอ่าน
@@ -180,6 +293,7 @@ uint16_t ADC_Read(ADC_Channel channel);
  */
 void ADC_ReadMultiple(ADC_Channel* channels, uint16_t* values, uint8_t count);
 
+#if SIMPLE_ADC_FLOAT
 /**
  * @brief แปลงค่า ADC เป็น voltage
  * @param adc_value ค่า ADC (0-1023)
@@ -202,6 +316,7 @@ float ADC_ToVoltage(uint16_t adc_value, float vref);
  * float voltage = ADC_ReadVoltage(ADC_CH_A0, 3.3);
  */
 float ADC_ReadVoltage(ADC_Channel channel, float vref);
+#endif
 
 /**
  * @brief อ่านค่า ADC แบบ average หลายครั้ง
@@ -216,6 +331,7 @@ float ADC_ReadVoltage(ADC_Channel channel, float vref);
  */
 uint16_t ADC_ReadAverage(ADC_Channel channel, uint8_t samples);
 
+#if SIMPLE_ADC_FLOAT
 /**
  * @brief แปลงค่า ADC เป็นเปอร์เซ็นต์
  * @param adc_value ค่า ADC (0-1023)
@@ -226,6 +342,7 @@ uint16_t ADC_ReadAverage(ADC_Channel channel, uint8_t samples);
  * float percent = ADC_ToPercent(adc);
  */
 float ADC_ToPercent(uint16_t adc_value);
+#endif
 
 /* ========== Internal Channel Functions ========== */
 
@@ -240,6 +357,7 @@ float ADC_ToPercent(uint16_t adc_value);
  */
 uint16_t ADC_ReadVrefInt(void);
 
+#if SIMPLE_ADC_FLOAT
 /**
  * @brief คำนวณแรงดัน VDD จริงจาก Vrefint
  * @return แรงดัน VDD (V)
@@ -283,6 +401,292 @@ float ADC_ReadVoltageCompensated(ADC_Channel channel);
  * float percent = ADC_GetBatteryPercent(vdd, 2.0, 3.2);
  */
 float ADC_GetBatteryPercent(float vdd, float v_min, float v_max);
+#endif
+
+/* ========== Fixed-Point Functions ========== */
+
+/**
+ * @brief แปลงค่า ADC เป็น mV (integer, Q16 scale)
+ * @param adc_value ค่า ADC (0-1023)
+ * @param vref_mv แรงดันอ้างอิง (mV) - ปกติใช้ 3300
+ * @return แรงดัน (mV)
+ * 
+ * @note เมื่อ vref_mv เป็นค่าคงที่ เหลือแค่ 1 multiply + shift
+ * 
+ * @example
+ * uint16_t mv = ADC_ToMillivolts(ADC_Read(ADC_CH_PD2), 3300);
+ */
+static inline uint16_t ADC_ToMillivolts(uint16_t adc_value, uint16_t vref_mv) {
+    return (uint16_t)(((uint32_t)adc_value * ADC_MV_SCALE_Q16(vref_mv) + 0x8000) >> 16);
+}
+
+/**
+ * @brief อ่านค่า ADC และแปลงเป็น mV ทันที
+ * @param channel ADC channel
+ * @param vref_mv แรงดันอ้างอิง (mV)
+ * @return แรงดัน (mV)
+ */
+static inline uint16_t ADC_ReadMillivolts(ADC_Channel channel, uint16_t vref_mv) {
+    return ADC_ToMillivolts(ADC_Read(channel), vref_mv);
+}
+
+/**
+ * @brief แปลงค่า ADC เป็นเปอร์เซ็นต์ (หน่วย 0.1%)
+ * @param adc_value ค่า ADC (0-1023)
+ * @return 0-1000 (1000 = 100.0%)
+ */
+static inline uint16_t ADC_ToPercent_x10(uint16_t adc_value) {
+    return ADC_ToMillivolts(adc_value, 1000);
+}
+
+/**
+ * @brief คำนวณแรงดัน VDD จริงจาก Vrefint (mV)
+ * @return แรงดัน VDD (mV), 3300 ถ้าอ่าน Vrefint ไม่ได้
+ * 
+ * @note ใช้สูตร: VDD = ADC_VREFINT_MV × 1023 / ADC_ReadVrefInt() (หารครั้งเดียว)
+ * 
+ * @example
+ * uint16_t vdd_mv = ADC_GetVDD_mV();
+ */
+uint16_t ADC_GetVDD_mV(void);
+
+/**
+ * @brief อ่านค่า ADC พร้อมชดเชยความผันผวนของ VDD (mV)
+ * @param channel ADC channel ที่ต้องการอ่าน
+ * @return แรงดันที่ชดเชยแล้ว (mV)
+ */
+uint16_t ADC_ReadMillivoltsCompensated(ADC_Channel channel);
+
+/**
+ * @brief คำนวณเปอร์เซ็นต์แบตเตอรี่ (หน่วย 0.1%)
+ * @param vdd_mv แรงดัน VDD ปัจจุบัน (mV)
+ * @param v_min_mv แรงดันต่ำสุดของแบตเตอรี่ (mV)
+ * @param v_max_mv แรงดันสูงสุดของแบตเตอรี่ (mV)
+ * @return 0-1000 (clamp แล้ว, 1000 = 100.0%)
+ * 
+ * @example
+ * // Li-ion (4.2V เต็ม, 3.0V หมด)
+ * uint16_t pct_x10 = ADC_GetBatteryPercent_x10(ADC_GetVDD_mV(), 3000, 4200);
+ */
+uint16_t ADC_GetBatteryPercent_x10(uint16_t vdd_mv, uint16_t v_min_mv, uint16_t v_max_mv);
+
+/* ========== Timer-Triggered Sampling ========== */
+
+/**
+ * @brief เริ่มสุ่มตัวอย่าง ADC ด้วยอัตราคงที่ (timer TRGO + DMA, ไม่ใช้ CPU ต่อ sample)
+ * @param channels array ของ channels (scan ตามลำดับทุกครั้งที่ timer trigger)
+ * @param count จำนวน channels (1-16)
+ * @param sample_rate_hz อัตราสุ่มต่อ channel (Hz)
+ * @param buffer buffer ของ DMA (ข้อมูลเรียงสลับ: ch0, ch1, ..., ch0, ch1, ...)
+ * @param length ขนาด buffer เป็น samples (ปัดลงให้หารด้วย count ลงตัว)
+ * @param callback เรียกเมื่อครบ buffer แล้ว DMA วนเขียนต่อ (NULL = ไม่ใช้)
+ * @return 1 = สำเร็จ, 0 = parameter ผิด, อัตราสูงเกินกว่า ADC จะแปลงทัน หรือ DMA_CH1 ถูกจองอยู่
+ *
+ * @note Sample time เลือกอัตโนมัติ (ยาวที่สุดที่ทัน) ADC clock = SystemCoreClock/8
+ * @note จอง DMA_CH1 ผ่าน DMA_AllocChannel(DMA_REQ_ADC1) และใช้ SIMPLE_ADC_SAMPLING_TIMER;
+ *       ห้ามเรียก ADC_Read() ระหว่างสุ่ม
+ *
+ * @example
+ * static uint16_t audio[256];
+ * void on_block(uint16_t* buf, uint16_t len) { process(buf, len); }
+ *
+ * ADC_Channel ch[] = {ADC_CH_PD4};
+ * ADC_StartSampling(ch, 1, 8000, audio, 256, on_block);  // 8 kHz
+ */
+uint8_t ADC_StartSampling(const ADC_Channel* channels, uint8_t count, uint32_t sample_rate_hz,
+                          uint16_t* buffer, uint16_t length, ADC_SampleCallback callback);
+
+/**
+ * @brief หยุดการสุ่มตัวอย่าง (ADC กลับไปโหมด ADC_Read())
+ */
+void ADC_StopSampling(void);
+
+/**
+ * @brief ตรวจสอบว่ากำลังสุ่มตัวอย่างอยู่หรือไม่
+ * @return 1 = กำลังสุ่ม, 0 = ไม่ได้สุ่ม
+ */
+uint8_t ADC_SamplingBusy(void);
+
+/**
+ * @brief ตำแหน่งที่ DMA จะเขียนถัดไปใน buffer
+ * @return index (0 ถึง length-1)
+ */
+uint16_t ADC_SamplingPosition(void);
+
+/* ========== Oversampling / Decimation ========== */
+
+/**
+ * @brief เริ่ม oversampling แบบ streaming (timer trigger + DMA half/full interrupts)
+ * @param channel ADC channel
+ * @param sample_rate_hz อัตราสุ่มดิบ (Hz)
+ * @param extra_bits บิตที่เพิ่ม 1-4 (ใช้ 4^extra_bits samples ต่อผลลัพธ์)
+ * @param dma_buffer buffer ของ DMA (ใช้ภายใน)
+ * @param dma_length ขนาด buffer เป็น samples (ปัดลงเป็นเลขคู่)
+ * @return 1 = สำเร็จ, 0 = parameter ผิด
+ *
+ * @details ทุกครึ่ง buffer ถูกสะสมใน interrupt ทันทีที่ DMA เขียนเสร็จ
+ *          (ISR time จำกัดที่ dma_length/2 samples) ผลลัพธ์ (sum >> extra_bits)
+ *          มีความละเอียด 10 + extra_bits bits เข้า queue ที่อัตรา
+ *          sample_rate_hz / 4^extra_bits
+ *
+ * @note ต้องมี noise ≥ 1 LSB ในสัญญาณเพื่อให้ได้ความละเอียดเพิ่มจริง
+ * @note หยุดด้วย ADC_StopSampling()
+ *
+ * @example
+ * static uint16_t os_dma[128];
+ * ADC_StartOversampling(ADC_CH_PD4, 16000, 3, os_dma, 128);  // 13-bit ที่ 250 Hz
+ *
+ * uint16_t value;
+ * while (ADC_OversampleRead(&value)) {
+ *     // value: 0-8191
+ * }
+ */
+uint8_t ADC_StartOversampling(ADC_Channel channel, uint32_t sample_rate_hz, uint8_t extra_bits,
+                              uint16_t* dma_buffer, uint16_t dma_length);
+
+/**
+ * @brief จำนวนผลลัพธ์ที่รออ่านใน queue
+ */
+uint8_t ADC_OversampleAvailable(void);
+
+/**
+ * @brief อ่านผลลัพธ์ที่เก่าที่สุดจาก queue
+ * @param value ผลลัพธ์ (10 + extra_bits bits)
+ * @return 1 = มีข้อมูล, 0 = queue ว่าง
+ */
+uint8_t ADC_OversampleRead(uint16_t* value);
+
+/**
+ * @brief จำนวนผลลัพธ์ที่หายเพราะ queue เต็ม (นับตั้งแต่ ADC_StartOversampling)
+ */
+uint16_t ADC_OversampleDropped(void);
+
+/* ========== Deinterleaved Scan ========== */
+
+/**
+ * @brief เริ่มต้น view ของ channel
+ * @param view view ที่ต้องการเริ่มต้น
+ * @param ring buffer ขนาด (1 << shift) samples
+ * @param shift log2 ของขนาด ring (0-8 → 1-256 samples) ค่าเฉลี่ยคิดจากทั้ง ring
+ */
+void ADC_ScanViewInit(ADC_ScanView* view, uint16_t* ring, uint8_t shift);
+
+/**
+ * @brief เริ่ม scan หลาย channels (timer trigger + DMA) แยกใส่ view ของแต่ละ channel
+ * @param channels array ของ channels (ลำดับเดียวกับ views)
+ * @param count จำนวน channels (1-16)
+ * @param sample_rate_hz จำนวน scan ต่อวินาที (ทุก channel ต่อ 1 trigger)
+ * @param dma_buffer buffer ของ DMA (ใช้ภายใน)
+ * @param dma_length ขนาด buffer เป็น samples (ปัดลงเป็นผลคูณของ 2 × count)
+ * @param views array ของ view [count] ที่ผ่าน ADC_ScanViewInit() แล้ว
+ * @return 1 = สำเร็จ, 0 = parameter ผิด
+ *
+ * @details ทุกครึ่ง buffer ถูกแยกตาม channel ใน DMA interrupt ครั้งเดียว
+ *          main loop อ่าน latest/min/max/average ได้ทันทีโดยไม่ต้องไล่ buffer แบบ stride
+ *
+ * @note หยุดด้วย ADC_StopSampling()
+ *
+ * @example
+ * static const ADC_Channel ch[4] = {ADC_CH_PA2, ADC_CH_PA1, ADC_CH_PC4, ADC_CH_PD2};
+ * static uint16_t dma[64];
+ * static uint16_t rings[4][16];
+ * static ADC_ScanView views[4];
+ *
+ * for (uint8_t i = 0; i < 4; i++) ADC_ScanViewInit(&views[i], rings[i], 4);
+ * ADC_StartScan(ch, 4, 1000, dma, 64, views);
+ *
+ * uint16_t temp = ADC_ScanAverage(&views[2]);  // เฉลี่ย 16 scans ล่าสุด
+ */
+uint8_t ADC_StartScan(const ADC_Channel* channels, uint8_t count, uint32_t sample_rate_hz,
+                      uint16_t* dma_buffer, uint16_t dma_length, ADC_ScanView* views);
+
+/**
+ * @brief Sample ล่าสุดของ channel
+ */
+static inline uint16_t ADC_ScanLatest(const ADC_ScanView* view) {
+    return view->latest;
+}
+
+/**
+ * @brief ค่าเฉลี่ยของ ring (1 << shift samples ล่าสุด)
+ */
+static inline uint16_t ADC_ScanAverage(const ADC_ScanView* view) {
+    return (uint16_t)(view->sum >> view->shift);
+}
+
+/**
+ * @brief ค่าต่ำสุดตั้งแต่เริ่มหรือ ADC_ScanResetMinMax()
+ */
+static inline uint16_t ADC_ScanMin(const ADC_ScanView* view) {
+    return view->min;
+}
+
+/**
+ * @brief ค่าสูงสุดตั้งแต่เริ่มหรือ ADC_ScanResetMinMax()
+ */
+static inline uint16_t ADC_ScanMax(const ADC_ScanView* view) {
+    return view->max;
+}
+
+/**
+ * @brief ล้าง min/max ของ view
+ */
+void ADC_ScanResetMinMax(ADC_ScanView* view);
+
+/**
+ * @brief Copy samples ล่าสุดของ view (เก่าสุดก่อน) เช่นป้อน filter หรือ control loop
+ * @param view view ของ channel
+ * @param out buffer ปลายทาง
+ * @param n จำนวนที่ต้องการ (สูงสุดขนาด ring)
+ * @return จำนวนที่ copy ได้ (0 ถ้ายังไม่มี sample)
+ *
+ * @note ปิด interrupt ระหว่าง copy
+ */
+uint16_t ADC_ScanCopy(const ADC_ScanView* view, uint16_t* out, uint16_t n);
+
+/* ========== Analog Watchdog ========== */
+
+/**
+ * @brief ตั้งค่า analog watchdog (hardware เปรียบเทียบทุก conversion ของ channel)
+ * @param channel ADC channel ที่เฝ้า
+ * @param low ขีดล่าง (0-1023) ค่าต่ำกว่านี้ = event
+ * @param high ขีดบน (0-1023) ค่าสูงกว่านี้ = event
+ * @param callback เรียกจาก interrupt เมื่อออกนอกช่วง (NULL = ใช้ ADC_WatchdogTriggered())
+ *
+ * @details ทำงานกับ ADC_Read(), ADC_ReadInjected(), DMA_analogReadStart()
+ *          และ ADC_StartSampling() โดยไม่ต้องเปลี่ยนโค้ดเดิม
+ *
+ * @note Interrupt แบบ latch: หลัง callback ต้องเรียก ADC_WatchdogRearm()
+ *       เพื่อรับ event ถัดไป (กันไม่ให้ stream ความเร็วสูงท่วม ISR)
+ * @note เรียกหลัง ADC_SimpleInit() (init ครั้งแรก reset ADC)
+ * @note ห้ามอ่าน ADC ใน callback ถ้า main loop อาจรอ ADC_Read() อยู่
+ * @note SIMPLE_ADC_WATCHDOG_IRQ = 0 ไม่มี ADC1_IRQHandler: callback ถูกละ ใช้ ADC_WatchdogTriggered()
+ *
+ * @example
+ * void overcurrent(ADC_Channel ch) {
+ *     PWM_Stop(PWM1_CH1);
+ * }
+ *
+ * ADC_StartSampling(ch, 1, 10000, buf, 64, NULL);
+ * ADC_SetWatchdog(ADC_CH_PD4, 0, 900, overcurrent);
+ */
+void ADC_SetWatchdog(ADC_Channel channel, uint16_t low, uint16_t high, ADC_WatchdogCallback callback);
+
+/**
+ * @brief เปิด watchdog interrupt อีกครั้งหลังจาก callback
+ */
+void ADC_WatchdogRearm(void);
+
+/**
+ * @brief ปิด analog watchdog
+ */
+void ADC_ClearWatchdog(void);
+
+/**
+ * @brief ตรวจสอบ (และล้าง) flag ของ watchdog แบบ polling
+ * @return 1 = มีค่าออกนอกช่วงตั้งแต่ครั้งก่อน, 0 = ไม่มี
+ */
+uint8_t ADC_WatchdogTriggered(void);
 
 #ifdef __cplusplus
 }
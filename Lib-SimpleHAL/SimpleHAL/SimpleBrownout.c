@@ -0,0 +1,279 @@
+/**
+ * @file SimpleBrownout.c
+ * @brief PVD-triggered Snapshot Save Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleBrownout.h"
+#include "SimpleCRC.h"
+#include "SimpleISRStat.h"
+#include <string.h>
+#if SIMPLE_HAL_USE_KV
+#include "SimpleKV.h"
+#endif
+#if SIMPLE_HAL_USE_LOGGER
+#include "SimpleLogger.h"
+#endif
+
+// PVD_IRQHandler ถูก link เสมอถ้า compile: ตัดทั้ง module เมื่อไม่ได้เลือกใช้
+#if SIMPLE_HAL_USE_BROWNOUT
+
+/* ========== Private Definitions ========== */
+
+#define BROWNOUT_BASE       ((uint32_t)(FLASH_BASE_ADDRESS + SIMPLE_BROWNOUT_PAGE_START * FLASH_PAGE_SIZE))
+#define BROWNOUT_END        ((uint32_t)(BROWNOUT_BASE + SIMPLE_BROWNOUT_PAGE_COUNT * FLASH_PAGE_SIZE))
+#define BROWNOUT_ERASED     0xFFFF
+#define BROWNOUT_MAGIC      0xB5
+#define BROWNOUT_CONSUMED   0x0000
+#define BROWNOUT_DATA_OFF   4
+#define BROWNOUT_FLAG_OFF   (BROWNOUT_SLOT_SIZE - 2)
+
+#define BROWNOUT_HEADER(size)   ((uint16_t)(BROWNOUT_MAGIC | ((uint16_t)(size) << 8)))
+#define BROWNOUT_HW(addr)       (*(const volatile uint16_t*)(addr))
+
+// Region [start, start + count) ทับ pages ของ brownout หรือไม่
+#define BROWNOUT_OVERLAPS(start, count) \
+    ((SIMPLE_BROWNOUT_PAGE_START) < (start) + (count) && \
+     (start) < (SIMPLE_BROWNOUT_PAGE_START) + SIMPLE_BROWNOUT_PAGE_COUNT)
+
+#if !SIMPLE_FLASH_STORAGE_LINKER
+#if SIMPLE_HAL_USE_KV && BROWNOUT_OVERLAPS(SIMPLE_KV_PAGE_START, SIMPLE_KV_PAGE_COUNT)
+#error "SimpleBrownout: page range overlaps SimpleKV (set SIMPLE_BROWNOUT_PAGE_START)"
+#endif
+#if SIMPLE_HAL_USE_LOGGER && BROWNOUT_OVERLAPS(SIMPLE_LOGGER_PAGE_START, SIMPLE_LOGGER_PAGE_COUNT)
+#error "SimpleBrownout: page range overlaps SimpleLogger (set SIMPLE_BROWNOUT_PAGE_START)"
+#endif
+#endif
+
+/* ========== Private Variables ========== */
+
+static const uint8_t* brownout_data = NULL;
+static uint8_t brownout_size = 0;
+static uint32_t brownout_addr = 0;            // slot ว่างที่เตรียมไว้
+static volatile uint8_t brownout_armed = 0;   // ISR เขียน slot ได้
+static volatile uint8_t brownout_saved = 0;   // slot ถูกเขียนแล้ว
+static uint8_t brownout_restored = 0;
+
+const uint16_t brownout_ram_bytes = sizeof(brownout_data) + sizeof(brownout_size) +
+                                    sizeof(brownout_addr) + sizeof(brownout_armed) +
+                                    sizeof(brownout_saved) + sizeof(brownout_restored);
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief Slot ถัดไป (slot ไม่ข้ามขอบ page), 0 = หมด region
+ */
+static uint32_t brownout_next(uint32_t addr) {
+    addr += BROWNOUT_SLOT_SIZE;
+    if ((addr & (FLASH_PAGE_SIZE - 1)) + BROWNOUT_SLOT_SIZE > FLASH_PAGE_SIZE) {
+        addr = (addr | (FLASH_PAGE_SIZE - 1)) + 1;
+    }
+    return (addr < BROWNOUT_END) ? addr : 0;
+}
+
+static uint8_t brownout_slot_erased(uint32_t addr) {
+    for (uint8_t off = 0; off < BROWNOUT_SLOT_SIZE; off += 2) {
+        if (BROWNOUT_HW(addr + off) != BROWNOUT_ERASED) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief CRC ของข้อมูล (0xFFFF ถูกแทนด้วย 0 เพื่อแยกจาก half-word ที่ยังไม่เขียน)
+ */
+static uint16_t brownout_crc_final(uint16_t crc) {
+    return (crc == BROWNOUT_ERASED) ? 0 : crc;
+}
+
+static uint8_t brownout_slot_valid(uint32_t addr) {
+    if (BROWNOUT_HW(addr) != BROWNOUT_HEADER(brownout_size)) return 0;
+    if (BROWNOUT_HW(addr + BROWNOUT_FLAG_OFF) != BROWNOUT_ERASED) return 0;
+
+    uint16_t crc = CRC16_CCITT((const void*)(addr + BROWNOUT_DATA_OFF), brownout_size);
+    return BROWNOUT_HW(addr + 2) == brownout_crc_final(crc);
+}
+
+static FlashStatus brownout_program(uint32_t addr, uint16_t data) {
+    FLASH_Status status = Flash_ProgramHalfWordRaw(addr, data);
+    if (status != FLASH_COMPLETE) return FLASH_ERROR_WRITE;
+    if (BROWNOUT_HW(addr) != data) return FLASH_ERROR_VERIFY;
+    return FLASH_OK;
+}
+
+/**
+ * @brief Pages ต้องอยู่ใน storage region ใต้ config/data pages (linker region เท่านั้น)
+ */
+static uint8_t brownout_range_ok(void) {
+#if SIMPLE_FLASH_STORAGE_LINKER
+    // ตำแหน่งมาจาก linker จึงตรวจการทับ SimpleKV/SimpleLogger ตอน runtime แทน #error
+#if SIMPLE_HAL_USE_KV
+    if (BROWNOUT_OVERLAPS(SIMPLE_KV_PAGE_START, SIMPLE_KV_PAGE_COUNT)) return 0;
+#endif
+#if SIMPLE_HAL_USE_LOGGER
+    if (BROWNOUT_OVERLAPS(SIMPLE_LOGGER_PAGE_START, SIMPLE_LOGGER_PAGE_COUNT)) return 0;
+#endif
+    return SIMPLE_BROWNOUT_PAGE_START >= FLASH_STORAGE_PAGE_START &&
+           SIMPLE_BROWNOUT_PAGE_START + SIMPLE_BROWNOUT_PAGE_COUNT <= FLASH_CONFIG_PAGE;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief ทิ้ง slot used (ถ้ามี) แล้วเตรียม slot ว่างถัดไป (erase region เมื่อหมด)
+ */
+static FlashStatus brownout_prepare(uint32_t used) {
+    FlashStatus status = FLASH_OK;
+
+    if (used && BROWNOUT_HW(used + BROWNOUT_FLAG_OFF) == BROWNOUT_ERASED) {
+        FLASH_Unlock();
+        status = brownout_program(used + BROWNOUT_FLAG_OFF, BROWNOUT_CONSUMED);
+        FLASH_Lock();
+        if (status != FLASH_OK) return status;
+    }
+
+    uint32_t next = used ? brownout_next(used) : BROWNOUT_BASE;
+    if (next == 0) {
+        for (uint32_t page = BROWNOUT_BASE; page < BROWNOUT_END; page += FLASH_PAGE_SIZE) {
+            status = Flash_ErasePageAt(page);
+            if (status != FLASH_OK) return status;
+        }
+        next = BROWNOUT_BASE;
+    }
+
+    brownout_addr = next;
+    return FLASH_OK;
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief ลงทะเบียน snapshot และเปิด PVD interrupt
+ */
+FlashStatus Brownout_Init(void* data, uint8_t size, uint32_t pvd_level) {
+    if (data == NULL || size == 0 || size > SIMPLE_BROWNOUT_MAX_SIZE) {
+        return FLASH_ERROR_INVALID;
+    }
+    if (Flash_Init() != FLASH_OK || !brownout_range_ok()) {
+        return FLASH_ERROR_RANGE;
+    }
+
+    brownout_armed = 0;
+    brownout_saved = 0;
+    brownout_restored = 0;
+    brownout_data = (const uint8_t*)data;
+    brownout_size = size;
+
+    // Slots ถูกใช้ตามลำดับ: slot ล่าสุดคือตัวสุดท้ายที่ไม่ว่าง
+    uint32_t last = 0;
+    for (uint32_t addr = BROWNOUT_BASE; addr != 0; addr = brownout_next(addr)) {
+        if (!brownout_slot_erased(addr)) {
+            last = addr;
+        }
+    }
+
+    if (last && brownout_slot_valid(last)) {
+        memcpy(data, (const void*)(last + BROWNOUT_DATA_OFF), size);
+        brownout_restored = 1;
+    }
+
+    FlashStatus status = brownout_prepare(last);
+    if (status != FLASH_OK) return status;
+
+    // PVD ผ่าน EXTI line 8: rising = VDD ตกต่ำกว่า threshold
+    PWR_EnablePVD(pvd_level);
+    EXTI->INTFR = EXTI_Line8;
+    EXTI->RTENR |= EXTI_Line8;
+    EXTI->INTENR |= EXTI_Line8;
+    brownout_armed = 1;
+#if SIMPLE_BROWNOUT_IRQ
+    NVIC_EnableIRQ(PVD_IRQn);
+#endif
+
+    // ต่ำกว่า threshold อยู่แล้ว: ไม่มีขอบให้ interrupt
+    if (PWR_GetPVDStatus()) {
+        Brownout_Save();
+    }
+    return FLASH_OK;
+}
+
+/**
+ * @brief Brownout_Init() คืนค่า snapshot หรือไม่
+ */
+bool Brownout_Restored(void) {
+    return brownout_restored != 0;
+}
+
+/**
+ * @brief เขียน snapshot ลง slot ที่เตรียมไว้
+ */
+FlashStatus Brownout_Save(void) {
+    uint32_t mstatus;
+
+    // จอง slot (เรียกซ้อนจาก ISR อื่นได้)
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+    uint8_t armed = brownout_armed;
+    brownout_armed = 0;
+    if (mstatus & 0x8) {
+        __asm volatile ("csrsi mstatus, 0x8");
+    }
+    if (!armed) return FLASH_ERROR_BUSY;
+
+    uint32_t addr = brownout_addr;
+    uint16_t crc = CRC16_CCITT_INIT;
+    FlashStatus status = FLASH_OK;
+
+    FLASH_Unlock();
+    for (uint8_t i = 0; status == FLASH_OK && i < brownout_size; i += 2) {
+        // CRC จาก bytes ที่เขียนจริง (RAM อาจเปลี่ยนระหว่างเขียน)
+        uint8_t pair[2] = {brownout_data[i], 0xFF};
+        uint8_t n = 1;
+        if (i + 1 < brownout_size) {
+            pair[1] = brownout_data[i + 1];
+            n = 2;
+        }
+        crc = CRC16_CCITTUpdate(crc, pair, n);
+        status = brownout_program(addr + BROWNOUT_DATA_OFF + i, (uint16_t)(pair[0] | (pair[1] << 8)));
+    }
+    if (status == FLASH_OK) {
+        status = brownout_program(addr + 2, brownout_crc_final(crc));
+    }
+    if (status == FLASH_OK) {
+        status = brownout_program(addr, BROWNOUT_HEADER(brownout_size));
+    }
+    FLASH_Lock();
+
+    brownout_saved = 1;
+    return status;
+}
+
+/**
+ * @brief เตรียม slot ใหม่เมื่อไฟกลับมาโดยไม่ reset
+ */
+FlashStatus Brownout_Service(void) {
+    if (!brownout_saved || PWR_GetPVDStatus()) return FLASH_OK;
+
+    FlashStatus status = brownout_prepare(brownout_addr);
+    if (status != FLASH_OK) return status;
+
+    brownout_saved = 0;
+    brownout_armed = 1;
+    return FLASH_OK;
+}
+
+#if SIMPLE_BROWNOUT_IRQ
+/**
+ * @brief PVD interrupt: VDD ต่ำกว่า threshold
+ */
+void PVD_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+
+void PVD_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_PVD);
+    EXTI->INTFR = EXTI_Line8;
+    Brownout_Save();
+    ISR_STAT_EXIT(ISR_STAT_PVD);
+}
+#endif
+
+#endif  // SIMPLE_HAL_USE_BROWNOUT
@@ -0,0 +1,158 @@
+/**
+ * @file SimpleBrownout.h
+ * @brief บันทึก RAM snapshot ลง Flash เมื่อไฟตก (PVD) และคืนค่าตอน boot ถัดไป
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * Flash_SaveConfig() erase page ก่อนเขียนซึ่งนานเกินช่วงที่ไฟยังพอ (hold-up time)
+ * module นี้จอง slot ที่ erase ไว้แล้วล่วงหน้า เมื่อ VDD ต่ำกว่า PVD threshold
+ * PVD interrupt เขียน snapshot ด้วย half-word programming ทันทีโดยไม่ต้อง erase
+ *
+ * **รูปแบบข้อมูล:**
+ * - Slot: [magic | size << 8][CRC16][data (ปัดเป็นเลขคู่)][consumed]
+ * - ISR เขียน data, CRC แล้ว header เป็นลำดับสุดท้าย: slot ที่เขียนไม่จบถูกข้าม
+ * - Boot: คืนค่า slot ล่าสุดแล้วเขียน consumed = 0 (ไม่คืนค่าเดิมซ้ำหลัง reset แบบอื่น)
+ * - Slot ถัดไปต้องว่างเสมอ: ถ้าหมดจะ erase pages ตอน boot (ไฟปกติ) ไม่ใช่ใน ISR
+ *
+ * **เวลาใน ISR:** ~(size / 2 + 2) half-word programs (ไม่กี่สิบ µs ต่อ half-word)
+ * ต้องสั้นกว่าเวลาที่ VDD ตกจาก PVD threshold ถึงแรงดันต่ำสุดของ flash
+ * (เพิ่ม capacitor ที่ VDD และใช้ threshold สูงสุดที่ระบบยอมรับได้)
+ *
+ * @example
+ * typedef struct { uint32_t pulses; uint16_t runtime_min; } Counters;
+ * static Counters counters;
+ *
+ * Brownout_Init(&counters, sizeof(counters), PWR_PVD_3V1);
+ * if (Brownout_Restored()) {
+ *     // counters มีค่าก่อนไฟดับ
+ * }
+ *
+ * while (1) {
+ *     counters.pulses++;
+ *     Brownout_Service();  // เตรียม slot ใหม่ถ้าไฟกลับมาโดยไม่ reset
+ * }
+ *
+ * @note ISR ที่เข้ามาระหว่าง flash operation ของ main (KV, Logger) ทำให้ operation นั้นล้มเหลว
+ *       (ข้อมูลเดิมยังปลอดภัยตามกลไกของ module นั้น)
+ * @note ตั้ง SIMPLE_FLASH_RAMFUNC = 1 ถ้าต้องการให้ interrupt อื่นทำงานระหว่างเขียน
+ */
+
+#ifndef __SIMPLE_BROWNOUT_H
+#define __SIMPLE_BROWNOUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SimpleHAL_Config.h"
+#include "SimpleFlash.h"
+#include "SimplePWR.h"
+#include <stdbool.h>
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief Page แรกของ region (ค่าเริ่มต้นอยู่ใต้ pages ของ SimpleLogger)
+ * @note SIMPLE_FLASH_STORAGE_LINKER = 1: ค่าเริ่มต้นคือท้าย storage region ใต้ config/data pages
+ *       (SimpleKV/SimpleLogger เริ่มจากต้น region)
+ * @note ต้องไม่ทับ region ของ SimpleKV/SimpleLogger: ตรวจตอน compile (หรือใน Brownout_Init()
+ *       เมื่อ SIMPLE_FLASH_STORAGE_LINKER = 1 เพราะตำแหน่งมาจาก linker)
+ */
+#ifndef SIMPLE_BROWNOUT_PAGE_START
+#if SIMPLE_FLASH_STORAGE_LINKER
+#define SIMPLE_BROWNOUT_PAGE_START (FLASH_CONFIG_PAGE - SIMPLE_BROWNOUT_PAGE_COUNT)
+#else
+#define SIMPLE_BROWNOUT_PAGE_START 229
+#endif
+#endif
+
+/**
+ * @brief จำนวน pages (มากขึ้น = erase น้อยลงต่อจำนวนครั้งที่ไฟดับ)
+ */
+#ifndef SIMPLE_BROWNOUT_PAGE_COUNT
+#define SIMPLE_BROWNOUT_PAGE_COUNT 1
+#endif
+
+/**
+ * @brief ขนาด snapshot สูงสุด (bytes, 1-58)
+ */
+#ifndef SIMPLE_BROWNOUT_MAX_SIZE
+#define SIMPLE_BROWNOUT_MAX_SIZE 16
+#endif
+
+/**
+ * @brief 1 = ประกาศ PVD_IRQHandler ให้ (0 = application เรียก Brownout_Save() เอง)
+ * @note SIMPLE_HAL_USE_BROWNOUT = 0 ตัดทั้ง SimpleBrownout.c (รวม handler) ออก
+ */
+#ifndef SIMPLE_BROWNOUT_IRQ
+#define SIMPLE_BROWNOUT_IRQ 1
+#endif
+
+#if SIMPLE_BROWNOUT_MAX_SIZE < 1 || SIMPLE_BROWNOUT_MAX_SIZE > (FLASH_PAGE_SIZE - 6)
+#error "SIMPLE_BROWNOUT_MAX_SIZE must be 1-58"
+#endif
+
+#if !SIMPLE_FLASH_STORAGE_LINKER
+#if SIMPLE_BROWNOUT_PAGE_START + SIMPLE_BROWNOUT_PAGE_COUNT > FLASH_TOTAL_PAGES
+#error "SimpleBrownout: invalid page range"
+#endif
+#endif
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief ขนาด slot บน flash: header + CRC + data (ปัดเป็นเลขคู่) + consumed
+ */
+#define BROWNOUT_SLOT_SIZE        (6 + ((SIMPLE_BROWNOUT_MAX_SIZE + 1) & ~1))
+
+/**
+ * @brief จำนวน slots ต่อ page
+ */
+#define BROWNOUT_SLOTS_PER_PAGE   (FLASH_PAGE_SIZE / BROWNOUT_SLOT_SIZE)
+
+/**
+ * @brief จำนวน slots ทั้งหมด (1 erase ต่อเท่านี้ครั้งที่ไฟดับ)
+ */
+#define BROWNOUT_SLOT_COUNT       (SIMPLE_BROWNOUT_PAGE_COUNT * BROWNOUT_SLOTS_PER_PAGE)
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief ลงทะเบียน snapshot, คืนค่าจาก flash ถ้ามี, เตรียม slot ว่าง และเปิด PVD interrupt
+ * @param data RAM ที่ต้องการบันทึก (ต้องอยู่ตลอดการใช้งาน)
+ * @param size ขนาด (1 - SIMPLE_BROWNOUT_MAX_SIZE)
+ * @param pvd_level PVD threshold (PWR_PVD_x)
+ * @return FLASH_OK เมื่อพร้อม, FLASH_ERROR_INVALID ถ้า size ไม่ถูกต้อง,
+ *         FLASH_ERROR_RANGE ถ้า pages ไม่อยู่ใน storage region หรือทับ SimpleKV/SimpleLogger
+ *
+ * @note data ถูกเขียนทับเฉพาะเมื่อพบ snapshot ที่ถูกต้องและขนาดตรงกัน
+ * @note เรียกหลังไฟนิ่งแล้ว: อาจ erase pages (VDD ต่ำกว่า threshold ตอนเรียก = บันทึกทันที)
+ */
+FlashStatus Brownout_Init(void* data, uint8_t size, uint32_t pvd_level);
+
+/**
+ * @brief Brownout_Init() คืนค่า snapshot จาก flash หรือไม่
+ */
+bool Brownout_Restored(void);
+
+/**
+ * @brief เขียน snapshot ลง slot ที่เตรียมไว้ (PVD_IRQHandler เรียกให้)
+ * @return FLASH_OK ถ้าเขียนสำเร็จ, FLASH_ERROR_BUSY ถ้ายังไม่พร้อมหรือบันทึกไปแล้ว
+ *
+ * @note บันทึกได้ครั้งเดียวต่อ slot: Brownout_Service() เตรียม slot ใหม่เมื่อไฟกลับมา
+ */
+FlashStatus Brownout_Save(void);
+
+/**
+ * @brief เรียกจาก main loop: ถ้าบันทึกไปแล้วแต่ VDD กลับมาสูงกว่า threshold
+ *        ทิ้ง snapshot นั้น (ค่าใน RAM ยังใหม่กว่า) และเตรียม slot ใหม่
+ * @return FLASH_OK ถ้าไม่มีอะไรต้องทำหรือเตรียมสำเร็จ
+ */
+FlashStatus Brownout_Service(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_BROWNOUT_H
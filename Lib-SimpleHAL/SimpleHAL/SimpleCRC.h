@@ -0,0 +1,166 @@
+/**
+ * @file SimpleCRC.h
+ * @brief CRC8 / CRC16 / CRC32 แบบ table-driven สำหรับ CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * CRC ที่ใช้ร่วมกันทั้ง SimpleHAL (SimpleFlash, SimpleKV, SimpleFrame, Simple1Wire)
+ * แทนการคำนวณทีละ bit (8 รอบต่อ byte)
+ *
+ * **Variants:**
+ * | Function        | Poly       | Init       | Reflect | XorOut     | Check ("123456789") |
+ * |-----------------|------------|------------|---------|------------|---------------------|
+ * | CRC8_Maxim()    | 0x31       | 0x00       | yes     | 0x00       | 0xA1                |
+ * | CRC16_CCITT()   | 0x1021     | 0xFFFF     | no      | 0x0000     | 0x29B1              |
+ * | CRC16_Modbus()  | 0x8005     | 0xFFFF     | yes     | 0x0000     | 0x4B37              |
+ * | CRC32()         | 0x04C11DB7 | 0xFFFFFFFF | yes     | 0xFFFFFFFF | 0xCBF43926          |
+ *
+ * **Table size (เลือกต่อ variant ตอน compile):**
+ * - 16 entries (nibble, default): 2 lookups ต่อ byte, flash 16 / 32 / 32 / 64 bytes
+ * - 256 entries: 1 lookup ต่อ byte, flash 256 / 512 / 512 / 1024 bytes
+ *
+ * **Streaming:** ฟังก์ชัน *Update() รับค่า CRC เดิม จึงคำนวณทีละ chunk ได้
+ * (เช่น DMA half/full-transfer callback) ได้ผลเท่ากับคำนวณทั้ง buffer ครั้งเดียว
+ *
+ * @example
+ * uint16_t crc = CRC16_CCITT_INIT;
+ * crc = CRC16_CCITTUpdate(crc, first_half, 32);   // half-transfer
+ * crc = CRC16_CCITTUpdate(crc, second_half, 32);  // transfer complete
+ *
+ * uint32_t crc32 = CRC32_Update(CRC32_INIT, block, len);
+ * crc32 = CRC32_Final(crc32);                     // == CRC32(block, len)
+ *
+ * @note ไม่มีตัวแปร RAM (tables อยู่ใน flash) เรียกจาก ISR ได้
+ */
+
+#ifndef __SIMPLE_CRC_H
+#define __SIMPLE_CRC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief ขนาด table ของ CRC8_Maxim (16 หรือ 256)
+ */
+#ifndef SIMPLE_CRC8_TABLE
+#define SIMPLE_CRC8_TABLE 16
+#endif
+
+/**
+ * @brief ขนาด table ของ CRC16_CCITT และ CRC16_Modbus (16 หรือ 256)
+ */
+#ifndef SIMPLE_CRC16_TABLE
+#define SIMPLE_CRC16_TABLE 16
+#endif
+
+/**
+ * @brief ขนาด table ของ CRC32 (16 หรือ 256)
+ */
+#ifndef SIMPLE_CRC32_TABLE
+#define SIMPLE_CRC32_TABLE 16
+#endif
+
+#if (SIMPLE_CRC8_TABLE != 16 && SIMPLE_CRC8_TABLE != 256) || \
+    (SIMPLE_CRC16_TABLE != 16 && SIMPLE_CRC16_TABLE != 256) || \
+    (SIMPLE_CRC32_TABLE != 16 && SIMPLE_CRC32_TABLE != 256)
+#error "SIMPLE_CRCx_TABLE must be 16 or 256"
+#endif
+
+/* ========== Definitions ========== */
+
+#define CRC8_MAXIM_INIT    0x00         /**< ค่าเริ่มต้น CRC-8/Maxim (1-Wire) */
+#define CRC16_CCITT_INIT   0xFFFF       /**< ค่าเริ่มต้น CRC-16/CCITT-FALSE */
+#define CRC16_MODBUS_INIT  0xFFFF       /**< ค่าเริ่มต้น CRC-16/Modbus */
+#define CRC32_INIT         0xFFFFFFFFUL /**< ค่าเริ่มต้น CRC-32 (ก่อน CRC32_Final()) */
+
+/* ========== CRC-8/Maxim ========== */
+
+/**
+ * @brief CRC-8/Maxim ต่อจากค่าเดิม (Dallas/Maxim 1-Wire ROM และ scratchpad)
+ * @param crc ค่า CRC เดิม (CRC8_MAXIM_INIT สำหรับ chunk แรก)
+ * @param data ข้อมูล
+ * @param len จำนวน bytes
+ * @return ค่า CRC ใหม่
+ *
+ * @note ข้อมูลที่รวม CRC byte ท้ายไว้แล้วได้ผลเป็น 0 ถ้าถูกต้อง
+ */
+uint8_t CRC8_MaximUpdate(uint8_t crc, const void* data, uint16_t len);
+
+/**
+ * @brief CRC-8/Maxim ของทั้ง buffer
+ */
+static inline uint8_t CRC8_Maxim(const void* data, uint16_t len) {
+    return CRC8_MaximUpdate(CRC8_MAXIM_INIT, data, len);
+}
+
+/* ========== CRC-16 ========== */
+
+/**
+ * @brief CRC-16/CCITT-FALSE ต่อจากค่าเดิม (เหมือน Flash_CalculateCRC16())
+ * @param crc ค่า CRC เดิม (CRC16_CCITT_INIT สำหรับ chunk แรก)
+ * @param data ข้อมูล
+ * @param len จำนวน bytes
+ * @return ค่า CRC ใหม่
+ */
+uint16_t CRC16_CCITTUpdate(uint16_t crc, const void* data, uint16_t len);
+
+/**
+ * @brief CRC-16/CCITT-FALSE ของทั้ง buffer
+ */
+static inline uint16_t CRC16_CCITT(const void* data, uint16_t len) {
+    return CRC16_CCITTUpdate(CRC16_CCITT_INIT, data, len);
+}
+
+/**
+ * @brief CRC-16/Modbus ต่อจากค่าเดิม
+ * @param crc ค่า CRC เดิม (CRC16_MODBUS_INIT สำหรับ chunk แรก)
+ * @param data ข้อมูล
+ * @param len จำนวน bytes
+ * @return ค่า CRC ใหม่ (ส่งบนสาย low byte ก่อน)
+ */
+uint16_t CRC16_ModbusUpdate(uint16_t crc, const void* data, uint16_t len);
+
+/**
+ * @brief CRC-16/Modbus ของทั้ง buffer
+ */
+static inline uint16_t CRC16_Modbus(const void* data, uint16_t len) {
+    return CRC16_ModbusUpdate(CRC16_MODBUS_INIT, data, len);
+}
+
+/* ========== CRC-32 ========== */
+
+/**
+ * @brief CRC-32 (IEEE 802.3 / zlib) ต่อจากค่าเดิม
+ * @param crc ค่า CRC เดิม (CRC32_INIT สำหรับ chunk แรก)
+ * @param data ข้อมูล
+ * @param len จำนวน bytes
+ * @return ค่า CRC ระหว่างทาง (ยังไม่ XOR ท้าย: เรียก CRC32_Final() เมื่อจบ)
+ */
+uint32_t CRC32_Update(uint32_t crc, const void* data, uint16_t len);
+
+/**
+ * @brief จบ CRC-32 แบบ streaming (XOR 0xFFFFFFFF)
+ */
+static inline uint32_t CRC32_Final(uint32_t crc) {
+    return crc ^ 0xFFFFFFFFUL;
+}
+
+/**
+ * @brief CRC-32 ของทั้ง buffer
+ */
+static inline uint32_t CRC32(const void* data, uint16_t len) {
+    return CRC32_Final(CRC32_Update(CRC32_INIT, data, len));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SIMPLE_CRC_H
@@ -0,0 +1,138 @@
+/**
+ * @file SimpleClock.c
+ * @brief Reference-counted Peripheral Clock Manager Implementation
+ * @version 1.1
+ * @date 2026-10-14
+ */
+
+#include "SimpleClock.h"
+
+/* ========== Private Definitions ========== */
+
+/**
+ * @brief Bus index เรียงตาม register ใน RCC (AHBPCENR, APB2PCENR, APB1PCENR ติดกัน)
+ */
+#define CLOCK_BUS_AHB   0
+#define CLOCK_BUS_APB2  1
+#define CLOCK_BUS_APB1  2
+#define CLOCK_BUS_COUNT 3
+
+#define CLOCK_PCENR(bus) ((&RCC->AHBPCENR)[bus])
+
+typedef struct {
+    uint8_t bus;
+    uint32_t mask;
+} ClockMap_t;
+
+/* ========== Private Variables ========== */
+
+static const ClockMap_t clock_map[CLOCK_PERIPH_COUNT] = {
+    {CLOCK_BUS_APB2, RCC_APB2Periph_GPIOA},
+    {CLOCK_BUS_APB2, RCC_APB2Periph_GPIOC},
+    {CLOCK_BUS_APB2, RCC_APB2Periph_GPIOD},
+    {CLOCK_BUS_APB2, RCC_APB2Periph_AFIO},
+    {CLOCK_BUS_APB2, RCC_APB2Periph_ADC1},
+    {CLOCK_BUS_APB2, RCC_APB2Periph_TIM1},
+    {CLOCK_BUS_APB2, RCC_APB2Periph_SPI1},
+    {CLOCK_BUS_APB2, RCC_APB2Periph_USART1},
+    {CLOCK_BUS_APB1, RCC_APB1Periph_TIM2},
+    {CLOCK_BUS_APB1, RCC_APB1Periph_WWDG},
+    {CLOCK_BUS_APB1, RCC_APB1Periph_I2C1},
+    {CLOCK_BUS_APB1, RCC_APB1Periph_PWR},
+    {CLOCK_BUS_AHB,  RCC_AHBPeriph_DMA1}
+};
+
+static uint8_t clock_refs[CLOCK_PERIPH_COUNT] = {0};
+
+// bit ที่ถูก release จนเหลือ 0 และรอปิดใน Clock_GateIdle()
+static uint32_t clock_idle[CLOCK_BUS_COUNT] = {0};
+
+// SimpleEnergy (ถ้า link อยู่): ปิดบัญชีเวลาของ peripherals ก่อน clock เปลี่ยน
+extern void Energy_Update(void) __attribute__((weak));
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เพิ่ม reference และเปิด clock เมื่อเป็นผู้ใช้คนแรก
+ */
+void Clock_Acquire(Clock_Periph periph) {
+    if (periph >= CLOCK_PERIPH_COUNT) return;
+
+    const ClockMap_t* map = &clock_map[periph];
+
+    __disable_irq();
+    if (clock_refs[periph]++ == 0) {
+        clock_idle[map->bus] &= ~map->mask;
+        if (Energy_Update && !(CLOCK_PCENR(map->bus) & map->mask)) {
+            Energy_Update();
+        }
+        CLOCK_PCENR(map->bus) |= map->mask;
+    }
+    __enable_irq();
+}
+
+/**
+ * @brief ลด reference ของ peripheral
+ */
+void Clock_Release(Clock_Periph periph) {
+    if (periph >= CLOCK_PERIPH_COUNT) return;
+
+    __disable_irq();
+    if (clock_refs[periph] && --clock_refs[periph] == 0) {
+        clock_idle[clock_map[periph].bus] |= clock_map[periph].mask;
+    }
+    __enable_irq();
+}
+
+/**
+ * @brief ปิด clock ของทุก peripheral ที่ idle
+ */
+void Clock_GateIdle(void) {
+    __disable_irq();
+    if (Energy_Update && (clock_idle[0] | clock_idle[1] | clock_idle[2])) {
+        Energy_Update();
+    }
+    for (uint8_t bus = 0; bus < CLOCK_BUS_COUNT; bus++) {
+        if (clock_idle[bus]) {
+            CLOCK_PCENR(bus) &= ~clock_idle[bus];
+            clock_idle[bus] = 0;
+        }
+    }
+    __enable_irq();
+}
+
+/**
+ * @brief อ่าน reference count ปัจจุบัน
+ */
+uint8_t Clock_GetRefCount(Clock_Periph periph) {
+    if (periph >= CLOCK_PERIPH_COUNT) return 0;
+    return clock_refs[periph];
+}
+
+/**
+ * @brief Peripheral ที่ clock เปิดอยู่จริงใน RCC
+ */
+uint16_t Clock_GetEnabledMask(void) {
+    uint16_t mask = 0;
+
+    for (uint8_t i = 0; i < CLOCK_PERIPH_COUNT; i++) {
+        if (CLOCK_PCENR(clock_map[i].bus) & clock_map[i].mask) {
+            mask |= (uint16_t)(1u << i);
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief Release ทุก clock ที่ owner ถืออยู่
+ */
+void Clock_ReleaseAll(uint16_t* held) {
+    uint16_t mask = *held;
+    *held = 0;
+
+    for (uint8_t i = 0; mask; i++, mask >>= 1) {
+        if (mask & 1) {
+            Clock_Release((Clock_Periph)i);
+        }
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ * @file SimpleClock.h
+ * @brief Reference-counted Peripheral Clock Manager สำหรับ CH32V003
+ * @version 1.1
+ * @date 2026-10-14
+ *
+ * @details
+ * ตัวจัดการ clock กลางของ SimpleHAL ทุก module เปิด clock ผ่าน
+ * Clock_Acquire() แทนการเรียก RCC_xxxPeriphClockCmd() โดยตรง
+ *
+ * **คุณสมบัติ:**
+ * - Reference count ต่อ peripheral (AHB, APB1, APB2)
+ * - เขียน RCC เฉพาะตอน refcount 0 -> 1 (init ซ้ำไม่มี overhead)
+ * - Clock_AcquireOnce() สำหรับ init ที่เรียกซ้ำได้ (idempotent)
+ * - Peripheral ที่ refcount กลับเป็น 0 จะถูกปิด clock ใน Clock_GateIdle()
+ *   (PWR_Sleep() เรียกให้อัตโนมัติก่อนเข้า sleep)
+ *
+ * @example
+ * static uint16_t my_clocks = 0;
+ *
+ * void MyDriver_Init(void) {
+ *     Clock_AcquireOnce(CLOCK_SPI1, &my_clocks);  // เรียกซ้ำได้
+ * }
+ *
+ * void MyDriver_End(void) {
+ *     Clock_ReleaseAll(&my_clocks);
+ * }
+ *
+ * @note Clock ที่ถูกเปิดจากนอก SimpleClock (เช่น debug.c) จะไม่ถูกปิดโดย Clock_GateIdle()
+ * @note ถ้า link SimpleEnergy ไว้ ทุกครั้งที่ clock เปิด/ปิดจะเรียก Energy_Update() ก่อน
+ */
+
+#ifndef __SIMPLE_CLOCK_H
+#define __SIMPLE_CLOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <ch32v00x.h>
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief Peripheral ที่ SimpleClock จัดการ
+ */
+typedef enum {
+    CLOCK_GPIOA = 0,  /**< APB2 GPIOA */
+    CLOCK_GPIOC,      /**< APB2 GPIOC */
+    CLOCK_GPIOD,      /**< APB2 GPIOD */
+    CLOCK_AFIO,       /**< APB2 AFIO (remap, EXTI) */
+    CLOCK_ADC1,       /**< APB2 ADC1 */
+    CLOCK_TIM1,       /**< APB2 TIM1 */
+    CLOCK_SPI1,       /**< APB2 SPI1 */
+    CLOCK_USART1,     /**< APB2 USART1 */
+    CLOCK_TIM2,       /**< APB1 TIM2 */
+    CLOCK_WWDG,       /**< APB1 WWDG */
+    CLOCK_I2C1,       /**< APB1 I2C1 */
+    CLOCK_PWR,        /**< APB1 PWR */
+    CLOCK_DMA1,       /**< AHB DMA1 */
+    CLOCK_PERIPH_COUNT
+} Clock_Periph;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เพิ่ม reference และเปิด clock เมื่อเป็นผู้ใช้คนแรก
+ * @param periph Peripheral ที่ต้องการ
+ *
+ * @note ทุก Clock_Acquire() ต้องคู่กับ Clock_Release() หนึ่งครั้ง
+ */
+void Clock_Acquire(Clock_Periph periph);
+
+/**
+ * @brief ลด reference ของ peripheral
+ * @param periph Peripheral ที่เลิกใช้
+ *
+ * @note เมื่อ refcount เป็น 0 clock ยังเปิดอยู่จนกว่าจะเรียก Clock_GateIdle()
+ */
+void Clock_Release(Clock_Periph periph);
+
+/**
+ * @brief ปิด clock ของทุก peripheral ที่ถูก release จน refcount เป็น 0
+ *
+ * @note PWR_Sleep() เรียกฟังก์ชันนี้ให้อัตโนมัติ
+ * @note ใช้เวลาคงที่ (เขียน RCC สูงสุด 3 registers)
+ */
+void Clock_GateIdle(void);
+
+/**
+ * @brief อ่าน reference count ปัจจุบัน
+ * @param periph Peripheral ที่ต้องการ
+ * @return จำนวนผู้ใช้งาน
+ */
+uint8_t Clock_GetRefCount(Clock_Periph periph);
+
+/**
+ * @brief Peripheral ที่ clock เปิดอยู่จริงใน RCC (รวมตัวที่ release แล้วแต่ยังไม่ถูก gate)
+ * @return Bitmask (bit n = Clock_Periph n)
+ *
+ * @note SimpleEnergy ใช้แบ่งเวลาทำงานต่อ peripheral
+ */
+uint16_t Clock_GetEnabledMask(void);
+
+/**
+ * @brief แปลง GPIO port เป็น Clock_Periph
+ * @param port GPIOA, GPIOC หรือ GPIOD
+ * @return CLOCK_GPIOx (port ไม่ถูกต้องคืน CLOCK_GPIOA)
+ */
+static inline Clock_Periph Clock_GPIOPeriph(GPIO_TypeDef* port) {
+    if (port == GPIOC) return CLOCK_GPIOC;
+    if (port == GPIOD) return CLOCK_GPIOD;
+    return CLOCK_GPIOA;
+}
+
+/**
+ * @brief Acquire เพียงครั้งเดียวต่อ owner (สำหรับ init ที่เรียกซ้ำได้)
+ * @param periph Peripheral ที่ต้องการ
+ * @param held Bitmask ของ owner ที่บันทึกว่าถือ clock ใดอยู่
+ *
+ * @note เมื่อถืออยู่แล้วเหลือแค่ load + test หนึ่งครั้ง
+ */
+static inline void Clock_AcquireOnce(Clock_Periph periph, uint16_t* held) {
+    uint16_t bit = (uint16_t)(1u << periph);
+    if (!(*held & bit)) {
+        *held |= bit;
+        Clock_Acquire(periph);
+    }
+}
+
+/**
+ * @brief Release clock ที่ owner ถืออยู่ (ถ้าไม่ได้ถือจะไม่ทำอะไร)
+ * @param periph Peripheral ที่เลิกใช้
+ * @param held Bitmask ของ owner
+ */
+static inline void Clock_ReleaseOnce(Clock_Periph periph, uint16_t* held) {
+    uint16_t bit = (uint16_t)(1u << periph);
+    if (*held & bit) {
+        *held &= (uint16_t)~bit;
+        Clock_Release(periph);
+    }
+}
+
+/**
+ * @brief Release ทุก clock ที่ owner ถืออยู่
+ * @param held Bitmask ของ owner (ถูก clear เป็น 0)
+ */
+void Clock_ReleaseAll(uint16_t* held);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_CLOCK_H
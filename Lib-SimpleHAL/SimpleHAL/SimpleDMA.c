@@ -1,28 +1,115 @@
 /**
  * @file SimpleDMA.c
  * @brief Simple DMA Library Implementation
- * @version 1.0
- * @date 2025-12-22
+ * @version 2.0
+ * @date 2026-10-14
  */
 
 #include "SimpleDMA.h"
 #include "SimpleADC.h"
+#include "SimpleClock.h"
+#include "SimpleDelay.h"
+#include "SimpleEvent.h"
+#include "SimplePWR.h"
+#include "SimpleISRStat.h"
 #include <string.h>
 
+/* ========== Private Defines ========== */
+
+// Channel ที่มี interrupt handler (SIMPLE_DMA_CHANNEL_MASK) รับ callback ได้
+#define DMA_HAS_HANDLER(ch)  ((ch) >= DMA_CH1 && (ch) <= DMA_CH7 && \
+                              (DMA_CHANNEL_MASK(ch) & SIMPLE_DMA_CHANNEL_MASK))
+
 /* ========== Private Variables ========== */
 
 // Callback functions สำหรับแต่ละ channel
 static DMA_TransferCompleteCallback transfer_complete_callbacks[7] = {NULL};
 static DMA_ErrorCallback error_callbacks[7] = {NULL};
+static DMA_HalfTransferCallback half_transfer_callbacks[7] = {NULL};
+static uint8_t transfer_complete_deferred = 0;  // bit ต่อ channel: callback ทำใน Event_Dispatch()
 
 // Status tracking
 static volatile DMA_Status channel_status[7] = {DMA_STATUS_IDLE};
 
+#if SIMPLE_DMA_CHAIN
+// Scatter-gather: segment ปัจจุบัน, จำนวนที่เหลือ (รวมตัวปัจจุบัน) และ callback ตอนจบ
+static const DMA_Segment_t* volatile chain_segments[7] = {NULL};
+static volatile uint8_t chain_remaining[7] = {0};
+static DMA_TransferCompleteCallback chain_callbacks[7] = {NULL};
+static uint8_t chain_restore_tcie = 0;  // bit ต่อ channel: ปิด TC interrupt คืนตอนจบ chain
+#endif
+
+// Channel ที่ถูกจองผ่าน DMA_AllocChannel() (bit 0 = CH1)
+static volatile uint8_t channel_allocated = 0;
+
+// Request source → channel ตายตัว (ลำดับตาม DMA_Request, 0 = channel ว่างใดก็ได้)
+static const uint8_t request_channel[] = {
+    0,  // MEM
+    1,  // ADC1
+    2,  // SPI1_RX
+    3,  // SPI1_TX
+    4,  // USART1_TX
+    5,  // USART1_RX
+    6,  // I2C1_TX
+    7,  // I2C1_RX
+    2,  // TIM1_CH1
+    3,  // TIM1_CH2
+    6,  // TIM1_CH3
+    4,  // TIM1_CH4
+    5,  // TIM1_UP
+    5,  // TIM2_CH1
+    7,  // TIM2_CH2
+    1,  // TIM2_CH3
+    7,  // TIM2_CH4
+    2   // TIM2_UP
+};
+
+// Clock ที่ SimpleDMA ถืออยู่
+static uint16_t dma_clocks = 0;
+
 /* ========== Private Function Prototypes ========== */
 
 static DMA_Channel_TypeDef* get_channel_base(DMA_Channel channel);
 static IRQn_Type get_channel_irqn(DMA_Channel channel);
 static void enable_dma_clock(void);
+static void spi_dma_load(DMA_Channel_TypeDef* dma_ch, const void* buffer, uint16_t count, uint8_t increment);
+#if SIMPLE_DMA_CHAIN
+static void dma_chain_load(DMA_Channel_TypeDef* dma_ch, const DMA_Segment_t* segment);
+static uint8_t dma_chain_next(uint8_t idx);
+
+/**
+ * @brief ยุติ chain จาก error interrupt
+ */
+static inline void dma_chain_cancel(uint8_t idx) {
+    chain_remaining[idx] = 0;
+}
+#else
+// ไม่มี chain: TC ทุกครั้งทำงานแบบปกติ
+static inline uint8_t dma_chain_next(uint8_t idx) {
+    (void)idx;
+    return 0;
+}
+
+static inline void dma_chain_cancel(uint8_t idx) {
+    (void)idx;
+}
+#endif
+static void dma_event_handler(uint16_t id, uint16_t arg);
+
+/**
+ * @brief ปิด interrupt และคืนสถานะเดิม (เรียกซ้อนจาก ISR ได้)
+ */
+static inline uint32_t dma_lock(void) {
+    uint32_t mstatus;
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+    return mstatus;
+}
+
+static inline void dma_unlock(uint32_t mstatus) {
+    if (mstatus & 0x8) {
+        __asm volatile ("csrsi mstatus, 0x8");
+    }
+}
 
 /* ========== Public Functions ========== */
 
@@ -158,6 +245,13 @@ void DMA_Stop(DMA_Channel channel) {
 DMA_Status DMA_GetStatus(DMA_Channel channel) {
     uint32_t flag_base = ((channel - 1) * 4);
     
+#if SIMPLE_DMA_CHAIN
+    // ระหว่าง chain TC flag หมายถึงจบ segment ไม่ใช่จบทั้ง chain
+    if (chain_remaining[channel - 1]) {
+        return channel_status[channel - 1];
+    }
+#endif
+    
     // Check transfer complete flag
     if (DMA_GetFlagStatus(DMA1_FLAG_TC1 << flag_base) != RESET) {
         channel_status[channel - 1] = DMA_STATUS_COMPLETE;
@@ -175,12 +269,9 @@ DMA_Status DMA_GetStatus(DMA_Channel channel) {
  * @brief รอให้การถ่ายโอนเสร็จสิ้น (blocking)
  */
 uint8_t DMA_WaitComplete(DMA_Channel channel, uint32_t timeout_ms) {
-    // uint32_t start_time = 0;  // Reserved for future timeout implementation
+    uint32_t start_time = Get_CurrentMs();
     uint8_t use_timeout = (timeout_ms > 0);
     
-    // Note: ต้องมี timer/delay library สำหรับ timeout
-    // สำหรับตอนนี้ใช้ simple polling
-    
     while (1) {
         DMA_Status status = DMA_GetStatus(channel);
         
@@ -192,17 +283,106 @@ uint8_t DMA_WaitComplete(DMA_Channel channel, uint32_t timeout_ms) {
             return 0;
         }
         
-        // TODO: Implement timeout checking with millis()
-        if (use_timeout) {
-            // Placeholder for timeout logic
+        if (use_timeout && IS_TIMEOUT(start_time, timeout_ms)) {
+            return 0;
         }
+        
+        SimpleHAL_Idle();
     }
 }
 
+/**
+ * @brief รอหลาย channels แบบ sleep (WFI) จนเสร็จทั้งหมด
+ */
+uint8_t DMA_WaitAllSleep(uint8_t channel_mask, uint32_t timeout_ms) {
+    uint32_t start_time = Get_CurrentMs();
+    uint8_t armed_tc = 0;  // interrupts ที่เปิดเพิ่มเพื่อปลุก CPU (ปิดคืนตอนจบ)
+    uint8_t armed_te = 0;
+    uint8_t polled = 0;    // มี channel ที่ไม่มี handler ปลุก CPU: poll แทน WFI
+    uint8_t result = 1;
+    
+    channel_mask &= 0x7F;
+    
+    for (uint8_t ch = 1; ch <= 7; ch++) {
+        uint8_t bit = (uint8_t)(1u << (ch - 1));
+        if (!(channel_mask & bit)) continue;
+        
+        // Channel นอก SIMPLE_DMA_CHANNEL_MASK: เปิด interrupt ไปก็ไม่มี handler ล้าง flag
+        if (!DMA_HAS_HANDLER(ch)) {
+            polled = 1;
+            continue;
+        }
+        
+        DMA_Channel_TypeDef* dma_ch = get_channel_base((DMA_Channel)ch);
+        if (!(dma_ch->CFGR & DMA_CFGR1_TCIE)) armed_tc |= bit;
+        if (!(dma_ch->CFGR & DMA_CFGR1_TEIE)) armed_te |= bit;
+        dma_ch->CFGR |= DMA_CFGR1_TCIE | DMA_CFGR1_TEIE;
+        NVIC_EnableIRQ(get_channel_irqn((DMA_Channel)ch));
+    }
+    
+    while (1) {
+        uint8_t busy = 0;
+        
+        SimpleHAL_Idle();
+        
+        // ตรวจสถานะกับ WFI ภายใต้ IRQ ปิด: interrupt ที่มาระหว่างนั้นยังปลุก WFI ได้
+        uint32_t mstatus = dma_lock();
+        
+        for (uint8_t ch = 1; ch <= 7; ch++) {
+            if (!(channel_mask & (1u << (ch - 1)))) continue;
+            
+            DMA_Status status = DMA_GetStatus((DMA_Channel)ch);
+            if (status == DMA_STATUS_ERROR) {
+                result = 0;
+            } else if (status == DMA_STATUS_BUSY) {
+                busy = 1;
+            }
+        }
+        
+        if (!busy || !result) {
+            dma_unlock(mstatus);
+            break;
+        }
+        
+        if (timeout_ms && IS_TIMEOUT(start_time, timeout_ms)) {
+            dma_unlock(mstatus);
+            result = 0;
+            break;
+        }
+        
+        // ตื่นด้วย DMA TC/TE หรือ SysTick (สำหรับ timeout)
+        if (!polled) {
+            PWR_EnterSleepMode(PWR_ENTRY_WFI);
+        }
+        dma_unlock(mstatus);
+    }
+    
+    for (uint8_t ch = 1; ch <= 7; ch++) {
+        uint8_t bit = (uint8_t)(1u << (ch - 1));
+        DMA_Channel_TypeDef* dma_ch;
+        
+        if (!((armed_tc | armed_te) & bit)) continue;
+        dma_ch = get_channel_base((DMA_Channel)ch);
+        if (armed_tc & bit) dma_ch->CFGR &= ~(uint32_t)DMA_CFGR1_TCIE;
+        if (armed_te & bit) dma_ch->CFGR &= ~(uint32_t)DMA_CFGR1_TEIE;
+    }
+    
+    return result;
+}
+
+/**
+ * @brief รอ channel เดียวแบบ sleep (WFI)
+ */
+uint8_t DMA_WaitCompleteSleep(DMA_Channel channel, uint32_t timeout_ms) {
+    return DMA_WaitAllSleep(DMA_CHANNEL_MASK(channel), timeout_ms);
+}
+
 /**
  * @brief ตั้งค่า callback function สำหรับ Transfer Complete
  */
 void DMA_SetTransferCompleteCallback(DMA_Channel channel, DMA_TransferCompleteCallback callback) {
+    SIMPLE_CHECK(DMA_HAS_HANDLER(channel));
+    transfer_complete_deferred &= (uint8_t)~(1u << (channel - 1));
     transfer_complete_callbacks[channel - 1] = callback;
     
     // Enable TC interrupt
@@ -214,10 +394,20 @@ void DMA_SetTransferCompleteCallback(DMA_Channel channel, DMA_TransferCompleteCa
     NVIC_EnableIRQ(irqn);
 }
 
+/**
+ * @brief ตั้ง callback ของ Transfer Complete ที่เรียกจาก Event_Dispatch()
+ */
+void DMA_SetTransferCompleteDeferred(DMA_Channel channel, DMA_TransferCompleteCallback callback) {
+    Event_SetHandler(EVENT_SOURCE_DMA, dma_event_handler);
+    DMA_SetTransferCompleteCallback(channel, callback);
+    transfer_complete_deferred |= (uint8_t)(1u << (channel - 1));
+}
+
 /**
  * @brief ตั้งค่า callback function สำหรับ Error
  */
 void DMA_SetErrorCallback(DMA_Channel channel, DMA_ErrorCallback callback) {
+    SIMPLE_CHECK(DMA_HAS_HANDLER(channel));
     error_callbacks[channel - 1] = callback;
     
     // Enable TE interrupt
@@ -229,6 +419,21 @@ void DMA_SetErrorCallback(DMA_Channel channel, DMA_ErrorCallback callback) {
     NVIC_EnableIRQ(irqn);
 }
 
+/**
+ * @brief ตั้งค่า callback function สำหรับ Half Transfer
+ */
+void DMA_SetHalfTransferCallback(DMA_Channel channel, DMA_HalfTransferCallback callback) {
+    SIMPLE_CHECK(DMA_HAS_HANDLER(channel));
+    half_transfer_callbacks[channel - 1] = callback;
+    
+    DMA_Channel_TypeDef* dma_ch = get_channel_base(channel);
+    DMA_ITConfig(dma_ch, DMA_IT_HT, callback ? ENABLE : DISABLE);
+    
+    if (callback) {
+        NVIC_EnableIRQ(get_channel_irqn(channel));
+    }
+}
+
 /**
  * @brief รีเซ็ต DMA channel
  */
@@ -254,75 +459,465 @@ uint16_t DMA_GetRemainingCount(DMA_Channel channel) {
     return DMA_GetCurrDataCounter(dma_ch);
 }
 
+/* ----- Channel Allocation Functions ----- */
+
+/**
+ * @brief จอง DMA channel สำหรับ request source
+ */
+DMA_Channel DMA_AllocChannel(DMA_Request request) {
+    uint8_t channel = DMA_CH_NONE;
+    
+    if ((uint32_t)request >= sizeof(request_channel)) return DMA_CH_NONE;
+    
+    uint32_t mstatus = dma_lock();
+    
+    uint8_t fixed = request_channel[request];
+    if (fixed) {
+        if (!(channel_allocated & (1u << (fixed - 1)))) {
+            channel = fixed;
+        }
+    } else {
+        // Memory-to-memory: channel เลขสูงก่อน ข้าม channel ที่ module อื่นตั้งไว้นอก allocator
+        // (เปิดอยู่, เปิด interrupt หรือมี callback ค้าง) แม้ว่าตอนนี้จะ idle
+        for (uint8_t ch = 7; ch >= 1; ch--) {
+            uint8_t idx = ch - 1;
+            if (!(channel_allocated & (1u << idx)) &&
+                !(get_channel_base((DMA_Channel)ch)->CFGR &
+                  (DMA_CFGR1_EN | DMA_IT_TC | DMA_IT_HT | DMA_IT_TE)) &&
+                transfer_complete_callbacks[idx] == NULL &&
+                half_transfer_callbacks[idx] == NULL &&
+                error_callbacks[idx] == NULL) {
+                channel = ch;
+                break;
+            }
+        }
+    }
+    
+    if (channel) {
+        channel_allocated |= (uint8_t)(1u << (channel - 1));
+        channel_status[channel - 1] = DMA_STATUS_IDLE;
+    }
+    
+    dma_unlock(mstatus);
+    return (DMA_Channel)channel;
+}
+
+/**
+ * @brief คืน channel ที่จองไว้
+ */
+void DMA_FreeChannel(DMA_Channel channel) {
+    SIMPLE_CHECK(channel >= DMA_CH1 && channel <= DMA_CH7);
+    
+    DMA_Channel_TypeDef* dma_ch = get_channel_base(channel);
+    uint8_t idx = channel - 1;
+    
+    dma_ch->CFGR &= ~(uint32_t)(DMA_CFGR1_EN | DMA_IT_TC | DMA_IT_HT | DMA_IT_TE);
+    
+    transfer_complete_callbacks[idx] = NULL;
+    transfer_complete_deferred &= (uint8_t)~(1u << idx);
+    half_transfer_callbacks[idx] = NULL;
+    error_callbacks[idx] = NULL;
+#if SIMPLE_DMA_CHAIN
+    chain_remaining[idx] = 0;
+    chain_segments[idx] = NULL;
+    chain_callbacks[idx] = NULL;
+#endif
+    channel_status[idx] = DMA_STATUS_IDLE;
+    
+    uint32_t mstatus = dma_lock();
+    channel_allocated &= (uint8_t)~(1u << idx);
+    dma_unlock(mstatus);
+}
+
+/**
+ * @brief ตรวจสอบว่า channel ถูกจองอยู่หรือไม่
+ */
+uint8_t DMA_IsChannelAllocated(DMA_Channel channel) {
+    SIMPLE_CHECK(channel >= DMA_CH1 && channel <= DMA_CH7, 0);
+    return (channel_allocated & (1u << (channel - 1))) ? 1 : 0;
+}
+
 /* ----- Memory Transfer Functions ----- */
 
 /**
- * @brief Copy memory ด้วย DMA (blocking)
+ * @brief Copy ทีละ byte ด้วย CPU (copy สั้นและส่วนหัว/ท้ายที่ไม่ align)
  */
-void DMA_MemCopy(void* dst, const void* src, uint16_t size) {
-    DMA_Config_t config = {
-        .channel = DMA_CH1,
-        .direction = DMA_DIR_MEM_TO_MEM,
-        .priority = DMA_PRIORITY_HIGH,
-        .data_size = DMA_SIZE_BYTE,
-        .mode = DMA_MODE_NORMAL,
-        .mem_increment = 1,
-        .periph_increment = 1,
-        .periph_addr = (uint32_t)src,
-        .mem_addr = (uint32_t)dst,
-        .buffer_size = size
-    };
+static inline void dma_cpu_copy(uint8_t* dst, const uint8_t* src, uint16_t size) {
+    while (size--) {
+        *dst++ = *src++;
+    }
+}
+
+static inline void dma_cpu_set(uint8_t* dst, uint8_t value, uint16_t size) {
+    while (size--) {
+        *dst++ = value;
+    }
+}
+
+/**
+ * @brief เลือก width ที่กว้างที่สุดและแบ่ง head (bytes ก่อน align) กับ body
+ * @param dst destination address
+ * @param phase (dst ^ src) สำหรับ copy หรือ 0 สำหรับ set (source ไม่เลื่อน)
+ * @param size จำนวน bytes ทั้งหมด
+ * @param head [out] จำนวน bytes ก่อน body
+ * @param body [out] จำนวน bytes ของ body (ผลคูณของ width)
+ */
+static DMA_DataSize dma_mem_split(uint32_t dst, uint32_t phase, uint16_t size,
+                                  uint16_t* head, uint16_t* body) {
+    DMA_DataSize width = DMA_SIZE_BYTE;
+    uint16_t unit = 1;
+    
+    // src และ dst ต้อง align ร่วมกันได้ (ผลต่าง address หารด้วย width ลงตัว)
+    if (!(phase & 3)) {
+        width = DMA_SIZE_WORD;
+        unit = 4;
+    } else if (!(phase & 1)) {
+        width = DMA_SIZE_HALFWORD;
+        unit = 2;
+    }
     
-    DMA_SimpleInit(&config);
-    DMA_Start(DMA_CH1);
-    DMA_WaitComplete(DMA_CH1, 0);
+    uint16_t h = (uint16_t)((0u - dst) & (unit - 1));
+    if (h > size) h = size;
+    uint16_t b = (uint16_t)((size - h) & ~(unit - 1));
+    
+    if (b == 0) {
+        // สั้นกว่า 1 word หลัง align: ทั้งหมดเป็น byte
+        width = DMA_SIZE_BYTE;
+        h = 0;
+        b = size;
+    }
+    
+    *head = h;
+    *body = b;
+    return width;
 }
 
 /**
- * @brief Copy memory ด้วย DMA (non-blocking)
+ * @brief ตั้งค่าและเริ่ม memory-to-memory transfer
  */
-void DMA_MemCopyAsync(DMA_Channel channel, void* dst, const void* src, uint16_t size) {
+static void dma_mem_start(DMA_Channel channel, uint32_t dst, uint32_t src, uint16_t bytes,
+                          DMA_DataSize width, uint8_t src_increment) {
     DMA_Config_t config = {
         .channel = channel,
         .direction = DMA_DIR_MEM_TO_MEM,
         .priority = DMA_PRIORITY_HIGH,
-        .data_size = DMA_SIZE_BYTE,
+        .data_size = width,
         .mode = DMA_MODE_NORMAL,
         .mem_increment = 1,
-        .periph_increment = 1,
-        .periph_addr = (uint32_t)src,
-        .mem_addr = (uint32_t)dst,
-        .buffer_size = size
+        .periph_increment = src_increment,
+        .periph_addr = src,
+        .mem_addr = dst,
+        .buffer_size = (uint16_t)(bytes >> width)  // จำนวน transfer ตาม width
     };
     
     DMA_SimpleInit(&config);
     DMA_Start(channel);
 }
 
+/**
+ * @brief Copy memory ด้วย DMA (blocking)
+ */
+void DMA_MemCopy(void* dst, const void* src, uint16_t size) {
+    if (size < SIMPLE_DMA_MEM_MIN_BYTES) {
+        dma_cpu_copy((uint8_t*)dst, (const uint8_t*)src, size);
+        return;
+    }
+    
+    DMA_Channel channel = DMA_AllocChannel(DMA_REQ_MEM);
+    if (channel == DMA_CH_NONE) {
+        memcpy(dst, src, size);  // ทุก channel ถูกใช้อยู่
+        return;
+    }
+    
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+    uint16_t head, body;
+    DMA_DataSize width = dma_mem_split((uint32_t)d, (uint32_t)d ^ (uint32_t)s, size, &head, &body);
+    
+    dma_cpu_copy(d, s, head);
+    dma_mem_start(channel, (uint32_t)(d + head), (uint32_t)(s + head), body, width, 1);
+    
+    // tail ระหว่าง DMA ทำงาน (คนละ address กับ body)
+    dma_cpu_copy(d + head + body, s + head + body, size - head - body);
+    
+    DMA_WaitComplete(channel, 0);
+    DMA_FreeChannel(channel);
+}
+
+/**
+ * @brief Copy memory ด้วย DMA (non-blocking)
+ */
+void DMA_MemCopyAsync(DMA_Channel channel, void* dst, const void* src, uint16_t size) {
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+    uint16_t head, body;
+    
+    if (size == 0) return;
+    
+    DMA_DataSize width = dma_mem_split((uint32_t)d, (uint32_t)d ^ (uint32_t)s, size, &head, &body);
+    
+    // head/tail ไม่เกิน 3 bytes ต่อด้าน copy ด้วย CPU ทันที
+    dma_cpu_copy(d, s, head);
+    dma_cpu_copy(d + head + body, s + head + body, size - head - body);
+    dma_mem_start(channel, (uint32_t)(d + head), (uint32_t)(s + head), body, width, 1);
+}
+
 /**
  * @brief Set memory ด้วย DMA
  */
 void DMA_MemSet(void* dst, uint8_t value, uint16_t size) {
-    // Create a single-byte source
-    static uint8_t fill_value;
+    if (size < SIMPLE_DMA_MEM_MIN_BYTES) {
+        dma_cpu_set((uint8_t*)dst, value, size);
+        return;
+    }
+    
+    DMA_Channel channel = DMA_AllocChannel(DMA_REQ_MEM);
+    if (channel == DMA_CH_NONE) {
+        memset(dst, value, size);  // ทุก channel ถูกใช้อยู่
+        return;
+    }
+    
+    // Source คงที่: ค่าเดียวกันทุก byte ของ word ใช้ได้กับทุก width
+    static uint32_t fill_value;
     fill_value = value;
+    fill_value |= fill_value << 8;
+    fill_value |= fill_value << 16;
     
-    DMA_Config_t config = {
-        .channel = DMA_CH1,
-        .direction = DMA_DIR_MEM_TO_MEM,
-        .priority = DMA_PRIORITY_HIGH,
-        .data_size = DMA_SIZE_BYTE,
-        .mode = DMA_MODE_NORMAL,
-        .mem_increment = 1,
-        .periph_increment = 0,  // Don't increment source
-        .periph_addr = (uint32_t)&fill_value,
-        .mem_addr = (uint32_t)dst,
-        .buffer_size = size
-    };
+    uint8_t* d = (uint8_t*)dst;
+    uint16_t head, body;
+    DMA_DataSize width = dma_mem_split((uint32_t)d, 0, size, &head, &body);
     
-    DMA_SimpleInit(&config);
-    DMA_Start(DMA_CH1);
-    DMA_WaitComplete(DMA_CH1, 0);
+    dma_cpu_set(d, value, head);
+    dma_mem_start(channel, (uint32_t)(d + head), (uint32_t)&fill_value, body, width, 0);
+    dma_cpu_set(d + head + body, value, size - head - body);
+    
+    DMA_WaitComplete(channel, 0);
+    DMA_FreeChannel(channel);
+}
+
+#if SIMPLE_DMA_CHAIN
+/* ----- Scatter-Gather Functions ----- */
+
+/**
+ * @brief เริ่มถ่ายโอนหลาย segments ต่อกันบน channel เดียว
+ */
+uint8_t DMA_ChainStart(DMA_Channel channel, const DMA_Segment_t* segments, uint8_t count,
+                       DMA_TransferCompleteCallback callback) {
+    if (segments == NULL || count == 0) return 0;
+    SIMPLE_CHECK(DMA_HAS_HANDLER(channel), 0);
+    
+    for (uint8_t i = 0; i < count; i++) {
+        if (segments[i].length == 0) return 0;  // CNTR = 0 ไม่เกิด TC
+    }
+    
+    DMA_Channel_TypeDef* dma_ch = get_channel_base(channel);
+    uint8_t idx = channel - 1;
+    
+    if ((dma_ch->CFGR & DMA_CFGR1_EN) || chain_remaining[idx]) {
+        return 0;  // channel กำลังทำงาน
+    }
+    
+    chain_segments[idx] = segments;
+    chain_callbacks[idx] = callback;
+    chain_remaining[idx] = count;
+    
+    if (dma_ch->CFGR & DMA_CFGR1_TCIE) {
+        chain_restore_tcie &= ~(1u << idx);
+    } else {
+        chain_restore_tcie |= (1u << idx);
+    }
+    
+    dma_chain_load(dma_ch, segments);
+    DMA_ITConfig(dma_ch, DMA_IT_TC, ENABLE);
+    NVIC_EnableIRQ(get_channel_irqn(channel));
+    DMA_Start(channel);
+    return 1;
+}
+
+/**
+ * @brief ตรวจสอบว่า chain ยังทำงานอยู่หรือไม่
+ */
+uint8_t DMA_ChainBusy(DMA_Channel channel) {
+    return chain_remaining[channel - 1] ? 1 : 0;
+}
+
+/**
+ * @brief ยกเลิก chain
+ */
+void DMA_ChainAbort(DMA_Channel channel) {
+    DMA_Channel_TypeDef* dma_ch = get_channel_base(channel);
+    uint8_t idx = channel - 1;
+    
+    DMA_Cmd(dma_ch, DISABLE);
+    
+    if (chain_remaining[idx]) {
+        chain_remaining[idx] = 0;
+        chain_segments[idx] = NULL;
+        chain_callbacks[idx] = NULL;
+        if (chain_restore_tcie & (1u << idx)) {
+            DMA_ITConfig(dma_ch, DMA_IT_TC, DISABLE);
+        }
+    }
+    
+    channel_status[idx] = DMA_STATUS_IDLE;
+}
+#endif  // SIMPLE_DMA_CHAIN
+
+/* ----- Ping-Pong Stream Functions ----- */
+
+// Stream ที่ผูกกับแต่ละ channel
+static DMA_Stream_t* volatile stream_objects[7] = {NULL};
+
+// Callback, status และ chain tables ต่อ channel (SimpleHAL_RamReport())
+const uint16_t dma_ram_bytes = sizeof(transfer_complete_callbacks) + sizeof(error_callbacks) +
+                               sizeof(half_transfer_callbacks) + sizeof(channel_status) +
+#if SIMPLE_DMA_CHAIN
+                               sizeof(chain_segments) + sizeof(chain_remaining) +
+                               sizeof(chain_callbacks) +
+#endif
+                               sizeof(stream_objects);
+
+/**
+ * @brief ครึ่งที่ DMA เขียนเสร็จแล้ว (half = 0 ครึ่งแรก, 1 ครึ่งหลัง)
+ */
+static void dma_stream_event(uint8_t idx, uint8_t half) {
+    DMA_Stream_t* stream = stream_objects[idx];
+    if (stream == NULL) return;
+    
+    uint8_t* data = stream->buffer + (half ? (uint32_t)stream->half_length * stream->element_size : 0);
+    stream->stats.blocks++;
+    
+    if (stream->callback != NULL) {
+        stream->callback(data, stream->half_length);
+        
+        // หลัง callback DMA ต้องยังอยู่ในอีกครึ่ง ไม่อย่างนั้นเขียนทับครึ่งที่เพิ่งส่งไปแล้ว
+        uint16_t remaining = (uint16_t)get_channel_base((DMA_Channel)(idx + 1))->CNTR;
+        uint8_t late = half ? (remaining <= stream->half_length) : (remaining > stream->half_length);
+        if (late) {
+            stream->overrun = 1;
+            stream->stats.overruns++;
+        }
+        return;
+    }
+    
+    // Poll mode: ครึ่งก่อนยังไม่ถูกหยิบ หรือยังประมวลผลครึ่งที่ DMA กำลังจะเขียน
+    if (stream->ready || stream->held == (uint8_t)((half ^ 1) + 1)) {
+        stream->overrun = 1;
+        stream->stats.overruns++;
+    }
+    stream->ready = (uint8_t)(half + 1);
+}
+
+static void dma_stream_half(DMA_Channel channel) {
+    dma_stream_event(channel - 1, 0);
+}
+
+static void dma_stream_full(DMA_Channel channel) {
+    dma_stream_event(channel - 1, 1);
+}
+
+/**
+ * @brief เริ่ม ping-pong stream บน channel ที่ตั้งค่า peripheral ไว้แล้ว
+ */
+uint8_t DMA_StreamStart(DMA_Stream_t* stream, DMA_Channel channel, void* buffer,
+                        uint16_t length, DMA_StreamCallback callback) {
+    if (stream == NULL || buffer == NULL || length < 2) return 0;
+    SIMPLE_CHECK(DMA_HAS_HANDLER(channel), 0);
+    
+    DMA_Channel_TypeDef* dma_ch = get_channel_base(channel);
+    uint8_t idx = channel - 1;
+    
+    DMA_Cmd(dma_ch, DISABLE);
+    
+    stream->channel = channel;
+    stream->buffer = (uint8_t*)buffer;
+    stream->half_length = length >> 1;
+    stream->element_size = (uint8_t)(1u << ((dma_ch->CFGR & DMA_CFGR1_MSIZE) >> 10));
+    stream->callback = callback;
+    stream->ready = 0;
+    stream->held = 0;
+    stream->overrun = 0;
+    stream->stats.blocks = 0;
+    stream->stats.overruns = 0;
+    stream_objects[idx] = stream;
+    
+    // Circular ทั้ง buffer (จำนวนคู่เพื่อให้สองครึ่งเท่ากัน)
+    dma_ch->MADDR = (uint32_t)buffer;
+    dma_ch->CNTR = (uint32_t)stream->half_length << 1;
+    dma_ch->CFGR |= DMA_CFGR1_CIRC | DMA_CFGR1_MINC;
+    
+    DMA_SetHalfTransferCallback(channel, dma_stream_half);
+    DMA_SetTransferCompleteCallback(channel, dma_stream_full);
+    DMA_ClearFlag(DMA1_FLAG_GL1 << (idx * 4));
+    DMA_Start(channel);
+    return 1;
+}
+
+/**
+ * @brief หยุด stream
+ */
+void DMA_StreamStop(DMA_Stream_t* stream) {
+    if (stream == NULL || stream_objects[stream->channel - 1] != stream) return;
+    
+    DMA_Channel_TypeDef* dma_ch = get_channel_base(stream->channel);
+    uint8_t idx = stream->channel - 1;
+    
+    DMA_Cmd(dma_ch, DISABLE);
+    DMA_ITConfig(dma_ch, DMA_IT_TC, DISABLE);
+    DMA_SetHalfTransferCallback(stream->channel, NULL);
+    transfer_complete_callbacks[idx] = NULL;
+    stream_objects[idx] = NULL;
+    channel_status[idx] = DMA_STATUS_IDLE;
+}
+
+/**
+ * @brief หยิบครึ่ง buffer ที่พร้อม (poll mode)
+ */
+void* DMA_StreamGet(DMA_Stream_t* stream, uint16_t* length) {
+    uint32_t mstatus = dma_lock();
+    uint8_t ready = stream->ready;
+    
+    stream->ready = 0;
+    if (ready) {
+        stream->held = ready;
+    }
+    dma_unlock(mstatus);
+    
+    if (!ready) return NULL;
+    
+    if (length) *length = stream->half_length;
+    return stream->buffer + ((ready == 2) ? (uint32_t)stream->half_length * stream->element_size : 0);
+}
+
+/**
+ * @brief คืนครึ่ง buffer หลังประมวลผลเสร็จ (poll mode)
+ */
+void DMA_StreamRelease(DMA_Stream_t* stream) {
+    stream->held = 0;
+}
+
+/**
+ * @brief อ่านและล้าง overrun flag
+ */
+uint8_t DMA_StreamOverrun(DMA_Stream_t* stream) {
+    uint8_t overrun = stream->overrun;
+    stream->overrun = 0;
+    return overrun;
+}
+
+/**
+ * @brief อ่านสถิติของ stream
+ */
+void DMA_StreamGetStats(DMA_Stream_t* stream, DMA_StreamStats_t* stats, uint8_t reset) {
+    uint32_t mstatus = dma_lock();
+    
+    stats->blocks = stream->stats.blocks;
+    stats->overruns = stream->stats.overruns;
+    if (reset) {
+        stream->stats.blocks = 0;
+        stream->stats.overruns = 0;
+    }
+    dma_unlock(mstatus);
 }
 
 /* ----- ADC Integration Functions ----- */
@@ -434,10 +1029,35 @@ uint16_t DMA_USART_GetReceivedCount(DMA_Channel channel, uint16_t buffer_size) {
 
 /* ----- SPI Integration Functions ----- */
 
+// Channel ที่ DMA_SPI_Init() จองไว้ (เรียกซ้ำได้โดยไม่จองซ้ำ)
+static uint8_t spi_dma_owned = 0;
+
+/**
+ * @brief จอง channel ของ SPI1 request (ต้องตรงกับ channel ที่ผู้เรียกระบุ)
+ */
+static uint8_t spi_dma_claim(DMA_Channel channel, DMA_Request request) {
+    if (spi_dma_owned & DMA_CHANNEL_MASK(channel)) return 1;
+    
+    DMA_Channel got = DMA_AllocChannel(request);
+    if (got == DMA_CH_NONE) return 0;
+    if (got != channel) {
+        DMA_FreeChannel(got);
+        return 0;
+    }
+    spi_dma_owned |= DMA_CHANNEL_MASK(channel);
+    return 1;
+}
+
 /**
  * @brief เริ่มต้น DMA สำหรับ SPI transmission
  */
-void DMA_SPI_Init(DMA_Channel tx_channel, DMA_Channel rx_channel) {
+uint8_t DMA_SPI_Init(DMA_Channel tx_channel, DMA_Channel rx_channel) {
+    if (!spi_dma_claim(tx_channel, DMA_REQ_SPI1_TX)) return 0;
+    if (!spi_dma_claim(rx_channel, DMA_REQ_SPI1_RX)) {
+        DMA_SPI_End(tx_channel, DMA_CH_NONE);
+        return 0;
+    }
+    
     // TX configuration
     DMA_Config_t tx_config = {
         .channel = tx_channel,
@@ -473,6 +1093,22 @@ void DMA_SPI_Init(DMA_Channel tx_channel, DMA_Channel rx_channel) {
     // Enable SPI DMA
     SPI_I2S_DMACmd(SPI1, SPI_I2S_DMAReq_Tx, ENABLE);
     SPI_I2S_DMACmd(SPI1, SPI_I2S_DMAReq_Rx, ENABLE);
+    return 1;
+}
+
+/**
+ * @brief คืน channel ที่ DMA_SPI_Init() จองไว้
+ */
+void DMA_SPI_End(DMA_Channel tx_channel, DMA_Channel rx_channel) {
+    DMA_Channel channels[2] = {tx_channel, rx_channel};
+    
+    for (uint8_t i = 0; i < 2; i++) {
+        if (channels[i] != DMA_CH_NONE && (spi_dma_owned & DMA_CHANNEL_MASK(channels[i]))) {
+            spi_dma_owned &= (uint8_t)~DMA_CHANNEL_MASK(channels[i]);
+            DMA_FreeChannel(channels[i]);
+        }
+    }
+    SPI_I2S_DMACmd(SPI1, SPI_I2S_DMAReq_Tx | SPI_I2S_DMAReq_Rx, DISABLE);
 }
 
 /**
@@ -480,26 +1116,43 @@ void DMA_SPI_Init(DMA_Channel tx_channel, DMA_Channel rx_channel) {
  */
 void DMA_SPI_TransferBuffer(DMA_Channel tx_channel, DMA_Channel rx_channel, 
                            const uint8_t* tx_data, uint8_t* rx_data, uint16_t length) {
-    DMA_Channel_TypeDef* tx_ch = get_channel_base(tx_channel);
-    DMA_Channel_TypeDef* rx_ch = get_channel_base(rx_channel);
-    
-    // Configure RX
-    DMA_Cmd(rx_ch, DISABLE);
-    rx_ch->MADDR = (uint32_t)rx_data;
-    rx_ch->CNTR = length;
-    
-    // Configure TX
-    DMA_Cmd(tx_ch, DISABLE);
-    tx_ch->MADDR = (uint32_t)tx_data;
-    tx_ch->CNTR = length;
+    // Configure RX และ TX (length = จำนวน frame ตามขนาด frame ของ SPI)
+    spi_dma_load(get_channel_base(rx_channel), rx_data, length, 1);
+    spi_dma_load(get_channel_base(tx_channel), tx_data, length, 1);
     
     // Start RX first, then TX
     DMA_Start(rx_channel);
     DMA_Start(tx_channel);
     
-    // Wait for completion
-    DMA_WaitComplete(tx_channel, 0);
-    DMA_WaitComplete(rx_channel, 0);
+    // Wait for completion (sleep จน TX และ RX เสร็จทั้งคู่)
+    DMA_WaitAllSleep(DMA_CHANNEL_MASK(tx_channel) | DMA_CHANNEL_MASK(rx_channel), 0);
+}
+
+static uint16_t spi_fill_value;  // DMA อ่านค่านี้ซ้ำ (ต้องอยู่จน fill เสร็จ)
+
+/**
+ * @brief ส่งค่าเดียวซ้ำ count ครั้งผ่าน SPI ด้วย DMA (memory address คงที่)
+ */
+void DMA_SPI_Fill(DMA_Channel tx_channel, uint16_t value, uint16_t count) {
+    // รอ transfer ก่อนหน้า (spi_fill_value อาจกำลังถูกอ่าน)
+    while (DMA_GetStatus(tx_channel) == DMA_STATUS_BUSY);
+    
+    spi_fill_value = value;
+    spi_dma_load(get_channel_base(tx_channel), &spi_fill_value, count, 0);
+    DMA_Start(tx_channel);
+}
+
+/**
+ * @brief ตรวจสอบว่า SPI write-only DMA ส่งครบและออกจากสายแล้ว
+ */
+uint8_t DMA_SPI_TxDone(DMA_Channel tx_channel) {
+    if (DMA_GetStatus(tx_channel) == DMA_STATUS_BUSY) return 0;
+    if (!(SPI1->STATR & SPI_STATR_TXE) || (SPI1->STATR & SPI_STATR_BSY)) return 0;
+    
+    // ไม่ได้อ่าน RX: ล้าง RXNE/OVR ก่อน transfer ถัดไป
+    (void)SPI1->DATAR;
+    (void)SPI1->STATR;
+    return 1;
 }
 
 /* ----- Simplified analogRead DMA Functions ----- */
@@ -533,31 +1186,39 @@ void DMA_analogReadStart(uint8_t pin, uint16_t* buffer, uint16_t buffer_size, ui
     // Configure GPIO as analog input (using SimpleADC)
     ADC_EnableChannel((ADC_Channel)adc_ch);
     
-    // ตั้งค่า ADC สำหรับ continuous conversion
-    ADC_InitTypeDef ADC_InitStructure = {0};
-    
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_ADC1, ENABLE);
-    RCC_ADCCLKConfig(RCC_PCLK2_Div8);
+    // ADC ยัง continuous + DMA อยู่: re-arm แค่ channel และ DMA pointer
+    if (adc_dma_active && (ADC1->CTLR2 & (ADC_CONT | ADC_DMA)) == (ADC_CONT | ADC_DMA)) {
+        DMA_Channel_TypeDef* dma_ch = get_channel_base(adc_dma_channel);
+        
+        DMA_Cmd(dma_ch, DISABLE);
+        ADC_RegularChannelConfig(ADC1, adc_ch, 1, ADC_SampleTime_241Cycles);
+        
+        // ทิ้ง conversion ที่ค้างอยู่ของ channel เดิม (ไม่เกิน 1 conversion)
+        (void)ADC1->RDATAR;
+        while (!(ADC1->STATR & ADC_EOC));
+        (void)ADC1->RDATAR;
+        
+        if (continuous) {
+            dma_ch->CFGR |= DMA_CFGR1_CIRC;
+        } else {
+            dma_ch->CFGR &= (uint16_t)~DMA_CFGR1_CIRC;
+        }
+        dma_ch->MADDR = (uint32_t)buffer;
+        dma_ch->CNTR = buffer_size;
+        DMA_ClearFlag(DMA1_FLAG_GL1 << ((adc_dma_channel - 1) * 4));
+        DMA_Start(adc_dma_channel);
+        return;
+    }
     
-    ADC_DeInit(ADC1);
-    ADC_InitStructure.ADC_Mode = ADC_Mode_Independent;
-    ADC_InitStructure.ADC_ScanConvMode = DISABLE;
-    ADC_InitStructure.ADC_ContinuousConvMode = ENABLE;
-    ADC_InitStructure.ADC_ExternalTrigConv = ADC_ExternalTrigConv_None;
-    ADC_InitStructure.ADC_DataAlign = ADC_DataAlign_Right;
-    ADC_InitStructure.ADC_NbrOfChannel = 1;
-    ADC_Init(ADC1, &ADC_InitStructure);
+    // จอง CH1 (ADC1 request) ครั้งแรก: ถ้า ADC streaming ถือไว้อยู่ไม่เริ่ม
+    if (!adc_dma_active) {
+        if (DMA_AllocChannel(DMA_REQ_ADC1) == DMA_CH_NONE) return;
+    }
     
+    // ตั้งค่า ADC สำหรับ continuous conversion (calibrate เฉพาะครั้งแรก)
+    ADC_Configure(ADC_ExternalTrigConv_None, 1, 1);
     ADC_RegularChannelConfig(ADC1, adc_ch, 1, ADC_SampleTime_241Cycles);
     
-    ADC_Cmd(ADC1, ENABLE);
-    
-    // Calibration
-    ADC_ResetCalibration(ADC1);
-    while(ADC_GetResetCalibrationStatus(ADC1));
-    ADC_StartCalibration(ADC1);
-    while(ADC_GetCalibrationStatus(ADC1));
-    
     // ตั้งค่า DMA
     DMA_ADC_Init(adc_dma_channel, buffer, buffer_size, continuous);
     DMA_Start(adc_dma_channel);
@@ -586,12 +1247,14 @@ uint16_t DMA_analogReadAverage(uint16_t* buffer, uint16_t buffer_size) {
  */
 void DMA_analogReadStop(void) {
     if (adc_dma_active) {
-        // หยุด ADC
+        // หยุด continuous conversion (ADC ยังเปิดอยู่ ค่า calibration ไม่หาย)
         ADC_SoftwareStartConvCmd(ADC1, DISABLE);
-        ADC_Cmd(ADC1, DISABLE);
+        ADC_DMACmd(ADC1, DISABLE);
+        ADC1->CTLR2 &= ~ADC_CONT;
         
-        // หยุด DMA
+        // หยุด DMA และคืน channel
         DMA_Stop(adc_dma_channel);
+        DMA_FreeChannel(adc_dma_channel);
         
         adc_dma_active = 0;
     }
@@ -667,165 +1330,363 @@ static IRQn_Type get_channel_irqn(DMA_Channel channel) {
     }
 }
 
+/**
+ * @brief ตั้ง channel SPI ตามขนาด frame ปัจจุบัน (DFF) และโหมด increment
+ * @param increment 0 = อ่าน/เขียน address เดิมซ้ำ (fill)
+ */
+static void spi_dma_load(DMA_Channel_TypeDef* dma_ch, const void* buffer, uint16_t count, uint8_t increment) {
+    uint16_t cfgr;
+    
+    DMA_Cmd(dma_ch, DISABLE);
+    
+    cfgr = dma_ch->CFGR & (uint16_t)~(DMA_CFGR1_MINC | DMA_CFGR1_PSIZE | DMA_CFGR1_MSIZE);
+    if (increment) {
+        cfgr |= DMA_CFGR1_MINC;
+    }
+    if (SPI1->CTLR1 & SPI_DataSize_16b) {
+        cfgr |= DMA_PeripheralDataSize_HalfWord | DMA_MemoryDataSize_HalfWord;
+    }
+    
+    dma_ch->CFGR = cfgr;
+    dma_ch->MADDR = (uint32_t)buffer;
+    dma_ch->CNTR = count;
+}
+
 /**
  * @brief Enable DMA clock
  */
 static void enable_dma_clock(void) {
-    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+    Clock_AcquireOnce(CLOCK_DMA1, &dma_clocks);
+}
+
+#if SIMPLE_DMA_CHAIN
+/**
+ * @brief โหลด segment ลง channel (channel ถูกปิดไว้ ผู้เรียกเปิดเอง)
+ */
+static void dma_chain_load(DMA_Channel_TypeDef* dma_ch, const DMA_Segment_t* segment) {
+    uint32_t width = segment->width & 0x03;
+    uint32_t cfgr = dma_ch->CFGR & ~(uint32_t)(DMA_CFGR1_EN | DMA_CFGR1_CIRC |
+                                               DMA_CFGR1_PSIZE | DMA_CFGR1_MSIZE);
+    
+    dma_ch->CFGR = cfgr;
+    
+    // DIR = 1: memory → peripheral (MADDR เป็น source), อื่น ๆ รวม M2M: PADDR เป็น source
+    if (cfgr & DMA_CFGR1_DIR) {
+        dma_ch->MADDR = segment->src;
+        dma_ch->PADDR = segment->dst;
+    } else {
+        dma_ch->PADDR = segment->src;
+        dma_ch->MADDR = segment->dst;
+    }
+    
+    dma_ch->CNTR = segment->length;
+    dma_ch->CFGR = cfgr | (width << 8) | (width << 10);
+}
+
+/**
+ * @brief เรียกจาก TC interrupt: โหลด segment ถัดไปหรือจบ chain
+ * @return 1 = chain จัดการ TC นี้แล้ว, 0 = ไม่มี chain (ทำงานแบบปกติ)
+ */
+static uint8_t dma_chain_next(uint8_t idx) {
+    uint8_t remaining = chain_remaining[idx];
+    if (remaining == 0) return 0;
+    
+    DMA_Channel_TypeDef* dma_ch = get_channel_base((DMA_Channel)(idx + 1));
+    
+    if (--remaining) {
+        const DMA_Segment_t* next = chain_segments[idx] + 1;
+        chain_segments[idx] = next;
+        chain_remaining[idx] = remaining;
+        
+        dma_chain_load(dma_ch, next);
+        dma_ch->CFGR |= DMA_CFGR1_EN;
+        return 1;
+    }
+    
+    // Segment สุดท้าย: ปิด channel และเรียก callback ครั้งเดียว
+    DMA_TransferCompleteCallback callback = chain_callbacks[idx];
+    
+    dma_ch->CFGR &= ~(uint32_t)DMA_CFGR1_EN;
+    if (chain_restore_tcie & (1u << idx)) {
+        dma_ch->CFGR &= ~(uint32_t)DMA_CFGR1_TCIE;
+    }
+    
+    chain_segments[idx] = NULL;
+    chain_callbacks[idx] = NULL;
+    chain_remaining[idx] = 0;
+    channel_status[idx] = DMA_STATUS_COMPLETE;
+    
+    if (callback != NULL) {
+        callback((DMA_Channel)(idx + 1));
+    }
+    return 1;
+}
+#endif  // SIMPLE_DMA_CHAIN
+
+/**
+ * @brief เรียก callback ของ Transfer Complete หรือ post ไปทำใน main loop
+ */
+static inline __attribute__((always_inline)) void dma_transfer_complete(uint8_t idx) {
+    DMA_TransferCompleteCallback callback = transfer_complete_callbacks[idx];
+    if (callback == NULL) return;
+    
+    // DMA IRQ ใช้ preemption priority 0 (ค่าเริ่มต้นของ NVIC_EnableIRQ)
+    if (transfer_complete_deferred & (1u << idx)) {
+        Event_Defer(EVENT_RING_HIGH, EVENT_ID(EVENT_SOURCE_DMA, idx), 0);
+    } else {
+        callback((DMA_Channel)(idx + 1));
+    }
+}
+
+/**
+ * @brief Deferred Transfer Complete (เรียกจาก Event_Dispatch())
+ */
+static void dma_event_handler(uint16_t id, uint16_t arg) {
+    (void)arg;
+    uint8_t idx = EVENT_INDEX(id);
+    DMA_TransferCompleteCallback callback = (idx < 7) ? transfer_complete_callbacks[idx] : NULL;
+    
+    if (callback != NULL) {
+        callback((DMA_Channel)(idx + 1));
+    }
 }
 
 /* ========== Interrupt Handlers ========== */
 
+#if SIMPLE_DMA_CHANNEL_MASK & 0x01
 /**
  * @brief DMA Channel 1 interrupt handler
  */
 void DMA1_Channel1_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
 void DMA1_Channel1_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_DMA_CH1);
+    if (DMA_GetITStatus(DMA1_IT_HT1) != RESET) {
+        DMA_ClearITPendingBit(DMA1_IT_HT1);
+        if (half_transfer_callbacks[0] != NULL) {
+            half_transfer_callbacks[0](DMA_CH1);
+        }
+    }
+    
     if (DMA_GetITStatus(DMA1_IT_TC1) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TC1);
-        channel_status[0] = DMA_STATUS_COMPLETE;
-        if (transfer_complete_callbacks[0] != NULL) {
-            transfer_complete_callbacks[0](DMA_CH1);
+        if (!dma_chain_next(0)) {
+            channel_status[0] = DMA_STATUS_COMPLETE;
+            dma_transfer_complete(0);
         }
     }
     
     if (DMA_GetITStatus(DMA1_IT_TE1) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TE1);
         channel_status[0] = DMA_STATUS_ERROR;
+        dma_chain_cancel(0);
         if (error_callbacks[0] != NULL) {
             error_callbacks[0](DMA_CH1);
         }
     }
+    ISR_STAT_EXIT(ISR_STAT_DMA_CH1);
 }
+#endif
 
+#if SIMPLE_DMA_CHANNEL_MASK & 0x02
 /**
  * @brief DMA Channel 2 interrupt handler
  */
 void DMA1_Channel2_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
 void DMA1_Channel2_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_DMA_CH2);
+    if (DMA_GetITStatus(DMA1_IT_HT2) != RESET) {
+        DMA_ClearITPendingBit(DMA1_IT_HT2);
+        if (half_transfer_callbacks[1] != NULL) {
+            half_transfer_callbacks[1](DMA_CH2);
+        }
+    }
+    
     if (DMA_GetITStatus(DMA1_IT_TC2) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TC2);
-        channel_status[1] = DMA_STATUS_COMPLETE;
-        if (transfer_complete_callbacks[1] != NULL) {
-            transfer_complete_callbacks[1](DMA_CH2);
+        if (!dma_chain_next(1)) {
+            channel_status[1] = DMA_STATUS_COMPLETE;
+            dma_transfer_complete(1);
         }
     }
     
     if (DMA_GetITStatus(DMA1_IT_TE2) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TE2);
         channel_status[1] = DMA_STATUS_ERROR;
+        dma_chain_cancel(1);
         if (error_callbacks[1] != NULL) {
             error_callbacks[1](DMA_CH2);
         }
     }
+    ISR_STAT_EXIT(ISR_STAT_DMA_CH2);
 }
+#endif
 
+#if SIMPLE_DMA_CHANNEL_MASK & 0x04
 /**
  * @brief DMA Channel 3 interrupt handler
  */
 void DMA1_Channel3_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
 void DMA1_Channel3_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_DMA_CH3);
+    if (DMA_GetITStatus(DMA1_IT_HT3) != RESET) {
+        DMA_ClearITPendingBit(DMA1_IT_HT3);
+        if (half_transfer_callbacks[2] != NULL) {
+            half_transfer_callbacks[2](DMA_CH3);
+        }
+    }
+    
     if (DMA_GetITStatus(DMA1_IT_TC3) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TC3);
-        channel_status[2] = DMA_STATUS_COMPLETE;
-        if (transfer_complete_callbacks[2] != NULL) {
-            transfer_complete_callbacks[2](DMA_CH3);
+        if (!dma_chain_next(2)) {
+            channel_status[2] = DMA_STATUS_COMPLETE;
+            dma_transfer_complete(2);
         }
     }
     
     if (DMA_GetITStatus(DMA1_IT_TE3) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TE3);
         channel_status[2] = DMA_STATUS_ERROR;
+        dma_chain_cancel(2);
         if (error_callbacks[2] != NULL) {
             error_callbacks[2](DMA_CH3);
         }
     }
+    ISR_STAT_EXIT(ISR_STAT_DMA_CH3);
 }
+#endif
 
+#if SIMPLE_DMA_CHANNEL_MASK & 0x08
 /**
  * @brief DMA Channel 4 interrupt handler
  */
 void DMA1_Channel4_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
 void DMA1_Channel4_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_DMA_CH4);
+    if (DMA_GetITStatus(DMA1_IT_HT4) != RESET) {
+        DMA_ClearITPendingBit(DMA1_IT_HT4);
+        if (half_transfer_callbacks[3] != NULL) {
+            half_transfer_callbacks[3](DMA_CH4);
+        }
+    }
+    
     if (DMA_GetITStatus(DMA1_IT_TC4) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TC4);
-        channel_status[3] = DMA_STATUS_COMPLETE;
-        if (transfer_complete_callbacks[3] != NULL) {
-            transfer_complete_callbacks[3](DMA_CH4);
+        if (!dma_chain_next(3)) {
+            channel_status[3] = DMA_STATUS_COMPLETE;
+            dma_transfer_complete(3);
         }
     }
     
     if (DMA_GetITStatus(DMA1_IT_TE4) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TE4);
         channel_status[3] = DMA_STATUS_ERROR;
+        dma_chain_cancel(3);
         if (error_callbacks[3] != NULL) {
             error_callbacks[3](DMA_CH4);
         }
     }
+    ISR_STAT_EXIT(ISR_STAT_DMA_CH4);
 }
+#endif
 
+#if SIMPLE_DMA_CHANNEL_MASK & 0x10
 /**
  * @brief DMA Channel 5 interrupt handler
  */
 void DMA1_Channel5_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
 void DMA1_Channel5_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_DMA_CH5);
+    if (DMA_GetITStatus(DMA1_IT_HT5) != RESET) {
+        DMA_ClearITPendingBit(DMA1_IT_HT5);
+        if (half_transfer_callbacks[4] != NULL) {
+            half_transfer_callbacks[4](DMA_CH5);
+        }
+    }
+    
     if (DMA_GetITStatus(DMA1_IT_TC5) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TC5);
-        channel_status[4] = DMA_STATUS_COMPLETE;
-        if (transfer_complete_callbacks[4] != NULL) {
-            transfer_complete_callbacks[4](DMA_CH5);
+        if (!dma_chain_next(4)) {
+            channel_status[4] = DMA_STATUS_COMPLETE;
+            dma_transfer_complete(4);
         }
     }
     
     if (DMA_GetITStatus(DMA1_IT_TE5) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TE5);
         channel_status[4] = DMA_STATUS_ERROR;
+        dma_chain_cancel(4);
         if (error_callbacks[4] != NULL) {
             error_callbacks[4](DMA_CH5);
         }
     }
+    ISR_STAT_EXIT(ISR_STAT_DMA_CH5);
 }
+#endif
 
+#if SIMPLE_DMA_CHANNEL_MASK & 0x20
 /**
  * @brief DMA Channel 6 interrupt handler
  */
 void DMA1_Channel6_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
 void DMA1_Channel6_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_DMA_CH6);
+    if (DMA_GetITStatus(DMA1_IT_HT6) != RESET) {
+        DMA_ClearITPendingBit(DMA1_IT_HT6);
+        if (half_transfer_callbacks[5] != NULL) {
+            half_transfer_callbacks[5](DMA_CH6);
+        }
+    }
+    
     if (DMA_GetITStatus(DMA1_IT_TC6) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TC6);
-        channel_status[5] = DMA_STATUS_COMPLETE;
-        if (transfer_complete_callbacks[5] != NULL) {
-            transfer_complete_callbacks[5](DMA_CH6);
+        if (!dma_chain_next(5)) {
+            channel_status[5] = DMA_STATUS_COMPLETE;
+            dma_transfer_complete(5);
         }
     }
     
     if (DMA_GetITStatus(DMA1_IT_TE6) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TE6);
         channel_status[5] = DMA_STATUS_ERROR;
+        dma_chain_cancel(5);
         if (error_callbacks[5] != NULL) {
             error_callbacks[5](DMA_CH6);
         }
     }
+    ISR_STAT_EXIT(ISR_STAT_DMA_CH6);
 }
+#endif
 
+#if SIMPLE_DMA_CHANNEL_MASK & 0x40
 /**
  * @brief DMA Channel 7 interrupt handler
  */
 void DMA1_Channel7_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
 void DMA1_Channel7_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_DMA_CH7);
+    if (DMA_GetITStatus(DMA1_IT_HT7) != RESET) {
+        DMA_ClearITPendingBit(DMA1_IT_HT7);
+        if (half_transfer_callbacks[6] != NULL) {
+            half_transfer_callbacks[6](DMA_CH7);
+        }
+    }
+    
     if (DMA_GetITStatus(DMA1_IT_TC7) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TC7);
-        channel_status[6] = DMA_STATUS_COMPLETE;
-        if (transfer_complete_callbacks[6] != NULL) {
-            transfer_complete_callbacks[6](DMA_CH7);
+        if (!dma_chain_next(6)) {
+            channel_status[6] = DMA_STATUS_COMPLETE;
+            dma_transfer_complete(6);
         }
     }
     
     if (DMA_GetITStatus(DMA1_IT_TE7) != RESET) {
         DMA_ClearITPendingBit(DMA1_IT_TE7);
         channel_status[6] = DMA_STATUS_ERROR;
+        dma_chain_cancel(6);
         if (error_callbacks[6] != NULL) {
             error_callbacks[6](DMA_CH7);
         }
     }
+    ISR_STAT_EXIT(ISR_STAT_DMA_CH7);
 }
+#endif
@@ -1,8 +1,8 @@
 /**
  * @file SimpleDMA.h
  * @brief Simple DMA Library สำหรับ CH32V003 แบบ Arduino-style
- * @version 1.0
- * @date 2025-12-22
+ * @version 1.9
+ * @date 2026-10-14
  * 
  * @details
  * Library นี้ห่อหุ้ม Hardware DMA ให้ใช้งานง่ายแบบ Arduino
@@ -14,6 +14,11 @@
  * - Circular buffer mode
  * - Priority management
  * - Callback functions สำหรับ Transfer Complete และ Error
+ * - Scatter-gather: ต่อหลาย segments บน channel เดียว callback ครั้งเดียวตอนจบ
+ * - Channel allocator ตาม request mapping ของ CH32V003 (กันสอง module ใช้ channel ซ้ำ)
+ * - DMA_MemCopy/DMA_MemSet เลือก width 32/16-bit ตาม alignment อัตโนมัติ
+ * - รอ transfer แบบ sleep (WFI) ได้ทีละหลาย channels
+ * - Ping-pong stream (half/full buffer) สำหรับ ADC, USART RX, SPI RX พร้อม overrun detection
  * - Integration กับ SimpleADC, SimpleUSART, SimpleSPI
  * 
  * **DMA Channels ของ CH32V003:**
@@ -46,6 +51,18 @@ extern "C" {
 
 #include <ch32v00x.h>
 #include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief ขนาดต่ำสุด (bytes) ที่ DMA_MemCopy()/DMA_MemSet() ใช้ DMA
+ *
+ * @details สั้นกว่านี้ copy ด้วย CPU loop เพราะการตั้งค่า channel ใช้เวลามากกว่า
+ */
+#ifndef SIMPLE_DMA_MEM_MIN_BYTES
+#define SIMPLE_DMA_MEM_MIN_BYTES 16
+#endif
 
 /* ========== Enumerations ========== */
 
@@ -56,6 +73,7 @@ extern "C" {
  * @note Channel number ต่ำกว่ามี priority สูงกว่า (ถ้าตั้ง priority เท่ากัน)
  */
 typedef enum {
+    DMA_CH_NONE = 0,  /**< ไม่มี channel (DMA_AllocChannel() ไม่สำเร็จ) */
     DMA_CH1 = 1,  /**< DMA Channel 1 */
     DMA_CH2 = 2,  /**< DMA Channel 2 */
     DMA_CH3 = 3,  /**< DMA Channel 3 */
@@ -123,6 +141,40 @@ typedef enum {
     DMA_PERIPH_TIM2    = 5   /**< Timer 2 */
 } DMA_Peripheral;
 
+/**
+ * @brief DMA request source สำหรับ DMA_AllocChannel()
+ *
+ * @details Request ของ peripheral ต่อกับ channel ตายตัว (ระบุใน comment)
+ * ส่วน DMA_REQ_MEM (memory-to-memory) ใช้ channel ว่างใดก็ได้
+ */
+typedef enum {
+    DMA_REQ_MEM = 0,        /**< Memory-to-memory (channel ว่างใดก็ได้) */
+    DMA_REQ_ADC1,           /**< CH1 */
+    DMA_REQ_SPI1_RX,        /**< CH2 */
+    DMA_REQ_SPI1_TX,        /**< CH3 */
+    DMA_REQ_USART1_TX,      /**< CH4 */
+    DMA_REQ_USART1_RX,      /**< CH5 */
+    DMA_REQ_I2C1_TX,        /**< CH6 */
+    DMA_REQ_I2C1_RX,        /**< CH7 */
+    DMA_REQ_TIM1_CH1,       /**< CH2 */
+    DMA_REQ_TIM1_CH2,       /**< CH3 */
+    DMA_REQ_TIM1_CH3,       /**< CH6 */
+    DMA_REQ_TIM1_CH4,       /**< CH4 (รวม TIM1_TRIG, TIM1_COM) */
+    DMA_REQ_TIM1_UP,        /**< CH5 */
+    DMA_REQ_TIM2_CH1,       /**< CH5 */
+    DMA_REQ_TIM2_CH2,       /**< CH7 */
+    DMA_REQ_TIM2_CH3,       /**< CH1 */
+    DMA_REQ_TIM2_CH4,       /**< CH7 */
+    DMA_REQ_TIM2_UP         /**< CH2 */
+} DMA_Request;
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief Bit ของ channel สำหรับ DMA_WaitAllSleep()
+ */
+#define DMA_CHANNEL_MASK(ch)  ((uint8_t)(1u << ((ch) - 1)))
+
 /* ========== Type Definitions ========== */
 
 /**
@@ -137,6 +189,12 @@ typedef void (*DMA_TransferCompleteCallback)(DMA_Channel channel);
  */
 typedef void (*DMA_ErrorCallback)(DMA_Channel channel);
 
+/**
+ * @brief Callback function type สำหรับ Half Transfer (ครึ่ง buffer)
+ * @param channel DMA channel ที่ถ่ายโอนครบครึ่ง buffer
+ */
+typedef void (*DMA_HalfTransferCallback)(DMA_Channel channel);
+
 /**
  * @brief DMA Configuration Structure
  */
@@ -153,6 +211,49 @@ typedef struct {
     uint16_t buffer_size;          /**< จำนวนข้อมูลที่ต้องการถ่ายโอน */
 } DMA_Config_t;
 
+/**
+ * @brief Segment หนึ่งช่วงของ scatter-gather chain
+ *
+ * @details src/dst เป็น address ตามทิศทางที่ channel ตั้งไว้
+ * (memory → peripheral: src = memory, dst = peripheral register)
+ */
+typedef struct {
+    uint32_t src;                  /**< Source address */
+    uint32_t dst;                  /**< Destination address */
+    uint16_t length;               /**< จำนวนข้อมูล (หน่วยตาม width, ต้องมากกว่า 0) */
+    uint8_t width;                 /**< ขนาดข้อมูล (DMA_DataSize) ใช้ทั้ง source และ destination */
+} DMA_Segment_t;
+
+/**
+ * @brief Callback ของ ping-pong stream (เรียกทุกครึ่ง buffer)
+ * @param data ครึ่ง buffer ที่ DMA เขียนเสร็จ
+ * @param length จำนวน elements ในครึ่งนั้น
+ */
+typedef void (*DMA_StreamCallback)(void* data, uint16_t length);
+
+/**
+ * @brief สถิติของ ping-pong stream
+ */
+typedef struct {
+    uint32_t blocks;               /**< จำนวนครึ่ง buffer ที่ส่งมอบ */
+    uint32_t overruns;             /**< จำนวนครั้งที่ผู้ใช้ประมวลผลไม่ทัน */
+} DMA_StreamStats_t;
+
+/**
+ * @brief Ping-pong stream object (ผู้ใช้จองไว้ ห้ามแก้ field เอง)
+ */
+typedef struct {
+    uint8_t* buffer;               /**< buffer ทั้งหมด (สองครึ่ง) */
+    uint16_t half_length;          /**< จำนวน elements ต่อครึ่ง */
+    uint8_t element_size;          /**< bytes ต่อ element (ตาม MSIZE ของ channel) */
+    DMA_Channel channel;           /**< DMA channel */
+    DMA_StreamCallback callback;   /**< NULL = poll mode */
+    volatile uint8_t ready;        /**< ครึ่งที่รอหยิบ (poll mode): 0 = ไม่มี, 1 = แรก, 2 = หลัง */
+    volatile uint8_t held;         /**< ครึ่งที่ผู้ใช้ถืออยู่ (poll mode) */
+    volatile uint8_t overrun;      /**< ประมวลผลไม่ทัน (ค้างไว้จน DMA_StreamOverrun()) */
+    volatile DMA_StreamStats_t stats;  /**< สถิติ */
+} DMA_Stream_t;
+
 /* ========== Function Prototypes ========== */
 
 /* ----- Basic DMA Functions ----- */
@@ -227,6 +328,38 @@ DMA_Status DMA_GetStatus(DMA_Channel channel);
  */
 uint8_t DMA_WaitComplete(DMA_Channel channel, uint32_t timeout_ms);
 
+/**
+ * @brief รอให้การถ่ายโอนเสร็จสิ้นแบบ sleep (WFI) แทน busy-poll
+ * @param channel DMA channel ที่ต้องการรอ
+ * @param timeout_ms timeout ในหน่วย milliseconds (0 = รอไม่จำกัด)
+ * @return 1 = เสร็จสิ้น, 0 = timeout หรือ error
+ *
+ * @details เปิด TC/TE interrupt ของ channel ชั่วคราวแล้วเข้า sleep ด้วย
+ * PWR_EnterSleepMode(PWR_ENTRY_WFI) CPU ตื่นเมื่อ DMA เสร็จหรือมี interrupt อื่น
+ * DMA ยังทำงานระหว่าง sleep จึงเหมาะกับ transfer ยาว เช่นส่งภาพขึ้นจอผ่าน SPI
+ *
+ * @note Timeout ใช้ millis (ตื่นทุก 1 ms จาก SysTick)
+ * @note ห้ามเรียกจาก interrupt
+ *
+ * @example
+ * DMA_SPI_TransferBuffer(DMA_CH3, DMA_CH2, frame, NULL, 4096);
+ * DMA_WaitCompleteSleep(DMA_CH3, 100);
+ */
+uint8_t DMA_WaitCompleteSleep(DMA_Channel channel, uint32_t timeout_ms);
+
+/**
+ * @brief รอหลาย channels แบบ sleep จนเสร็จทั้งหมด
+ * @param channel_mask รวม DMA_CHANNEL_MASK() ของ channels ที่ต้องการรอ
+ * @param timeout_ms timeout ในหน่วย milliseconds (0 = รอไม่จำกัด)
+ * @return 1 = เสร็จทุก channel, 0 = timeout หรือมี channel error
+ *
+ * @note Channel นอก SIMPLE_DMA_CHANNEL_MASK ไม่มี handler ปลุก CPU: ถ้ามีใน mask จะ poll แทน sleep
+ *
+ * @example
+ * DMA_WaitAllSleep(DMA_CHANNEL_MASK(DMA_CH2) | DMA_CHANNEL_MASK(DMA_CH3), 50);
+ */
+uint8_t DMA_WaitAllSleep(uint8_t channel_mask, uint32_t timeout_ms);
+
 /**
  * @brief ตั้งค่า callback function สำหรับ Transfer Complete
  * @param channel DMA channel
@@ -241,6 +374,22 @@ uint8_t DMA_WaitComplete(DMA_Channel channel, uint32_t timeout_ms);
  */
 void DMA_SetTransferCompleteCallback(DMA_Channel channel, DMA_TransferCompleteCallback callback);
 
+/**
+ * @brief ตั้ง callback ของ Transfer Complete ที่ทำใน main loop แทน ISR
+ * @param channel DMA channel
+ * @param callback เรียกจาก Event_Dispatch() (ISR แค่ post event ลง EVENT_RING_HIGH)
+ *
+ * @note ต้องเรียก Event_Dispatch() ใน main loop (SimpleEvent.h)
+ * @note DMA_SetTransferCompleteCallback() กลับไปเรียกใน ISR ตามเดิม
+ *
+ * @example
+ * DMA_SetTransferCompleteDeferred(DMA_CH1, on_complete);
+ * while (1) {
+ *     Event_Dispatch();
+ * }
+ */
+void DMA_SetTransferCompleteDeferred(DMA_Channel channel, DMA_TransferCompleteCallback callback);
+
 /**
  * @brief ตั้งค่า callback function สำหรับ Error
  * @param channel DMA channel
@@ -255,6 +404,19 @@ void DMA_SetTransferCompleteCallback(DMA_Channel channel, DMA_TransferCompleteCa
  */
 void DMA_SetErrorCallback(DMA_Channel channel, DMA_ErrorCallback callback);
 
+/**
+ * @brief ตั้งค่า callback function สำหรับ Half Transfer
+ * @param channel DMA channel
+ * @param callback pointer ไปยัง callback function (NULL = ปิด HT interrupt)
+ * 
+ * @note ใช้คู่กับ circular mode: ประมวลผลครึ่งแรกขณะ DMA เขียนครึ่งหลัง
+ * 
+ * @example
+ * DMA_SetHalfTransferCallback(DMA_CH1, on_first_half);
+ * DMA_SetTransferCompleteCallback(DMA_CH1, on_second_half);
+ */
+void DMA_SetHalfTransferCallback(DMA_Channel channel, DMA_HalfTransferCallback callback);
+
 /**
  * @brief รีเซ็ต DMA channel
  * @param channel DMA channel ที่ต้องการรีเซ็ต
@@ -275,6 +437,44 @@ void DMA_Reset(DMA_Channel channel);
  */
 uint16_t DMA_GetRemainingCount(DMA_Channel channel);
 
+/* ----- Channel Allocation Functions ----- */
+
+/**
+ * @brief จอง DMA channel สำหรับ request source
+ * @param request request source (peripheral ได้ channel ตายตัว, DMA_REQ_MEM ได้ channel ว่าง)
+ * @return channel ที่จองได้ หรือ DMA_CH_NONE ถ้า channel ถูกจองแล้ว
+ *
+ * @details DMA_REQ_MEM ค้นจาก CH7 ลงไป CH1 และข้าม channel ที่เปิดใช้อยู่, เปิด interrupt
+ * หรือมี callback ค้าง (เช่นถูกตั้งค่าตรงโดยไม่ผ่าน allocator) เพื่อเหลือ channel ต้น ๆ ให้ ADC/SPI
+ *
+ * @note เรียกจาก interrupt ได้ (ปิด interrupt ระหว่างจอง)
+ * @note ADC streaming, DMA_analogReadStart(), DMA_MemCopy()/DMA_MemSet(), DMA_SPI_Init(),
+ *       USART TX/frame RX, I2C DMA, shiftOut ผ่าน SPI และ 1-Wire แบบ USART จองผ่านฟังก์ชันนี้เอง
+ *
+ * @example
+ * DMA_Channel ch = DMA_AllocChannel(DMA_REQ_MEM);
+ * if (ch != DMA_CH_NONE) {
+ *     DMA_MemCopyAsync(ch, dst, src, 100);
+ *     while (DMA_GetStatus(ch) == DMA_STATUS_BUSY);
+ *     DMA_FreeChannel(ch);
+ * }
+ */
+DMA_Channel DMA_AllocChannel(DMA_Request request);
+
+/**
+ * @brief คืน channel ที่จองไว้
+ * @param channel channel จาก DMA_AllocChannel()
+ *
+ * @note หยุด channel, ปิด interrupts และล้าง callbacks ของ channel
+ */
+void DMA_FreeChannel(DMA_Channel channel);
+
+/**
+ * @brief ตรวจสอบว่า channel ถูกจองอยู่หรือไม่
+ * @return 1 = ถูกจอง, 0 = ว่าง
+ */
+uint8_t DMA_IsChannelAllocated(DMA_Channel channel);
+
 /* ----- Memory Transfer Functions ----- */
 
 /**
@@ -284,6 +484,9 @@ uint16_t DMA_GetRemainingCount(DMA_Channel channel);
  * @param size จำนวน bytes ที่ต้องการ copy
  * 
  * @note ฟังก์ชันนี้จะรอจนกว่าการ copy จะเสร็จสิ้น
+ * @note จอง channel ว่างชั่วคราว ถ้าไม่มี channel ว่างจะ copy ด้วย CPU แทน
+ * @note ถ้า src และ dst เหลื่อมกันลงตัว 4 (หรือ 2) bytes จะ copy ทีละ word (halfword)
+ *       ส่วนหัว/ท้ายที่ไม่ align copy ด้วย CPU; สั้นกว่า SIMPLE_DMA_MEM_MIN_BYTES ใช้ CPU ทั้งหมด
  * 
  * @example
  * uint8_t src[100], dst[100];
@@ -299,11 +502,15 @@ void DMA_MemCopy(void* dst, const void* src, uint16_t size);
  * @param size จำนวน bytes ที่ต้องการ copy
  * 
  * @note ฟังก์ชันนี้จะ return ทันที ใช้ DMA_GetStatus() เพื่อตรวจสอบสถานะ
+ * @note ใช้ channel จาก DMA_AllocChannel(DMA_REQ_MEM) เพื่อไม่ชนกับ peripheral อื่น
+ * @note เลือก width แบบเดียวกับ DMA_MemCopy() ส่วนหัว/ท้าย (ไม่เกิน 3 bytes) copy ทันทีก่อน return
  * 
  * @example
- * DMA_MemCopyAsync(DMA_CH1, dst, src, 100);
+ * DMA_Channel ch = DMA_AllocChannel(DMA_REQ_MEM);
+ * DMA_MemCopyAsync(ch, dst, src, 100);
  * // ทำงานอื่นได้
- * while (DMA_GetStatus(DMA_CH1) != DMA_STATUS_COMPLETE);
+ * while (DMA_GetStatus(ch) != DMA_STATUS_COMPLETE);
+ * DMA_FreeChannel(ch);
  */
 void DMA_MemCopyAsync(DMA_Channel channel, void* dst, const void* src, uint16_t size);
 
@@ -313,12 +520,136 @@ void DMA_MemCopyAsync(DMA_Channel channel, void* dst, const void* src, uint16_t
  * @param value ค่าที่ต้องการ set
  * @param size จำนวน bytes
  * 
+ * @note จอง channel ว่างชั่วคราว ถ้าไม่มี channel ว่างจะใช้ memset() แทน
+ * @note เขียนทีละ word ตาม alignment ของ dst (เช่นล้าง framebuffer)
+ *
  * @example
  * uint8_t buffer[100];
  * DMA_MemSet(buffer, 0, 100);  // Clear buffer
  */
 void DMA_MemSet(void* dst, uint8_t value, uint16_t size);
 
+#if SIMPLE_DMA_CHAIN
+/* ----- Scatter-Gather Functions ----- */
+
+/**
+ * @brief เริ่มถ่ายโอนหลาย segments ต่อกันบน channel เดียว
+ * @param channel DMA channel ที่ตั้งค่าไว้แล้ว (DMA_SimpleInit(), DMA_USART_InitTx() ฯลฯ)
+ * @param segments array ของ segments (ต้องอยู่จนจบ chain ห้ามเป็น local ที่หมดอายุ)
+ * @param count จำนวน segments
+ * @param callback เรียกครั้งเดียวเมื่อ segment สุดท้ายเสร็จ (NULL = ไม่ใช้)
+ * @return 1 = เริ่มแล้ว, 0 = channel ไม่ว่างหรือ segment ไม่ถูกต้อง
+ *
+ * @details TC interrupt โหลด address/length/width ของ segment ถัดไปแล้วเปิด channel ต่อ
+ * ไม่ต้อง copy ข้อมูลหลายส่วนรวมเป็น buffer เดียวก่อนส่ง
+ * ทิศทาง, increment และ priority ใช้ตามที่ channel ตั้งค่าไว้ (circular mode ถูกปิด)
+ *
+ * @note ระหว่าง segments peripheral เห็นช่องว่างสั้น ๆ เท่าเวลาเข้า interrupt
+ * @note DMA_GetStatus() คืน BUSY จนจบทั้ง chain
+ * @note ระหว่าง chain, callback ของ DMA_SetTransferCompleteCallback() ไม่ถูกเรียก
+ *
+ * @example
+ * // ส่ง header + payload + CRC ทาง USART โดยไม่ copy
+ * static DMA_Segment_t frame[3];
+ * frame[0] = (DMA_Segment_t){(uint32_t)&header, (uint32_t)&USART1->DATAR, sizeof(header), DMA_SIZE_BYTE};
+ * frame[1] = (DMA_Segment_t){(uint32_t)payload, (uint32_t)&USART1->DATAR, len, DMA_SIZE_BYTE};
+ * frame[2] = (DMA_Segment_t){(uint32_t)&crc, (uint32_t)&USART1->DATAR, 2, DMA_SIZE_BYTE};
+ * DMA_ChainStart(DMA_CH4, frame, 3, on_frame_sent);
+ */
+uint8_t DMA_ChainStart(DMA_Channel channel, const DMA_Segment_t* segments, uint8_t count,
+                       DMA_TransferCompleteCallback callback);
+
+/**
+ * @brief ตรวจสอบว่า chain ยังทำงานอยู่หรือไม่
+ * @return 1 = ยังมี segment ที่ยังไม่เสร็จ
+ */
+uint8_t DMA_ChainBusy(DMA_Channel channel);
+
+/**
+ * @brief ยกเลิก chain (ปิด channel ไม่เรียก callback)
+ */
+void DMA_ChainAbort(DMA_Channel channel);
+#endif  // SIMPLE_DMA_CHAIN
+
+/* ----- Ping-Pong Stream Functions ----- */
+
+/**
+ * @brief เริ่ม ping-pong stream บน channel ที่ตั้งค่า peripheral ไว้แล้ว
+ * @param stream stream object (ต้องอยู่ตลอดการทำงาน เช่น static)
+ * @param channel DMA channel ที่ตั้งค่าแล้ว (DMA_ADC_Init(), DMA_USART_InitRx(), DMA_SPI_Init())
+ * @param buffer buffer ทั้งหมด (สองครึ่ง) ขนาดตาม data size ของ channel
+ * @param length จำนวน elements ทั้งหมด (ปัดลงเป็นเลขคู่)
+ * @param callback เรียกจาก interrupt ทุกครึ่ง (NULL = poll ด้วย DMA_StreamGet())
+ * @return 1 = เริ่มแล้ว, 0 = parameter ผิด
+ *
+ * @details ตั้ง circular mode และเปิด HT/TC interrupt: เมื่อ DMA เขียนครึ่งแรกเสร็จจะส่งมอบ
+ * ครึ่งแรกขณะ DMA เขียนครึ่งหลัง และสลับกันไปเรื่อย ๆ
+ *
+ * **Overrun:**
+ * - Callback mode: callback ต้อง return ก่อน DMA เขียนครบอีกครึ่ง (ตรวจจาก CNTR หลัง callback)
+ * - Poll mode: ครึ่งที่ยังไม่หยิบถูกแทนที่ หรือ DMA วนกลับมาเขียนครึ่งที่ยังไม่ DMA_StreamRelease()
+ *
+ * @note ใช้ HT/TC callbacks ของ channel (แทนที่ callback ที่ตั้งไว้เดิม)
+ * @note ADC/USART/SPI ต้องเริ่มส่ง DMA request เอง (เช่น ADC_SoftwareStartConvCmd())
+ *
+ * @example
+ * // USART RX ต่อเนื่อง ประมวลผลทีละ 32 bytes
+ * static uint8_t rx[64];
+ * static DMA_Stream_t rx_stream;
+ * void on_rx(void* data, uint16_t len) { parse((uint8_t*)data, len); }
+ *
+ * DMA_USART_InitRx(DMA_CH5, rx, 64, 1);
+ * DMA_StreamStart(&rx_stream, DMA_CH5, rx, 64, on_rx);
+ *
+ * @example
+ * // ADC แบบ poll ใน main loop
+ * static uint16_t samples[128];
+ * static DMA_Stream_t adc_stream;
+ * DMA_ADC_Init(DMA_CH1, samples, 128, 1);
+ * DMA_StreamStart(&adc_stream, DMA_CH1, samples, 128, NULL);
+ * ADC_SoftwareStartConvCmd(ADC1, ENABLE);
+ *
+ * uint16_t n;
+ * uint16_t* half = DMA_StreamGet(&adc_stream, &n);
+ * if (half) { process(half, n); DMA_StreamRelease(&adc_stream); }
+ */
+uint8_t DMA_StreamStart(DMA_Stream_t* stream, DMA_Channel channel, void* buffer,
+                        uint16_t length, DMA_StreamCallback callback);
+
+/**
+ * @brief หยุด stream (ปิด channel และถอด callbacks)
+ */
+void DMA_StreamStop(DMA_Stream_t* stream);
+
+/**
+ * @brief หยิบครึ่ง buffer ที่พร้อม (poll mode)
+ * @param stream stream object
+ * @param length [out] จำนวน elements (NULL = ไม่ต้องการ)
+ * @return pointer ของครึ่งที่พร้อม หรือ NULL ถ้ายังไม่มี
+ *
+ * @note เรียก DMA_StreamRelease() เมื่อประมวลผลเสร็จ
+ */
+void* DMA_StreamGet(DMA_Stream_t* stream, uint16_t* length);
+
+/**
+ * @brief คืนครึ่ง buffer หลังประมวลผลเสร็จ (poll mode)
+ */
+void DMA_StreamRelease(DMA_Stream_t* stream);
+
+/**
+ * @brief อ่านและล้าง overrun flag
+ * @return 1 = มี overrun ตั้งแต่อ่านครั้งก่อน
+ */
+uint8_t DMA_StreamOverrun(DMA_Stream_t* stream);
+
+/**
+ * @brief อ่านสถิติของ stream
+ * @param stream stream object
+ * @param stats [out] สถิติ
+ * @param reset 1 = ล้างตัวนับหลังอ่าน
+ */
+void DMA_StreamGetStats(DMA_Stream_t* stream, DMA_StreamStats_t* stats, uint8_t reset);
+
 /* ----- ADC Integration Functions ----- */
 
 /**
@@ -361,10 +692,11 @@ void DMA_ADC_InitMultiChannel(DMA_Channel channel, uint16_t* buffer, uint8_t num
  * @param buffer_size ขนาดของ buffer
  * 
  * @note ต้องเรียก USART_SimpleInit() ก่อนใช้ฟังก์ชันนี้
+ * @note USART1_TX ต่อกับ DMA CH4 เท่านั้น (SimpleUSART ใช้ CH4 เป็น TX FIFO อยู่แล้ว)
  * 
  * @example
  * uint8_t tx_buffer[256];
- * DMA_USART_InitTx(DMA_CH2, tx_buffer, 256);
+ * DMA_USART_InitTx(DMA_CH4, tx_buffer, 256);
  */
 void DMA_USART_InitTx(DMA_Channel channel, uint8_t* buffer, uint16_t buffer_size);
 
@@ -379,7 +711,7 @@ void DMA_USART_InitTx(DMA_Channel channel, uint8_t* buffer, uint16_t buffer_size
  * 
  * @example
  * uint8_t rx_buffer[256];
- * DMA_USART_InitRx(DMA_CH3, rx_buffer, 256, 1);  // Circular mode
+ * DMA_USART_InitRx(DMA_CH5, rx_buffer, 256, 1);  // Circular mode (USART1_RX = CH5)
  */
 void DMA_USART_InitRx(DMA_Channel channel, uint8_t* buffer, uint16_t buffer_size, uint8_t circular);
 
@@ -389,9 +721,11 @@ void DMA_USART_InitRx(DMA_Channel channel, uint8_t* buffer, uint16_t buffer_size
  * @param data pointer ไปยังข้อมูลที่ต้องการส่ง
  * @param length จำนวน bytes
  * 
+ * @note ใช้ได้จาก DMA transfer-complete callback เพื่อส่ง chunk ถัดไปต่อทันที
+ * 
  * @example
  * char msg[] = "Hello World!";
- * DMA_USART_Transmit(DMA_CH2, (uint8_t*)msg, strlen(msg));
+ * DMA_USART_Transmit(DMA_CH4, (uint8_t*)msg, strlen(msg));
  */
 void DMA_USART_Transmit(DMA_Channel channel, const uint8_t* data, uint16_t length);
 
@@ -402,7 +736,7 @@ void DMA_USART_Transmit(DMA_Channel channel, const uint8_t* data, uint16_t lengt
  * @return จำนวน bytes ที่รับได้
  * 
  * @example
- * uint16_t received = DMA_USART_GetReceivedCount(DMA_CH3, 256);
+ * uint16_t received = DMA_USART_GetReceivedCount(DMA_CH5, 256);
  */
 uint16_t DMA_USART_GetReceivedCount(DMA_Channel channel, uint16_t buffer_size);
 
@@ -410,15 +744,24 @@ uint16_t DMA_USART_GetReceivedCount(DMA_Channel channel, uint16_t buffer_size);
 
 /**
  * @brief เริ่มต้น DMA สำหรับ SPI transmission
- * @param tx_channel DMA channel สำหรับ TX
- * @param rx_channel DMA channel สำหรับ RX
+ * @param tx_channel DMA channel สำหรับ TX (DMA_CH3)
+ * @param rx_channel DMA channel สำหรับ RX (DMA_CH2)
+ * @return 1 = สำเร็จ, 0 = channel ถูก module อื่นจองอยู่ หรือไม่ใช่ channel ของ SPI1
  * 
  * @note ต้องเรียก SPI_SimpleInit() ก่อนใช้ฟังก์ชันนี้
+ * @note จองทั้งสอง channel ผ่าน DMA_AllocChannel() จนถึง DMA_SPI_End() (เรียกซ้ำได้)
  * 
  * @example
- * DMA_SPI_Init(DMA_CH4, DMA_CH5);
+ * DMA_SPI_Init(DMA_CH3, DMA_CH2);  // SPI1: TX=CH3, RX=CH2
+ */
+uint8_t DMA_SPI_Init(DMA_Channel tx_channel, DMA_Channel rx_channel);
+
+/**
+ * @brief ปิด SPI DMA requests และคืน channel ที่ DMA_SPI_Init() จองไว้
+ * @param tx_channel DMA channel สำหรับ TX (DMA_CH_NONE = ข้าม)
+ * @param rx_channel DMA channel สำหรับ RX (DMA_CH_NONE = ข้าม)
  */
-void DMA_SPI_Init(DMA_Channel tx_channel, DMA_Channel rx_channel);
+void DMA_SPI_End(DMA_Channel tx_channel, DMA_Channel rx_channel);
 
 /**
  * @brief ส่งและรับข้อมูลผ่าน SPI ด้วย DMA
@@ -430,11 +773,40 @@ void DMA_SPI_Init(DMA_Channel tx_channel, DMA_Channel rx_channel);
  * 
  * @example
  * uint8_t tx[10], rx[10];
- * DMA_SPI_TransferBuffer(DMA_CH4, DMA_CH5, tx, rx, 10);
+ * DMA_SPI_TransferBuffer(DMA_CH3, DMA_CH2, tx, rx, 10);
+ * 
+ * @note ใน SPI_DATA_16BIT mode length คือจำนวน frame และ buffer เป็น uint16_t
+ * @note รอจนเสร็จด้วย DMA_WaitAllSleep() (CPU sleep ระหว่าง transfer) ห้ามเรียกจาก interrupt
  */
 void DMA_SPI_TransferBuffer(DMA_Channel tx_channel, DMA_Channel rx_channel, 
                            const uint8_t* tx_data, uint8_t* rx_data, uint16_t length);
 
+/**
+ * @brief ส่งค่าเดียวซ้ำผ่าน SPI ด้วย DMA ครั้งเดียว (memory address ไม่เพิ่ม)
+ * @param tx_channel DMA channel สำหรับ TX (CH3)
+ * @param value ค่าที่ส่ง (8-bit mode ใช้เฉพาะ byte ต่ำ)
+ * @param count จำนวน frame (สูงสุด 65535)
+ * 
+ * @note ไม่รอ: ตรวจด้วย DMA_SPI_TxDone() ก่อนยกเลิก CS
+ * @note ขนาด frame ตาม SPI_SetDataSize() เช่นเติมสีทั้งจอ 128x160 = 20480 frames
+ * 
+ * @example
+ * SPI_SetDataSize(SPI_DATA_16BIT);
+ * DMA_SPI_Fill(DMA_CH3, 0xF800, 128 * 160);  // สีแดง RGB565
+ * while (!DMA_SPI_TxDone(DMA_CH3));
+ * SPI_SetCS(1);
+ */
+void DMA_SPI_Fill(DMA_Channel tx_channel, uint16_t value, uint16_t count);
+
+/**
+ * @brief ตรวจสอบว่า SPI TX DMA ส่งครบและ byte สุดท้ายออกจากสายแล้ว
+ * @param tx_channel DMA channel สำหรับ TX
+ * @return 1 = เสร็จ (ยกเลิก CS ได้), 0 = ยังส่งอยู่
+ * 
+ * @note ล้าง RXNE/OVR ที่ค้างจากการส่งแบบไม่อ่าน RX
+ */
+uint8_t DMA_SPI_TxDone(DMA_Channel tx_channel);
+
 /* ----- Simplified analogRead DMA Functions ----- */
 
 /**
@@ -449,6 +821,10 @@ void DMA_SPI_TransferBuffer(DMA_Channel tx_channel, DMA_Channel rx_channel,
  *       2. ตั้งค่า DMA สำหรับ ADC
  *       3. เริ่ม ADC continuous conversion
  * 
+ * @note Calibration ทำครั้งเดียว (cache ใน SimpleADC) ถ้าเรียกซ้ำขณะทำงานอยู่
+ *       จะ re-arm แค่ channel และ DMA pointer (ทิ้ง conversion ค้างไม่เกิน 1 ค่า)
+ * @note จอง CH1 ผ่าน DMA_AllocChannel(DMA_REQ_ADC1) ไม่เริ่มถ้า ADC_StartSampling() ถืออยู่
+ * 
  * @example
  * // อ่านค่า ADC จาก PD2 แบบต่อเนื่อง 100 ตัวอย่าง
  * uint16_t adc_buffer[100];
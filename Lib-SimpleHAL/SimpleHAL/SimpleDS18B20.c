@@ -0,0 +1,285 @@
+/**
+ * @file SimpleDS18B20.c
+ * @brief Multi-bus DS18B20 Conversion Scheduler Implementation
+ * @version 1.0
+ * @date 2026-10-15
+ */
+
+#include "SimpleDS18B20.h"
+#include "SimpleDelay.h"
+#include <string.h>
+
+/* ========== Private Definitions ========== */
+
+#define DS18B20_SCRATCHPAD_SIZE  9
+#define DS18B20_CONFIG_RESERVED  0x1F  // bits 0-4 ของ config อ่านได้ 1 เสมอ
+#define DS18B20_NO_BUS           0xFF
+
+/* ========== Private Variables ========== */
+
+static DS18B20_Sensor ds18b20_sensors[SIMPLE_DS18B20_MAX_SENSORS];
+static uint8_t ds18b20_bus_of[SIMPLE_DS18B20_MAX_SENSORS];  // index ใน ds18b20_buses
+static uint8_t ds18b20_count = 0;
+
+static OneWire_Bus* ds18b20_buses[ONEWIRE_MAX_BUSES];       // buses ที่มี sensor
+static uint32_t ds18b20_bus_start[ONEWIRE_MAX_BUSES];       // เวลาที่สั่ง Convert T (ms)
+static uint8_t ds18b20_bus_count = 0;
+
+static uint8_t ds18b20_remaining = 0;   // sensors ที่ยังไม่ได้อ่านใน sweep นี้
+static uint8_t ds18b20_next = 0;        // จุดเริ่มหาใน Process() ครั้งถัดไป (round-robin)
+static bool ds18b20_busy = false;
+
+const uint16_t ds18b20_ram_bytes = sizeof(ds18b20_sensors) + sizeof(ds18b20_bus_of) +
+                                   sizeof(ds18b20_count) + sizeof(ds18b20_buses) +
+                                   sizeof(ds18b20_bus_start) + sizeof(ds18b20_bus_count) +
+                                   sizeof(ds18b20_remaining) + sizeof(ds18b20_next) +
+                                   sizeof(ds18b20_busy);
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief Reset แล้วเลือก sensor (Match ROM หรือ Skip ROM)
+ */
+static bool DS18B20_Address(const DS18B20_Sensor* s) {
+    if (s->skip_rom) {
+        if (!OneWire_Reset(s->bus)) return false;
+        OneWire_SkipROM(s->bus);
+        return true;
+    }
+    return OneWire_Select(s->bus, s->rom);
+}
+
+/**
+ * @brief อ่าน scratchpad 9 bytes และตรวจ CRC
+ * @note Bus ที่ค้าง low อ่านได้ 0 ทั้งหมดซึ่ง CRC ผ่าน จึงตรวจ reserved bits ของ config ด้วย
+ */
+static bool DS18B20_ReadScratchpad(const DS18B20_Sensor* s, uint8_t* buf) {
+    if (!DS18B20_Address(s)) return false;
+
+    OneWire_WriteByte(s->bus, DS18B20_CMD_READ_SCRATCHPAD);
+    OneWire_ReadBytes(s->bus, buf, DS18B20_SCRATCHPAD_SIZE);
+
+    return OneWire_VerifyCRC(buf, DS18B20_SCRATCHPAD_SIZE) &&
+           (buf[4] & DS18B20_CONFIG_RESERVED) == DS18B20_CONFIG_RESERVED;
+}
+
+/**
+ * @brief เขียน config ความละเอียด (TH/TL เดิมจาก scratchpad)
+ */
+static bool DS18B20_WriteResolution(DS18B20_Sensor* s) {
+    uint8_t buf[DS18B20_SCRATCHPAD_SIZE];
+
+    if (!DS18B20_ReadScratchpad(s, buf)) return false;
+    if (!DS18B20_Address(s)) return false;
+
+    uint8_t cmd[4] = {
+        DS18B20_CMD_WRITE_SCRATCHPAD,
+        buf[2],                                                       // TH
+        buf[3],                                                       // TL
+        (uint8_t)(((s->resolution - 9) << 5) | DS18B20_CONFIG_RESERVED)  // R1:R0
+    };
+    OneWire_WriteBytes(s->bus, cmd, sizeof(cmd));
+
+    return true;
+}
+
+/**
+ * @brief หา (หรือเพิ่ม) bus ในตาราง buses ของ scheduler
+ */
+static uint8_t DS18B20_BusIndex(OneWire_Bus* bus) {
+    for (uint8_t i = 0; i < ds18b20_bus_count; i++) {
+        if (ds18b20_buses[i] == bus) return i;
+    }
+    if (ds18b20_bus_count >= ONEWIRE_MAX_BUSES) return DS18B20_NO_BUS;
+
+    ds18b20_buses[ds18b20_bus_count] = bus;
+    return ds18b20_bus_count++;
+}
+
+/**
+ * @brief ปัดความละเอียดเข้าช่วง 9-12 bits
+ */
+static uint8_t DS18B20_ClampResolution(uint8_t resolution) {
+    if (resolution < 9) return 9;
+    if (resolution > 12) return 12;
+    return resolution;
+}
+
+/**
+ * @brief อ่านผลของ sensor หนึ่งตัว (เก็บค่าเดิมไว้ถ้าอ่านไม่ผ่าน)
+ */
+static void DS18B20_ReadSensor(DS18B20_Sensor* s) {
+    uint8_t buf[DS18B20_SCRATCHPAD_SIZE];
+
+    if (!DS18B20_ReadScratchpad(s, buf)) {
+        if (s->crc_errors < 255) s->crc_errors++;
+        return;
+    }
+
+    // Bits ต่ำกว่าความละเอียดไม่ได้กำหนดค่า (datasheet) จึงล้างทิ้ง
+    int16_t raw = (int16_t)((uint16_t)buf[1] << 8 | buf[0]);
+    uint16_t undefined = (uint16_t)((1u << (12 - s->resolution)) - 1);
+    s->raw = (int16_t)(raw & (int16_t)~undefined);
+    s->valid = true;
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เพิ่ม sensor และตั้งความละเอียด
+ */
+int8_t DS18B20_Add(OneWire_Bus* bus, const uint8_t* rom, uint8_t resolution) {
+    if (!bus || !bus->initialized) return -1;
+    if (ds18b20_count >= SIMPLE_DS18B20_MAX_SENSORS || ds18b20_busy) return -1;
+
+    uint8_t bus_index = DS18B20_BusIndex(bus);
+    if (bus_index == DS18B20_NO_BUS) return -1;
+
+    DS18B20_Sensor* s = &ds18b20_sensors[ds18b20_count];
+    memset(s, 0, sizeof(DS18B20_Sensor));
+    s->bus = bus;
+    s->skip_rom = (rom == NULL);
+    if (rom) memcpy(s->rom, rom, 8);
+    s->resolution = DS18B20_ClampResolution(resolution);
+    s->raw = DS18B20_INVALID_TEMP;
+
+    if (!DS18B20_WriteResolution(s)) return -1;
+
+    ds18b20_bus_of[ds18b20_count] = bus_index;
+    return (int8_t)ds18b20_count++;
+}
+
+/**
+ * @brief เปลี่ยนความละเอียดของ sensor
+ */
+bool DS18B20_SetResolution(uint8_t index, uint8_t resolution) {
+    if (index >= ds18b20_count || ds18b20_busy) return false;
+
+    DS18B20_Sensor* s = &ds18b20_sensors[index];
+    s->resolution = DS18B20_ClampResolution(resolution);
+
+    return DS18B20_WriteResolution(s);
+}
+
+/**
+ * @brief เริ่ม sweep บนทุก bus
+ */
+bool DS18B20_StartSweep(void) {
+    if (ds18b20_busy || ds18b20_count == 0) return false;
+
+    // Convert T ด้วย Skip ROM: ทุก sensor บน bus เริ่มแปลงพร้อมกัน
+    bool converting[ONEWIRE_MAX_BUSES];
+    for (uint8_t b = 0; b < ds18b20_bus_count; b++) {
+        OneWire_Bus* bus = ds18b20_buses[b];
+
+        converting[b] = OneWire_Reset(bus);
+        if (converting[b]) {
+            OneWire_SkipROM(bus);
+            OneWire_WriteByte(bus, DS18B20_CMD_CONVERT_T);
+        }
+        ds18b20_bus_start[b] = Get_CurrentMs();
+    }
+
+    ds18b20_remaining = 0;
+    for (uint8_t i = 0; i < ds18b20_count; i++) {
+        DS18B20_Sensor* s = &ds18b20_sensors[i];
+
+        // Bus ที่ไม่มี presence: ไม่มีอะไรให้อ่าน นับเป็น error ทันที
+        s->pending = converting[ds18b20_bus_of[i]];
+        if (s->pending) {
+            ds18b20_remaining++;
+        } else if (s->crc_errors < 255) {
+            s->crc_errors++;
+        }
+    }
+
+    ds18b20_next = 0;
+    ds18b20_busy = true;
+
+    return true;
+}
+
+/**
+ * @brief เดิน scheduler (อ่านไม่เกิน 1 sensor ต่อครั้ง)
+ */
+bool DS18B20_Process(void) {
+    if (!ds18b20_busy) return false;
+
+    if (ds18b20_remaining) {
+        uint32_t now = Get_CurrentMs();
+
+        // Round-robin: sensor ที่ครบเวลาแปลงตัวถัดไป (ความละเอียดต่ำได้อ่านก่อน)
+        for (uint8_t n = 0; n < ds18b20_count; n++) {
+            uint8_t i = (uint8_t)((ds18b20_next + n) % ds18b20_count);
+            DS18B20_Sensor* s = &ds18b20_sensors[i];
+
+            if (!s->pending) continue;
+            if (ELAPSED_TIME(ds18b20_bus_start[ds18b20_bus_of[i]], now) <
+                DS18B20_ConversionTimeMs(s->resolution)) {
+                continue;
+            }
+
+            DS18B20_ReadSensor(s);
+            s->pending = false;
+            ds18b20_remaining--;
+            ds18b20_next = (uint8_t)(i + 1);
+            break;
+        }
+    }
+
+    if (ds18b20_remaining) return false;
+
+    ds18b20_busy = false;
+    return true;
+}
+
+/**
+ * @brief ตรวจว่ากำลังอยู่ระหว่าง sweep
+ */
+bool DS18B20_IsBusy(void) {
+    return ds18b20_busy;
+}
+
+/**
+ * @brief จำนวน sensors ที่เพิ่มไว้
+ */
+uint8_t DS18B20_Count(void) {
+    return ds18b20_count;
+}
+
+/**
+ * @brief ข้อมูลของ sensor
+ */
+const DS18B20_Sensor* DS18B20_GetSensor(uint8_t index) {
+    if (index >= ds18b20_count) return NULL;
+    return &ds18b20_sensors[index];
+}
+
+/**
+ * @brief อุณหภูมิล่าสุด (1/16 °C)
+ */
+int16_t DS18B20_GetRaw(uint8_t index) {
+    if (index >= ds18b20_count || !ds18b20_sensors[index].valid) {
+        return DS18B20_INVALID_TEMP;
+    }
+    return ds18b20_sensors[index].raw;
+}
+
+/**
+ * @brief อุณหภูมิล่าสุด (0.01 °C)
+ */
+int16_t DS18B20_GetCentiC(uint8_t index) {
+    int16_t raw = DS18B20_GetRaw(index);
+    if (raw == DS18B20_INVALID_TEMP) return DS18B20_INVALID_TEMP;
+
+    // raw * 100 / 16 = raw * 25 / 4 (สูงสุด 2000 * 25 ไม่ล้น int32)
+    return (int16_t)(((int32_t)raw * 25) / 4);
+}
+
+/**
+ * @brief เวลาแปลงสูงสุดตามความละเอียด
+ * @note 750 ms ที่ 12 bit ลดลงครึ่งหนึ่งต่อ bit (93.75 ms ที่ 9 bit) +1 ms ปัดขึ้น
+ */
+uint16_t DS18B20_ConversionTimeMs(uint8_t resolution) {
+    return (uint16_t)((750u >> (12 - DS18B20_ClampResolution(resolution))) + 1);
+}
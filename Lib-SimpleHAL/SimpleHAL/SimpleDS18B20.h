@@ -0,0 +1,166 @@
+/**
+ * @file SimpleDS18B20.h
+ * @brief DS18B20 scheduler: สั่ง Convert T ทุก bus พร้อมกันแล้วทยอยอ่านตามความละเอียด
+ * @version 1.0
+ * @date 2026-10-15
+ *
+ * @details
+ * อ่านทีละ sensor แบบเดิม (Convert T -> รอ 750 ms -> อ่าน) ใช้เวลา 750 ms ต่อ sensor
+ * module นี้ส่ง Skip ROM + Convert T ไปทุก bus ในครั้งเดียว (ทุก sensor แปลงพร้อมกัน)
+ * แล้ว DS18B20_Process() อ่าน scratchpad ทีละ sensor เมื่อครบเวลาแปลงของ sensor นั้น
+ *
+ * **การจัดลำดับ:**
+ * - เวลาแปลงนับต่อ sensor ตามความละเอียดของตัวเอง (9 bit 94 ms ... 12 bit 751 ms)
+ *   sensor ความละเอียดต่ำถูกอ่านระหว่างที่ตัวอื่นบน bus อื่นยังแปลงอยู่
+ * - Process() อ่านไม่เกิน 1 sensor ต่อครั้ง (~10 ms) main loop ไม่ถูกบล็อกนาน
+ * - ตรวจ CRC ด้วย OneWire_VerifyCRC() ตัวที่ CRC ผิดถูกนับใน crc_errors และค่าเดิมถูกเก็บไว้
+ * - Sweep 16 sensors (12 bit) ใช้เวลา ~1 conversion period + เวลาอ่าน 16 x ~10 ms
+ *
+ * @example
+ * OneWire_Bus* bus_a = OneWire_Init(PC1);
+ * OneWire_Bus* bus_b = OneWire_Init(PD2);
+ *
+ * DS18B20_Add(bus_a, rom_tank, 12);   // Match ROM
+ * DS18B20_Add(bus_a, rom_pipe, 10);
+ * DS18B20_Add(bus_b, NULL, 9);        // sensor เดียวบน bus: Skip ROM
+ *
+ * DS18B20_StartSweep();
+ * while (1) {
+ *     if (DS18B20_Process()) {
+ *         int16_t t = DS18B20_GetCentiC(0);  // 2512 = 25.12 °C
+ *         DS18B20_StartSweep();
+ *     }
+ * }
+ *
+ * @note Parasite power: ต้องเปิด strong pull-up เองระหว่างแปลง (ไม่มีใน module นี้)
+ */
+
+#ifndef __SIMPLE_DS18B20_H
+#define __SIMPLE_DS18B20_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SimpleHAL_Config.h"
+#include "Simple1Wire.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief จำนวน sensors สูงสุด (ทุก bus รวมกัน)
+ */
+#ifndef SIMPLE_DS18B20_MAX_SENSORS
+#define SIMPLE_DS18B20_MAX_SENSORS 16
+#endif
+
+/* ========== DS18B20 Commands ========== */
+
+#define DS18B20_CMD_CONVERT_T         0x44  /**< เริ่มแปลงอุณหภูมิ */
+#define DS18B20_CMD_WRITE_SCRATCHPAD  0x4E  /**< เขียน TH, TL, config */
+#define DS18B20_CMD_READ_SCRATCHPAD   0xBE  /**< อ่าน scratchpad 9 bytes */
+#define DS18B20_CMD_COPY_SCRATCHPAD   0x48  /**< บันทึก TH, TL, config ลง EEPROM */
+
+#define DS18B20_INVALID_TEMP  INT16_MIN     /**< ค่าที่คืนเมื่อยังไม่มีค่าที่ผ่าน CRC */
+
+/* ========== Structures ========== */
+
+/**
+ * @brief ข้อมูลต่อ sensor
+ */
+typedef struct {
+    OneWire_Bus* bus;       /**< bus ที่ sensor อยู่ */
+    uint8_t rom[8];         /**< ROM address (family 0x28) */
+    bool skip_rom;          /**< sensor เดียวบน bus: ใช้ Skip ROM แทน Match ROM */
+    uint8_t resolution;     /**< 9-12 bits */
+    int16_t raw;            /**< ค่าล่าสุดที่ผ่าน CRC (1/16 °C) */
+    bool valid;             /**< มีค่าที่ผ่าน CRC แล้ว */
+    bool pending;           /**< ยังไม่ได้อ่านใน sweep ปัจจุบัน */
+    uint8_t crc_errors;     /**< จำนวนครั้งที่ CRC ผิด (ค้างที่ 255) */
+} DS18B20_Sensor;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เพิ่ม sensor และตั้งความละเอียด (เขียน config ลง scratchpad)
+ * @param bus bus ที่ sensor อยู่
+ * @param rom ROM address 8 bytes หรือ NULL ถ้ามี sensor เดียวบน bus
+ * @param resolution 9-12 bits (นอกช่วงถูกปัดเข้าช่วง)
+ * @return index ของ sensor หรือ -1 ถ้าเต็มหรือไม่พบ device
+ *
+ * @note TH/TL เดิมถูกเก็บไว้ (อ่าน scratchpad ก่อนเขียน)
+ * @note ทำงานแบบ blocking (~15 ms) เรียกตอน init
+ */
+int8_t DS18B20_Add(OneWire_Bus* bus, const uint8_t* rom, uint8_t resolution);
+
+/**
+ * @brief เปลี่ยนความละเอียดของ sensor
+ * @param index index จาก DS18B20_Add()
+ * @param resolution 9-12 bits
+ * @return true = เขียนสำเร็จ
+ *
+ * @note ห้ามเรียกระหว่าง sweep (DS18B20_IsBusy())
+ */
+bool DS18B20_SetResolution(uint8_t index, uint8_t resolution);
+
+/**
+ * @brief เริ่ม sweep: ส่ง Skip ROM + Convert T ไปทุก bus ที่มี sensor
+ * @return true = เริ่มแล้ว, false = sweep ก่อนหน้ายังไม่จบหรือไม่มี sensor
+ *
+ * @note ใช้เวลา ~1.5 ms ต่อ bus
+ */
+bool DS18B20_StartSweep(void);
+
+/**
+ * @brief เดิน scheduler: อ่าน sensor ที่ครบเวลาแปลงแล้วไม่เกิน 1 ตัว
+ * @return true ครั้งเดียวเมื่อ sweep จบ (อ่านครบทุก sensor)
+ *
+ * @note เรียกใน main loop บ่อยๆ ยิ่งเรียกถี่ sweep ยิ่งจบเร็ว
+ */
+bool DS18B20_Process(void);
+
+/**
+ * @brief ตรวจว่ากำลังอยู่ระหว่าง sweep
+ */
+bool DS18B20_IsBusy(void);
+
+/**
+ * @brief จำนวน sensors ที่เพิ่มไว้
+ */
+uint8_t DS18B20_Count(void);
+
+/**
+ * @brief ข้อมูลของ sensor (ROM, crc_errors, ...)
+ * @return NULL ถ้า index ไม่ถูกต้อง
+ */
+const DS18B20_Sensor* DS18B20_GetSensor(uint8_t index);
+
+/**
+ * @brief อุณหภูมิล่าสุดในหน่วย 1/16 °C (ค่าดิบจาก sensor)
+ * @return DS18B20_INVALID_TEMP ถ้ายังไม่มีค่าที่ผ่าน CRC
+ */
+int16_t DS18B20_GetRaw(uint8_t index);
+
+/**
+ * @brief อุณหภูมิล่าสุดในหน่วย 0.01 °C (ไม่ใช้ float)
+ * @return DS18B20_INVALID_TEMP ถ้ายังไม่มีค่าที่ผ่าน CRC
+ *
+ * @example
+ * int16_t t = DS18B20_GetCentiC(0);
+ * printf("%d.%02d C\r\n", t / 100, abs(t % 100));
+ */
+int16_t DS18B20_GetCentiC(uint8_t index);
+
+/**
+ * @brief เวลาแปลงสูงสุดตามความละเอียด (ms)
+ * @param resolution 9-12 bits
+ */
+uint16_t DS18B20_ConversionTimeMs(uint8_t resolution);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_DS18B20_H
@@ -0,0 +1,211 @@
+/**
+ * @file SimpleDebounce.c
+ * @brief Timer-driven Debounce Engine Implementation
+ * @version 1.1
+ * @date 2026-10-14
+ */
+
+#include "SimpleDebounce.h"
+
+/* ========== Private Definitions ========== */
+
+#define DEBOUNCE_PORT_COUNT 3
+#define DEBOUNCE_QUEUE_MASK (SIMPLE_DEBOUNCE_QUEUE_SIZE - 1)
+
+/**
+ * @brief สถานะ debounce ต่อ port (ทุก bit ของ port ทำงานขนานกัน)
+ */
+typedef struct {
+    uint16_t mask;    /**< bit ที่ลงทะเบียน */
+    uint16_t invert;  /**< bit ที่เป็น active-low */
+    uint16_t state;   /**< สถานะที่ debounce แล้ว (1 = active) */
+    uint16_t cnt0;    /**< vertical counter bit 0 */
+    uint16_t cnt1;    /**< vertical counter bit 1 */
+} DebouncePort_t;
+
+/* ========== Private Variables ========== */
+
+static GPIO_TypeDef* const debounce_gpio[DEBOUNCE_PORT_COUNT] = {GPIOA, GPIOC, GPIOD};
+static const uint8_t debounce_pin_base[DEBOUNCE_PORT_COUNT] = {
+    (uint8_t)(PA1 - 1), PC0, (uint8_t)(PD2 - 2)
+};
+
+static volatile DebouncePort_t debounce_ports[DEBOUNCE_PORT_COUNT];
+
+static volatile Debounce_Event_t debounce_queue[SIMPLE_DEBOUNCE_QUEUE_SIZE];
+static volatile uint8_t debounce_head = 0;
+static volatile uint8_t debounce_tail = 0;
+static volatile uint16_t debounce_overruns = 0;
+
+// Port state + event queue (SimpleHAL_RamReport())
+const uint16_t debounce_ram_bytes = sizeof(debounce_ports) + sizeof(debounce_queue);
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief แปลง pin เป็น index ของ port
+ */
+static inline uint8_t getPortIndex(uint8_t pin) {
+    if (pin < PC0) return 0;
+    if (pin < PD2) return 1;
+    return 2;
+}
+
+/**
+ * @brief ใส่ event ทุก bit ที่เปลี่ยนสถานะลง queue
+ */
+static void pushEvents(uint8_t port, uint16_t changed, uint16_t state) {
+    uint8_t bit = 0;
+    while (changed) {
+        if (changed & 1) {
+            uint8_t next = (debounce_head + 1) & DEBOUNCE_QUEUE_MASK;
+            if (next == debounce_tail) {
+                debounce_overruns++;
+            } else {
+                debounce_queue[debounce_head].pin = debounce_pin_base[port] + bit;
+                debounce_queue[debounce_head].type = (state & 1) ? DEBOUNCE_PRESS : DEBOUNCE_RELEASE;
+                debounce_head = next;
+            }
+        }
+        changed >>= 1;
+        state >>= 1;
+        bit++;
+    }
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่ม debounce engine ด้วย timer interrupt
+ */
+void Debounce_Init(TIM_Instance timer, uint16_t sample_hz) {
+    debounce_head = 0;
+    debounce_tail = 0;
+    debounce_overruns = 0;
+
+    TIM_SimpleInit(timer, sample_hz);
+    TIM_AttachInterrupt(timer, Debounce_Tick);
+    TIM_Start(timer);
+}
+
+/**
+ * @brief เริ่ม debounce engine บน SysTick tick hook
+ */
+void Debounce_InitSysTick(uint16_t interval_ms) {
+    static Timer_TickHook_t hook;
+
+    debounce_head = 0;
+    debounce_tail = 0;
+    debounce_overruns = 0;
+
+    Timer_AddTickHook(&hook, interval_ms, Debounce_Tick);
+}
+
+/**
+ * @brief ลงทะเบียน pin เข้า debounce engine
+ */
+uint8_t Debounce_AddPin(uint8_t pin, uint8_t active_low) {
+    if (!IS_GPIO_PIN(pin)) return 0;
+
+    uint8_t idx = getPortIndex(pin);
+    uint16_t bit = GPIO_PIN_MASK(pin);
+    volatile DebouncePort_t* p = &debounce_ports[idx];
+
+    __disable_irq();
+    uint16_t level = debounce_gpio[idx]->INDR & bit;
+    if (active_low) {
+        p->invert |= bit;
+        level ^= bit;
+    } else {
+        p->invert &= ~bit;
+    }
+    p->state = (p->state & ~bit) | level;
+    p->cnt0 &= ~bit;
+    p->cnt1 &= ~bit;
+    p->mask |= bit;
+    __enable_irq();
+
+    return 1;
+}
+
+/**
+ * @brief ยกเลิกการ debounce pin
+ */
+void Debounce_RemovePin(uint8_t pin) {
+    if (!IS_GPIO_PIN(pin)) return;
+
+    uint16_t bit = GPIO_PIN_MASK(pin);
+    volatile DebouncePort_t* p = &debounce_ports[getPortIndex(pin)];
+
+    __disable_irq();
+    p->mask &= ~bit;
+    p->state &= ~bit;
+    __enable_irq();
+}
+
+/**
+ * @brief Sample ทุก port หนึ่งครั้ง
+ *
+ * Vertical counter: bit ที่ค่าอ่านต่างจาก state นับขึ้น 1 ต่อ tick
+ * (cnt1:cnt0 = 0,1,2,3) ต่างติดกันครั้งที่ 4 จึง toggle state
+ * bit ที่ค่าอ่านตรงกับ state จะ reset counter ทันที
+ */
+void Debounce_Tick(void) {
+    for (uint8_t i = 0; i < DEBOUNCE_PORT_COUNT; i++) {
+        volatile DebouncePort_t* p = &debounce_ports[i];
+        uint16_t mask = p->mask;
+        if (!mask) continue;
+
+        uint16_t sample = (debounce_gpio[i]->INDR ^ p->invert) & mask;
+        uint16_t state = p->state;
+        uint16_t delta = sample ^ state;
+        uint16_t cnt0 = p->cnt0;
+        uint16_t cnt1 = p->cnt1;
+        uint16_t toggle = delta & cnt0 & cnt1;
+
+        // นับขึ้นเฉพาะ bit ที่ต่างจาก state (3 -> 0 วนกลับเองเมื่อ toggle)
+        p->cnt1 = (cnt1 ^ cnt0) & delta;
+        p->cnt0 = ~cnt0 & delta;
+
+        if (toggle) {
+            state ^= toggle;
+            p->state = state;
+            pushEvents(i, toggle, state);
+        }
+    }
+}
+
+/**
+ * @brief อ่าน event ถัดไปจาก queue
+ */
+uint8_t Debounce_GetEvent(Debounce_Event_t* event) {
+    uint8_t tail = debounce_tail;
+    if (tail == debounce_head) return 0;
+
+    event->pin = debounce_queue[tail].pin;
+    event->type = debounce_queue[tail].type;
+    debounce_tail = (tail + 1) & DEBOUNCE_QUEUE_MASK;
+    return 1;
+}
+
+/**
+ * @brief จำนวน event ที่รออยู่ใน queue
+ */
+uint8_t Debounce_Available(void) {
+    return (debounce_head - debounce_tail) & DEBOUNCE_QUEUE_MASK;
+}
+
+/**
+ * @brief อ่านสถานะที่ debounce แล้วของ pin
+ */
+uint8_t Debounce_IsPressed(uint8_t pin) {
+    if (!IS_GPIO_PIN(pin)) return 0;
+    return (debounce_ports[getPortIndex(pin)].state & GPIO_PIN_MASK(pin)) ? 1 : 0;
+}
+
+/**
+ * @brief จำนวน event ที่ถูกทิ้งเพราะ queue เต็ม
+ */
+uint16_t Debounce_Overruns(void) {
+    return debounce_overruns;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file SimpleDebounce.h
+ * @brief Timer-driven Debounce Engine สำหรับ CH32V003
+ * @version 1.1
+ * @date 2026-10-14
+ *
+ * @details
+ * Library นี้ debounce ปุ่ม/สวิตช์หลายตัวพร้อมกันจาก timer tick เดียว
+ * แทนการเขียน digitalRead + millis() กระจายอยู่ใน main loop
+ *
+ * **หลักการทำงาน:**
+ * - ทุก tick อ่าน INDR ของแต่ละ port ที่มี pin ลงทะเบียนเพียงครั้งเดียว
+ * - ใช้ vertical counter 2-bit ต่อ port (ทุก bit ของ port นับพร้อมกัน)
+ * - สถานะจะเปลี่ยนเมื่อค่าอ่านได้คงที่ติดต่อกัน 4 samples
+ * - ต้นทุนประมาณสิบกว่าคำสั่งต่อ port ไม่ขึ้นกับจำนวน pin
+ * - Event PRESS/RELEASE ถูกเก็บใน ring buffer ให้ main loop อ่านทีหลัง
+ *
+ * **เวลา debounce:**
+ * - debounce_time = 4 / sample_hz (เช่น 200 Hz -> 20 ms)
+ *
+ * @example
+ * #include "SimpleDebounce.h"
+ *
+ * int main(void) {
+ *     pinMode(PC1, PIN_MODE_INPUT_PULLUP);
+ *     pinMode(PD3, PIN_MODE_INPUT_PULLUP);
+ *     Debounce_AddPin(PC1, 1);   // active-low (กดแล้วเป็น LOW)
+ *     Debounce_AddPin(PD3, 1);
+ *     Debounce_Init(TIM_2, 200); // sample 200 Hz -> debounce 20 ms
+ *
+ *     while(1) {
+ *         Debounce_Event_t ev;
+ *         while(Debounce_GetEvent(&ev)) {
+ *             if(ev.type == DEBOUNCE_PRESS) {
+ *                 printf("Pin %d pressed\r\n", ev.pin);
+ *             }
+ *         }
+ *     }
+ * }
+ *
+ * @note Timer ที่ใช้จะถูก SimpleDebounce ครอบครอง (ใช้ TIM_AttachInterrupt)
+ * @note Debounce_InitSysTick() ใช้ tick hook ของ SimpleDelay แทน (ไม่ใช้ TIM)
+ */
+
+#ifndef __SIMPLE_DEBOUNCE_H
+#define __SIMPLE_DEBOUNCE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <ch32v00x.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleDelay.h"
+#include "SimpleGPIO.h"
+#include "SimpleTIM.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief ขนาด event queue (ต้องเป็นเลขยกกำลัง 2)
+ */
+#ifndef SIMPLE_DEBOUNCE_QUEUE_SIZE
+#define SIMPLE_DEBOUNCE_QUEUE_SIZE 16
+#endif
+
+#if (SIMPLE_DEBOUNCE_QUEUE_SIZE & (SIMPLE_DEBOUNCE_QUEUE_SIZE - 1)) != 0
+#error "SIMPLE_DEBOUNCE_QUEUE_SIZE must be a power of 2"
+#endif
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief ชนิดของ debounce event
+ */
+typedef enum {
+    DEBOUNCE_RELEASE = 0,  /**< ปล่อยปุ่ม (สถานะ active -> inactive) */
+    DEBOUNCE_PRESS = 1     /**< กดปุ่ม (สถานะ inactive -> active) */
+} Debounce_EventType;
+
+/**
+ * @brief Debounce event ที่อ่านได้จาก queue
+ */
+typedef struct {
+    uint8_t pin;   /**< Pin ที่เกิด event (GPIO_Pin) */
+    uint8_t type;  /**< DEBOUNCE_PRESS หรือ DEBOUNCE_RELEASE */
+} Debounce_Event_t;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่ม debounce engine ด้วย timer interrupt
+ * @param timer Timer ที่ใช้สร้าง sample tick (TIM_1 หรือ TIM_2)
+ * @param sample_hz ความถี่การ sample (Hz) แนะนำ 100-500 Hz
+ *
+ * @note debounce_time = 4 / sample_hz
+ * @note เรียก Debounce_AddPin() ก่อนหรือหลัง Init ก็ได้
+ *
+ * @example
+ * Debounce_Init(TIM_2, 200);  // debounce 20 ms
+ */
+void Debounce_Init(TIM_Instance timer, uint16_t sample_hz);
+
+/**
+ * @brief เริ่ม debounce engine บน SysTick ร่วมกับ SimpleDelay (ไม่ใช้ TIM)
+ * @param interval_ms คาบการ sample (ms) แนะนำ 2-10 ms
+ *
+ * @note debounce_time = 4 × interval_ms
+ * @note Sample ใน SysTick_Handler ผ่าน Timer_AddTickHook()
+ *
+ * @example
+ * Debounce_InitSysTick(5);  // debounce 20 ms
+ */
+void Debounce_InitSysTick(uint16_t interval_ms);
+
+/**
+ * @brief ลงทะเบียน pin เข้า debounce engine
+ * @param pin GPIO pin (PA1-PD7)
+ * @param active_low 1 = กดแล้วเป็น LOW (ปุ่มต่อ GND + pull-up), 0 = กดแล้วเป็น HIGH
+ * @return 1 = สำเร็จ, 0 = pin ไม่ถูกต้อง
+ *
+ * @note ต้องตั้ง pinMode() เป็น input เอง
+ * @note สถานะเริ่มต้นอ้างอิงจากค่าที่อ่านได้ตอนลงทะเบียน (ไม่เกิด event ปลอม)
+ *
+ * @example
+ * pinMode(PC1, PIN_MODE_INPUT_PULLUP);
+ * Debounce_AddPin(PC1, 1);
+ */
+uint8_t Debounce_AddPin(uint8_t pin, uint8_t active_low);
+
+/**
+ * @brief ยกเลิกการ debounce pin
+ * @param pin GPIO pin ที่ลงทะเบียนไว้
+ */
+void Debounce_RemovePin(uint8_t pin);
+
+/**
+ * @brief Sample ทุก port หนึ่งครั้ง (ถูกเรียกจาก timer interrupt)
+ *
+ * @note เรียกเองได้หากต้องการใช้ tick จากแหล่งอื่น (ไม่ต้องเรียก Debounce_Init)
+ */
+void Debounce_Tick(void);
+
+/**
+ * @brief อ่าน event ถัดไปจาก queue
+ * @param event ตัวแปรรับ event
+ * @return 1 = มี event, 0 = queue ว่าง
+ */
+uint8_t Debounce_GetEvent(Debounce_Event_t* event);
+
+/**
+ * @brief จำนวน event ที่รออยู่ใน queue
+ * @return จำนวน event
+ */
+uint8_t Debounce_Available(void);
+
+/**
+ * @brief อ่านสถานะที่ debounce แล้วของ pin
+ * @param pin GPIO pin ที่ลงทะเบียนไว้
+ * @return 1 = กดอยู่ (active), 0 = ไม่ได้กด
+ */
+uint8_t Debounce_IsPressed(uint8_t pin);
+
+/**
+ * @brief จำนวน event ที่ถูกทิ้งเพราะ queue เต็ม
+ * @return จำนวน event ที่หาย (นับตั้งแต่ Debounce_Init)
+ */
+uint16_t Debounce_Overruns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_DEBOUNCE_H
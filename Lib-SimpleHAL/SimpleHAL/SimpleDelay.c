@@ -1,7 +1,7 @@
 /********************************** (C) COPYRIGHT
  * ******************************* File Name          : SimpleDelay.c Author    :
- * Extracted from WCH debug.c Version            : V1.0.0 Date               :
- * 2025/12/21 Description        : Delay and Timing Library Implementation
+ * Extracted from WCH debug.c Version            : V1.8.0 Date               :
+ * 2026/10/14 Description        : Delay and Timing Library Implementation
  *********************************************************************************
  * Copyright (c) 2021 Nanjing Qinheng Microelectronics Co., Ltd.
  * Attention: This software (modified or not) and binary are used for
@@ -9,11 +9,154 @@
  *******************************************************************************/
 
 #include "SimpleDelay.h"
+#include "SimpleISRStat.h"
+#if SIMPLE_DELAY_SLEEP_MS
+#include "SimpleClock.h"
+#include "SimplePWR.h"
+#endif
 
 /* Global Variables */
-static uint32_t us_per_tick = 0; // จำนวน microseconds ต่อ 1 tick
 volatile uint32_t millis = 0;    // ตัวนับ milliseconds (ถูกแก้ไขใน interrupt)
 
+void (*volatile SimpleHAL_IdleHook)(void) = NULL;  // เรียกใน blocking waits
+
+// Timebase: us = micros_base + (ticks × us_per_tick_q20) >> 20 (ไม่มีการหาร)
+#define TICK_US_SHIFT 20
+static uint32_t tick_per_ms = 0;          // SysTick counts ต่อ 1 ms
+static uint32_t tick_per_us = 0;          // SysTick counts (= CPU cycles) ต่อ 1 us
+static uint32_t us_per_tick_q20 = 0;      // (1000 << 20) / tick_per_ms
+static volatile uint64_t micros_base = 0; // us ที่ขอบ ms ล่าสุด (64-bit ไม่ล้น)
+
+// SoftTimer service
+static SoftTimer_t *softtimer_head = NULL;          // active list เรียงตามเวลาหมด
+static SoftTimer_t *softtimer_pending_head = NULL;  // คิวรอ SoftTimer_Run()
+static SoftTimer_t *softtimer_pending_tail = NULL;
+
+// Tick hooks ที่ SysTick เรียก (ลำดับตามการลงทะเบียน)
+static Timer_TickHook_t *tickhook_head = NULL;
+
+#if SIMPLE_DELAY_TICKLESS
+// Tickless: SysTick นับอิสระ millis ถูกเลื่อนตามตัวนับเมื่อมีการอ่านเวลา
+static uint32_t tick_base = 0;    // ค่า CNT ที่ตรงกับค่า millis ปัจจุบัน
+static uint32_t tick_max_ms = 0;  // ตื่นอย่างน้อยทุกเท่านี้ (ก่อน CNT - tick_base ล้น)
+static uint32_t softtimer_ms = 0; // millis ที่ active list ถูกเลื่อนถึงล่าสุด
+
+#define SYSTICK_CTLR_SWIE (1UL << 31) // สั่ง SysTick interrupt ด้วย software
+#endif
+
+static void SoftTimer_Advance(uint32_t ms);
+static void Timer_RunHooks(uint32_t ms);
+
+/**
+ * @brief ปิด IRQ และจำสถานะเดิม (เรียกจาก callback ใน interrupt ได้)
+ */
+static inline uint32_t Timer_Lock(void) {
+  uint32_t mstatus;
+  __asm volatile("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+  return mstatus;
+}
+
+static inline void Timer_Unlock(uint32_t mstatus) {
+  if (mstatus & 0x8) {
+    __asm volatile("csrsi mstatus, 0x8");
+  }
+}
+
+#if SIMPLE_DELAY_TICKLESS
+/**
+ * @brief เลื่อน millis ตามจำนวน ms เต็มที่ตัวนับผ่านไป (ต้องถือ lock)
+ *
+ * @return ticks หลังขอบ ms ล่าสุด (< tick_per_ms)
+ */
+static uint32_t Timer_Sync(void) {
+  uint32_t elapsed = SysTick->CNT - tick_base;
+
+  if (elapsed >= 4 * tick_per_ms) {
+    // หลัง sleep นาน: หารครั้งเดียว
+    uint32_t ms = elapsed / tick_per_ms;
+    uint32_t ticks = ms * tick_per_ms;
+    tick_base += ticks;
+    elapsed -= ticks;
+    millis += ms;
+    micros_base += (uint64_t)ms * 1000;
+  } else {
+    // กรณีปกติ (อ่านเวลาบ่อย): ลบไม่เกิน 3 รอบ
+    while (elapsed >= tick_per_ms) {
+      tick_base += tick_per_ms;
+      elapsed -= tick_per_ms;
+      millis++;
+      micros_base += 1000;
+    }
+  }
+  return elapsed;
+}
+
+/**
+ * @brief ตั้ง compare ไว้ที่ deadline ถัดไป (ต้องถือ lock และ sync แล้ว)
+ */
+static void Timer_Reschedule(void) {
+  uint32_t ms = tick_max_ms;
+
+  if (softtimer_head != NULL) {
+    uint32_t lag = millis - softtimer_ms;
+    uint32_t due = softtimer_head->delta;
+    due = (due > lag) ? due - lag : 0;
+    if (due < ms) {
+      ms = due;
+    }
+  }
+
+  for (Timer_TickHook_t *hook = tickhook_head; hook != NULL; hook = hook->next) {
+    uint32_t lag = millis - softtimer_ms;
+    uint32_t due = (hook->remaining > lag) ? hook->remaining - lag : 0;
+    if (due < ms) {
+      ms = due;
+    }
+  }
+
+  uint32_t target = tick_base + ms * tick_per_ms;
+  SysTick->CMP = target;
+
+  // compare แบบเท่ากันเท่านั้น ถ้าตัวนับผ่านไปแล้วให้เข้า interrupt ทันที
+  if ((int32_t)(target - SysTick->CNT) <= 0) {
+    SysTick->CTLR |= SYSTICK_CTLR_SWIE;
+  }
+}
+#endif
+
+/**
+ * @brief อ่านเวลา 64-bit us (ต้องถือ lock)
+ */
+static uint64_t Timer_ReadUs(void) {
+#if SIMPLE_DELAY_TICKLESS
+  uint32_t ticks = Timer_Sync();
+  return micros_base + ((ticks * us_per_tick_q20) >> TICK_US_SHIFT);
+#else
+  uint64_t base = micros_base;
+  uint32_t ticks = SysTick->CNT;
+
+  // ตัวนับรีเซ็ตแล้วแต่ SysTick_Handler ยังไม่ได้ทำงาน (ถูกเรียกใน ISR อื่น
+  // หรือขณะปิด interrupt): อ่านใหม่และนับ ms นั้นเอง เวลาจึงไม่ถอยหลัง
+  if (SysTick->SR & 1) {
+    ticks = SysTick->CNT;
+    base += 1000;
+  }
+  return base + ((ticks * us_per_tick_q20) >> TICK_US_SHIFT);
+#endif
+}
+
+/**
+ * @brief คำนวณค่าแปลง ticks ↔ เวลา จาก SystemCoreClock
+ */
+static void Timer_SetRate(void) {
+  tick_per_ms = SystemCoreClock / 1000;
+  tick_per_us = tick_per_ms / 1000;
+  us_per_tick_q20 = (1000UL << TICK_US_SHIFT) / tick_per_ms; // ปัดลง: ไม่ถึง 1000 ใน 1 ms
+#if SIMPLE_DELAY_TICKLESS
+  tick_max_ms = 0x40000000UL / tick_per_ms;
+#endif
+}
+
 /*================= INITIALIZATION ==================*/
 
 /**
@@ -23,29 +166,78 @@ volatile uint32_t millis = 0;    // ตัวนับ milliseconds (ถูก
  * 1. ตั้งค่า SysTick ให้ทำงานที่ความถี่ 1ms
  * 2. เปิดใช้งาน SysTick interrupt
  * 3. เปิดใช้งาน NVIC สำหรับ SysTick
+ * 4. บันทึกสถานะ SIMPLE_INIT_DELAY (ฟังก์ชันอื่นจะไม่ init ซ้ำ)
  *
- * @note ต้องเรียกใช้ก่อนใช้งานฟังก์ชัน timer อื่นๆ
+ * @note ฟังก์ชัน timer อื่นๆ เรียกให้เองเมื่อใช้งานครั้งแรก
  */
 void Timer_Init(void) {
-  us_per_tick = 1000;                    // ตั้งค่า SysTick interrupt ให้เกิดทุก 1ms
+  Timer_SetRate();
+#if SIMPLE_DELAY_TICKLESS
+  tick_base = 0;
+  softtimer_ms = millis;
+  SysTick->CTLR = 0;
+  SysTick->SR = 0;
+  SysTick->CNT = 0;
+  SysTick->CMP = tick_max_ms * tick_per_ms;
+  SysTick->CTLR = 0x7;          // STE | STIE | HCLK, ไม่ auto-reload (นับอิสระ)
+  NVIC_EnableIRQ(SysTick_IRQn);
+  SimpleInit_Run(SIMPLE_INIT_DELAY, NULL);
+  if (softtimer_head != NULL) {
+    uint32_t mstatus = Timer_Lock();
+    Timer_Reschedule();
+    Timer_Unlock(mstatus);
+  }
+#else
   SysTick->CTLR = 0;                     // ปิดการทำงานของ SysTick ก่อนตั้งค่า
   SysTick->SR = 0;                       // ล้างสถานะ interrupt flag
   SysTick->CNT = 0;                      // เคลียร์ตัวนับ
-  SysTick->CMP = SystemCoreClock / 1000; // ตั้งค่าคอมแพร์เพื่อให้เกิด interrupt ทุก 1ms
+  SysTick->CMP = tick_per_ms;            // ตั้งค่าคอมแพร์เพื่อให้เกิด interrupt ทุก 1ms
   SysTick->CTLR = 0xF;          // เปิดการทำงานของ SysTick พร้อม interrupt
   NVIC_EnableIRQ(SysTick_IRQn); // เปิดใช้งาน SysTick ใน NVIC
+  SimpleInit_Run(SIMPLE_INIT_DELAY, NULL);
+#endif
 }
 
+/**
+ * @brief ปรับ SysTick หลัง SystemCoreClock เปลี่ยน โดยเวลาไม่กระโดด
+ *
+ * ticks ที่ค้างอยู่ในตัวนับ (เศษของ ms ปัจจุบัน) ถูกแปลงเป็นจำนวน ticks
+ * ที่อัตราใหม่ millis และ micros จึงต่อเนื่อง
+ *
+ * @note SysTick ต้องหยุดนับ (CTLR bit 0 = 0) ก่อนเปลี่ยน clock จนถึงตอนเรียก
+ *       เรียกขณะปิด interrupt (SimpleHAL_SetSysClock() ทำให้)
+ */
+void Timer_Retime(void) {
+  if (!SimpleInit_IsDone(SIMPLE_INIT_DELAY)) return;  // init ครั้งแรกใช้ clock ใหม่เอง
+
+  uint32_t old_tick_per_ms = tick_per_ms;
+#if SIMPLE_DELAY_TICKLESS
+  uint32_t ticks = Timer_Sync();  // เลื่อน ms ที่ครบด้วยอัตราเดิม เหลือเศษ < old_tick_per_ms
+  Timer_SetRate();
+  tick_base = 0;
+  SysTick->CNT = ticks * tick_per_ms / old_tick_per_ms;
+  Timer_Reschedule();
+#else
+  // ถ้า compare ผ่านไปแล้ว CNT เริ่มนับใหม่และ SysTick_Handler นับ ms นั้นเองเมื่อเปิด interrupt
+  uint32_t ticks = SysTick->CNT;
+  Timer_SetRate();
+  SysTick->CMP = tick_per_ms;
+  SysTick->CNT = ticks * tick_per_ms / old_tick_per_ms;
+#endif
+  SysTick->CTLR |= 1;  // นับต่อ
+}
+
+#if SIMPLE_DELAY_AUTO_INIT
 /**
  * @brief Auto-initialization function
  *
- * ฟังก์ชันนี้จะถูกเรียกอัตโนมัติก่อน main()
- * ทำให้ไม่ต้องเรียก Timer_Init() เอง
+ * ฟังก์ชันนี้จะถูกเรียกอัตโนมัติก่อน main() เมื่อ SIMPLE_DELAY_AUTO_INIT = 1
  */
 __attribute__((constructor))
 static void SimpleDelay_AutoInit(void) {
   Timer_Init();
 }
+#endif
 
 /**
  * @brief SysTick Interrupt Handler
@@ -56,12 +248,139 @@ static void SimpleDelay_AutoInit(void) {
 void SysTick_Handler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
 
 void SysTick_Handler(void) {
+#if SIMPLE_DELAY_TICKLESS
+  // CNT นับต่อจาก compare: latency = CNT - CMP (0 ถ้าปลุกด้วย SWIE ก่อนถึง compare)
+  ISR_STAT_ENTER_LATENCY(ISR_STAT_SYSTICK,
+                         (int32_t)(SysTick->CNT - SysTick->CMP) > 0 ? SysTick->CNT - SysTick->CMP : 0);
+  SysTick->SR = 0;
+  SysTick->CTLR &= ~SYSTICK_CTLR_SWIE;
+
+  uint32_t mstatus = Timer_Lock();
+  Timer_Sync();
+  uint32_t elapsed = millis - softtimer_ms;
+  if (softtimer_head != NULL) {
+    SoftTimer_Advance(elapsed);
+  }
+  if (tickhook_head != NULL) {
+    Timer_RunHooks(elapsed);
+  }
+  softtimer_ms = millis;
+  Timer_Reschedule();
+  Timer_Unlock(mstatus);
+#else
+  ISR_STAT_ENTER_LATENCY(ISR_STAT_SYSTICK, SysTick->CNT); // CNT เริ่มจาก 0 ที่ compare
   SysTick->SR = 0; // ล้าง interrupt flag
   millis++;        // เพิ่มค่า millis ทุกๆ 1ms
+  micros_base += 1000;
+  if (softtimer_head != NULL) {
+    SoftTimer_Advance(1); // O(1) ถ้าไม่มี timer หมดเวลาใน tick นี้
+  }
+  if (tickhook_head != NULL) {
+    Timer_RunHooks(1);
+  }
+#endif
+  ISR_STAT_EXIT(ISR_STAT_SYSTICK);
+}
+
+/*================= TICK HOOKS ==================*/
+
+/**
+ * @brief เลื่อน hooks ไป ms และเรียกตัวที่ถึงคาบ (เรียกจาก SysTick)
+ */
+static void Timer_RunHooks(uint32_t ms) {
+  for (Timer_TickHook_t *hook = tickhook_head; hook != NULL; hook = hook->next) {
+    if (hook->remaining > ms) {
+      hook->remaining -= ms;
+    } else {
+      hook->remaining = hook->interval;
+      hook->callback();
+    }
+  }
+}
+
+/**
+ * @brief ลงทะเบียน tick hook
+ */
+void Timer_AddTickHook(Timer_TickHook_t *hook, uint16_t interval_ms, void (*callback)(void)) {
+  if (hook == NULL || callback == NULL || interval_ms == 0) return;
+
+  Timer_EnsureInit();
+  Timer_RemoveTickHook(hook);
+
+  uint32_t mstatus = Timer_Lock();
+  hook->callback = callback;
+  hook->interval = interval_ms;
+  hook->remaining = interval_ms;
+#if SIMPLE_DELAY_TICKLESS
+  // remaining นับจาก softtimer_ms เหมือน SoftTimer (ค่าต่างไม่เกินคาบ wake สูงสุด)
+  Timer_Sync();
+  uint32_t lag = millis - softtimer_ms;
+  hook->remaining = (lag + interval_ms > 0xFFFF) ? 0xFFFF : (uint16_t)(lag + interval_ms);
+#endif
+  hook->next = tickhook_head;
+  tickhook_head = hook;
+#if SIMPLE_DELAY_TICKLESS
+  Timer_Reschedule();
+#endif
+  Timer_Unlock(mstatus);
+}
+
+/**
+ * @brief ยกเลิก tick hook
+ */
+void Timer_RemoveTickHook(Timer_TickHook_t *hook) {
+  if (hook == NULL) return;
+
+  uint32_t mstatus = Timer_Lock();
+  Timer_TickHook_t **link = &tickhook_head;
+  while (*link != NULL && *link != hook) {
+    link = &(*link)->next;
+  }
+  if (*link != NULL) {
+    *link = hook->next;
+  }
+  Timer_Unlock(mstatus);
 }
 
 /*================= BLOCKING DELAYS ==================*/
 
+#if SIMPLE_DELAY_SLEEP_MS
+#if SIMPLE_DELAY_TICKLESS
+static void Delay_WakeCallback(void *arg) {
+  (void)arg;
+}
+#endif
+
+/**
+ * @brief Delay_Ms() แบบหลับ: WFI จนครบ n ms นับจาก start
+ */
+static void Delay_SleepMs(uint32_t start, uint32_t n) {
+#if SIMPLE_DELAY_TICKLESS
+  // SysTick ไม่ตื่นทุก 1 ms: ให้ SoftTimer ปลุกตอนครบเวลา
+  SoftTimer_t wake = {0};
+  SoftTimer_Start(&wake, n, 0, Delay_WakeCallback, NULL);
+#endif
+
+  while (1) {
+    SimpleHAL_Idle();
+    Clock_GateIdle();  // เปิด IRQ เอง จึงเรียกก่อน lock
+
+    // ตรวจเวลากับ WFI ภายใต้ IRQ ปิด: SysTick ที่มาระหว่างนั้นยังปลุก WFI ได้
+    uint32_t mstatus = Timer_Lock();
+    if ((Get_CurrentMs() - start) >= n) {
+      Timer_Unlock(mstatus);
+      break;
+    }
+    PWR_EnterSleepMode(PWR_ENTRY_WFI);
+    Timer_Unlock(mstatus);
+  }
+
+#if SIMPLE_DELAY_TICKLESS
+  SoftTimer_Stop(&wake);
+#endif
+}
+#endif
+
 /**
  * @brief หน่วงเวลาแบบ blocking ในหน่วย microseconds
  *
@@ -73,7 +392,13 @@ void SysTick_Handler(void) {
  */
 void Delay_Us(uint32_t n) {
   if (n == 0) return;
-  
+
+  Timer_EnsureInit();
+  if (n < 1000000) {
+    Delay_CyclesRun(tick_per_us * n); // ไม่ต้องอ่าน Get_CurrentUs() ทุกรอบ
+    return;
+  }
+
   uint32_t start = Get_CurrentUs();
   // ใช้ unsigned arithmetic เพื่อจัดการ overflow อัตโนมัติ
   while ((Get_CurrentUs() - start) < n) {
@@ -94,9 +419,34 @@ void Delay_Ms(uint32_t n) {
   if (n == 0) return;
   
   uint32_t start = Get_CurrentMs();
+#if SIMPLE_DELAY_SLEEP_MS
+  if (n >= SIMPLE_DELAY_SLEEP_MS) {
+    Delay_SleepMs(start, n);
+    return;
+  }
+#endif
   // ใช้ unsigned arithmetic เพื่อจัดการ overflow อัตโนมัติ
   while ((Get_CurrentMs() - start) < n) {
-    // รอจนกว่าเวลาจะผ่านไป
+    SimpleHAL_Idle();
+  }
+}
+
+/**
+ * @brief ส่วน runtime ของ Delay_Cycles()
+ */
+void Delay_CyclesRun(uint32_t cycles) {
+  if (cycles <= SIMPLE_DELAY_CALL_OVERHEAD + SIMPLE_DELAY_LOOP_CYCLES) return;
+  cycles -= SIMPLE_DELAY_CALL_OVERHEAD;
+
+  if (cycles <= SIMPLE_DELAY_INLINE_MAX_CYCLES) {
+    Delay_Spin(cycles / SIMPLE_DELAY_LOOP_CYCLES);
+    return;
+  }
+
+  // ยาว: SysTick นับที่ HCLK (1 tick = 1 cycle) จึงไม่ยืดเมื่อถูก interrupt แทรก
+  Timer_Stopwatch_t sw;
+  Timer_StopwatchStart(&sw);  // Get_TicksPerMs() เริ่ม SysTick ให้
+  while (Timer_StopwatchRead(&sw) < cycles) {
   }
 }
 
@@ -110,7 +460,15 @@ void Delay_Ms(uint32_t n) {
  * @note ใช้สำหรับการวัดเวลาที่ละเอียดกว่า millisecond
  */
 uint32_t Get_TickMicros(void) {
-  return (SysTick->CNT * us_per_tick) / SysTick->CMP;
+  Timer_EnsureInit();
+#if SIMPLE_DELAY_TICKLESS
+  uint32_t mstatus = Timer_Lock();
+  uint32_t ticks = Timer_Sync();
+  Timer_Unlock(mstatus);
+#else
+  uint32_t ticks = SysTick->CNT;
+#endif
+  return (ticks * us_per_tick_q20) >> TICK_US_SHIFT;
 }
 
 /**
@@ -120,7 +478,18 @@ uint32_t Get_TickMicros(void) {
  *
  * @note ค่านี้จะ overflow ทุกๆ 49.7 วัน (2^32 ms)
  */
-uint32_t Get_CurrentMs(void) { return millis; }
+uint32_t Get_CurrentMs(void) {
+  Timer_EnsureInit();
+#if SIMPLE_DELAY_TICKLESS
+  uint32_t mstatus = Timer_Lock();
+  Timer_Sync();
+  uint32_t now = millis;
+  Timer_Unlock(mstatus);
+  return now;
+#else
+  return millis;
+#endif
+}
 
 /**
  * @brief อ่านค่าเวลาปัจจุบันในหน่วย microseconds
@@ -131,17 +500,84 @@ uint32_t Get_CurrentMs(void) { return millis; }
  *       ฟังก์ชันนี้ปิด interrupt ชั่วคราวเพื่อความแม่นยำ
  */
 uint32_t Get_CurrentUs(void) {
-  uint32_t current_millis;
-  uint32_t current_tick;
+  return (uint32_t)Get_CurrentUs64();
+}
+
+/**
+ * @brief อ่านค่าเวลาปัจจุบันในหน่วย microseconds แบบ 64-bit
+ *
+ * @return จำนวน microseconds นับตั้งแต่เริ่มต้นระบบ (ไม่ล้นในทางปฏิบัติ)
+ */
+uint64_t Get_CurrentUs64(void) {
+  Timer_EnsureInit();
+
+  uint32_t mstatus = Timer_Lock();
+  uint64_t now = Timer_ReadUs();
+  Timer_Unlock(mstatus);
+
+  return now;
+}
+
+/**
+ * @brief อ่านเวลาปัจจุบันเป็น millis + ticks ภายใน ms นั้น
+ */
+uint32_t Get_CurrentMsTicks(uint32_t *ticks) {
+  Timer_EnsureInit();
+
+  uint32_t mstatus = Timer_Lock();
+#if SIMPLE_DELAY_TICKLESS
+  uint32_t now_ticks = Timer_Sync();
+  uint32_t now_ms = millis;
+#else
+  uint32_t now_ms = millis;
+  uint32_t now_ticks = SysTick->CNT;
+
+  // เหมือน Timer_ReadUs(): ตัวนับรีเซ็ตแล้วแต่ SysTick_Handler ยังไม่ได้นับ ms นั้น
+  if (SysTick->SR & 1) {
+    now_ticks = SysTick->CNT;
+    now_ms++;
+  }
+#endif
+  Timer_Unlock(mstatus);
+
+  *ticks = now_ticks;
+  return now_ms;
+}
 
-  __disable_irq();             // ปิด interrupt ชั่วคราว
-  current_millis = millis;     // อ่านค่า millis
-  current_tick = SysTick->CNT; // อ่านค่าตัวนับ SysTick
-  __enable_irq();              // เปิด interrupt คืน
+/**
+ * @brief จำนวน SysTick ticks ต่อ 1 ms
+ */
+uint32_t Get_TicksPerMs(void) {
+  Timer_EnsureInit();
+  return tick_per_ms;
+}
 
-  uint32_t us_in_tick = (current_tick * us_per_tick) / SysTick->CMP;
+/**
+ * @brief เลื่อน timebase ไป ms (เวลาที่ SysTick หยุดนับ)
+ */
+void Timer_AdvanceMs(uint32_t ms) {
+  Timer_EnsureInit();
 
-  return (current_millis * 1000) + us_in_tick; // รวมค่า ms และ us
+  uint32_t mstatus = Timer_Lock();
+#if SIMPLE_DELAY_TICKLESS
+  Timer_Sync();
+#endif
+  millis += ms;
+  micros_base += (uint64_t)ms * 1000;
+#if SIMPLE_DELAY_TICKLESS
+  ms = millis - softtimer_ms;
+#endif
+  if (softtimer_head != NULL) {
+    SoftTimer_Advance(ms);
+  }
+  if (tickhook_head != NULL) {
+    Timer_RunHooks(ms);
+  }
+#if SIMPLE_DELAY_TICKLESS
+  softtimer_ms = millis;
+  Timer_Reschedule();
+#endif
+  Timer_Unlock(mstatus);
 }
 
 /*================= NON-BLOCKING TIMERS ==================*/
@@ -159,7 +595,7 @@ uint32_t Get_CurrentUs(void) {
  */
 void Start_Timer(Timer_t *timer, uint32_t ms, uint8_t repeat) {
   if (timer != NULL) {
-    timer->start_time = millis; // บันทึกเวลาปัจจุบัน
+    timer->start_time = Get_CurrentMs(); // บันทึกเวลาปัจจุบัน
     timer->duration = ms;       // ตั้งค่าระยะเวลา
     timer->active = 1;          // เปิดการทำงาน
     timer->repeat = repeat;     // ตั้งค่าการทำงานซ้ำ
@@ -174,7 +610,7 @@ void Start_Timer(Timer_t *timer, uint32_t ms, uint8_t repeat) {
  */
 void Reset_Timer(Timer_t *timer, uint8_t repeat) {
   if (timer != NULL) {
-    timer->start_time = millis; // รีเซ็ตเวลาเริ่มต้น
+    timer->start_time = Get_CurrentMs(); // รีเซ็ตเวลาเริ่มต้น
     timer->active = 1;          // เปิดการทำงาน
     timer->repeat = repeat;     // ตั้งค่าการทำงานซ้ำ
   }
@@ -196,9 +632,10 @@ uint8_t Is_Timer_Expired(Timer_t *timer) {
 
   // ตรวจสอบว่า timer ทำงานอยู่และเวลาที่ผ่านไปครบหรือยัง
   // ใช้ unsigned arithmetic เพื่อจัดการกับ overflow
-  if (timer->active && ((millis - timer->start_time) >= timer->duration)) {
+  uint32_t now = Get_CurrentMs();
+  if (timer->active && ((now - timer->start_time) >= timer->duration)) {
     if (timer->repeat) {
-      timer->start_time = millis; // รีเซ็ตเวลาถ้าเป็นแบบ repeat
+      timer->start_time = now; // รีเซ็ตเวลาถ้าเป็นแบบ repeat
     } else {
       timer->active = 0; // ปิดการทำงานถ้าไม่ repeat
     }
@@ -217,3 +654,189 @@ void Stop_Timer(Timer_t *timer) {
     timer->active = 0;
   }
 }
+
+/*================= SOFTWARE TIMER SERVICE ==================*/
+
+/**
+ * @brief แทรก timer ลง active list (ต้องถือ lock)
+ */
+static void SoftTimer_Insert(SoftTimer_t *timer, uint32_t ms) {
+  SoftTimer_t **link = &softtimer_head;
+
+  // ตัวที่หมดพร้อมกันเรียงตามลำดับที่ start (ใช้ <=)
+  while (*link != NULL && (*link)->delta <= ms) {
+    ms -= (*link)->delta;
+    link = &(*link)->next;
+  }
+
+  timer->delta = ms;
+  timer->next = *link;
+  if (*link != NULL) {
+    (*link)->delta -= ms;
+  }
+  *link = timer;
+  timer->active = 1;
+}
+
+/**
+ * @brief เอา timer ออกจาก active list (ต้องถือ lock)
+ */
+static void SoftTimer_Unlink(SoftTimer_t *timer) {
+  SoftTimer_t **link = &softtimer_head;
+
+  while (*link != NULL && *link != timer) {
+    link = &(*link)->next;
+  }
+  if (*link == NULL) return;
+
+  // เวลาที่เหลือของตัวนี้ส่งต่อให้ตัวถัดไป
+  if (timer->next != NULL) {
+    timer->next->delta += timer->delta;
+  }
+  *link = timer->next;
+  timer->active = 0;
+}
+
+/**
+ * @brief เลื่อน active list ไป ms (เรียกจาก SysTick, ต้องถือ lock)
+ *
+ * @note โหมด tick เรียกด้วย 1 ทุก ms: ลด delta ของตัวแรกเท่านั้น
+ */
+static void SoftTimer_Advance(uint32_t ms) {
+  SoftTimer_t *timer = softtimer_head;
+
+  while (timer != NULL) {
+    if (timer->delta > ms) {
+      timer->delta -= ms;
+      break;
+    }
+    ms -= timer->delta;
+    timer->delta = 0;
+
+    softtimer_head = timer->next;
+    timer->active = 0;
+
+    if (timer->period) {
+      SoftTimer_Insert(timer, timer->period);
+    }
+
+#if SIMPLE_SOFTTIMER_ISR_DISPATCH
+    timer->callback(timer->arg);
+#else
+    if (!timer->pending) {
+      timer->pending = 1;
+      timer->next_pending = NULL;
+      if (softtimer_pending_tail != NULL) {
+        softtimer_pending_tail->next_pending = timer;
+      } else {
+        softtimer_pending_head = timer;
+      }
+      softtimer_pending_tail = timer;
+    }
+#endif
+
+    timer = softtimer_head;
+  }
+}
+
+/**
+ * @brief เริ่ม software timer แบบ callback
+ */
+void SoftTimer_Start(SoftTimer_t *timer, uint32_t ms, uint32_t period_ms,
+                     SoftTimer_Callback callback, void *arg) {
+  if (timer == NULL || callback == NULL) return;
+
+  Timer_EnsureInit();
+
+  uint32_t mstatus = Timer_Lock();
+  if (timer->active) {
+    SoftTimer_Unlink(timer);
+  }
+  timer->callback = callback;
+  timer->arg = arg;
+  timer->period = period_ms;
+#if SIMPLE_DELAY_TICKLESS
+  // list นับจาก softtimer_ms: ชดเชยเวลาที่ millis เดินไปแล้ว
+  Timer_Sync();
+  SoftTimer_Insert(timer, ms + (millis - softtimer_ms));
+  Timer_Reschedule();
+#else
+  SoftTimer_Insert(timer, ms);
+#endif
+  Timer_Unlock(mstatus);
+}
+
+/**
+ * @brief หยุด software timer
+ */
+void SoftTimer_Stop(SoftTimer_t *timer) {
+  if (timer == NULL) return;
+
+  uint32_t mstatus = Timer_Lock();
+  if (timer->active) {
+    SoftTimer_Unlink(timer);
+  }
+
+  // ถอดออกจากคิวรอเรียก callback
+  if (timer->pending) {
+    SoftTimer_t **link = &softtimer_pending_head;
+    SoftTimer_t *prev = NULL;
+
+    while (*link != NULL && *link != timer) {
+      prev = *link;
+      link = &(*link)->next_pending;
+    }
+    if (*link == timer) {
+      *link = timer->next_pending;
+      if (softtimer_pending_tail == timer) {
+        softtimer_pending_tail = prev;
+      }
+    }
+    timer->pending = 0;
+  }
+  Timer_Unlock(mstatus);
+}
+
+/**
+ * @brief เรียก callback ของ timers ที่หมดเวลาแล้ว
+ */
+void SoftTimer_Run(void) {
+  while (softtimer_pending_head != NULL) {
+    uint32_t mstatus = Timer_Lock();
+    SoftTimer_t *timer = softtimer_pending_head;
+    if (timer == NULL) {
+      Timer_Unlock(mstatus);
+      break;
+    }
+    softtimer_pending_head = timer->next_pending;
+    if (softtimer_pending_head == NULL) {
+      softtimer_pending_tail = NULL;
+    }
+    timer->pending = 0;
+    Timer_Unlock(mstatus);
+
+    timer->callback(timer->arg);
+  }
+}
+
+/**
+ * @brief เวลาจนถึง timer ตัวถัดไปหมดเวลา
+ */
+uint32_t SoftTimer_NextDeadline(void) {
+  uint32_t result = 0xFFFFFFFFUL;
+
+  uint32_t mstatus = Timer_Lock();
+  if (softtimer_pending_head != NULL) {
+    result = 0;
+  } else if (softtimer_head != NULL) {
+    result = softtimer_head->delta;
+#if SIMPLE_DELAY_TICKLESS
+    Timer_Sync();
+    uint32_t lag = millis - softtimer_ms;
+    result = (result > lag) ? result - lag : 0;
+#endif
+  }
+  Timer_Unlock(mstatus);
+
+  return result;
+}
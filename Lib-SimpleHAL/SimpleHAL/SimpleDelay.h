@@ -1,15 +1,22 @@
 /********************************** (C) COPYRIGHT
  * ******************************* File Name          : SimpleDelay.h Author    :
- * Extracted from WCH debug.h Version            : V1.0.0 Date               :
- * 2025/12/21 Description        : Delay and Timing Library for CH32V003 Provides
+ * Extracted from WCH debug.h Version            : V1.8.0 Date               :
+ * 2026/10/14 Description        : Delay and Timing Library for CH32V003 Provides
  * both blocking and non-blocking timing functions
  *********************************************************************************
  * Features:
  * - SysTick-based timing (1ms resolution)
- * - Auto-initialization (no need to call Timer_Init)
+ * - Lazy initialization on first use (no need to call Timer_Init)
  * - Non-blocking timers with repeat support
+ * - Software timer service with callbacks (sorted delta list, O(1) per tick)
+ * - Tick hooks: other modules share the single SysTick interrupt
+ * - Optional tickless mode: SysTick free-runs, wakes only for the next deadline
  * - Blocking microsecond/millisecond delays
- * - High-precision time reading (millis/micros)
+ * - Optional sleeping Delay_Ms() (WFI between SysTick interrupts) and idle hook
+ * - Cycle-accurate short delays (Delay_Cycles/Delay_Ns)
+ * - High-precision time reading (millis/micros, 64-bit micros, no division)
+ * - Timebase compensation for time spent with SysTick stopped (standby)
+ * - Runtime clock changes keep millis/micros continuous (Timer_Retime)
  *******************************************************************************/
 #ifndef __SIMPLE_DELAY_H
 #define __SIMPLE_DELAY_H
@@ -20,6 +27,88 @@ extern "C" {
 
 #include <ch32v00x.h>
 #include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleInit.h"
+
+/*================= CONFIGURATION ==================*/
+
+/**
+ * @brief 1 = เริ่ม SysTick ก่อน main() ด้วย constructor (พฤติกรรมเดิม)
+ *        0 = เริ่ม SysTick เมื่อใช้งานครั้งแรก (default, boot เร็วกว่า)
+ */
+#ifndef SIMPLE_DELAY_AUTO_INIT
+#define SIMPLE_DELAY_AUTO_INIT 0
+#endif
+
+/**
+ * @brief 1 = เรียก callback ของ SoftTimer ใน SysTick interrupt ทันที
+ *        0 = ต่อคิวไว้ให้ SoftTimer_Run() เรียกใน main loop (default)
+ */
+#ifndef SIMPLE_SOFTTIMER_ISR_DISPATCH
+#define SIMPLE_SOFTTIMER_ISR_DISPATCH 0
+#endif
+
+/**
+ * @brief 1 = Tickless: SysTick นับอิสระ ms/us คำนวณจากตัวนับ และตั้ง compare
+ *            ไว้ที่ deadline ของ SoftTimer ตัวถัดไปเท่านั้น
+ *        0 = interrupt ทุก 1 ms (default)
+ *
+ * @details ไม่มี SoftTimer ทำงาน SysTick ตื่นแค่ทุก ~22 วินาที (ที่ 48 MHz)
+ * เพื่อ sync ก่อนตัวนับล้น แทน 1000 ครั้งต่อวินาที ทำให้ WFI หลับได้นาน
+ *
+ * @note ตัวแปร millis ถูกเลื่อนเมื่อเรียกฟังก์ชันอ่านเวลาหรือเมื่อ SysTick ตื่น
+ *       เท่านั้น ให้ใช้ Get_CurrentMs() แทนการอ่าน millis ตรงๆ
+ * @note Module ใน SimpleHAL อ่านเวลาละเอียดผ่าน Get_CurrentMsTicks() จึงใช้ได้ทั้งสองโหมด
+ *       โค้ดของผู้ใช้ห้ามถือว่า SysTick->CNT รีเซ็ตทุก 1 ms
+ * @note การอ่านเวลาเลื่อน millis ด้วยการลบ (หารเฉพาะหลัง sleep นานกว่า 4 ms)
+ */
+#ifndef SIMPLE_DELAY_TICKLESS
+#define SIMPLE_DELAY_TICKLESS 0
+#endif
+
+/**
+ * @brief ความถี่ CPU ตอน compile สำหรับแปลง Delay_Ns() (ต้องตรงกับ SystemCoreClock)
+ */
+#ifndef SIMPLE_DELAY_F_CPU
+#define SIMPLE_DELAY_F_CPU 48000000UL
+#endif
+
+/**
+ * @brief CPU cycles ต่อรอบของ delay loop (addi + bnez, 2-4)
+ */
+#ifndef SIMPLE_DELAY_LOOP_CYCLES
+#define SIMPLE_DELAY_LOOP_CYCLES 4
+#endif
+
+/**
+ * @brief Cycles ของการเรียก Delay_CyclesRun() (call, ตรวจค่า, return) ที่หักออก
+ */
+#ifndef SIMPLE_DELAY_CALL_OVERHEAD
+#define SIMPLE_DELAY_CALL_OVERHEAD 12
+#endif
+
+/**
+ * @brief Delay ที่ยาวกว่านี้ (cycles) เทียบกับ SysTick แทน loop
+ *        ค่าคงที่ไม่เกินนี้ compile เป็น loop inline
+ */
+#ifndef SIMPLE_DELAY_INLINE_MAX_CYCLES
+#define SIMPLE_DELAY_INLINE_MAX_CYCLES 1024
+#endif
+
+/**
+ * @brief Delay_Ms() ที่ยาวตั้งแต่ค่านี้ (ms) หลับ (WFI แบบ PWR_Sleep()) ระหว่าง interrupts
+ *        0 = spin ตลอด (default)
+ *
+ * @details CPU ตื่นทุก SysTick ตรวจเวลาแล้วหลับต่อ กินกระแสแบบ sleep mode
+ * แทน run mode ตลอด delay โค้ดเดิมที่เรียก Delay_Ms() ไม่ต้องแก้
+ *
+ * @note ต้อง link SimplePWR และ SimpleClock (clock ที่ไม่มีผู้ใช้ถูกปิดก่อนหลับ)
+ * @note Peripherals และ interrupts ทำงานตามปกติระหว่าง delay (sleep ไม่ใช่ standby)
+ * @note โหมด tickless: ตั้ง SoftTimer ปลุกตอนครบเวลาให้เอง
+ */
+#ifndef SIMPLE_DELAY_SLEEP_MS
+#define SIMPLE_DELAY_SLEEP_MS 0
+#endif
 
 /*================= TIMER STRUCTURE ==================*/
 
@@ -38,6 +127,71 @@ typedef struct {
   uint8_t repeat;
 } Timer_t;
 
+/**
+ * @brief Callback ของ SoftTimer
+ * @param arg ค่าที่ส่งให้ตอน SoftTimer_Start()
+ */
+typedef void (*SoftTimer_Callback)(void *arg);
+
+/**
+ * @brief Software timer แบบ callback (ผู้ใช้จองไว้ ห้ามแก้ field เอง)
+ *
+ * @details Timers ที่ทำงานอยู่ต่อกันเป็น list เรียงตามเวลาหมด
+ * แต่ละตัวเก็บ delta (ms) จากตัวก่อนหน้า SysTick จึงลดแค่ตัวแรก
+ */
+typedef struct SoftTimer {
+  struct SoftTimer *next;         /**< ตัวถัดไปใน active list */
+  struct SoftTimer *next_pending; /**< ตัวถัดไปในคิวรอเรียก callback */
+  uint32_t delta;                 /**< ms หลังตัวก่อนหน้าใน list */
+  uint32_t period;                /**< คาบ (ms), 0 = ครั้งเดียว */
+  SoftTimer_Callback callback;
+  void *arg;
+  volatile uint8_t active;        /**< อยู่ใน active list */
+  volatile uint8_t pending;       /**< รอเรียก callback */
+} SoftTimer_t;
+
+/**
+ * @brief Hook ที่ SysTick เรียกทุก interval ms (ผู้ใช้จองไว้ ห้ามแก้ field เอง)
+ *
+ * @details Module ที่ต้องการ tick ของตัวเอง (debounce, sampling, scheduler)
+ * ลงทะเบียนที่นี่แทนการใช้ timer interrupt แยก ทุกตัวจึงใช้ SysTick
+ * interrupt เดียวกัน (และตื่นพร้อมกันในโหมด tickless)
+ */
+typedef struct Timer_TickHook {
+  struct Timer_TickHook *next;
+  void (*callback)(void);
+  uint16_t interval;   /**< ms ระหว่างการเรียก */
+  uint16_t remaining;  /**< ms จนถึงครั้งถัดไป */
+} Timer_TickHook_t;
+
+/*================= IDLE HOOK ==================*/
+
+/**
+ * @brief Hook ที่ blocking waits ของ SimpleHAL เรียกทุกรอบที่รอ (NULL = ไม่มี)
+ *
+ * @details Delay_Ms(), DMA_WaitComplete()/DMA_WaitAllSleep() และ TM_Run() ของ
+ * SimpleTask (TM_TIMEBASE_SIMPLEHAL = 1) เรียกผ่าน SimpleHAL_Idle()
+ * ใช้ feed watchdog, poll งานสั้นๆ หรือหลับแบบกำหนดเองใน legacy code
+ *
+ * @note ถูกเรียกถี่ (ทุกรอบที่ spin หรือทุกครั้งที่ตื่น) ต้องสั้นและห้ามเรียก Delay_Ms()
+ * @note ถ้า hook หลับเอง (WFI) ต้องมี interrupt ปลุกแน่นอน: โหมด tickless SysTick ไม่ตื่นทุก 1 ms
+ *
+ * @example
+ * static void feed(void) { IWDG_ReloadCounter(); }
+ * SimpleHAL_IdleHook = feed;
+ */
+extern void (*volatile SimpleHAL_IdleHook)(void);
+
+/**
+ * @brief เรียก SimpleHAL_IdleHook ถ้ามี (สำหรับ loop รอของ module อื่น)
+ */
+static inline void SimpleHAL_Idle(void) {
+  void (*hook)(void) = SimpleHAL_IdleHook;
+  if (hook) {
+    hook();
+  }
+}
+
 /*================= INITIALIZATION ==================*/
 
 /**
@@ -46,10 +200,52 @@ typedef struct {
  * ฟังก์ชันนี้จะตั้งค่า SysTick ให้ทำงานที่ความถี่ 1ms และเปิดใช้งาน interrupt
  * ต้องเรียกใช้ฟังก์ชันนี้ก่อนใช้งานฟังก์ชัน timer อื่นๆ
  *
- * @note ควรเรียกใช้ในตอนต้นของ main() หรือ boot sequence
+ * @note ไม่จำเป็นต้องเรียก: ทุกฟังก์ชันเวลาจะ init ให้เองเมื่อใช้ครั้งแรก
+ * @note เรียกตรงๆ เพื่อเริ่ม millis ตั้งแต่จุดที่ต้องการ หรือ init ใหม่หลังเปลี่ยน clock
  */
 void Timer_Init(void);
 
+/**
+ * @brief ปรับ SysTick ให้ตรงกับ SystemCoreClock ใหม่โดย millis/micros ไม่กระโดด
+ *
+ * @note เรียกโดย SimpleHAL_SetSysClock() (SimpleSysClock) ไม่ต้องเรียกเอง
+ * @note ไม่มีผลถ้า SysTick ยังไม่ถูกเริ่ม
+ */
+void Timer_Retime(void);
+
+/**
+ * @brief เริ่ม SysTick ถ้ายังไม่ได้เริ่ม (fast path: load + branch)
+ *
+ * @note ใช้ใน module ที่อ่าน SysTick หรือ millis โดยตรง
+ */
+static inline void Timer_EnsureInit(void) {
+  SimpleInit_Ensure(SIMPLE_INIT_DELAY, Timer_Init);
+}
+
+/*================= TICK HOOKS ==================*/
+
+/**
+ * @brief ลงทะเบียน callback ให้ SysTick เรียกทุก interval_ms
+ *
+ * @param hook struct ที่ผู้เรียกจองไว้ (ต้องอยู่ตลอดการใช้งาน)
+ * @param interval_ms คาบ (1-65535 ms)
+ * @param callback ถูกเรียกใน SysTick interrupt (ต้องสั้น)
+ *
+ * @note เรียกซ้ำกับ hook เดิมเพื่อเปลี่ยนคาบได้
+ * @note โหมด tickless: SysTick ตื่นตาม hook ที่ใกล้ที่สุด ถ้าพลาดหลายคาบ
+ *       (เช่นปิด interrupt นาน) callback ถูกเรียกครั้งเดียว
+ *
+ * @example
+ * static Timer_TickHook_t scan_hook;
+ * Timer_AddTickHook(&scan_hook, 5, keypad_scan);   // ทุก 5 ms
+ */
+void Timer_AddTickHook(Timer_TickHook_t *hook, uint16_t interval_ms, void (*callback)(void));
+
+/**
+ * @brief ยกเลิก tick hook
+ */
+void Timer_RemoveTickHook(Timer_TickHook_t *hook);
+
 /*================= NON-BLOCKING TIMERS ==================*/
 
 /**
@@ -91,6 +287,68 @@ uint8_t Is_Timer_Expired(Timer_t *timer);
  */
 void Stop_Timer(Timer_t *timer);
 
+/*================= SOFTWARE TIMER SERVICE ==================*/
+
+/**
+ * @brief เริ่ม software timer แบบ callback
+ *
+ * @param timer timer object (ต้องอยู่ตลอดการทำงาน เช่น static)
+ * @param ms เวลาจนถึงครั้งแรก (milliseconds)
+ * @param period_ms คาบของครั้งถัดไป (0 = ครั้งเดียว)
+ * @param callback ฟังก์ชันที่เรียกเมื่อหมดเวลา
+ * @param arg ค่าที่ส่งให้ callback
+ *
+ * @note เรียกซ้ำกับ timer ที่ทำงานอยู่ = เริ่มนับใหม่
+ * @note ใช้เวลา O(n) ตาม timers ที่ทำงานอยู่ (แทรกตามลำดับ) แต่ SysTick เป็น O(1)
+ * @note Periodic timer ถูกต่อคิวครั้งถัดไปตอนหมดเวลาใน interrupt จึงไม่ดริฟต์
+ *       แม้ SoftTimer_Run() จะถูกเรียกช้า
+ *
+ * @example
+ * static SoftTimer_t blink;
+ * void on_blink(void *arg) { digitalToggle(PD4); }
+ *
+ * SoftTimer_Start(&blink, 500, 500, on_blink, NULL);
+ * while (1) {
+ *   SoftTimer_Run();
+ * }
+ */
+void SoftTimer_Start(SoftTimer_t *timer, uint32_t ms, uint32_t period_ms,
+                     SoftTimer_Callback callback, void *arg);
+
+/**
+ * @brief หยุด software timer (ยกเลิก callback ที่รออยู่ด้วย)
+ *
+ * @param timer timer object
+ */
+void SoftTimer_Stop(SoftTimer_t *timer);
+
+/**
+ * @brief ตรวจสอบว่า timer ยังทำงานอยู่หรือไม่
+ *
+ * @return 1 = รอหมดเวลาหรือรอเรียก callback
+ */
+static inline uint8_t SoftTimer_IsActive(const SoftTimer_t *timer) {
+  return (timer->active || timer->pending) ? 1 : 0;
+}
+
+/**
+ * @brief เรียก callback ของ timers ที่หมดเวลาแล้ว (เรียกใน main loop)
+ *
+ * @note ไม่มีอะไรรอ: ตรวจ pointer เดียวแล้ว return
+ * @note ไม่จำเป็นเมื่อ SIMPLE_SOFTTIMER_ISR_DISPATCH = 1
+ */
+void SoftTimer_Run(void);
+
+/**
+ * @brief เวลาจนถึง timer ตัวถัดไปหมดเวลา
+ *
+ * @return milliseconds (0 = มี callback รออยู่, 0xFFFFFFFF = ไม่มี timer)
+ *
+ * @note ใช้กำหนดเวลา sleep ของ idle loop ให้ตื่นตรงเวลา
+ * @note โหมด tickless: SysTick ตื่นเองตอน deadline นี้ จึงเรียก WFI ได้เลย
+ */
+uint32_t SoftTimer_NextDeadline(void);
+
 /*================= BLOCKING DELAYS ==================*/
 
 /**
@@ -99,6 +357,7 @@ void Stop_Timer(Timer_t *timer);
  * @param n จำนวน microseconds ที่ต้องการหน่วง
  *
  * @warning ฟังก์ชันนี้จะบล็อกการทำงานของโปรแกรม
+ * @note ต่ำกว่า 1 วินาทีนับ CPU cycles ผ่าน Delay_CyclesRun() (1-3 us แม่นยำ)
  * @note ใช้ SysTick timer สำหรับความแม่นยำสูง (ความละเอียด ~1us)
  *       รองรับ overflow อัตโนมัติด้วย unsigned arithmetic
  *       ไม่ขึ้นกับ compiler optimization
@@ -114,9 +373,84 @@ void Delay_Us(uint32_t n);
  * @note ใช้ SysTick timer สำหรับความแม่นยำสูง (ความละเอียด 1ms)
  *       รองรับ overflow อัตโนมัติด้วย unsigned arithmetic
  *       ไม่ขึ้นกับ compiler optimization
+ * @note เรียก SimpleHAL_IdleHook ระหว่างรอ และหลับ (WFI) เมื่อ n >= SIMPLE_DELAY_SLEEP_MS
  */
 void Delay_Ms(uint32_t n);
 
+/*================= CYCLE DELAYS ==================*/
+
+/**
+ * @brief Cycles ต่อ ns แบบ Q16 สำหรับ Delay_Ns() ที่ค่าไม่คงที่ (ปัดขึ้น)
+ */
+#define SIMPLE_DELAY_NS_CYCLES_Q16                                             \
+  ((uint32_t)(((uint64_t)SIMPLE_DELAY_F_CPU * 65536ULL + 999999999ULL) /       \
+              1000000000ULL))
+
+/**
+ * @brief Delay loop: SIMPLE_DELAY_LOOP_CYCLES ต่อรอบ (loops ต้องมากกว่า 0)
+ */
+static inline __attribute__((always_inline)) void Delay_Spin(uint32_t loops) {
+  __asm volatile("1: addi %0, %0, -1\n\tbnez %0, 1b" : "+r"(loops));
+}
+
+/**
+ * @brief ส่วน runtime ของ Delay_Cycles() (ค่าไม่คงที่หรือยาว)
+ *
+ * @param cycles จำนวน CPU cycles (รวม call overhead แล้ว)
+ *
+ * @note สั้น: delay loop, ยาว: เทียบกับ SysTick->CNT (ไม่ยืดเมื่อถูก interrupt แทรก)
+ */
+void Delay_CyclesRun(uint32_t cycles);
+
+/**
+ * @brief หน่วงเวลาเป็นจำนวน CPU cycles
+ *
+ * @param cycles จำนวน CPU cycles
+ *
+ * @note ค่าคงที่ (≤ SIMPLE_DELAY_INLINE_MAX_CYCLES) compile เป็น li + loop + nop
+ *       ไม่มี function call คลาดไม่เกิน 1-2 cycles (ไม่นับ interrupt)
+ * @note ค่าไม่คงที่เรียก Delay_CyclesRun() ซึ่งหัก SIMPLE_DELAY_CALL_OVERHEAD ให้
+ * @warning ใน bit-bang ที่ต้องตรงเวลา ปิด interrupt ระหว่าง delay
+ *
+ * @example
+ * digitalWriteFast(PC1, LOW);
+ * Delay_Cycles(24);           // 0.5 us ที่ 48 MHz
+ * digitalWriteFast(PC1, HIGH);
+ */
+static inline __attribute__((always_inline)) void Delay_Cycles(uint32_t cycles) {
+  if (__builtin_constant_p(cycles) &&
+      cycles <= SIMPLE_DELAY_INLINE_MAX_CYCLES) {
+    // li ใช้ 1 cycle ที่เหลือเป็น loop และเศษเติมด้วย nop
+    if (cycles > SIMPLE_DELAY_LOOP_CYCLES) {
+      Delay_Spin((cycles - 1) / SIMPLE_DELAY_LOOP_CYCLES);
+      cycles = (cycles - 1) % SIMPLE_DELAY_LOOP_CYCLES;
+    }
+    if (cycles >= 1) __asm volatile("nop");
+    if (cycles >= 2) __asm volatile("nop");
+    if (cycles >= 3) __asm volatile("nop");
+    if (cycles >= 4) __asm volatile("nop");
+  } else {
+    Delay_CyclesRun(cycles);
+  }
+}
+
+/**
+ * @brief หน่วงเวลาในหน่วย nanoseconds (ปัดขึ้นเป็น cycles)
+ *
+ * @param ns จำนวน nanoseconds (ค่าไม่คงที่ต้องน้อยกว่า ~1.3 ms)
+ *
+ * @note ค่าคงที่แปลงตอน compile ด้วย SIMPLE_DELAY_F_CPU (ไม่มีการคูณหาร runtime)
+ * @note ความละเอียด 1 cycle (~21 ns ที่ 48 MHz)
+ */
+static inline __attribute__((always_inline)) void Delay_Ns(uint32_t ns) {
+  if (__builtin_constant_p(ns)) {
+    Delay_Cycles((uint32_t)(((uint64_t)ns * SIMPLE_DELAY_F_CPU + 999999999ULL) /
+                            1000000000ULL));
+  } else {
+    Delay_Cycles((ns * SIMPLE_DELAY_NS_CYCLES_Q16) >> 16);
+  }
+}
+
 /*================= TIME READING ==================*/
 
 /**
@@ -125,6 +459,7 @@ void Delay_Ms(uint32_t n);
  * @return ค่า microseconds ในช่วง 0-999 us ของ tick ปัจจุบัน
  *
  * @note ใช้สำหรับการวัดเวลาที่ละเอียดกว่า millisecond
+ * @note คูณด้วย reciprocal ที่คำนวณไว้ตอน Timer_Init() (ไม่มีการหาร)
  */
 uint32_t Get_TickMicros(void);
 
@@ -143,11 +478,105 @@ uint32_t Get_CurrentMs(void);
  *
  * @return จำนวน microseconds นับตั้งแต่เริ่มต้นระบบ
  *
- * @note ค่านี้จะ overflow ทุกๆ 71.6 นาที (2^32 us)
+ * @note ค่านี้จะ overflow ทุกๆ 71.6 นาที (2^32 us) ใช้ Get_CurrentUs64() ถ้าต้องการช่วงยาว
  *       ฟังก์ชันนี้ปิด interrupt ชั่วคราวเพื่อความแม่นยำ
  */
 uint32_t Get_CurrentUs(void);
 
+/**
+ * @brief อ่านค่าเวลาปัจจุบันในหน่วย microseconds แบบ 64-bit
+ *
+ * @return จำนวน microseconds นับตั้งแต่เริ่มต้นระบบ (ไม่ล้นในทางปฏิบัติ)
+ *
+ * @note ไม่มีการหาร: ISR บวก 1000 ให้ฐาน 64-bit ทุก ms แล้วเศษใน ms
+ *       คำนวณด้วย (ticks × reciprocal) >> 20 (ปัดลง คลาดน้อยกว่า 1 us)
+ * @note อ่านแบบ atomic และไม่ถอยหลังที่ขอบ ms แม้เรียกขณะ SysTick interrupt
+ *       ค้างอยู่ (เช่นใน ISR อื่น)
+ */
+uint64_t Get_CurrentUs64(void);
+
+/**
+ * @brief อ่านเวลาปัจจุบันเป็น millis + SysTick ticks ภายใน ms นั้น
+ *
+ * @param ticks [out] ticks (CPU cycles ที่ HCLK) นับจากขอบ ms, น้อยกว่า Get_TicksPerMs()
+ * @return จำนวน milliseconds นับตั้งแต่เริ่มต้นระบบ
+ *
+ * @note ใช้ได้ทั้งโหมด 1 ms และ tickless: module ที่ต้องการ timestamp ละเอียด
+ *       ต้องใช้ฟังก์ชันนี้แทนการอ่าน SysTick->CNT/CMP ตรงๆ
+ * @note ไม่มีการหาร เรียกจาก ISR ได้ และนับ ms ที่ SysTick interrupt ยังค้างอยู่ให้เอง
+ *
+ * @example
+ * uint32_t t0, t1;
+ * uint32_t ms0 = Get_CurrentMsTicks(&t0);
+ * // ...
+ * uint32_t ms1 = Get_CurrentMsTicks(&t1);
+ * uint32_t cycles = (ms1 - ms0) * Get_TicksPerMs() + t1 - t0;
+ */
+uint32_t Get_CurrentMsTicks(uint32_t *ticks);
+
+/**
+ * @brief จำนวน SysTick ticks ต่อ 1 ms (= SystemCoreClock / 1000)
+ */
+uint32_t Get_TicksPerMs(void);
+
+/**
+ * @brief ตัวจับเวลาแบบ poll ที่นับ SysTick ticks ต่อเนื่องแม้ปิด interrupt นานหลาย ms
+ */
+typedef struct {
+  uint32_t elapsed;  /**< ticks สะสมตั้งแต่ Timer_StopwatchStart() */
+  uint32_t prev;     /**< SysTick->CNT ที่อ่านล่าสุด */
+  uint32_t reload;   /**< ticks ต่อ ms (โหมด 1 ms) */
+} Timer_Stopwatch_t;
+
+/**
+ * @brief เริ่มจับเวลา
+ *
+ * @example
+ * Timer_Stopwatch_t sw;
+ * Timer_StopwatchStart(&sw);
+ * __disable_irq();
+ * while (!done()) {
+ *     if (Timer_StopwatchRead(&sw) > 5 * Get_TicksPerMs()) break;  // 5 ms
+ * }
+ * __enable_irq();
+ */
+static inline void Timer_StopwatchStart(Timer_Stopwatch_t *sw) {
+  sw->reload = Get_TicksPerMs();
+  sw->elapsed = 0;
+  sw->prev = SysTick->CNT;
+}
+
+/**
+ * @brief อ่าน ticks (CPU cycles) ตั้งแต่ Timer_StopwatchStart()
+ *
+ * @note โหมด 1 ms ต้องเรียกถี่กว่าทุก 1 ms จึงนับการ reload ของตัวนับได้ครบ
+ *       (ไม่พึ่ง SysTick_Handler จึงใช้ขณะปิด interrupt ได้) โหมด tickless ไม่มีข้อจำกัดนี้
+ */
+static inline uint32_t Timer_StopwatchRead(Timer_Stopwatch_t *sw) {
+  uint32_t now = SysTick->CNT;
+#if !SIMPLE_DELAY_TICKLESS
+  if (now < sw->prev) {
+    sw->elapsed += sw->reload; // ตัวนับ reload ทุก 1 ms
+  }
+#endif
+  sw->elapsed += now - sw->prev;
+  sw->prev = now;
+  return sw->elapsed;
+}
+
+/**
+ * @brief เลื่อน millis/micros ไปข้างหน้า ms (ชดเชยเวลาที่ SysTick หยุดนับ)
+ *
+ * @param ms เวลาที่ผ่านไปจริงขณะ SysTick หยุด
+ *
+ * @details SoftTimers และ tick hooks เลื่อนไปพร้อมกัน: ตัวที่ครบกำหนดระหว่างนั้น
+ * ถูกเรียกครั้งเดียว (เหมือนพลาดหลาย tick ในโหมด tickless)
+ *
+ * @note ใช้หลังตื่นจาก standby (PWR_StandbyTimed() เรียกให้เอง)
+ * @note ห้ามใช้ชดเชยเวลาที่ SysTick ยังเดินอยู่: millis จะนับซ้ำ
+ */
+void Timer_AdvanceMs(uint32_t ms);
+
 /*================= HELPER MACROS ==================*/
 
 /**
@@ -0,0 +1,252 @@
+/**
+ * @file SimpleEnergy.c
+ * @brief Runtime Energy Accounting Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleEnergy.h"
+#include "SimpleDelay.h"
+#include "SimpleFormat.h"
+#include <string.h>
+
+/* ========== Private Definitions ========== */
+
+// µA·µs ต่อ 1 nAh (3600 s × 10^6 µs / 1000)
+#define ENERGY_UAUS_PER_NAH 3600000ULL
+
+/* ========== Private Variables ========== */
+
+static const char* const energy_state_names[PWR_STATE_COUNT] = {
+    "run", "sleep", "standby"
+};
+
+static const uint16_t energy_state_ua[PWR_STATE_COUNT] = {
+    SIMPLE_ENERGY_RUN_UA, SIMPLE_ENERGY_SLEEP_UA, SIMPLE_ENERGY_STANDBY_UA
+};
+
+static const char* const energy_periph_names[CLOCK_PERIPH_COUNT] = {
+    "GPIOA", "GPIOC", "GPIOD", "AFIO", "ADC1", "TIM1", "SPI1",
+    "USART1", "TIM2", "WWDG", "I2C1", "PWR", "DMA1"
+};
+
+// ค่าประมาณที่ 48 MHz (application แทนได้ด้วย array ที่ไม่ weak)
+const uint16_t energy_periph_ua[CLOCK_PERIPH_COUNT] __attribute__((weak)) = {
+    20,   // GPIOA
+    20,   // GPIOC
+    20,   // GPIOD
+    10,   // AFIO
+    500,  // ADC1 (รวม analog)
+    150,  // TIM1
+    60,   // SPI1
+    80,   // USART1
+    100,  // TIM2
+    10,   // WWDG
+    60,   // I2C1
+    10,   // PWR
+    50    // DMA1
+};
+
+static uint64_t energy_state_us[PWR_STATE_COUNT];
+static uint32_t energy_periph_ms[CLOCK_PERIPH_COUNT];
+static uint64_t energy_last_us = 0;
+static uint32_t energy_last_ms = 0;
+static uint8_t energy_state = PWR_STATE_RUN;
+static volatile uint8_t energy_running = 0;
+
+// ตัวนับเวลา (SimpleHAL_RamReport())
+const uint16_t energy_ram_bytes = sizeof(energy_state_us) + sizeof(energy_periph_ms);
+
+/* ========== Private Functions ========== */
+
+static inline uint32_t Energy_Lock(void) {
+    uint32_t mstatus;
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+    return mstatus;
+}
+
+static inline void Energy_Unlock(uint32_t mstatus) {
+    if (mstatus & 0x8) {
+        __asm volatile ("csrsi mstatus, 0x8");
+    }
+}
+
+/**
+ * @brief เพิ่มเวลาตั้งแต่ครั้งก่อนให้ state และ peripherals ที่ clock เปิดอยู่ (ต้องถือ lock)
+ */
+static void Energy_Account(void) {
+    uint64_t now_us = Get_CurrentUs64();
+    uint32_t now_ms = Get_CurrentMs();
+
+    energy_state_us[energy_state] += now_us - energy_last_us;
+    energy_last_us = now_us;
+
+    uint32_t ms = now_ms - energy_last_ms;
+    energy_last_ms = now_ms;
+
+    // Standby: clock ของ peripherals หยุดทั้งหมด
+    if (ms == 0 || energy_state == PWR_STATE_STANDBY) return;
+
+    uint16_t mask = Clock_GetEnabledMask();
+    for (uint8_t i = 0; mask; i++, mask >>= 1) {
+        if (mask & 1) {
+            energy_periph_ms[i] += ms;
+        }
+    }
+}
+
+/**
+ * @brief รวมประจุทุกรายการ (µA·µs) และรายงานผ่าน callback
+ * @param total_us เวลารวมทุก state (NULL = ไม่ต้องการ)
+ */
+static uint64_t Energy_Collect(Energy_Callback callback, uint64_t* total_us) {
+    uint64_t charge_total = 0;
+    uint64_t time_total = 0;
+
+    Energy_Update();
+
+    for (uint8_t i = 0; i < PWR_STATE_COUNT; i++) {
+        uint32_t mstatus = Energy_Lock();
+        uint64_t us = energy_state_us[i];
+        Energy_Unlock(mstatus);
+
+        uint64_t charge = us * energy_state_ua[i];
+        charge_total += charge;
+        time_total += us;
+        if (callback && us) {
+            callback(energy_state_names[i], (uint32_t)(us / 1000),
+                     (uint32_t)(charge / ENERGY_UAUS_PER_NAH));
+        }
+    }
+
+    for (uint8_t i = 0; i < CLOCK_PERIPH_COUNT; i++) {
+        uint32_t ms = energy_periph_ms[i];  // 32-bit: อ่านครั้งเดียว atomic
+
+        uint64_t charge = (uint64_t)ms * 1000 * energy_periph_ua[i];
+        charge_total += charge;
+        if (callback && ms) {
+            callback(energy_periph_names[i], ms, (uint32_t)(charge / ENERGY_UAUS_PER_NAH));
+        }
+    }
+
+    if (total_us) {
+        *total_us = time_total;
+    }
+    return charge_total;
+}
+
+/**
+ * @brief ต่อข้อความ + ตัวเลข + หน่วยลง buffer
+ */
+static uint8_t Energy_AppendField(char* line, uint8_t len, uint32_t value, const char* unit) {
+    line[len++] = ' ';
+    len += Format_UInt(&line[len], value);
+    uint8_t n = (uint8_t)strlen(unit);
+    memcpy(&line[len], unit, n);
+    return len + n;
+}
+
+static Printf_Output energy_output = NULL;
+
+static void Energy_PrintLine(const char* name, uint32_t ms, uint32_t nah) {
+    char line[48];
+    uint8_t len = (uint8_t)strlen(name);
+
+    memcpy(line, name, len);
+    len = Energy_AppendField(line, len, ms, " ms");
+    len = Energy_AppendField(line, len, nah, " nAh\r\n");
+    energy_output(line, len);
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief ล้างตัวนับและเริ่มนับ
+ */
+void Energy_Start(void) {
+    Timer_EnsureInit();
+
+    uint32_t mstatus = Energy_Lock();
+    memset(energy_state_us, 0, sizeof(energy_state_us));
+    memset(energy_periph_ms, 0, sizeof(energy_periph_ms));
+    energy_last_us = Get_CurrentUs64();
+    energy_last_ms = Get_CurrentMs();
+    energy_state = PWR_STATE_RUN;
+    energy_running = 1;
+    Energy_Unlock(mstatus);
+}
+
+/**
+ * @brief หยุดนับ
+ */
+void Energy_Stop(void) {
+    uint32_t mstatus = Energy_Lock();
+    if (energy_running) {
+        Energy_Account();
+        energy_running = 0;
+    }
+    Energy_Unlock(mstatus);
+}
+
+/**
+ * @brief ปิดบัญชีเวลาถึงตอนนี้
+ */
+void Energy_Update(void) {
+    if (!energy_running) return;
+
+    uint32_t mstatus = Energy_Lock();
+    if (energy_running) {
+        Energy_Account();
+    }
+    Energy_Unlock(mstatus);
+}
+
+/**
+ * @brief เปลี่ยน power state
+ */
+void Energy_SetState(uint8_t state) {
+    if (!energy_running || state >= PWR_STATE_COUNT) return;
+
+    uint32_t mstatus = Energy_Lock();
+    if (energy_running) {
+        Energy_Account();
+        energy_state = state;
+    }
+    Energy_Unlock(mstatus);
+}
+
+/**
+ * @brief รายงานเวลาและประจุ
+ */
+uint32_t Energy_Report(Energy_Callback callback) {
+    return (uint32_t)(Energy_Collect(callback, NULL) / ENERGY_UAUS_PER_NAH);
+}
+
+/**
+ * @brief กระแสเฉลี่ยตั้งแต่ Energy_Start()
+ */
+uint32_t Energy_GetAverageUA(void) {
+    uint64_t total_us;
+    uint64_t charge = Energy_Collect(NULL, &total_us);
+
+    return total_us ? (uint32_t)(charge / total_us) : 0;
+}
+
+/**
+ * @brief ส่งรายงานเป็นข้อความ
+ */
+void Energy_Print(Printf_Output output) {
+    if (!output) return;
+
+    uint64_t total_us;
+    energy_output = output;
+    uint64_t charge = Energy_Collect(Energy_PrintLine, &total_us);
+
+    char line[64];
+    uint8_t len = 5;
+    memcpy(line, "total", len);
+    len = Energy_AppendField(line, len, (uint32_t)(total_us / 1000), " ms");
+    len = Energy_AppendField(line, len, (uint32_t)(charge / ENERGY_UAUS_PER_NAH), " nAh avg");
+    len = Energy_AppendField(line, len, total_us ? (uint32_t)(charge / total_us) : 0, " uA\r\n");
+    output(line, len);
+}
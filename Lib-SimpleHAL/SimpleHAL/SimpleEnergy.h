@@ -0,0 +1,141 @@
+/**
+ * @file SimpleEnergy.h
+ * @brief Runtime Energy Accounting สำหรับ CH32V003 (เวลาในแต่ละ power state + peripherals)
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * ประมาณพลังงานที่ใช้จริงในสนามโดยไม่ต้องมีเครื่องวัดกระแส:
+ * นับเวลาที่อยู่ใน run/sleep/standby และเวลาที่ clock ของแต่ละ peripheral เปิดอยู่
+ * แล้วคูณด้วยกระแสต่อ state/peripheral (ค่าคงที่ที่ปรับได้)
+ *
+ * **แหล่งข้อมูล:**
+ * - SimplePWR แจ้ง state เมื่อเข้า/ออก sleep และ standby (PWR_EnterSleepMode(),
+ *   PWR_Sleep(), Delay_Ms() แบบ sleep, PWR_StandbyTimed(), PWR_IdleFor())
+ * - SimpleClock เรียก Energy_Update() ก่อน clock ของ peripheral เปิด/ปิด
+ * - เวลาจาก Get_CurrentUs64() ของ SimpleDelay (standby นับจากเวลาที่ชดเชยให้ millis)
+ *
+ * **หน่วย:** เวลาเป็น ms, ประจุเป็น nAh (1 µAh = 1000 nAh)
+ *
+ * @example
+ * Energy_Start();
+ * ...
+ * Energy_Print(Printf_OutputUSART);
+ * // run 5230 ms 4358 nAh
+ * // sleep 54770 ms 18256 nAh
+ * // USART1 60000 ms 1333 nAh
+ * // total 60000 ms 23947 nAh avg 1436 uA
+ *
+ * @note เป็นค่าประมาณ: ความแม่นยำขึ้นกับค่ากระแสที่ใช้ (วัดเทียบกับ board จริงหนึ่งครั้งแล้วปรับ)
+ * @note ISR ที่ปลุก CPU นับเป็นเวลา sleep จนกว่า PWR_EnterSleepMode() จะ return
+ * @note PWR_StandbyUntilInterrupt() ไม่รู้เวลาที่หลับ จึงไม่ถูกนับ
+ */
+
+#ifndef __SIMPLE_ENERGY_H
+#define __SIMPLE_ENERGY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <ch32v00x.h>
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleClock.h"
+#include "SimplePWR.h"
+#include "SimplePrintf.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief กระแสของ core ใน run mode (µA, ไม่รวม peripherals)
+ */
+#ifndef SIMPLE_ENERGY_RUN_UA
+#define SIMPLE_ENERGY_RUN_UA 3000
+#endif
+
+/**
+ * @brief กระแสของ core ใน sleep mode (µA, ไม่รวม peripherals)
+ */
+#ifndef SIMPLE_ENERGY_SLEEP_UA
+#define SIMPLE_ENERGY_SLEEP_UA 1200
+#endif
+
+/**
+ * @brief กระแสใน standby mode รวม LSI + AWU (µA)
+ */
+#ifndef SIMPLE_ENERGY_STANDBY_UA
+#define SIMPLE_ENERGY_STANDBY_UA 10
+#endif
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief กระแสเพิ่มต่อ peripheral ขณะ clock เปิด (µA, เรียงตาม Clock_Periph)
+ *
+ * @details ค่าเริ่มต้นเป็นค่าประมาณที่ 48 MHz: ประกาศ array ชื่อเดียวกัน
+ * (ไม่ weak) ใน application เพื่อแทนด้วยค่าที่วัดได้
+ */
+extern const uint16_t energy_periph_ua[CLOCK_PERIPH_COUNT];
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief Callback ของ Energy_Report()
+ * @param name ชื่อ state ("run", "sleep", "standby") หรือ peripheral ("USART1", ...)
+ * @param ms เวลาสะสม
+ * @param nah ประจุที่ใช้ (nAh)
+ */
+typedef void (*Energy_Callback)(const char* name, uint32_t ms, uint32_t nah);
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief ล้างตัวนับและเริ่มนับ (state ปัจจุบันเป็น run)
+ * @note เรียกซ้ำเพื่อเริ่มรอบวัดใหม่
+ */
+void Energy_Start(void);
+
+/**
+ * @brief หยุดนับ (ค่าที่สะสมไว้ยังอ่านได้)
+ */
+void Energy_Stop(void);
+
+/**
+ * @brief ปิดบัญชีเวลาตั้งแต่ครั้งก่อนถึงตอนนี้ ให้ state และ peripherals ปัจจุบัน
+ * @note SimpleClock เรียกให้ก่อน clock เปลี่ยน, ใช้ใน ISR ได้
+ */
+void Energy_Update(void);
+
+/**
+ * @brief เปลี่ยน power state (SimplePWR เรียกให้)
+ * @param state PWR_STATE_RUN, PWR_STATE_SLEEP หรือ PWR_STATE_STANDBY
+ */
+void Energy_SetState(uint8_t state);
+
+/**
+ * @brief รายงานเวลาและประจุของแต่ละ state และ peripheral
+ * @param callback เรียกต่อ state/peripheral ที่มีเวลา > 0 (NULL = ไม่รายงาน)
+ * @return ประจุรวม (nAh)
+ *
+ * @note เรียกจาก main loop (ใช้การหาร 64-bit)
+ */
+uint32_t Energy_Report(Energy_Callback callback);
+
+/**
+ * @brief กระแสเฉลี่ยตั้งแต่ Energy_Start() (µA)
+ * @note ใช้ประเมินอายุแบตเตอรี่: ชั่วโมง = mAh × 1000 / ค่านี้
+ */
+uint32_t Energy_GetAverageUA(void);
+
+/**
+ * @brief ส่งรายงานเป็นข้อความ 1 บรรทัดต่อรายการ ปิดท้ายด้วยบรรทัด total
+ * @param output ปลายทาง (Printf_OutputUSART, Printf_OutputSDI หรือของผู้ใช้)
+ */
+void Energy_Print(Printf_Output output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_ENERGY_H
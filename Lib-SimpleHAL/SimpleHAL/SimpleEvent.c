@@ -0,0 +1,65 @@
+/**
+ * @file SimpleEvent.c
+ * @brief Lock-free Event Queue Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleEvent.h"
+#include <stddef.h>
+
+/* ========== Private Variables ========== */
+
+Event_Queue event_rings[EVENT_RING_COUNT];
+
+static Event_Handler event_handlers[EVENT_SOURCE_COUNT];
+static uint8_t event_dropped_seen[EVENT_RING_COUNT];
+
+// Rings + handler table (SimpleHAL_RamReport())
+const uint16_t event_ram_bytes = sizeof(event_rings) + sizeof(event_handlers);
+
+/* ========== Deferred Callbacks ========== */
+
+/**
+ * @brief ตั้ง handler ของ source
+ */
+void Event_SetHandler(Event_Source source, Event_Handler handler) {
+    if (source >= EVENT_SOURCE_COUNT) return;
+    event_handlers[source] = handler;
+}
+
+/**
+ * @brief เรียก handler ของ deferred events ที่รออยู่
+ */
+uint16_t Event_Dispatch(void) {
+    uint16_t count = 0;
+    Event_t event;
+
+    for (uint8_t ring = 0; ring < EVENT_RING_COUNT; ring++) {
+        while (Event_Get(&event_rings[ring], &event)) {
+            uint8_t source = EVENT_SOURCE(event.id);
+            if (source < EVENT_SOURCE_COUNT && event_handlers[source] != NULL) {
+                event_handlers[source](event.id, event.arg);
+            }
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief จำนวน deferred events ที่ทิ้งตั้งแต่เรียกครั้งก่อน
+ */
+uint16_t Event_Dropped(void) {
+    uint16_t total = 0;
+
+    // ตัวนับเขียนโดย producer เท่านั้น: consumer จำค่าที่เห็นล่าสุดแล้วคืนผลต่าง
+    for (uint8_t ring = 0; ring < EVENT_RING_COUNT; ring++) {
+        uint8_t dropped = event_rings[ring].dropped;
+        total += (uint8_t)(dropped - event_dropped_seen[ring]);
+        event_dropped_seen[ring] = dropped;
+    }
+
+    return total;
+}
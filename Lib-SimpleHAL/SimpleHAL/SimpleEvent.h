@@ -0,0 +1,204 @@
+/**
+ * @file SimpleEvent.h
+ * @brief Lock-free Event Queue สำหรับส่งงานจาก ISR ไปทำใน main loop บน CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * Ring buffer แบบ single-producer/single-consumer ของ (event id, uint16 arg)
+ * ไม่ต้องปิด interrupt: แต่ละ event เป็น word เดียว (store 32-bit เป็น atomic บน RV32EC)
+ * producer เขียน head และ consumer เขียน tail เท่านั้น
+ *
+ * **คุณสมบัติ:**
+ * - Event_Post()/Event_Get() บน Event_Queue ของผู้ใช้ (ISR หนึ่ง → main)
+ * - Deferred callbacks: attachInterruptDeferred(), DMA_SetTransferCompleteDeferred(),
+ *   TIM_AttachInterruptDeferred() ทำให้ ISR เหลือแค่ post event แล้ว return
+ * - Event_Dispatch() ใน main loop เรียก callback ตัวจริงตามลำดับที่เกิด
+ * - นับ event ที่ทิ้งเมื่อ queue เต็ม (Event_Dropped())
+ *
+ * **Producer ต่อ queue:**
+ * ISR ที่ preemption priority เท่ากันขัดจังหวะกันไม่ได้ จึงนับเป็น producer เดียว
+ * Deferred callbacks จึงใช้ 2 queues ตาม priority ที่ module ตั้งไว้:
+ * - EVENT_RING_HIGH: priority 0 (DMA)
+ * - EVENT_RING_LOW: priority 1 (GPIO EXTI, TIM, USART)
+ *
+ * @example
+ * void button_isr(void) {          // ทำงานใน main loop ไม่ใช่ใน ISR
+ *     printf("pressed\n");
+ * }
+ *
+ * attachInterruptDeferred(PC1, button_isr, FALLING);
+ *
+ * while (1) {
+ *     Event_Dispatch();
+ *     // งานอื่น
+ * }
+ *
+ * @note Event_Get()/Event_Dispatch() เรียกจาก main loop เท่านั้น (consumer เดียว)
+ */
+
+#ifndef __SIMPLE_EVENT_H
+#define __SIMPLE_EVENT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief จำนวน slots ต่อ queue (power of 2, 2-256) ใช้ได้จริง size - 1 events
+ */
+#ifndef SIMPLE_EVENT_QUEUE_SIZE
+#define SIMPLE_EVENT_QUEUE_SIZE 16
+#endif
+
+#if (SIMPLE_EVENT_QUEUE_SIZE & (SIMPLE_EVENT_QUEUE_SIZE - 1)) || SIMPLE_EVENT_QUEUE_SIZE < 2 || SIMPLE_EVENT_QUEUE_SIZE > 256
+#error "SIMPLE_EVENT_QUEUE_SIZE must be a power of 2 (2-256)"
+#endif
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief Event id = (source << 8) | index
+ */
+#define EVENT_ID(source, index)  ((uint16_t)(((source) << 8) | ((index) & 0xFF)))
+#define EVENT_SOURCE(id)         ((uint8_t)((id) >> 8))
+#define EVENT_INDEX(id)          ((uint8_t)(id))
+
+/**
+ * @brief Sources ของ event ที่ Event_Dispatch() ส่งต่อ
+ */
+typedef enum {
+    EVENT_SOURCE_USER = 0,  /**< Event_Defer() ของผู้ใช้ → handler ของ Event_SetHandler() */
+    EVENT_SOURCE_GPIO,      /**< EXTI lines (arg = mask ของ lines) */
+    EVENT_SOURCE_DMA,       /**< DMA transfer complete (index = channel) */
+    EVENT_SOURCE_TIM,       /**< TIM update (index = TIM_Instance) */
+    EVENT_SOURCE_COUNT
+} Event_Source;
+
+/**
+ * @brief Deferred queues แยกตาม NVIC preemption priority ของ ISR ที่ post
+ */
+typedef enum {
+    EVENT_RING_HIGH = 0,    /**< ISR priority 0 */
+    EVENT_RING_LOW = 1,     /**< ISR priority 1 */
+    EVENT_RING_COUNT
+} Event_Ring;
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief Event ที่อ่านจาก queue
+ */
+typedef struct {
+    uint16_t id;
+    uint16_t arg;
+} Event_t;
+
+/**
+ * @brief SPSC ring buffer (slot = arg << 16 | id)
+ */
+typedef struct {
+    volatile uint32_t slots[SIMPLE_EVENT_QUEUE_SIZE];
+    volatile uint8_t head;     /**< เขียนโดย producer เท่านั้น */
+    volatile uint8_t tail;     /**< เขียนโดย consumer เท่านั้น */
+    volatile uint8_t dropped;  /**< events ที่ทิ้งเพราะเต็ม (เขียนโดย producer, วนรอบที่ 256) */
+} Event_Queue;
+
+/**
+ * @brief Handler ของ event source
+ */
+typedef void (*Event_Handler)(uint16_t id, uint16_t arg);
+
+/* ========== Queue ========== */
+
+/**
+ * @brief ใส่ event ลง queue (producer)
+ * @return 1 = สำเร็จ, 0 = queue เต็ม (นับใน dropped)
+ */
+static inline uint8_t Event_Post(Event_Queue* queue, uint16_t id, uint16_t arg) {
+    uint8_t head = queue->head;
+    uint8_t next = (uint8_t)((head + 1) & (SIMPLE_EVENT_QUEUE_SIZE - 1));
+
+    if (next == queue->tail) {
+        queue->dropped++;
+        return 0;
+    }
+
+    // Slot ต้องเขียนเสร็จก่อน publish head
+    queue->slots[head] = ((uint32_t)arg << 16) | id;
+    queue->head = next;
+    return 1;
+}
+
+/**
+ * @brief อ่าน event ออกจาก queue (consumer)
+ * @return 1 = ได้ event, 0 = queue ว่าง
+ */
+static inline uint8_t Event_Get(Event_Queue* queue, Event_t* event) {
+    uint8_t tail = queue->tail;
+    if (tail == queue->head) return 0;
+
+    uint32_t slot = queue->slots[tail];
+    queue->tail = (uint8_t)((tail + 1) & (SIMPLE_EVENT_QUEUE_SIZE - 1));
+
+    event->id = (uint16_t)slot;
+    event->arg = (uint16_t)(slot >> 16);
+    return 1;
+}
+
+/**
+ * @brief จำนวน events ที่รออยู่
+ */
+static inline uint8_t Event_Count(const Event_Queue* queue) {
+    return (uint8_t)((queue->head - queue->tail) & (SIMPLE_EVENT_QUEUE_SIZE - 1));
+}
+
+/* ========== Deferred Callbacks ========== */
+
+/**
+ * @brief Deferred queues ของ library (ใช้ผ่าน Event_Defer())
+ */
+extern Event_Queue event_rings[EVENT_RING_COUNT];
+
+/**
+ * @brief Post event ลง deferred queue ตาม priority ของ ISR ที่เรียก
+ * @param ring EVENT_RING_HIGH (ISR priority 0) หรือ EVENT_RING_LOW (priority 1)
+ * @param id EVENT_ID(source, index)
+ * @param arg ข้อมูลประกอบ
+ * @return 1 = สำเร็จ, 0 = queue เต็ม
+ *
+ * @note ห้ามเรียกจาก main loop (main ไม่ใช่ producer ของ ring)
+ */
+static inline uint8_t Event_Defer(Event_Ring ring, uint16_t id, uint16_t arg) {
+    return Event_Post(&event_rings[ring], id, arg);
+}
+
+/**
+ * @brief ตั้ง handler ของ source
+ * @note Module ของ library ลงทะเบียน source ของตัวเองเมื่อเปิด deferred callback
+ */
+void Event_SetHandler(Event_Source source, Event_Handler handler);
+
+/**
+ * @brief เรียก handler ของ deferred events ที่รออยู่ทั้งหมด (HIGH ก่อน LOW)
+ * @return จำนวน events ที่ dispatch
+ *
+ * @note เรียกจาก main loop เท่านั้น
+ */
+uint16_t Event_Dispatch(void);
+
+/**
+ * @brief จำนวน deferred events ที่ทิ้งเพราะ queue เต็มตั้งแต่เรียกครั้งก่อน (รวมทุก ring)
+ */
+uint16_t Event_Dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_EVENT_H
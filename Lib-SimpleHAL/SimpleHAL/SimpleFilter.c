@@ -0,0 +1,253 @@
+/**
+ * @file SimpleFilter.c
+ * @brief Fixed-point Streaming Filters Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleFilter.h"
+
+/* ========== Moving Average ========== */
+
+/**
+ * @brief เริ่มต้น moving average
+ */
+void Filter_MovingAverageInit(Filter_MovingAverage* filter, uint16_t* window, uint8_t shift) {
+    if (shift < 1) shift = 1;
+    if (shift > 8) shift = 8;
+
+    filter->window = window;
+    filter->shift = shift;
+    filter->sum = 0;
+    filter->index = 0;
+    filter->primed = 0;
+}
+
+/**
+ * @brief ใส่ sample และคืนค่าเฉลี่ย
+ */
+uint16_t Filter_MovingAverageUpdate(Filter_MovingAverage* filter, uint16_t sample) {
+    uint16_t size = (uint16_t)(1u << filter->shift);
+
+    if (!filter->primed) {
+        for (uint16_t i = 0; i < size; i++) {
+            filter->window[i] = sample;
+        }
+        filter->sum = (uint32_t)sample << filter->shift;
+        filter->primed = 1;
+        return sample;
+    }
+
+    uint8_t index = filter->index;
+    filter->sum += (uint32_t)sample - filter->window[index];
+    filter->window[index] = sample;
+    filter->index = (uint8_t)((index + 1) & (size - 1));
+
+    return (uint16_t)(filter->sum >> filter->shift);
+}
+
+/**
+ * @brief Filter ทั้ง buffer แบบ in-place
+ */
+void Filter_MovingAverageBuffer(Filter_MovingAverage* filter, uint16_t* buffer, uint16_t length) {
+    while (length--) {
+        *buffer = Filter_MovingAverageUpdate(filter, *buffer);
+        buffer++;
+    }
+}
+
+/* ========== EMA ========== */
+
+/**
+ * @brief เริ่มต้น EMA
+ */
+void Filter_EMAInit(Filter_EMA* filter, uint8_t shift) {
+    if (shift < 1) shift = 1;
+    if (shift > 15) shift = 15;
+
+    filter->shift = shift;
+    filter->acc = 0;
+    filter->primed = 0;
+}
+
+/**
+ * @brief ใส่ sample และคืนค่า filter
+ */
+uint16_t Filter_EMAUpdate(Filter_EMA* filter, uint16_t sample) {
+    uint8_t shift = filter->shift;
+
+    if (!filter->primed) {
+        filter->acc = (uint32_t)sample << shift;
+        filter->primed = 1;
+        return sample;
+    }
+
+    // acc = acc × (1 - alpha) + sample (acc เก็บค่า × 2^shift)
+    filter->acc = filter->acc - (filter->acc >> shift) + sample;
+
+    return (uint16_t)((filter->acc + (1UL << (shift - 1))) >> shift);
+}
+
+/**
+ * @brief Filter ทั้ง buffer แบบ in-place
+ */
+void Filter_EMABuffer(Filter_EMA* filter, uint16_t* buffer, uint16_t length) {
+    while (length--) {
+        *buffer = Filter_EMAUpdate(filter, *buffer);
+        buffer++;
+    }
+}
+
+/* ========== Biquad ========== */
+
+/**
+ * @brief เริ่มต้น biquad
+ */
+void Filter_BiquadInit(Filter_Biquad* filter, int16_t b0, int16_t b1, int16_t b2,
+                       int16_t a1, int16_t a2) {
+    filter->b0 = b0;
+    filter->b1 = b1;
+    filter->b2 = b2;
+    filter->a1 = a1;
+    filter->a2 = a2;
+    Filter_BiquadReset(filter);
+}
+
+/**
+ * @brief ล้าง state
+ */
+void Filter_BiquadReset(Filter_Biquad* filter) {
+    filter->x1 = 0;
+    filter->x2 = 0;
+    filter->y1 = 0;
+    filter->y2 = 0;
+    filter->error = 0;
+}
+
+/**
+ * @brief ใส่ sample และคืนค่า filter
+ */
+uint16_t Filter_BiquadUpdate(Filter_Biquad* filter, uint16_t sample) {
+    int32_t x = sample;
+
+    // สะสมแบบ unsigned: ผลรวมกลางทางล้นได้ ผลลัพธ์ยังถูกถ้า y × 2^14 อยู่ในช่วง int32
+    uint32_t acc = filter->error;
+    acc += (uint32_t)(filter->b0 * x);
+    acc += (uint32_t)(filter->b1 * filter->x1);
+    acc += (uint32_t)(filter->b2 * filter->x2);
+    acc -= (uint32_t)(filter->a1 * filter->y1);
+    acc -= (uint32_t)(filter->a2 * filter->y2);
+
+    // Error feedback: เก็บเศษ 14 bits ไว้รอบถัดไป
+    filter->error = acc & 0x3FFF;
+    int32_t y = (int32_t)acc >> 14;
+
+    filter->x2 = filter->x1;
+    filter->x1 = x;
+    filter->y2 = filter->y1;
+    filter->y1 = y;
+
+    if (y < 0) return 0;
+    if (y > 0xFFFF) return 0xFFFF;
+    return (uint16_t)y;
+}
+
+/**
+ * @brief Filter ทั้ง buffer แบบ in-place
+ */
+void Filter_BiquadBuffer(Filter_Biquad* filter, uint16_t* buffer, uint16_t length) {
+    while (length--) {
+        *buffer = Filter_BiquadUpdate(filter, *buffer);
+        buffer++;
+    }
+}
+
+/* ========== Median ========== */
+
+/**
+ * @brief Median ของ 5 ค่า
+ */
+uint16_t Filter_Median5(uint16_t a, uint16_t b, uint16_t c, uint16_t d, uint16_t e) {
+    uint16_t t;
+
+    // เรียงคู่ (a,b) และ (c,d)
+    if (a > b) { t = a; a = b; b = t; }
+    if (c > d) { t = c; c = d; d = t; }
+
+    // a = ค่าน้อยสุดของ 4 ตัว (มี 3 ค่ามากกว่า จึงไม่ใช่ median) แทนที่ด้วย e
+    if (c < a) { t = a; a = c; c = t; t = b; b = d; d = t; }
+    a = e;
+    if (a > b) { t = a; a = b; b = t; }
+
+    // ตัดค่าน้อยสุดของ 4 ตัวอีกครั้ง median = ค่าน้อยสุดของที่เหลือ
+    if (c < a) { t = b; b = d; d = t; c = a; }
+    return (b < c) ? b : c;
+}
+
+/**
+ * @brief เริ่มต้น median filter แบบ streaming
+ */
+void Filter_MedianInit(Filter_Median* filter, uint8_t size) {
+    filter->size = (size >= 5) ? 5 : 3;
+    filter->index = 0;
+    filter->primed = 0;
+}
+
+/**
+ * @brief ใส่ sample และคืน median ของ samples ล่าสุด
+ */
+uint16_t Filter_MedianUpdate(Filter_Median* filter, uint16_t sample) {
+    uint16_t* h = filter->history;
+
+    if (!filter->primed) {
+        h[0] = h[1] = h[2] = h[3] = h[4] = sample;
+        filter->primed = 1;
+    }
+
+    h[filter->index] = sample;
+    if (++filter->index >= filter->size) {
+        filter->index = 0;
+    }
+
+    if (filter->size == 5) {
+        return Filter_Median5(h[0], h[1], h[2], h[3], h[4]);
+    }
+    return Filter_Median3(h[0], h[1], h[2]);
+}
+
+/**
+ * @brief Filter ทั้ง buffer แบบ in-place
+ */
+void Filter_MedianBuffer(Filter_Median* filter, uint16_t* buffer, uint16_t length) {
+    while (length--) {
+        *buffer = Filter_MedianUpdate(filter, *buffer);
+        buffer++;
+    }
+}
+
+/* ========== Min/Max ========== */
+
+/**
+ * @brief ล้าง tracker
+ */
+void Filter_MinMaxReset(Filter_MinMax* tracker) {
+    tracker->min = 0xFFFF;
+    tracker->max = 0;
+}
+
+/**
+ * @brief อัปเดตด้วยทั้ง buffer
+ */
+void Filter_MinMaxBuffer(Filter_MinMax* tracker, const uint16_t* buffer, uint16_t length) {
+    uint16_t min = tracker->min;
+    uint16_t max = tracker->max;
+
+    while (length--) {
+        uint16_t sample = *buffer++;
+        if (sample < min) min = sample;
+        if (sample > max) max = sample;
+    }
+
+    tracker->min = min;
+    tracker->max = max;
+}
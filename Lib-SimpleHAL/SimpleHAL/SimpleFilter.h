@@ -0,0 +1,244 @@
+/**
+ * @file SimpleFilter.h
+ * @brief Fixed-point Streaming Filters สำหรับ ADC samples บน CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * Filter แบบ integer ที่เรียกได้ทีละ sample จาก ISR หรือทำ in-place บน
+ * uint16_t DMA buffer (เช่นใน half-transfer callback)
+ *
+ * **Filters:**
+ * - Moving average: running sum, O(1) ต่อ sample, window ขนาด 2^n (หารด้วย shift)
+ * - EMA: alpha = 1/2^n ใช้แค่ shift และบวกลบ
+ * - Biquad IIR: coefficients Q14, มี error feedback ลด limit cycle ที่ cutoff ต่ำ
+ * - Median of 3 / 5: ตัด spike ด้วย sorting network (ไม่มี loop)
+ * - Min/max tracker
+ *
+ * **ต้นทุนบน RV32EC (ไม่มี hardware multiply):**
+ * - Moving average, EMA, median, min/max: ไม่มีการคูณหรือหาร
+ * - Biquad: 5 multiplies ต่อ sample (software multiply)
+ *
+ * @example
+ * static uint16_t window[16];
+ * static Filter_MovingAverage avg;
+ *
+ * Filter_MovingAverageInit(&avg, window, 4);  // 2^4 = 16 samples
+ *
+ * void on_half(uint16_t* samples, uint16_t n) {
+ *     Filter_MovingAverageBuffer(&avg, samples, n);  // in-place
+ * }
+ *
+ * @note แต่ละ filter state ใช้กับ stream เดียว (ไม่ต้องปิด interrupt ถ้าเรียกจาก context เดียว)
+ */
+
+#ifndef __SIMPLE_FILTER_H
+#define __SIMPLE_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief แปลง coefficient ค่าคงที่เป็น Q14 ตอน compile (ช่วง -2.0 ถึง < 2.0)
+ *
+ * @example
+ * Filter_BiquadInit(&lp, FILTER_Q14(0.0675f), FILTER_Q14(0.135f), FILTER_Q14(0.0675f),
+ *                   FILTER_Q14(-1.143f), FILTER_Q14(0.413f));
+ */
+#define FILTER_Q14(c)  ((int16_t)((c) * 16384.0f + (((c) >= 0) ? 0.5f : -0.5f)))
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief Moving average (window ขนาด 2^shift)
+ */
+typedef struct {
+    uint16_t* window;   /**< buffer ของผู้เรียก [1 << shift] */
+    uint32_t sum;       /**< ผลรวมของ window */
+    uint8_t shift;      /**< log2 ของขนาด window (1-8) */
+    uint8_t index;      /**< ตำแหน่งที่จะเขียนถัดไป */
+    uint8_t primed;     /**< window ถูกเติมด้วย sample แรกแล้ว */
+} Filter_MovingAverage;
+
+/**
+ * @brief Exponential moving average (alpha = 1/2^shift)
+ */
+typedef struct {
+    uint32_t acc;       /**< ค่า filter × 2^shift */
+    uint8_t shift;      /**< 1-15 */
+    uint8_t primed;
+} Filter_EMA;
+
+/**
+ * @brief Biquad IIR (Direct Form I, coefficients Q14)
+ *
+ * @details y = b0·x + b1·x1 + b2·x2 - a1·y1 - a2·y2 (a0 = 1)
+ */
+typedef struct {
+    int16_t b0, b1, b2;  /**< feed-forward (Q14) */
+    int16_t a1, a2;      /**< feedback (Q14) */
+    int32_t x1, x2;      /**< input ก่อนหน้า */
+    int32_t y1, y2;      /**< output ก่อนหน้า */
+    uint32_t error;      /**< เศษจาก shift ของรอบก่อน (error feedback) */
+} Filter_Biquad;
+
+/**
+ * @brief Median filter แบบ streaming (3 หรือ 5 samples)
+ */
+typedef struct {
+    uint16_t history[5];
+    uint8_t size;       /**< 3 หรือ 5 */
+    uint8_t index;
+    uint8_t primed;
+} Filter_Median;
+
+/**
+ * @brief Min/max tracker
+ */
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+} Filter_MinMax;
+
+/* ========== Moving Average ========== */
+
+/**
+ * @brief เริ่มต้น moving average
+ * @param filter filter state
+ * @param window buffer ขนาด (1 << shift) samples
+ * @param shift log2 ของขนาด window (1-8 → 2-256 samples)
+ *
+ * @note Sample แรกเติมทั้ง window (ไม่มีช่วง ramp-up จาก 0)
+ */
+void Filter_MovingAverageInit(Filter_MovingAverage* filter, uint16_t* window, uint8_t shift);
+
+/**
+ * @brief ใส่ sample และคืนค่าเฉลี่ย
+ * @return ค่าเฉลี่ยของ window
+ */
+uint16_t Filter_MovingAverageUpdate(Filter_MovingAverage* filter, uint16_t sample);
+
+/**
+ * @brief Filter ทั้ง buffer แบบ in-place
+ */
+void Filter_MovingAverageBuffer(Filter_MovingAverage* filter, uint16_t* buffer, uint16_t length);
+
+/* ========== EMA ========== */
+
+/**
+ * @brief เริ่มต้น EMA
+ * @param filter filter state
+ * @param shift alpha = 1/2^shift (1-15) เช่น 3 → alpha = 0.125
+ *
+ * @note Time constant ≈ 2^shift samples
+ */
+void Filter_EMAInit(Filter_EMA* filter, uint8_t shift);
+
+/**
+ * @brief ใส่ sample และคืนค่า filter
+ */
+uint16_t Filter_EMAUpdate(Filter_EMA* filter, uint16_t sample);
+
+/**
+ * @brief Filter ทั้ง buffer แบบ in-place
+ */
+void Filter_EMABuffer(Filter_EMA* filter, uint16_t* buffer, uint16_t length);
+
+/* ========== Biquad ========== */
+
+/**
+ * @brief เริ่มต้น biquad
+ * @param filter filter state
+ * @param b0 b1 b2 a1 a2 coefficients แบบ Q14 (ใช้ FILTER_Q14())
+ *
+ * @note ออกแบบ coefficients ตอน compile (เช่น RBJ cookbook แล้วหารด้วย a0)
+ */
+void Filter_BiquadInit(Filter_Biquad* filter, int16_t b0, int16_t b1, int16_t b2,
+                       int16_t a1, int16_t a2);
+
+/**
+ * @brief ล้าง state (เริ่มจาก 0)
+ */
+void Filter_BiquadReset(Filter_Biquad* filter);
+
+/**
+ * @brief ใส่ sample และคืนค่า filter (clamp 0-65535)
+ */
+uint16_t Filter_BiquadUpdate(Filter_Biquad* filter, uint16_t sample);
+
+/**
+ * @brief Filter ทั้ง buffer แบบ in-place
+ */
+void Filter_BiquadBuffer(Filter_Biquad* filter, uint16_t* buffer, uint16_t length);
+
+/* ========== Median ========== */
+
+/**
+ * @brief Median ของ 3 ค่า (3 comparisons)
+ */
+static inline uint16_t Filter_Median3(uint16_t a, uint16_t b, uint16_t c) {
+    if (a > b) { uint16_t t = a; a = b; b = t; }
+    if (b > c) b = c;
+    return (a > b) ? a : b;
+}
+
+/**
+ * @brief Median ของ 5 ค่า (6 comparisons)
+ */
+uint16_t Filter_Median5(uint16_t a, uint16_t b, uint16_t c, uint16_t d, uint16_t e);
+
+/**
+ * @brief เริ่มต้น median filter แบบ streaming
+ * @param filter filter state
+ * @param size 3 หรือ 5
+ */
+void Filter_MedianInit(Filter_Median* filter, uint8_t size);
+
+/**
+ * @brief ใส่ sample และคืน median ของ samples ล่าสุด
+ */
+uint16_t Filter_MedianUpdate(Filter_Median* filter, uint16_t sample);
+
+/**
+ * @brief Filter ทั้ง buffer แบบ in-place
+ */
+void Filter_MedianBuffer(Filter_Median* filter, uint16_t* buffer, uint16_t length);
+
+/* ========== Min/Max ========== */
+
+/**
+ * @brief ล้าง tracker (min = 65535, max = 0)
+ */
+void Filter_MinMaxReset(Filter_MinMax* tracker);
+
+/**
+ * @brief อัปเดตด้วย sample เดียว
+ */
+static inline void Filter_MinMaxUpdate(Filter_MinMax* tracker, uint16_t sample) {
+    if (sample < tracker->min) tracker->min = sample;
+    if (sample > tracker->max) tracker->max = sample;
+}
+
+/**
+ * @brief อัปเดตด้วยทั้ง buffer (ไม่แก้ buffer)
+ */
+void Filter_MinMaxBuffer(Filter_MinMax* tracker, const uint16_t* buffer, uint16_t length);
+
+/**
+ * @brief ช่วงของค่า (max - min), 0 ถ้ายังไม่มี sample
+ */
+static inline uint16_t Filter_MinMaxRange(const Filter_MinMax* tracker) {
+    return (tracker->max >= tracker->min) ? (uint16_t)(tracker->max - tracker->min) : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_FILTER_H
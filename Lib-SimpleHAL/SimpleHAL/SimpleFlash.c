@@ -1,39 +1,146 @@
 /**
  * @file SimpleFlash.c
  * @brief Simple Flash Storage Library Implementation
- * @version 1.0
- * @date 2025-12-21
+ * @version 1.6
+ * @date 2026-10-14
  */
 
 #include "SimpleFlash.h"
+#include "SimpleInit.h"
+#include "SimpleCRC.h"
 
 
 /* ========== Private Variables ========== */
 
-static bool flash_initialized = false;
+/* Transaction cache: แต่ละ slot เก็บสำเนา page ที่แก้ไข (page_addr 0 = ว่าง) */
+static uint32_t txn_page_addr[SIMPLE_FLASH_TXN_PAGES];
+static uint8_t txn_page_data[SIMPLE_FLASH_TXN_PAGES][FLASH_PAGE_SIZE];
+static uint8_t txn_active = 0;
+
+/* ขนาด config ที่ตรวจ CRC ผ่านแล้ว (0 = ยังไม่ตรวจ) สำหรับ Flash_MapConfig() */
+static uint8_t config_map_size = 0;
+
+const uint16_t flash_ram_bytes = sizeof(txn_page_addr) + sizeof(txn_page_data) + sizeof(txn_active) +
+                                 sizeof(config_map_size);
 
 /* ========== Private Function Prototypes ========== */
 
 static FlashStatus Flash_UnlockInternal(void);
 static void Flash_LockInternal(void);
+static void Flash_LockFastInternal(void);
+static bool Flash_IsPageAddress(uint32_t page_addr);
+static bool Flash_IsRangeValid(uint32_t addr, uint16_t size);
+static FlashStatus Flash_ModifyPage(uint32_t addr, const uint8_t* data, uint8_t len);
 static FlashStatus Flash_WaitForOperation(uint32_t timeout_ms);
 static FlashStatus Flash_ConvertStatus(FLASH_Status status);
 
+/* ========== Flash Core (RAM-resident เมื่อ SIMPLE_FLASH_RAMFUNC) ========== */
+
+#if SIMPLE_FLASH_RAMFUNC
+#define FLASH_CORE_SECTION  FLASH_RAMFUNC
+#else
+#define FLASH_CORE_SECTION  __attribute__((noinline))
+#endif
+
+/**
+ * @brief รอ busy flag (inline: ห้ามเรียกโค้ดใน flash ระหว่าง operation)
+ */
+static inline __attribute__((always_inline)) void Flash_CoreWait(void) {
+    while (FLASH->STATR & FLASH_STATR_BSY) {
+    }
+}
+
+/**
+ * @brief เริ่ม page operation (fast erase / fast program) แล้วรอจบ
+ */
+static inline __attribute__((always_inline)) void Flash_CorePageOp(uint32_t mode, uint32_t page_addr) {
+    FLASH->CTLR |= mode;
+    FLASH->ADDR = page_addr;
+    FLASH->CTLR |= FLASH_CTLR_STRT;
+    Flash_CoreWait();
+    FLASH->CTLR &= ~mode;
+}
+
+/**
+ * @brief Fast erase 64 bytes (ต้อง FLASH_Unlock_Fast() แล้ว)
+ */
+FLASH_CORE_SECTION static void Flash_CoreErasePage(uint32_t page_addr) {
+    Flash_CorePageOp(FLASH_CTLR_PAGE_ER, page_addr);
+}
+
+/**
+ * @brief Fast erase + โหลด page buffer 16 words + program (ลำดับเดียวกับ SPL fast functions)
+ */
+FLASH_CORE_SECTION static void Flash_CoreProgramPage(uint32_t page_addr, const uint8_t* src) {
+    Flash_CorePageOp(FLASH_CTLR_PAGE_ER, page_addr);
+
+    FLASH->CTLR |= FLASH_CTLR_PAGE_PG;
+    FLASH->CTLR |= FLASH_CTLR_BUF_RST;
+    Flash_CoreWait();
+    FLASH->CTLR &= ~FLASH_CTLR_PAGE_PG;
+
+    // ประกอบ word ทีละ byte: src ไม่ต้อง align และไม่เรียก memcpy() ที่อยู่ใน flash
+    for (uint8_t i = 0; i < FLASH_PAGE_SIZE; i += 4) {
+        uint32_t word = (uint32_t)src[i] | ((uint32_t)src[i + 1] << 8) |
+                        ((uint32_t)src[i + 2] << 16) | ((uint32_t)src[i + 3] << 24);
+        FLASH->CTLR |= FLASH_CTLR_PAGE_PG;
+        *(volatile uint32_t*)(page_addr + i) = word;
+        FLASH->CTLR |= FLASH_CTLR_BUF_LOAD;
+        Flash_CoreWait();
+        FLASH->CTLR &= ~FLASH_CTLR_PAGE_PG;
+    }
+
+    Flash_CorePageOp(FLASH_CTLR_PAGE_PG, page_addr);
+}
+
+/**
+ * @brief เขียน half-word ขณะ unlock อยู่
+ */
+FLASH_CORE_SECTION FLASH_Status Flash_ProgramHalfWordRaw(uint32_t addr, uint16_t data) {
+    Flash_CoreWait();
+    FLASH->CTLR |= FLASH_CTLR_PG;
+    *(volatile uint16_t*)addr = data;
+    Flash_CoreWait();
+    FLASH->CTLR &= ~FLASH_CTLR_PG;
+
+    return (FLASH->STATR & FLASH_STATR_WRPRTERR) ? FLASH_ERROR_WRP : FLASH_COMPLETE;
+}
+
+/**
+ * @brief ลงทะเบียน interrupt ที่ต้องทำงานระหว่าง erase/program
+ */
+void Flash_SetRamIRQ(uint8_t channel, IRQn_Type irq, void (*handler)(void)) {
+    if (channel > 1) {
+        return;
+    }
+    SetVTFIRQ((uint32_t)handler, irq, channel, (handler != NULL) ? ENABLE : DISABLE);
+}
+
 /* ========== Core Functions Implementation ========== */
 
+/**
+ * @brief ตั้งค่า Flash controller (เรียกครั้งเดียวผ่าน SimpleInit)
+ */
+static void Flash_HWInit(void) {
+    // Enable flash clock (already enabled by default)
+    // Flash latency เป็นของ SystemInit/SimpleHAL_SetSysClock(): ห้ามแตะที่นี่
+    // (ตั้ง Latency_0 ทับตอน 48 MHz ทำให้ CPU อ่าน flash ผิด)
+}
+
 /**
  * @brief เริ่มต้นระบบ Flash storage
  */
 FlashStatus Flash_Init(void) {
-    if (flash_initialized) {
-        return FLASH_OK;
+#if SIMPLE_FLASH_STORAGE_LINKER
+    // Region จาก linker script: ต้องเป็น pages เต็มภายใน flash
+    if ((FLASH_STORAGE_START_ADDR & (FLASH_PAGE_SIZE - 1)) != 0 ||
+        FLASH_STORAGE_PAGE_COUNT < 2 ||
+        FLASH_STORAGE_START_ADDR + FLASH_STORAGE_SIZE >
+            FLASH_BASE_ADDRESS + (FLASH_TOTAL_PAGES * FLASH_PAGE_SIZE)) {
+        return FLASH_ERROR_RANGE;
     }
-    
-    // Enable flash clock (already enabled by default)
-    // Set flash latency based on system clock
-    FLASH_SetLatency(FLASH_Latency_0);  // For 24MHz or less
-    
-    flash_initialized = true;
+#endif
+    SimpleInit_Ensure(SIMPLE_INIT_FLASH, Flash_HWInit);
     return FLASH_OK;
 }
 
@@ -58,29 +165,86 @@ FlashStatus Flash_EraseAll(void) {
  * @brief ลบข้อมูลใน page ที่กำหนด
  */
 FlashStatus Flash_ErasePage(uint8_t page_num) {
-    // Validate page number (254 or 255 only)
-    if (page_num != FLASH_CONFIG_PAGE && page_num != FLASH_DATA_PAGE) {
+    uint32_t page_addr = Flash_GetPageAddress(page_num);
+    if (page_addr == 0) {
         return FLASH_ERROR_RANGE;
     }
     
+    // Fast erase 64 bytes (FLASH_ErasePage() ของ SPL ลบทั้ง 1KB)
+    return Flash_ErasePageAt(page_addr);
+}
+
+/* ========== Fast Page Functions ========== */
+
+/**
+ * @brief ลบ + เขียน page ใน storage area ทั้ง 64 bytes
+ */
+FlashStatus Flash_ProgramPage(uint8_t page_num, const uint8_t* src) {
     uint32_t page_addr = Flash_GetPageAddress(page_num);
     if (page_addr == 0) {
         return FLASH_ERROR_RANGE;
     }
     
-    // Unlock flash
-    FlashStatus status = Flash_UnlockInternal();
-    if (status != FLASH_OK) {
-        return status;
+    return Flash_ProgramPageAt(page_addr, src);
+}
+
+/**
+ * @brief Fast erase 1 page (64 bytes) ที่ address ใดก็ได้ใน Flash
+ */
+FlashStatus Flash_ErasePageAt(uint32_t page_addr) {
+    if (!Flash_IsPageAddress(page_addr)) {
+        return FLASH_ERROR_ALIGN;
     }
     
-    // Erase page
-    FLASH_Status flash_status = FLASH_ErasePage(page_addr);
+    config_map_size = 0;
+    FLASH_ClearFlag(FLASH_FLAG_WRPRTERR);
+    FLASH_Unlock_Fast();
+    Flash_CoreErasePage(page_addr);
+    Flash_LockFastInternal();
     
-    // Lock flash
-    Flash_LockInternal();
+    if (FLASH_GetFlagStatus(FLASH_FLAG_WRPRTERR) == SET) {
+        return FLASH_ERROR_WRITE;
+    }
     
-    return Flash_ConvertStatus(flash_status);
+    // Verify: ทุก word ต้องเป็น 0xFFFFFFFF
+    const volatile uint32_t* word = (const volatile uint32_t*)page_addr;
+    for (uint8_t i = 0; i < FLASH_PAGE_SIZE / 4; i++) {
+        if (word[i] != 0xFFFFFFFF) {
+            return FLASH_ERROR_ERASE;
+        }
+    }
+    
+    return FLASH_OK;
+}
+
+/**
+ * @brief Fast erase + program 1 page (64 bytes) ที่ address ใดก็ได้ใน Flash
+ */
+FlashStatus Flash_ProgramPageAt(uint32_t page_addr, const uint8_t* src) {
+    if (src == NULL) {
+        return FLASH_ERROR_INVALID;
+    }
+    if (!Flash_IsPageAddress(page_addr)) {
+        return FLASH_ERROR_ALIGN;
+    }
+    
+    config_map_size = 0;
+    FLASH_ClearFlag(FLASH_FLAG_WRPRTERR);
+    FLASH_Unlock_Fast();
+    
+    // Erase แล้วโหลด page buffer ทีละ word และโปรแกรมครั้งเดียว
+    Flash_CoreProgramPage(page_addr, src);
+    
+    Flash_LockFastInternal();
+    
+    if (FLASH_GetFlagStatus(FLASH_FLAG_WRPRTERR) == SET) {
+        return FLASH_ERROR_WRITE;
+    }
+    if (memcmp((const void*)page_addr, src, FLASH_PAGE_SIZE) != 0) {
+        return FLASH_ERROR_VERIFY;
+    }
+    
+    return FLASH_OK;
 }
 
 /* ========== Basic Read Functions ========== */
@@ -161,7 +325,8 @@ FlashStatus Flash_WriteHalfWord(uint32_t addr, uint16_t data) {
     }
     
     // Program half-word
-    FLASH_Status flash_status = FLASH_ProgramHalfWord(addr, data);
+    config_map_size = 0;
+    FLASH_Status flash_status = Flash_ProgramHalfWordRaw(addr, data);
     
     // Lock flash
     Flash_LockInternal();
@@ -194,8 +359,12 @@ FlashStatus Flash_WriteWord(uint32_t addr, uint32_t data) {
         return status;
     }
     
-    // Program word
-    FLASH_Status flash_status = FLASH_ProgramWord(addr, data);
+    // Program word (2 half-words)
+    config_map_size = 0;
+    FLASH_Status flash_status = Flash_ProgramHalfWordRaw(addr, (uint16_t)data);
+    if (flash_status == FLASH_COMPLETE) {
+        flash_status = Flash_ProgramHalfWordRaw(addr + 2, (uint16_t)(data >> 16));
+    }
     
     // Lock flash
     Flash_LockInternal();
@@ -220,16 +389,18 @@ uint16_t Flash_ReadString(uint32_t addr, char* buffer, uint16_t max_len) {
         return 0;
     }
     
+    // อ่านผ่าน pointer โดยตรง ไม่เกินท้าย storage area
+    const char* src = (const char*)addr;
+    uint32_t avail = FLASH_STORAGE_START_ADDR + FLASH_STORAGE_SIZE - addr;
     uint16_t i;
-    for (i = 0; i < max_len - 1; i++) {
-        char c = (char)Flash_ReadByte(addr + i);
-        buffer[i] = c;
-        if (c == '\0') {
+    for (i = 0; i < max_len - 1 && i < avail; i++) {
+        buffer[i] = src[i];
+        if (src[i] == '\0') {
             return i;  // Return length without null terminator
         }
     }
     
-    buffer[max_len - 1] = '\0';  // Ensure null termination
+    buffer[i] = '\0';  // Ensure null termination
     return i;
 }
 
@@ -247,15 +418,7 @@ FlashStatus Flash_WriteString(uint32_t addr, const char* str) {
     }
     
     // Write string including null terminator
-    FlashStatus status;
-    for (uint16_t i = 0; i <= len; i++) {
-        status = Flash_WriteByte(addr + i, (uint8_t)str[i]);
-        if (status != FLASH_OK) {
-            return status;
-        }
-    }
-    
-    return FLASH_OK;
+    return Flash_WriteStruct(addr, str, len + 1);
 }
 
 /* ========== Struct/Buffer Functions ========== */
@@ -268,14 +431,12 @@ FlashStatus Flash_ReadStruct(uint32_t addr, void* ptr, uint16_t size) {
         return FLASH_ERROR_INVALID;
     }
     
-    if (size > FLASH_PAGE_SIZE) {
+    if (size > FLASH_PAGE_SIZE || !Flash_IsRangeValid(addr, size)) {
         return FLASH_ERROR_RANGE;
     }
     
-    uint8_t* dest = (uint8_t*)ptr;
-    for (uint16_t i = 0; i < size; i++) {
-        dest[i] = Flash_ReadByte(addr + i);
-    }
+    // Flash เป็น memory-mapped: memcpy() copy ทีละ word เมื่อ align
+    memcpy(ptr, (const void*)addr, size);
     
     return FLASH_OK;
 }
@@ -288,21 +449,29 @@ FlashStatus Flash_WriteStruct(uint32_t addr, const void* ptr, uint16_t size) {
         return FLASH_ERROR_INVALID;
     }
     
-    if (size > FLASH_PAGE_SIZE) {
+    if (size > FLASH_PAGE_SIZE ||
+        addr + size > FLASH_STORAGE_START_ADDR + FLASH_STORAGE_SIZE) {
         return FLASH_ERROR_RANGE;
     }
     
     const uint8_t* src = (const uint8_t*)ptr;
-    FlashStatus status;
     
-    for (uint16_t i = 0; i < size; i++) {
-        status = Flash_WriteByte(addr + i, src[i]);
-        if (status != FLASH_OK) {
-            return status;
-        }
+    // ทั้ง page: fast page program ครั้งเดียว
+    if (size == FLASH_PAGE_SIZE && Flash_IsPageAddress(addr)) {
+        return Flash_ProgramPageAt(addr, src);
     }
     
-    return FLASH_OK;
+    // บางส่วน: โปรแกรมทีละ half-word (byte ขอบนอกช่วงใช้ค่าเดิมใน Flash)
+    uint32_t end = addr + size;
+    FlashStatus status = FLASH_OK;
+    
+    for (uint32_t a = addr & ~0x01UL; a < end && status == FLASH_OK; a += 2) {
+        uint8_t low = (a >= addr) ? src[a - addr] : Flash_ReadByte(a);
+        uint8_t high = (a + 1 < end) ? src[a + 1 - addr] : Flash_ReadByte(a + 1);
+        status = Flash_WriteHalfWord(a, (uint16_t)(low | ((uint16_t)high << 8)));
+    }
+    
+    return status;
 }
 
 /* ========== Configuration Management ========== */
@@ -318,21 +487,14 @@ FlashStatus Flash_SaveConfig(const void* ptr, uint16_t size) {
     // Calculate CRC
     uint16_t crc = Flash_CalculateCRC16((const uint8_t*)ptr, size);
     
-    // Erase config page
-    FlashStatus status = Flash_ErasePage(FLASH_CONFIG_PAGE);
-    if (status != FLASH_OK) {
-        return status;
-    }
-    
-    // Write config data
-    status = Flash_WriteStruct(FLASH_CONFIG_ADDR, ptr, size);
-    if (status != FLASH_OK) {
-        return status;
-    }
+    // ประกอบทั้ง page ใน RAM: config + CRC (little-endian) + 0xFF
+    uint8_t page_buffer[FLASH_PAGE_SIZE];
+    memset(page_buffer, 0xFF, sizeof(page_buffer));
+    memcpy(page_buffer, ptr, size);
+    page_buffer[size] = (uint8_t)(crc & 0xFF);
+    page_buffer[size + 1] = (uint8_t)(crc >> 8);
     
-    // Write CRC at the end
-    status = Flash_WriteHalfWord(FLASH_CONFIG_ADDR + size, crc);
-    return status;
+    return Flash_ProgramPage(FLASH_CONFIG_PAGE, page_buffer);
 }
 
 /**
@@ -348,14 +510,8 @@ bool Flash_LoadConfig(void* ptr, uint16_t size) {
         return false;
     }
     
-    // Read stored CRC
-    uint16_t stored_crc = Flash_ReadHalfWord(FLASH_CONFIG_ADDR + size);
-    
-    // Calculate CRC of read data
-    uint16_t calculated_crc = Flash_CalculateCRC16((const uint8_t*)ptr, size);
-    
-    // Compare CRCs
-    return (stored_crc == calculated_crc);
+    // ตรวจ CRC บน flash (ผลถูกจำไว้ให้ Flash_MapConfig())
+    return Flash_MapConfig(size) != NULL;
 }
 
 /**
@@ -373,26 +529,67 @@ bool Flash_IsConfigValid(void) {
     return true;
 }
 
-/* ========== Utility Functions ========== */
+/* ========== Zero-copy Read Functions ========== */
 
 /**
- * @brief คำนวณ CRC16-CCITT checksum
+ * @brief ตรวจช่วง address แล้วคืน const pointer เข้า flash
  */
-uint16_t Flash_CalculateCRC16(const uint8_t* data, uint16_t len) {
-    uint16_t crc = 0xFFFF;  // Initial value
-    
-    for (uint16_t i = 0; i < len; i++) {
-        crc ^= (uint16_t)data[i] << 8;
-        for (uint8_t j = 0; j < 8; j++) {
-            if (crc & 0x8000) {
-                crc = (crc << 1) ^ 0x1021;  // Polynomial
-            } else {
-                crc <<= 1;
-            }
+const void* Flash_Map(uint32_t addr, uint16_t size, uint8_t align) {
+    if (size == 0 || !Flash_IsRangeValid(addr, size)) {
+        return NULL;
+    }
+    if (align > 1 && (addr & (align - 1)) != 0) {
+        return NULL;
+    }
+    return (const void*)addr;
+}
+
+/**
+ * @brief const pointer ไปยัง string ใน flash
+ */
+const char* Flash_MapString(uint32_t addr) {
+    if (!Flash_IsAddressValid(addr)) {
+        return NULL;
+    }
+    
+    const char* str = (const char*)addr;
+    uint32_t avail = FLASH_STORAGE_START_ADDR + FLASH_STORAGE_SIZE - addr;
+    for (uint16_t i = 0; i <= FLASH_MAX_STRING_LENGTH && i < avail; i++) {
+        if (str[i] == '\0') {
+            return str;
+        }
+    }
+    return NULL;  // erased (0xFF) หรือไม่ได้เขียนด้วย Flash_WriteString()
+}
+
+/**
+ * @brief const pointer ไปยัง configuration ที่ CRC ถูกต้อง
+ */
+const void* Flash_MapConfig(uint16_t size) {
+    if (size == 0 || size > (FLASH_CONFIG_SIZE - 2)) {
+        return NULL;
+    }
+    
+    if (config_map_size != size) {
+        // CRC ต่อท้าย config (little-endian, size อาจเป็นเลขคี่)
+        const uint8_t* config = (const uint8_t*)FLASH_CONFIG_ADDR;
+        uint16_t stored_crc = config[size] | ((uint16_t)config[size + 1] << 8);
+        if (Flash_CalculateCRC16(config, size) != stored_crc) {
+            return NULL;
         }
+        config_map_size = (uint8_t)size;
     }
     
-    return crc;
+    return (const void*)FLASH_CONFIG_ADDR;
+}
+
+/* ========== Utility Functions ========== */
+
+/**
+ * @brief คำนวณ CRC16-CCITT checksum
+ */
+uint16_t Flash_CalculateCRC16(const uint8_t* data, uint16_t len) {
+    return CRC16_CCITT(data, len);  // poly 0x1021, init 0xFFFF
 }
 
 /**
@@ -407,8 +604,8 @@ bool Flash_IsAddressValid(uint32_t addr) {
  * @brief แปลง page number เป็น address
  */
 uint32_t Flash_GetPageAddress(uint8_t page_num) {
-    // Validate page number (254 or 255 only)
-    if (page_num != FLASH_CONFIG_PAGE && page_num != FLASH_DATA_PAGE) {
+    // Validate page number (ภายใน storage area)
+    if ((uint16_t)(page_num - FLASH_STORAGE_PAGE_START) >= FLASH_STORAGE_PAGE_COUNT) {
         return 0;
     }
     return FLASH_BASE_ADDRESS + (page_num * FLASH_PAGE_SIZE);
@@ -424,69 +621,147 @@ FlashStatus Flash_WriteByteWithErase(uint32_t addr, uint8_t data) {
         return FLASH_ERROR_RANGE;
     }
     
-    // Determine which page this address belongs to
-    uint32_t page_addr = addr & ~(FLASH_PAGE_SIZE - 1);  // Align to page boundary
-    uint8_t page_num = (addr - FLASH_BASE_ADDRESS) / FLASH_PAGE_SIZE;
-    
-    // Read entire page into buffer
-    uint8_t page_buffer[FLASH_PAGE_SIZE];
-    for (uint16_t i = 0; i < FLASH_PAGE_SIZE; i++) {
-        page_buffer[i] = Flash_ReadByte(page_addr + i);
+    return Flash_ModifyPage(addr, &data, 1);
+}
+
+/**
+ * @brief เขียน half-word พร้อม auto-erase
+ */
+FlashStatus Flash_WriteHalfWordWithErase(uint32_t addr, uint16_t data) {
+    if (!Flash_IsAddressValid(addr) || (addr & 0x01)) {
+        return FLASH_ERROR_ALIGN;
     }
     
-    // Modify the byte
-    uint16_t offset = addr - page_addr;
-    page_buffer[offset] = data;
-    
-    // Erase page
-    FlashStatus status = Flash_ErasePage(page_num);
-    if (status != FLASH_OK) {
-        return status;
+    // Little-endian, erase/program page ครั้งเดียว
+    uint8_t bytes[2] = { (uint8_t)(data & 0xFF), (uint8_t)(data >> 8) };
+    return Flash_ModifyPage(addr, bytes, sizeof(bytes));
+}
+
+/**
+ * @brief เขียน word พร้อม auto-erase
+ */
+FlashStatus Flash_WriteWordWithErase(uint32_t addr, uint32_t data) {
+    if (!Flash_IsAddressValid(addr) || (addr & 0x03)) {
+        return FLASH_ERROR_ALIGN;
     }
     
-    // Write buffer back
-    for (uint16_t i = 0; i < FLASH_PAGE_SIZE; i++) {
-        status = Flash_WriteByte(page_addr + i, page_buffer[i]);
-        if (status != FLASH_OK) {
-            return status;
-        }
+    // Little-endian, erase/program page ครั้งเดียว
+    uint8_t bytes[4] = {
+        (uint8_t)(data & 0xFF), (uint8_t)(data >> 8),
+        (uint8_t)(data >> 16), (uint8_t)(data >> 24)
+    };
+    return Flash_ModifyPage(addr, bytes, sizeof(bytes));
+}
+
+/* ========== Transaction Functions ========== */
+
+/**
+ * @brief เริ่ม transaction
+ */
+FlashStatus Flash_BeginTransaction(void) {
+    if (txn_active) {
+        return FLASH_ERROR_BUSY;
     }
     
+    for (uint8_t i = 0; i < SIMPLE_FLASH_TXN_PAGES; i++) {
+        txn_page_addr[i] = 0;
+    }
+    txn_active = 1;
     return FLASH_OK;
 }
 
 /**
- * @brief เขียน half-word พร้อม auto-erase
+ * @brief แก้ไขข้อมูลใน page cache
  */
-FlashStatus Flash_WriteHalfWordWithErase(uint32_t addr, uint16_t data) {
-    if (!Flash_IsAddressValid(addr) || (addr & 0x01)) {
-        return FLASH_ERROR_ALIGN;
+FlashStatus Flash_TxnWrite(uint32_t addr, const void* data, uint16_t len) {
+    if (!txn_active || data == NULL) {
+        return FLASH_ERROR_INVALID;
+    }
+    if (!Flash_IsAddressValid(addr) ||
+        addr + len > FLASH_STORAGE_START_ADDR + FLASH_STORAGE_SIZE) {
+        return FLASH_ERROR_RANGE;
     }
     
-    // Use byte write for each byte
-    FlashStatus status = Flash_WriteByteWithErase(addr, (uint8_t)(data & 0xFF));
-    if (status != FLASH_OK) {
-        return status;
+    // นับ slot ที่ต้องใช้ก่อนแก้ cache: FLASH_ERROR_FULL ต้องไม่ทิ้ง page แรกที่แก้ไปครึ่งเดียว
+    uint8_t free_slots = 0;
+    for (uint8_t i = 0; i < SIMPLE_FLASH_TXN_PAGES; i++) {
+        if (txn_page_addr[i] == 0) free_slots++;
+    }
+    for (uint32_t page_addr = addr & ~(FLASH_PAGE_SIZE - 1UL); page_addr < addr + len;
+         page_addr += FLASH_PAGE_SIZE) {
+        uint8_t cached = 0;
+        for (uint8_t i = 0; i < SIMPLE_FLASH_TXN_PAGES; i++) {
+            if (txn_page_addr[i] == page_addr) cached = 1;
+        }
+        if (!cached) {
+            if (free_slots == 0) return FLASH_ERROR_FULL;
+            free_slots--;
+        }
     }
     
-    return Flash_WriteByteWithErase(addr + 1, (uint8_t)(data >> 8));
+    const uint8_t* src = (const uint8_t*)data;
+    
+    while (len > 0) {
+        uint32_t page_addr = addr & ~(FLASH_PAGE_SIZE - 1UL);
+        uint8_t offset = (uint8_t)(addr - page_addr);
+        uint16_t chunk = FLASH_PAGE_SIZE - offset;
+        if (chunk > len) chunk = len;
+        
+        // หา slot ของ page นี้ หรือ slot ว่างแรก
+        uint8_t slot = SIMPLE_FLASH_TXN_PAGES;
+        for (uint8_t i = 0; i < SIMPLE_FLASH_TXN_PAGES; i++) {
+            if (txn_page_addr[i] == page_addr) {
+                slot = i;
+                break;
+            }
+            if (txn_page_addr[i] == 0 && slot == SIMPLE_FLASH_TXN_PAGES) {
+                slot = i;
+            }
+        }
+        
+        // Page ใหม่: โหลดค่าปัจจุบันจาก Flash
+        if (txn_page_addr[slot] != page_addr) {
+            memcpy(txn_page_data[slot], (const void*)page_addr, FLASH_PAGE_SIZE);
+            txn_page_addr[slot] = page_addr;
+        }
+        
+        memcpy(txn_page_data[slot] + offset, src, chunk);
+        addr += chunk;
+        src += chunk;
+        len -= chunk;
+    }
+    
+    return FLASH_OK;
 }
 
 /**
- * @brief เขียน word พร้อม auto-erase
+ * @brief เขียน page ที่แก้ไขลง Flash (1 erase + 1 program ต่อ page)
  */
-FlashStatus Flash_WriteWordWithErase(uint32_t addr, uint32_t data) {
-    if (!Flash_IsAddressValid(addr) || (addr & 0x03)) {
-        return FLASH_ERROR_ALIGN;
+FlashStatus Flash_Commit(void) {
+    if (!txn_active) {
+        return FLASH_ERROR_INVALID;
     }
     
-    // Write as two half-words
-    FlashStatus status = Flash_WriteHalfWordWithErase(addr, (uint16_t)(data & 0xFFFF));
-    if (status != FLASH_OK) {
-        return status;
+    FlashStatus status = FLASH_OK;
+    for (uint8_t i = 0; i < SIMPLE_FLASH_TXN_PAGES && status == FLASH_OK; i++) {
+        uint32_t page_addr = txn_page_addr[i];
+        if (page_addr == 0) continue;
+        
+        // Page ที่ค่าไม่เปลี่ยนไม่ต้อง erase
+        if (memcmp((const void*)page_addr, txn_page_data[i], FLASH_PAGE_SIZE) != 0) {
+            status = Flash_ProgramPageAt(page_addr, txn_page_data[i]);
+        }
     }
     
-    return Flash_WriteHalfWordWithErase(addr + 2, (uint16_t)(data >> 16));
+    txn_active = 0;
+    return status;
+}
+
+/**
+ * @brief ยกเลิก transaction (ไม่เขียนอะไรลง Flash)
+ */
+void Flash_AbortTransaction(void) {
+    txn_active = 0;
 }
 
 /* ========== Private Functions ========== */
@@ -506,6 +781,49 @@ static void Flash_LockInternal(void) {
     FLASH_Lock();
 }
 
+/**
+ * @brief Lock fast programming mode และ flash controller
+ */
+static void Flash_LockFastInternal(void) {
+    FLASH_Lock_Fast();
+    FLASH_Lock();
+}
+
+/**
+ * @brief ตรวจว่าเป็นต้น page (align 64 bytes) ภายใน Flash 16KB
+ */
+static bool Flash_IsPageAddress(uint32_t page_addr) {
+    return (page_addr >= FLASH_BASE_ADDRESS &&
+            page_addr < FLASH_BASE_ADDRESS + (FLASH_TOTAL_PAGES * FLASH_PAGE_SIZE) &&
+            (page_addr & (FLASH_PAGE_SIZE - 1)) == 0);
+}
+
+/**
+ * @brief ตรวจว่าทั้งช่วง [addr, addr + size) อยู่ใน storage area
+ */
+static bool Flash_IsRangeValid(uint32_t addr, uint16_t size) {
+    return (Flash_IsAddressValid(addr) &&
+            size <= FLASH_STORAGE_SIZE - (addr - FLASH_STORAGE_START_ADDR));
+}
+
+/**
+ * @brief Read-modify-write ภายใน page เดียว (ข้าม erase ถ้าค่าเท่าเดิม)
+ */
+static FlashStatus Flash_ModifyPage(uint32_t addr, const uint8_t* data, uint8_t len) {
+    uint32_t page_addr = addr & ~(FLASH_PAGE_SIZE - 1UL);
+    uint8_t offset = (uint8_t)(addr - page_addr);
+    
+    if (memcmp((const void*)addr, data, len) == 0) {
+        return FLASH_OK;
+    }
+    
+    uint8_t page_buffer[FLASH_PAGE_SIZE];
+    memcpy(page_buffer, (const void*)page_addr, FLASH_PAGE_SIZE);
+    memcpy(page_buffer + offset, data, len);
+    
+    return Flash_ProgramPageAt(page_addr, page_buffer);
+}
+
 /**
  * @brief Wait for flash operation to complete
  */
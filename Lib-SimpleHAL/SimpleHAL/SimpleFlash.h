@@ -1,8 +1,8 @@
 /**
  * @file SimpleFlash.h
  * @brief Simple Flash Storage Library สำหรับ CH32V003
- * @version 1.0
- * @date 2025-12-21
+ * @version 1.6
+ * @date 2026-10-14
  * 
  * @details
  * Library สำหรับจัดเก็บข้อมูล configuration และข้อความใน Flash memory
@@ -11,6 +11,10 @@
  * **คุณสมบัติ:**
  * - อ่าน/เขียนข้อมูล byte, half-word (16-bit), word (32-bit)
  * - จัดเก็บ string และ struct
+ * - Zero-copy read: const pointer เข้า flash โดยตรง (Flash_MapConst(), Flash_MapConfig())
+ * - Fast page program: erase + เขียน 64 bytes ในครั้งเดียว (Flash_ProgramPage())
+ * - Transaction: รวมหลายการแก้ไขเป็น 1 erase + 1 program ต่อ page (Flash_BeginTransaction())
+ * - RAM-resident erase/program (SIMPLE_FLASH_RAMFUNC): IRQ สำคัญทำงานต่อได้ระหว่าง erase
  * - Configuration management พร้อม CRC validation
  * - Wear leveling support
  * - Factory reset capability
@@ -19,6 +23,7 @@
  * - CH32V003 มี Flash 16KB (256 pages × 64 bytes/page)
  * - Write endurance: ~10,000-80,000 cycles ต่อ page
  * - ต้อง erase ทั้ง page (64 bytes) ก่อนเขียนข้อมูลใหม่
+ * - Standard erase ของ SPL (FLASH_ErasePage()) ลบทีละ 1KB: library ใช้ fast erase 64 bytes เสมอ
  * - การเขียนทำได้ครั้งละ 16-bit หรือ 32-bit
  * - สำหรับข้อมูลที่เปลี่ยนบ่อยมาก แนะนำใช้ external EEPROM
  * 
@@ -28,6 +33,34 @@
  * - Page 254: Configuration storage (64 bytes)
  * - Page 255: General data storage (64 bytes)
  * 
+ * **Storage region จาก linker script (SIMPLE_FLASH_STORAGE_LINKER = 1):**
+ * - ขนาด/ตำแหน่งมาจาก symbols _storage_start / _storage_end (เช่น 1-4KB สำหรับ SimpleKV หรือ logger)
+ * - 2 pages สุดท้ายของ region เป็น config / data page, pages ที่เหลือเริ่มที่ FLASH_STORAGE_PAGE_START
+ * - Linker ตัด FLASH region ให้เล็กลง: code ที่โตจนทับ storage จะ link ไม่ผ่าน ("region FLASH overflowed")
+ * 
+ * แก้ Link.ld ของโปรเจกต์ (ตัวอย่าง 1KB ท้าย flash):
+ * @code
+ * MEMORY
+ * {
+ *     FLASH (rx)   : ORIGIN = 0x00000000, LENGTH = 16K - 1K
+ *     STORAGE (r)  : ORIGIN = 0x00000000 + 16K - 1K, LENGTH = 1K
+ *     RAM (xrw)    : ORIGIN = 0x20000000, LENGTH = 2K
+ * }
+ * 
+ * SECTIONS
+ * {
+ *     ...
+ *     .storage (NOLOAD) :
+ *     {
+ *         PROVIDE(_storage_start = .);
+ *         KEEP(*(.storage .storage.*))
+ *         . = ORIGIN(STORAGE) + LENGTH(STORAGE);
+ *         PROVIDE(_storage_end = .);
+ *     } >STORAGE
+ *     ASSERT(_storage_start % 64 == 0, "storage region must be 64-byte aligned")
+ * }
+ * @endcode
+ * 
  * @example
  * // ตัวอย่างการใช้งานพื้นฐาน
  * #include "SimpleFlash.h"
@@ -66,6 +99,7 @@ extern "C" {
 #endif
 
 #include <ch32v00x.h>
+#include "SimpleHAL_Config.h"
 #include "ch32v00x_flash.h"
 #include <stdint.h>
 #include <stdbool.h>
@@ -81,22 +115,41 @@ extern "C" {
 #define FLASH_BASE_ADDRESS           0x08000000 /**< Flash base address */
 
 /**
- * @brief Flash storage area configuration
- * @note ใช้ last 2 pages (254-255) สำหรับเก็บข้อมูล
+ * @brief 1 = ใช้ storage region จาก linker script (_storage_start / _storage_end)
+ * @note 0 = pages 254-255 แบบเดิม (ใช้กับ Link.ld ของ SDK ได้โดยไม่ต้องแก้)
  */
+#ifndef SIMPLE_FLASH_STORAGE_LINKER
+#define SIMPLE_FLASH_STORAGE_LINKER  0
+#endif
+
+/**
+ * @brief Flash storage area configuration
+ * @note ค่าเริ่มต้นใช้ last 2 pages (254-255) สำหรับเก็บข้อมูล
+ */
+#if SIMPLE_FLASH_STORAGE_LINKER
+extern uint8_t _storage_start[];               /**< จาก linker script */
+extern uint8_t _storage_end[];
+
+/* Link.ld ของ SDK ใช้ ORIGIN = 0 (alias ของ 0x08000000): แปลงเป็น address จริง */
+#define FLASH_STORAGE_START_ADDR     (FLASH_BASE_ADDRESS + ((uint32_t)_storage_start & 0x00FFFFFF))
+#define FLASH_STORAGE_SIZE           ((uint32_t)(_storage_end - _storage_start))
+#define FLASH_STORAGE_PAGE_START     ((uint8_t)((FLASH_STORAGE_START_ADDR - FLASH_BASE_ADDRESS) / FLASH_PAGE_SIZE))
+#define FLASH_STORAGE_PAGE_COUNT     ((uint16_t)(FLASH_STORAGE_SIZE / FLASH_PAGE_SIZE))
+#else
 #define FLASH_STORAGE_PAGE_START     254       /**< Page เริ่มต้นสำหรับเก็บข้อมูล */
 #define FLASH_STORAGE_PAGE_COUNT     2         /**< จำนวน pages สำหรับเก็บข้อมูล */
 #define FLASH_STORAGE_START_ADDR     (FLASH_BASE_ADDRESS + (FLASH_STORAGE_PAGE_START * FLASH_PAGE_SIZE))
 #define FLASH_STORAGE_SIZE           (FLASH_STORAGE_PAGE_COUNT * FLASH_PAGE_SIZE)  /**< 128 bytes */
+#endif
 
 /**
- * @brief Flash storage sections
+ * @brief Flash storage sections (2 pages สุดท้ายของ storage area)
  */
-#define FLASH_CONFIG_PAGE            254       /**< Page สำหรับ configuration */
+#define FLASH_CONFIG_PAGE            ((uint8_t)(FLASH_STORAGE_PAGE_START + FLASH_STORAGE_PAGE_COUNT - 2))  /**< Page สำหรับ configuration */
 #define FLASH_CONFIG_ADDR            (FLASH_BASE_ADDRESS + (FLASH_CONFIG_PAGE * FLASH_PAGE_SIZE))
 #define FLASH_CONFIG_SIZE            FLASH_PAGE_SIZE  /**< 64 bytes */
 
-#define FLASH_DATA_PAGE              255       /**< Page สำหรับ general data */
+#define FLASH_DATA_PAGE              ((uint8_t)(FLASH_STORAGE_PAGE_START + FLASH_STORAGE_PAGE_COUNT - 1))  /**< Page สำหรับ general data */
 #define FLASH_DATA_ADDR              (FLASH_BASE_ADDRESS + (FLASH_DATA_PAGE * FLASH_PAGE_SIZE))
 #define FLASH_DATA_SIZE              FLASH_PAGE_SIZE  /**< 64 bytes */
 
@@ -105,6 +158,42 @@ extern "C" {
  */
 #define FLASH_MAX_STRING_LENGTH      60        /**< ความยาว string สูงสุด (เหลือที่สำหรับ null + metadata) */
 
+/* ========== Configuration ========== */
+
+/**
+ * @brief จำนวน page ที่ transaction แก้ไขพร้อมกันได้ (RAM 68 bytes ต่อ page)
+ * @note 2 = แก้ได้ทั้ง config และ data page ใน transaction เดียว
+ */
+#ifndef SIMPLE_FLASH_TXN_PAGES
+#define SIMPLE_FLASH_TXN_PAGES       1
+#endif
+
+#if SIMPLE_FLASH_TXN_PAGES < 1 || SIMPLE_FLASH_TXN_PAGES > 4
+#error "SIMPLE_FLASH_TXN_PAGES must be 1-4"
+#endif
+
+/**
+ * @brief วาง erase/program loops ใน RAM (.highcode)
+ *
+ * @details ระหว่าง erase/program (หลาย ms) CPU ที่ fetch คำสั่งจาก flash จะค้างทั้งหมด
+ * รวมถึงทุก interrupt เมื่อเปิดใช้ CPU รอ busy flag จาก RAM แทน และ interrupts
+ * ที่ลงทะเบียนด้วย Flash_SetRamIRQ() (handler ใน RAM) ทำงานต่อได้ระหว่าง KV GC/logger erase
+ * ใช้ RAM เพิ่มราว 200 bytes
+ */
+#ifndef SIMPLE_FLASH_RAMFUNC
+#define SIMPLE_FLASH_RAMFUNC         0
+#endif
+
+/**
+ * @brief วางฟังก์ชันใน RAM (section .highcode ที่ startup copy จาก flash)
+ *
+ * @note ฟังก์ชันที่ต้องทำงานระหว่าง erase ต้องไม่เรียกโค้ดหรืออ่าน const ที่อยู่ใน flash
+ *
+ * @example
+ * FLASH_RAMFUNC void motor_update_isr(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+ */
+#define FLASH_RAMFUNC  __attribute__((section(".highcode"), noinline))
+
 /* ========== Status Codes ========== */
 
 /**
@@ -121,7 +210,8 @@ typedef enum {
     FLASH_ERROR_ALIGN,         /**< Address alignment error */
     FLASH_ERROR_RANGE,         /**< Address out of range */
     FLASH_ERROR_CRC,           /**< CRC check failed */
-    FLASH_ERROR_INVALID        /**< Invalid parameter */
+    FLASH_ERROR_INVALID,       /**< Invalid parameter */
+    FLASH_ERROR_FULL           /**< Storage/transaction cache full */
 } FlashStatus;
 
 /* ========== Core Functions ========== */
@@ -131,6 +221,8 @@ typedef enum {
  * @return FLASH_OK ถ้าสำเร็จ
  * 
  * @note ต้องเรียกฟังก์ชันนี้ก่อนใช้งาน Flash storage
+ * @note SIMPLE_FLASH_STORAGE_LINKER = 1: คืน FLASH_ERROR_RANGE ถ้า region ไม่ align 64 bytes,
+ *       เล็กกว่า 2 pages หรืออยู่นอก flash 16KB
  * 
  * @example
  * Flash_Init();
@@ -150,16 +242,90 @@ FlashStatus Flash_EraseAll(void);
 
 /**
  * @brief ลบข้อมูลใน page ที่กำหนด
- * @param page_num หมายเลข page (254 หรือ 255)
+ * @param page_num หมายเลข page ใน storage area (ค่าเริ่มต้น 254 หรือ 255)
  * @return FLASH_OK ถ้าสำเร็จ
  * 
- * @note page_num ต้องเป็น 254 (config) หรือ 255 (data) เท่านั้น
+ * @note page_num ต้องอยู่ใน storage area (FLASH_STORAGE_PAGE_START ถึง FLASH_DATA_PAGE)
+ * @note ใช้ fast erase 64 bytes (ไม่กระทบ page ข้างเคียง)
  * 
  * @example
  * Flash_ErasePage(FLASH_CONFIG_PAGE);  // ลบ config page
  */
 FlashStatus Flash_ErasePage(uint8_t page_num);
 
+/* ========== Fast Page Functions ========== */
+
+/**
+ * @brief ลบ + เขียน page ใน storage area ทั้ง 64 bytes
+ * @param page_num หมายเลข page ใน storage area
+ * @param src ข้อมูล FLASH_PAGE_SIZE bytes ใน RAM (ไม่ต้อง align)
+ * @return FLASH_OK ถ้าสำเร็จ, FLASH_ERROR_VERIFY ถ้าอ่านกลับไม่ตรง
+ * 
+ * @note ใช้ fast programming: fast erase 64 bytes → โหลด page buffer 16 words
+ *       → program ครั้งเดียว (เร็วกว่าเขียนทีละ half-word 32 ครั้งมาก)
+ * @note Flash_SaveConfig() และ Flash_Write*WithErase() ใช้ฟังก์ชันนี้
+ * 
+ * @example
+ * uint8_t page[FLASH_PAGE_SIZE];
+ * memset(page, 0xFF, sizeof(page));
+ * memcpy(page, &settings, sizeof(settings));
+ * Flash_ProgramPage(FLASH_DATA_PAGE, page);
+ */
+FlashStatus Flash_ProgramPage(uint8_t page_num, const uint8_t* src);
+
+/**
+ * @brief Fast erase 1 page (64 bytes) ที่ address ใดก็ได้ใน Flash 16KB
+ * @param page_addr address ต้น page (align 64 bytes)
+ * @return FLASH_OK ถ้าสำเร็จ, FLASH_ERROR_ALIGN ถ้าไม่ใช่ต้น page
+ * 
+ * @warning ไม่จำกัดแค่ storage area: สำหรับ module ที่จอง page เอง (เช่น SimpleKV)
+ *          ระวังอย่าลบ page ของโปรแกรม
+ */
+FlashStatus Flash_ErasePageAt(uint32_t page_addr);
+
+/**
+ * @brief Fast erase + program 1 page (64 bytes) ที่ address ใดก็ได้ใน Flash 16KB
+ * @param page_addr address ต้น page (align 64 bytes)
+ * @param src ข้อมูล FLASH_PAGE_SIZE bytes (ต้องไม่อยู่ใน page ที่กำลังเขียน)
+ * @return FLASH_OK ถ้าสำเร็จ
+ * 
+ * @warning เหมือน Flash_ErasePageAt(): ไม่ตรวจว่าเป็น storage area
+ */
+FlashStatus Flash_ProgramPageAt(uint32_t page_addr, const uint8_t* src);
+
+/* ========== RAM-resident Functions ========== */
+
+/**
+ * @brief เขียน half-word ขณะ unlock อยู่ (แทน FLASH_ProgramHalfWord() ของ SPL)
+ * @param addr ที่อยู่ใน Flash (align 2 bytes, ยังไม่ถูกเขียนตั้งแต่ erase)
+ * @param data ข้อมูล
+ * @return FLASH_COMPLETE หรือ FLASH_ERROR_WRP
+ *
+ * @note ต้องเรียก FLASH_Unlock() ก่อน ไม่ lock และไม่ verify ให้ (สำหรับเขียนหลาย half-words ติดกัน)
+ * @note SIMPLE_FLASH_RAMFUNC = 1: รอ busy จาก RAM (SimpleKV และ SimpleLogger ใช้ฟังก์ชันนี้)
+ */
+FLASH_Status Flash_ProgramHalfWordRaw(uint32_t addr, uint16_t data);
+
+/**
+ * @brief ลงทะเบียน interrupt ที่ต้องทำงานระหว่าง erase/program (VTF channel 0-1)
+ * @param channel VTF channel (0 หรือ 1)
+ * @param irq หมายเลข interrupt
+ * @param handler handler ที่ประกาศด้วย FLASH_RAMFUNC, NULL = ยกเลิก
+ *
+ * @details VTF กระโดดไป handler โดยตรงไม่ต้องอ่าน vector table จาก flash
+ * Interrupts อื่นยังรอจน erase/program เสร็จเหมือนเดิม
+ *
+ * @note ใช้ร่วมกับ SIMPLE_FLASH_RAMFUNC = 1 และยังต้องเปิดด้วย NVIC_EnableIRQ()
+ *
+ * @example
+ * // ชื่อ handler อะไรก็ได้ (VTF มาก่อน vector table จึงแทน handler ของ SimpleHAL สำหรับ irq นั้น)
+ * FLASH_RAMFUNC void motor_update_isr(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+ *
+ * Flash_SetRamIRQ(0, TIM1_UP_IRQn, motor_update_isr);
+ * KV_Set(KEY_COUNT, &count, sizeof(count));  // PWM update ไม่สะดุดระหว่าง GC
+ */
+void Flash_SetRamIRQ(uint8_t channel, IRQn_Type irq, void (*handler)(void));
+
 /* ========== Basic Read/Write Functions ========== */
 
 /**
@@ -283,7 +449,9 @@ FlashStatus Flash_WriteString(uint32_t addr, const char* str);
  * @param addr ที่อยู่ใน Flash
  * @param ptr pointer ไปยัง struct/buffer ปลายทาง
  * @param size ขนาดของ struct/buffer (bytes)
- * @return FLASH_OK ถ้าสำเร็จ
+ * @return FLASH_OK ถ้าสำเร็จ, FLASH_ERROR_RANGE ถ้าช่วงเลยท้าย storage area
+ * 
+ * @note Copy ด้วย memcpy() จาก flash โดยตรง: ถ้าไม่ต้องแก้ค่าใช้ Flash_MapConst() แทน
  * 
  * @example
  * typedef struct {
@@ -303,8 +471,10 @@ FlashStatus Flash_ReadStruct(uint32_t addr, void* ptr, uint16_t size);
  * @param size ขนาดของ struct/buffer (bytes)
  * @return FLASH_OK ถ้าสำเร็จ
  * 
- * @warning ต้อง erase page ก่อนเขียน
+ * @warning ต้อง erase page ก่อนเขียน (ยกเว้นกรณีเต็ม page ด้านล่าง)
  * @note size ต้องไม่เกิน FLASH_PAGE_SIZE
+ * @note ถ้า addr เป็นต้น page และ size == FLASH_PAGE_SIZE จะใช้ Flash_ProgramPage() (erase ให้ในตัว)
+ * @note กรณีอื่นโปรแกรมทีละ half-word (แต่ละ half-word เขียนครั้งเดียว)
  * 
  * @example
  * MyData_t data = {.id = 123, .value = 456};
@@ -324,6 +494,8 @@ FlashStatus Flash_WriteStruct(uint32_t addr, const void* ptr, uint16_t size);
  * @note CRC16 จะถูกคำนวณและเขียนต่อท้าย struct อัตโนมัติ
  * @note struct ต้องมี field uint16_t crc เป็น field สุดท้าย
  * @note size ต้องไม่เกิน FLASH_CONFIG_SIZE - 2 (เหลือที่สำหรับ CRC)
+ * @note Erase page 254 ทุกครั้งที่บันทึก: ค่าที่บันทึกบ่อยให้ใช้ SimpleKV (KV_Set())
+ * @note ประกอบทั้ง page ใน RAM (64 bytes บน stack) แล้วเขียนด้วย Flash_ProgramPage() ครั้งเดียว
  * 
  * @example
  * typedef struct {
@@ -344,6 +516,7 @@ FlashStatus Flash_SaveConfig(const void* ptr, uint16_t size);
  * @return true ถ้าโหลดสำเร็จและ CRC ถูกต้อง, false ถ้าผิดพลาด
  * 
  * @note struct ต้องมี field uint16_t crc เป็น field สุดท้าย
+ * @note อ่านแค่บาง field ใช้ Flash_MapConfig() แทนได้ (ไม่ต้องมีสำเนาใน RAM)
  * 
  * @example
  * Config_t config;
@@ -374,6 +547,60 @@ bool Flash_LoadConfig(void* ptr, uint16_t size);
  */
 bool Flash_IsConfigValid(void);
 
+/* ========== Zero-copy Read Functions ========== */
+
+/**
+ * @brief ตรวจช่วง address แล้วคืน const pointer เข้า flash โดยตรง (ไม่ copy ลง RAM)
+ * @param addr ที่อยู่ใน storage area
+ * @param size ขนาด (bytes) ทั้งช่วงต้องอยู่ใน storage area
+ * @param align alignment ที่ต้องการ (1, 2, 4)
+ * @return pointer หรือ NULL ถ้าอยู่นอก storage area / ไม่ align
+ *
+ * @note Flash เป็น memory-mapped: อ่านผ่าน pointer เร็วเท่าอ่าน const ปกติ
+ * @warning ค่าที่ชี้เปลี่ยนตาม flash (หลัง erase จะเป็น 0xFF)
+ */
+const void* Flash_Map(uint32_t addr, uint16_t size, uint8_t align);
+
+/**
+ * @brief Flash_Map() แบบระบุ type: คืน const type* (ตรวจขนาดและ alignment ของ type ให้)
+ *
+ * @example
+ * const Calib_t* cal = Flash_MapConst(FLASH_DATA_ADDR, Calib_t);
+ * if (cal != NULL) {
+ *     offset = cal->offset;  // อ่าน field เดียว ไม่ copy ทั้ง struct
+ * }
+ */
+#define Flash_MapConst(addr, type) \
+    ((const type*)Flash_Map((addr), sizeof(type), __alignof__(type)))
+
+/**
+ * @brief const pointer ไปยัง string ใน flash
+ * @param addr ที่อยู่ใน storage area
+ * @return pointer, หรือ NULL ถ้าไม่พบ null terminator ภายใน FLASH_MAX_STRING_LENGTH + 1 bytes
+ *         (เช่น page ที่ erase แล้ว)
+ *
+ * @example
+ * const char* name = Flash_MapString(FLASH_DATA_ADDR);
+ * if (name != NULL) printf("Name: %s\n", name);
+ */
+const char* Flash_MapString(uint32_t addr);
+
+/**
+ * @brief const pointer ไปยัง configuration ที่ CRC ถูกต้อง
+ * @param size ขนาดของ struct (ไม่รวม CRC field) เหมือน Flash_LoadConfig()
+ * @return pointer ไปยัง FLASH_CONFIG_ADDR, หรือ NULL ถ้าไม่มี config / CRC ไม่ถูกต้อง
+ *
+ * @note ตรวจ CRC ครั้งแรกครั้งเดียวแล้วจำไว้ จนกว่าจะเขียน/erase ผ่าน SimpleFlash
+ * @note ไม่ต้องมี struct สำเนาใน RAM
+ *
+ * @example
+ * const Config_t* cfg = Flash_MapConfig(sizeof(Config_t) - sizeof(uint16_t));
+ * if (cfg != NULL) {
+ *     PWM_SetDuty(cfg->brightness);
+ * }
+ */
+const void* Flash_MapConfig(uint16_t size);
+
 /* ========== Utility Functions ========== */
 
 /**
@@ -404,7 +631,7 @@ bool Flash_IsAddressValid(uint32_t addr);
 
 /**
  * @brief แปลง page number เป็น address
- * @param page_num หมายเลข page (254 หรือ 255)
+ * @param page_num หมายเลข page ใน storage area (ค่าเริ่มต้น 254 หรือ 255)
  * @return address ของ page, หรือ 0 ถ้า page_num ไม่ถูกต้อง
  * 
  * @example
@@ -499,8 +726,8 @@ uint32_t Flash_GetPageAddress(uint8_t page_num);
  * @note ฟังก์ชันนี้จะ:
  *       1. อ่าน page ทั้งหมดมาเก็บใน buffer
  *       2. แก้ไข byte ที่ต้องการ
- *       3. Erase page
- *       4. เขียน buffer กลับลง Flash
+ *       3. Erase + เขียน buffer กลับด้วย Flash_ProgramPage()
+ * @note ค่าเท่าเดิมอยู่แล้วจะไม่ erase (ไม่สิ้นเปลือง endurance)
  * @warning ใช้ RAM 64 bytes สำหรับ buffer
  * @warning ช้ากว่าการเขียนปกติ เพราะต้อง erase ทั้ง page
  * 
@@ -515,7 +742,7 @@ FlashStatus Flash_WriteByteWithErase(uint32_t addr, uint8_t data);
  * @param data ข้อมูลที่ต้องการเขียน
  * @return FLASH_OK ถ้าสำเร็จ
  * 
- * @note ดูรายละเอียดใน Flash_WriteByteWithErase()
+ * @note ดูรายละเอียดใน Flash_WriteByteWithErase() (erase page ครั้งเดียวต่อการเรียก)
  */
 FlashStatus Flash_WriteHalfWordWithErase(uint32_t addr, uint16_t data);
 
@@ -525,10 +752,56 @@ FlashStatus Flash_WriteHalfWordWithErase(uint32_t addr, uint16_t data);
  * @param data ข้อมูลที่ต้องการเขียน
  * @return FLASH_OK ถ้าสำเร็จ
  * 
- * @note ดูรายละเอียดใน Flash_WriteByteWithErase()
+ * @note ดูรายละเอียดใน Flash_WriteByteWithErase() (erase page ครั้งเดียวต่อการเรียก)
  */
 FlashStatus Flash_WriteWordWithErase(uint32_t addr, uint32_t data);
 
+/* ========== Transaction Functions ========== */
+
+/**
+ * @brief เริ่ม transaction: การแก้ไขถัดไปเก็บใน page cache (RAM) จนกว่าจะ commit
+ * @return FLASH_OK ถ้าสำเร็จ, FLASH_ERROR_BUSY ถ้ามี transaction ค้างอยู่
+ * 
+ * @note เหมาะกับการแก้หลายค่าใน page เดียว: Write*WithErase() erase ทุกครั้งที่เรียก
+ *       แต่ transaction erase 1 ครั้งต่อ page ไม่ว่าจะแก้กี่ค่า
+ * 
+ * @example
+ * Flash_BeginTransaction();
+ * Flash_TxnWrite(FLASH_DATA_ADDR + 0, &counter, sizeof(counter));
+ * Flash_TxnWrite(FLASH_DATA_ADDR + 4, &flags, sizeof(flags));
+ * Flash_TxnWrite(FLASH_DATA_ADDR + 8, name, 16);
+ * Flash_Commit();  // 1 erase + 1 page program
+ */
+FlashStatus Flash_BeginTransaction(void);
+
+/**
+ * @brief แก้ไขข้อมูลใน transaction (ยังไม่เขียนลง Flash)
+ * @param addr ที่อยู่ใน storage area (ไม่ต้อง align)
+ * @param data ข้อมูลต้นทาง
+ * @param len จำนวน bytes (ข้าม page ได้)
+ * @return FLASH_OK ถ้าสำเร็จ
+ * @return FLASH_ERROR_FULL ถ้าแตะ page เกิน SIMPLE_FLASH_TXN_PAGES (cache ไม่ถูกแก้เลย)
+ * @return FLASH_ERROR_INVALID ถ้ายังไม่ได้ Flash_BeginTransaction()
+ * 
+ * @note การอ่านจาก Flash ระหว่าง transaction ยังได้ค่าเดิม (ก่อน commit)
+ */
+FlashStatus Flash_TxnWrite(uint32_t addr, const void* data, uint16_t len);
+
+/**
+ * @brief เขียน page ที่แก้ไขลง Flash และจบ transaction
+ * @return FLASH_OK ถ้าสำเร็จ
+ * 
+ * @note แต่ละ page: fast erase + page program ครั้งเดียว (Flash_ProgramPageAt())
+ * @note Page ที่ค่าสุดท้ายเท่าเดิมไม่ถูก erase
+ * @warning ไม่ใช่ power-fail safe: ไฟดับระหว่าง commit อาจได้ page ว่าง หรือ page แรกใหม่ page ที่สองเก่า
+ */
+FlashStatus Flash_Commit(void);
+
+/**
+ * @brief ยกเลิก transaction (ทิ้งการแก้ไขทั้งหมด)
+ */
+void Flash_AbortTransaction(void);
+
 #ifdef __cplusplus
 }
 #endif
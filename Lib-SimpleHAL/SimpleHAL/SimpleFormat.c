@@ -0,0 +1,119 @@
+/**
+ * @file SimpleFormat.c
+ * @brief Division-free Number Formatting Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleFormat.h"
+
+/* ========== Private Variables ========== */
+
+static const uint32_t format_pow10[10] = {
+    1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+    10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+static const char format_hex_lower[16] = "0123456789abcdef";
+static const char format_hex_upper[16] = "0123456789ABCDEF";
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief แปลง unsigned integer พร้อมเติมหน้าให้ครบความกว้าง
+ */
+uint8_t Format_UIntPad(char* buffer, uint32_t value, uint8_t width, char pad) {
+    uint8_t len = 0;
+    uint8_t started = 0;
+
+    for (uint8_t i = 0; i < 10; i++) {
+        uint32_t p = format_pow10[i];
+        char digit = '0';
+
+        // ลบกำลังของ 10 แทนการหาร (สูงสุด 9 ครั้งต่อหลัก)
+        while (value >= p) {
+            value -= p;
+            digit++;
+        }
+
+        if (started || digit != '0' || i == 9) {
+            started = 1;
+            buffer[len++] = digit;
+        } else if ((uint8_t)(10 - i) <= width) {
+            buffer[len++] = pad;
+        }
+    }
+
+    buffer[len] = '\0';
+    return len;
+}
+
+/**
+ * @brief แปลง unsigned integer เป็น decimal string
+ */
+uint8_t Format_UInt(char* buffer, uint32_t value) {
+    return Format_UIntPad(buffer, value, 0, '0');
+}
+
+/**
+ * @brief แปลง signed integer เป็น decimal string
+ */
+uint8_t Format_Int(char* buffer, int32_t value) {
+    if (value < 0) {
+        buffer[0] = '-';
+        // -(value + 1) + 1 ไม่ overflow เมื่อ value = INT32_MIN
+        return 1 + Format_UInt(&buffer[1], (uint32_t)(-(value + 1)) + 1);
+    }
+    return Format_UInt(buffer, (uint32_t)value);
+}
+
+/**
+ * @brief แปลงเป็น hexadecimal string
+ */
+uint8_t Format_Hex(char* buffer, uint32_t value, uint8_t digits, uint8_t uppercase) {
+    const char* hex_chars = uppercase ? format_hex_upper : format_hex_lower;
+
+    if (digits == 0) digits = 1;
+    if (digits > 8) digits = 8;
+
+    for (int8_t i = digits - 1; i >= 0; i--) {
+        buffer[i] = hex_chars[value & 0x0F];
+        value >>= 4;
+    }
+
+    buffer[digits] = '\0';
+    return digits;
+}
+
+/**
+ * @brief แปลงตัวเลข fixed-point เป็น decimal string
+ */
+uint8_t Format_Fixed(char* buffer, int32_t value, uint8_t decimals) {
+    uint8_t sign = 0;
+    uint32_t magnitude = (uint32_t)value;
+
+    if (value < 0) {
+        buffer[0] = '-';
+        sign = 1;
+        magnitude = (uint32_t)(-(value + 1)) + 1;
+    }
+
+    if (decimals > 9) decimals = 9;
+
+    // เติม '0' ให้มีอย่างน้อย 1 หลักหน้าจุด (5, 2 -> "005")
+    char* digits = &buffer[sign];
+    uint8_t len = Format_UIntPad(digits, magnitude, decimals + 1, '0');
+
+    if (decimals == 0) {
+        return sign + len;
+    }
+
+    // เลื่อนส่วนทศนิยม (รวม '\0') ไปทางขวา 1 ตำแหน่งแล้วแทรกจุด
+    uint8_t point = len - decimals;
+    for (uint8_t i = len + 1; i > point; i--) {
+        digits[i] = digits[i - 1];
+    }
+    digits[point] = '.';
+
+    return sign + len + 1;
+}
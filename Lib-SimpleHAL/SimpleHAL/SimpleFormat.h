@@ -0,0 +1,115 @@
+/**
+ * @file SimpleFormat.h
+ * @brief Division-free Number Formatting สำหรับ CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * แปลงตัวเลขเป็นข้อความโดยไม่ใช้ `/` หรือ `%`
+ * CH32V003 (RV32EC) ไม่มีคำสั่งหาร ทุกการหารจึงเรียก libgcc (__udivsi3)
+ * ซึ่งใช้หลายร้อย cycles ต่อครั้ง
+ *
+ * **หลักการ:**
+ * - Decimal: ลบด้วยกำลังของ 10 ทีละหลัก (สูงสุด 9 ครั้งต่อหลัก ไม่มีการหาร)
+ * - Hex: shift + mask
+ * - Fixed-point: จำนวนเต็มที่ scale ไว้แล้ว (เช่น mV, 0.01°C) แทรกจุดทศนิยม
+ *   ใช้แทน printf("%.2f") ซึ่งดึง float library เข้ามาหลาย KB
+ * - ทุกฟังก์ชันเขียนลง buffer ที่ผู้ใช้เตรียม และคืนค่าความยาว (ไม่รวม '\0')
+ *   ต่อข้อความได้ทันทีโดยไม่ต้องเรียก strlen()
+ *
+ * @example
+ * char buf[24];
+ * uint8_t n = 0;
+ * n += Format_Fixed(&buf[n], 3297, 3);   // "3.297"
+ * buf[n++] = 'V';
+ * buf[n] = '\0';
+ *
+ * @note ขนาด buffer ต่ำสุด: FORMAT_INT_SIZE สำหรับ int32_t (รวม '-' และ '\0')
+ */
+
+#ifndef __SIMPLE_FORMAT_H
+#define __SIMPLE_FORMAT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Buffer Sizes ========== */
+
+#define FORMAT_INT_SIZE    12  /**< "-2147483648" + '\0' */
+#define FORMAT_FIXED_SIZE  13  /**< int32_t + จุดทศนิยม + '\0' */
+#define FORMAT_HEX_SIZE    9   /**< 8 hex digits + '\0' */
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief แปลง unsigned integer เป็น decimal string
+ * @param buffer buffer ปลายทาง (อย่างน้อย 11 bytes)
+ * @param value ค่าที่ต้องการแปลง
+ * @return จำนวนตัวอักษรที่เขียน (ไม่รวม '\0')
+ *
+ * @example
+ * Format_UInt(buf, 12345);  // "12345"
+ */
+uint8_t Format_UInt(char* buffer, uint32_t value);
+
+/**
+ * @brief แปลง signed integer เป็น decimal string
+ * @param buffer buffer ปลายทาง (อย่างน้อย FORMAT_INT_SIZE bytes)
+ * @param value ค่าที่ต้องการแปลง
+ * @return จำนวนตัวอักษรที่เขียน (ไม่รวม '\0')
+ *
+ * @example
+ * Format_Int(buf, -999);  // "-999"
+ */
+uint8_t Format_Int(char* buffer, int32_t value);
+
+/**
+ * @brief แปลง unsigned integer พร้อมเติมหน้าให้ครบความกว้าง (เหมือน "%05u" / "%5u")
+ * @param buffer buffer ปลายทาง
+ * @param value ค่าที่ต้องการแปลง
+ * @param width ความกว้างขั้นต่ำ (0-10)
+ * @param pad ตัวอักษรที่ใช้เติม ('0' หรือ ' ')
+ * @return จำนวนตัวอักษรที่เขียน (ไม่รวม '\0')
+ *
+ * @example
+ * Format_UIntPad(buf, 7, 2, '0');    // "07"
+ * Format_UIntPad(buf, 42, 4, ' ');   // "  42"
+ */
+uint8_t Format_UIntPad(char* buffer, uint32_t value, uint8_t width, char pad);
+
+/**
+ * @brief แปลงเป็น hexadecimal string (ไม่มี "0x" นำหน้า)
+ * @param buffer buffer ปลายทาง (อย่างน้อย digits + 1 bytes)
+ * @param value ค่าที่ต้องการแปลง
+ * @param digits จำนวนหลัก (1-8)
+ * @param uppercase 1 = A-F, 0 = a-f
+ * @return จำนวนตัวอักษรที่เขียน (ไม่รวม '\0')
+ *
+ * @example
+ * Format_Hex(buf, 0x3F, 2, 1);  // "3F"
+ */
+uint8_t Format_Hex(char* buffer, uint32_t value, uint8_t digits, uint8_t uppercase);
+
+/**
+ * @brief แปลงตัวเลข fixed-point เป็น decimal string ที่มีจุดทศนิยม
+ * @param buffer buffer ปลายทาง (อย่างน้อย FORMAT_FIXED_SIZE bytes)
+ * @param value ค่าที่ scale ด้วย 10^decimals แล้ว (เช่น 3297 mV)
+ * @param decimals จำนวนหลักหลังจุด (0-9)
+ * @return จำนวนตัวอักษรที่เขียน (ไม่รวม '\0')
+ *
+ * @example
+ * Format_Fixed(buf, 3297, 3);   // "3.297"  (mV -> V)
+ * Format_Fixed(buf, -5, 2);     // "-0.05"
+ * Format_Fixed(buf, 2550, 1);   // "255.0"
+ */
+uint8_t Format_Fixed(char* buffer, int32_t value, uint8_t decimals);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_FORMAT_H
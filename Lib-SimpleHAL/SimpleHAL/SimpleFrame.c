@@ -0,0 +1,218 @@
+/**
+ * @file SimpleFrame.c
+ * @brief COBS Framed Binary Transport Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleFrame.h"
+#include "SimpleCRC.h"
+
+// ต้องใช้ USART_TxReserve()/USART_TxCommit() (โหมด TX DMA) และ USART_BeginFrameRx()
+#if SIMPLE_USART_TX_DMA && SIMPLE_USART_FRAME_RX
+
+/* ========== Private Definitions ========== */
+
+#define FRAME_RX_CAPACITY (SIMPLE_FRAME_MAX_PAYLOAD + 2)  // payload + CRC
+
+/* ========== Private Variables ========== */
+
+static uint8_t frame_rx_dma[SIMPLE_FRAME_RX_DMA_SIZE];
+
+// Streaming decoder state
+static uint8_t frame_rx_packet[FRAME_RX_CAPACITY];
+static uint16_t frame_rx_len = 0;
+static uint8_t frame_rx_remaining = 0;   // data bytes ที่เหลือใน block (0 = byte ถัดไปเป็น code)
+static uint8_t frame_rx_zero_pending = 0; // block ก่อนหน้าจบด้วย 0 ที่ถูกตัดออก
+static uint8_t frame_rx_dropping = 0;     // ทิ้ง byte จนถึงตัวคั่นถัดไป
+
+static Frame_PacketCallback frame_packet_callback = NULL;
+static uint16_t frame_crc_errors = 0;
+static uint16_t frame_dropped = 0;
+
+// RX DMA ring + packet buffer (SimpleHAL_RamReport())
+const uint16_t frame_ram_bytes = sizeof(frame_rx_dma) + sizeof(frame_rx_packet);
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief เริ่ม decoder ใหม่สำหรับ packet ถัดไป
+ */
+static inline void Frame_RxReset(void) {
+    frame_rx_len = 0;
+    frame_rx_remaining = 0;
+    frame_rx_zero_pending = 0;
+    frame_rx_dropping = 0;
+}
+
+/**
+ * @brief เพิ่ม byte ที่ decode แล้วลง packet buffer
+ */
+static inline void Frame_RxAppend(uint8_t byte) {
+    if (frame_rx_len < FRAME_RX_CAPACITY) {
+        frame_rx_packet[frame_rx_len++] = byte;
+    } else {
+        frame_rx_dropping = 1;
+        frame_dropped++;
+    }
+}
+
+/**
+ * @brief จบ packet เมื่อเจอตัวคั่น 0x00: ตรวจ CRC แล้วส่งให้ callback
+ */
+static void Frame_RxComplete(void) {
+    if (frame_rx_dropping || frame_rx_len == 0) {
+        return;  // ทิ้งแล้ว หรือ 0x00 ซ้ำ (ใช้เป็นตัว sync ได้)
+    }
+
+    if (frame_rx_remaining || frame_rx_len < 2) {
+        frame_dropped++;  // COBS block ไม่ครบ
+        return;
+    }
+
+    uint16_t length = frame_rx_len - 2;
+    uint16_t crc = frame_rx_packet[length] | ((uint16_t)frame_rx_packet[length + 1] << 8);
+
+    if (crc != CRC16_CCITT(frame_rx_packet, length)) {
+        frame_crc_errors++;
+        return;
+    }
+
+    frame_packet_callback(frame_rx_packet, length);
+}
+
+/**
+ * @brief Decode ข้อมูล 1 ช่วงจาก circular buffer
+ */
+static void Frame_RxFeed(const uint8_t* data, uint16_t length) {
+    while (length--) {
+        uint8_t byte = *data++;
+
+        if (byte == 0x00) {
+            Frame_RxComplete();
+            Frame_RxReset();
+            continue;
+        }
+
+        if (frame_rx_dropping) continue;
+
+        if (frame_rx_remaining == 0) {
+            // Code byte: 0 ที่ถูกตัดออกจาก block ก่อนหน้าคืนกลับมา
+            if (frame_rx_zero_pending) {
+                Frame_RxAppend(0x00);
+            }
+            frame_rx_remaining = byte - 1;
+            frame_rx_zero_pending = (byte != 0xFF);
+        } else {
+            Frame_RxAppend(byte);
+            frame_rx_remaining--;
+        }
+    }
+}
+
+/**
+ * @brief USART frame callback: ป้อนทั้ง 2 ช่วงของ circular buffer ให้ decoder
+ */
+static void Frame_RxCallback(const USART_Frame_t* frame) {
+    Frame_RxFeed(frame->data, frame->length);
+    if (frame->length2) {
+        Frame_RxFeed(frame->data2, frame->length2);
+    }
+}
+
+/**
+ * @brief ตำแหน่ง byte ที่ index ในพื้นที่ที่จองไว้
+ */
+static inline uint8_t* Frame_SpanAt(const USART_TxSpan_t* span, uint16_t index) {
+    return (index < span->length) ? &span->data[index] : &span->data2[index - span->length];
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่มรับ packet
+ */
+uint8_t Frame_Begin(Frame_PacketCallback callback) {
+    if (!callback) return 0;
+
+    Frame_RxReset();
+    frame_packet_callback = callback;
+    return USART_BeginFrameRx(frame_rx_dma, SIMPLE_FRAME_RX_DMA_SIZE, Frame_RxCallback);
+}
+
+/**
+ * @brief หยุดรับ packet
+ */
+void Frame_End(void) {
+    USART_EndFrameRx();
+    frame_packet_callback = NULL;
+}
+
+/**
+ * @brief Encode และส่ง packet
+ */
+uint8_t Frame_Send(const uint8_t* data, uint16_t length) {
+    uint16_t crc = CRC16_CCITT(data, length);
+    uint16_t total = length + 2;
+
+    // ขนาดสูงสุดหลัง encode: ข้อมูล + code byte ทุก 254 bytes + ตัวคั่น
+    uint16_t max_encoded = total + 2;
+    for (uint16_t n = total; n >= 254; n -= 254) {
+        max_encoded++;
+    }
+
+    USART_TxSpan_t span;
+    if (!USART_TxReserve(max_encoded, &span)) {
+        return 0;
+    }
+
+    uint16_t out = 1;       // ตำแหน่งเขียนถัดไป
+    uint16_t code_pos = 0;  // ตำแหน่ง code byte ของ block ปัจจุบัน
+    uint8_t code = 1;
+
+    for (uint16_t i = 0; i < total; i++) {
+        uint8_t byte = (i < length) ? data[i] : (uint8_t)((i == length) ? crc : (crc >> 8));
+
+        if (byte == 0x00) {
+            *Frame_SpanAt(&span, code_pos) = code;
+            code_pos = out++;
+            code = 1;
+        } else {
+            *Frame_SpanAt(&span, out++) = byte;
+            if (++code == 0xFF) {
+                *Frame_SpanAt(&span, code_pos) = code;
+                code_pos = out++;
+                code = 1;
+            }
+        }
+    }
+
+    *Frame_SpanAt(&span, code_pos) = code;
+    *Frame_SpanAt(&span, out++) = 0x00;
+
+    USART_TxCommit(out);
+    return 1;
+}
+
+/**
+ * @brief Decode ข้อมูลที่เข้ามาแล้วโดยไม่รอสายว่าง
+ */
+void Frame_Poll(void) {
+    USART_PollFrameRx();
+}
+
+/**
+ * @brief จำนวน packet ที่ CRC ไม่ถูกต้อง
+ */
+uint16_t Frame_GetCrcErrors(void) {
+    return frame_crc_errors;
+}
+
+/**
+ * @brief จำนวน packet ที่ถูกทิ้ง
+ */
+uint16_t Frame_GetDropped(void) {
+    return frame_dropped;
+}
+
+#endif /* SIMPLE_USART_TX_DMA && SIMPLE_USART_FRAME_RX */
@@ -0,0 +1,129 @@
+/**
+ * @file SimpleFrame.h
+ * @brief COBS Framed Binary Transport พร้อม CRC16 ผ่าน USART DMA
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * ส่ง/รับ packet แบบ binary ผ่าน USART โดยแต่ละ packet ถูก encode ด้วย COBS
+ * (Consistent Overhead Byte Stuffing) และปิดท้ายด้วย 0x00 เป็นตัวคั่น
+ *
+ * **รูปแบบบนสาย:**
+ * @code
+ * COBS( payload | CRC16 low | CRC16 high ) | 0x00
+ * @endcode
+ * - CRC16-CCITT (poly 0x1021, init 0xFFFF) ผ่าน CRC16_CCITT() ใน SimpleCRC
+ * - Overhead: 1 byte ต่อ 254 bytes + CRC 2 bytes + ตัวคั่น 1 byte
+ *
+ * **Zero-copy:**
+ * - TX: encode ลง TX FIFO ของ SimpleUSART โดยตรง (USART_TxReserve) แล้ว DMA ส่งต่อ
+ * - RX: decode แบบ streaming จาก circular DMA buffer (USART_BeginFrameRx)
+ *   ลง packet buffer ทีละ byte ไม่มี buffer กลาง
+ *
+ * @example
+ * void on_packet(const uint8_t* data, uint16_t length) {
+ *     // packet ผ่าน CRC แล้ว
+ * }
+ *
+ * USART_SimpleInit(BAUD_1M, USART_PINS_DEFAULT);
+ * Frame_Begin(on_packet);
+ *
+ * uint8_t batch[] = {0x01, 0x00, 0x7F};
+ * Frame_Send(batch, sizeof(batch));
+ *
+ * while (1) {
+ *     Frame_Poll();  // สำหรับ stream ต่อเนื่องที่ไม่มีช่วงสายว่าง
+ * }
+ *
+ * @note ต้องใช้ SIMPLE_USART_TX_DMA = 1 และ SIMPLE_USART_FRAME_RX = 1 (ถ้าไม่ใช่ SimpleFrame.c จะไม่ถูก compile)
+ * @note ระหว่าง Frame_Begin() ถึง Frame_End() USART RX ถูกใช้โดย SimpleFrame
+ */
+
+#ifndef __SIMPLE_FRAME_H
+#define __SIMPLE_FRAME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleUSART.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief ขนาด payload สูงสุดที่รับได้ (ไม่รวม CRC)
+ */
+#ifndef SIMPLE_FRAME_MAX_PAYLOAD
+#define SIMPLE_FRAME_MAX_PAYLOAD 64
+#endif
+
+/**
+ * @brief ขนาด circular DMA buffer สำหรับ RX
+ * @note ที่ 1 Mbaud (100 KB/s) buffer 128 bytes ต้อง poll อย่างน้อยทุก ~1.2 ms
+ */
+#ifndef SIMPLE_FRAME_RX_DMA_SIZE
+#define SIMPLE_FRAME_RX_DMA_SIZE 128
+#endif
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief Callback เมื่อได้รับ packet ที่ CRC ถูกต้อง
+ * @param data payload (ใช้ได้เฉพาะภายใน callback)
+ * @param length ความยาว payload
+ *
+ * @note ถูกเรียกจาก USART interrupt (IDLE) หรือจาก Frame_Poll()
+ */
+typedef void (*Frame_PacketCallback)(const uint8_t* data, uint16_t length);
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่มรับ packet (circular DMA + streaming COBS decoder)
+ * @param callback ฟังก์ชันที่รับ packet ที่ถูกต้อง
+ * @return 1 = สำเร็จ, 0 = parameter ไม่ถูกต้อง
+ *
+ * @note เรียกหลัง USART_SimpleInit()
+ */
+uint8_t Frame_Begin(Frame_PacketCallback callback);
+
+/**
+ * @brief หยุดรับ packet และคืน USART RX ให้ receive ring buffer
+ */
+void Frame_End(void);
+
+/**
+ * @brief Encode และส่ง packet (COBS + CRC16) ผ่าน TX FIFO + DMA
+ * @param data payload
+ * @param length ความยาว payload
+ * @return 1 = เข้า FIFO แล้ว, 0 = packet ใหญ่เกิน TX FIFO
+ *
+ * @note รอเฉพาะเมื่อ FIFO มีที่ว่างไม่พอ (ส่งเสร็จใน background)
+ * @note ขนาดสูงสุดที่ส่งได้ต่อ packet ประมาณ SIMPLE_USART_TX_BUFFER_SIZE - 5 bytes
+ */
+uint8_t Frame_Send(const uint8_t* data, uint16_t length);
+
+/**
+ * @brief Decode ข้อมูลที่เข้ามาแล้วโดยไม่รอสายว่าง
+ *
+ * @note จำเป็นเมื่อ packet ต่อกันโดยไม่มีช่วงว่าง (IDLE ไม่เกิด)
+ */
+void Frame_Poll(void);
+
+/**
+ * @brief จำนวน packet ที่ CRC ไม่ถูกต้อง
+ */
+uint16_t Frame_GetCrcErrors(void);
+
+/**
+ * @brief จำนวน packet ที่ถูกทิ้งเพราะยาวเกิน SIMPLE_FRAME_MAX_PAYLOAD หรือ COBS ผิด
+ */
+uint16_t Frame_GetDropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_FRAME_H
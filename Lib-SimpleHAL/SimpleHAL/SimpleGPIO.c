@@ -1,14 +1,21 @@
 /**
  * @file SimpleGPIO.c
  * @brief Simple GPIO Library Implementation
- * @version 1.3
- * @date 2025-12-22
+ * @version 1.5
+ * @date 2026-10-14
  */
 
 #include "SimpleGPIO.h"
 #include "SimpleADC.h"
 #include "SimplePWM.h"
 #include "SimpleDelay.h"
+#include "SimpleTIM.h"
+#include "SimpleSPI.h"
+#include "SimpleDMA.h"
+#include "SimpleClock.h"
+#include "SimpleEvent.h"
+#include "SimpleInit.h"
+#include "SimpleISRStat.h"
 
 /* ========== Internal Structures ========== */
 
@@ -60,6 +67,7 @@ static const PinMap_t pin_map[] = {
 
 #define PIN_MAP_SIZE (sizeof(pin_map) / sizeof(PinMap_t))
 
+#if SIMPLE_GPIO_EXTI
 /* ========== Interrupt Callback Storage ========== */
 
 /**
@@ -68,12 +76,60 @@ static const PinMap_t pin_map[] = {
  */
 static void (*exti_callbacks[8])(void) = {0};
 
-/* ========== Analog Function State ========== */
+/**
+ * @brief Interrupt callback functions แบบมี context (attachInterruptArg)
+ */
+static GPIO_InterruptArgCallback exti_arg_callbacks[8] = {0};
+static void* exti_contexts[8] = {0};
+
+/**
+ * @brief EXTI lines ที่ callback ถูกเรียกจาก Event_Dispatch() แทน ISR
+ */
+static volatile uint8_t exti_deferred_lines = 0;
 
 /**
- * @brief ADC initialization state
+ * @brief ตำแหน่ง bit ต่ำสุดที่เป็น 1 ของค่า 4 bits (index 0 ไม่ถูกใช้)
+ * @note RV32EC ไม่มีคำสั่ง ctz จึงใช้ table แทน
  */
-static uint8_t adc_initialized = 0;
+static const uint8_t nibble_ctz[16] = {0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
+
+#if SIMPLE_GPIO_CAPTURE_SIZE
+/* ========== Edge Capture State ========== */
+
+/**
+ * @brief Edge ที่ถูกบันทึกใน ISR (timestamp ยังไม่แปลง)
+ * @note raw = (millis 16 bits ล่าง << 16) | ticks ภายใน ms (Get_CurrentMsTicks(), < 65536 ที่ <= 48 MHz)
+ */
+typedef struct {
+    uint32_t raw;
+    uint8_t pin;
+    uint8_t level;
+} EdgeRaw_t;
+
+/**
+ * @brief Ring buffer แบบ lock-free (ISR เขียน head, main loop เขียน tail)
+ */
+static EdgeRaw_t edge_buffer[SIMPLE_GPIO_CAPTURE_SIZE];
+static volatile uint16_t edge_head = 0;
+static volatile uint16_t edge_tail = 0;
+static volatile uint16_t edge_overruns = 0;
+
+/**
+ * @brief EXTI lines ที่อยู่ใน capture mode และข้อมูล pin ของแต่ละ line
+ */
+static volatile uint8_t edge_capture_lines = 0;
+static const PinMap_t* edge_capture_maps[8] = {0};
+static uint8_t edge_capture_pins[8] = {0};
+#endif  // SIMPLE_GPIO_CAPTURE_SIZE
+
+// EXTI callback tables + edge capture ring (SimpleHAL_RamReport())
+const uint16_t gpio_ram_bytes = sizeof(exti_arg_callbacks) + sizeof(exti_contexts)
+#if SIMPLE_GPIO_CAPTURE_SIZE
+                                + sizeof(edge_buffer) + sizeof(edge_capture_maps) +
+                                sizeof(edge_capture_pins)
+#endif
+                                ;
+#endif  // SIMPLE_GPIO_EXTI
 
 /* ========== Internal Helper Functions ========== */
 
@@ -87,15 +143,51 @@ static const PinMap_t* getPinMap(uint8_t pin) {
 }
 
 /**
- * @brief เปิดใช้งาน GPIO clock
+ * @brief Clock ที่ SimpleGPIO ถืออยู่ (bitmask ของ Clock_Periph)
  */
-static void enableGPIOClock(GPIO_TypeDef* port) {
-    if (port == GPIOA) {
-        RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);
-    } else if (port == GPIOC) {
-        RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC, ENABLE);
-    } else if (port == GPIOD) {
-        RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOD, ENABLE);
+static uint16_t gpio_clocks = 0;
+
+/**
+ * @brief เปิดใช้งาน GPIO clock (ผ่าน SimpleClock, เรียกซ้ำได้)
+ */
+static inline void enableGPIOClock(GPIO_TypeDef* port) {
+    Clock_AcquireOnce(Clock_GPIOPeriph(port), &gpio_clocks);
+}
+
+/**
+ * @brief จำนวน GPIO ports ของ CH32V003 (GPIOA, GPIOC, GPIOD)
+ */
+#define GPIO_PORT_COUNT 3
+
+/**
+ * @brief รายการ GPIO ports สำหรับฟังก์ชันแบบ batch
+ */
+static GPIO_TypeDef* const gpio_ports[GPIO_PORT_COUNT] = {GPIOA, GPIOC, GPIOD};
+
+/**
+ * @brief แปลง GPIO port เป็น index ใน gpio_ports[]
+ */
+static uint8_t getPortIndex(GPIO_TypeDef* port) {
+    if (port == GPIOA) return 0;
+    if (port == GPIOC) return 1;
+    return 2;
+}
+
+/**
+ * @brief แปลงโหมดเป็นค่า CNF/MODE 4 bits ของ CFGLR
+ * @param mode โหมดที่ต้องการ
+ * @param pull [out] 1 = pull-up, 0 = pull-down (ใช้เฉพาะ input pull)
+ * @return ค่า 4 bits, หรือ 0xFF ถ้าโหมดไม่ถูกต้อง
+ */
+static uint8_t getModeConfig(GPIO_PinMode mode, uint8_t* pull) {
+    *pull = 0;
+    switch (mode) {
+        case PIN_MODE_INPUT:          return 0x4;  // CNF=01 floating, MODE=00
+        case PIN_MODE_OUTPUT:         return 0x3;  // CNF=00 push-pull, MODE=11 (30MHz)
+        case PIN_MODE_INPUT_PULLUP:   *pull = 1; return 0x8;  // CNF=10 pull, ODR=1
+        case PIN_MODE_INPUT_PULLDOWN: return 0x8;  // CNF=10 pull, ODR=0
+        case PIN_MODE_OUTPUT_OD:      return 0x7;  // CNF=01 open-drain, MODE=11
+        default:                      return 0xFF;
     }
 }
 
@@ -150,15 +242,43 @@ void pinMode(uint8_t pin, GPIO_PinMode mode) {
 void _pinModeMultiple(const uint8_t* pins, uint8_t count, GPIO_PinMode mode) {
     if (!pins || count == 0) return;
     
+    uint8_t pull;
+    uint8_t cfg = getModeConfig(mode, &pull);
+    if (cfg == 0xFF) return;
+    
+    // รวม pins ตาม port: mask ของ CFGLR และ mask ของ pins
+    uint32_t cfg_mask[GPIO_PORT_COUNT] = {0};
+    uint16_t pin_mask[GPIO_PORT_COUNT] = {0};
+    
     for (uint8_t i = 0; i < count; i++) {
-        pinMode(pins[i], mode);
+        const PinMap_t* map = getPinMap(pins[i]);
+        if (!map) continue;
+        
+        uint8_t idx = getPortIndex(map->port);
+        cfg_mask[idx] |= (uint32_t)0xF << (map->pin_source * 4);
+        pin_mask[idx] |= map->pin;
+    }
+    
+    // ทีละ port: pull-up/down ผ่าน BSHR แล้วอัปเดต CFGLR ครั้งเดียว
+    uint32_t cfg_fill = cfg * 0x11111111UL;
+    for (uint8_t idx = 0; idx < GPIO_PORT_COUNT; idx++) {
+        if (!pin_mask[idx]) continue;
+        
+        GPIO_TypeDef* port = gpio_ports[idx];
+        enableGPIOClock(port);
+        
+        if (cfg == 0x8) {
+            port->BSHR = pull ? pin_mask[idx] : ((uint32_t)pin_mask[idx] << 16);
+        }
+        port->CFGLR = (port->CFGLR & ~cfg_mask[idx]) | (cfg_fill & cfg_mask[idx]);
     }
 }
 
 /**
  * @brief เขียนค่า digital ไปยัง output pin
+ * @note ชื่อฟังก์ชันอยู่ในวงเล็บเพื่อไม่ให้ macro digitalWrite() ขยาย
  */
-void digitalWrite(uint8_t pin, uint8_t value) {
+void (digitalWrite)(uint8_t pin, uint8_t value) {
     const PinMap_t* map = getPinMap(pin);
     if (!map) return;
     
@@ -171,8 +291,9 @@ void digitalWrite(uint8_t pin, uint8_t value) {
 
 /**
  * @brief อ่านค่า digital จาก input pin
+ * @note ชื่อฟังก์ชันอยู่ในวงเล็บเพื่อไม่ให้ macro digitalRead() ขยาย
  */
-uint8_t digitalRead(uint8_t pin) {
+uint8_t (digitalRead)(uint8_t pin) {
     const PinMap_t* map = getPinMap(pin);
     if (!map) return 0;
     
@@ -181,28 +302,23 @@ uint8_t digitalRead(uint8_t pin) {
 
 /**
  * @brief สลับสถานะของ output pin
+ * @note ชื่อฟังก์ชันอยู่ในวงเล็บเพื่อไม่ให้ macro digitalToggle() ขยาย
  */
-void digitalToggle(uint8_t pin) {
+void (digitalToggle)(uint8_t pin) {
     const PinMap_t* map = getPinMap(pin);
     if (!map) return;
     
-    // อ่านค่าปัจจุบันแล้วสลับ
-    if (GPIO_ReadOutputDataBit(map->port, map->pin)) {
-        GPIO_ResetBits(map->port, map->pin);
-    } else {
-        GPIO_SetBits(map->port, map->pin);
-    }
+    // คำนวณจาก OUTDR แล้วเขียน BSHR ครั้งเดียว (atomic)
+    portToggleMask(map->port, map->pin);
 }
 
+#if SIMPLE_GPIO_EXTI
 /**
- * @brief ตั้งค่า external interrupt
+ * @brief ตั้งค่า EXTI line และ NVIC ของ pin
  */
-void attachInterrupt(uint8_t pin, void (*callback)(void), GPIO_InterruptMode mode) {
-    const PinMap_t* map = getPinMap(pin);
-    if (!map || !callback) return;
-    
+static void configureEXTI(const PinMap_t* map, GPIO_InterruptMode mode) {
     // เปิด AFIO clock
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
+    Clock_AcquireOnce(CLOCK_AFIO, &gpio_clocks);
     
     // ตั้งค่า EXTI line
     GPIO_EXTILineConfig(map->port_source, map->pin_source);
@@ -227,9 +343,6 @@ void attachInterrupt(uint8_t pin, void (*callback)(void), GPIO_InterruptMode mod
     
     EXTI_Init(&EXTI_InitStructure);
     
-    // เก็บ callback
-    exti_callbacks[map->pin_source] = callback;
-    
     // เปิด NVIC
     NVIC_InitTypeDef NVIC_InitStructure = {0};
     NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
@@ -241,6 +354,71 @@ void attachInterrupt(uint8_t pin, void (*callback)(void), GPIO_InterruptMode mod
     NVIC_Init(&NVIC_InitStructure);
 }
 
+/**
+ * @brief ตั้งค่า external interrupt
+ */
+void attachInterrupt(uint8_t pin, void (*callback)(void), GPIO_InterruptMode mode) {
+    const PinMap_t* map = getPinMap(pin);
+    if (!map || !callback) return;
+    
+    // เก็บ callback ก่อนเปิด interrupt
+    exti_deferred_lines &= (uint8_t)~(1 << map->pin_source);
+    exti_arg_callbacks[map->pin_source] = NULL;
+    exti_callbacks[map->pin_source] = callback;
+    
+    configureEXTI(map, mode);
+}
+
+/**
+ * @brief เรียก callbacks ของ EXTI lines ที่ถูก defer (จาก Event_Dispatch())
+ */
+static void gpio_event_handler(uint16_t id, uint16_t lines) {
+    (void)id;
+    
+    while (lines) {
+        uint8_t line = (lines & 0x0F) ? 0 : 4;
+        line += nibble_ctz[(lines >> line) & 0x0F];
+        lines &= lines - 1;
+        
+        if (exti_arg_callbacks[line]) {
+            exti_arg_callbacks[line](exti_contexts[line]);
+        } else if (exti_callbacks[line]) {
+            exti_callbacks[line]();
+        }
+    }
+}
+
+/**
+ * @brief ตั้งค่า external interrupt ที่ callback ทำใน main loop
+ */
+void attachInterruptDeferred(uint8_t pin, void (*callback)(void), GPIO_InterruptMode mode) {
+    const PinMap_t* map = getPinMap(pin);
+    if (!map || !callback) return;
+    
+    Event_SetHandler(EVENT_SOURCE_GPIO, gpio_event_handler);
+    
+    exti_arg_callbacks[map->pin_source] = NULL;
+    exti_callbacks[map->pin_source] = callback;
+    exti_deferred_lines |= (uint8_t)(1 << map->pin_source);
+    
+    configureEXTI(map, mode);
+}
+
+/**
+ * @brief ตั้งค่า external interrupt แบบมี context pointer
+ */
+void attachInterruptArg(uint8_t pin, GPIO_InterruptArgCallback callback, void* context, GPIO_InterruptMode mode) {
+    const PinMap_t* map = getPinMap(pin);
+    if (!map || !callback) return;
+    
+    exti_deferred_lines &= (uint8_t)~(1 << map->pin_source);
+    exti_callbacks[map->pin_source] = NULL;
+    exti_contexts[map->pin_source] = context;
+    exti_arg_callbacks[map->pin_source] = callback;
+    
+    configureEXTI(map, mode);
+}
+
 /**
  * @brief ยกเลิก external interrupt
  */
@@ -255,9 +433,125 @@ void detachInterrupt(uint8_t pin) {
     EXTI_Init(&EXTI_InitStructure);
     
     // ลบ callback
+    exti_deferred_lines &= (uint8_t)~(1 << map->pin_source);
     exti_callbacks[map->pin_source] = NULL;
+    exti_arg_callbacks[map->pin_source] = NULL;
+    exti_contexts[map->pin_source] = NULL;
+#if SIMPLE_GPIO_CAPTURE_SIZE
+    edge_capture_lines &= (uint8_t)~(1 << map->pin_source);
+#endif
+}
+
+#if SIMPLE_GPIO_CAPTURE_SIZE
+/* ========== Edge Capture ========== */
+
+/**
+ * @brief บันทึก edge ของ pin ลง ring buffer แทนการเรียก callback
+ */
+void attachEdgeCapture(uint8_t pin, GPIO_InterruptMode mode) {
+    const PinMap_t* map = getPinMap(pin);
+    if (!map) return;
+    
+    uint8_t line = map->pin_source;
+    exti_deferred_lines &= (uint8_t)~(1 << line);
+    exti_callbacks[line] = NULL;
+    exti_arg_callbacks[line] = NULL;
+    edge_capture_maps[line] = map;
+    edge_capture_pins[line] = pin;
+    edge_capture_lines |= (uint8_t)(1 << line);
+    
+    // Timestamp มาจาก SysTick จึงต้องเริ่ม timebase ก่อนเปิด interrupt
+    Timer_EnsureInit();
+    configureEXTI(map, mode);
 }
 
+/**
+ * @brief จำนวน edges ที่รอให้อ่าน
+ */
+uint16_t edgeCaptureAvailable(void) {
+    return (uint16_t)((edge_head - edge_tail) & (SIMPLE_GPIO_CAPTURE_SIZE - 1));
+}
+
+/**
+ * @brief อ่าน edges ออกจาก buffer ทีละชุด พร้อมแปลง timestamp เป็น microseconds
+ */
+uint16_t edgeCaptureRead(GPIO_Edge_t* events, uint16_t max_events) {
+    if (!events || max_events == 0) return 0;
+    
+    // Snapshot head ก่อนอ่านเวลาอ้างอิง เพื่อให้ทุก edge ที่อ่านเกิดก่อน now_ms
+    uint16_t head = edge_head;
+    uint16_t tail = edge_tail;
+    uint16_t count = 0;
+    
+    // เวลาอ้างอิงสำหรับต่อ millis 16 bits ล่างให้เป็น 32 bits
+    uint32_t now_ms = Get_CurrentMs();
+    uint32_t tick_per_ms = Get_TicksPerMs();
+    
+    while (count < max_events && tail != head) {
+        const EdgeRaw_t* raw = &edge_buffer[tail];
+        uint32_t ms = now_ms - (uint16_t)((uint16_t)now_ms - (uint16_t)(raw->raw >> 16));
+        uint32_t ticks = raw->raw & 0xFFFF;
+        
+        events[count].time_us = ms * 1000 + (ticks * 1000) / tick_per_ms;
+        events[count].pin = raw->pin;
+        events[count].level = raw->level;
+        count++;
+        
+        tail = (tail + 1) & (SIMPLE_GPIO_CAPTURE_SIZE - 1);
+    }
+    
+    edge_tail = tail;
+    return count;
+}
+
+/**
+ * @brief จำนวน edges ที่หายเพราะ buffer เต็ม (นับตั้งแต่ clear ครั้งล่าสุด)
+ */
+uint16_t edgeCaptureOverruns(void) {
+    return edge_overruns;
+}
+
+/**
+ * @brief ล้าง buffer และตัวนับ overrun
+ */
+void edgeCaptureClear(void) {
+    edge_tail = edge_head;
+    edge_overruns = 0;
+}
+
+/**
+ * @brief บันทึก edges ของ lines ที่อยู่ใน capture mode (เรียกจาก ISR)
+ * @note อ่าน timestamp ครั้งเดียวต่อ interrupt ไม่มีการหาร
+ */
+static inline void edgeCapturePush(uint32_t lines) {
+    uint32_t ticks;
+    uint32_t ms = Get_CurrentMsTicks(&ticks);
+    uint32_t raw = (ms << 16) | (ticks & 0xFFFF);
+    uint16_t head = edge_head;
+    
+    while (lines) {
+        uint8_t line = (lines & 0x0F) ? 0 : 4;
+        line += nibble_ctz[(lines >> line) & 0x0F];
+        lines &= lines - 1;
+        
+        uint16_t next = (head + 1) & (SIMPLE_GPIO_CAPTURE_SIZE - 1);
+        if (next == edge_tail) {
+            edge_overruns++;
+            continue;
+        }
+        
+        const PinMap_t* map = edge_capture_maps[line];
+        edge_buffer[head].raw = raw;
+        edge_buffer[head].pin = edge_capture_pins[line];
+        edge_buffer[head].level = (map->port->INDR & map->pin) ? HIGH : LOW;
+        head = next;
+    }
+    
+    edge_head = head;
+}
+#endif  // SIMPLE_GPIO_CAPTURE_SIZE
+#endif  // SIMPLE_GPIO_EXTI
+
 /**
  * @brief เขียนค่าไปยัง port ทั้งหมด
  */
@@ -312,32 +606,180 @@ static uint8_t mapPinToPWM(uint8_t pin) {
     }
 }
 
-/* ========== Analog Functions ========== */
+/* ========== Input Capture Helpers ========== */
 
 /**
- * @brief อ่านค่า analog จาก ADC pin - Implementation with runtime validation
+ * @brief ค่า timeout สูงสุดของ pulseInCapture (microseconds)
  */
-uint16_t _analogRead_impl(uint8_t pin) {
-    // Runtime validation สำหรับกรณีใช้ตัวแปร
-    // ADC pins: PA1, PA2, PC4, PD2-PD6 (ไม่รวม PD7!)
-    if (pin != PA1 && pin != PA2 && pin != PC4 &&
-        (pin < PD2 || pin > PD6)) {
-        return 0;  // Pin ไม่รองรับ ADC
+#define CAPTURE_MAX_TIMEOUT_US   1000000UL
+
+/**
+ * @brief จำนวน ticks สูงสุดของ timeout ต่อรอบ counter
+ * @note เว้นระยะจาก 65535 เพื่อให้ตรวจ timeout แบบ polling ได้ทันก่อน counter วน
+ */
+#define CAPTURE_TIMEOUT_TICKS    0xF000UL
+
+/**
+ * @brief ข้อมูล timer channel ของ pin ที่ใช้ input capture
+ */
+typedef struct {
+    TIM_TypeDef* tim;
+    TIM_Instance timer;
+    uint8_t channel;    // 0-3 (CH1-CH4)
+} CaptureMap_t;
+
+/**
+ * @brief สถานะของ pulseInAsync()
+ */
+static struct {
+    CaptureMap_t cap;
+    PulseInCallback callback;
+    uint16_t start;
+    uint16_t timeout_ticks;
+    uint16_t prescaler;
+    uint8_t pin;
+    uint8_t phase;              // 0 = รอ edge เริ่ม, 1 = รอ edge จบ
+    volatile uint8_t active;
+} pulse_async = {0};
+
+/**
+ * @brief แมป pin เป็น timer channel สำหรับ input capture
+ * @return 1 = สำเร็จ, 0 = pin ไม่รองรับ
+ */
+static uint8_t getCaptureMap(uint8_t pin, CaptureMap_t* cap) {
+    uint8_t pwm_ch = mapPinToPWM(pin);
+    if (pwm_ch == 0xFF) return 0;
+    
+    cap->timer = (pwm_ch < PWM2_CH1) ? TIM_1 : TIM_2;
+    cap->tim = (cap->timer == TIM_1) ? TIM1 : TIM2;
+    cap->channel = pwm_ch & 0x03;
+    return 1;
+}
+
+/**
+ * @brief คำนวณ prescaler ให้ timeout ทั้งหมดอยู่ในรอบ counter 16-bit เดียว
+ * @param timeout timeout (microseconds), 0 = ใช้ค่าสูงสุด
+ * @param timeout_ticks [out] timeout ในหน่วย timer ticks
+ * @return ค่า prescaler
+ */
+static uint16_t captureCalcPrescaler(uint32_t timeout, uint16_t* timeout_ticks) {
+    if (timeout == 0 || timeout > CAPTURE_MAX_TIMEOUT_US) {
+        timeout = CAPTURE_MAX_TIMEOUT_US;
     }
     
-    // แมป pin เป็น ADC channel
-    uint8_t adc_ch = mapPinToADC(pin);
+    uint32_t cycles = timeout * (SystemCoreClock / 1000000);
+    uint32_t prescaler = cycles / CAPTURE_TIMEOUT_TICKS;
+    *timeout_ticks = (uint16_t)(cycles / (prescaler + 1));
+    return (uint16_t)prescaler;
+}
+
+/**
+ * @brief ตั้งค่า timer เป็น input capture บน channel ของ pin
+ * @param rising 1 = capture ขอบขาขึ้น, 0 = ขอบขาลง
+ */
+static void captureConfigure(const CaptureMap_t* cap, uint16_t prescaler, uint8_t rising) {
+    // Time base: free-running 16-bit, counter เริ่มที่ 0
+    TIM_Stop(cap->timer);
+    TIM_AdvancedInit(cap->timer, prescaler, 0xFFFF, TIM_MODE_UP);
     
-    // ตรวจสอบว่า pin รองรับ ADC หรือไม่ (double-check)
-    if (adc_ch == 0xFF) {
-        return 0;  // Pin ไม่รองรับ ADC
+    TIM_ICInitTypeDef TIM_ICInitStructure = {0};
+    TIM_ICInitStructure.TIM_Channel = (uint16_t)(cap->channel * 4);  // TIM_Channel_1-4
+    TIM_ICInitStructure.TIM_ICPolarity = rising ? TIM_ICPolarity_Rising : TIM_ICPolarity_Falling;
+    TIM_ICInitStructure.TIM_ICSelection = TIM_ICSelection_DirectTI;
+    TIM_ICInitStructure.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+    TIM_ICInitStructure.TIM_ICFilter = 0;
+    TIM_ICInit(cap->tim, &TIM_ICInitStructure);
+}
+
+/**
+ * @brief สลับขอบที่ใช้ capture (rising ↔ falling)
+ */
+static inline void captureTogglePolarity(const CaptureMap_t* cap) {
+    cap->tim->CCER ^= (uint16_t)(TIM_CC1P << (cap->channel * 4));
+}
+
+/**
+ * @brief อ่านค่า capture register ของ channel
+ */
+static inline uint16_t captureRead(TIM_TypeDef* tim, uint8_t channel) {
+    return (uint16_t)(&tim->CH1CVR)[channel];
+}
+
+/**
+ * @brief หยุด timer และปิด capture channel
+ */
+static void captureRelease(const CaptureMap_t* cap) {
+    TIM_Stop(cap->timer);
+    cap->tim->CCER &= (uint16_t)~(0x000F << (cap->channel * 4));
+}
+
+/**
+ * @brief รอ capture event จนกว่าจะครบ timeout (นับจาก from)
+ * @return 1 = เกิด capture, 0 = timeout
+ */
+static uint8_t captureWaitEdge(TIM_TypeDef* tim, uint16_t cc_flag, uint16_t from, uint16_t timeout_ticks) {
+    while (!(tim->INTFR & cc_flag)) {
+        if ((uint16_t)(tim->CNT - from) >= timeout_ticks) return 0;
     }
+    return 1;
+}
+
+/**
+ * @brief จบ pulseInAsync() และเรียก callback
+ */
+static void pulseAsyncFinish(uint32_t cycles) {
+    PulseInCallback callback = pulse_async.callback;
     
-    // Init ADC ครั้งแรก
-    if (!adc_initialized) {
-        ADC_SimpleInit();
-        adc_initialized = 1;
+    TIM_DetachCCHandler(pulse_async.cap.timer);
+    captureRelease(&pulse_async.cap);
+    pulse_async.active = 0;
+    
+    if (callback) {
+        callback(pulse_async.pin, cycles);
     }
+}
+
+/**
+ * @brief Capture/compare handler ของ pulseInAsync() (เรียกจาก ISR)
+ * @note channel คู่ (CH1↔CH2, CH3↔CH4) ใช้เป็น output compare สำหรับ timeout
+ */
+static void pulseAsyncHandler(uint16_t flags) {
+    TIM_TypeDef* tim = pulse_async.cap.tim;
+    uint8_t ch = pulse_async.cap.channel;
+    uint8_t timeout_ch = ch ^ 1;
+    
+    if (flags & (TIM_IT_CC1 << ch)) {
+        uint16_t captured = captureRead(tim, ch);
+        
+        if (pulse_async.phase == 0) {
+            // Edge เริ่ม: สลับขอบ และเลื่อน timeout ไปนับจากจุดนี้
+            pulse_async.start = captured;
+            pulse_async.phase = 1;
+            captureTogglePolarity(&pulse_async.cap);
+            (&tim->CH1CVR)[timeout_ch] = (uint16_t)(captured + pulse_async.timeout_ticks);
+        } else {
+            uint16_t ticks = (uint16_t)(captured - pulse_async.start);
+            pulseAsyncFinish((uint32_t)ticks * (pulse_async.prescaler + 1));
+        }
+    } else if (flags & (TIM_IT_CC1 << timeout_ch)) {
+        pulseAsyncFinish(0);
+    }
+}
+
+/* ========== Analog Functions ========== */
+
+/**
+ * @brief อ่านค่า analog จาก ADC pin - Implementation with runtime validation
+ */
+uint16_t _analogRead_impl(uint8_t pin) {
+    // แมป pin เป็น ADC channel (ADC pins: PA1, PA2, PC4, PD2-PD6)
+    uint8_t adc_ch = mapPinToADC(pin);
+    
+    // Runtime validation สำหรับกรณีใช้ตัวแปร (pin คงที่ตรวจตอน compile แล้ว)
+    SIMPLE_CHECK(adc_ch != 0xFF, 0);
+    
+    // Init ADC ครั้งแรก (SimpleInit guard)
+    SimpleInit_Ensure(SIMPLE_INIT_ADC, ADC_SimpleInit);
     
     // อ่านค่า ADC
     return ADC_Read((ADC_Channel)adc_ch);
@@ -347,19 +789,11 @@ uint16_t _analogRead_impl(uint8_t pin) {
  * @brief เขียนค่า PWM ไปยัง pin - Implementation with runtime validation
  */
 void _analogWrite_impl(uint8_t pin, uint8_t value) {
-    // Runtime validation สำหรับกรณีใช้ตัวแปร
-    if (pin != PA1 && pin != PC0 && pin != PC3 && pin != PC4 &&
-        pin != PD2 && pin != PD3 && pin != PD4 && pin != PD7) {
-        return;  // Pin ไม่รองรับ PWM
-    }
-    
-    // แมป pin เป็น PWM channel
+    // แมป pin เป็น PWM channel (PA1, PC0, PC3, PC4, PD2, PD3, PD4, PD7)
     uint8_t pwm_ch = mapPinToPWM(pin);
     
-    // ตรวจสอบว่า pin รองรับ PWM หรือไม่ (double-check)
-    if (pwm_ch == 0xFF) {
-        return;  // Pin ไม่รองรับ PWM
-    }
+    // Runtime validation สำหรับกรณีใช้ตัวแปร (pin คงที่ตรวจตอน compile แล้ว)
+    SIMPLE_CHECK(pwm_ch != 0xFF);
     
     // เรียกใช้ PWM_Write (มี auto-init อยู่แล้ว)
     PWM_Write((PWM_Channel)pwm_ch, value);
@@ -373,8 +807,26 @@ void _analogWrite_impl(uint8_t pin, uint8_t value) {
 void _digitalWriteMultiple(const uint8_t* pins, const uint8_t* values, uint8_t count) {
     if (!pins || !values || count == 0) return;
     
+    // BSHR: ครึ่งล่าง = set, ครึ่งบน = reset
+    uint32_t bshr[GPIO_PORT_COUNT] = {0};
+    
     for (uint8_t i = 0; i < count; i++) {
-        digitalWrite(pins[i], values[i]);
+        const PinMap_t* map = getPinMap(pins[i]);
+        if (!map) continue;
+        
+        uint8_t idx = getPortIndex(map->port);
+        if (values[i]) {
+            bshr[idx] |= map->pin;
+        } else {
+            bshr[idx] |= (uint32_t)map->pin << 16;
+        }
+    }
+    
+    // เขียนครั้งเดียวต่อ port → pins ใน port เดียวกันเปลี่ยนพร้อมกัน
+    for (uint8_t idx = 0; idx < GPIO_PORT_COUNT; idx++) {
+        if (bshr[idx]) {
+            gpio_ports[idx]->BSHR = bshr[idx];
+        }
     }
 }
 
@@ -416,12 +868,169 @@ uint32_t pulseIn(uint8_t pin, uint8_t state, uint32_t timeout) {
     return pulse_end - pulse_start;
 }
 
+/**
+ * @brief วัดความกว้างของ pulse ด้วย timer input capture
+ */
+uint32_t pulseInCapture(uint8_t pin, uint8_t state, uint32_t timeout) {
+    CaptureMap_t cap;
+    if (!getCaptureMap(pin, &cap) || pulse_async.active) return 0;
+    
+    uint16_t timeout_ticks;
+    uint16_t prescaler = captureCalcPrescaler(timeout, &timeout_ticks);
+    captureConfigure(&cap, prescaler, state);
+    
+    TIM_TypeDef* tim = cap.tim;
+    uint16_t cc_flag = TIM_IT_CC1 << cap.channel;
+    uint32_t cycles = 0;
+    
+    tim->INTFR = (uint16_t)~cc_flag;
+    TIM_Start(cap.timer);
+    
+    // รอ edge เริ่มต้นของ pulse (counter เริ่มที่ 0)
+    if (captureWaitEdge(tim, cc_flag, 0, timeout_ticks)) {
+        uint16_t start = captureRead(tim, cap.channel);
+        
+        // สลับขอบแล้วรอ edge จบ
+        captureTogglePolarity(&cap);
+        tim->INTFR = (uint16_t)~cc_flag;
+        
+        if (captureWaitEdge(tim, cc_flag, start, timeout_ticks)) {
+            uint16_t ticks = (uint16_t)(captureRead(tim, cap.channel) - start);
+            cycles = (uint32_t)ticks * (prescaler + 1);
+        }
+    }
+    
+    captureRelease(&cap);
+    return cycles;
+}
+
+/**
+ * @brief เริ่มวัดความกว้างของ pulse แบบ async (ผลลัพธ์ผ่าน callback)
+ */
+uint8_t pulseInAsync(uint8_t pin, uint8_t state, uint32_t timeout, PulseInCallback callback) {
+    CaptureMap_t cap;
+    if (!callback || !getCaptureMap(pin, &cap) || pulse_async.active) return 0;
+    
+    pulse_async.cap = cap;
+    pulse_async.callback = callback;
+    pulse_async.pin = pin;
+    pulse_async.phase = 0;
+    pulse_async.prescaler = captureCalcPrescaler(timeout, &pulse_async.timeout_ticks);
+    pulse_async.active = 1;
+    
+    captureConfigure(&cap, pulse_async.prescaler, state);
+    
+    // Channel คู่เป็น output compare แบบ frozen (ไม่ออก pin) สำหรับ timeout
+    TIM_TypeDef* tim = cap.tim;
+    uint8_t timeout_ch = cap.channel ^ 1;
+    volatile uint16_t* chctlr = (timeout_ch < 2) ? &tim->CHCTLR1 : &tim->CHCTLR2;
+    *chctlr &= (uint16_t)~(0x00FF << ((timeout_ch & 1) * 8));
+    tim->CCER &= (uint16_t)~(0x000F << (timeout_ch * 4));
+    (&tim->CH1CVR)[timeout_ch] = pulse_async.timeout_ticks;
+    
+    uint16_t it_flags = (uint16_t)((TIM_IT_CC1 << cap.channel) | (TIM_IT_CC1 << timeout_ch));
+    tim->INTFR = (uint16_t)~it_flags;
+    TIM_AttachCCHandler(cap.timer, pulseAsyncHandler);
+    TIM_ITConfig(tim, it_flags, ENABLE);
+    TIM_Start(cap.timer);
+    
+    return 1;
+}
+
+/**
+ * @brief ตรวจสอบว่า pulseInAsync() กำลังวัดอยู่หรือไม่
+ */
+uint8_t pulseInAsyncBusy(void) {
+    return pulse_async.active;
+}
+
+/**
+ * @brief ยกเลิก pulseInAsync() ที่กำลังวัด (ไม่เรียก callback)
+ */
+void pulseInAsyncCancel(void) {
+    if (!pulse_async.active) return;
+    
+    TIM_DetachCCHandler(pulse_async.cap.timer);
+    captureRelease(&pulse_async.cap);
+    pulse_async.active = 0;
+}
+
+/* ========== Hardware Shift Helpers (SPI1) ========== */
+
+/**
+ * @brief ตรวจสอบว่า pins ตรงกับ SPI1 หรือไม่
+ */
+#define IS_SPI_SHIFT_OUT(dataPin, clockPin)  ((dataPin) == PC6 && (clockPin) == PC5)
+#define IS_SPI_SHIFT_IN(dataPin, clockPin)   ((dataPin) == PC7 && (clockPin) == PC5)
+
+/**
+ * @brief เตรียม SPI1 สำหรับ shift ด้วย mode และ bit order ที่ต้องการ
+ * @return config เดิมของ SPI1 (ส่งให้ SPI_RestoreConfig)
+ * 
+ * @note ถ้า SPI1 ยังไม่ถูก init จะ init ด้วย SPI_PINS_DEFAULT_NO_CS (PC4 ไม่ถูกแตะ)
+ * @note ถ้าผู้ใช้ init SPI1 ไว้แล้ว ความเร็วเดิมถูกใช้ต่อ และ config ถูกคืนหลังส่งเสร็จ
+ */
+static uint16_t shiftSPIBegin(uint8_t bitOrder, SPI_Mode mode) {
+    if (!SPI_IsEnabled()) {
+        SPI_SimpleInit(SPI_MODE0, SIMPLE_GPIO_SHIFT_SPI_SPEED, SPI_PINS_DEFAULT_NO_CS);
+    }
+    return SPI_ApplyConfig(mode, (bitOrder == LSBFIRST) ? SPI_LSB_FIRST : SPI_MSB_FIRST);
+}
+
+/**
+ * @brief ส่ง buffer ออก SPI1 ด้วย DMA (TX อย่างเดียว, blocking)
+ * @return 1 = ส่งแล้ว, 0 = DMA channel ถูกจองอยู่ (เช่น SimpleSPI_Async) ผู้เรียกส่งเอง
+ */
+static uint8_t shiftSPIWriteDMA(const uint8_t* data, uint16_t len) {
+    if (DMA_AllocChannel(DMA_REQ_SPI1_TX) == DMA_CH_NONE) return 0;
+    
+    DMA_Config_t tx_config = {
+        .channel = SIMPLE_GPIO_SHIFT_DMA_CHANNEL,
+        .direction = DMA_DIR_MEM_TO_PERIPH,
+        .priority = DMA_PRIORITY_HIGH,
+        .data_size = DMA_SIZE_BYTE,
+        .mode = DMA_MODE_NORMAL,
+        .mem_increment = 1,
+        .periph_increment = 0,
+        .periph_addr = (uint32_t)&SPI1->DATAR,
+        .mem_addr = (uint32_t)data,
+        .buffer_size = len
+    };
+    
+    DMA_SimpleInit(&tx_config);
+    SPI_I2S_DMACmd(SPI1, SPI_I2S_DMAReq_Tx, ENABLE);
+    DMA_Start(SIMPLE_GPIO_SHIFT_DMA_CHANNEL);
+    DMA_WaitComplete(SIMPLE_GPIO_SHIFT_DMA_CHANNEL, 0);
+    
+    // รอ byte สุดท้ายออกจาก shift register
+    while (SPI_I2S_GetFlagStatus(SPI1, SPI_I2S_FLAG_TXE) == RESET);
+    while (SPI_I2S_GetFlagStatus(SPI1, SPI_I2S_FLAG_BSY) != RESET);
+    SPI_I2S_DMACmd(SPI1, SPI_I2S_DMAReq_Tx, DISABLE);
+    DMA_Stop(SIMPLE_GPIO_SHIFT_DMA_CHANNEL);
+    DMA_FreeChannel(SIMPLE_GPIO_SHIFT_DMA_CHANNEL);
+    
+    // ล้าง RX ที่ไม่ได้อ่าน (DATAR แล้วตาม STATR เพื่อ clear OVR)
+    (void)SPI1->DATAR;
+    (void)SPI1->STATR;
+    return 1;
+}
+
 /**
  * @brief ส่งข้อมูล 1 byte ผ่าน software SPI (shift out)
  */
 void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t value) {
     uint8_t i;
     
+#if SIMPLE_GPIO_SHIFT_USE_SPI
+    // ใช้ SPI1 เมื่อ pins ตรงกับ MOSI/SCK (mode 0: data ก่อนขอบขาขึ้น)
+    if (IS_SPI_SHIFT_OUT(dataPin, clockPin)) {
+        uint16_t saved = shiftSPIBegin(bitOrder, SPI_MODE0);
+        SPI_Transfer(value);
+        SPI_RestoreConfig(saved);
+        return;
+    }
+#endif
+    
     for (i = 0; i < 8; i++) {
         if (bitOrder == LSBFIRST) {
             // ส่ง LSB ก่อน
@@ -446,6 +1055,16 @@ uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder) {
     uint8_t value = 0;
     uint8_t i;
     
+#if SIMPLE_GPIO_SHIFT_USE_SPI
+    // ใช้ SPI1 เมื่อ pins ตรงกับ MISO/SCK (mode 1: อ่านหลังขอบขาขึ้น เหมือน bit-bang)
+    if (IS_SPI_SHIFT_IN(dataPin, clockPin)) {
+        uint16_t saved = shiftSPIBegin(bitOrder, SPI_MODE1);
+        value = SPI_Transfer(0x00);
+        SPI_RestoreConfig(saved);
+        return value;
+    }
+#endif
+    
     for (i = 0; i < 8; i++) {
         // สร้าง clock pulse
         digitalWrite(clockPin, HIGH);
@@ -467,26 +1086,96 @@ uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder) {
     return value;
 }
 
+/**
+ * @brief ส่งข้อมูลหลาย bytes ผ่าน shift register chain
+ */
+void shiftOutBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, const uint8_t* data, uint16_t len) {
+    if (!data || len == 0) return;
+    
+#if SIMPLE_GPIO_SHIFT_USE_SPI
+    if (IS_SPI_SHIFT_OUT(dataPin, clockPin)) {
+        uint16_t saved = shiftSPIBegin(bitOrder, SPI_MODE0);
+        
+        if (len < SIMPLE_GPIO_SHIFT_DMA_THRESHOLD || !shiftSPIWriteDMA(data, len)) {
+            for (uint16_t i = 0; i < len; i++) {
+                SPI_Transfer(data[i]);
+            }
+        }
+        
+        SPI_RestoreConfig(saved);
+        return;
+    }
+#endif
+    
+    for (uint16_t i = 0; i < len; i++) {
+        shiftOut(dataPin, clockPin, bitOrder, data[i]);
+    }
+}
+
+/**
+ * @brief รับข้อมูลหลาย bytes จาก shift register chain
+ */
+void shiftInBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t* data, uint16_t len) {
+    if (!data || len == 0) return;
+    
+#if SIMPLE_GPIO_SHIFT_USE_SPI
+    if (IS_SPI_SHIFT_IN(dataPin, clockPin)) {
+        uint16_t saved = shiftSPIBegin(bitOrder, SPI_MODE1);
+        SPI_Read(data, len, 0x00);
+        SPI_RestoreConfig(saved);
+        return;
+    }
+#endif
+    
+    for (uint16_t i = 0; i < len; i++) {
+        data[i] = shiftIn(dataPin, clockPin, bitOrder);
+    }
+}
+
 /* ========== Interrupt Handlers ========== */
 
+#if SIMPLE_GPIO_EXTI
 /**
  * @brief EXTI interrupt handler
  * @note ใช้สำหรับ EXTI lines 0-7
+ * @note อ่าน pending register ครั้งเดียว แล้ววนเฉพาะ bit ที่ set
  */
 void EXTI7_0_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
 void EXTI7_0_IRQHandler(void) {
-    // ตรวจสอบแต่ละ EXTI line
-    for (uint8_t i = 0; i < 8; i++) {
-        uint16_t exti_line = (1 << i);
+    ISR_STAT_ENTER(ISR_STAT_EXTI);
+    uint32_t pending = EXTI->INTFR & EXTI->INTENR & 0xFF;
+    
+    // Clear ทุก line ที่จะถูก dispatch ในครั้งเดียว (write 1 to clear)
+    EXTI->INTFR = pending;
+    
+#if SIMPLE_GPIO_CAPTURE_SIZE
+    // Lines ที่อยู่ใน capture mode บันทึกลง buffer อย่างเดียว
+    uint32_t capture = pending & edge_capture_lines;
+    if (capture) {
+        edgeCapturePush(capture);
+        pending &= ~capture;
+    }
+#endif
+    
+    // Lines แบบ deferred: post mask เป็น event เดียว (EXTI ใช้ preemption priority 1)
+    uint32_t deferred = pending & exti_deferred_lines;
+    if (deferred) {
+        Event_Defer(EVENT_RING_LOW, EVENT_ID(EVENT_SOURCE_GPIO, 0), (uint16_t)deferred);
+        pending &= ~deferred;
+    }
+    
+    while (pending) {
+        // หา bit ต่ำสุด: เลือก nibble แล้วเปิด table
+        uint8_t line = (pending & 0x0F) ? 0 : 4;
+        line += nibble_ctz[(pending >> line) & 0x0F];
+        pending &= pending - 1;
         
-        if (EXTI_GetITStatus(exti_line) != RESET) {
-            // เรียก callback ถ้ามี
-            if (exti_callbacks[i]) {
-                exti_callbacks[i]();
-            }
-            
-            // Clear interrupt flag
-            EXTI_ClearITPendingBit(exti_line);
+        if (exti_arg_callbacks[line]) {
+            exti_arg_callbacks[line](exti_contexts[line]);
+        } else if (exti_callbacks[line]) {
+            exti_callbacks[line]();
         }
     }
+    ISR_STAT_EXIT(ISR_STAT_EXTI);
 }
+#endif  // SIMPLE_GPIO_EXTI
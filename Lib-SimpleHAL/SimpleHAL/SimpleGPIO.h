@@ -1,8 +1,8 @@
 /**
  * @file SimpleGPIO.h
  * @brief Simple GPIO Library สำหรับ CH32V003
- * @version 1.3
- * @date 2025-12-22
+ * @version 1.5
+ * @date 2026-10-14
  * 
  * @details
  * Library นี้ให้ API สำหรับการควบคุม GPIO pins ของ CH32V003
@@ -11,12 +11,17 @@
  * **คุณสมบัติ:**
  * - pinMode() สำหรับตั้งค่าโหมด
  * - digitalWrite() / digitalRead()
- * - digitalToggle() สำหรับสลับสถานะ
- * - attachInterrupt() / detachInterrupt()
+ * - digitalToggle() สำหรับสลับสถานะ (atomic, BSHR store เดียว)
+ * - portToggleMask() สำหรับสลับหลาย pins ใน port เดียวกันพร้อมกัน
+ * - attachInterrupt() / attachInterruptArg() / attachInterruptDeferred() / detachInterrupt()
+ * - attachEdgeCapture() บันทึก edges พร้อม timestamp ลง ring buffer
  * - analogRead() สำหรับอ่านค่า ADC (PD2-PD7)
  * - analogWrite() สำหรับสร้าง PWM (PA1, PC0, PC3-4, PD2-4, PD7)
+ * - pulseInCapture() / pulseInAsync() วัด pulse ด้วย timer input capture
+ * - shiftOut() / shiftIn() ใช้ SPI1 (และ DMA สำหรับ buffer) อัตโนมัติเมื่อ pins ตรงกับ SPI1
  * - ใช้ชื่อ pin ตามจริงของ CH32V003
  * - **Hybrid Pin Validation:** ตรวจสอบ pin ที่ไม่รองรับทั้งตอนคอมไพล์และ runtime
+ * - **Fast Path:** digitalWrite()/digitalRead() กับ constant pin คอมไพล์เหลือ register access เดียว
  * 
  * **GPIO Pins ของ CH32V003:**
  * - GPIOA: PA1-PA2 (PA1 รองรับ PWM)
@@ -50,6 +55,7 @@ extern "C" {
 
 #include <ch32v00x.h>
 #include <stdint.h>
+#include "SimpleHAL_Config.h"
 
 /* ========== Pin Definitions ========== */
 
@@ -99,6 +105,51 @@ typedef enum {
     PIN_MODE_OUTPUT_OD            /**< Output open-drain */
 } GPIO_PinMode;
 
+/* ========== Configuration ========== */
+
+/**
+ * @brief ให้ shiftOut()/shiftIn() ใช้ SPI1 เมื่อ pins ตรงกับ SCK/MOSI/MISO
+ * @note ตั้งเป็น 0 เพื่อใช้ bit-bang เสมอ
+ */
+#ifndef SIMPLE_GPIO_SHIFT_USE_SPI
+#define SIMPLE_GPIO_SHIFT_USE_SPI       1
+#endif
+
+/**
+ * @brief ความเร็ว SPI1 เมื่อ shiftOut()/shiftIn() เป็นผู้ init (ค่า SPI_Speed)
+ * @note ค่าเริ่มต้น = PCLK/8 (6 MHz @ 48MHz)
+ */
+#ifndef SIMPLE_GPIO_SHIFT_SPI_SPEED
+#define SIMPLE_GPIO_SHIFT_SPI_SPEED     SPI_4MHZ
+#endif
+
+/**
+ * @brief DMA channel สำหรับ shiftOutBuffer() (CH3 = SPI1_TX)
+ */
+#ifndef SIMPLE_GPIO_SHIFT_DMA_CHANNEL
+#define SIMPLE_GPIO_SHIFT_DMA_CHANNEL   DMA_CH3
+#endif
+
+/**
+ * @brief จำนวน bytes ขั้นต่ำที่ shiftOutBuffer() จะใช้ DMA
+ */
+#ifndef SIMPLE_GPIO_SHIFT_DMA_THRESHOLD
+#define SIMPLE_GPIO_SHIFT_DMA_THRESHOLD 8
+#endif
+
+/**
+ * @brief ขนาด ring buffer ของ edge capture (ต้องเป็นกำลังของ 2)
+ * @note ใช้ RAM 8 bytes ต่อ entry, เก็บได้ SIZE-1 edges
+ * @note 0 = ตัด attachEdgeCapture() และ buffer ออก (EXTI callbacks ยังใช้ได้)
+ */
+#ifndef SIMPLE_GPIO_CAPTURE_SIZE
+#define SIMPLE_GPIO_CAPTURE_SIZE        32
+#endif
+
+#if (SIMPLE_GPIO_CAPTURE_SIZE & (SIMPLE_GPIO_CAPTURE_SIZE - 1)) != 0
+#error "SIMPLE_GPIO_CAPTURE_SIZE must be a power of 2"
+#endif
+
 /* ========== Digital Values ========== */
 
 #ifndef HIGH
@@ -130,6 +181,21 @@ typedef enum {
     CHANGE         /**< Trigger on both edges */
 } GPIO_InterruptMode;
 
+/**
+ * @brief Edge ที่อ่านได้จาก edge capture buffer
+ */
+typedef struct {
+    uint32_t time_us;  /**< เวลาที่เกิด edge (microseconds, timebase เดียวกับ Get_CurrentUs) */
+    uint8_t pin;       /**< หมายเลข pin */
+    uint8_t level;     /**< ระดับของ pin ตอนเข้า ISR (HIGH/LOW) */
+} GPIO_Edge_t;
+
+/**
+ * @brief Interrupt callback แบบมี context pointer
+ * @param context ค่าที่ส่งให้ตอน attachInterruptArg()
+ */
+typedef void (*GPIO_InterruptArgCallback)(void* context);
+
 /* ========== Function Prototypes ========== */
 
 /**
@@ -163,6 +229,7 @@ void _pinModeMultiple(const uint8_t* pins, uint8_t count, GPIO_PinMode mode);
  * 
  * @note Macro นี้จะคำนวณจำนวน pins อัตโนมัติ ไม่ต้องระบุ count
  * @note ใช้ได้เฉพาะ array ที่ประกาศแบบ const uint8_t arr[] = {...}
+ * @note pins ถูกจัดกลุ่มตาม port แล้วอัปเดต CFGLR ครั้งเดียวต่อ port
  * 
  * @example
  * // ตั้งค่า LED 3 ดวงเป็น output พร้อมกัน (ไม่ต้องบอกจำนวน!)
@@ -209,6 +276,7 @@ uint8_t digitalRead(uint8_t pin);
  * @param pin หมายเลข pin (PA1-PA2, PC0-PC7, PD2-PD7)
  * 
  * @note Pin ต้องถูกตั้งเป็น OUTPUT mode ก่อน
+ * @note เป็น atomic operation (BSHR store เดียว) เรียกใน ISR ได้อย่างปลอดภัย
  * 
  * @example
  * pinMode(PC0, PIN_MODE_OUTPUT);
@@ -219,6 +287,7 @@ uint8_t digitalRead(uint8_t pin);
  */
 void digitalToggle(uint8_t pin);
 
+#if SIMPLE_GPIO_EXTI
 /**
  * @brief ตั้งค่า external interrupt สำหรับ pin
  * @param pin หมายเลข pin (PA1-PA2, PC0-PC7, PD2-PD7)
@@ -238,6 +307,48 @@ void digitalToggle(uint8_t pin);
  */
 void attachInterrupt(uint8_t pin, void (*callback)(void), GPIO_InterruptMode mode);
 
+/**
+ * @brief ตั้งค่า external interrupt แบบมี context pointer
+ * @param pin หมายเลข pin (PA1-PA2, PC0-PC7, PD2-PD7)
+ * @param callback ฟังก์ชันที่จะถูกเรียกพร้อม context
+ * @param context pointer ที่ส่งให้ callback (เช่น struct ของ driver)
+ * @param mode โหมด interrupt (RISING, FALLING, CHANGE)
+ * 
+ * @note callback เดียวใช้ได้กับหลาย pins โดยแยกด้วย context
+ * @note แทนที่ callback เดิมของ EXTI line เดียวกัน (ทั้งแบบมีและไม่มี context)
+ * 
+ * @example
+ * typedef struct { uint8_t pin_a, pin_b; volatile int32_t count; } Encoder_t;
+ * Encoder_t enc1 = {PC1, PC2, 0};
+ * Encoder_t enc2 = {PD3, PD4, 0};
+ * 
+ * void encoder_isr(void* ctx) {
+ *     Encoder_t* enc = (Encoder_t*)ctx;
+ *     enc->count += digitalRead(enc->pin_b) ? 1 : -1;
+ * }
+ * 
+ * attachInterruptArg(PC1, encoder_isr, &enc1, RISING);
+ * attachInterruptArg(PD3, encoder_isr, &enc2, RISING);
+ */
+void attachInterruptArg(uint8_t pin, GPIO_InterruptArgCallback callback, void* context, GPIO_InterruptMode mode);
+
+/**
+ * @brief ตั้งค่า external interrupt ที่ callback ทำใน main loop แทน ISR
+ * @param pin หมายเลข pin (PA1-PA2, PC0-PC7, PD2-PD7)
+ * @param callback เรียกจาก Event_Dispatch()
+ * @param mode โหมด interrupt (RISING, FALLING, CHANGE)
+ *
+ * @note ISR แค่ post mask ของ lines ลง EVENT_RING_LOW (SimpleEvent.h)
+ * @note Edges ที่เกิดซ้ำก่อน Event_Dispatch() ได้ event แยกกันจนกว่า queue เต็ม
+ *
+ * @example
+ * attachInterruptDeferred(PC1, button_pressed, FALLING);
+ * while (1) {
+ *     Event_Dispatch();
+ * }
+ */
+void attachInterruptDeferred(uint8_t pin, void (*callback)(void), GPIO_InterruptMode mode);
+
 /**
  * @brief ยกเลิก external interrupt ของ pin
  * @param pin หมายเลข pin (PC0-PC7, PD2-PD7)
@@ -247,6 +358,63 @@ void attachInterrupt(uint8_t pin, void (*callback)(void), GPIO_InterruptMode mod
  */
 void detachInterrupt(uint8_t pin);
 
+#if SIMPLE_GPIO_CAPTURE_SIZE
+/**
+ * @brief บันทึก edges ของ pin ลง ring buffer (แทนการเรียก callback)
+ * @param pin หมายเลข pin (PA1-PA2, PC0-PC7, PD2-PD7)
+ * @param mode edge ที่ต้องการบันทึก (RISING, FALLING, CHANGE)
+ * 
+ * @details
+ * ISR บันทึกเพียง (pin, level, timestamp ดิบจาก SysTick) ไม่มีการหารหรือเรียก callback
+ * การแปลงเป็น microseconds ทำตอน edgeCaptureRead() ใน main loop
+ * 
+ * @note Pin ต้องถูกตั้งเป็น INPUT mode ก่อน
+ * @note ต้องอ่าน buffer อย่างน้อยทุก ~65 วินาที เพื่อให้ต่อ timestamp ได้ถูกต้อง
+ * @note Timestamp มาจาก Get_CurrentMsTicks() จึงใช้ได้กับ SIMPLE_DELAY_TICKLESS
+ * @note ยกเลิกด้วย detachInterrupt()
+ * 
+ * @example
+ * GPIO_Edge_t edges[16];
+ * 
+ * pinMode(PD3, PIN_MODE_INPUT_PULLUP);
+ * attachEdgeCapture(PD3, CHANGE);
+ * 
+ * while (1) {
+ *     uint16_t n = edgeCaptureRead(edges, 16);
+ *     for (uint16_t i = 1; i < n; i++) {
+ *         uint32_t width = edges[i].time_us - edges[i - 1].time_us;
+ *     }
+ * }
+ */
+void attachEdgeCapture(uint8_t pin, GPIO_InterruptMode mode);
+
+/**
+ * @brief จำนวน edges ที่รอให้อ่าน
+ * @return จำนวน edges ใน buffer
+ */
+uint16_t edgeCaptureAvailable(void);
+
+/**
+ * @brief อ่าน edges ออกจาก buffer ทีละชุด
+ * @param events array สำหรับเก็บผลลัพธ์
+ * @param max_events ขนาดของ array
+ * @return จำนวน edges ที่อ่านได้
+ */
+uint16_t edgeCaptureRead(GPIO_Edge_t* events, uint16_t max_events);
+
+/**
+ * @brief จำนวน edges ที่หายเพราะ buffer เต็ม
+ * @return จำนวน edges ที่หาย (นับตั้งแต่ edgeCaptureClear() ครั้งล่าสุด)
+ */
+uint16_t edgeCaptureOverruns(void);
+
+/**
+ * @brief ล้าง buffer และตัวนับ overrun
+ */
+void edgeCaptureClear(void);
+#endif  // SIMPLE_GPIO_CAPTURE_SIZE
+#endif  // SIMPLE_GPIO_EXTI
+
 /* ========== Advanced Functions ========== */
 
 /**
@@ -290,6 +458,153 @@ uint8_t portRead(GPIO_TypeDef* port);
                          (pin) == PD2 || (pin) == PD3 || \
                          (pin) == PD4 || (pin) == PD7)
 
+/**
+ * @brief ตรวจสอบว่าเป็น GPIO pin ที่มีอยู่จริงหรือไม่
+ * @note Pins ที่มี: PA1-PA2, PC0-PC7, PD2-PD7
+ */
+#define IS_GPIO_PIN(pin) ((pin) <= PA2 || \
+                          ((pin) >= PC0 && (pin) <= PC7) || \
+                          ((pin) >= PD2 && (pin) <= PD7))
+
+/**
+ * @brief ประเมินเงื่อนไขตอนคอมไพล์เฉพาะเมื่อ pin เป็น constant
+ * @details ถ้า pin เป็นตัวแปร จะได้ค่า 1 เสมอ ทำให้ _Static_assert ไม่ error
+ *          และปล่อยให้ runtime validation ทำงานแทน
+ */
+#define GPIO_CONST_CHECK(pin, cond) \
+    __builtin_choose_expr(__builtin_constant_p(pin), (cond), 1)
+
+/* ========== Fast Path (Constant Pins) ========== */
+
+/**
+ * @brief แปลงหมายเลข pin เป็น GPIO port
+ * @note คำนวณจาก encoding ของ GPIO_Pin: 0-9 = GPIOA, 10-19 = GPIOC, 20-29 = GPIOD
+ */
+#define GPIO_PIN_PORT(pin) ((pin) < PC0 ? GPIOA : ((pin) < PD2 ? GPIOC : GPIOD))
+
+/**
+ * @brief แปลงหมายเลข pin เป็น bit mask ภายใน port
+ * @note PA1 = 0 → bit 1, PC0 = 10 → bit 0, PD2 = 20 → bit 2
+ */
+#define GPIO_PIN_MASK(pin) ((uint16_t)(1u << ((pin) < PC0 ? (pin) + 1 : \
+                                             ((pin) < PD2 ? (pin) - PC0 : (pin) - PD2 + 2))))
+
+/**
+ * @brief เขียนค่า digital แบบ inline (ไม่มี lookup table)
+ * @param pin หมายเลข pin (ควรเป็น constant เพื่อให้คอมไพล์เหลือ store เดียว)
+ * @param value HIGH หรือ LOW
+ *
+ * @note ไม่มีการตรวจสอบ pin ตอน runtime ใช้ผ่าน macro digitalWrite() จะปลอดภัยกว่า
+ * @note BSHR/BCR เป็น write-only จึง atomic เทียบกับ ISR ที่ใช้ port เดียวกัน
+ *
+ * @example
+ * digitalWriteFast(PD4, HIGH);  // คอมไพล์เป็น GPIOD->BSHR = (1 << 4)
+ */
+static inline __attribute__((always_inline)) void digitalWriteFast(uint8_t pin, uint8_t value) {
+    if (value) {
+        GPIO_PIN_PORT(pin)->BSHR = GPIO_PIN_MASK(pin);
+    } else {
+        GPIO_PIN_PORT(pin)->BCR = GPIO_PIN_MASK(pin);
+    }
+}
+
+/**
+ * @brief อ่านค่า digital แบบ inline (ไม่มี lookup table)
+ * @param pin หมายเลข pin (ควรเป็น constant)
+ * @return HIGH หรือ LOW
+ *
+ * @example
+ * if (digitalReadFast(PC1) == LOW) { ... }  // คอมไพล์เป็น GPIOC->INDR & (1 << 1)
+ */
+static inline __attribute__((always_inline)) uint8_t digitalReadFast(uint8_t pin) {
+    return (GPIO_PIN_PORT(pin)->INDR & GPIO_PIN_MASK(pin)) ? HIGH : LOW;
+}
+
+/**
+ * @brief สลับสถานะหลาย pins ใน port เดียวกันแบบ atomic
+ * @param port GPIO port (GPIOA, GPIOC, GPIOD)
+ * @param mask bit mask ของ pins ที่ต้องการสลับ (เช่น GPIO_Pin_0 | GPIO_Pin_3)
+ *
+ * @details
+ * คำนวณจาก OUTDR แล้วเขียน BSHR ครั้งเดียว: bit ที่เป็น 1 ถูก reset (ครึ่งบน)
+ * bit ที่เป็น 0 ถูก set (ครึ่งล่าง) pins อื่นใน port ไม่ถูกแตะ
+ * จึงไม่ชนกับ ISR ที่เขียน pins อื่นของ port เดียวกัน
+ *
+ * @example
+ * portToggleMask(GPIOC, GPIO_Pin_0 | GPIO_Pin_1);  // สลับ PC0 และ PC1 พร้อมกัน
+ */
+static inline __attribute__((always_inline)) void portToggleMask(GPIO_TypeDef* port, uint16_t mask) {
+    uint32_t out = port->OUTDR & mask;
+    port->BSHR = (out << 16) | (~out & mask);
+}
+
+/**
+ * @brief สลับสถานะ pin แบบ inline (ไม่มี lookup table)
+ * @param pin หมายเลข pin (ควรเป็น constant)
+ *
+ * @example
+ * digitalToggleFast(PC0);  // อ่าน GPIOC->OUTDR แล้วเขียน BSHR ครั้งเดียว
+ */
+static inline __attribute__((always_inline)) void digitalToggleFast(uint8_t pin) {
+    portToggleMask(GPIO_PIN_PORT(pin), GPIO_PIN_MASK(pin));
+}
+
+/**
+ * @brief เขียนค่า digital (Hybrid: constant pin → fast path, ตัวแปร → lookup table)
+ *
+ * **Pin Validation:**
+ * - ถ้าใช้ constant (เช่น PD4) → ตรวจสอบตอนคอมไพล์ แล้วเหลือ BSHR/BCR store เดียว
+ * - ถ้าใช้ตัวแปร → เรียกฟังก์ชัน digitalWrite() ปกติซึ่งตรวจสอบตอน runtime
+ *
+ * @note ต้องการเรียกฟังก์ชันจริงเสมอ (เช่นใช้เป็น function pointer) ให้ใช้ (digitalWrite)
+ *
+ * @example
+ * digitalWrite(PD4, HIGH);     // GPIOD->BSHR = 0x10
+ * digitalWrite(PA3, HIGH);     // ✗ Compile Error! ไม่มี PA3
+ * digitalWrite(my_pin, HIGH);  // runtime lookup
+ */
+#define digitalWrite(pin, value) __builtin_choose_expr( \
+    __builtin_constant_p(pin), \
+    ({ \
+        _Static_assert(GPIO_CONST_CHECK(pin, IS_GPIO_PIN(pin)), \
+            "digitalWrite: Invalid pin! Valid: PA1-PA2, PC0-PC7, PD2-PD7"); \
+        digitalWriteFast(pin, value); \
+    }), \
+    digitalWrite(pin, value) \
+)
+
+/**
+ * @brief อ่านค่า digital (Hybrid: constant pin → fast path, ตัวแปร → lookup table)
+ *
+ * @example
+ * uint8_t state = digitalRead(PC1);  // GPIOC->INDR & 0x02
+ */
+#define digitalRead(pin) __builtin_choose_expr( \
+    __builtin_constant_p(pin), \
+    ({ \
+        _Static_assert(GPIO_CONST_CHECK(pin, IS_GPIO_PIN(pin)), \
+            "digitalRead: Invalid pin! Valid: PA1-PA2, PC0-PC7, PD2-PD7"); \
+        digitalReadFast(pin); \
+    }), \
+    digitalRead(pin) \
+)
+
+/**
+ * @brief สลับสถานะ pin (Hybrid: constant pin → fast path, ตัวแปร → lookup table)
+ *
+ * @example
+ * digitalToggle(PC0);  // BSHR store เดียว, ปลอดภัยเมื่อเรียกใน ISR
+ */
+#define digitalToggle(pin) __builtin_choose_expr( \
+    __builtin_constant_p(pin), \
+    ({ \
+        _Static_assert(GPIO_CONST_CHECK(pin, IS_GPIO_PIN(pin)), \
+            "digitalToggle: Invalid pin! Valid: PA1-PA2, PC0-PC7, PD2-PD7"); \
+        digitalToggleFast(pin); \
+    }), \
+    digitalToggle(pin) \
+)
+
 /* ========== Analog Functions ========== */
 
 /**
@@ -336,7 +651,7 @@ uint16_t _analogRead_impl(uint8_t pin);
 #define analogRead(pin) __builtin_choose_expr( \
     __builtin_constant_p(pin), \
     ({ \
-        _Static_assert(IS_ADC_PIN(pin), \
+        _Static_assert(GPIO_CONST_CHECK(pin, IS_ADC_PIN(pin)), \
             "analogRead: Pin does not support ADC! Only PA1, PA2, PC4, PD2-PD6 support ADC."); \
         _analogRead_impl(pin); \
     }), \
@@ -388,7 +703,7 @@ void _analogWrite_impl(uint8_t pin, uint8_t value);
 #define analogWrite(pin, value) __builtin_choose_expr( \
     __builtin_constant_p(pin), \
     ({ \
-        _Static_assert(IS_PWM_PIN(pin), \
+        _Static_assert(GPIO_CONST_CHECK(pin, IS_PWM_PIN(pin)), \
             "analogWrite: Pin does not support PWM! Supported: PA1, PC0, PC3-4, PD2-4, PD7"); \
         _analogWrite_impl(pin, value); \
     }), \
@@ -412,6 +727,8 @@ void _digitalWriteMultiple(const uint8_t* pins, const uint8_t* values, uint8_t c
  * 
  * @note Macro นี้จะคำนวณจำนวน pins อัตโนมัติ
  * @note ขนาด pins_array และ values_array ต้องเท่ากัน
+ * @note เขียน BSHR ครั้งเดียวต่อ port → pins ใน port เดียวกันเปลี่ยนใน clock เดียวกัน
+ * @note ถ้า pin ซ้ำกันใน array และค่าต่างกัน ฮาร์ดแวร์จะให้ set ชนะ
  * 
  * @example
  * const uint8_t leds[] = {PC0, PC1, PC2};
@@ -444,6 +761,79 @@ void _digitalWriteMultiple(const uint8_t* pins, const uint8_t* values, uint8_t c
  */
 uint32_t pulseIn(uint8_t pin, uint8_t state, uint32_t timeout);
 
+/**
+ * @brief Callback ของ pulseInAsync()
+ * @param pin pin ที่วัด
+ * @param cycles ความกว้างของ pulse (หน่วย SystemCoreClock cycles), 0 = timeout
+ */
+typedef void (*PulseInCallback)(uint8_t pin, uint32_t cycles);
+
+/**
+ * @brief แปลงจำนวน cycles เป็น microseconds
+ */
+#define PULSE_CYCLES_TO_US(cycles)  ((cycles) / (SystemCoreClock / 1000000))
+
+/**
+ * @brief แปลงจำนวน cycles เป็น nanoseconds (สำหรับ pulse สั้นกว่า ~89 ms @ 48MHz)
+ */
+#define PULSE_CYCLES_TO_NS(cycles)  (((cycles) * 1000) / (SystemCoreClock / 1000000))
+
+/**
+ * @brief วัดความกว้างของ pulse ด้วย timer input capture (hardware timestamp)
+ * @param pin pin ที่รองรับ capture: PD2, PA1, PC3, PC4 (TIM1), PD4, PD3, PC0, PD7 (TIM2)
+ * @param state ชนิดของ pulse ที่ต้องการวัด (HIGH หรือ LOW)
+ * @param timeout ระยะเวลา timeout (microseconds) ต่อช่วงรอ, 0 = สูงสุด 1 วินาที
+ * @return ความกว้างของ pulse (หน่วย SystemCoreClock cycles), 0 = timeout หรือ pin ไม่รองรับ
+ * 
+ * @details
+ * Edge ถูก timestamp โดย hardware จึงไม่ขึ้นกับความเร็ว loop
+ * ความละเอียด = (prescaler+1) cycles โดย prescaler คำนวณจาก timeout
+ * เช่น timeout 30ms @ 48MHz → ~0.46us, timeout 2.5ms → 1 cycle (~21ns)
+ * 
+ * @note Timer ของ pin จะถูกตั้งค่าใหม่ ห้ามใช้ร่วมกับ PWM/SimpleTIM บน timer เดียวกัน
+ * @note Pin ต้องถูกตั้งเป็น INPUT mode ก่อน
+ * 
+ * @example
+ * uint32_t cycles = pulseInCapture(PD4, HIGH, 30000);
+ * uint32_t us = PULSE_CYCLES_TO_US(cycles);
+ */
+uint32_t pulseInCapture(uint8_t pin, uint8_t state, uint32_t timeout);
+
+/**
+ * @brief เริ่มวัดความกว้างของ pulse แบบ async ด้วย timer input capture
+ * @param pin pin ที่รองรับ capture (เหมือน pulseInCapture)
+ * @param state ชนิดของ pulse ที่ต้องการวัด (HIGH หรือ LOW)
+ * @param timeout ระยะเวลา timeout (microseconds) ต่อช่วงรอ, 0 = สูงสุด 1 วินาที
+ * @param callback ฟังก์ชันที่ถูกเรียกจาก ISR เมื่อวัดเสร็จหรือ timeout
+ * @return 1 = เริ่มวัดแล้ว, 0 = pin ไม่รองรับหรือกำลังวัดอยู่
+ * 
+ * @note วัดได้ทีละ 1 pulse, channel คู่ (CH1↔CH2, CH3↔CH4) ถูกใช้เป็น timeout
+ * @note Callback ทำงานใน interrupt context ควรทำงานให้สั้น
+ * 
+ * @example
+ * volatile uint32_t echo_us = 0;
+ * void on_echo(uint8_t pin, uint32_t cycles) {
+ *     echo_us = PULSE_CYCLES_TO_US(cycles);
+ * }
+ * 
+ * pulseInAsync(PD4, HIGH, 30000, on_echo);
+ * while (pulseInAsyncBusy()) {
+ *     // ทำงานอื่นได้
+ * }
+ */
+uint8_t pulseInAsync(uint8_t pin, uint8_t state, uint32_t timeout, PulseInCallback callback);
+
+/**
+ * @brief ตรวจสอบว่า pulseInAsync() กำลังวัดอยู่หรือไม่
+ * @return 1 = กำลังวัด, 0 = ว่าง
+ */
+uint8_t pulseInAsyncBusy(void);
+
+/**
+ * @brief ยกเลิก pulseInAsync() ที่กำลังวัด (ไม่เรียก callback)
+ */
+void pulseInAsyncCancel(void);
+
 /**
  * @brief ส่งข้อมูล 1 byte ผ่าน software SPI (shift out)
  * @param dataPin pin สำหรับส่งข้อมูล
@@ -453,6 +843,8 @@ uint32_t pulseIn(uint8_t pin, uint8_t state, uint32_t timeout);
  * 
  * @note ใช้สำหรับควบคุม 74HC595, LED matrix, shift register
  * @note Clock frequency ~100kHz (ขึ้นกับ system clock)
+ * @note ถ้า dataPin = PC6 (MOSI) และ clockPin = PC5 (SCK) จะส่งผ่าน SPI1 แทน (~6 MHz)
+ *       PC5/PC6/PC7 จะกลายเป็น SPI pins หลังเรียกครั้งแรก
  * 
  * @example
  * // ควบคุม 74HC595 (8-bit shift register)
@@ -475,6 +867,7 @@ void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t value
  * 
  * @note ใช้สำหรับอ่าน 74HC165, keypad matrix, shift register
  * @note Clock frequency ~100kHz (ขึ้นกับ system clock)
+ * @note ถ้า dataPin = PC7 (MISO) และ clockPin = PC5 (SCK) จะรับผ่าน SPI1 แทน (SPI mode 1)
  * 
  * @example
  * // อ่าน 74HC165 (8-bit shift register)
@@ -490,6 +883,41 @@ void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t value
  */
 uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder);
 
+/**
+ * @brief ส่งข้อมูลหลาย bytes ผ่าน shift register chain (daisy chain)
+ * @param dataPin pin สำหรับส่งข้อมูล
+ * @param clockPin pin สำหรับ clock signal
+ * @param bitOrder ลำดับการส่ง bit (LSBFIRST หรือ MSBFIRST)
+ * @param data ข้อมูลที่ต้องการส่ง (byte แรกจะไปอยู่ปลาย chain)
+ * @param len จำนวน bytes
+ * 
+ * @note ถ้า pins ตรงกับ SPI1 และ len >= SIMPLE_GPIO_SHIFT_DMA_THRESHOLD จะส่งด้วย DMA
+ *       (SIMPLE_GPIO_SHIFT_DMA_CHANNEL) ต่อเนื่องไม่มีช่องว่างระหว่าง bytes
+ *       จองผ่าน DMA_AllocChannel() ระหว่างส่ง ถ้าถูกจองอยู่จะส่งทีละ byte แทน
+ * 
+ * @example
+ * // 74HC595 x 8 ตัว ต่อ PC6 (data) และ PC5 (clock)
+ * uint8_t frame[8];
+ * digitalWrite(LATCH_PIN, LOW);
+ * shiftOutBuffer(PC6, PC5, MSBFIRST, frame, sizeof(frame));
+ * digitalWrite(LATCH_PIN, HIGH);
+ */
+void shiftOutBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, const uint8_t* data, uint16_t len);
+
+/**
+ * @brief รับข้อมูลหลาย bytes จาก shift register chain
+ * @param dataPin pin สำหรับรับข้อมูล
+ * @param clockPin pin สำหรับ clock signal
+ * @param bitOrder ลำดับการรับ bit (LSBFIRST หรือ MSBFIRST)
+ * @param data buffer สำหรับเก็บข้อมูล
+ * @param len จำนวน bytes
+ * 
+ * @example
+ * uint8_t inputs[4];
+ * shiftInBuffer(PC7, PC5, MSBFIRST, inputs, sizeof(inputs));
+ */
+void shiftInBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t* data, uint16_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,26 +1,95 @@
 /**
  * @file SimpleHAL.c
  * @brief SimpleHAL Initialization Implementation
- * @version 1.0
- * @date 2025-12-21
+ * @version 1.2
+ * @date 2026-10-14
  * 
  * @details
  * Optional initialization function for SimpleHAL
- * Auto-initialization is already enabled, so this is optional
+ * Every subsystem initializes lazily on first use (SimpleInit), so this is optional
+ * Stack high-water mark and static RAM diagnostics
  */
 
 #include "SimpleHAL.h"
 
+/* ========== Stack & RAM Diagnostics ========== */
+
+#define STACK_PAINT_VALUE  0xA5A5A5A5UL
+
+// Linker symbols (Link.ld)
+extern uint32_t SIMPLE_HAL_STACK_LIMIT[];
+extern uint32_t _eusrstack[];
+extern uint32_t _data_vma[];
+extern uint32_t _edata[];
+extern uint32_t _sbss[];
+extern uint32_t _ebss[];
+
+/*
+ * RAM ที่แต่ละ module ประกาศไว้ (const ใน .c ของ module)
+ * weak: module ที่ไม่ได้ link มีที่อยู่เป็น NULL
+ */
+extern const uint16_t adc_ram_bytes __attribute__((weak));
+extern const uint16_t brownout_ram_bytes __attribute__((weak));
+extern const uint16_t debounce_ram_bytes __attribute__((weak));
+extern const uint16_t dma_ram_bytes __attribute__((weak));
+extern const uint16_t ds18b20_ram_bytes __attribute__((weak));
+extern const uint16_t energy_ram_bytes __attribute__((weak));
+extern const uint16_t event_ram_bytes __attribute__((weak));
+extern const uint16_t flash_ram_bytes __attribute__((weak));
+extern const uint16_t frame_ram_bytes __attribute__((weak));
+extern const uint16_t gpio_ram_bytes __attribute__((weak));
+extern const uint16_t isrstat_ram_bytes __attribute__((weak));
+extern const uint16_t logger_ram_bytes __attribute__((weak));
+extern const uint16_t onewire_ram_bytes __attribute__((weak));
+extern const uint16_t opamp_measure_ram_bytes __attribute__((weak));
+extern const uint16_t pool_ram_bytes __attribute__((weak));
+extern const uint16_t taskwdg_ram_bytes __attribute__((weak));
+extern const uint16_t tim_ram_bytes __attribute__((weak));
+extern const uint16_t trace_ram_bytes __attribute__((weak));
+extern const uint16_t usart_ram_bytes __attribute__((weak));
+extern const uint16_t ws2812_ram_bytes __attribute__((weak));
+extern const uint16_t zerocross_ram_bytes __attribute__((weak));
+
+static const struct {
+    const char* module;
+    const uint16_t* bytes;
+} ram_modules[] = {
+    {"ADC", &adc_ram_bytes},
+    {"Brownout", &brownout_ram_bytes},
+    {"Debounce", &debounce_ram_bytes},
+    {"DMA", &dma_ram_bytes},
+    {"DS18B20", &ds18b20_ram_bytes},
+    {"Energy", &energy_ram_bytes},
+    {"Event", &event_ram_bytes},
+    {"Flash", &flash_ram_bytes},
+    {"Frame", &frame_ram_bytes},
+    {"GPIO", &gpio_ram_bytes},
+    {"ISRStat", &isrstat_ram_bytes},
+    {"Logger", &logger_ram_bytes},
+    {"1Wire", &onewire_ram_bytes},
+    {"OPAMP_Measure", &opamp_measure_ram_bytes},
+    {"Pool", &pool_ram_bytes},
+    {"TaskWDG", &taskwdg_ram_bytes},
+    {"TIM", &tim_ram_bytes},
+    {"Trace", &trace_ram_bytes},
+    {"USART", &usart_ram_bytes},
+    {"WS2812", &ws2812_ram_bytes},
+    {"ZeroCross", &zerocross_ram_bytes},
+};
+
+static Timer_TickHook_t stack_guard_hook;
+static uint8_t stack_guard_tripped = 0;
+
 /**
  * @brief Initialize SimpleHAL (Optional)
  * 
- * @note Auto-initialization is already enabled via constructor attributes
+ * @note Subsystems initialize on first use through SimpleInit_Ensure()
  *       This function is provided for explicit control if needed
  * 
  * @details
- * Currently this function does nothing because:
- * - SimpleDelay auto-initializes via constructor
- * - Other peripherals don't require global initialization
+ * Starts the SysTick timebase eagerly so millis() counts from this call
+ * instead of from the first timing function call.
+ * Other peripherals initialize lazily and are not touched here.
  * 
  * Future additions may include:
  * - Global peripheral configuration
@@ -34,6 +103,102 @@
  * }
  */
 void SimpleHAL_Init(void) {
-    // Currently empty - auto-init handles everything
-    // Reserved for future use
+#if SIMPLE_HAL_STACK_PAINT
+    SimpleHAL_StackPaint();
+#endif
+    Timer_EnsureInit();
+}
+
+/**
+ * @brief ทาสี stack ที่ยังไม่ถูกใช้
+ */
+void SimpleHAL_StackPaint(void) {
+    uint32_t sp;
+    __asm volatile ("mv %0, sp" : "=r"(sp));
+
+    // เว้น 16 bytes ใต้ sp (function นี้เป็น leaf จึงไม่มีอะไรอยู่ใต้ sp)
+    volatile uint32_t* p = SIMPLE_HAL_STACK_LIMIT;
+    volatile uint32_t* top = (volatile uint32_t*)((sp - 16) & ~3UL);
+    while (p < top) {
+        *p++ = STACK_PAINT_VALUE;
+    }
+}
+
+/**
+ * @brief Stack ที่ไม่เคยถูกใช้ตั้งแต่ทาสี
+ */
+uint16_t SimpleHAL_GetStackFree(void) {
+    const volatile uint32_t* p = SIMPLE_HAL_STACK_LIMIT;
+
+    while (p < _eusrstack && *p == STACK_PAINT_VALUE) {
+        p++;
+    }
+    return (uint16_t)((uint32_t)p - (uint32_t)SIMPLE_HAL_STACK_LIMIT);
+}
+
+/**
+ * @brief ขนาดของ stack
+ */
+uint16_t SimpleHAL_GetStackSize(void) {
+    return (uint16_t)((uint32_t)_eusrstack - (uint32_t)SIMPLE_HAL_STACK_LIMIT);
+}
+
+/**
+ * @brief ตรวจ guard words ที่ขอบล่างของ stack
+ */
+uint8_t SimpleHAL_StackCheck(void) {
+    const volatile uint32_t* p = SIMPLE_HAL_STACK_LIMIT;
+
+    for (uint8_t i = 0; i < SIMPLE_HAL_STACK_GUARD_WORDS; i++) {
+        if (p[i] != STACK_PAINT_VALUE) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Default เมื่อ guard เสีย: หยุดที่ debugger หรือค้างจน watchdog reset
+ */
+__attribute__((weak)) void SimpleHAL_StackOverflow(void) {
+    __asm volatile ("csrci mstatus, 0x8");
+    __asm volatile ("ebreak");
+    while (1) {
+    }
+}
+
+/**
+ * @brief Tick hook: ตรวจ guard (เรียกจาก SysTick ISR)
+ */
+static void stack_guard_tick(void) {
+    if (!stack_guard_tripped && !SimpleHAL_StackCheck()) {
+        stack_guard_tripped = 1;
+        SimpleHAL_StackOverflow();
+    }
+}
+
+/**
+ * @brief ตรวจ guard ใน SysTick ทุก interval_ms
+ */
+void SimpleHAL_StackGuardInit(uint16_t interval_ms) {
+    // เขียน guard ใหม่ (กรณียังไม่ได้ทาสี stack)
+    volatile uint32_t* p = SIMPLE_HAL_STACK_LIMIT;
+    for (uint8_t i = 0; i < SIMPLE_HAL_STACK_GUARD_WORDS; i++) {
+        p[i] = STACK_PAINT_VALUE;
+    }
+    stack_guard_tripped = 0;
+    Timer_AddTickHook(&stack_guard_hook, interval_ms, stack_guard_tick);
+}
+
+/**
+ * @brief รายงาน RAM ของแต่ละ module ที่ link อยู่
+ */
+uint16_t SimpleHAL_RamReport(SimpleHAL_RamCallback callback) {
+    if (callback) {
+        for (uint8_t i = 0; i < sizeof(ram_modules) / sizeof(ram_modules[0]); i++) {
+            if (ram_modules[i].bytes) {
+                callback(ram_modules[i].module, *ram_modules[i].bytes);
+            }
+        }
+    }
+    return (uint16_t)(((uint32_t)_edata - (uint32_t)_data_vma) +
+                      ((uint32_t)_ebss - (uint32_t)_sbss));
 }
@@ -20,6 +20,38 @@
  * - IWDG: Independent Watchdog (ป้องกันระบบค้าง)
  * - WWDG: Window Watchdog (ตรวจสอบ timing เข้มงวด)
  * - DMA: Direct Memory Access (ถ่ายโอนข้อมูลความเร็วสูง)
+ * - Debounce: debounce ปุ่มหลายตัวจาก timer tick เดียว
+ * - Clock: reference-counted peripheral clock gating
+ * - Init: lazy on-demand initialization (ไม่มี constructor ตอน boot)
+ * - Format: แปลงตัวเลขเป็นข้อความแบบไม่ใช้การหาร
+ * - Printf: printf ขนาดเล็กส่งตรงเข้า USART/SDI (ไม่ใช้ newlib stdio)
+ * - Trace: binary trace log จาก ISR ส่งออกทีหลัง
+ * - Frame: COBS + CRC16 packet transport ผ่าน USART DMA
+ * - SPI_Async: คิว SPI transaction ผ่าน DMA พร้อม CS อัตโนมัติ
+ * - I2C_Shadow: Register shadow cache สำหรับ I2C devices
+ * - SPI_Soft: Software SPI ความเร็วสูงบน pin ใดก็ได้
+ * - Filter: fixed-point filters สำหรับ ADC stream (moving average, EMA, biquad, median)
+ * - WS2812: NeoPixel output ผ่าน TIM PWM + DMA (ไม่ปิด interrupt)
+ * - TIM_Capture: วัดความถี่/duty ด้วย PWM-input capture (hardware จับขอบ)
+ * - TIM_Encoder: quadrature encoder นับด้วย hardware ขยายเป็น 32 bits
+ * - TIM_Timestamp: counter 32-bit จาก TIM1 + TIM2 cascade (ไม่มี interrupt)
+ * - Event: lock-free event queue ส่ง callback จาก ISR ไปทำใน main loop
+ * - TaskWDG: software task watchdog feed IWDG/WWDG เมื่อทุก task check-in ทัน
+ * - Pool: fixed-block memory pool (O(1), ใช้จาก ISR ได้) แทน heap
+ * - KV: key-value store แบบ log บน flash (wear leveling, ไม่ erase ทุกครั้งที่บันทึก)
+ * - CRC: CRC8/Maxim, CRC16-CCITT/Modbus, CRC32 แบบ nibble หรือ byte table (streaming)
+ * - Logger: append-only ring logger บน flash (sensor samples แบบ offline)
+ * - Energy: นับเวลาใน run/sleep/standby และต่อ peripheral แล้วประมาณ µAh
+ * - Brownout: บันทึก RAM snapshot ลง flash จาก PVD interrupt และคืนค่าตอน boot
+ * - DS18B20: สั่ง Convert T ทุก 1-Wire bus พร้อมกันแล้วทยอยอ่าน scratchpad (CRC)
+ * - 1Wire_Cache: บันทึก ROM list ของ 1-Wire bus ใน KV ตรวจตอน boot แทน search ใหม่
+ * - OPAMP_Measure: เลือก gain path ของ OPAMP อัตโนมัติบน ADC scan (DMA) ผลเป็นหน่วยเดียว
+ * - ZeroCross: comparator + TIM2 capture จับจุดตัดศูนย์เป็น µs, ติดตามคาบ/มุม, ยิง triac
+ * - ISRStat: latency / exec / load ของ interrupt handlers ทุกตัว + trace pin (SIMPLE_ISR_STATS)
+ * - SysClock: เปลี่ยน HCLK 3-48 MHz ขณะทำงาน, SysTick/USART/I2C/SPI/PWM/TIM ปรับ timing เอง
+ *
+ * Module ที่ include และ feature ที่ compile เลือกได้ใน SimpleHAL_Config.h
+ * (SIMPLE_HAL_USE_<MODULE>, SIMPLE_HAL_FLOAT, SIMPLE_HAL_ARG_CHECK, ...)
  * 
  * **คุณสมบัติหลัก:**
  * - API แบบ Arduino-style
@@ -62,22 +94,114 @@ extern "C" {
 /* ========== Include All SimpleHAL Libraries ========== */
 
 #include <ch32v00x.h>
+#include "SimpleHAL_Config.h"
 #include "SimpleUSART.h" // IWYU pragma: keep
 #include "SimpleI2C.h" // IWYU pragma: keep
 #include "SimpleSPI.h" // IWYU pragma: keep
 #include "SimpleADC.h" // IWYU pragma: keep
 #include "SimpleGPIO.h" // IWYU pragma: keep
 #include "SimpleTIM.h" // IWYU pragma: keep
+#if SIMPLE_HAL_USE_TIM_EXT
 #include "SimpleTIM_Ext.h" // IWYU pragma: keep
+#endif
 #include "SimplePWM.h" // IWYU pragma: keep
+#if SIMPLE_HAL_USE_OPAMP
 #include "SimpleOPAMP.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_FLASH
 #include "SimpleFlash.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_IWDG
 #include "SimpleIWDG.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_WWDG
 #include "SimpleWWDG.h" // IWYU pragma: keep
+#endif
 #include "SimpleDelay.h" // IWYU pragma: keep
+#if SIMPLE_HAL_USE_1WIRE
 #include "Simple1Wire.h" // IWYU pragma: keep
+#endif
 #include "SimpleDMA.h" // IWYU pragma: keep
 #include "SimplePWR.h" // IWYU pragma: keep
+#if SIMPLE_HAL_USE_DEBOUNCE
+#include "SimpleDebounce.h" // IWYU pragma: keep
+#endif
+#include "SimpleClock.h" // IWYU pragma: keep
+#include "SimpleInit.h" // IWYU pragma: keep
+#include "SimpleFormat.h" // IWYU pragma: keep
+#include "SimplePrintf.h" // IWYU pragma: keep
+#if SIMPLE_HAL_USE_TRACE
+#include "SimpleTrace.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_FRAME
+#include "SimpleFrame.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_SPI_ASYNC
+#include "SimpleSPI_Async.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_I2C_SHADOW
+#include "SimpleI2C_Shadow.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_SPI_SOFT
+#include "SimpleSPI_Soft.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_FILTER
+#include "SimpleFilter.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_WS2812
+#include "SimpleWS2812.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_TIM_CAPTURE
+#include "SimpleTIM_Capture.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_TIM_ENCODER
+#include "SimpleTIM_Encoder.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_TIM_TIMESTAMP
+#include "SimpleTIM_Timestamp.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_EVENT
+#include "SimpleEvent.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_TASKWDG
+#include "SimpleTaskWDG.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_POOL
+#include "SimplePool.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_KV
+#include "SimpleKV.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_CRC
+#include "SimpleCRC.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_LOGGER
+#include "SimpleLogger.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_ENERGY
+#include "SimpleEnergy.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_BROWNOUT
+#include "SimpleBrownout.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_DS18B20
+#include "SimpleDS18B20.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_1WIRE_CACHE
+#include "Simple1Wire_Cache.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_OPAMP_MEASURE
+#include "SimpleOPAMP_Measure.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_ZEROCROSS
+#include "SimpleZeroCross.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_ISRSTAT
+#include "SimpleISRStat.h" // IWYU pragma: keep
+#endif
+#if SIMPLE_HAL_USE_SYSCLOCK
+#include "SimpleSysClock.h" // IWYU pragma: keep
+#endif
 
 /* ========== Version Information ========== */
 
@@ -91,12 +215,13 @@ extern "C" {
 /**
  * @brief Initialize SimpleHAL (Optional)
  * 
- * @note Auto-initialization is already enabled
+ * @note Subsystems initialize lazily on first use (SimpleInit)
  *       Call this only if you need explicit control
  * 
  * @details
- * This function is optional because SimpleHAL components
- * auto-initialize themselves (e.g., SimpleDelay uses constructor)
+ * This function is optional. It starts the SysTick timebase early
+ * so millis() counts from this call and paints the stack for
+ * SimpleHAL_GetStackFree() (SIMPLE_HAL_STACK_PAINT); nothing runs before main()
  * 
  * @example
  * int main(void) {
@@ -106,6 +231,92 @@ extern "C" {
  */
 void SimpleHAL_Init(void);
 
+/* ========== Stack & RAM Diagnostics ========== */
+
+/**
+ * @brief SimpleHAL_Init() ทาสี stack ให้ (0 = เรียก SimpleHAL_StackPaint() เอง)
+ */
+#ifndef SIMPLE_HAL_STACK_PAINT
+#define SIMPLE_HAL_STACK_PAINT 1
+#endif
+
+/**
+ * @brief Symbol ของ linker ที่เป็นขอบล่างของ stack
+ *
+ * @details Default = ช่วงที่ Link.ld จองไว้ (__stack_size) ไม่ทับ heap หรือ .noinit
+ * stack ที่ลึกกว่านี้ถือว่าเกินงบ (ต่อจากนี้คือ heap แล้วจึง .bss)
+ * ถ้าไม่ใช้ malloc และ .noinit ตั้งเป็น _end เพื่อวัดทั้ง RAM ที่ว่าง
+ */
+#ifndef SIMPLE_HAL_STACK_LIMIT
+#define SIMPLE_HAL_STACK_LIMIT _susrstack
+#endif
+
+/**
+ * @brief จำนวน words ที่ขอบล่างของ stack ที่ guard ตรวจ
+ */
+#ifndef SIMPLE_HAL_STACK_GUARD_WORDS
+#define SIMPLE_HAL_STACK_GUARD_WORDS 4
+#endif
+
+/**
+ * @brief Callback ของ SimpleHAL_RamReport()
+ * @param module ชื่อ module
+ * @param bytes RAM ของ buffers และ callback tables ของ module (ไม่รวมตัวแปรเดี่ยว)
+ */
+typedef void (*SimpleHAL_RamCallback)(const char* module, uint16_t bytes);
+
+/**
+ * @brief ทาสี stack ที่ยังไม่ถูกใช้ (ตั้งแต่ขอบล่างถึงใต้ stack frame ปัจจุบัน)
+ * @note เรียกต้น main() (SimpleHAL_Init() เรียกให้) ทาซ้ำได้เพื่อเริ่มวัดรอบใหม่
+ */
+void SimpleHAL_StackPaint(void);
+
+/**
+ * @brief Stack ที่ไม่เคยถูกใช้ตั้งแต่ทาสี (high-water mark)
+ * @return bytes ที่เหลือ, 0 = stack ลึกถึงขอบล่างแล้ว
+ *
+ * @example
+ * printf("stack free %u / %u\r\n", SimpleHAL_GetStackFree(), SimpleHAL_GetStackSize());
+ */
+uint16_t SimpleHAL_GetStackFree(void);
+
+/**
+ * @brief ขนาดของ stack (ขอบล่างถึง _eusrstack)
+ */
+uint16_t SimpleHAL_GetStackSize(void);
+
+/**
+ * @brief ตรวจ guard words ที่ขอบล่างของ stack
+ * @return 1 = ปกติ, 0 = stack ลึกถึง guard แล้ว
+ */
+uint8_t SimpleHAL_StackCheck(void);
+
+/**
+ * @brief ตรวจ guard ใน SysTick ทุก interval_ms (tick hook ของ SimpleDelay)
+ * @note ครั้งแรกที่ guard เสียจะเรียก SimpleHAL_StackOverflow() จาก SysTick ISR
+ *       ก่อนที่ stack จะทับ heap/.bss
+ */
+void SimpleHAL_StackGuardInit(uint16_t interval_ms);
+
+/**
+ * @brief เรียกเมื่อ guard เสีย (weak: default ปิด interrupt, ebreak แล้วค้าง)
+ * @note เขียนทับได้ เช่น บันทึกลง flash แล้ว NVIC_SystemReset()
+ */
+void SimpleHAL_StackOverflow(void);
+
+/**
+ * @brief รายงาน RAM ของแต่ละ module ที่ link อยู่
+ * @param callback เรียกครั้งละ module (NULL = คืนแค่ผลรวม)
+ * @return ขนาด .data + .bss ทั้งโปรแกรม (bytes)
+ *
+ * @example
+ * static void show(const char* module, uint16_t bytes) {
+ *     printf("%-10s %5u\r\n", module, bytes);
+ * }
+ * printf("static RAM %u\r\n", SimpleHAL_RamReport(show));
+ */
+uint16_t SimpleHAL_RamReport(SimpleHAL_RamCallback callback);
+
 /* ========== Helper Macros ========== */
 
 /**
@@ -0,0 +1,270 @@
+/**
+ * @file SimpleHAL_Config.h
+ * @brief Compile-time configuration ของ SimpleHAL: ตัด feature ที่ firmware ไม่ใช้ออก
+ * @version 1.0
+ * @date 2026-10-15
+ *
+ * @details
+ * ทุก header ของ SimpleHAL include ไฟล์นี้ก่อน configuration ของตัวเอง
+ * ค่าที่ตั้งจึงมีผลเหมือนกันทั้ง library และ application
+ *
+ * **ตั้งค่าโดยไม่แก้ library:**
+ * - สร้าง SimpleHAL_UserConfig.h ใน include path ของ project (ถูก include อัตโนมัติ)
+ * - หรือ -DSIMPLE_HAL_USER_CONFIG="\"my_config.h\"" เพื่อเลือกไฟล์เอง
+ * - หรือ -D ทีละ macro เหมือนเดิม
+ *
+ * **ทำไมต้องมี switch:**
+ * Linker (--gc-sections) ตัดฟังก์ชันที่ไม่ถูกเรียกออกอยู่แล้ว แต่ interrupt handlers
+ * อยู่ใน vector table จึงถูก link เสมอ พร้อม callback tables, buffers และโค้ดทุกอย่าง
+ * ที่ handler อ้างถึง switch ในไฟล์นี้ตัดรากเหล่านั้นและ runtime checks ที่ไม่จำเป็น
+ *
+ * @example
+ * // SimpleHAL_UserConfig.h ของ project ที่ใช้แค่ USART TX DMA (CH4) และ ADC
+ * #define SIMPLE_HAL_FLOAT         0      // ไม่ link soft-float
+ * #define SIMPLE_HAL_ARG_CHECK     0      // pin/channel ถูกต้องแน่นอน
+ * #define SIMPLE_DMA_CHANNEL_MASK  0x08   // handler เฉพาะ CH4
+ * #define SIMPLE_DMA_CHAIN         0
+ * #define SIMPLE_GPIO_EXTI         0      // ไม่ใช้ attachInterrupt()
+ * #define SIMPLE_USART_RX_BUFFER_SIZE 16
+ *
+ * @note ค่าขนาด buffer ของแต่ละ module (SIMPLE_USART_RX_BUFFER_SIZE, SIMPLE_EVENT_QUEUE_SIZE,
+ *       SIMPLE_GPIO_CAPTURE_SIZE, SIMPLE_KV_MAX_KEYS, ...) อยู่ใน header ของ module นั้น
+ *       และ override จาก SimpleHAL_UserConfig.h ได้เช่นกัน
+ */
+
+#ifndef __SIMPLE_HAL_CONFIG_H
+#define __SIMPLE_HAL_CONFIG_H
+
+/* ========== User Configuration ========== */
+
+#if defined(SIMPLE_HAL_USER_CONFIG)
+#include SIMPLE_HAL_USER_CONFIG
+#elif defined(__has_include)
+#if __has_include("SimpleHAL_UserConfig.h")
+#include "SimpleHAL_UserConfig.h"
+#endif
+#endif
+
+/* ========== Features ========== */
+
+/**
+ * @brief ฟังก์ชันที่รับ/คืน float (ADC_ToVoltage(), OPAMP_CalculateGain...(), ...)
+ * @note 0 = ไม่ link soft-float ของ RV32EC (หลาย KB) เหลือเฉพาะ API แบบ integer
+ * @note ตั้งแยกต่อ module ได้ด้วย SIMPLE_ADC_FLOAT / SIMPLE_OPAMP_FLOAT
+ */
+#ifndef SIMPLE_HAL_FLOAT
+#define SIMPLE_HAL_FLOAT 1
+#endif
+
+/**
+ * @brief ตรวจ argument ตอน runtime (pin ที่ไม่รองรับ, channel นอกช่วง)
+ * @note 0 = ข้ามการตรวจ: argument ผิดเป็น undefined behavior
+ * @note Pin ที่เป็นค่าคงที่ยังถูกตรวจตอน compile (analogRead()/analogWrite())
+ */
+#ifndef SIMPLE_HAL_ARG_CHECK
+#define SIMPLE_HAL_ARG_CHECK 1
+#endif
+
+/**
+ * @brief return เมื่อ cond เป็นเท็จ (ค่า return ตามหลัง ถ้ามี) หายไปเมื่อ SIMPLE_HAL_ARG_CHECK = 0
+ *
+ * @example
+ * SIMPLE_CHECK(pwm_ch != 0xFF);      // void function
+ * SIMPLE_CHECK(adc_ch != 0xFF, 0);   // คืน 0
+ */
+#if SIMPLE_HAL_ARG_CHECK
+#define SIMPLE_CHECK(cond, ...)  do { if (!(cond)) return __VA_ARGS__; } while (0)
+#else
+#define SIMPLE_CHECK(cond, ...)  do {} while (0)
+#endif
+
+/* ========== Interrupt Handlers / Callback Slots ========== */
+
+/**
+ * @brief DMA channels ที่มี interrupt handler (bit 0 = CH1 ... bit 6 = CH7)
+ * @note Channel นอก mask ยังถ่ายโอนได้ (poll ด้วย DMA_WaitComplete(), DMA_WaitAllSleep()
+ *       จะ poll แทนการหลับ) แต่ไม่มี callback
+ * @note ค่าที่ module ใช้: ADC = CH1, SPI = CH2/3, USART = CH4/5, I2C = CH6/7
+ */
+#ifndef SIMPLE_DMA_CHANNEL_MASK
+#define SIMPLE_DMA_CHANNEL_MASK 0x7F
+#endif
+
+/**
+ * @brief Scatter-gather (DMA_ChainStart()) ใน DMA TC handlers
+ * @note 0 = ตัด chain tables และขั้นตอน chain ออกจากทุก handler
+ */
+#ifndef SIMPLE_DMA_CHAIN
+#define SIMPLE_DMA_CHAIN 1
+#endif
+
+/**
+ * @brief EXTI (attachInterrupt(), attachEdgeCapture()) และ EXTI7_0_IRQHandler
+ * @note 0 = ตัด callback tables 8 lines และ edge capture buffer
+ */
+#ifndef SIMPLE_GPIO_EXTI
+#define SIMPLE_GPIO_EXTI 1
+#endif
+
+/**
+ * @brief I2C async engine (I2C_ReadRegAsync(), I2C_SubmitBatch(), ...) และ I2C1_EV/ER_IRQHandler
+ * @note 0 = เหลือเฉพาะ API แบบ blocking ตัด state machine และ handlers ทั้งสอง
+ */
+#ifndef SIMPLE_I2C_ASYNC
+#define SIMPLE_I2C_ASYNC 1
+#endif
+
+/**
+ * @brief Callback ของ ADC_SetWatchdog() และ ADC1_IRQHandler
+ * @note 0 = ไม่มี handler: watchdog ใช้แบบ polling ด้วย ADC_WatchdogTriggered() เท่านั้น
+ */
+#ifndef SIMPLE_ADC_WATCHDOG_IRQ
+#define SIMPLE_ADC_WATCHDOG_IRQ 1
+#endif
+
+/**
+ * @brief รับ frame แบบ idle-line (USART_BeginFrameRx(), SimpleFrame)
+ * @note USART1_IRQHandler ถูก link เมื่อ switch นี้หรือ SIMPLE_USART_RX_INTERRUPT เป็น 1
+ *       ตั้งทั้งคู่เป็น 0 เพื่อตัด handler และ receive ring buffer ออก
+ */
+#ifndef SIMPLE_USART_FRAME_RX
+#define SIMPLE_USART_FRAME_RX 1
+#endif
+
+/**
+ * @brief Modules ลงทะเบียน hook กับ SimpleSysClock และปรับ timing เองเมื่อ
+ *        SimpleHAL_SetSysClock() เปลี่ยน clock (USART, I2C, SPI, PWM, TIM, soft I2C/SPI)
+ * @note 0 = ไม่มี hook: SysTick ยังถูกปรับ แต่ module อื่นต้อง init ใหม่เอง
+ */
+#ifndef SIMPLE_SYSCLOCK_RETIME
+#define SIMPLE_SYSCLOCK_RETIME 1
+#endif
+
+/* ========== Bus Counts ========== */
+
+/**
+ * @brief จำนวน 1-Wire buses สูงสุด (OneWire_Init() แต่ละครั้งใช้ 1 slot)
+ */
+#ifndef SIMPLE_1WIRE_MAX_BUSES
+#define SIMPLE_1WIRE_MAX_BUSES 4
+#endif
+
+/* ========== Modules ========== */
+
+/**
+ * @brief Modules ที่ SimpleHAL.h รวมเข้ามา (1 = include)
+ *
+ * @details Module ที่ไม่ถูก include เรียกไม่ได้ (compile error แทนการ link โดยไม่ตั้งใจ)
+ * Modules พื้นฐาน (GPIO, Delay, TIM, PWM, ADC, USART, I2C, SPI, DMA, Clock, Init,
+ * PWR, Format, Printf) include เสมอ
+ *
+ * @note --gc-sections ตัดเฉพาะฟังก์ชันที่ไม่ถูกอ้างถึง interrupt handler ถูก link เสมอ
+ *       Module ที่มี handler จึงถูก compile ตาม switch ของตัวเอง (SimpleBrownout.c ใช้
+ *       SIMPLE_HAL_USE_BROWNOUT) ส่วน handlers ของ modules พื้นฐานใช้ switch ในหมวด
+ *       Interrupt Handlers ด้านบน
+ */
+#ifndef SIMPLE_HAL_USE_TIM_EXT
+#define SIMPLE_HAL_USE_TIM_EXT 1
+#endif
+#ifndef SIMPLE_HAL_USE_OPAMP
+#define SIMPLE_HAL_USE_OPAMP 1
+#endif
+#ifndef SIMPLE_HAL_USE_FLASH
+#define SIMPLE_HAL_USE_FLASH 1
+#endif
+#ifndef SIMPLE_HAL_USE_IWDG
+#define SIMPLE_HAL_USE_IWDG 1
+#endif
+#ifndef SIMPLE_HAL_USE_WWDG
+#define SIMPLE_HAL_USE_WWDG 1
+#endif
+#ifndef SIMPLE_HAL_USE_1WIRE
+#define SIMPLE_HAL_USE_1WIRE 1
+#endif
+#ifndef SIMPLE_HAL_USE_DEBOUNCE
+#define SIMPLE_HAL_USE_DEBOUNCE 1
+#endif
+#ifndef SIMPLE_HAL_USE_TRACE
+#define SIMPLE_HAL_USE_TRACE 1
+#endif
+#ifndef SIMPLE_HAL_USE_FRAME
+#define SIMPLE_HAL_USE_FRAME 1
+#endif
+#ifndef SIMPLE_HAL_USE_SPI_ASYNC
+#define SIMPLE_HAL_USE_SPI_ASYNC 1
+#endif
+#ifndef SIMPLE_HAL_USE_I2C_SHADOW
+#define SIMPLE_HAL_USE_I2C_SHADOW 1
+#endif
+#ifndef SIMPLE_HAL_USE_SPI_SOFT
+#define SIMPLE_HAL_USE_SPI_SOFT 1
+#endif
+#ifndef SIMPLE_HAL_USE_FILTER
+#define SIMPLE_HAL_USE_FILTER 1
+#endif
+#ifndef SIMPLE_HAL_USE_WS2812
+#define SIMPLE_HAL_USE_WS2812 1
+#endif
+#ifndef SIMPLE_HAL_USE_TIM_CAPTURE
+#define SIMPLE_HAL_USE_TIM_CAPTURE 1
+#endif
+#ifndef SIMPLE_HAL_USE_TIM_ENCODER
+#define SIMPLE_HAL_USE_TIM_ENCODER 1
+#endif
+#ifndef SIMPLE_HAL_USE_TIM_TIMESTAMP
+#define SIMPLE_HAL_USE_TIM_TIMESTAMP 1
+#endif
+#ifndef SIMPLE_HAL_USE_EVENT
+#define SIMPLE_HAL_USE_EVENT 1
+#endif
+#ifndef SIMPLE_HAL_USE_TASKWDG
+#define SIMPLE_HAL_USE_TASKWDG 1
+#endif
+#ifndef SIMPLE_HAL_USE_POOL
+#define SIMPLE_HAL_USE_POOL 1
+#endif
+#ifndef SIMPLE_HAL_USE_KV
+#define SIMPLE_HAL_USE_KV 1
+#endif
+#ifndef SIMPLE_HAL_USE_CRC
+#define SIMPLE_HAL_USE_CRC 1
+#endif
+#ifndef SIMPLE_HAL_USE_LOGGER
+#define SIMPLE_HAL_USE_LOGGER 1
+#endif
+#ifndef SIMPLE_HAL_USE_ENERGY
+#define SIMPLE_HAL_USE_ENERGY 1
+#endif
+#ifndef SIMPLE_HAL_USE_BROWNOUT
+#define SIMPLE_HAL_USE_BROWNOUT 1
+#endif
+#ifndef SIMPLE_HAL_USE_DS18B20
+#define SIMPLE_HAL_USE_DS18B20 1
+#endif
+#ifndef SIMPLE_HAL_USE_1WIRE_CACHE
+#define SIMPLE_HAL_USE_1WIRE_CACHE 1
+#endif
+#ifndef SIMPLE_HAL_USE_OPAMP_MEASURE
+#define SIMPLE_HAL_USE_OPAMP_MEASURE 1
+#endif
+#ifndef SIMPLE_HAL_USE_ZEROCROSS
+#define SIMPLE_HAL_USE_ZEROCROSS 1
+#endif
+#ifndef SIMPLE_HAL_USE_ISRSTAT
+#define SIMPLE_HAL_USE_ISRSTAT 1
+#endif
+#ifndef SIMPLE_HAL_USE_SYSCLOCK
+#define SIMPLE_HAL_USE_SYSCLOCK 1
+#endif
+
+/* ========== Consistency Checks ========== */
+
+#if (SIMPLE_DMA_CHANNEL_MASK & ~0x7F) != 0
+#error "SIMPLE_DMA_CHANNEL_MASK: CH32V003 มี DMA channel 1-7 (bits 0-6)"
+#endif
+
+#if SIMPLE_1WIRE_MAX_BUSES < 1
+#error "SIMPLE_1WIRE_MAX_BUSES must be at least 1"
+#endif
+
+#endif  // __SIMPLE_HAL_CONFIG_H
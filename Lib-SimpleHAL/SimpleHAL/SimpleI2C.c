@@ -1,30 +1,383 @@
 /**
  * @file SimpleI2C.c
  * @brief Simple I2C Library Implementation
- * @version 1.0
- * @date 2025-12-12
+ * @version 1.5
+ * @date 2026-10-14
  */
 
 #include "SimpleI2C.h"
 #include "SimpleDelay.h"
+#include "SimpleClock.h"
+#include "SimpleDMA.h"
+#include "SimpleISRStat.h"
+#if SIMPLE_SYSCLOCK_RETIME
+#include "SimpleSysClock.h"
+#endif
+
+/* ========== Private Definitions ========== */
+
+#define I2C_ASYNC_IT_BITS  (I2C_CTLR2_ITEVTEN | I2C_CTLR2_ITBUFEN | I2C_CTLR2_ITERREN)
+#define I2C_ERROR_FLAGS    (I2C_STAR1_BERR | I2C_STAR1_ARLO | I2C_STAR1_AF | I2C_STAR1_OVR)
+#define I2C_DMA_BITS       (I2C_CTLR2_DMAEN | I2C_CTLR2_LAST)
+
+/**
+ * @brief ใช้ DMA เมื่อยาวถึง threshold (read ต้องมีอย่างน้อย 2 bytes สำหรับ LAST/NACK)
+ */
+#define I2C_WANT_DMA(len, read) (SIMPLE_I2C_DMA_THRESHOLD && (len) >= SIMPLE_I2C_DMA_THRESHOLD && (!(read) || (len) >= 2))
+// DMA ใช้ได้เมื่อจอง CH6/CH7 สำเร็จแล้ว (I2C_DmaEnsureInit())
+#define I2C_USE_DMA(len, read)  (I2C_WANT_DMA(len, read) && i2c_dma_ready)
+
+/**
+ * @brief ขั้นตอนของ async transaction
+ */
+typedef enum {
+    I2C_PHASE_IDLE = 0,
+    I2C_PHASE_WRITE,     // ส่ง address(W), register และข้อมูล (write)
+    I2C_PHASE_READ       // หลัง repeated START: address(R) และรับข้อมูล
+} I2C_AsyncPhase;
+
+/* ========== Private Variables ========== */
+
+static uint16_t i2c_clocks = 0;  // Clock ที่ SimpleI2C ถืออยู่
+static uint8_t i2c_dma_ready = 0;
+static uint32_t i2c_speed = I2C_100KHZ;  // ความเร็วที่ init (ใช้ตั้ง timing ใหม่เมื่อ clock เปลี่ยน)
+
+// Async transaction (1 รายการต่อครั้ง)
+static volatile uint8_t i2c_async_phase = I2C_PHASE_IDLE;  // IDLE เสมอเมื่อ SIMPLE_I2C_ASYNC = 0
+#if SIMPLE_I2C_ASYNC
+static volatile I2C_Status i2c_async_status = I2C_OK;
+static uint8_t i2c_async_addr;
+static uint8_t i2c_async_reg;
+static uint8_t i2c_async_read;        // 1 = read หลังส่ง register
+static uint8_t i2c_async_dma;         // 1 = ข้อมูลส่ง/รับผ่าน DMA
+static uint8_t* i2c_async_data;
+static uint16_t i2c_async_len;
+static uint16_t i2c_async_index;
+static uint8_t i2c_async_restart;     // 1 = ขอ repeated START ให้ op ถัดไปแล้ว
+static uint8_t i2c_async_wait_sb;     // 1 = รอ SB (ข้าม event ค้างของ op ก่อนหน้า)
+static uint32_t i2c_async_start_ms;
+static I2C_AsyncCallback i2c_async_callback = NULL;
+static void* i2c_async_context = NULL;
+
+// Batch ที่กำลังทำงาน (op เดี่ยวใช้ i2c_single_op)
+static I2C_Op* i2c_batch_op;
+static uint8_t i2c_batch_left;        // จำนวน op ที่เหลือหลัง op ปัจจุบัน
+static I2C_Status i2c_batch_status;   // error แรกของ batch
+static I2C_Op i2c_single_op;
+#endif  // SIMPLE_I2C_ASYNC
 
 /* ========== Private Helper Functions ========== */
 
 /**
- * @brief รอ event flag พร้อม timeout
+ * @brief รอ event flag พร้อม timeout (นับจาก millis ไม่ขึ้นกับเวลาต่อรอบ)
  */
 static I2C_Status I2C_WaitEvent(uint32_t event, uint32_t timeout_ms) {
-    uint32_t timeout = timeout_ms * 1000;  // แปลงเป็น microseconds
+    uint32_t start = Get_CurrentMs();
     
     while(!I2C_CheckEvent(I2C1, event)) {
-        if(timeout-- == 0) {
+        if((Get_CurrentMs() - start) >= timeout_ms) {
             return I2C_ERROR_TIMEOUT;
         }
-        Delay_Us(1);
     }
     return I2C_OK;
 }
 
+/**
+ * @brief ส่ง START สำหรับ blocking API (ปฏิเสธถ้า async transaction ใช้ bus อยู่)
+ */
+static I2C_Status I2C_SendStart(void) {
+    if(i2c_async_phase != I2C_PHASE_IDLE) {
+        return I2C_ERROR_BUS_BUSY;
+    }
+    
+    I2C_GenerateSTART(I2C1, ENABLE);
+    return I2C_WaitEvent(I2C_EVENT_MASTER_MODE_SELECT, I2C_TIMEOUT_MS);
+}
+
+/**
+ * @brief จองและตั้งค่า DMA channel ของ I2C1 ครั้งแรกที่ใช้ (TX = CH6, RX = CH7)
+ * @return 1 = ใช้ DMA ได้, 0 = channel ถูก module อื่นจองอยู่ (ใช้ polling/interrupt แทน)
+ */
+#if SIMPLE_I2C_ASYNC
+static void I2C_DmaRxComplete(DMA_Channel channel);
+#endif
+
+static uint8_t I2C_DmaEnsureInit(void) {
+    if(i2c_dma_ready) return 1;
+    
+    if(DMA_AllocChannel(DMA_REQ_I2C1_TX) == DMA_CH_NONE) return 0;
+    if(DMA_AllocChannel(DMA_REQ_I2C1_RX) == DMA_CH_NONE) {
+        DMA_FreeChannel(SIMPLE_I2C_TX_DMA_CHANNEL);
+        return 0;
+    }
+    
+    DMA_Config_t config = {
+        .channel = SIMPLE_I2C_TX_DMA_CHANNEL,
+        .direction = DMA_DIR_MEM_TO_PERIPH,
+        .priority = DMA_PRIORITY_HIGH,
+        .data_size = DMA_SIZE_BYTE,
+        .mode = DMA_MODE_NORMAL,
+        .mem_increment = 1,
+        .periph_increment = 0,
+        .periph_addr = (uint32_t)&I2C1->DATAR,
+        .mem_addr = 0,  // ตั้งต่อ transfer
+        .buffer_size = 0
+    };
+    DMA_SimpleInit(&config);
+    
+    config.channel = SIMPLE_I2C_RX_DMA_CHANNEL;
+    config.direction = DMA_DIR_PERIPH_TO_MEM;
+    DMA_SimpleInit(&config);
+#if SIMPLE_I2C_ASYNC
+    DMA_SetTransferCompleteCallback(SIMPLE_I2C_RX_DMA_CHANNEL, I2C_DmaRxComplete);
+#endif
+    
+    i2c_dma_ready = 1;
+    return 1;
+}
+
+/**
+ * @brief ตั้ง buffer ของ DMA channel แล้วเริ่ม (I2C ยังไม่ขอ DMA จนกว่า DMAEN จะถูกตั้ง)
+ */
+static void I2C_DmaArm(DMA_Channel channel, const uint8_t* buffer, uint16_t len) {
+    DMA_Channel_TypeDef* ch = DMA_GetChannelBase(channel);
+    
+    DMA_Cmd(ch, DISABLE);
+    ch->MADDR = (uint32_t)buffer;
+    ch->CNTR = len;
+    DMA_Start(channel);
+}
+
+/**
+ * @brief รอ DMA ของ blocking transfer (timeout ตามความยาว, NACK จบทันที)
+ */
+static I2C_Status I2C_DmaWait(DMA_Channel channel, uint16_t len) {
+    uint32_t timeout_ms = I2C_TIMEOUT_MS + (len >> 3);  // ~125 us ต่อ byte ครอบคลุม 100 kHz
+    uint32_t start = Get_CurrentMs();
+    I2C_Status status = I2C_OK;
+    
+    while(DMA_GetStatus(channel) != DMA_STATUS_COMPLETE) {
+        if(I2C1->STAR1 & I2C_STAR1_AF) {
+            I2C1->STAR1 = (uint16_t)~I2C_STAR1_AF;
+            status = I2C_ERROR_NACK;
+            break;
+        }
+        if((Get_CurrentMs() - start) >= timeout_ms) {
+            status = I2C_ERROR_TIMEOUT;
+            break;
+        }
+    }
+    
+    I2C1->CTLR2 &= (uint16_t)~I2C_DMA_BITS;
+    if(status != I2C_OK) {
+        DMA_Stop(channel);
+        I2C_GenerateSTOP(I2C1, ENABLE);
+    }
+    return status;
+}
+
+/**
+ * @brief ส่งข้อมูลหลัง address/register (DMA เมื่อยาวถึง threshold)
+ */
+static I2C_Status I2C_SendBytes(const uint8_t* data, uint16_t len) {
+    I2C_Status status;
+    
+    if(I2C_WANT_DMA(len, 0) && I2C_DmaEnsureInit()) {
+        I2C_DmaArm(SIMPLE_I2C_TX_DMA_CHANNEL, data, len);
+        I2C1->CTLR2 |= I2C_CTLR2_DMAEN;
+        
+        status = I2C_DmaWait(SIMPLE_I2C_TX_DMA_CHANNEL, len);
+        if(status != I2C_OK) return status;
+        
+        // DMA เขียน byte สุดท้ายลง DATAR แล้ว: รอจนออกจาก shift register
+        return I2C_WaitEvent(I2C_EVENT_MASTER_BYTE_TRANSMITTED, I2C_TIMEOUT_MS);
+    }
+    
+    for(uint16_t i = 0; i < len; i++) {
+        I2C_SendData(I2C1, data[i]);
+        status = I2C_WaitEvent(I2C_EVENT_MASTER_BYTE_TRANSMITTED, I2C_TIMEOUT_MS);
+        if(status != I2C_OK) return status;
+    }
+    return I2C_OK;
+}
+
+#if SIMPLE_I2C_ASYNC
+/**
+ * @brief ปิด IRQ และจำสถานะเดิม
+ */
+static inline uint32_t I2C_Lock(void) {
+    uint32_t mstatus;
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+    return mstatus;
+}
+
+static inline void I2C_Unlock(uint32_t mstatus) {
+    if (mstatus & 0x8) {
+        __asm volatile ("csrsi mstatus, 0x8");
+    }
+}
+
+/**
+ * @brief โหลด op ลง state ของ engine (ยังไม่แตะ bus)
+ */
+static void I2C_AsyncLoad(I2C_Op* op) {
+    i2c_async_addr = op->addr;
+    i2c_async_reg = op->reg;
+    i2c_async_read = (op->direction == I2C_OP_READ) ? 1 : 0;
+    i2c_async_data = op->data;
+    i2c_async_len = op->data ? op->len : 0;
+    i2c_async_dma = I2C_USE_DMA(i2c_async_len, i2c_async_read) ? 1 : 0;
+    i2c_async_index = 0;
+    i2c_async_restart = 0;
+    i2c_async_wait_sb = 1;
+    i2c_async_start_ms = Get_CurrentMs();
+    i2c_async_phase = I2C_PHASE_WRITE;
+    op->status = I2C_ERROR_BUS_BUSY;
+}
+
+/**
+ * @brief จบ op บน bus: repeated START ถ้ามี op ถัดไปใน batch ไม่งั้น STOP
+ */
+static void I2C_AsyncEndCondition(void) {
+    if(i2c_batch_left) {
+        I2C1->CTLR1 |= I2C_CTLR1_START;
+        i2c_async_restart = 1;
+    } else {
+        I2C1->CTLR1 |= I2C_CTLR1_STOP;
+    }
+}
+
+/**
+ * @brief จบ op ปัจจุบัน: บันทึกผล แล้วต่อ op ถัดไปหรือปิด engine และเรียก callback
+ */
+static void I2C_AsyncFinish(I2C_Status status) {
+    I2C1->CTLR2 &= (uint16_t)~(I2C_CTLR2_ITBUFEN | I2C_DMA_BITS);
+    I2C1->CTLR1 |= I2C_CTLR1_ACK;
+    
+    if(i2c_async_dma) {
+        DMA_Stop(i2c_async_read ? SIMPLE_I2C_RX_DMA_CHANNEL : SIMPLE_I2C_TX_DMA_CHANNEL);
+    }
+    
+    i2c_batch_op->status = status;
+    if(i2c_batch_status == I2C_OK) {
+        i2c_batch_status = status;
+    }
+    
+    if(i2c_batch_left) {
+        uint8_t restart = i2c_async_restart;
+        
+        i2c_batch_left--;
+        I2C_AsyncLoad(++i2c_batch_op);
+        
+        // op ก่อนหน้าจบด้วย STOP (error): เริ่มใหม่หลัง STOP
+        if(!restart) {
+            I2C1->CTLR1 |= I2C_CTLR1_START;
+        }
+        return;
+    }
+    
+    I2C_AsyncCallback callback = i2c_async_callback;
+    
+    I2C1->CTLR2 &= (uint16_t)~I2C_ASYNC_IT_BITS;
+    i2c_async_status = i2c_batch_status;
+    i2c_async_phase = I2C_PHASE_IDLE;
+    
+    if(callback) {
+        callback(i2c_async_status, i2c_async_context);
+    }
+}
+
+/**
+ * @brief เริ่ม batch (เรียกขณะปิด IRQ)
+ */
+static I2C_Status I2C_AsyncBeginLocked(I2C_Op* ops, uint8_t count,
+                                       I2C_AsyncCallback callback, void* context) {
+    if(i2c_async_phase != I2C_PHASE_IDLE) {
+        return I2C_ERROR_BUS_BUSY;
+    }
+    
+    i2c_batch_op = ops;
+    i2c_batch_left = count - 1;
+    i2c_batch_status = I2C_OK;
+    i2c_async_callback = callback;
+    i2c_async_context = context;
+    i2c_async_status = I2C_ERROR_BUS_BUSY;
+    I2C_AsyncLoad(ops);
+    
+    I2C1->STAR1 = (uint16_t)~I2C_ERROR_FLAGS;
+    I2C1->CTLR2 = (I2C1->CTLR2 & (uint16_t)~I2C_CTLR2_ITBUFEN) | I2C_CTLR2_ITEVTEN | I2C_CTLR2_ITERREN;
+    I2C1->CTLR1 |= I2C_CTLR1_ACK | I2C_CTLR1_START;
+    
+    return I2C_OK;
+}
+
+/**
+ * @brief เริ่ม op เดี่ยวผ่าน op ภายใน (I2C_ReadRegAsync/I2C_WriteRegAsync)
+ */
+static I2C_Status I2C_AsyncSingle(uint8_t addr, uint8_t reg, uint8_t* data, uint16_t len,
+                                  uint8_t direction, I2C_AsyncCallback callback, void* context) {
+    if(I2C_WANT_DMA(len, direction == I2C_OP_READ)) {
+        I2C_DmaEnsureInit();
+    }
+    
+    uint32_t mstatus = I2C_Lock();
+    I2C_Status status = I2C_ERROR_BUS_BUSY;
+    
+    if(i2c_async_phase == I2C_PHASE_IDLE) {
+        i2c_single_op.addr = addr;
+        i2c_single_op.reg = reg;
+        i2c_single_op.direction = direction;
+        i2c_single_op.data = data;
+        i2c_single_op.len = len;
+        status = I2C_AsyncBeginLocked(&i2c_single_op, 1, callback, context);
+    }
+    
+    I2C_Unlock(mstatus);
+    return status;
+}
+#endif  // SIMPLE_I2C_ASYNC
+
+/**
+ * @brief ตั้ง FREQ/CKCFGR จาก SystemCoreClock ปัจจุบันและ i2c_speed แล้วเปิด I2C
+ */
+static void I2C_ApplySpeed(void) {
+    I2C_InitTypeDef I2C_InitStructure = {0};
+    
+    I2C_InitStructure.I2C_ClockSpeed = i2c_speed;
+    I2C_InitStructure.I2C_Mode = I2C_Mode_I2C;
+    I2C_InitStructure.I2C_DutyCycle = I2C_DutyCycle_2;
+    I2C_InitStructure.I2C_OwnAddress1 = 0x00;  // Master mode
+    I2C_InitStructure.I2C_Ack = I2C_Ack_Enable;
+    I2C_InitStructure.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
+    
+    I2C_Init(I2C1, &I2C_InitStructure);
+    I2C_Cmd(I2C1, ENABLE);
+}
+
+#if SIMPLE_SYSCLOCK_RETIME
+static SysClock_Hook_t i2c_sysclock_hook;
+
+/**
+ * @brief SimpleHAL_SetSysClock(): รอ transaction ที่ค้างแล้วคำนวณ timing ใหม่
+ */
+static void I2C_SysClockChanged(SysClock_Phase phase, uint32_t old_hz, uint32_t new_hz) {
+    (void)old_hz;
+    (void)new_hz;
+    if (!(I2C1->CTLR1 & I2C_CTLR1_PE)) return;
+
+    if (phase == SYSCLK_PHASE_PRE) {
+#if SIMPLE_I2C_ASYNC
+        while(I2C_AsyncBusy());
+#endif
+        // STOP ของ transaction สุดท้ายยังอยู่บนสาย
+        uint32_t start = Get_CurrentMs();
+        while((I2C1->STAR2 & I2C_STAR2_BUSY) && (Get_CurrentMs() - start) < I2C_TIMEOUT_MS);
+        return;
+    }
+    I2C_ApplySpeed();
+}
+#endif
+
 /* ========== Public Functions ========== */
 
 /**
@@ -32,14 +385,10 @@ static I2C_Status I2C_WaitEvent(uint32_t event, uint32_t timeout_ms) {
  */
 void I2C_SimpleInit(I2C_Speed speed, I2C_PinConfig pin_config) {
     GPIO_InitTypeDef GPIO_InitStructure = {0};
-    I2C_InitTypeDef I2C_InitStructure = {0};
     
-    // 1. เปิด Clock
-    if(pin_config == I2C_PINS_DEFAULT) {
-        RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC | RCC_APB1Periph_I2C1, ENABLE);
-    } else {
-        RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOD | RCC_APB1Periph_I2C1, ENABLE);
-    }
+    // 1. เปิด Clock (I2C1 อยู่บน APB1)
+    Clock_AcquireOnce(pin_config == I2C_PINS_DEFAULT ? CLOCK_GPIOC : CLOCK_GPIOD, &i2c_clocks);
+    Clock_AcquireOnce(CLOCK_I2C1, &i2c_clocks);
     
     // 2. ตั้งค่า Pin Remapping และ GPIO
     switch(pin_config) {
@@ -65,18 +414,20 @@ void I2C_SimpleInit(I2C_Speed speed, I2C_PinConfig pin_config) {
             break;
     }
     
-    // 3. ตั้งค่า I2C
-    I2C_InitStructure.I2C_ClockSpeed = speed;
-    I2C_InitStructure.I2C_Mode = I2C_Mode_I2C;
-    I2C_InitStructure.I2C_DutyCycle = I2C_DutyCycle_2;
-    I2C_InitStructure.I2C_OwnAddress1 = 0x00;  // Master mode
-    I2C_InitStructure.I2C_Ack = I2C_Ack_Enable;
-    I2C_InitStructure.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
+    // 3. ตั้งค่าและเปิดใช้งาน I2C
+    i2c_speed = speed;
+    I2C_ApplySpeed();
     
-    I2C_Init(I2C1, &I2C_InitStructure);
+    // 4. เตรียม interrupt สำหรับ async API (เปิดจริงเฉพาะระหว่าง transaction)
+    i2c_async_phase = I2C_PHASE_IDLE;
+#if SIMPLE_I2C_ASYNC
+    NVIC_EnableIRQ(I2C1_EV_IRQn);
+    NVIC_EnableIRQ(I2C1_ER_IRQn);
+#endif
     
-    // 4. เปิดใช้งาน I2C
-    I2C_Cmd(I2C1, ENABLE);
+#if SIMPLE_SYSCLOCK_RETIME
+    SysClock_AddHook(&i2c_sysclock_hook, I2C_SysClockChanged);
+#endif
 }
 
 /**
@@ -86,8 +437,7 @@ I2C_Status I2C_Write(uint8_t addr, uint8_t* data, uint16_t len) {
     I2C_Status status;
     
     // 1. ส่ง START condition
-    I2C_GenerateSTART(I2C1, ENABLE);
-    status = I2C_WaitEvent(I2C_EVENT_MASTER_MODE_SELECT, I2C_TIMEOUT_MS);
+    status = I2C_SendStart();
     if(status != I2C_OK) return status;
     
     // 2. ส่ง address + Write bit
@@ -96,11 +446,8 @@ I2C_Status I2C_Write(uint8_t addr, uint8_t* data, uint16_t len) {
     if(status != I2C_OK) return status;
     
     // 3. ส่งข้อมูล
-    for(uint16_t i = 0; i < len; i++) {
-        I2C_SendData(I2C1, data[i]);
-        status = I2C_WaitEvent(I2C_EVENT_MASTER_BYTE_TRANSMITTED, I2C_TIMEOUT_MS);
-        if(status != I2C_OK) return status;
-    }
+    status = I2C_SendBytes(data, len);
+    if(status != I2C_OK) return status;
     
     // 4. ส่ง STOP condition
     I2C_GenerateSTOP(I2C1, ENABLE);
@@ -115,10 +462,29 @@ I2C_Status I2C_Read(uint8_t addr, uint8_t* data, uint16_t len) {
     I2C_Status status;
     
     // 1. ส่ง START condition
-    I2C_GenerateSTART(I2C1, ENABLE);
-    status = I2C_WaitEvent(I2C_EVENT_MASTER_MODE_SELECT, I2C_TIMEOUT_MS);
+    status = I2C_SendStart();
     if(status != I2C_OK) return status;
     
+    if(I2C_WANT_DMA(len, 1) && I2C_DmaEnsureInit()) {
+        // DMA + LAST ต้องพร้อมก่อนล้าง ADDR: hardware ตอบ NACK ที่ byte สุดท้ายเอง
+        I2C_DmaArm(SIMPLE_I2C_RX_DMA_CHANNEL, data, len);
+        I2C1->CTLR2 |= I2C_DMA_BITS;
+        
+        I2C_Send7bitAddress(I2C1, addr << 1, I2C_Direction_Receiver);
+        status = I2C_WaitEvent(I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED, I2C_TIMEOUT_MS);
+        if(status != I2C_OK) {
+            I2C1->CTLR2 &= (uint16_t)~I2C_DMA_BITS;
+            DMA_Stop(SIMPLE_I2C_RX_DMA_CHANNEL);
+            return status;
+        }
+        
+        status = I2C_DmaWait(SIMPLE_I2C_RX_DMA_CHANNEL, len);
+        if(status != I2C_OK) return status;
+        
+        I2C_GenerateSTOP(I2C1, ENABLE);
+        return I2C_OK;
+    }
+    
     // 2. ส่ง address + Read bit
     I2C_Send7bitAddress(I2C1, addr << 1, I2C_Direction_Receiver);
     status = I2C_WaitEvent(I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED, I2C_TIMEOUT_MS);
@@ -180,8 +546,7 @@ I2C_Status I2C_WriteRegMulti(uint8_t addr, uint8_t reg, uint8_t* data, uint16_t
     I2C_Status status;
     
     // 1. ส่ง START condition
-    I2C_GenerateSTART(I2C1, ENABLE);
-    status = I2C_WaitEvent(I2C_EVENT_MASTER_MODE_SELECT, I2C_TIMEOUT_MS);
+    status = I2C_SendStart();
     if(status != I2C_OK) return status;
     
     // 2. ส่ง address + Write bit
@@ -195,11 +560,8 @@ I2C_Status I2C_WriteRegMulti(uint8_t addr, uint8_t reg, uint8_t* data, uint16_t
     if(status != I2C_OK) return status;
     
     // 4. ส่งข้อมูล
-    for(uint16_t i = 0; i < len; i++) {
-        I2C_SendData(I2C1, data[i]);
-        status = I2C_WaitEvent(I2C_EVENT_MASTER_BYTE_TRANSMITTED, I2C_TIMEOUT_MS);
-        if(status != I2C_OK) return status;
-    }
+    status = I2C_SendBytes(data, len);
+    if(status != I2C_OK) return status;
     
     // 5. ส่ง STOP condition
     I2C_GenerateSTOP(I2C1, ENABLE);
@@ -220,19 +582,119 @@ I2C_Status I2C_ReadRegMulti(uint8_t addr, uint8_t reg, uint8_t* data, uint16_t l
 }
 
 /**
- * @brief สแกนหา I2C devices บน bus
+ * @brief ตรวจสอบ address 1 ตัวด้วย timeout สั้น (รอ ADDR หรือ NACK)
  */
-uint8_t I2C_Scan(uint8_t* found_devices, uint8_t max_devices) {
-    uint8_t count = 0;
+I2C_Status I2C_Probe(uint8_t addr) {
+    I2C_Status status = I2C_ERROR_TIMEOUT;
+    uint32_t start;
+    
+    if(i2c_async_phase != I2C_PHASE_IDLE) {
+        return I2C_ERROR_BUS_BUSY;
+    }
+    
+    I2C1->STAR1 = (uint16_t)~I2C_ERROR_FLAGS;
+    I2C1->CTLR1 |= I2C_CTLR1_START;
+    
+    // 1. รอ START (bus ค้างหรือไม่มี pull-up จะไม่เกิด)
+    start = Get_CurrentUs();
+    while(!(I2C1->STAR1 & I2C_STAR1_SB)) {
+        if((Get_CurrentUs() - start) >= SIMPLE_I2C_SCAN_TIMEOUT_US) {
+            I2C_GenerateSTOP(I2C1, ENABLE);
+            return I2C_ERROR_TIMEOUT;
+        }
+    }
+    
+    // 2. ส่ง address แล้วรอ ACK (ADDR) หรือ NACK (AF) อย่างใดอย่างหนึ่ง
+    I2C1->DATAR = (uint8_t)(addr << 1);
+    start = Get_CurrentUs();
+    while((Get_CurrentUs() - start) < SIMPLE_I2C_SCAN_TIMEOUT_US) {
+        uint16_t star1 = I2C1->STAR1;
+        
+        if(star1 & I2C_STAR1_ADDR) {
+            (void)I2C1->STAR2;
+            status = I2C_OK;
+            break;
+        }
+        if(star1 & I2C_STAR1_AF) {
+            status = I2C_ERROR_NACK;
+            break;
+        }
+        if(star1 & (I2C_STAR1_BERR | I2C_STAR1_ARLO)) {
+            status = I2C_ERROR_BUS;
+            break;
+        }
+    }
+    
+    I2C1->STAR1 = (uint16_t)~I2C_ERROR_FLAGS;
+    I2C_GenerateSTOP(I2C1, ENABLE);
+    
+    // 3. รอ STOP ออกจาก bus ก่อน probe ถัดไป
+    start = Get_CurrentUs();
+    while(I2C1->CTLR1 & I2C_CTLR1_STOP) {
+        if((Get_CurrentUs() - start) >= SIMPLE_I2C_SCAN_TIMEOUT_US) {
+            return I2C_ERROR_BUS;
+        }
+    }
+    
+    return status;
+}
+
+/**
+ * @brief Probe รายการ address และเก็บตัวที่ตอบ (หยุดเมื่อ bus มีปัญหา)
+ */
+static uint8_t I2C_ScanRange(const uint8_t* candidates, uint8_t first, uint8_t count,
+                             uint8_t* found_devices, uint8_t max_devices) {
+    uint8_t found = 0;
     
-    for(uint8_t addr = 0x08; addr < 0x78; addr++) {
-        if(I2C_IsDeviceReady(addr)) {
-            if(count < max_devices) {
-                found_devices[count++] = addr;
+    for(uint8_t i = 0; i < count; i++) {
+        uint8_t addr = candidates ? candidates[i] : (uint8_t)(first + i);
+        I2C_Status status = I2C_Probe(addr);
+        
+        if(status == I2C_OK) {
+            if(found < max_devices) {
+                found_devices[found++] = addr;
             }
+        } else if(status != I2C_ERROR_NACK) {
+            break;  // bus error/ค้าง: address ที่เหลือก็จะไม่ตอบ
+        }
+    }
+    
+    return found;
+}
+
+/**
+ * @brief สแกนหา I2C devices บน bus
+ */
+uint8_t I2C_Scan(uint8_t* found_devices, uint8_t max_devices) {
+    return I2C_ScanRange(NULL, 0x08, 0x78 - 0x08, found_devices, max_devices);
+}
+
+/**
+ * @brief สแกนเฉพาะ address ที่ระบุ
+ */
+uint8_t I2C_ScanList(const uint8_t* candidates, uint8_t count,
+                     uint8_t* found_devices, uint8_t max_devices) {
+    if(candidates == NULL) return 0;
+    return I2C_ScanRange(candidates, 0, count, found_devices, max_devices);
+}
+
+/**
+ * @brief ตรวจผลสแกนครั้งก่อน แล้วสแกนเต็มเฉพาะเมื่อไม่ตรง
+ */
+uint8_t I2C_ScanCached(uint8_t* known_devices, uint8_t* known_count, uint8_t max_devices) {
+    uint8_t count = *known_count;
+    
+    // Fast path: ทุก device เดิมยังตอบ
+    if(count > 0 && count <= max_devices) {
+        uint8_t i;
+        for(i = 0; i < count; i++) {
+            if(I2C_Probe(known_devices[i]) != I2C_OK) break;
         }
+        if(i == count) return count;
     }
     
+    count = I2C_Scan(known_devices, max_devices);
+    *known_count = count;
     return count;
 }
 
@@ -240,22 +702,242 @@ uint8_t I2C_Scan(uint8_t* found_devices, uint8_t max_devices) {
  * @brief ตรวจสอบว่า device ตอบสนองหรือไม่
  */
 uint8_t I2C_IsDeviceReady(uint8_t addr) {
-    I2C_Status status;
+    return (I2C_Probe(addr) == I2C_OK) ? 1 : 0;
+}
+
+#if SIMPLE_I2C_ASYNC
+/* ========== Async (Interrupt-driven) API ========== */
+
+/**
+ * @brief อ่านหลาย bytes จาก register แบบ non-blocking
+ */
+I2C_Status I2C_ReadRegAsync(uint8_t addr, uint8_t reg, uint8_t* data, uint16_t len,
+                            I2C_AsyncCallback callback, void* context) {
+    if(data == NULL || len == 0) return I2C_ERROR_NACK;
+    return I2C_AsyncSingle(addr, reg, data, len, I2C_OP_READ, callback, context);
+}
+
+/**
+ * @brief เขียนหลาย bytes ไปยัง register แบบ non-blocking
+ */
+I2C_Status I2C_WriteRegAsync(uint8_t addr, uint8_t reg, const uint8_t* data, uint16_t len,
+                             I2C_AsyncCallback callback, void* context) {
+    if(data == NULL) len = 0;
+    return I2C_AsyncSingle(addr, reg, (uint8_t*)data, len, I2C_OP_WRITE, callback, context);
+}
+
+/**
+ * @brief ส่งชุด register read/write ให้ทำต่อกันแบบ non-blocking
+ */
+I2C_Status I2C_SubmitBatch(I2C_Op* ops, uint8_t count, I2C_AsyncCallback callback, void* context) {
+    uint8_t need_dma = 0;
     
-    // ส่ง START condition
-    I2C_GenerateSTART(I2C1, ENABLE);
-    status = I2C_WaitEvent(I2C_EVENT_MASTER_MODE_SELECT, I2C_TIMEOUT_MS);
-    if(status != I2C_OK) {
-        I2C_GenerateSTOP(I2C1, ENABLE);
+    if(ops == NULL || count == 0) return I2C_ERROR_NACK;
+    
+    for(uint8_t i = 0; i < count; i++) {
+        uint8_t read = (ops[i].direction == I2C_OP_READ);
+        if(read && (ops[i].data == NULL || ops[i].len == 0)) return I2C_ERROR_NACK;
+        if(I2C_WANT_DMA(ops[i].len, read)) need_dma = 1;
+    }
+    
+    if(need_dma) {
+        I2C_DmaEnsureInit();
+    }
+    
+    uint32_t mstatus = I2C_Lock();
+    I2C_Status status = I2C_AsyncBeginLocked(ops, count, callback, context);
+    I2C_Unlock(mstatus);
+    return status;
+}
+
+/**
+ * @brief ทำชุด register read/write ต่อกันแล้วรอจนจบ
+ */
+I2C_Status I2C_RunBatch(I2C_Op* ops, uint8_t count) {
+    I2C_Status status = I2C_SubmitBatch(ops, count, NULL, NULL);
+    if(status != I2C_OK) return status;
+    
+    while(I2C_AsyncBusy());
+    return i2c_async_status;
+}
+
+/**
+ * @brief ตรวจสอบว่า async transaction ยังทำงานอยู่หรือไม่ (และจัดการ timeout)
+ */
+uint8_t I2C_AsyncBusy(void) {
+    if(i2c_async_phase == I2C_PHASE_IDLE) return 0;
+    
+    if((Get_CurrentMs() - i2c_async_start_ms) >= I2C_TIMEOUT_MS) {
+        uint32_t mstatus = I2C_Lock();
+        if(i2c_async_phase != I2C_PHASE_IDLE) {
+            i2c_batch_left = 0;  // ยกเลิกทั้ง batch
+            I2C1->CTLR1 |= I2C_CTLR1_STOP;
+            I2C_AsyncFinish(I2C_ERROR_TIMEOUT);
+        }
+        I2C_Unlock(mstatus);
         return 0;
     }
     
-    // ส่ง address
-    I2C_Send7bitAddress(I2C1, addr << 1, I2C_Direction_Transmitter);
-    status = I2C_WaitEvent(I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED, I2C_TIMEOUT_MS);
+    return 1;
+}
+
+/**
+ * @brief ผลของ async transaction ล่าสุด
+ */
+I2C_Status I2C_AsyncGetStatus(void) {
+    return i2c_async_status;
+}
+
+/* ========== Interrupt Handlers ========== */
+
+/**
+ * @brief DMA RX transfer complete: byte สุดท้ายรับแล้ว (NACK โดย LAST) ส่ง STOP หรือ repeated START
+ */
+static void I2C_DmaRxComplete(DMA_Channel channel) {
+    (void)channel;
     
-    // ส่ง STOP condition
-    I2C_GenerateSTOP(I2C1, ENABLE);
+    // Blocking I2C_Read() รอ DMA status เอง
+    if(i2c_async_phase != I2C_PHASE_READ || !i2c_async_dma) return;
+    
+    I2C_AsyncEndCondition();
+    I2C_AsyncFinish(I2C_OK);
+}
+
+void I2C1_EV_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+void I2C1_ER_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+
+/**
+ * @brief I2C1 event: เดิน state machine ทีละ event (SB, ADDR, TXE/BTF, RXNE)
+ */
+static inline __attribute__((always_inline)) void I2C_EventStep(void) {
+    uint16_t star1 = I2C1->STAR1;
+    
+    if(i2c_async_phase == I2C_PHASE_IDLE) {
+        I2C1->CTLR2 &= (uint16_t)~I2C_ASYNC_IT_BITS;
+        return;
+    }
+    
+    // Byte ที่รับก่อน: repeated START ของ op ถัดไปอาจตั้ง SB มาพร้อม byte สุดท้าย
+    if(i2c_async_phase == I2C_PHASE_READ && !i2c_async_dma && !i2c_async_wait_sb
+       && (star1 & I2C_STAR1_RXNE)) {
+        i2c_async_data[i2c_async_index++] = (uint8_t)I2C1->DATAR;
+        
+        uint16_t remaining = i2c_async_len - i2c_async_index;
+        if(remaining == 1) {
+            // byte สุดท้ายกำลังรับ: ตอบ NACK แล้ว STOP/START
+            I2C1->CTLR1 &= (uint16_t)~I2C_CTLR1_ACK;
+            I2C_AsyncEndCondition();
+        } else if(remaining == 0) {
+            I2C_AsyncFinish(I2C_OK);
+            if(i2c_async_phase == I2C_PHASE_IDLE) return;
+            star1 = I2C1->STAR1;
+        }
+    }
+    
+    // START (หรือ repeated START) ส่งแล้ว: ส่ง address
+    if(star1 & I2C_STAR1_SB) {
+        I2C1->DATAR = (uint8_t)((i2c_async_addr << 1) | (i2c_async_phase == I2C_PHASE_READ ? 1 : 0));
+        i2c_async_wait_sb = 0;
+        return;
+    }
+    
+    // BTF/TXE ที่ค้างจาก op ก่อนหน้าจนกว่า START จะเกิด
+    if(i2c_async_wait_sb) return;
+    
+    // Address ได้ ACK
+    if(star1 & I2C_STAR1_ADDR) {
+        if(i2c_async_phase == I2C_PHASE_READ && i2c_async_dma) {
+            // DMA + LAST พร้อมก่อนล้าง ADDR: NACK byte สุดท้ายอัตโนมัติ, จบที่ DMA TC
+            I2C_DmaArm(SIMPLE_I2C_RX_DMA_CHANNEL, i2c_async_data, i2c_async_len);
+            I2C1->CTLR2 |= I2C_DMA_BITS;
+            (void)I2C1->STAR2;
+            return;
+        }
+        
+        if(i2c_async_phase == I2C_PHASE_READ) {
+            // 1 byte: NACK ต้องตั้งก่อนล้าง ADDR และ STOP ทันทีหลังล้าง
+            if(i2c_async_len == 1) {
+                I2C1->CTLR1 &= (uint16_t)~I2C_CTLR1_ACK;
+            }
+            (void)I2C1->STAR2;
+            if(i2c_async_len == 1) {
+                I2C_AsyncEndCondition();
+            }
+        } else {
+            (void)I2C1->STAR2;
+            I2C1->DATAR = i2c_async_reg;
+            
+            if(i2c_async_dma && !i2c_async_read) {
+                // DMA เติมข้อมูลต่อจาก register byte, จบที่ BTF
+                I2C_DmaArm(SIMPLE_I2C_TX_DMA_CHANNEL, i2c_async_data, i2c_async_len);
+                i2c_async_index = i2c_async_len;
+                I2C1->CTLR2 |= I2C_CTLR2_DMAEN;
+                return;
+            }
+        }
+        I2C1->CTLR2 |= I2C_CTLR2_ITBUFEN;
+        return;
+    }
+    
+    // Read phase: รับข้อมูลที่ด้านบน (RXNE) หรือผ่าน DMA
+    if(i2c_async_phase == I2C_PHASE_READ) return;
+    
+    // Write phase: เติม DATAR ระหว่างที่ยังมีข้อมูล
+    if(star1 & I2C_STAR1_TXE) {
+        if(!i2c_async_read && i2c_async_index < i2c_async_len) {
+            I2C1->DATAR = i2c_async_data[i2c_async_index++];
+            return;
+        }
+        
+        // ข้อมูลหมดแล้ว: รอ BTF (byte สุดท้ายออกจาก shift register)
+        I2C1->CTLR2 &= (uint16_t)~I2C_CTLR2_ITBUFEN;
+        
+        if(i2c_async_dma && DMA_GetRemainingCount(SIMPLE_I2C_TX_DMA_CHANNEL) != 0) {
+            return;
+        }
+        
+        if(star1 & I2C_STAR1_BTF) {
+            if(i2c_async_read) {
+                // Repeated START (BTF ถูกล้างเมื่อ START เกิดขึ้น)
+                i2c_async_phase = I2C_PHASE_READ;
+                i2c_async_wait_sb = 1;
+                I2C1->CTLR1 |= I2C_CTLR1_ACK | I2C_CTLR1_START;
+            } else {
+                I2C_AsyncEndCondition();
+                I2C_AsyncFinish(I2C_OK);
+            }
+        }
+    }
+}
+
+/**
+ * @brief I2C1 error: NACK, bus error, arbitration lost, overrun
+ */
+static inline __attribute__((always_inline)) void I2C_ErrorStep(void) {
+    uint16_t star1 = I2C1->STAR1;
+    
+    I2C1->STAR1 = (uint16_t)~I2C_ERROR_FLAGS;
+    
+    if(i2c_async_phase == I2C_PHASE_IDLE) return;
+    
+    // เสีย arbitration แล้วไม่ใช่ master อีก: ห้ามส่ง STOP
+    if(!(star1 & I2C_STAR1_ARLO)) {
+        I2C1->CTLR1 |= I2C_CTLR1_STOP;
+    }
     
-    return (status == I2C_OK) ? 1 : 0;
+    I2C_AsyncFinish((star1 & I2C_STAR1_AF) ? I2C_ERROR_NACK : I2C_ERROR_BUS);
+}
+
+// Handlers แยกจาก state machine เพื่อให้ทุกทางออกผ่านจุดวัดของ SimpleISRStat
+void I2C1_EV_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_I2C_EV);
+    I2C_EventStep();
+    ISR_STAT_EXIT(ISR_STAT_I2C_EV);
+}
+
+void I2C1_ER_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_I2C_ER);
+    I2C_ErrorStep();
+    ISR_STAT_EXIT(ISR_STAT_I2C_ER);
 }
+#endif  // SIMPLE_I2C_ASYNC
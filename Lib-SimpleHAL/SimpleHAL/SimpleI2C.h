@@ -1,8 +1,8 @@
 /**
  * @file SimpleI2C.h
  * @brief Simple I2C Library สำหรับ CH32V003 แบบ Arduino-style
- * @version 1.0
- * @date 2025-12-12
+ * @version 1.3
+ * @date 2026-10-14
  * 
  * @details
  * Library นี้ห่อหุ้ม Hardware I2C ให้ใช้งานง่ายแบบ Arduino Wire
@@ -14,6 +14,10 @@
  * - ฟังก์ชัน read/write แบบ Arduino Wire
  * - Helper functions สำหรับ register access
  * - Error handling ด้วย return status
+ * - Register read/write แบบ non-blocking (interrupt-driven) พร้อม callback (SIMPLE_I2C_ASYNC)
+ * - DMA อัตโนมัติสำหรับ transfer ยาว (EEPROM dump, OLED framebuffer)
+ * - Batch ของหลาย sensor ต่อกันด้วย repeated START พร้อมผลแยกราย op
+ * - Scan เร็ว: probe timeout สั้น, รายการ address ที่กำหนด, ตรวจผลสแกนครั้งก่อน
  * 
  * @example
  * // ตัวอย่างการใช้งาน
@@ -33,6 +37,10 @@
  * }
  * 
  * @note ต้องต่อ pull-up resistor (4.7kΩ แนะนำ) ที่ SDA และ SCL
+ * @note Transfer ตั้งแต่ SIMPLE_I2C_DMA_THRESHOLD bytes ใช้ DMA CH6 (TX) / CH7 (RX)
+ *       จองผ่าน DMA_AllocChannel() ครั้งแรกที่ใช้ ถ้าถูกจองอยู่จะส่ง/รับแบบไม่ใช้ DMA
+ * @note SimpleHAL_SetSysClock() รอ transaction ที่ค้างแล้วตั้ง timing ใหม่จากความเร็วที่ init
+ *       (400 kHz ต้องใช้ HCLK อย่างน้อย 12 MHz)
  */
 
 #ifndef __SIMPLE_I2C_H
@@ -44,6 +52,39 @@ extern "C" {
 
 #include <ch32v00x_i2c.h>
 #include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief ความยาวขั้นต่ำ (bytes) ที่ส่ง/รับผ่าน DMA แทนทีละ byte (0 = ไม่ใช้ DMA)
+ * @note ใช้กับ I2C_Write/Read, I2C_WriteRegMulti/ReadRegMulti และ async API
+ */
+#ifndef SIMPLE_I2C_DMA_THRESHOLD
+#define SIMPLE_I2C_DMA_THRESHOLD 16
+#endif
+
+/**
+ * @brief DMA channel สำหรับ I2C1_TX (hardware กำหนดเป็น CH6)
+ */
+#ifndef SIMPLE_I2C_TX_DMA_CHANNEL
+#define SIMPLE_I2C_TX_DMA_CHANNEL DMA_CH6
+#endif
+
+/**
+ * @brief DMA channel สำหรับ I2C1_RX (hardware กำหนดเป็น CH7)
+ */
+#ifndef SIMPLE_I2C_RX_DMA_CHANNEL
+#define SIMPLE_I2C_RX_DMA_CHANNEL DMA_CH7
+#endif
+
+/**
+ * @brief Timeout (us) ของแต่ละขั้นใน I2C_Probe() (START, address phase, STOP)
+ * @note Address phase ที่ 100 kHz ใช้ ~100 us จึงเผื่อ clock stretching ได้
+ */
+#ifndef SIMPLE_I2C_SCAN_TIMEOUT_US
+#define SIMPLE_I2C_SCAN_TIMEOUT_US 500
+#endif
 
 /* ========== Enumerations ========== */
 
@@ -74,9 +115,42 @@ typedef enum {
     I2C_OK = 0,              /**< Success */
     I2C_ERROR_TIMEOUT,       /**< Timeout error */
     I2C_ERROR_NACK,          /**< NACK received */
-    I2C_ERROR_BUS_BUSY       /**< Bus busy */
+    I2C_ERROR_BUS_BUSY,      /**< Bus busy */
+    I2C_ERROR_BUS            /**< Bus error หรือ arbitration lost */
 } I2C_Status;
 
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief Callback เมื่อ async transaction จบ
+ * @param status I2C_OK หรือ error ที่เกิด
+ * @param context ค่าที่ส่งมากับ I2C_ReadRegAsync()/I2C_WriteRegAsync()
+ *
+ * @note ถูกเรียกจาก I2C interrupt (หรือจาก I2C_AsyncBusy() เมื่อ timeout)
+ * @note เริ่ม async transaction ถัดไปจากใน callback ได้
+ */
+typedef void (*I2C_AsyncCallback)(I2C_Status status, void* context);
+
+/**
+ * @brief ทิศทางของ op ใน batch
+ */
+typedef enum {
+    I2C_OP_READ = 0,         /**< ส่ง register แล้ว repeated START อ่าน len bytes */
+    I2C_OP_WRITE = 1         /**< ส่ง register ตามด้วย len bytes */
+} I2C_OpDirection;
+
+/**
+ * @brief Register read/write 1 รายการใน batch
+ */
+typedef struct {
+    uint8_t addr;                /**< ที่อยู่ของ device (7-bit address) */
+    uint8_t reg;                 /**< register เริ่มต้น */
+    uint8_t direction;           /**< I2C_OpDirection */
+    uint8_t* data;               /**< buffer รับ/ส่ง (write: NULL ได้เมื่อ len = 0) */
+    uint16_t len;                /**< จำนวน bytes */
+    volatile I2C_Status status;  /**< ผลของ op นี้ (engine เขียน, I2C_ERROR_BUS_BUSY = ยังไม่จบ) */
+} I2C_Op;
+
 /* ========== Constants ========== */
 
 #define I2C_TIMEOUT_MS  100  /**< Timeout ในหน่วย milliseconds */
@@ -187,6 +261,9 @@ I2C_Status I2C_ReadRegMulti(uint8_t addr, uint8_t reg, uint8_t* data, uint16_t l
  * @param max_devices ขนาดสูงสุดของ array
  * @return จำนวน devices ที่พบ
  * 
+ * @note ใช้ I2C_Probe(): address ที่ไม่มี device จบทันทีที่ NACK
+ * @note หยุดสแกนเมื่อ bus error หรือ bus ค้าง (คืนจำนวนที่พบก่อนหน้า)
+ * 
  * @example
  * uint8_t devices[10];
  * uint8_t count = I2C_Scan(devices, 10);
@@ -196,6 +273,46 @@ I2C_Status I2C_ReadRegMulti(uint8_t addr, uint8_t reg, uint8_t* data, uint16_t l
  */
 uint8_t I2C_Scan(uint8_t* found_devices, uint8_t max_devices);
 
+/**
+ * @brief สแกนเฉพาะ address ที่ระบุ (เช่น address ที่ board รองรับ)
+ * @param candidates รายการ address ที่ต้องการตรวจ
+ * @param count จำนวน address ใน candidates
+ * @param found_devices array สำหรับเก็บ addresses ที่พบ
+ * @param max_devices ขนาดสูงสุดของ array
+ * @return จำนวน devices ที่พบ
+ * 
+ * @example
+ * static const uint8_t board[] = {0x3C, 0x68, 0x76, 0x77};
+ * uint8_t found[4];
+ * uint8_t n = I2C_ScanList(board, 4, found, 4);
+ */
+uint8_t I2C_ScanList(const uint8_t* candidates, uint8_t count,
+                     uint8_t* found_devices, uint8_t max_devices);
+
+/**
+ * @brief ใช้ผลสแกนครั้งก่อน: probe เฉพาะ address เดิม สแกนเต็มเมื่อไม่ตรง
+ * @param known_devices [in/out] addresses ที่พบครั้งก่อน / ผลสแกนใหม่
+ * @param known_count [in/out] จำนวน address ใน known_devices (0 = ยังไม่เคยสแกน)
+ * @param max_devices ขนาดของ known_devices
+ * @return จำนวน devices
+ * 
+ * @note เก็บ known_devices ไว้ใน RAM ที่ไม่ถูกล้างตอน warm reset หรือใน flash
+ *       เพื่อให้ boot ครั้งถัดไป probe แค่ไม่กี่ address
+ * @note device ใหม่ที่เพิ่มโดยที่ตัวเดิมยังตอบครบจะไม่ถูกพบ (เรียก I2C_Scan() เอง)
+ */
+uint8_t I2C_ScanCached(uint8_t* known_devices, uint8_t* known_count, uint8_t max_devices);
+
+/**
+ * @brief ตรวจ address 1 ตัว (START, address, รอ ACK หรือ NACK, STOP)
+ * @param addr ที่อยู่ของ device (7-bit address)
+ * @return I2C_OK = ตอบ, I2C_ERROR_NACK = ไม่มี device,
+ *         I2C_ERROR_TIMEOUT / I2C_ERROR_BUS = bus มีปัญหา,
+ *         I2C_ERROR_BUS_BUSY = async transaction ใช้ bus อยู่
+ * 
+ * @note ใช้ timeout SIMPLE_I2C_SCAN_TIMEOUT_US แทน I2C_TIMEOUT_MS
+ */
+I2C_Status I2C_Probe(uint8_t addr);
+
 /**
  * @brief ตรวจสอบว่า device ตอบสนองหรือไม่
  * @param addr ที่อยู่ของ device (7-bit address)
@@ -208,6 +325,103 @@ uint8_t I2C_Scan(uint8_t* found_devices, uint8_t max_devices);
  */
 uint8_t I2C_IsDeviceReady(uint8_t addr);
 
+#if SIMPLE_I2C_ASYNC
+/* ========== Async (Interrupt-driven) API ========== */
+
+/**
+ * @brief อ่านหลาย bytes จาก register แบบ non-blocking
+ * @param addr ที่อยู่ของ device (7-bit address)
+ * @param reg ที่อยู่ของ register เริ่มต้น
+ * @param data buffer รับข้อมูล (ต้องอยู่จนกว่า callback จะถูกเรียก)
+ * @param len จำนวน bytes (อย่างน้อย 1)
+ * @param callback เรียกเมื่อจบ (NULL = ไม่เรียก ใช้ I2C_AsyncBusy() แทน)
+ * @param context ค่าที่ส่งต่อให้ callback
+ * @return I2C_OK = เริ่มแล้ว, I2C_ERROR_BUS_BUSY = มี transaction ทำงานอยู่,
+ *         I2C_ERROR_NACK = data เป็น NULL หรือ len เป็น 0
+ *
+ * @note ส่ง register address แล้ว repeated START เป็น read ใน transaction เดียว
+ * @note ห้ามเรียก blocking API ระหว่าง I2C_AsyncBusy() (จะได้ I2C_ERROR_BUS_BUSY)
+ *
+ * @example
+ * static uint8_t accel[6];
+ *
+ * void accel_done(I2C_Status status, void* context) {
+ *     if (status == I2C_OK) accel_ready = 1;
+ * }
+ *
+ * I2C_ReadRegAsync(0x68, 0x3B, accel, 6, accel_done, NULL);
+ * // CPU ว่างทำงานอื่นระหว่างอ่าน
+ */
+I2C_Status I2C_ReadRegAsync(uint8_t addr, uint8_t reg, uint8_t* data, uint16_t len,
+                            I2C_AsyncCallback callback, void* context);
+
+/**
+ * @brief เขียนหลาย bytes ไปยัง register แบบ non-blocking
+ * @param addr ที่อยู่ของ device (7-bit address)
+ * @param reg ที่อยู่ของ register เริ่มต้น
+ * @param data ข้อมูล (ต้องอยู่จนกว่า callback จะถูกเรียก, NULL ได้เมื่อ len = 0)
+ * @param len จำนวน bytes (0 = ส่งเฉพาะ register address)
+ * @param callback เรียกเมื่อจบ (NULL = ไม่เรียก)
+ * @param context ค่าที่ส่งต่อให้ callback
+ * @return I2C_OK = เริ่มแล้ว, I2C_ERROR_BUS_BUSY = มี transaction ทำงานอยู่
+ *
+ * @example
+ * static const uint8_t config[] = {0x00, 0x18};
+ * I2C_WriteRegAsync(0x68, 0x1B, config, sizeof(config), NULL, NULL);
+ */
+I2C_Status I2C_WriteRegAsync(uint8_t addr, uint8_t reg, const uint8_t* data, uint16_t len,
+                             I2C_AsyncCallback callback, void* context);
+
+/**
+ * @brief ส่งชุด register read/write ให้ทำต่อกันแบบ non-blocking
+ * @param ops array ของ op (ต้องอยู่จนกว่า callback จะถูกเรียก)
+ * @param count จำนวน op
+ * @param callback เรียกครั้งเดียวเมื่อครบทุก op พร้อม error แรก (NULL = ไม่เรียก)
+ * @param context ค่าที่ส่งต่อให้ callback
+ * @return I2C_OK = เริ่มแล้ว, I2C_ERROR_BUS_BUSY = มี transaction ทำงานอยู่,
+ *         I2C_ERROR_NACK = parameter ไม่ถูกต้อง (read op ไม่มี buffer)
+ *
+ * @note op ต่อกันด้วย repeated START ไม่มี STOP คั่น (ยกเว้นหลัง op ที่ error)
+ * @note op ที่ error (เช่น sensor ไม่ตอบ) ไม่หยุด batch ดูผลราย op ที่ ops[i].status
+ *
+ * @example
+ * static uint8_t accel[6], gyro[6], baro[3];
+ * static I2C_Op frame[] = {
+ *     {0x19, 0xA8, I2C_OP_READ, accel, 6},
+ *     {0x6B, 0x22, I2C_OP_READ, gyro, 6},
+ *     {0x76, 0xF7, I2C_OP_READ, baro, 3},
+ * };
+ *
+ * I2C_SubmitBatch(frame, 3, frame_done, NULL);
+ */
+I2C_Status I2C_SubmitBatch(I2C_Op* ops, uint8_t count, I2C_AsyncCallback callback, void* context);
+
+/**
+ * @brief ทำชุด register read/write ต่อกันแล้วรอจนครบ (blocking)
+ * @param ops array ของ op
+ * @param count จำนวน op
+ * @return error แรกของ batch หรือ I2C_OK (ผลราย op ที่ ops[i].status)
+ *
+ * @note ใช้ engine เดียวกับ I2C_SubmitBatch() จึงต้องเปิด interrupt อยู่
+ */
+I2C_Status I2C_RunBatch(I2C_Op* ops, uint8_t count);
+
+/**
+ * @brief ตรวจสอบว่า async transaction ยังทำงานอยู่หรือไม่
+ * @return 1 = กำลังทำงาน, 0 = ว่าง
+ *
+ * @note ยกเลิก transaction ที่ op ปัจจุบันนานเกิน I2C_TIMEOUT_MS และเรียก callback
+ *       ด้วย I2C_ERROR_TIMEOUT (เช่น device ค้าง SCL) op ที่เหลือใน batch ถูกข้าม
+ */
+uint8_t I2C_AsyncBusy(void);
+
+/**
+ * @brief ผลของ async transaction หรือ batch ล่าสุด
+ * @return I2C_OK, error แรก หรือ I2C_ERROR_BUS_BUSY ถ้ายังไม่จบ
+ */
+I2C_Status I2C_AsyncGetStatus(void);
+#endif  // SIMPLE_I2C_ASYNC
+
 #ifdef __cplusplus
 }
 #endif
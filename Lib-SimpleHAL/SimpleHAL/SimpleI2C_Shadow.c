@@ -0,0 +1,221 @@
+/**
+ * @file SimpleI2C_Shadow.c
+ * @brief Register Shadow Cache Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleI2C_Shadow.h"
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief หา index ของ register ใน shadow
+ * @return 1 = อยู่ในช่วง, 0 = นอกช่วง
+ */
+static inline uint8_t I2C_ShadowIndex(const I2C_Shadow* shadow, uint8_t reg, uint8_t* index) {
+    uint8_t offset = (uint8_t)(reg - shadow->first_reg);
+    if (reg < shadow->first_reg || offset >= shadow->count) return 0;
+    *index = offset;
+    return 1;
+}
+
+/**
+ * @brief Bitmask ของ registers [start, start + len)
+ */
+static inline uint32_t I2C_ShadowSpan(uint8_t start, uint8_t len) {
+    uint32_t bits = (len >= I2C_SHADOW_MAX_REGS) ? 0xFFFFFFFFUL : ((1UL << len) - 1);
+    return bits << start;
+}
+
+/**
+ * @brief Register ที่ผ่าน cache ได้ (อยู่ในช่วงและไม่ volatile)
+ */
+static inline uint8_t I2C_ShadowCached(const I2C_Shadow* shadow, uint8_t reg, uint8_t* index) {
+    return I2C_ShadowIndex(shadow, reg, index) && !(shadow->volatile_mask & (1UL << *index));
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่มต้น shadow
+ */
+void I2C_ShadowInit(I2C_Shadow* shadow, uint8_t addr, uint8_t first_reg,
+                    uint8_t* storage, uint8_t count, I2C_ShadowMode mode) {
+    if (shadow == NULL) return;
+
+    if (count > I2C_SHADOW_MAX_REGS) {
+        count = I2C_SHADOW_MAX_REGS;
+    }
+
+    shadow->addr = addr;
+    shadow->first_reg = first_reg;
+    shadow->count = storage ? count : 0;
+    shadow->mode = mode;
+    shadow->values = storage;
+    shadow->valid = 0;
+    shadow->dirty = 0;
+    shadow->volatile_mask = 0;
+}
+
+/**
+ * @brief กำหนดให้ register อ่านจาก bus ทุกครั้ง
+ */
+void I2C_ShadowSetVolatile(I2C_Shadow* shadow, uint8_t reg) {
+    uint8_t index;
+    if (shadow == NULL || !I2C_ShadowIndex(shadow, reg, &index)) return;
+
+    uint32_t bit = 1UL << index;
+    shadow->volatile_mask |= bit;
+    shadow->dirty &= ~bit;
+}
+
+/**
+ * @brief อ่านทั้ง block จาก device
+ */
+I2C_Status I2C_ShadowLoad(I2C_Shadow* shadow) {
+    uint8_t buffer[I2C_SHADOW_MAX_REGS];
+
+    if (shadow == NULL || shadow->count == 0) return I2C_OK;
+
+    I2C_Status status = I2C_ReadRegMulti(shadow->addr, shadow->first_reg, buffer, shadow->count);
+    if (status != I2C_OK) return status;
+
+    // เก็บค่าที่ยังรอ flush ไว้
+    for (uint8_t i = 0; i < shadow->count; i++) {
+        if (!(shadow->dirty & (1UL << i))) {
+            shadow->values[i] = buffer[i];
+        }
+    }
+
+    shadow->valid = I2C_ShadowSpan(0, shadow->count);
+    return I2C_OK;
+}
+
+/**
+ * @brief อ่าน register
+ */
+I2C_Status I2C_ShadowRead(I2C_Shadow* shadow, uint8_t reg, uint8_t* value) {
+    uint8_t index;
+
+    if (shadow == NULL || value == NULL) return I2C_ERROR_NACK;
+
+    if (!I2C_ShadowCached(shadow, reg, &index)) {
+        return I2C_ReadRegMulti(shadow->addr, reg, value, 1);
+    }
+
+    uint32_t bit = 1UL << index;
+    if (!(shadow->valid & bit)) {
+        I2C_Status status = I2C_ReadRegMulti(shadow->addr, reg, &shadow->values[index], 1);
+        if (status != I2C_OK) return status;
+        shadow->valid |= bit;
+    }
+
+    *value = shadow->values[index];
+    return I2C_OK;
+}
+
+/**
+ * @brief เขียน register
+ */
+I2C_Status I2C_ShadowWrite(I2C_Shadow* shadow, uint8_t reg, uint8_t value) {
+    uint8_t index;
+
+    if (shadow == NULL) return I2C_ERROR_NACK;
+
+    if (!I2C_ShadowCached(shadow, reg, &index)) {
+        return I2C_WriteRegMulti(shadow->addr, reg, &value, 1);
+    }
+
+    uint32_t bit = 1UL << index;
+    if ((shadow->valid & bit) && shadow->values[index] == value) {
+        return I2C_OK;  // ค่าเดิม (หรือรอ flush ด้วยค่านี้อยู่แล้ว)
+    }
+
+    shadow->values[index] = value;
+    shadow->valid |= bit;
+
+    if (shadow->mode == I2C_SHADOW_WRITE_BACK) {
+        shadow->dirty |= bit;
+        return I2C_OK;
+    }
+
+    I2C_Status status = I2C_WriteRegMulti(shadow->addr, reg, &value, 1);
+    if (status != I2C_OK) {
+        shadow->valid &= ~bit;  // ไม่รู้ว่า device รับค่าหรือไม่
+    }
+    return status;
+}
+
+/**
+ * @brief Read-modify-write บางบิตของ register
+ */
+I2C_Status I2C_ShadowModify(I2C_Shadow* shadow, uint8_t reg, uint8_t mask, uint8_t value) {
+    uint8_t current;
+
+    I2C_Status status = I2C_ShadowRead(shadow, reg, &current);
+    if (status != I2C_OK) return status;
+
+    return I2C_ShadowWrite(shadow, reg, (uint8_t)((current & ~mask) | (value & mask)));
+}
+
+/**
+ * @brief เขียน register ที่ dirty ลง device
+ */
+I2C_Status I2C_ShadowFlush(I2C_Shadow* shadow) {
+    I2C_Status result = I2C_OK;
+
+    if (shadow == NULL) return I2C_ERROR_NACK;
+
+    uint32_t pending = shadow->dirty;
+    uint32_t fillable = shadow->valid & ~shadow->volatile_mask;
+    uint8_t i = 0;
+
+    while (pending) {
+        while (!(pending & (1UL << i))) i++;
+
+        // ขยาย burst ผ่าน register ที่รู้ค่าจนถึง dirty ตัวสุดท้ายที่ต่อกันได้
+        uint8_t start = i;
+        uint8_t end = i;
+        for (uint8_t j = i + 1; j < shadow->count; j++) {
+            uint32_t bit = 1UL << j;
+            if (pending & bit) {
+                end = j;
+            } else if (!(fillable & bit)) {
+                break;
+            }
+        }
+
+        uint8_t len = end - start + 1;
+        uint32_t span = I2C_ShadowSpan(start, len);
+
+        I2C_Status status = I2C_WriteRegMulti(shadow->addr, shadow->first_reg + start,
+                                              &shadow->values[start], len);
+        if (status == I2C_OK) {
+            shadow->dirty &= ~span;
+        } else if (result == I2C_OK) {
+            result = status;
+        }
+
+        pending &= ~span;
+        i = end + 1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief ทิ้งค่าใน cache
+ */
+void I2C_ShadowInvalidate(I2C_Shadow* shadow) {
+    if (shadow == NULL) return;
+    shadow->valid = 0;
+    shadow->dirty = 0;
+}
+
+/**
+ * @brief ตรวจสอบว่ามีค่าที่ยังไม่ได้เขียนลง device หรือไม่
+ */
+uint8_t I2C_ShadowIsDirty(const I2C_Shadow* shadow) {
+    return (shadow && shadow->dirty) ? 1 : 0;
+}
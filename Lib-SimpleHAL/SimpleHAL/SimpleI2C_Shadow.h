@@ -0,0 +1,164 @@
+/**
+ * @file SimpleI2C_Shadow.h
+ * @brief Register Shadow Cache สำหรับ I2C devices บน SimpleI2C
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * เก็บสำเนาของ config registers ของ device ไว้ใน RAM
+ * ทำให้ read-modify-write ไม่ต้องอ่านจาก bus ทุกครั้ง
+ *
+ * **คุณสมบัติ:**
+ * - อ่าน register ที่ cache ไว้จาก RAM (register ที่ตั้งเป็น volatile ผ่าน bus เสมอ)
+ * - Write-through: เขียนลง device ทันที (ข้ามถ้าค่าไม่เปลี่ยน)
+ * - Write-back: พักไว้ใน RAM แล้วรวมเป็น I2C_WriteRegMulti() burst ตอน flush
+ * - หลาย shadow ต่อ device ได้ (เช่นแยก block ของ register)
+ *
+ * **หน่วยความจำ:** ผู้เรียกเป็นเจ้าของ struct และ storage (1 byte ต่อ register)
+ * ครอบคลุมได้สูงสุด 32 registers ต่อเนื่องต่อ shadow
+ *
+ * @example
+ * static uint8_t imu_regs[8];
+ * static I2C_Shadow imu;
+ *
+ * I2C_ShadowInit(&imu, 0x68, 0x19, imu_regs, sizeof(imu_regs), I2C_SHADOW_WRITE_BACK);
+ * I2C_ShadowLoad(&imu);                     // 1 burst อ่านทั้ง block
+ *
+ * I2C_ShadowModify(&imu, 0x1B, 0x18, 0x08); // gyro range: ไม่มี bus transaction
+ * I2C_ShadowModify(&imu, 0x1C, 0x18, 0x10); // accel range
+ * I2C_ShadowFlush(&imu);                    // เขียน 0x1B-0x1C ใน burst เดียว
+ *
+ * @note Flush ถือว่า device เพิ่ม register address อัตโนมัติ (auto-increment)
+ * @note Register นอกช่วงของ shadow ถูกส่งต่อไป SimpleI2C ตรงๆ
+ */
+
+#ifndef __SIMPLE_I2C_SHADOW_H
+#define __SIMPLE_I2C_SHADOW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleI2C.h"
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief จำนวน register สูงสุดต่อ shadow (bitmask 32-bit)
+ */
+#define I2C_SHADOW_MAX_REGS  32
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief วิธีเขียนของ shadow
+ */
+typedef enum {
+    I2C_SHADOW_WRITE_THROUGH = 0,  /**< เขียนลง device ทันที */
+    I2C_SHADOW_WRITE_BACK    = 1   /**< พักไว้จนกว่าจะ I2C_ShadowFlush() */
+} I2C_ShadowMode;
+
+/**
+ * @brief Shadow ของ register block 1 ช่วง
+ */
+typedef struct {
+    uint8_t addr;              /**< ที่อยู่ของ device (7-bit address) */
+    uint8_t first_reg;         /**< register แรกของ block */
+    uint8_t count;             /**< จำนวน registers (1-32) */
+    uint8_t mode;              /**< I2C_ShadowMode */
+    uint8_t* values;           /**< storage ของผู้เรียก [count] */
+    uint32_t valid;            /**< bit n = ทราบค่า values[n] (ตรงกับ device หรือรอ flush) */
+    uint32_t dirty;            /**< bit n = values[n] ยังไม่ได้เขียนลง device */
+    uint32_t volatile_mask;    /**< bit n = อ่านจาก bus เสมอ (status, data) */
+} I2C_Shadow;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่มต้น shadow (ยังไม่มี register ใดถูก cache)
+ * @param shadow shadow ที่ต้องการตั้งค่า
+ * @param addr ที่อยู่ของ device
+ * @param first_reg register แรกของ block
+ * @param storage buffer เก็บค่า register (ขนาด count bytes)
+ * @param count จำนวน registers (จำกัดที่ I2C_SHADOW_MAX_REGS)
+ * @param mode I2C_SHADOW_WRITE_THROUGH หรือ I2C_SHADOW_WRITE_BACK
+ */
+void I2C_ShadowInit(I2C_Shadow* shadow, uint8_t addr, uint8_t first_reg,
+                    uint8_t* storage, uint8_t count, I2C_ShadowMode mode);
+
+/**
+ * @brief กำหนดให้ register อ่านจาก bus ทุกครั้ง (ค่าที่ device เปลี่ยนเอง)
+ * @param shadow shadow
+ * @param reg register ในช่วงของ shadow
+ */
+void I2C_ShadowSetVolatile(I2C_Shadow* shadow, uint8_t reg);
+
+/**
+ * @brief อ่านทั้ง block จาก device ใน burst เดียว
+ * @return I2C_Status
+ *
+ * @note ค่าที่ยัง dirty ใน write-back ถูกเก็บไว้ (ไม่ถูกทับ)
+ */
+I2C_Status I2C_ShadowLoad(I2C_Shadow* shadow);
+
+/**
+ * @brief อ่าน register (จาก cache ถ้ามี ไม่งั้นจาก bus แล้ว cache ไว้)
+ * @param shadow shadow
+ * @param reg register
+ * @param value ค่าที่อ่านได้
+ * @return I2C_Status
+ */
+I2C_Status I2C_ShadowRead(I2C_Shadow* shadow, uint8_t reg, uint8_t* value);
+
+/**
+ * @brief เขียน register
+ * @param shadow shadow
+ * @param reg register
+ * @param value ค่าใหม่
+ * @return I2C_Status (write-back คืน I2C_OK ทันที)
+ *
+ * @note Write-through ข้ามการเขียนถ้าค่าใน cache เท่าเดิมอยู่แล้ว
+ */
+I2C_Status I2C_ShadowWrite(I2C_Shadow* shadow, uint8_t reg, uint8_t value);
+
+/**
+ * @brief Read-modify-write บางบิตของ register
+ * @param shadow shadow
+ * @param reg register
+ * @param mask บิตที่ต้องการเปลี่ยน
+ * @param value ค่าใหม่ของบิตใน mask
+ * @return I2C_Status
+ *
+ * @example
+ * // ตั้ง bit 3-4 ของ register 0x1B เป็น 01 โดยไม่แตะบิตอื่น
+ * I2C_ShadowModify(&imu, 0x1B, 0x18, 0x08);
+ */
+I2C_Status I2C_ShadowModify(I2C_Shadow* shadow, uint8_t reg, uint8_t mask, uint8_t value);
+
+/**
+ * @brief เขียน register ที่ dirty ลง device
+ * @return I2C_Status (error แรก, register ที่เขียนไม่สำเร็จยัง dirty)
+ *
+ * @note Register ที่ dirty ติดกันถูกรวมเป็น burst เดียว และช่องว่างของ
+ *       register ที่ valid ไม่ volatile ถูกเขียนซ้ำด้วยค่าเดิมเพื่อรวม burst
+ */
+I2C_Status I2C_ShadowFlush(I2C_Shadow* shadow);
+
+/**
+ * @brief ทิ้งค่าใน cache (เช่นหลัง device reset) รวมถึงค่าที่ยังไม่ flush
+ */
+void I2C_ShadowInvalidate(I2C_Shadow* shadow);
+
+/**
+ * @brief ตรวจสอบว่ามีค่าที่ยังไม่ได้เขียนลง device หรือไม่
+ * @return 1 = มี, 0 = ไม่มี
+ */
+uint8_t I2C_ShadowIsDirty(const I2C_Shadow* shadow);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_I2C_SHADOW_H
@@ -1,58 +1,129 @@
 /**
  * @file SimpleI2C_Soft.c
  * @brief Software I2C (Bit-bang) Implementation
+ * @version 1.1
+ * @date 2026-10-14
  */
 
 #include "SimpleI2C_Soft.h"
-#include "SimpleDelay.h"
+#if SIMPLE_SYSCLOCK_RETIME
+#include "SimpleSysClock.h"
+#endif
 
-/* ลำดับ Pin ส่วนตัว */
-static uint8_t _SCL_PIN;
-static uint8_t _SDA_PIN;
-static uint16_t _DELAY_US;
+/* ลำดับ Pin ส่วนตัว (resolve port/mask ครั้งเดียวตอน init) */
+static GPIO_TypeDef* _SCL_PORT;
+static GPIO_TypeDef* _SDA_PORT;
+static uint16_t _SCL_MASK;
+static uint16_t _SDA_MASK;
 
-/* Helper Macros */
-#define SCL_H()   digitalWrite(_SCL_PIN, HIGH)
-#define SCL_L()   digitalWrite(_SCL_PIN, LOW)
-#define SDA_H()   digitalWrite(_SDA_PIN, HIGH)
-#define SDA_L()   digitalWrite(_SDA_PIN, LOW)
-#define SDA_READ() digitalRead(_SDA_PIN)
+/* จำนวนรอบ delay loop ของแต่ละช่วง clock */
+static uint32_t _DELAY_LOW = 1;  // Delay_Spin(0) วน 2^32 รอบ
+static uint32_t _DELAY_HIGH = 1;
+static uint32_t _STRETCH_LIMIT;
+static uint8_t _TIMEOUT;
+static uint32_t _SPEED;  /* ความเร็วที่ init (คำนวณ delay ใหม่เมื่อ clock เปลี่ยน) */
+
+/* Helper Macros: เขียน/อ่าน register ตรง */
+#define SCL_H()    (_SCL_PORT->BSHR = _SCL_MASK)
+#define SCL_L()    (_SCL_PORT->BCR = _SCL_MASK)
+#define SDA_H()    (_SDA_PORT->BSHR = _SDA_MASK)
+#define SDA_L()    (_SDA_PORT->BCR = _SDA_MASK)
+#define SDA_READ() ((_SDA_PORT->INDR & _SDA_MASK) ? 1 : 0)
+#define SCL_READ() ((_SCL_PORT->INDR & _SCL_MASK) ? 1 : 0)
+
+/**
+ * @brief แปลงจำนวน cycles เป็นรอบ Delay_Spin (หัก overhead ของการสลับขา)
+ * @note อย่างน้อย 1 รอบ เพราะ Delay_Spin(0) วน 2^32 รอบ
+ */
+static uint32_t I2C_Soft_CyclesToLoops(uint32_t cycles) {
+    uint32_t loops = 0;
+    if (cycles > SIMPLE_I2C_SOFT_OVERHEAD_CYCLES) {
+        loops = (cycles - SIMPLE_I2C_SOFT_OVERHEAD_CYCLES) / SIMPLE_I2C_SOFT_LOOP_CYCLES;
+    }
+    return loops ? loops : 1;
+}
+
+/**
+ * @brief ปล่อย SCL แล้วรอจน SCL เป็น HIGH จริง (clock stretching)
+ */
+static inline __attribute__((always_inline)) void I2C_Soft_SclRelease(void) {
+    SCL_H();
+
+    if (!SCL_READ()) {
+        uint32_t limit = _STRETCH_LIMIT;
+        while (!SCL_READ()) {
+            if (--limit == 0) {
+                _TIMEOUT = 1;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief คำนวณรอบ delay จาก SystemCoreClock ปัจจุบันและ _SPEED
+ */
+static void I2C_Soft_SetTiming(void) {
+    // แบ่งคาบ: LOW 9/16, HIGH 7/16 (tLOW ต้องยาวกว่า tHIGH ตาม spec)
+    uint32_t period = SystemCoreClock / _SPEED;
+    uint32_t high = (period * 7) >> 4;
+
+    _DELAY_HIGH = I2C_Soft_CyclesToLoops(high);
+    _DELAY_LOW = I2C_Soft_CyclesToLoops(period - high);
+
+    // ~6 cycles ต่อรอบการ poll SCL
+    _STRETCH_LIMIT = (SystemCoreClock / 1000000) * SIMPLE_I2C_SOFT_STRETCH_US / 6 + 1;
+}
+
+#if SIMPLE_SYSCLOCK_RETIME
+static SysClock_Hook_t i2c_soft_sysclock_hook;
+
+static void I2C_Soft_SysClockChanged(SysClock_Phase phase, uint32_t old_hz, uint32_t new_hz) {
+    (void)old_hz;
+    (void)new_hz;
+    if (phase == SYSCLK_PHASE_POST) {
+        I2C_Soft_SetTiming();
+    }
+}
+#endif
 
 /**
  * @brief เริ่มต้น Software I2C
  */
 void I2C_Soft_Init(uint8_t scl_pin, uint8_t sda_pin, I2C_Soft_Speed speed) {
-    _SCL_PIN = scl_pin;
-    _SDA_PIN = sda_pin;
-    
-    // ตั้งค่า delay ตามความเร็วมาตรฐาน
-    if (speed == I2C_SOFT_400KHZ) {
-        _DELAY_US = 1; // ประมาณ 400kHz+ (ขึ้นกับ loop overhead)
-    } else {
-        _DELAY_US = 5; // ประมาณ 100kHz
-    }
+    _SCL_PORT = GPIO_PIN_PORT(scl_pin);
+    _SCL_MASK = GPIO_PIN_MASK(scl_pin);
+    _SDA_PORT = GPIO_PIN_PORT(sda_pin);
+    _SDA_MASK = GPIO_PIN_MASK(sda_pin);
+
+    _SPEED = (uint32_t)speed;
+    I2C_Soft_SetTiming();
+    _TIMEOUT = 0;
+#if SIMPLE_SYSCLOCK_RETIME
+    SysClock_AddHook(&i2c_soft_sysclock_hook, I2C_Soft_SysClockChanged);
+#endif
 
     // ตั้งค่าเป็น Open-Drain Output
-    pinMode(_SCL_PIN, PIN_MODE_OUTPUT_OD);
-    pinMode(_SDA_PIN, PIN_MODE_OUTPUT_OD);
+    pinMode(scl_pin, PIN_MODE_OUTPUT_OD);
+    pinMode(sda_pin, PIN_MODE_OUTPUT_OD);
 
     // Idle state
     SCL_H();
     SDA_H();
-    Delay_Us(_DELAY_US);
+    Delay_Spin(_DELAY_LOW);
 }
 
 /**
- * @brief สัญญาณ Start
+ * @brief สัญญาณ Start (หรือ repeated START)
  */
 void I2C_Soft_Start(void) {
     SDA_H();
-    SCL_H();
-    Delay_Us(_DELAY_US);
+    Delay_Spin(_DELAY_LOW);
+    I2C_Soft_SclRelease();
+    Delay_Spin(_DELAY_HIGH);
     SDA_L();
-    Delay_Us(_DELAY_US);
+    Delay_Spin(_DELAY_HIGH);
     SCL_L();
-    Delay_Us(_DELAY_US);
 }
 
 /**
@@ -60,10 +131,11 @@ void I2C_Soft_Start(void) {
  */
 void I2C_Soft_Stop(void) {
     SDA_L();
-    SCL_H();
-    Delay_Us(_DELAY_US);
+    Delay_Spin(_DELAY_LOW);
+    I2C_Soft_SclRelease();
+    Delay_Spin(_DELAY_HIGH);
     SDA_H();
-    Delay_Us(_DELAY_US);
+    Delay_Spin(_DELAY_LOW);
 }
 
 /**
@@ -71,25 +143,24 @@ void I2C_Soft_Stop(void) {
  * @return 0 = ACK, 1 = NACK
  */
 uint8_t I2C_Soft_WriteByte(uint8_t byte) {
-    uint8_t i;
-    for (i = 0; i < 8; i++) {
+    for (uint8_t i = 0; i < 8; i++) {
         if (byte & 0x80) SDA_H();
         else SDA_L();
         byte <<= 1;
-        Delay_Us(_DELAY_US);
-        SCL_H();
-        Delay_Us(_DELAY_US);
+        Delay_Spin(_DELAY_LOW);
+        I2C_Soft_SclRelease();
+        Delay_Spin(_DELAY_HIGH);
         SCL_L();
     }
-    
+
     // Check ACK
     SDA_H(); // Release SDA
-    Delay_Us(_DELAY_US);
-    SCL_H();
-    Delay_Us(_DELAY_US);
+    Delay_Spin(_DELAY_LOW);
+    I2C_Soft_SclRelease();
+    Delay_Spin(_DELAY_HIGH);
     uint8_t ack = SDA_READ();
     SCL_L();
-    
+
     return ack;
 }
 
@@ -97,25 +168,26 @@ uint8_t I2C_Soft_WriteByte(uint8_t byte) {
  * @brief อ่าน 1 Byte
  */
 uint8_t I2C_Soft_ReadByte(uint8_t ack) {
-    uint8_t i, byte = 0;
+    uint8_t byte = 0;
     SDA_H(); // Ensure SDA is high (input)
-    for (i = 0; i < 8; i++) {
+    for (uint8_t i = 0; i < 8; i++) {
         byte <<= 1;
-        SCL_H();
-        Delay_Us(_DELAY_US);
+        Delay_Spin(_DELAY_LOW);
+        I2C_Soft_SclRelease();
+        Delay_Spin(_DELAY_HIGH);
         if (SDA_READ()) byte |= 0x01;
         SCL_L();
-        Delay_Us(_DELAY_US);
     }
-    
+
     // Send ACK/NACK
     if (ack) SDA_L();
     else SDA_H();
-    SCL_H();
-    Delay_Us(_DELAY_US);
+    Delay_Spin(_DELAY_LOW);
+    I2C_Soft_SclRelease();
+    Delay_Spin(_DELAY_HIGH);
     SCL_L();
     SDA_H();
-    
+
     return byte;
 }
 
@@ -123,41 +195,43 @@ uint8_t I2C_Soft_ReadByte(uint8_t ack) {
  * @brief เขียนข้อมูล (ข้าม ACK ได้)
  */
 I2C_Soft_Status I2C_Soft_Write(uint8_t addr, uint8_t* data, uint16_t len, uint8_t ignore_ack) {
+    _TIMEOUT = 0;
     I2C_Soft_Start();
-    
+
     // Send Address + W
     if (I2C_Soft_WriteByte(addr << 1) && !ignore_ack) {
         I2C_Soft_Stop();
-        return I2C_SOFT_ERROR_NACK;
+        return _TIMEOUT ? I2C_SOFT_ERROR_TIMEOUT : I2C_SOFT_ERROR_NACK;
     }
-    
-    for (uint16_t i = 0; i < len; i++) {
+
+    for (uint16_t i = 0; i < len && !_TIMEOUT; i++) {
         if (I2C_Soft_WriteByte(data[i]) && !ignore_ack) {
             I2C_Soft_Stop();
-            return I2C_SOFT_ERROR_NACK;
+            return _TIMEOUT ? I2C_SOFT_ERROR_TIMEOUT : I2C_SOFT_ERROR_NACK;
         }
     }
-    
+
     I2C_Soft_Stop();
-    return I2C_SOFT_OK;
+    return _TIMEOUT ? I2C_SOFT_ERROR_TIMEOUT : I2C_SOFT_OK;
 }
 
 /**
  * @brief อ่านข้อมูล
  */
 I2C_Soft_Status I2C_Soft_Read(uint8_t addr, uint8_t* data, uint16_t len) {
+    _TIMEOUT = 0;
     I2C_Soft_Start();
-    
+
     // Send Address + R
     if (I2C_Soft_WriteByte((addr << 1) | 0x01)) {
         I2C_Soft_Stop();
-        return I2C_SOFT_ERROR_NACK;
+        return _TIMEOUT ? I2C_SOFT_ERROR_TIMEOUT : I2C_SOFT_ERROR_NACK;
     }
-    
-    for (uint16_t i = 0; i < len; i++) {
+
+    for (uint16_t i = 0; i < len && !_TIMEOUT; i++) {
         data[i] = I2C_Soft_ReadByte(i < (len - 1));
     }
-    
+
     I2C_Soft_Stop();
-    return I2C_SOFT_OK;
+    return _TIMEOUT ? I2C_SOFT_ERROR_TIMEOUT : I2C_SOFT_OK;
 }
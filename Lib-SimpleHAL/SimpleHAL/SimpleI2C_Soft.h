@@ -1,12 +1,24 @@
 /**
  * @file SimpleI2C_Soft.h
  * @brief Software I2C (Bit-bang) Library for CH32V003
- * @version 1.0
- * @date 2025-12-22
+ * @version 1.1
+ * @date 2026-10-14
  * 
  * @details
  * Library นี้ใช้เทคนิค Bit-bang เพื่อสร้างสัญญาณ I2C ผ่าน GPIO ทั่วไป
  * ออกแบบมาเพื่อใช้ทดสอบกับ Logic Analyzer โดยเฉพาะ (สามารถข้ามการเช็ค ACK ได้)
+ * และใช้เป็น I2C bus ที่สอง
+ * 
+ * **Timing:**
+ * - เขียน BSHR/BCR และอ่าน INDR ตรงจาก port/mask ที่ resolve ไว้ตอน init
+ * - Delay นับรอบจาก SystemCoreClock (LOW 9/16, HIGH 7/16 ของคาบ)
+ * - รองรับ clock stretching: หลังปล่อย SCL รอจน SCL เป็น HIGH จริง
+ * - 100 kHz, 400 kHz และ Fast-mode Plus 1 MHz (ที่ 48 MHz)
+ * 
+ * @note ถ้าวัดความเร็วจริงได้ต่างจากที่ตั้ง ปรับ SIMPLE_I2C_SOFT_LOOP_CYCLES
+ *       และ SIMPLE_I2C_SOFT_OVERHEAD_CYCLES ตาม logic analyzer
+ * @note SimpleHAL_SetSysClock() คำนวณ delay ใหม่ให้ ถ้าเปลี่ยน SystemCoreClock เองต้องเรียก
+ *       I2C_Soft_Init() ใหม่
  */
 
 #ifndef __SIMPLE_I2C_SOFT_H
@@ -17,14 +29,40 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+#include "SimpleHAL_Config.h"
 #include "SimpleGPIO.h"
+#include "SimpleDelay.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief จำนวน CPU cycles ต่อรอบของ Delay_Spin (addi + bnez จาก flash)
+ */
+#ifndef SIMPLE_I2C_SOFT_LOOP_CYCLES
+#define SIMPLE_I2C_SOFT_LOOP_CYCLES SIMPLE_DELAY_LOOP_CYCLES
+#endif
+
+/**
+ * @brief Cycles ที่ใช้ในการสลับขาและตรวจ SCL ต่อครึ่งคาบ (หักออกจาก delay)
+ */
+#ifndef SIMPLE_I2C_SOFT_OVERHEAD_CYCLES
+#define SIMPLE_I2C_SOFT_OVERHEAD_CYCLES 12
+#endif
+
+/**
+ * @brief เวลาสูงสุด (us) ที่ยอมให้ slave ยืด clock ก่อนถือว่า timeout
+ */
+#ifndef SIMPLE_I2C_SOFT_STRETCH_US
+#define SIMPLE_I2C_SOFT_STRETCH_US 1000
+#endif
 
 /**
  * @brief ความเร็ว Software I2C
  */
 typedef enum {
     I2C_SOFT_100KHZ = 100000,
-    I2C_SOFT_400KHZ = 400000
+    I2C_SOFT_400KHZ = 400000,
+    I2C_SOFT_1MHZ   = 1000000   /**< Fast-mode Plus (ต้องใช้ pull-up ~1kΩ) */
 } I2C_Soft_Speed;
 
 /**
@@ -33,14 +71,17 @@ typedef enum {
 typedef enum {
     I2C_SOFT_OK = 0,
     I2C_SOFT_ERROR_NACK = 1,
-    I2C_SOFT_ERROR_BUSY = 2
+    I2C_SOFT_ERROR_BUSY = 2,
+    I2C_SOFT_ERROR_TIMEOUT = 3   /**< Slave ยืด clock นานเกิน SIMPLE_I2C_SOFT_STRETCH_US */
 } I2C_Soft_Status;
 
 /**
  * @brief เริ่มต้น Software I2C
  * @param scl_pin Pin สำหรับ SCL
  * @param sda_pin Pin สำหรับ SDA
- * @param speed ความเร็วมาตรฐาน (I2C_SOFT_100KHZ, I2C_SOFT_400KHZ)
+ * @param speed ความเร็ว (I2C_SOFT_100KHZ, I2C_SOFT_400KHZ, I2C_SOFT_1MHZ)
+ *
+ * @note คำนวณ delay จาก SystemCoreClock ปัจจุบัน
  */
 void I2C_Soft_Init(uint8_t scl_pin, uint8_t sda_pin, I2C_Soft_Speed speed);
 
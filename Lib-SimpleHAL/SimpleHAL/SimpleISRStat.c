@@ -0,0 +1,160 @@
+/**
+ * @file SimpleISRStat.c
+ * @brief ISR Latency / Load Instrumentation Implementation
+ * @version 1.0
+ * @date 2026-10-15
+ */
+
+#include "SimpleISRStat.h"
+#include "SimpleGPIO.h"
+#include "SimpleDelay.h"
+#include "SimplePrintf.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ========== Private Variables ========== */
+
+static const char* const isr_stat_names[ISR_STAT_COUNT] = {
+    "SysTick", "EXTI", "TIM1_UP", "TIM1_CC", "TIM2",
+    "DMA_CH1", "DMA_CH2", "DMA_CH3", "DMA_CH4", "DMA_CH5", "DMA_CH6", "DMA_CH7",
+    "ADC", "USART", "I2C_EV", "I2C_ER", "PVD", "WWDG"
+};
+
+#if SIMPLE_ISR_STATS
+
+ISR_Stat isr_stats[ISR_STAT_COUNT];
+static uint32_t isr_stat_start_ms = 0;     // เริ่มช่วงวัด load
+
+#if SIMPLE_ISR_STATS_TRACE
+GPIO_TypeDef* isr_trace_port[ISR_STAT_COUNT];
+uint16_t isr_trace_mask[ISR_STAT_COUNT];
+#endif
+
+const uint16_t isrstat_ram_bytes = sizeof(isr_stats) + sizeof(isr_stat_start_ms)
+#if SIMPLE_ISR_STATS_TRACE
+                                   + sizeof(isr_trace_port) + sizeof(isr_trace_mask)
+#endif
+                                   ;
+
+/* ========== Public Functions ========== */
+
+void ISR_StatReset(void) {
+    // Handler ที่กำลังทำงานอาจเขียนทับกลางทาง: ปิด interrupt ระหว่างล้าง
+    __disable_irq();
+    memset(isr_stats, 0, sizeof(isr_stats));
+    isr_stat_start_ms = Get_CurrentMs();
+    __enable_irq();
+}
+
+const ISR_Stat* ISR_StatGet(ISR_StatId id) {
+    if (id >= ISR_STAT_COUNT) return NULL;
+    return &isr_stats[id];
+}
+
+uint16_t ISR_StatLoad_x100(ISR_StatId id) {
+    if (id >= ISR_STAT_COUNT) return 0;
+
+    uint32_t window_ms = Get_CurrentMs() - isr_stat_start_ms;
+    if (window_ms == 0) return 0;
+
+    uint64_t window = (uint64_t)window_ms * (SystemCoreClock / 1000);
+    uint64_t load = (uint64_t)isr_stats[id].exec_total * 10000 / window;
+    return load > 10000 ? 10000 : (uint16_t)load;
+}
+
+ISR_StatId ISR_StatWorst(void) {
+    ISR_StatId worst = ISR_STAT_COUNT;
+    uint32_t worst_exec = 0;
+
+    for (uint8_t i = 0; i < ISR_STAT_COUNT; i++) {
+        if (isr_stats[i].count && isr_stats[i].exec_max >= worst_exec) {
+            worst_exec = isr_stats[i].exec_max;
+            worst = (ISR_StatId)i;
+        }
+    }
+    return worst;
+}
+
+void ISR_StatSetTracePin(ISR_StatId id, uint8_t pin) {
+#if SIMPLE_ISR_STATS_TRACE
+    if (id >= ISR_STAT_COUNT) return;
+
+    if (pin == 0xFF) {
+        isr_trace_port[id] = NULL;
+        return;
+    }
+
+    digitalWrite(pin, LOW);
+    pinMode(pin, PIN_MODE_OUTPUT);
+    isr_trace_mask[id] = GPIO_PIN_MASK(pin);
+    isr_trace_port[id] = GPIO_PIN_PORT(pin);   // ตั้งหลัง mask: handler อ่าน port ก่อน
+#else
+    (void)id;
+    (void)pin;
+#endif
+}
+
+void ISR_StatReport(void) {
+    SimpleHAL_printf("ISR        count  lat_max lat_avg exec_max exec_avg  load%%\r\n");
+
+    for (uint8_t i = 0; i < ISR_STAT_COUNT; i++) {
+        // Snapshot: handler อาจเขียนระหว่างพิมพ์
+        __disable_irq();
+        ISR_Stat s = isr_stats[i];
+        __enable_irq();
+
+        if (s.count == 0) continue;
+
+        SimpleHAL_printf("%-8s %7u %8u %7u %8u %8u %6.2f\r\n",
+                         isr_stat_names[i], s.count, s.latency_max,
+                         s.latency_total / s.count, s.exec_max,
+                         s.exec_total / s.count, ISR_StatLoad_x100((ISR_StatId)i));
+    }
+
+    ISR_StatId worst = ISR_StatWorst();
+    if (worst == ISR_STAT_COUNT) {
+        SimpleHAL_printf("No interrupts recorded\r\n");
+        return;
+    }
+
+    uint32_t cycles = isr_stats[worst].exec_max;
+    SimpleHAL_printf("Worst-case blocker: %s (%u cycles = %u us)\r\n",
+                     isr_stat_names[worst], cycles,
+                     (uint32_t)((uint64_t)cycles * 1000000 / SystemCoreClock));
+}
+
+#else
+
+const uint16_t isrstat_ram_bytes = 0;
+
+void ISR_StatReset(void) {
+}
+
+const ISR_Stat* ISR_StatGet(ISR_StatId id) {
+    (void)id;
+    return NULL;
+}
+
+uint16_t ISR_StatLoad_x100(ISR_StatId id) {
+    (void)id;
+    return 0;
+}
+
+ISR_StatId ISR_StatWorst(void) {
+    return ISR_STAT_COUNT;
+}
+
+void ISR_StatSetTracePin(ISR_StatId id, uint8_t pin) {
+    (void)id;
+    (void)pin;
+}
+
+void ISR_StatReport(void) {
+    SimpleHAL_printf("ISR stats disabled (SIMPLE_ISR_STATS = 0)\r\n");
+}
+
+#endif  // SIMPLE_ISR_STATS
+
+const char* ISR_StatName(ISR_StatId id) {
+    return id < ISR_STAT_COUNT ? isr_stat_names[id] : "?";
+}
@@ -0,0 +1,234 @@
+/**
+ * @file SimpleISRStat.h
+ * @brief วัด latency, เวลาทำงาน และ load ของ interrupt handlers ใน SimpleHAL
+ * @version 1.0
+ * @date 2026-10-15
+ *
+ * @details
+ * Handlers ของ SimpleHAL (SysTick, EXTI, TIM1/TIM2, DMA, ADC, USART, I2C, PVD, WWDG)
+ * เรียก callback ของผู้ใช้ภายใน interrupt แต่ไม่มีทางรู้ว่าแต่ละตัวกินเวลาเท่าไร
+ * เมื่อเปิด SIMPLE_ISR_STATS ทุก handler บันทึกสถิติของตัวเองลงตาราง
+ *
+ * **สิ่งที่วัด (หน่วย CPU cycles จาก SysTick CNT ที่นับด้วย HCLK):**
+ * - count: จำนวนครั้งที่เข้า
+ * - exec: เวลาจากต้น handler ถึงท้าย (max และผลรวมสำหรับ avg/load)
+ * - latency: เวลาจาก event ของ hardware ถึงต้น handler เฉพาะ handler ที่รู้เวลาของ event
+ *   - SysTick: CNT ตอนเข้าเทียบกับ compare
+ *   - TIM1 update / TIM2 update: CNT ตอนเข้า × (PSC + 1) (counter นับขึ้นจาก 0)
+ *   - Handlers อื่นไม่มีเวลาอ้างอิง: latency = 0
+ *
+ * **Trace pin:** ISR_StatSetTracePin() ให้ขาเป็น HIGH ตลอดช่วงของ handler
+ * (เขียน BSHR/BCR ตรงๆ) ดู jitter และการซ้อนกันของ interrupts บน scope / logic analyzer
+ *
+ * **Report:** ISR_StatReport() พิมพ์ตารางและบอก handler ที่ exec max สูงสุด
+ * ซึ่งเป็นตัวกำหนด worst-case response ของ interrupt ที่ priority เท่ากันหรือต่ำกว่า
+ *
+ * @example
+ * // compile ด้วย -DSIMPLE_ISR_STATS=1
+ * ISR_StatSetTracePin(ISR_STAT_TIM2, PC3);
+ *
+ * while (1) {
+ *     if (ELAPSED_TIME(last, Get_CurrentMs()) >= 5000) {
+ *         last = Get_CurrentMs();
+ *         ISR_StatReport();
+ *         ISR_StatReset();
+ *     }
+ * }
+ *
+ * @note ปิดอยู่ (SIMPLE_ISR_STATS = 0) macros เป็นค่าว่าง handler ไม่มีต้นทุนเพิ่ม
+ * @note Interrupt ที่ซ้อน (preemption) ถูกนับรวมใน exec ของ handler ที่ถูกขัด
+ * @note ต้องเริ่ม SysTick (Timer_Init()) ก่อน มิฉะนั้น exec เป็น 0
+ */
+
+#ifndef __SIMPLE_ISR_STAT_H
+#define __SIMPLE_ISR_STAT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <ch32v00x.h>
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleDelay.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief 1 = เปิดการวัดใน handlers ทั้งหมด (default ปิด)
+ */
+#ifndef SIMPLE_ISR_STATS
+#define SIMPLE_ISR_STATS 0
+#endif
+
+/**
+ * @brief 1 = รองรับ trace pin (เพิ่ม 2 stores ต่อ handler และ 6 bytes RAM ต่อ handler)
+ */
+#ifndef SIMPLE_ISR_STATS_TRACE
+#define SIMPLE_ISR_STATS_TRACE 1
+#endif
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief Handlers ที่วัด
+ */
+typedef enum {
+    ISR_STAT_SYSTICK = 0,
+    ISR_STAT_EXTI,
+    ISR_STAT_TIM1_UP,
+    ISR_STAT_TIM1_CC,
+    ISR_STAT_TIM2,
+    ISR_STAT_DMA_CH1,
+    ISR_STAT_DMA_CH2,
+    ISR_STAT_DMA_CH3,
+    ISR_STAT_DMA_CH4,
+    ISR_STAT_DMA_CH5,
+    ISR_STAT_DMA_CH6,
+    ISR_STAT_DMA_CH7,
+    ISR_STAT_ADC,
+    ISR_STAT_USART,
+    ISR_STAT_I2C_EV,
+    ISR_STAT_I2C_ER,
+    ISR_STAT_PVD,
+    ISR_STAT_WWDG,
+    ISR_STAT_COUNT
+} ISR_StatId;
+
+/**
+ * @brief สถิติของ handler หนึ่งตัว (cycles)
+ */
+typedef struct {
+    uint32_t count;          /**< จำนวนครั้ง */
+    uint32_t exec_total;     /**< ผลรวม exec (wrap หลัง ~89 s ที่ load 100%) */
+    uint32_t exec_max;       /**< exec สูงสุด */
+    uint32_t latency_total;  /**< ผลรวม latency */
+    uint16_t latency_max;    /**< latency สูงสุด (ตันที่ 65535) */
+} ISR_Stat;
+
+/* ========== Instrumentation ========== */
+
+#if SIMPLE_ISR_STATS
+
+extern ISR_Stat isr_stats[ISR_STAT_COUNT];
+
+#if SIMPLE_ISR_STATS_TRACE
+extern GPIO_TypeDef* isr_trace_port[ISR_STAT_COUNT];
+extern uint16_t isr_trace_mask[ISR_STAT_COUNT];
+#endif
+
+/**
+ * @brief ต้น handler: trace pin HIGH, บันทึก latency และคืนเวลาเริ่ม
+ */
+static inline __attribute__((always_inline))
+uint32_t ISR_StatEnter(ISR_StatId id, uint32_t latency) {
+    uint32_t t0 = SysTick->CNT;
+#if SIMPLE_ISR_STATS_TRACE
+    if (isr_trace_port[id]) isr_trace_port[id]->BSHR = isr_trace_mask[id];
+#endif
+    ISR_Stat* s = &isr_stats[id];
+    s->latency_total += latency;
+    if (latency > s->latency_max) s->latency_max = latency > 0xFFFF ? 0xFFFF : (uint16_t)latency;
+    return t0;
+}
+
+/**
+ * @brief ท้าย handler: บันทึก exec และ trace pin LOW
+ */
+static inline __attribute__((always_inline))
+void ISR_StatExit(ISR_StatId id, uint32_t t0) {
+    uint32_t dt = SysTick->CNT - t0;
+#if !SIMPLE_DELAY_TICKLESS
+    // CNT ถูก reset ที่ compare (โหมด 1 ms) ระหว่าง handler (tickless: CNT นับอิสระ ลบตรงได้)
+    if ((int32_t)dt < 0) dt += SysTick->CMP;
+#endif
+
+    ISR_Stat* s = &isr_stats[id];
+    s->count++;
+    s->exec_total += dt;
+    if (dt > s->exec_max) s->exec_max = dt;
+#if SIMPLE_ISR_STATS_TRACE
+    if (isr_trace_port[id]) isr_trace_port[id]->BCR = isr_trace_mask[id];
+#endif
+}
+
+/**
+ * @brief ใส่ที่ต้น handler (latency ไม่ทราบ)
+ */
+#define ISR_STAT_ENTER(id)                   uint32_t isr_stat_t0 = ISR_StatEnter((id), 0)
+
+/**
+ * @brief ใส่ที่ต้น handler พร้อม latency (cycles จาก event ถึงตอนนี้)
+ */
+#define ISR_STAT_ENTER_LATENCY(id, cycles)   uint32_t isr_stat_t0 = ISR_StatEnter((id), (cycles))
+
+/**
+ * @brief ใส่ที่ท้าย handler (ทุกทางออก)
+ */
+#define ISR_STAT_EXIT(id)                    ISR_StatExit((id), isr_stat_t0)
+
+#else
+
+#define ISR_STAT_ENTER(id)                   do {} while (0)
+#define ISR_STAT_ENTER_LATENCY(id, cycles)   do {} while (0)
+#define ISR_STAT_EXIT(id)                    do {} while (0)
+
+#endif  // SIMPLE_ISR_STATS
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief ล้างสถิติทั้งหมดและเริ่มช่วงวัด load ใหม่
+ */
+void ISR_StatReset(void);
+
+/**
+ * @brief อ่านสถิติของ handler
+ * @return NULL ถ้า id ไม่ถูกต้องหรือ SIMPLE_ISR_STATS = 0
+ */
+const ISR_Stat* ISR_StatGet(ISR_StatId id);
+
+/**
+ * @brief ชื่อของ handler (สำหรับพิมพ์)
+ */
+const char* ISR_StatName(ISR_StatId id);
+
+/**
+ * @brief สัดส่วนเวลาที่ handler ใช้ตั้งแต่ ISR_StatReset() (× 100, เช่น 125 = 1.25%)
+ */
+uint16_t ISR_StatLoad_x100(ISR_StatId id);
+
+/**
+ * @brief Handler ที่ exec max สูงสุด (ตัวกำหนด worst-case response)
+ * @return ISR_STAT_COUNT ถ้ายังไม่มี handler ใดทำงาน
+ */
+ISR_StatId ISR_StatWorst(void);
+
+/**
+ * @brief ตั้งขาที่เป็น HIGH ระหว่าง handler (ตั้งเป็น output ให้)
+ * @param id handler
+ * @param pin ขา (เช่น PC3) หรือ 0xFF = ยกเลิก
+ *
+ * @note ไม่มีผลถ้า SIMPLE_ISR_STATS_TRACE = 0
+ */
+void ISR_StatSetTracePin(ISR_StatId id, uint8_t pin);
+
+/**
+ * @brief พิมพ์ตารางสถิติทาง SimpleHAL_printf
+ *
+ * @details ตัวอย่าง:
+ * ```
+ * ISR        count  lat_max lat_avg exec_max exec_avg  load%
+ * SysTick     5000       14       9      412      118   2.46
+ * TIM2         500      120      31     2210     1950   4.06
+ * Worst-case blocker: TIM2 (2210 cycles = 46 us)
+ * ```
+ * แสดงเฉพาะ handlers ที่ทำงานอย่างน้อยหนึ่งครั้ง
+ */
+void ISR_StatReport(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_ISR_STAT_H
@@ -14,6 +14,7 @@ extern "C" {
 #endif
 
 #include <ch32v00x.h>
+#include "SimpleHAL_Config.h"
 #include "ch32v00x_iwdg.h"
 
 /******************************************************************************/
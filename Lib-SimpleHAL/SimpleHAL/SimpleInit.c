@@ -0,0 +1,37 @@
+/**
+ * @file SimpleInit.c
+ * @brief Lazy On-demand Initialization Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include <ch32v00x.h>
+#include "SimpleInit.h"
+
+/* ========== Global Variables ========== */
+
+volatile uint32_t simple_init_done = 0;
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เรียก init function แล้วบันทึกว่า subsystem พร้อมใช้งาน
+ */
+void SimpleInit_Run(uint8_t id, void (*init)(void)) {
+    if (init) {
+        init();
+    }
+
+    __disable_irq();
+    simple_init_done |= (1UL << id);
+    __enable_irq();
+}
+
+/**
+ * @brief ล้างสถานะ init ของ subsystem
+ */
+void SimpleInit_Invalidate(uint8_t id) {
+    __disable_irq();
+    simple_init_done &= ~(1UL << id);
+    __enable_irq();
+}
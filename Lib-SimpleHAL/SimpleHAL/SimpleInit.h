@@ -0,0 +1,100 @@
+/**
+ * @file SimpleInit.h
+ * @brief Lazy On-demand Initialization สำหรับ SimpleHAL
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * Guard กลางสำหรับ init subsystem เมื่อถูกใช้ครั้งแรก แทน constructor
+ * และ flag `xxx_initialized` ที่แต่ละ module เคยมีเอง
+ *
+ * **หลักการ:**
+ * - ทุก subsystem มี 1 bit ใน simple_init_done
+ * - SimpleInit_Ensure() เป็น inline: ถ้า init แล้วเหลือแค่ load + branch
+ * - Startup (ก่อน main) ไม่มีงานใดๆ ของ SimpleHAL
+ *   ทำให้ boot หลัง standby wakeup เร็วที่สุด
+ *
+ * @example
+ * static void MySensor_HWInit(void) { ... }
+ *
+ * uint16_t MySensor_Read(void) {
+ *     SimpleInit_Ensure(SIMPLE_INIT_USER, MySensor_HWInit);
+ *     ...
+ * }
+ */
+
+#ifndef __SIMPLE_INIT_H
+#define __SIMPLE_INIT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Subsystem IDs ========== */
+
+/**
+ * @brief Subsystem ที่ init แบบ lazy
+ */
+typedef enum {
+    SIMPLE_INIT_DELAY = 0,   /**< SysTick timebase (SimpleDelay) */
+    SIMPLE_INIT_ADC,         /**< ADC สำหรับ analogRead() */
+    SIMPLE_INIT_FLASH,       /**< SimpleFlash */
+    SIMPLE_INIT_TIM_EXT,     /**< TIM2 1 kHz tick ของ Stopwatch/Countdown */
+    SIMPLE_INIT_USER = 16    /**< ID แรกสำหรับ application (16-31) */
+} SimpleInit_Id;
+
+/* ========== Internal State ========== */
+
+/**
+ * @brief Bitmask ของ subsystem ที่ init แล้ว (อย่าแก้โดยตรง)
+ */
+extern volatile uint32_t simple_init_done;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เรียก init function แล้วบันทึกว่า subsystem พร้อมใช้งาน
+ * @param id Subsystem ID
+ * @param init ฟังก์ชัน init (จะถูกเรียกทุกครั้งที่เรียก SimpleInit_Run)
+ *
+ * @note ใช้ใน public init function เช่น Timer_Init() ที่ต้อง init ใหม่เมื่อถูกเรียกตรงๆ
+ */
+void SimpleInit_Run(uint8_t id, void (*init)(void));
+
+/**
+ * @brief ล้างสถานะ init ให้ subsystem ถูก init ใหม่ในการใช้งานครั้งถัดไป
+ * @param id Subsystem ID
+ *
+ * @note ใช้เมื่อการตั้งค่าเดิมไม่ถูกต้องแล้ว เช่นหลังเปลี่ยน system clock
+ */
+void SimpleInit_Invalidate(uint8_t id);
+
+/**
+ * @brief Init subsystem ถ้ายังไม่เคย init (fast path: load + branch)
+ * @param id Subsystem ID
+ * @param init ฟังก์ชัน init
+ */
+static inline __attribute__((always_inline))
+void SimpleInit_Ensure(uint8_t id, void (*init)(void)) {
+    if (__builtin_expect(!(simple_init_done & (1UL << id)), 0)) {
+        SimpleInit_Run(id, init);
+    }
+}
+
+/**
+ * @brief ตรวจสอบว่า subsystem init แล้วหรือยัง
+ * @param id Subsystem ID
+ * @return 1 = init แล้ว, 0 = ยังไม่ได้ init
+ */
+static inline uint8_t SimpleInit_IsDone(uint8_t id) {
+    return (simple_init_done & (1UL << id)) ? 1 : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_INIT_H
@@ -0,0 +1,375 @@
+/**
+ * @file SimpleKV.c
+ * @brief Log-structured Key-Value Store Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleKV.h"
+#include "SimpleCRC.h"
+
+/* ========== Private Definitions ========== */
+
+#define KV_BASE         (FLASH_BASE_ADDRESS + SIMPLE_KV_PAGE_START * FLASH_PAGE_SIZE)
+#define KV_ERASED       0xFFFF
+#define KV_MAGIC        0x4B56      // "VK"
+#define KV_PAGE_HEADER  4           // [seq][magic]
+#define KV_REC_HEADER   4           // [key | len << 8][crc]
+#define KV_NONE         0xFFFF      // index: ไม่มีค่า
+
+#define KV_PAGE_ADDR(page)  (KV_BASE + (uint32_t)(page) * FLASH_PAGE_SIZE)
+#define KV_HW(addr)         (*(const volatile uint16_t*)(addr))
+#define KV_REC_SIZE(len)    (KV_REC_HEADER + (((len) + 1) & ~1))
+
+/* ========== Private Variables ========== */
+
+static uint16_t kv_index[SIMPLE_KV_MAX_KEYS];  // offset จาก KV_BASE ของ record ล่าสุด
+static uint8_t kv_head;         // page ที่กำลังเขียน
+static uint8_t kv_tail;         // page เก่าสุดใน log
+static uint8_t kv_used;         // pages ใน log (0 = ว่าง)
+static uint8_t kv_head_off;     // offset ถัดไปใน head page
+static uint16_t kv_seq;         // seq ของ head page
+static uint16_t kv_erases;
+static uint8_t kv_mounted = 0;
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief CRC ของ record (0xFFFF ถูกแทนด้วย 0 เพื่อแยกจาก half-word ที่ยังไม่เขียน)
+ */
+static uint16_t kv_record_crc(uint16_t header, const uint8_t* data, uint8_t len) {
+    uint8_t h[2] = {(uint8_t)header, (uint8_t)(header >> 8)};
+    uint16_t crc = CRC16_CCITTUpdate(CRC16_CCITT_INIT, h, 2);
+    crc = CRC16_CCITTUpdate(crc, data, len);
+    return (crc == KV_ERASED) ? 0 : crc;
+}
+
+static uint8_t kv_page_valid(uint8_t page) {
+    return KV_HW(KV_PAGE_ADDR(page) + 2) == KV_MAGIC;
+}
+
+static uint16_t kv_page_seq(uint8_t page) {
+    return KV_HW(KV_PAGE_ADDR(page));
+}
+
+static FlashStatus kv_program(uint32_t addr, uint16_t data) {
+    FLASH_Status status = Flash_ProgramHalfWordRaw(addr, data);
+    if (status != FLASH_COMPLETE) return FLASH_ERROR_WRITE;
+    if (KV_HW(addr) != data) return FLASH_ERROR_VERIFY;
+    return FLASH_OK;
+}
+
+/**
+ * @brief Erase page ถ้ายังมีข้อมูลอยู่
+ */
+static FlashStatus kv_erase(uint8_t page) {
+    uint32_t addr = KV_PAGE_ADDR(page);
+
+    for (uint8_t off = 0; off < FLASH_PAGE_SIZE; off += 2) {
+        if (KV_HW(addr + off) != KV_ERASED) {
+            kv_erases++;
+            return Flash_ErasePageAt(addr);  // fast erase 64 bytes
+        }
+    }
+    return FLASH_OK;
+}
+
+/**
+ * @brief เปิด page ถัดไปเป็น head (seq ก่อน magic: header ที่เขียนไม่จบไม่ valid)
+ */
+static FlashStatus kv_open_page(void) {
+    uint8_t page = (uint8_t)((kv_head + 1) % SIMPLE_KV_PAGE_COUNT);
+    uint16_t seq = (uint16_t)(kv_seq + 1);
+
+    FlashStatus status = kv_erase(page);
+    if (status != FLASH_OK) return status;
+
+    FLASH_Unlock();
+    status = kv_program(KV_PAGE_ADDR(page), seq);
+    if (status == FLASH_OK) {
+        status = kv_program(KV_PAGE_ADDR(page) + 2, KV_MAGIC);
+    }
+    FLASH_Lock();
+    if (status != FLASH_OK) return status;
+
+    if (kv_used == 0) kv_tail = page;
+    kv_head = page;
+    kv_head_off = KV_PAGE_HEADER;
+    kv_seq = seq;
+    kv_used++;
+    return FLASH_OK;
+}
+
+/**
+ * @brief เขียน record ที่ head (header, data แล้ว CRC เป็นลำดับสุดท้าย)
+ */
+static FlashStatus kv_append(uint8_t key, const uint8_t* data, uint8_t len) {
+    uint32_t addr = KV_PAGE_ADDR(kv_head) + kv_head_off;
+    uint16_t header = (uint16_t)(key | ((uint16_t)len << 8));
+    uint16_t crc = kv_record_crc(header, data, len);
+    FlashStatus status;
+
+    FLASH_Unlock();
+    status = kv_program(addr, header);
+    for (uint8_t i = 0; status == FLASH_OK && i < len; i += 2) {
+        uint16_t hw = data[i];
+        hw |= (i + 1 < len) ? (uint16_t)data[i + 1] << 8 : 0xFF00;
+        status = kv_program(addr + KV_REC_HEADER + i, hw);
+    }
+    if (status == FLASH_OK) {
+        status = kv_program(addr + 2, crc);
+    }
+    FLASH_Lock();
+
+    // ที่ถูกใช้แล้วแม้เขียนไม่สำเร็จ
+    kv_head_off = (uint8_t)(kv_head_off + KV_REC_SIZE(len));
+    if (status == FLASH_OK && key < SIMPLE_KV_MAX_KEYS) {
+        kv_index[key] = len ? (uint16_t)(addr - KV_BASE) : KV_NONE;
+    }
+    return status;
+}
+
+/**
+ * @brief ย้าย records ที่ยังใช้อยู่ของ tail ไป page ใหม่แล้ว erase tail
+ *
+ * @note kv_used == SIMPLE_KV_PAGE_COUNT หมายถึง GC ครั้งก่อนถูกขัดจังหวะ (ไฟดับ)
+ *       จึงย้ายต่อใน head เดิมโดยไม่เปิด page ใหม่
+ */
+static FlashStatus kv_reclaim(void) {
+    uint8_t old = kv_tail;
+    uint16_t base = (uint16_t)(old * FLASH_PAGE_SIZE);
+    FlashStatus status;
+
+    if (kv_used < SIMPLE_KV_PAGE_COUNT) {
+        status = kv_open_page();
+        if (status != FLASH_OK) return status;
+    }
+
+    for (uint8_t key = 0; key < SIMPLE_KV_MAX_KEYS; key++) {
+        uint16_t off = kv_index[key];
+        if (off == KV_NONE || off < base || off >= base + FLASH_PAGE_SIZE) continue;
+
+        const uint8_t* rec = (const uint8_t*)(KV_BASE + off);
+        if (kv_head_off + KV_REC_SIZE(rec[1]) > FLASH_PAGE_SIZE) {
+            return FLASH_ERROR_FULL;  // ไม่ erase: ค่ายังอยู่ใน page เก่า
+        }
+        status = kv_append(key, rec + KV_REC_HEADER, rec[1]);
+        if (status != FLASH_OK) return status;
+    }
+
+    // ไฟดับก่อนถึงตรงนี้: page เก่ายังอยู่ แต่สำเนาใน page ใหม่ถูก replay ทีหลังจึงชนะ
+    status = kv_erase(old);
+    if (status != FLASH_OK) return status;
+    kv_tail = (uint8_t)((old + 1) % SIMPLE_KV_PAGE_COUNT);
+    kv_used--;
+    return FLASH_OK;
+}
+
+/**
+ * @brief อ่าน records ของ page เข้า index
+ * @return offset หลัง record สุดท้าย
+ */
+static uint8_t kv_replay(uint8_t page) {
+    uint32_t addr = KV_PAGE_ADDR(page);
+    uint8_t off = KV_PAGE_HEADER;
+
+    while (off + KV_REC_HEADER <= FLASH_PAGE_SIZE) {
+        uint16_t header = KV_HW(addr + off);
+        if (header == KV_ERASED) break;
+
+        uint8_t key = (uint8_t)header;
+        uint8_t len = (uint8_t)(header >> 8);
+        if (len > KV_MAX_VALUE_SIZE || off + KV_REC_SIZE(len) > FLASH_PAGE_SIZE) {
+            return FLASH_PAGE_SIZE;  // header เสีย: ไม่เขียนต่อใน page นี้
+        }
+
+        const uint8_t* data = (const uint8_t*)(addr + off + KV_REC_HEADER);
+        if (key < SIMPLE_KV_MAX_KEYS && KV_HW(addr + off + 2) == kv_record_crc(header, data, len)) {
+            kv_index[key] = len ? (uint16_t)(addr + off - KV_BASE) : KV_NONE;
+        }
+        off = (uint8_t)(off + KV_REC_SIZE(len));
+    }
+    return off;
+}
+
+/**
+ * @brief KV pages ต้องอยู่ใน storage region ใต้ config/data pages (linker region เท่านั้น)
+ */
+static uint8_t kv_range_ok(void) {
+#if SIMPLE_FLASH_STORAGE_LINKER
+    return SIMPLE_KV_PAGE_START >= FLASH_STORAGE_PAGE_START &&
+           SIMPLE_KV_PAGE_START + SIMPLE_KV_PAGE_COUNT <= FLASH_CONFIG_PAGE;
+#else
+    return 1;
+#endif
+}
+
+static uint8_t kv_ensure_mounted(void) {
+    if (!kv_mounted) KV_Init();
+    return kv_mounted;
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief Mount store
+ */
+FlashStatus KV_Init(void) {
+    uint8_t head = 0xFF;
+
+    for (uint8_t key = 0; key < SIMPLE_KV_MAX_KEYS; key++) {
+        kv_index[key] = KV_NONE;
+    }
+    if (Flash_Init() != FLASH_OK || !kv_range_ok()) {
+        return FLASH_ERROR_RANGE;
+    }
+
+    // Head = page ที่ seq ใหม่สุด (เทียบแบบ wrap-safe)
+    for (uint8_t page = 0; page < SIMPLE_KV_PAGE_COUNT; page++) {
+        if (kv_page_valid(page) &&
+            (head == 0xFF || (int16_t)(kv_page_seq(page) - kv_page_seq(head)) > 0)) {
+            head = page;
+        }
+    }
+
+    kv_used = 0;
+    kv_seq = 0;
+    kv_head = SIMPLE_KV_PAGE_COUNT - 1;  // page ถัดไป = 0
+    kv_head_off = FLASH_PAGE_SIZE;
+    kv_tail = 0;
+
+    if (head != 0xFF) {
+        // ย้อนหา pages ที่ seq ต่อเนื่องกัน
+        uint8_t tail = head;
+        uint16_t seq = kv_page_seq(head);
+        kv_used = 1;
+        while (kv_used < SIMPLE_KV_PAGE_COUNT) {
+            uint8_t prev = (uint8_t)((tail + SIMPLE_KV_PAGE_COUNT - 1) % SIMPLE_KV_PAGE_COUNT);
+            if (!kv_page_valid(prev) || kv_page_seq(prev) != (uint16_t)(seq - 1)) break;
+            tail = prev;
+            seq--;
+            kv_used++;
+        }
+
+        uint8_t page = tail;
+        for (uint8_t i = 0; i < kv_used; i++) {
+            kv_head_off = kv_replay(page);
+            page = (uint8_t)((page + 1) % SIMPLE_KV_PAGE_COUNT);
+        }
+        kv_head = head;
+        kv_tail = tail;
+        kv_seq = kv_page_seq(head);
+    }
+
+    kv_mounted = 1;
+    if (kv_used == SIMPLE_KV_PAGE_COUNT) {
+        return kv_reclaim();  // ทำ GC ที่ค้างให้จบ
+    }
+    return FLASH_OK;
+}
+
+/**
+ * @brief อ่านค่าของ key
+ */
+uint8_t KV_Get(uint8_t key, void* buffer, uint8_t max_len) {
+    if (key >= SIMPLE_KV_MAX_KEYS) return 0;
+    kv_ensure_mounted();
+
+    uint16_t off = kv_index[key];
+    if (off == KV_NONE) return 0;
+
+    const uint8_t* rec = (const uint8_t*)(KV_BASE + off);
+    uint8_t len = rec[1];
+    if (buffer) {
+        memcpy(buffer, rec + KV_REC_HEADER, (len < max_len) ? len : max_len);
+    }
+    return len;
+}
+
+/**
+ * @brief บันทึกค่า
+ */
+FlashStatus KV_Set(uint8_t key, const void* data, uint8_t len) {
+    if (key >= SIMPLE_KV_MAX_KEYS || data == NULL || len == 0 || len > KV_MAX_VALUE_SIZE) {
+        return FLASH_ERROR_INVALID;
+    }
+    if (!kv_ensure_mounted()) return FLASH_ERROR_RANGE;
+
+    // ค่าเดิม: ไม่ต้องเขียน
+    uint16_t off = kv_index[key];
+    if (off != KV_NONE) {
+        const uint8_t* rec = (const uint8_t*)(KV_BASE + off);
+        if (rec[1] == len && memcmp(rec + KV_REC_HEADER, data, len) == 0) return FLASH_OK;
+    }
+
+    for (uint8_t attempt = 0; attempt <= SIMPLE_KV_PAGE_COUNT; attempt++) {
+        FlashStatus status;
+
+        if (kv_used && kv_head_off + KV_REC_SIZE(len) <= FLASH_PAGE_SIZE) {
+            return kv_append(key, (const uint8_t*)data, len);
+        }
+        if (kv_used < SIMPLE_KV_PAGE_COUNT - 1) {
+            status = kv_open_page();
+        } else {
+            status = kv_reclaim();  // ใช้ page สำรอง แล้วคืน page เก่าสุด
+        }
+        if (status != FLASH_OK) return status;
+    }
+    return FLASH_ERROR_FULL;
+}
+
+/**
+ * @brief ลบ key
+ */
+FlashStatus KV_Delete(uint8_t key) {
+    if (key >= SIMPLE_KV_MAX_KEYS) return FLASH_ERROR_INVALID;
+    if (!kv_ensure_mounted()) return FLASH_ERROR_RANGE;
+    if (kv_index[key] == KV_NONE) return FLASH_OK;
+
+    for (uint8_t attempt = 0; attempt <= SIMPLE_KV_PAGE_COUNT; attempt++) {
+        FlashStatus status;
+
+        if (kv_used && kv_head_off + KV_REC_HEADER <= FLASH_PAGE_SIZE) {
+            return kv_append(key, NULL, 0);
+        }
+        status = (kv_used < SIMPLE_KV_PAGE_COUNT - 1) ? kv_open_page() : kv_reclaim();
+        if (status != FLASH_OK) return status;
+    }
+    return FLASH_ERROR_FULL;
+}
+
+/**
+ * @brief ลบทุก key
+ */
+FlashStatus KV_Format(void) {
+    if (!kv_range_ok()) return FLASH_ERROR_RANGE;
+
+    for (uint8_t page = 0; page < SIMPLE_KV_PAGE_COUNT; page++) {
+        FlashStatus status = kv_erase(page);
+        if (status != FLASH_OK) return status;
+    }
+    return KV_Init();
+}
+
+/**
+ * @brief อ่านสถานะของ store
+ */
+void KV_GetStats(KV_Stats* stats) {
+    if (!stats) return;
+    kv_ensure_mounted();
+
+    stats->keys = 0;
+    stats->live_bytes = 0;
+    for (uint8_t key = 0; key < SIMPLE_KV_MAX_KEYS; key++) {
+        if (kv_index[key] != KV_NONE) {
+            const uint8_t* rec = (const uint8_t*)(KV_BASE + kv_index[key]);
+            stats->keys++;
+            stats->live_bytes += KV_REC_SIZE(rec[1]);
+        }
+    }
+    stats->pages_used = kv_used;
+    stats->free_bytes = (uint16_t)((SIMPLE_KV_PAGE_COUNT - 1 - kv_used) *
+                                   (FLASH_PAGE_SIZE - KV_PAGE_HEADER));
+    if (kv_used) stats->free_bytes += FLASH_PAGE_SIZE - kv_head_off;
+    stats->erases = kv_erases;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file SimpleKV.h
+ * @brief Log-structured Key-Value Store บน Flash ของ CH32V003 (wear leveling)
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * เก็บค่า config หลายตัวแบบ append-only ในช่วง pages ที่กำหนด
+ * การบันทึกค่าใหม่เป็นการเขียน record ต่อท้าย (half-words ต่อเนื่องใน unlock เดียว)
+ * ไม่ต้อง erase page ทุกครั้งเหมือน Flash_SaveConfig()
+ *
+ * **รูปแบบข้อมูล:**
+ * - Page: [seq][magic] ตามด้วย records, pages ต่อกันเป็น log วนรอบ (seq บอกลำดับ)
+ * - Record: [key | len << 8][CRC16][data (ปัดเป็นเลขคู่)]
+ * - CRC เขียนเป็นลำดับสุดท้าย: record ที่เขียนไม่จบ (ไฟดับ) ถูกข้ามตอน mount
+ * - len = 0 คือการลบ key (tombstone)
+ *
+ * **Garbage collection:**
+ * เมื่อ log เต็ม (เหลือ page ว่างสำรอง 1 page) จะย้ายเฉพาะ records ที่ยังใช้อยู่
+ * ของ page เก่าสุดไป page ใหม่แล้ว erase page เก่า จึง erase 1 ครั้งต่อ ~ (page / record) ครั้งที่บันทึก
+ * ไฟดับระหว่าง GC ไม่ทำให้ข้อมูลหาย (ค่าเดิมยังอยู่ใน page เก่าจนกว่าจะ erase)
+ *
+ * **RAM index:**
+ * ตำแหน่ง record ล่าสุดของแต่ละ key (2 bytes ต่อ key) สร้างตอน mount
+ * KV_Get() จึงอ่านตรงจาก flash โดยไม่ต้อง scan
+ *
+ * @example
+ * enum { KEY_BRIGHTNESS, KEY_CALIBRATION, KEY_BOOT_COUNT };
+ *
+ * uint32_t boots = 0;
+ * KV_Get(KEY_BOOT_COUNT, &boots, sizeof(boots));
+ * boots++;
+ * KV_Set(KEY_BOOT_COUNT, &boots, sizeof(boots));   // 8 bytes ต่อท้าย log ไม่มี erase
+ *
+ * @note Keys เป็นตัวเลข 0 - SIMPLE_KV_MAX_KEYS-1 (ใช้ enum)
+ * @note ค่ายาวสุด KV_MAX_VALUE_SIZE bytes (record ต้องอยู่ใน page เดียว)
+ * @note การเขียน/erase flash หยุด CPU ระหว่างทำงาน (ไม่ควรเรียกใน ISR)
+ */
+
+#ifndef __SIMPLE_KV_H
+#define __SIMPLE_KV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SimpleHAL_Config.h"
+#include "SimpleFlash.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief Page แรกของ KV store (ค่าเริ่มต้นอยู่ใต้ pages 254-255 ของ SimpleFlash)
+ * @note SIMPLE_FLASH_STORAGE_LINKER = 1: ค่าเริ่มต้นคือต้น storage region จาก linker script
+ */
+#ifndef SIMPLE_KV_PAGE_START
+#if SIMPLE_FLASH_STORAGE_LINKER
+#define SIMPLE_KV_PAGE_START FLASH_STORAGE_PAGE_START
+#else
+#define SIMPLE_KV_PAGE_START 246
+#endif
+#endif
+
+/**
+ * @brief จำนวน pages (>= 2, สำรองไว้ 1 page สำหรับ GC)
+ */
+#ifndef SIMPLE_KV_PAGE_COUNT
+#define SIMPLE_KV_PAGE_COUNT 8
+#endif
+
+/**
+ * @brief จำนวน keys (RAM index 2 bytes ต่อ key)
+ */
+#ifndef SIMPLE_KV_MAX_KEYS
+#define SIMPLE_KV_MAX_KEYS 16
+#endif
+
+#if SIMPLE_KV_PAGE_COUNT < 2
+#error "SIMPLE_KV_PAGE_COUNT must be >= 2"
+#endif
+
+#if !SIMPLE_FLASH_STORAGE_LINKER
+#if SIMPLE_KV_PAGE_START + SIMPLE_KV_PAGE_COUNT > FLASH_TOTAL_PAGES
+#error "SimpleKV: invalid page range"
+#endif
+#endif
+
+#if SIMPLE_KV_MAX_KEYS < 1 || SIMPLE_KV_MAX_KEYS > 255
+#error "SIMPLE_KV_MAX_KEYS must be 1-255"
+#endif
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief ขนาดค่าสูงสุดต่อ key (page - page header - record header)
+ */
+#define KV_MAX_VALUE_SIZE  (FLASH_PAGE_SIZE - 8)
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief สถานะของ store
+ */
+typedef struct {
+    uint8_t pages_used;    /**< pages ใน log */
+    uint8_t keys;          /**< keys ที่มีค่า */
+    uint16_t live_bytes;   /**< bytes ของ records ล่าสุด (รวม header) */
+    uint16_t free_bytes;   /**< ที่ว่างก่อนต้อง GC */
+    uint16_t erases;       /**< page erases ตั้งแต่ boot */
+} KV_Stats;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief Mount store: หา log และสร้าง RAM index (ทำ GC ที่ถูกขัดจังหวะให้จบ)
+ * @return FLASH_OK หรือ status ของการเขียน flash
+ * @return FLASH_ERROR_RANGE ถ้า pages ไม่อยู่ใน storage region ใต้ config/data pages
+ *         (SIMPLE_FLASH_STORAGE_LINKER = 1)
+ * @note ฟังก์ชันอื่นเรียกให้เองครั้งแรก เรียกซ้ำเพื่อ scan ใหม่
+ */
+FlashStatus KV_Init(void);
+
+/**
+ * @brief อ่านค่าของ key
+ * @param key 0 - SIMPLE_KV_MAX_KEYS-1
+ * @param buffer ปลายทาง (NULL = อ่านแค่ความยาว)
+ * @param max_len ขนาด buffer (ค่าที่ยาวกว่าถูกตัด)
+ * @return ความยาวของค่าที่เก็บไว้, 0 = ไม่มี key นี้
+ */
+uint8_t KV_Get(uint8_t key, void* buffer, uint8_t max_len);
+
+/**
+ * @brief บันทึกค่า (ไม่เขียนถ้าค่าเดิมเหมือนกัน)
+ * @param key 0 - SIMPLE_KV_MAX_KEYS-1
+ * @param data ข้อมูล
+ * @param len 1 - KV_MAX_VALUE_SIZE
+ * @return FLASH_OK, FLASH_ERROR_FULL ถ้า records ล่าสุดเต็มทุก page
+ */
+FlashStatus KV_Set(uint8_t key, const void* data, uint8_t len);
+
+/**
+ * @brief ลบ key
+ */
+FlashStatus KV_Delete(uint8_t key);
+
+/**
+ * @brief มีค่าของ key หรือไม่
+ */
+static inline bool KV_Exists(uint8_t key) {
+    return KV_Get(key, NULL, 0) != 0;
+}
+
+/**
+ * @brief ลบทุก key (erase ทุก page ของ store)
+ */
+FlashStatus KV_Format(void);
+
+/**
+ * @brief อ่านสถานะของ store
+ */
+void KV_GetStats(KV_Stats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_KV_H
@@ -0,0 +1,369 @@
+/**
+ * @file SimpleLogger.c
+ * @brief Append-only Ring Logger Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleLogger.h"
+#include "SimpleCRC.h"
+
+/* ========== Private Definitions ========== */
+
+#define LOGGER_BASE         (FLASH_BASE_ADDRESS + SIMPLE_LOGGER_PAGE_START * FLASH_PAGE_SIZE)
+#define LOGGER_N            SIMPLE_LOGGER_PAGE_COUNT
+#define LOGGER_ERASED       0xFFFF
+#define LOGGER_MAGIC        0x474C      // "LG"
+#define LOGGER_TAG          0x0000      // slot ถูกใช้แล้ว
+#define LOGGER_PAGE_HEADER  4           // [seq][magic]
+
+#define LOGGER_PAGE_ADDR(page)      (LOGGER_BASE + (uint32_t)(page) * FLASH_PAGE_SIZE)
+#define LOGGER_SLOT_ADDR(page, s)   (LOGGER_PAGE_ADDR(page) + LOGGER_PAGE_HEADER + (uint32_t)(s) * LOGGER_SLOT_SIZE)
+#define LOGGER_HW(addr)             (*(const volatile uint16_t*)(addr))
+
+#if SIMPLE_HAL_USE_KV
+// Pages ของ logger ทับ pages ของ SimpleKV หรือไม่
+#define LOGGER_OVERLAPS_KV \
+    ((SIMPLE_LOGGER_PAGE_START) < (SIMPLE_KV_PAGE_START) + SIMPLE_KV_PAGE_COUNT && \
+     (SIMPLE_KV_PAGE_START) < (SIMPLE_LOGGER_PAGE_START) + SIMPLE_LOGGER_PAGE_COUNT)
+
+#if !SIMPLE_FLASH_STORAGE_LINKER && LOGGER_OVERLAPS_KV
+#error "SimpleLogger: page range overlaps SimpleKV (set SIMPLE_LOGGER_PAGE_START)"
+#endif
+#endif
+
+/* ========== Private Variables ========== */
+
+static uint8_t logger_head = LOGGER_N - 1;  // page ที่กำลังเขียน
+static uint8_t logger_head_slot;            // slot ว่างถัดไปใน head
+static uint16_t logger_head_seq;
+static uint8_t logger_used;                 // pages ที่มีข้อมูล (0 = ว่าง)
+static uint8_t logger_ahead_ready;          // page ถัดจาก head ว่างแล้ว
+static uint8_t logger_mounted = 0;
+
+const uint16_t logger_ram_bytes = sizeof(logger_head) + sizeof(logger_head_slot) +
+                                  sizeof(logger_head_seq) + sizeof(logger_used) +
+                                  sizeof(logger_ahead_ready) + sizeof(logger_mounted);
+
+/* ========== Private Functions ========== */
+
+static uint8_t logger_page_valid(uint8_t page) {
+    return LOGGER_HW(LOGGER_PAGE_ADDR(page) + 2) == LOGGER_MAGIC;
+}
+
+static uint16_t logger_page_seq(uint8_t page) {
+    return LOGGER_HW(LOGGER_PAGE_ADDR(page));
+}
+
+static uint8_t logger_next(uint8_t page) {
+    return (page + 1 == LOGGER_N) ? 0 : (uint8_t)(page + 1);
+}
+
+/**
+ * @brief Page ที่อยู่ก่อนหน้า page ไป back pages (back < LOGGER_N, ไม่ใช้ %)
+ */
+static uint8_t logger_back(uint8_t page, uint8_t back) {
+    return (page >= back) ? (uint8_t)(page - back) : (uint8_t)(page + LOGGER_N - back);
+}
+
+/**
+ * @brief CRC ของข้อมูล (0xFFFF ถูกแทนด้วย 0 เพื่อแยกจาก half-word ที่ยังไม่เขียน)
+ */
+static uint16_t logger_crc(const void* data) {
+    uint16_t crc = CRC16_CCITT(data, SIMPLE_LOGGER_RECORD_SIZE);
+    return (crc == LOGGER_ERASED) ? 0 : crc;
+}
+
+static FlashStatus logger_program(uint32_t addr, uint16_t data) {
+    FLASH_Status status = Flash_ProgramHalfWordRaw(addr, data);
+    if (status != FLASH_COMPLETE) return FLASH_ERROR_WRITE;
+    if (LOGGER_HW(addr) != data) return FLASH_ERROR_VERIFY;
+    return FLASH_OK;
+}
+
+/**
+ * @brief Erase page ถ้ายังมีข้อมูลอยู่
+ */
+static FlashStatus logger_erase(uint8_t page) {
+    uint32_t addr = LOGGER_PAGE_ADDR(page);
+
+    for (uint8_t off = 0; off < FLASH_PAGE_SIZE; off += 2) {
+        if (LOGGER_HW(addr + off) != LOGGER_ERASED) {
+            return Flash_ErasePageAt(addr);  // fast erase 64 bytes
+        }
+    }
+    return FLASH_OK;
+}
+
+/**
+ * @brief Pages ต้องอยู่ใน storage region ใต้ config/data pages (linker region เท่านั้น)
+ */
+static uint8_t logger_range_ok(void) {
+#if SIMPLE_FLASH_STORAGE_LINKER
+    // ตำแหน่งมาจาก linker จึงตรวจการทับ SimpleKV ตอน runtime แทน #error
+#if SIMPLE_HAL_USE_KV
+    if (LOGGER_OVERLAPS_KV) return 0;
+#endif
+    return SIMPLE_LOGGER_PAGE_START >= FLASH_STORAGE_PAGE_START &&
+           SIMPLE_LOGGER_PAGE_START + SIMPLE_LOGGER_PAGE_COUNT <= FLASH_CONFIG_PAGE;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief หา head page (seq ใหม่สุด), 0xFF = ไม่มีข้อมูล
+ *
+ * @details Pages ที่ valid เรียงเป็นวง seq เพิ่มขึ้นทีละ 1 ตามด้วย pages ว่าง
+ * ถ้า page 0 valid: pages 0..head มี seq >= seq ของ page 0, หลัง head ไม่ใช่ → binary search
+ * ถ้า page 0 ว่างแต่ page สุดท้าย valid: head คือ page สุดท้าย
+ */
+static uint8_t logger_find_head(void) {
+    if (logger_page_valid(0)) {
+        uint16_t seq0 = logger_page_seq(0);
+        uint16_t lo = 0;            // เงื่อนไขจริง
+        uint16_t hi = LOGGER_N;     // เงื่อนไขเท็จ
+        while (hi - lo > 1) {
+            uint8_t mid = (uint8_t)((lo + hi) >> 1);
+            if (logger_page_valid(mid) && (int16_t)(logger_page_seq(mid) - seq0) >= 0) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        return (uint8_t)lo;
+    }
+
+    if (logger_page_valid(LOGGER_N - 1)) {
+        return LOGGER_N - 1;
+    }
+
+    // รูปแบบอื่น (pages ถูกแก้จากภายนอก): scan ทุก page
+    uint8_t head = 0xFF;
+    for (uint8_t page = 1; page < LOGGER_N - 1; page++) {
+        if (logger_page_valid(page) &&
+            (head == 0xFF || (int16_t)(logger_page_seq(page) - logger_page_seq(head)) > 0)) {
+            head = page;
+        }
+    }
+    return head;
+}
+
+/**
+ * @brief จำนวน pages ที่ seq ต่อเนื่องย้อนจาก head (binary search)
+ */
+static uint8_t logger_count_pages(void) {
+    uint16_t lo = 1;                // k = 0 (head) ต่อเนื่องเสมอ
+    uint16_t hi = LOGGER_N + 1;     // k = LOGGER_N เป็นไปไม่ได้
+    while (hi - lo > 1) {
+        uint8_t k = (uint8_t)((lo + hi) >> 1);
+        uint8_t page = logger_back(logger_head, (uint8_t)(k - 1));
+        if (logger_page_valid(page) && logger_page_seq(page) == (uint16_t)(logger_head_seq - (k - 1))) {
+            lo = k;
+        } else {
+            hi = k;
+        }
+    }
+    return (uint8_t)lo;
+}
+
+/**
+ * @brief Slot ว่างถัดไปใน head page (binary search บน tag)
+ */
+static uint8_t logger_find_slot(void) {
+    uint8_t lo = 0;
+    uint8_t hi = LOGGER_RECORDS_PER_PAGE;
+    while (lo < hi) {
+        uint8_t mid = (uint8_t)((lo + hi) >> 1);
+        if (LOGGER_HW(LOGGER_SLOT_ADDR(logger_head, mid)) != LOGGER_ERASED) {
+            lo = (uint8_t)(mid + 1);
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static uint8_t logger_ensure_mounted(void) {
+    if (!logger_mounted) Logger_Init();
+    return logger_mounted;
+}
+
+/**
+ * @brief เปิด page ถัดไปเป็น head (seq ก่อน magic: header ที่เขียนไม่จบไม่ valid)
+ */
+static FlashStatus logger_open_page(void) {
+    uint8_t page = logger_next(logger_head);
+    uint16_t seq = (uint16_t)(logger_head_seq + 1);
+
+    // ทิ้ง page เก่าสุด ถ้า Logger_Service() ยังไม่ได้ทำ
+    if (logger_used == LOGGER_N) logger_used--;
+
+    FlashStatus status = logger_ahead_ready ? FLASH_OK : logger_erase(page);
+    if (status != FLASH_OK) return status;
+
+    FLASH_Unlock();
+    status = logger_program(LOGGER_PAGE_ADDR(page), seq);
+    if (status == FLASH_OK) {
+        status = logger_program(LOGGER_PAGE_ADDR(page) + 2, LOGGER_MAGIC);
+    }
+    FLASH_Lock();
+
+    // Page นี้ใช้ไม่ได้แล้ว: erase ใหม่ครั้งหน้า
+    logger_ahead_ready = 0;
+    if (status != FLASH_OK) return status;
+
+    logger_head = page;
+    logger_head_slot = 0;
+    logger_head_seq = seq;
+    logger_used++;
+    return FLASH_OK;
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief Mount logger
+ */
+FlashStatus Logger_Init(void) {
+    logger_mounted = 0;
+    if (Flash_Init() != FLASH_OK || !logger_range_ok()) {
+        return FLASH_ERROR_RANGE;
+    }
+
+    logger_head = LOGGER_N - 1;  // page ถัดไป = 0
+    logger_head_slot = 0;
+    logger_head_seq = 0;
+    logger_used = 0;
+    logger_ahead_ready = 0;
+
+    uint8_t head = logger_find_head();
+    if (head != 0xFF) {
+        logger_head = head;
+        logger_head_seq = logger_page_seq(head);
+        logger_used = logger_count_pages();
+        logger_head_slot = logger_find_slot();
+    }
+
+    logger_mounted = 1;
+    return FLASH_OK;
+}
+
+/**
+ * @brief ต่อท้าย 1 record
+ */
+FlashStatus Logger_Append(const void* record) {
+    if (record == NULL) return FLASH_ERROR_INVALID;
+    if (!logger_ensure_mounted()) return FLASH_ERROR_RANGE;
+
+    if (logger_used == 0 || logger_head_slot >= LOGGER_RECORDS_PER_PAGE) {
+        FlashStatus status = logger_open_page();
+        if (status != FLASH_OK) return status;
+    }
+
+    const uint8_t* data = (const uint8_t*)record;
+    uint32_t addr = LOGGER_SLOT_ADDR(logger_head, logger_head_slot);
+    FlashStatus status;
+
+    // Tag → data → CRC (slot ที่ถูกใช้แล้วนับเสมอ แม้เขียนไม่สำเร็จ)
+    logger_head_slot++;
+    FLASH_Unlock();
+    status = logger_program(addr, LOGGER_TAG);
+    for (uint8_t i = 0; status == FLASH_OK && i < SIMPLE_LOGGER_RECORD_SIZE; i += 2) {
+        uint16_t hw = data[i];
+        hw |= (i + 1 < SIMPLE_LOGGER_RECORD_SIZE) ? (uint16_t)data[i + 1] << 8 : 0xFF00;
+        status = logger_program(addr + 2 + i, hw);
+    }
+    if (status == FLASH_OK) {
+        status = logger_program(addr + LOGGER_SLOT_SIZE - 2, logger_crc(data));
+    }
+    FLASH_Lock();
+
+    return status;
+}
+
+/**
+ * @brief Erase page ถัดจาก head ไว้ล่วงหน้า
+ */
+FlashStatus Logger_Service(void) {
+    if (!logger_mounted || logger_ahead_ready) return FLASH_OK;
+
+    // Logger เต็ม: page ถัดไปคือ page เก่าสุด
+    if (logger_used == LOGGER_N) logger_used--;
+
+    FlashStatus status = logger_erase(logger_next(logger_head));
+    if (status == FLASH_OK) logger_ahead_ready = 1;
+    return status;
+}
+
+/**
+ * @brief จำนวน records
+ */
+uint16_t Logger_Count(void) {
+    if (!logger_ensure_mounted() || logger_used == 0) return 0;
+    return (uint16_t)((logger_used - 1) * LOGGER_RECORDS_PER_PAGE + logger_head_slot);
+}
+
+/**
+ * @brief เริ่มอ่านจาก record เก่าสุด
+ */
+void Logger_ReadBegin(Logger_Cursor* cursor) {
+    if (cursor == NULL) return;
+    logger_ensure_mounted();
+
+    cursor->seq = (uint16_t)(logger_head_seq - (logger_used ? logger_used - 1 : 0));
+    cursor->slot = 0;
+    cursor->lost = 0;
+}
+
+/**
+ * @brief อ่าน record ถัดไป
+ */
+bool Logger_Read(Logger_Cursor* cursor, void* record) {
+    if (cursor == NULL || record == NULL || !logger_ensure_mounted()) return false;
+
+    while (logger_used) {
+        // Page ของ cursor ถูกทิ้งไปแล้ว: ข้ามไป page เก่าสุดที่เหลือ
+        uint16_t tail_seq = (uint16_t)(logger_head_seq - (logger_used - 1));
+        if ((int16_t)(cursor->seq - tail_seq) < 0) {
+            cursor->seq = tail_seq;
+            cursor->slot = 0;
+            cursor->lost = 1;
+        }
+
+        int16_t ahead = (int16_t)(logger_head_seq - cursor->seq);
+        if (ahead < 0) return false;  // cursor จากก่อน Logger_Clear()
+
+        uint8_t limit = (ahead == 0) ? logger_head_slot : LOGGER_RECORDS_PER_PAGE;
+        if (cursor->slot >= limit) {
+            if (ahead == 0) return false;
+            cursor->seq++;
+            cursor->slot = 0;
+            continue;
+        }
+
+        uint8_t page = logger_back(logger_head, (uint8_t)ahead);
+        uint32_t addr = LOGGER_SLOT_ADDR(page, cursor->slot);
+        cursor->slot++;
+
+        const uint8_t* data = (const uint8_t*)(addr + 2);
+        if (LOGGER_HW(addr + LOGGER_SLOT_SIZE - 2) == logger_crc(data)) {
+            memcpy(record, data, SIMPLE_LOGGER_RECORD_SIZE);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief ลบทุก record
+ */
+FlashStatus Logger_Clear(void) {
+    if (!logger_range_ok()) return FLASH_ERROR_RANGE;
+
+    for (uint8_t page = 0; page < LOGGER_N; page++) {
+        FlashStatus status = logger_erase(page);
+        if (status != FLASH_OK) return status;
+    }
+    return Logger_Init();
+}
@@ -0,0 +1,201 @@
+/**
+ * @file SimpleLogger.h
+ * @brief Append-only Ring Logger บน Flash ของ CH32V003 (sensor samples แบบ offline)
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * เก็บ records ขนาดคงที่ต่อท้ายกันในช่วง pages ที่กำหนดแบบวนรอบ
+ * เมื่อเต็มจะทิ้ง page เก่าสุด แล้วอ่านย้อนจากเก่าไปใหม่ด้วย cursor ตอน upload
+ *
+ * **รูปแบบข้อมูล:**
+ * - Page: [seq][magic] ตามด้วย LOGGER_RECORDS_PER_PAGE records (seq บอกลำดับ page)
+ * - Record: [tag][data (ปัดเป็นเลขคู่)][CRC16] เขียนด้วย half-word programming ใน unlock เดียว
+ * - Tag เขียนก่อน (slot ถูกใช้แล้ว), CRC เขียนท้ายสุด: record ที่ไฟดับระหว่างเขียนถูกข้ามตอนอ่าน
+ *
+ * **Recovery ตอน boot (O(log n)):**
+ * - Pages ที่มีข้อมูลเรียงต่อกันเป็นวง (seq เพิ่มทีละ 1): หา head page ด้วย binary search
+ * - จำนวน pages (tail) และ slot ว่างถัดไปใน head page หาด้วย binary search เช่นกัน
+ * - ถ้ารูปแบบผิดไปจากที่ logger เขียนเอง (เช่น page ถูกลบจากภายนอก) จะ scan ทุก page แทน
+ *
+ * **Erase-ahead:**
+ * เรียก Logger_Service() ใน main loop/idle เพื่อ erase page ถัดจาก head ไว้ล่วงหน้า
+ * Logger_Append() จึงเหลือแค่เขียน half-words (ไม่กี่ µs ต่อ half-word)
+ * ถ้าไม่เรียก page จะถูก erase ตอน append ที่ขึ้น page ใหม่แทน
+ *
+ * @example
+ * typedef struct { uint32_t time; int16_t temp; uint16_t light; } Sample;  // 8 bytes
+ *
+ * // compile ด้วย -DSIMPLE_LOGGER_RECORD_SIZE=8
+ * Logger_Init();
+ * Sample s = {Get_CurrentMs(), temp, light};
+ * Logger_Append(&s);
+ *
+ * // Upload
+ * Logger_Cursor cur;
+ * Logger_ReadBegin(&cur);
+ * while (Logger_Read(&cur, &s)) {
+ *     send_sample(&s);
+ * }
+ * Logger_Clear();
+ *
+ * @note ค่าเริ่มต้นใช้ pages 230-245 (1KB) ใต้ SimpleKV และ SimpleFlash: ต้องไม่ทับ code
+ * @note SIMPLE_FLASH_STORAGE_LINKER = 1: ค่าเริ่มต้นต่อท้าย pages ของ SimpleKV ใน storage region
+ * @note การเขียน/erase flash หยุด CPU ระหว่างทำงาน (ไม่ควรเรียกใน ISR)
+ */
+
+#ifndef __SIMPLE_LOGGER_H
+#define __SIMPLE_LOGGER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SimpleHAL_Config.h"
+#include "SimpleFlash.h"
+#if SIMPLE_HAL_USE_KV
+#include "SimpleKV.h"
+#endif
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief Page แรกของ logger
+ * @note SIMPLE_FLASH_STORAGE_LINKER = 1: ค่าเริ่มต้นคือ page ถัดจาก SimpleKV
+ *       (หรือต้น storage region เมื่อปิด SIMPLE_HAL_USE_KV)
+ * @note ต้องไม่ทับ pages ของ SimpleKV: ตรวจตอน compile (หรือใน Logger_Init() ในโหมด linker)
+ */
+#ifndef SIMPLE_LOGGER_PAGE_START
+#if SIMPLE_FLASH_STORAGE_LINKER && SIMPLE_HAL_USE_KV
+#define SIMPLE_LOGGER_PAGE_START (SIMPLE_KV_PAGE_START + SIMPLE_KV_PAGE_COUNT)
+#elif SIMPLE_FLASH_STORAGE_LINKER
+#define SIMPLE_LOGGER_PAGE_START FLASH_STORAGE_PAGE_START
+#else
+#define SIMPLE_LOGGER_PAGE_START 230
+#endif
+#endif
+
+/**
+ * @brief จำนวน pages (2-255)
+ * @note SIMPLE_FLASH_STORAGE_LINKER = 1: ค่าเริ่มต้น 4 pages ให้ KV 8 + logger 4
+ *       + brownout 1 + config/data 2 พอดี region 1KB ในตัวอย่างของ SimpleFlash.h
+ */
+#ifndef SIMPLE_LOGGER_PAGE_COUNT
+#if SIMPLE_FLASH_STORAGE_LINKER
+#define SIMPLE_LOGGER_PAGE_COUNT 4
+#else
+#define SIMPLE_LOGGER_PAGE_COUNT 16
+#endif
+#endif
+
+/**
+ * @brief ขนาดข้อมูลต่อ record (bytes, 1-56)
+ */
+#ifndef SIMPLE_LOGGER_RECORD_SIZE
+#define SIMPLE_LOGGER_RECORD_SIZE 8
+#endif
+
+#if SIMPLE_LOGGER_PAGE_COUNT < 2 || SIMPLE_LOGGER_PAGE_COUNT > 255
+#error "SIMPLE_LOGGER_PAGE_COUNT must be 2-255"
+#endif
+
+#if SIMPLE_LOGGER_RECORD_SIZE < 1 || SIMPLE_LOGGER_RECORD_SIZE > (FLASH_PAGE_SIZE - 8)
+#error "SIMPLE_LOGGER_RECORD_SIZE must be 1-56"
+#endif
+
+#if !SIMPLE_FLASH_STORAGE_LINKER
+#if SIMPLE_LOGGER_PAGE_START + SIMPLE_LOGGER_PAGE_COUNT > FLASH_TOTAL_PAGES
+#error "SimpleLogger: invalid page range"
+#endif
+#endif
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief ขนาด record บน flash: tag + data (ปัดเป็นเลขคู่) + CRC
+ */
+#define LOGGER_SLOT_SIZE         (4 + ((SIMPLE_LOGGER_RECORD_SIZE + 1) & ~1))
+
+/**
+ * @brief จำนวน records ต่อ page (หลัง page header 4 bytes)
+ */
+#define LOGGER_RECORDS_PER_PAGE  ((FLASH_PAGE_SIZE - 4) / LOGGER_SLOT_SIZE)
+
+/**
+ * @brief จำนวน records สูงสุดที่เก็บได้ (page ถัดจาก head อาจถูก erase ล่วงหน้า)
+ */
+#define LOGGER_CAPACITY          ((SIMPLE_LOGGER_PAGE_COUNT - 1) * LOGGER_RECORDS_PER_PAGE)
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief ตำแหน่งอ่าน (อ่านต่อได้เรื่อยๆ ขณะที่ยังมีการ append)
+ */
+typedef struct {
+    uint16_t seq;       /**< seq ของ page ที่อ่านอยู่ */
+    uint8_t slot;       /**< record ถัดไปใน page */
+    uint8_t lost;       /**< 1 = records ที่ยังไม่ได้อ่านถูกเขียนทับไปแล้ว */
+} Logger_Cursor;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief Mount logger: หา head/tail ด้วย binary search
+ * @return FLASH_OK, หรือ FLASH_ERROR_RANGE ถ้า pages ไม่อยู่ใน storage region
+ *         ใต้ config/data pages (SIMPLE_FLASH_STORAGE_LINKER = 1)
+ * @note ฟังก์ชันอื่นเรียกให้เองครั้งแรก
+ */
+FlashStatus Logger_Init(void);
+
+/**
+ * @brief ต่อท้าย 1 record
+ * @param record ข้อมูล SIMPLE_LOGGER_RECORD_SIZE bytes
+ * @return FLASH_OK ถ้าสำเร็จ
+ *
+ * @note เมื่อเต็ม page เก่าสุดถูกทิ้ง (LOGGER_RECORDS_PER_PAGE records)
+ * @note Slot ที่เขียนไม่สำเร็จถูกข้าม (ไม่เขียนซ้ำที่เดิม)
+ */
+FlashStatus Logger_Append(const void* record);
+
+/**
+ * @brief Erase page ถัดจาก head ไว้ล่วงหน้า (เรียกจาก main loop/idle)
+ * @return FLASH_OK ถ้าไม่มีอะไรต้องทำหรือ erase สำเร็จ
+ *
+ * @note ทำงานจริงครั้งเดียวต่อ page ที่เปิดใหม่ ที่เหลือคืนทันที
+ * @note ถ้า logger เต็ม page เก่าสุดจะถูกทิ้งตอนนี้ (เร็วกว่าการรอ append)
+ */
+FlashStatus Logger_Service(void);
+
+/**
+ * @brief จำนวน records ใน logger (รวม record ที่เขียนไม่จบ ถ้ามี)
+ */
+uint16_t Logger_Count(void);
+
+/**
+ * @brief เริ่มอ่านจาก record เก่าสุด
+ */
+void Logger_ReadBegin(Logger_Cursor* cursor);
+
+/**
+ * @brief อ่าน record ถัดไป (เก่าไปใหม่)
+ * @param cursor จาก Logger_ReadBegin()
+ * @param record ปลายทาง SIMPLE_LOGGER_RECORD_SIZE bytes
+ * @return true ถ้าได้ record, false ถ้าอ่านถึง record ล่าสุดแล้ว
+ *
+ * @note Records ที่ CRC ไม่ถูกต้องถูกข้าม
+ * @note ถ้า page ที่ cursor ชี้ถูกเขียนทับ จะกระโดดไป record เก่าสุดที่เหลือและตั้ง cursor->lost
+ * @note Append ต่อหลังจาก false แล้วเรียกอีกครั้งจะได้ record ใหม่ต่อ
+ */
+bool Logger_Read(Logger_Cursor* cursor, void* record);
+
+/**
+ * @brief ลบทุก record (erase pages ที่มีข้อมูล)
+ * @note เรียก Logger_ReadBegin() ใหม่หลัง clear
+ */
+FlashStatus Logger_Clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SIMPLE_LOGGER_H
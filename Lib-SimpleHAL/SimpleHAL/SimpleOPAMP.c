@@ -154,6 +154,7 @@ void OPAMP_SetChannels(OPAMP_Channel_Positive pos_channel,
 /*                              Utility Functions                             */
 /******************************************************************************/
 
+#if SIMPLE_OPAMP_FLOAT
 /**
  * @brief  Calculate gain for non-inverting amplifier
  * @note   Formula: Gain = 1 + (R2/R1)
@@ -189,6 +190,7 @@ uint32_t OPAMP_CalculateR2Inv(uint32_t r1, float desired_gain) {
     if(desired_gain < 0.0f) desired_gain = -desired_gain;  // Use absolute value
     return (uint32_t)(r1 * desired_gain);
 }
+#endif
 
 /**
  * @brief  Check if OPAMP is enabled
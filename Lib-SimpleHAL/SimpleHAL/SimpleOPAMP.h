@@ -51,6 +51,15 @@ extern "C" {
 
 #include "ch32v00x_opa.h"
 #include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/**
+ * @brief ฟังก์ชันคำนวณ gain/R2 แบบ float (0 = compile ออก)
+ * @note ค่าเริ่มต้นตาม SIMPLE_HAL_FLOAT (SimpleHAL_Config.h)
+ */
+#ifndef SIMPLE_OPAMP_FLOAT
+#define SIMPLE_OPAMP_FLOAT SIMPLE_HAL_FLOAT
+#endif
 
 /******************************************************************************/
 /*                              Mode Definitions                              */
@@ -255,6 +264,7 @@ void OPAMP_SetChannels(OPAMP_Channel_Positive pos_channel,
 /*                              Utility Functions                             */
 /******************************************************************************/
 
+#if SIMPLE_OPAMP_FLOAT
 /**
  * @brief  Calculate gain for non-inverting amplifier
  * @param  r1: Resistor to ground (Ω)
@@ -304,6 +314,7 @@ uint32_t OPAMP_CalculateR2NonInv(uint32_t r1, float desired_gain);
  *   uint32_t r2 = OPAMP_CalculateR2Inv(10000, 3);  // Returns 30000
  */
 uint32_t OPAMP_CalculateR2Inv(uint32_t r1, float desired_gain);
+#endif
 
 /**
  * @brief  Check if OPAMP is enabled
@@ -0,0 +1,178 @@
+/**
+ * @file SimpleOPAMP_Measure.c
+ * @brief OPAMP + ADC Auto-ranging Measurement Implementation
+ * @version 1.0
+ * @date 2026-10-15
+ */
+
+#include "SimpleOPAMP_Measure.h"
+#include <stddef.h>
+
+/* ========== Private Definitions ========== */
+
+#define MEASURE_RING_SIZE   (1u << SIMPLE_OPAMP_MEASURE_AVG_SHIFT)
+#define MEASURE_DMA_LENGTH  (SIMPLE_OPAMP_MEASURE_MAX_PATHS * 2 * 4)  // MAX_PATHS x 4 samples ต่อครึ่ง buffer
+
+#if SIMPLE_OPAMP_MEASURE_AVG_SHIFT > 8
+#error "SIMPLE_OPAMP_MEASURE_AVG_SHIFT must be 0-8"
+#endif
+
+/* ========== Private Variables ========== */
+
+static const OPAMP_MeasureConfig* measure_config = NULL;
+static int64_t measure_scale_q16[SIMPLE_OPAMP_MEASURE_MAX_PATHS];   // counts -> หน่วยผลลัพธ์ (Q16)
+static uint16_t measure_up_below[SIMPLE_OPAMP_MEASURE_MAX_PATHS];   // ต่ำกว่านี้ = เพิ่ม gain ได้
+static uint8_t measure_view_of[SIMPLE_OPAMP_MEASURE_MAX_PATHS];     // path -> index ของ view
+static uint8_t measure_active = 0;
+static uint16_t measure_settle_head = 0;   // view->head ที่ต้องถึงก่อนคืนค่า
+static uint16_t measure_scan_frames = 0;   // frames ต่อครึ่ง DMA buffer
+
+static ADC_Channel measure_channels[SIMPLE_OPAMP_MEASURE_MAX_PATHS];
+static ADC_ScanView measure_views[SIMPLE_OPAMP_MEASURE_MAX_PATHS];
+static uint16_t measure_rings[SIMPLE_OPAMP_MEASURE_MAX_PATHS][MEASURE_RING_SIZE];
+static uint16_t measure_dma[MEASURE_DMA_LENGTH];
+
+const uint16_t opamp_measure_ram_bytes = sizeof(measure_config) + sizeof(measure_scale_q16) +
+                                         sizeof(measure_up_below) + sizeof(measure_view_of) +
+                                         sizeof(measure_active) + sizeof(measure_settle_head) +
+                                         sizeof(measure_scan_frames) +
+                                         sizeof(measure_channels) + sizeof(measure_views) +
+                                         sizeof(measure_rings) + sizeof(measure_dma);
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief เลือก path: เขียน PSEL/NSEL และตั้งจุดที่ samples ของ path ใหม่เต็ม ring
+ */
+static void OPAMP_MeasureApply(uint8_t index) {
+    const OPAMP_MeasurePath* path = &measure_config->paths[index];
+    const ADC_ScanView* view = &measure_views[measure_view_of[index]];
+
+    measure_active = index;
+    OPAMP_SetChannels(path->pos, path->neg);
+
+    // ครึ่ง buffer ที่ DMA กำลังเติมอาจมี samples ของ path เดิมเต็มครึ่ง (เข้า ring ตอน HT/TC ถัดไป)
+    // +1: sample ที่กำลังแปลงอยู่ตอนสลับอาจตกไปอยู่ต้นครึ่งถัดไป
+    measure_settle_head = (uint16_t)(view->head + measure_scan_frames + MEASURE_RING_SIZE + 1);
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่มวัด
+ */
+uint8_t OPAMP_MeasureStart(const OPAMP_MeasureConfig* config) {
+    if (!config || !config->paths || config->unit_den == 0) return 0;
+    if (config->path_count == 0 || config->path_count > SIMPLE_OPAMP_MEASURE_MAX_PATHS) return 0;
+
+    OPAMP_MeasureStop();
+
+    uint8_t channel_count = 0;
+
+    for (uint8_t i = 0; i < config->path_count; i++) {
+        const OPAMP_MeasurePath* path = &config->paths[i];
+
+        if (path->gain_x100 == 0) return 0;
+        if (i > 0 && path->gain_x100 <= config->paths[i - 1].gain_x100) return 0;
+
+        // ADC channel เดียวกัน (เช่น output ของ OPAMP) ใช้ view ร่วมกัน
+        uint8_t v = 0;
+        while (v < channel_count && measure_channels[v] != path->adc) v++;
+        if (v == channel_count) {
+            measure_channels[channel_count++] = path->adc;
+        }
+        measure_view_of[i] = v;
+
+        // µV ต่อ count = vref_mv × 1000 / 1023 / (gain_x100 / 100)
+        measure_scale_q16[i] = ((int64_t)config->vref_mv * 100000 * config->unit_num * 65536) /
+                               ((int64_t)ADC_MAX_VALUE * path->gain_x100 * config->unit_den);
+
+        // Path ถัดไปไม่ saturate ถ้าค่านี้ × (gain ถัดไป / gain นี้) < SAT (hysteresis 1/8)
+        if (i > 0) {
+            measure_up_below[i - 1] = (uint16_t)(((uint32_t)SIMPLE_OPAMP_MEASURE_SAT *
+                                                  config->paths[i - 1].gain_x100 / path->gain_x100) * 7 / 8);
+        }
+    }
+    measure_up_below[config->path_count - 1] = 0;
+
+    for (uint8_t v = 0; v < channel_count; v++) {
+        ADC_ScanViewInit(&measure_views[v], measure_rings[v], SIMPLE_OPAMP_MEASURE_AVG_SHIFT);
+    }
+
+    measure_config = config;
+    // เหมือน ADC_StartScan(): ครึ่ง buffer ปัดลงให้มี frames ครบ
+    measure_scan_frames = (uint16_t)((MEASURE_DMA_LENGTH / 2) / channel_count);
+
+    // Gain ต่ำสุดก่อน: ไม่ saturate แน่นอนตอนเริ่ม
+    OPAMP_MeasureApply(0);
+    OPAMP_Enable();
+
+    ADC_SimpleInitChannels(measure_channels, channel_count);
+    if (!ADC_StartScan(measure_channels, channel_count, config->sample_rate_hz,
+                       measure_dma, MEASURE_DMA_LENGTH, measure_views)) {
+        measure_config = NULL;
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief หยุดวัด
+ */
+void OPAMP_MeasureStop(void) {
+    if (!measure_config) return;
+
+    ADC_StopSampling();
+    measure_config = NULL;
+}
+
+/**
+ * @brief อ่านค่าล่าสุดและเลื่อน gain ถ้าจำเป็น
+ */
+OPAMP_MeasureStatus OPAMP_MeasureRead(int32_t* value) {
+    if (!measure_config) return OPAMP_MEASURE_STOPPED;
+
+    uint8_t index = measure_active;
+    const ADC_ScanView* view = &measure_views[measure_view_of[index]];
+
+    // Ring ยังมี samples ของ path เดิมอยู่
+    if ((int16_t)(view->head - measure_settle_head) < 0) {
+        return OPAMP_MEASURE_SETTLING;
+    }
+
+    uint16_t counts = ADC_ScanAverage(view);
+    OPAMP_MeasureStatus status = OPAMP_MEASURE_OK;
+
+    if (counts >= SIMPLE_OPAMP_MEASURE_SAT) {
+        if (index > 0) {
+            OPAMP_MeasureApply(index - 1);
+            return OPAMP_MEASURE_SETTLING;
+        }
+        status = OPAMP_MEASURE_OVERRANGE;
+    } else if (counts < measure_up_below[index]) {
+        // ค่ายังใช้ได้ แต่ path ถัดไปละเอียดกว่า: เปลี่ยนสำหรับครั้งหน้า
+        OPAMP_MeasureApply(index + 1);
+    }
+
+    if (value) {
+        *value = (int32_t)(((int64_t)counts * measure_scale_q16[index]) >> 16);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Index ของ path ที่ใช้อยู่
+ */
+uint8_t OPAMP_MeasureActivePath(void) {
+    return measure_active;
+}
+
+/**
+ * @brief บังคับใช้ path
+ */
+void OPAMP_MeasureSelectPath(uint8_t index) {
+    if (!measure_config || index >= measure_config->path_count) return;
+    OPAMP_MeasureApply(index);
+}
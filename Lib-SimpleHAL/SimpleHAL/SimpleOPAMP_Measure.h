@@ -0,0 +1,156 @@
+/**
+ * @file SimpleOPAMP_Measure.h
+ * @brief Measurement channel แบบ auto-ranging: OPAMP gain paths + ADC scan (DMA)
+ * @version 1.0
+ * @date 2026-10-15
+ *
+ * @details
+ * บอร์ด current-sense / sensor front-end มักต่อ feedback network หลายชุดไว้ที่
+ * CHN0/CHN1 (และ input ที่ CHP0/CHP1) เพื่อเลือก gain module นี้รวมการเลือก path
+ * ของ OPAMP กับ ADC_StartScan() ที่สุ่มต่อเนื่องด้วย DMA แล้วเลื่อน gain ให้อัตโนมัติ
+ *
+ * **Gain paths:**
+ * - Path = (PSEL, NSEL, ADC channel, gain) เรียงจาก gain ต่ำ (ช่วงกว้าง) ไปสูง
+ * - ADC channel ปกติคือ output ของ OPAMP (ADC_CH_PD4) หรือขา input โดยตรง
+ *   (เช่น CHP0 = PA2 = ADC_CH_PA2) เป็น path gain 1 ที่ไม่ผ่าน OPAMP
+ * - เปลี่ยน path = เขียน PSEL/NSEL ใหม่เท่านั้น ADC/DMA/timer สุ่มต่อไม่ต้อง init ใหม่
+ *
+ * **Auto-ranging (ทำใน OPAMP_MeasureRead()):**
+ * - ค่าเฉลี่ย >= SIMPLE_OPAMP_MEASURE_SAT (saturate) -> ลด gain 1 ขั้น
+ * - ค่าเฉลี่ยต่ำพอที่ path ถัดไปยังไม่ saturate (มี hysteresis 1/8) -> เพิ่ม gain 1 ขั้น
+ * - หลังเปลี่ยน path รอให้ ring ของ view เต็มด้วย samples ใหม่ก่อนคืนค่า
+ *
+ * **หน่วยผลลัพธ์:** result = µV ที่ input × unit_num / unit_den (integer, ไม่ใช้ float)
+ * ทุก path ให้ผลในหน่วยเดียวกัน เช่น shunt 10 mΩ: mA = µV / 10 -> unit_num = 1, unit_den = 10
+ *
+ * @example
+ * // Shunt 10 mΩ ที่ PA2 (CHP0): ตรงเข้า ADC (1x), ผ่าน OPAMP 11x (CHN0), 101x (CHN1)
+ * static const OPAMP_MeasurePath paths[] = {
+ *     {OPAMP_CHP0, OPAMP_CHN0, ADC_CH_PA2, 100},     // bypass: ไม่ผ่าน OPAMP
+ *     {OPAMP_CHP0, OPAMP_CHN0, ADC_CH_PD4, 1100},    // 1 + 100k/10k
+ *     {OPAMP_CHP0, OPAMP_CHN1, ADC_CH_PD4, 10100},   // 1 + 1M/10k
+ * };
+ * static const OPAMP_MeasureConfig cfg = {paths, 3, 3300, 1, 10, 2000};
+ *
+ * OPAMP_MeasureStart(&cfg);
+ * while (1) {
+ *     int32_t ma;
+ *     if (OPAMP_MeasureRead(&ma) == OPAMP_MEASURE_OK) {
+ *         // ma: กระแส (mA) จาก path ที่ละเอียดที่สุดที่ไม่ saturate
+ *     }
+ * }
+ *
+ * @note รองรับ path แบบ non-inverting / follower / bypass (gain เป็นบวก)
+ * @note ใช้ ADC_StartScan() ของ SimpleADC (DMA_CH1 + SIMPLE_ADC_SAMPLING_TIMER)
+ *       ห้ามใช้ ADC_Read() หรือ sampling อื่นระหว่างวัด
+ */
+
+#ifndef __SIMPLE_OPAMP_MEASURE_H
+#define __SIMPLE_OPAMP_MEASURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SimpleHAL_Config.h"
+#include "SimpleOPAMP.h"
+#include "SimpleADC.h"
+#include <stdint.h>
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief จำนวน gain paths สูงสุด
+ */
+#ifndef SIMPLE_OPAMP_MEASURE_MAX_PATHS
+#define SIMPLE_OPAMP_MEASURE_MAX_PATHS 4
+#endif
+
+/**
+ * @brief log2 ของจำนวน samples ที่เฉลี่ยต่อผลลัพธ์ (ring ต่อ ADC channel)
+ */
+#ifndef SIMPLE_OPAMP_MEASURE_AVG_SHIFT
+#define SIMPLE_OPAMP_MEASURE_AVG_SHIFT 3
+#endif
+
+/**
+ * @brief ขีด saturate (ADC counts) เผื่อ output swing ของ OPAMP ที่ไม่ถึง rail
+ */
+#ifndef SIMPLE_OPAMP_MEASURE_SAT
+#define SIMPLE_OPAMP_MEASURE_SAT 1000
+#endif
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief Gain path หนึ่งชุด
+ */
+typedef struct {
+    OPAMP_Channel_Positive pos;   /**< PSEL ของ path นี้ */
+    OPAMP_Channel_Negative neg;   /**< NSEL (เลือก feedback network) */
+    ADC_Channel adc;              /**< ADC channel ที่อ่าน (ADC_CH_PD4 = output ของ OPAMP) */
+    uint16_t gain_x100;           /**< gain × 100 (100 = 1x) */
+} OPAMP_MeasurePath;
+
+/**
+ * @brief ค่าตั้งของ measurement channel
+ */
+typedef struct {
+    const OPAMP_MeasurePath* paths;  /**< paths เรียง gain จากต่ำไปสูง */
+    uint8_t path_count;              /**< 1 - SIMPLE_OPAMP_MEASURE_MAX_PATHS */
+    uint16_t vref_mv;                /**< แรงดันอ้างอิงของ ADC (VDD) */
+    int32_t unit_num;                /**< result = µV × unit_num / unit_den */
+    int32_t unit_den;
+    uint32_t sample_rate_hz;         /**< scans ต่อวินาที (ทุก ADC channel ต่อ scan) */
+} OPAMP_MeasureConfig;
+
+/**
+ * @brief สถานะของ OPAMP_MeasureRead()
+ */
+typedef enum {
+    OPAMP_MEASURE_OK = 0,      /**< ค่าใช้ได้ */
+    OPAMP_MEASURE_SETTLING,    /**< เพิ่งเปลี่ยน path หรือยังไม่มี samples (ไม่มีค่า) */
+    OPAMP_MEASURE_OVERRANGE,   /**< saturate ที่ gain ต่ำสุด (ค่าถูกตัด) */
+    OPAMP_MEASURE_STOPPED      /**< ยังไม่ได้ start */
+} OPAMP_MeasureStatus;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่มวัด: ตั้ง ADC pins, OPAMP ที่ path gain ต่ำสุด และ ADC scan (DMA)
+ * @param config ค่าตั้ง (ต้องคงอยู่ตลอดการวัด)
+ * @return 1 = สำเร็จ, 0 = parameter ผิด (paths ไม่เรียงตาม gain) หรือเริ่ม scan ไม่ได้
+ *
+ * @note คำนวณ scale ต่อ path ครั้งเดียวที่นี่ การอ่านแต่ละครั้งเหลือคูณ + shift
+ */
+uint8_t OPAMP_MeasureStart(const OPAMP_MeasureConfig* config);
+
+/**
+ * @brief หยุดวัด (หยุด ADC scan, OPAMP ยังเปิดอยู่)
+ */
+void OPAMP_MeasureStop(void);
+
+/**
+ * @brief อ่านค่าล่าสุด (ค่าเฉลี่ย) และเลื่อน gain ถ้าจำเป็น
+ * @param value ผลลัพธ์ในหน่วยของ config (เขียนเมื่อ OK หรือ OVERRANGE)
+ * @return OPAMP_MeasureStatus
+ *
+ * @note เรียกจาก main loop, ไม่บล็อก
+ */
+OPAMP_MeasureStatus OPAMP_MeasureRead(int32_t* value);
+
+/**
+ * @brief Index ของ path ที่ใช้อยู่
+ */
+uint8_t OPAMP_MeasureActivePath(void);
+
+/**
+ * @brief บังคับใช้ path (เช่นทดสอบ) auto-ranging ทำงานต่อจาก path นี้
+ */
+void OPAMP_MeasureSelectPath(uint8_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_OPAMP_MEASURE_H
@@ -1,12 +1,16 @@
 /**
  * @file SimplePWM.c
  * @brief Simple PWM Library Implementation
- * @version 1.0
- * @date 2025-12-21
+ * @version 1.5
+ * @date 2026-10-14
  */
 
 
 #include "SimplePWM.h"
+#include "SimpleClock.h"
+#if SIMPLE_SYSCLOCK_RETIME
+#include "SimpleSysClock.h"
+#endif
 
 
 /* ========== Internal Structures ========== */
@@ -41,8 +45,69 @@ static PWM_ChannelConfig_t pwm_channels[] = {
 
 #define PWM_CHANNEL_COUNT (sizeof(pwm_channels) / sizeof(PWM_ChannelConfig_t))
 
+/**
+ * @brief Clock ที่ SimplePWM ถืออยู่ (bitmask ของ Clock_Periph)
+ */
+static uint16_t pwm_clocks = 0;
+
+/**
+ * @brief Timer registers ตาม PWM_Timer
+ */
+static TIM_TypeDef* const pwm_timers[2] = {TIM1, TIM2};
+
+/**
+ * @brief ความลึกของ PWM_BeginUpdate() ที่ยังไม่ commit ต่อ timer
+ */
+static uint8_t pwm_update_depth[2] = {0, 0};
+
+/**
+ * @brief Pin ของ TIM1 complementary outputs (ไม่ remap)
+ */
+static const struct {
+    GPIO_TypeDef* port;
+    uint16_t pin;
+} pwm_n_pins[3] = {
+    {GPIOD, GPIO_Pin_0},  // CH1N - PD0
+    {GPIOA, GPIO_Pin_2},  // CH2N - PA2
+    {GPIOD, GPIO_Pin_1}   // CH3N - PD1 (SWIO)
+};
+
+/**
+ * @brief Channels ที่เปิด complementary output (bit = PWM1_CH1 - PWM1_CH3)
+ */
+static uint8_t pwm_complementary = 0;
+
+/**
+ * @brief Dead-time ล่าสุดจาก PWM_SetDeadTime() (0 = ไม่ได้ตั้ง)
+ */
+static uint16_t pwm_deadtime_ns = 0;
+
 /* ========== Internal Helper Functions ========== */
 
+#if SIMPLE_SYSCLOCK_RETIME
+static SysClock_Hook_t pwm_sysclock_hook;
+
+/**
+ * @brief SimpleHAL_SetSysClock(): ปรับ prescaler ของ timer ที่ใช้อยู่ (ความถี่และ duty เท่าเดิม)
+ *        และคำนวณ dead-time ใหม่ (DTG นับด้วย HCLK)
+ */
+static void PWM_SysClockChanged(SysClock_Phase phase, uint32_t old_hz, uint32_t new_hz) {
+    (void)old_hz;
+    (void)new_hz;
+    if (phase != SYSCLK_PHASE_POST) return;
+
+    if (pwm_clocks & (1u << CLOCK_TIM1)) {
+        SysClock_ScaleTimer(TIM1);
+        if (pwm_deadtime_ns) {
+            PWM_SetDeadTime(pwm_deadtime_ns);
+        }
+    }
+    if (pwm_clocks & (1u << CLOCK_TIM2)) {
+        SysClock_ScaleTimer(TIM2);
+    }
+}
+#endif
+
 /**
  * @brief ดึง channel config
  */
@@ -56,23 +121,17 @@ static PWM_ChannelConfig_t* getChannelConfig(PWM_Channel channel) {
  */
 static void enablePeripheralClocks(PWM_ChannelConfig_t* config) {
     // เปิด GPIO clock
-    if (config->gpio_port == GPIOA) {
-        RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);
-    } else if (config->gpio_port == GPIOC) {
-        RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC, ENABLE);
-    } else if (config->gpio_port == GPIOD) {
-        RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOD, ENABLE);
-    }
+    Clock_AcquireOnce(Clock_GPIOPeriph(config->gpio_port), &pwm_clocks);
     
-    // เปิด Timer clock
-    if (config->timer == TIM1) {
-        RCC_APB2PeriphClockCmd(RCC_APB2Periph_TIM1, ENABLE);
-    } else if (config->timer == TIM2) {
-        RCC_APB2PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
-    }
+    // เปิด Timer clock (TIM2 อยู่บน APB1)
+    Clock_AcquireOnce(config->timer == TIM1 ? CLOCK_TIM1 : CLOCK_TIM2, &pwm_clocks);
     
     // เปิด AFIO clock
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
+    Clock_AcquireOnce(CLOCK_AFIO, &pwm_clocks);
+    
+#if SIMPLE_SYSCLOCK_RETIME
+    SysClock_AddHook(&pwm_sysclock_hook, PWM_SysClockChanged);
+#endif
 }
 
 /**
@@ -92,18 +151,17 @@ static void configureGPIO(PWM_ChannelConfig_t* config) {
 static void calculatePWMParams(uint32_t frequency_hz, uint16_t* prescaler, uint16_t* period) {
     uint32_t ticks = SystemCoreClock / frequency_hz;
     
-    if (ticks <= 65536) {
-        *prescaler = 0;
-        *period = ticks - 1;
-    } else {
-        *prescaler = (ticks / 65536);
-        *period = (ticks / (*prescaler + 1)) - 1;
-        
-        while (*period > 65535) {
-            (*prescaler)++;
-            *period = (ticks / (*prescaler + 1)) - 1;
-        }
-    }
+    // prescaler ต่ำสุดที่ period ไม่เกิน 16 bits: ceil(ticks / 65536) - 1 (shift แทนการค้นหา)
+    uint32_t psc = (ticks - 1) >> 16;
+    *prescaler = (uint16_t)psc;
+    *period = (uint16_t)((psc ? ticks / (psc + 1) : ticks) - 1);
+}
+
+/**
+ * @brief Address ของ compare register ของ channel (CH1CVR - CH4CVR ต่อกัน)
+ */
+static inline volatile uint32_t* channelCCR(PWM_ChannelConfig_t* config, PWM_Channel channel) {
+    return &config->timer->CH1CVR + (channel & 0x03);
 }
 
 /**
@@ -280,10 +338,16 @@ void PWM_SetFrequency(PWM_Channel channel, uint32_t frequency_hz) {
     uint16_t prescaler, period;
     calculatePWMParams(frequency_hz, &prescaler, &period);
     
-    configureTimerBase(config->timer, prescaler, period);
+    // PSC และ ATRLR (ARPE) เป็น preload: โหลดพร้อม CCR ที่ขอบคาบเดียวกัน
+    // ไม่ใช้ TIM_TimeBaseInit() เพราะ UG รีเซ็ต counter กลางคาบ (runt pulse)
+    PWM_Timer timer = PWM_CHANNEL_TIMER(channel);
+    PWM_BeginUpdate(timer);
+    config->timer->PSC = prescaler;
+    config->timer->ATRLR = period;
     
     // Reset duty cycle
     PWM_SetDutyCycleRaw(channel, 0);
+    PWM_CommitUpdate(timer);
 }
 
 /**
@@ -294,6 +358,9 @@ void PWM_Start(PWM_Channel channel) {
     if (!config || !config->initialized) return;
     
     TIM_CCxCmd(config->timer, config->tim_channel, TIM_CCx_Enable);
+    if (pwm_complementary & (1u << channel)) {
+        TIM_CCxNCmd(TIM1, config->tim_channel, TIM_CCxN_Enable);
+    }
 }
 
 /**
@@ -304,6 +371,9 @@ void PWM_Stop(PWM_Channel channel) {
     if (!config || !config->initialized) return;
     
     TIM_CCxCmd(config->timer, config->tim_channel, TIM_CCx_Disable);
+    if (pwm_complementary & (1u << channel)) {
+        TIM_CCxNCmd(TIM1, config->tim_channel, TIM_CCxN_Disable);
+    }
 }
 
 /**
@@ -322,6 +392,297 @@ void PWM_Write(PWM_Channel channel, uint8_t value) {
     PWM_SetDutyCycle(channel, duty_percent);
 }
 
+/* ========== Synchronized Update ========== */
+
+/**
+ * @brief เริ่มชุดการแก้ที่ต้องออกพร้อมกัน
+ */
+void PWM_BeginUpdate(PWM_Timer timer) {
+    if (timer > PWM_TIMER_2) return;
+    
+    pwm_timers[timer]->CTLR1 |= TIM_UDIS;
+    pwm_update_depth[timer]++;
+}
+
+/**
+ * @brief ปล่อยค่าที่แก้ไว้ที่ขอบคาบถัดไป
+ */
+void PWM_CommitUpdate(PWM_Timer timer) {
+    if (timer > PWM_TIMER_2 || pwm_update_depth[timer] == 0) return;
+    if (--pwm_update_depth[timer]) return;
+    
+    TIM_TypeDef* tim = pwm_timers[timer];
+    tim->CTLR1 &= ~TIM_UDIS;
+    
+    // Counter หยุดอยู่: ไม่มีขอบคาบให้รอ โหลด preload ทันที
+    if (!(tim->CTLR1 & TIM_CEN)) {
+        tim->SWEVGR = TIM_UG;
+    }
+}
+
+/* ========== Fast Update ========== */
+
+/**
+ * @brief คำนวณ prescaler/period ครั้งเดียว
+ */
+void PWM_ComputeTimeBase(uint32_t frequency_hz, PWM_TimeBase* timebase) {
+    if (!timebase || frequency_hz == 0) return;
+    calculatePWMParams(frequency_hz, &timebase->prescaler, &timebase->period);
+}
+
+/**
+ * @brief เปลี่ยนความถี่ด้วยค่าที่คำนวณไว้แล้ว
+ */
+void PWM_SetTimeBase(PWM_Timer timer, const PWM_TimeBase* timebase) {
+    if (timer > PWM_TIMER_2 || !timebase) return;
+    
+    TIM_TypeDef* tim = pwm_timers[timer];
+    PWM_BeginUpdate(timer);
+    tim->PSC = timebase->prescaler;
+    tim->ATRLR = timebase->period;
+    PWM_CommitUpdate(timer);
+}
+
+/**
+ * @brief ตั้ง duty cycle แบบ Q16
+ */
+void PWM_SetDutyQ16(PWM_Channel channel, uint16_t duty_q16) {
+    if (channel >= PWM_CHANNEL_COUNT) return;
+    
+    PWM_ChannelConfig_t* config = &pwm_channels[channel];
+    
+    // (period + 1) × duty >> 16: 0xFFFF ให้ค่าเกิน period = high ตลอดคาบ
+    uint32_t span = (uint32_t)config->timer->ATRLR + 1;
+    uint32_t value = (duty_q16 == 0xFFFF) ? span : ((span * duty_q16) >> 16);
+    if (value > 0xFFFF) value = 0xFFFF;
+    
+    *channelCCR(config, channel) = value;
+}
+
+/* ========== Complementary Outputs (TIM1) ========== */
+
+/**
+ * @brief เริ่มต้น PWM แบบ complementary
+ */
+uint8_t PWM_InitComplementary(PWM_Channel channel, uint32_t frequency_hz, PWM_Alignment alignment) {
+    if (channel > PWM1_CH3) return 0;
+    
+    PWM_ChannelConfig_t* config = &pwm_channels[channel];
+    enablePeripheralClocks(config);
+    Clock_AcquireOnce(Clock_GPIOPeriph(pwm_n_pins[channel].port), &pwm_clocks);
+    
+    configureGPIO(config);
+    GPIO_InitTypeDef GPIO_InitStructure = {0};
+    GPIO_InitStructure.GPIO_Pin = pwm_n_pins[channel].pin;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_PP;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_30MHz;
+    GPIO_Init(pwm_n_pins[channel].port, &GPIO_InitStructure);
+    
+    // Center-aligned นับขึ้นและลง: 1 คาบ PWM = 2 × (ARR + 1) ticks
+    uint16_t prescaler, period;
+    calculatePWMParams(alignment == PWM_ALIGN_CENTER ? frequency_hz * 2 : frequency_hz,
+                       &prescaler, &period);
+    
+    // เปลี่ยน CMS ได้เฉพาะตอน counter หยุด
+    TIM_Cmd(TIM1, DISABLE);
+    configureTimerBase(TIM1, prescaler, period);
+    TIM_CounterModeConfig(TIM1, alignment == PWM_ALIGN_CENTER ?
+                          TIM_CounterMode_CenterAligned1 : TIM_CounterMode_Up);
+    configurePWMChannel(config, 0);
+    
+    // Idle level (OISx/OISxN = 0) = LOW ทั้งสองขา, OSSR/OSSI ขับขาไว้ขณะ MOE = 0
+    TIM1->CTLR2 &= ~(uint16_t)(0x0300u << (channel * 2));
+    TIM1->BDTR |= TIM_OSSR | TIM_OSSI;
+    pwm_complementary |= (uint8_t)(1u << channel);
+    
+    TIM_Cmd(TIM1, ENABLE);
+    TIM_CtrlPWMOutputs(TIM1, ENABLE);
+    
+    config->initialized = 1;
+    return 1;
+}
+
+/**
+ * @brief ตั้ง dead-time
+ */
+void PWM_SetDeadTime(uint16_t deadtime_ns) {
+    pwm_deadtime_ns = deadtime_ns;
+    uint32_t ticks = ((uint32_t)deadtime_ns * (SystemCoreClock / 1000000) + 999) / 1000;
+    uint8_t dtg;
+    
+    // DTG 4 ช่วง: ×1 (0-127), ×2 (128-254), ×8 (256-504), ×16 (512-1008) ticks
+    if (ticks <= 127) {
+        dtg = (uint8_t)ticks;
+    } else if (ticks <= 254) {
+        dtg = (uint8_t)(0x80 | (((ticks + 1) >> 1) - 64));
+    } else if (ticks <= 504) {
+        dtg = (uint8_t)(0xC0 | (((ticks + 7) >> 3) - 32));
+    } else if (ticks <= 1008) {
+        dtg = (uint8_t)(0xE0 | (((ticks + 15) >> 4) - 32));
+    } else {
+        dtg = 0xFF;
+    }
+    
+    TIM1->BDTR = (TIM1->BDTR & ~TIM_DTG) | dtg;
+}
+
+/**
+ * @brief ตั้งค่า hardware break
+ */
+void PWM_ConfigBreak(PWM_BreakInput input, uint8_t auto_restart) {
+    uint16_t bdtr = TIM1->BDTR & ~(TIM_BKE | TIM_BKP | TIM_AOE);
+    
+    if (input != PWM_BREAK_NONE) {
+        Clock_AcquireOnce(Clock_GPIOPeriph(GPIOC), &pwm_clocks);
+        
+        // Pull ไปฝั่ง inactive: สายหลุด = ไม่ break เอง
+        GPIO_InitTypeDef GPIO_InitStructure = {0};
+        GPIO_InitStructure.GPIO_Pin = GPIO_Pin_2;
+        GPIO_InitStructure.GPIO_Mode = (input == PWM_BREAK_ACTIVE_LOW) ? GPIO_Mode_IPU : GPIO_Mode_IPD;
+        GPIO_Init(GPIOC, &GPIO_InitStructure);
+        
+        bdtr |= TIM_BKE;
+        if (input == PWM_BREAK_ACTIVE_HIGH) bdtr |= TIM_BKP;
+    }
+    if (auto_restart) bdtr |= TIM_AOE;
+    
+    TIM1->BDTR = bdtr | TIM_OSSR | TIM_OSSI;
+    TIM1->INTFR = (uint16_t)~TIM_BIF;
+}
+
+/**
+ * @brief สั่ง break ด้วย software
+ */
+void PWM_Break(void) {
+    TIM1->SWEVGR = TIM_BG;
+}
+
+/**
+ * @brief ตรวจสอบสถานะ break
+ */
+uint8_t PWM_IsBroken(void) {
+    return (TIM1->BDTR & TIM_MOE) ? 0 : 1;
+}
+
+/**
+ * @brief เปิด output กลับหลัง break
+ */
+uint8_t PWM_ClearBreak(void) {
+    TIM1->INTFR = (uint16_t)~TIM_BIF;
+    TIM1->BDTR |= TIM_MOE;  // ไม่ติดถ้า BKIN ยัง active
+    return PWM_IsBroken() ? 0 : 1;
+}
+
+/* ========== One-Pulse ========== */
+
+/**
+ * @brief ตั้ง channel เป็น one-pulse
+ */
+uint8_t PWM_InitOnePulse(PWM_Channel channel, uint32_t delay_us, uint32_t width_us,
+                         PWM_PulseTrigger trigger) {
+    PWM_ChannelConfig_t* config = getChannelConfig(channel);
+    if (!config || width_us == 0) return 0;
+    
+    TIM_TypeDef* timer = config->timer;
+    uint8_t index = (uint8_t)(channel & 0x03);
+    uint8_t first = (uint8_t)(channel - index);  // CH1 ของ timer เดียวกัน
+    
+    // ขา trigger ต้องไม่ใช่ขา output
+    if ((trigger == PWM_TRIGGER_TI1 && index == 0) ||
+        (trigger == PWM_TRIGGER_TI2 && index == 1) ||
+        (trigger == PWM_TRIGGER_ETR && timer == TIM2 && index == 0)) {
+        return 0;
+    }
+    
+    enablePeripheralClocks(config);
+    configureGPIO(config);
+    
+    // Prescaler ต่ำสุดที่ delay + width พอดี 16 bits
+    uint32_t tick_per_us = SystemCoreClock / 1000000;
+    uint32_t delay = delay_us * tick_per_us;
+    uint32_t width = width_us * tick_per_us;
+    uint32_t psc = (delay + width - 1) >> 16;
+    delay /= psc + 1;
+    width /= psc + 1;
+    if (delay == 0) delay = 1;         // CCR = 0 ทำให้ output ค้าง HIGH หลัง pulse
+    if (width == 0) width = 1;
+    uint32_t period = delay + width - 1;
+    if (period > 0xFFFF) period = 0xFFFF;
+    
+    TIM_Cmd(timer, DISABLE);
+    configureTimerBase(timer, (uint16_t)psc, (uint16_t)period);
+    
+    // PWM mode 2: LOW ขณะ CNT < CCR, HIGH จน update แล้ว OPM หยุด counter ที่ 0
+    configurePWMChannel(config, (uint16_t)delay);
+    TIM_SelectOCxM(timer, config->tim_channel, TIM_OCMode_PWM2);
+    TIM_CCxCmd(timer, config->tim_channel, TIM_CCx_Enable);
+    TIM_SelectOnePulseMode(timer, TIM_OPMode_Single);
+    timer->SWEVGR = TIM_UG;  // โหลด CCR/ARR จาก preload ก่อน pulse แรก
+    timer->INTFR = (uint16_t)~TIM_IT_Update;
+    
+    if (trigger == PWM_TRIGGER_SOFTWARE) {
+        TIM_SelectSlaveMode(timer, 0);
+    } else {
+        GPIO_InitTypeDef GPIO_InitStructure = {0};
+        GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
+        uint16_t source;
+        
+        if (trigger == PWM_TRIGGER_ETR) {
+            GPIO_TypeDef* port = (timer == TIM1) ? GPIOC : GPIOD;
+            Clock_AcquireOnce(Clock_GPIOPeriph(port), &pwm_clocks);
+            GPIO_InitStructure.GPIO_Pin = (timer == TIM1) ? GPIO_Pin_5 : GPIO_Pin_4;
+            GPIO_Init(port, &GPIO_InitStructure);
+            TIM_ETRConfig(timer, TIM_ExtTRGPSC_OFF, TIM_ExtTRGPolarity_NonInverted, 0);
+            source = TIM_TS_ETRF;
+        } else {
+            PWM_ChannelConfig_t* input = &pwm_channels[first + (trigger - PWM_TRIGGER_TI1)];
+            Clock_AcquireOnce(Clock_GPIOPeriph(input->gpio_port), &pwm_clocks);
+            GPIO_InitStructure.GPIO_Pin = input->gpio_pin;
+            GPIO_Init(input->gpio_port, &GPIO_InitStructure);
+            
+            TIM_ICInitTypeDef TIM_ICInitStructure = {0};
+            TIM_ICInitStructure.TIM_Channel = input->tim_channel;
+            TIM_ICInitStructure.TIM_ICPolarity = TIM_ICPolarity_Rising;
+            TIM_ICInitStructure.TIM_ICSelection = TIM_ICSelection_DirectTI;
+            TIM_ICInitStructure.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+            TIM_ICInit(timer, &TIM_ICInitStructure);
+            source = (trigger == PWM_TRIGGER_TI1) ? TIM_TS_TI1FP1 : TIM_TS_TI2FP2;
+        }
+        
+        // Trigger mode: hardware ตั้ง CEN ที่ขอบ trigger
+        TIM_SelectInputTrigger(timer, source);
+        TIM_SelectSlaveMode(timer, TIM_SlaveMode_Trigger);
+    }
+    
+    if (timer == TIM1) {
+        TIM_CtrlPWMOutputs(TIM1, ENABLE);
+    }
+    
+    config->initialized = 1;
+    return 1;
+}
+
+/**
+ * @brief เริ่ม pulse ด้วย software
+ */
+uint8_t PWM_FirePulse(PWM_Channel channel) {
+    PWM_ChannelConfig_t* config = getChannelConfig(channel);
+    if (!config || (config->timer->CTLR1 & TIM_CEN)) return 0;
+    
+    config->timer->CTLR1 |= TIM_CEN;
+    return 1;
+}
+
+/**
+ * @brief ตรวจสอบว่า pulse กำลังทำงาน
+ */
+uint8_t PWM_PulseBusy(PWM_Channel channel) {
+    PWM_ChannelConfig_t* config = getChannelConfig(channel);
+    if (!config) return 0;
+    
+    return (config->timer->CTLR1 & TIM_CEN) ? 1 : 0;
+}
+
 /* ========== Advanced Functions ========== */
 
 /**
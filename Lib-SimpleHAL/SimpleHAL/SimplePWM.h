@@ -1,8 +1,8 @@
 /**
  * @file SimplePWM.h
  * @brief Simple PWM Library สำหรับ CH32V003 แบบ Arduino-style
- * @version 1.0
- * @date 2025-12-21
+ * @version 1.4
+ * @date 2026-10-14
  * 
  * @details
  * Library นี้ให้ API แบบ Arduino สำหรับการควบคุม PWM output
@@ -14,6 +14,11 @@
  * - ตั้งค่าความถี่ PWM
  * - รองรับ pin remapping
  * - Start/Stop PWM output
+ * - อัปเดตหลาย channels + ความถี่พร้อมกันที่ขอบคาบเดียว (PWM_BeginUpdate/CommitUpdate)
+ * - ตาราง prescaler/period ตอน compile (PWM_TIMEBASE) และ duty แบบ Q16 ไม่มีการหาร
+ * - TIM1 complementary outputs (CH1N-CH3N), dead-time, break input, center-aligned
+ * - One-pulse: pulse เดียวที่ delay/width แม่นยำ เริ่มด้วย software หรือ trigger input
+ * - ความถี่, duty และ dead-time คงเดิมหลัง SimpleHAL_SetSysClock()
  * 
  * **PWM Channels และ Pins:**
  * 
@@ -22,12 +27,14 @@
  * - PWM1_CH2: PA1
  * - PWM1_CH3: PC3
  * - PWM1_CH4: PC4
+ * - CH1N: PD0, CH2N: PA2, CH3N: PD1 (SWIO), BKIN: PC2, ETR: PC5
  * 
  * **TIM2 (Default pins):**
  * - PWM2_CH1: PD4
  * - PWM2_CH2: PD3
  * - PWM2_CH3: PC0
  * - PWM2_CH4: PD7
+ * - ETR: PD4 (ใช้ขาเดียวกับ CH1)
  * 
  * @example
  * // ตัวอย่างการใช้งาน
@@ -58,6 +65,16 @@ extern "C" {
 
 #include <ch32v00x.h>
 #include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief ความถี่ timer clock ตอน compile สำหรับ PWM_TIMEBASE() (ต้องตรงกับ SystemCoreClock)
+ */
+#ifndef SIMPLE_PWM_F_CPU
+#define SIMPLE_PWM_F_CPU 48000000UL
+#endif
 
 /* ========== PWM Channel Definitions ========== */
 
@@ -88,6 +105,55 @@ typedef enum {
     PWM_REMAP_FULL           /**< Full remap */
 } PWM_Remap;
 
+/**
+ * @brief Timer ของ PWM channels (สำหรับ PWM_BeginUpdate()/PWM_CommitUpdate())
+ */
+typedef enum {
+    PWM_TIMER_1 = 0,         /**< TIM1: PWM1_CH1 - PWM1_CH4 */
+    PWM_TIMER_2 = 1          /**< TIM2: PWM2_CH1 - PWM2_CH4 */
+} PWM_Timer;
+
+/**
+ * @brief Timer ของ PWM channel
+ */
+#define PWM_CHANNEL_TIMER(channel) \
+    ((PWM_Timer)((channel) >= PWM2_CH1 ? PWM_TIMER_2 : PWM_TIMER_1))
+
+/**
+ * @brief คู่ prescaler/period ที่คำนวณไว้ล่วงหน้า (PWM_TIMEBASE() หรือ PWM_ComputeTimeBase())
+ */
+typedef struct {
+    uint16_t prescaler;      /**< ค่า PSC */
+    uint16_t period;         /**< ค่า ATRLR */
+} PWM_TimeBase;
+
+/**
+ * @brief รูปแบบการนับของ timer
+ */
+typedef enum {
+    PWM_ALIGN_EDGE = 0,      /**< นับขึ้น (default) */
+    PWM_ALIGN_CENTER         /**< นับขึ้น-ลง: pulse อยู่กลางคาบ ripple ต่ำสำหรับ motor/bridge */
+} PWM_Alignment;
+
+/**
+ * @brief Break input (BKIN, PC2) ของ TIM1
+ */
+typedef enum {
+    PWM_BREAK_NONE = 0,      /**< ไม่ใช้ BKIN (ยังสั่ง PWM_Break() ได้) */
+    PWM_BREAK_ACTIVE_LOW,    /**< Break เมื่อ PC2 = LOW (pull-up ภายใน) */
+    PWM_BREAK_ACTIVE_HIGH    /**< Break เมื่อ PC2 = HIGH (pull-down ภายใน) */
+} PWM_BreakInput;
+
+/**
+ * @brief แหล่งเริ่ม pulse ของ one-pulse mode
+ */
+typedef enum {
+    PWM_TRIGGER_SOFTWARE = 0,  /**< เริ่มด้วย PWM_FirePulse() */
+    PWM_TRIGGER_TI1,           /**< ขอบขึ้นที่ขา CH1 ของ timer เดียวกัน */
+    PWM_TRIGGER_TI2,           /**< ขอบขึ้นที่ขา CH2 ของ timer เดียวกัน */
+    PWM_TRIGGER_ETR            /**< ขอบขึ้นที่ขา ETR (TIM1: PC5, TIM2: PD4) */
+} PWM_PulseTrigger;
+
 /* ========== Function Prototypes ========== */
 
 /**
@@ -150,6 +216,7 @@ void PWM_SetDutyCycleRaw(PWM_Channel channel, uint16_t duty_value);
  * 
  * @note จะรีเซ็ต duty cycle เป็น 0%
  * @note ถ้าใช้หลาย channels บน timer เดียวกัน ความถี่จะเปลี่ยนทุก channels
+ * @note เปลี่ยนที่ขอบคาบ (ไม่ reset counter) จึงไม่มี runt pulse
  * 
  * @example
  * PWM_SetFrequency(PWM1_CH1, 2000);  // เปลี่ยนเป็น 2 kHz
@@ -189,6 +256,184 @@ void PWM_Stop(PWM_Channel channel);
  */
 void PWM_Write(PWM_Channel channel, uint8_t value);
 
+/* ========== Synchronized Update ========== */
+
+/**
+ * @brief เริ่มชุดการแก้ duty/ความถี่ที่ต้องออกพร้อมกัน
+ * @param timer PWM_TIMER_1 หรือ PWM_TIMER_2
+ *
+ * @details ตั้ง UDIS ของ timer: CCR, ARR (preload) และ prescaler ที่เขียนหลังจากนี้
+ * ค้างอยู่ใน preload registers ไม่ถูกโหลดที่ขอบคาบจนกว่าจะ PWM_CommitUpdate()
+ *
+ * @note เรียกซ้อนกันได้ (commit จริงเมื่อครบทุกคู่)
+ * @note ระหว่าง begin/commit timer ไม่สร้าง update event (รวม DMA request และ
+ *       update interrupt) ควร commit ภายในไม่กี่คาบ
+ *
+ * @example
+ * // RGBW เปลี่ยนสีพร้อมกัน ไม่มีคาบที่เห็นสีผสมระหว่างทาง
+ * PWM_BeginUpdate(PWM_TIMER_1);
+ * PWM_SetDutyCycleRaw(PWM1_CH1, r);
+ * PWM_SetDutyCycleRaw(PWM1_CH2, g);
+ * PWM_SetDutyCycleRaw(PWM1_CH3, b);
+ * PWM_SetDutyCycleRaw(PWM1_CH4, w);
+ * PWM_CommitUpdate(PWM_TIMER_1);
+ */
+void PWM_BeginUpdate(PWM_Timer timer);
+
+/**
+ * @brief ปล่อยค่าที่แก้ไว้ให้ออกพร้อมกันที่ขอบคาบถัดไป
+ * @param timer PWM_TIMER_1 หรือ PWM_TIMER_2
+ *
+ * @note ถ้า counter หยุดอยู่ (ก่อน PWM_Init() เปิด timer) โหลดทันทีด้วย UG
+ */
+void PWM_CommitUpdate(PWM_Timer timer);
+
+/* ========== Fast Update ========== */
+
+/**
+ * @brief คำนวณ prescaler/period ของความถี่ครั้งเดียว (เช่นตอน init) เพื่อใช้ซ้ำ
+ * @param frequency_hz ความถี่ (Hz)
+ * @param timebase [out] ผลลัพธ์
+ *
+ * @note ใช้ SystemCoreClock ปัจจุบัน (ค่าคงที่ใช้ PWM_TIMEBASE() แทน)
+ */
+void PWM_ComputeTimeBase(uint32_t frequency_hz, PWM_TimeBase* timebase);
+
+/**
+ * @brief เปลี่ยนความถี่ด้วยค่าที่คำนวณไว้แล้ว (2 register stores ไม่มีการหาร)
+ * @param timer PWM_TIMER_1 หรือ PWM_TIMER_2
+ * @param timebase prescaler/period
+ *
+ * @note เปลี่ยนที่ขอบคาบถัดไปพร้อมกัน (ห่อด้วย PWM_BeginUpdate()/PWM_CommitUpdate())
+ * @note ไม่แตะ CCR: ตั้ง duty ใหม่ด้วย PWM_SetDutyQ16() ใน update เดียวกันถ้าต้องการ
+ *
+ * @example
+ * // Tone: ตารางโน้ตอยู่ใน flash ไม่มีการคำนวณตอนเล่น
+ * static const PWM_TimeBase notes[] = { PWM_TIMEBASE(262), PWM_TIMEBASE(294), PWM_TIMEBASE(330) };
+ *
+ * PWM_BeginUpdate(PWM_TIMER_1);
+ * PWM_SetTimeBase(PWM_TIMER_1, &notes[i]);
+ * PWM_SetDutyQ16(PWM1_CH1, 0x8000);  // 50%
+ * PWM_CommitUpdate(PWM_TIMER_1);
+ */
+void PWM_SetTimeBase(PWM_Timer timer, const PWM_TimeBase* timebase);
+
+/**
+ * @brief ตั้ง duty cycle แบบ Q16 (0x0000 = 0%, 0xFFFF = 100%)
+ * @param channel PWM channel
+ * @param duty_q16 สัดส่วน duty × 65536
+ *
+ * @note คิดจาก period ปัจจุบันของ timer: 1 multiply + shift ไม่มีการหาร
+ * @note ไม่ตรวจว่า channel init แล้ว (fast path)
+ */
+void PWM_SetDutyQ16(PWM_Channel channel, uint16_t duty_q16);
+
+/* ========== Complementary Outputs (TIM1) ========== */
+
+/**
+ * @brief เริ่มต้น PWM แบบ complementary (CHx + CHxN) สำหรับ half-bridge
+ * @param channel PWM1_CH1 - PWM1_CH3
+ * @param frequency_hz ความถี่ PWM (Hz) ทั้ง 2 alignment
+ * @param alignment PWM_ALIGN_EDGE หรือ PWM_ALIGN_CENTER
+ * @return 1 = สำเร็จ, 0 = channel ไม่มี complementary output
+ *
+ * @details CHxN เป็นสัญญาณกลับของ CHx โดยมี dead-time ทั้งสองขอบ
+ * เมื่อ break หรือ MOE = 0 ทั้งสองขาถูกขับไปที่ idle level (LOW) ทันที
+ *
+ * @note ใช้ pin default ของ TIM1 (ไม่ remap) และความถี่/alignment มีผลทั้ง TIM1
+ * @note CH3N (PD1) เป็นขา SWIO: ใช้ได้เมื่อไม่ต่อ debugger
+ * @note เรียก PWM_Start() เพื่อเปิดทั้งสองขา
+ *
+ * @example
+ * PWM_InitComplementary(PWM1_CH1, 20000, PWM_ALIGN_CENTER);
+ * PWM_SetDeadTime(500);                       // 500 ns
+ * PWM_ConfigBreak(PWM_BREAK_ACTIVE_LOW, 0);   // overcurrent comparator → PC2
+ * PWM_SetDutyQ16(PWM1_CH1, 0x4000);
+ * PWM_Start(PWM1_CH1);
+ */
+uint8_t PWM_InitComplementary(PWM_Channel channel, uint32_t frequency_hz, PWM_Alignment alignment);
+
+/**
+ * @brief ตั้ง dead-time ของ complementary outputs (ทุก channel ของ TIM1)
+ * @param deadtime_ns dead-time (ns) ปัดขึ้นตามความละเอียดของ DTG
+ *
+ * @note ที่ 48 MHz: ละเอียด 21 ns ถึง 2.6 us, หยาบขึ้นถึงสูงสุด ~21 us
+ */
+void PWM_SetDeadTime(uint16_t deadtime_ns);
+
+/**
+ * @brief ตั้งค่า hardware break (ดับ output โดยไม่ผ่าน CPU)
+ * @param input แหล่ง break จากขา BKIN (PC2)
+ * @param auto_restart 1 = เปิด output เองที่ update ถัดไปเมื่อ break หายไป
+ *                     0 = ค้างจนกว่าจะเรียก PWM_ClearBreak()
+ *
+ * @note CH32V003 ไม่มี comparator ภายใน และ PVD ไม่ได้ต่อเข้า BKIN ใน silicon:
+ *       ต่อ comparator ภายนอก (หรือ OPA output) เข้า PC2 หรือเรียก PWM_Break()
+ *       จาก PVD interrupt
+ */
+void PWM_ConfigBreak(PWM_BreakInput input, uint8_t auto_restart);
+
+/**
+ * @brief สั่ง break ด้วย software (เรียกจาก ISR ได้ เช่น PVD หรือ fault)
+ */
+void PWM_Break(void);
+
+/**
+ * @brief ตรวจสอบว่า output ถูกดับจาก break อยู่หรือไม่
+ * @return 1 = MOE ปิดอยู่
+ */
+uint8_t PWM_IsBroken(void);
+
+/**
+ * @brief เปิด output กลับหลัง break
+ * @return 1 = เปิดแล้ว, 0 = break ยัง active อยู่
+ */
+uint8_t PWM_ClearBreak(void);
+
+/* ========== One-Pulse ========== */
+
+/**
+ * @brief ตั้ง channel เป็น one-pulse: LOW → รอ delay → HIGH นาน width → LOW
+ * @param channel PWM channel ที่ออก pulse
+ * @param delay_us เวลาจาก trigger ถึงขอบขึ้นของ pulse (us)
+ * @param width_us ความกว้าง pulse (us)
+ * @param trigger แหล่งเริ่ม pulse
+ * @return 1 = สำเร็จ, 0 = channel ชนกับขา trigger หรือเวลาเป็น 0
+ *
+ * @details Hardware นับ delay และ width เอง: jitter เทียบกับขอบ trigger
+ * ไม่เกิน 1 tick ของ timer (ไม่ขึ้นกับ interrupt) และ trigger ใหม่ระหว่าง
+ * pulse ถูกข้ามจนกว่า pulse จะจบ
+ *
+ * @note ความละเอียด = (prescaler + 1) / SystemCoreClock แบบเดียวกับ PWM_Init:
+ *       1 tick (20.8 ns) ถ้า delay + width ≤ 1365 us ที่ 48 MHz
+ * @note Delay ต่ำสุด 1 tick (+ ~2-3 ticks resync ของ trigger input)
+ * @note ใช้ timer ทั้งตัว: channel อื่นของ timer เดียวกันใช้ PWM ปกติไม่ได้
+ * @note EXTI pin ไม่ต่อเข้า timer trigger ใน silicon: เรียก PWM_FirePulse()
+ *       จาก EXTI callback แทน (jitter = interrupt latency)
+ *
+ * @example
+ * // HC-SR04 trigger: pulse 10 us ทุกครั้งที่เรียก
+ * PWM_InitOnePulse(PWM1_CH4, 0, 10, PWM_TRIGGER_SOFTWARE);
+ * PWM_FirePulse(PWM1_CH4);
+ *
+ * // Camera strobe: 250 us หลังขอบขึ้นที่ PD4 (TIM2 CH1) กว้าง 100 us บน PD3
+ * PWM_InitOnePulse(PWM2_CH2, 250, 100, PWM_TRIGGER_TI1);
+ */
+uint8_t PWM_InitOnePulse(PWM_Channel channel, uint32_t delay_us, uint32_t width_us,
+                         PWM_PulseTrigger trigger);
+
+/**
+ * @brief เริ่ม pulse ด้วย software (เรียกจาก ISR ได้)
+ * @return 1 = เริ่มแล้ว, 0 = pulse ก่อนหน้ายังไม่จบ
+ */
+uint8_t PWM_FirePulse(PWM_Channel channel);
+
+/**
+ * @brief ตรวจสอบว่า pulse กำลังทำงาน (รอ delay หรือ HIGH อยู่)
+ * @return 1 = กำลังทำงาน
+ */
+uint8_t PWM_PulseBusy(PWM_Channel channel);
+
 /* ========== Advanced Functions ========== */
 
 /**
@@ -250,6 +495,33 @@ void PWM_SetPolarity(PWM_Channel channel, uint8_t inverted);
 
 /* ========== Helper Macros ========== */
 
+/**
+ * @brief Ticks ต่อคาบของความถี่ (คำนวณตอน compile จาก SIMPLE_PWM_F_CPU)
+ */
+#define PWM_TICKS_FOR(hz)  ((uint32_t)(SIMPLE_PWM_F_CPU / (hz)))
+
+/**
+ * @brief Prescaler ต่ำสุดที่ทำให้ period ไม่เกิน 16 bits (ความละเอียด duty สูงสุด)
+ */
+#define PWM_PRESCALER_FOR(hz)  ((uint16_t)((PWM_TICKS_FOR(hz) - 1) >> 16))
+
+/**
+ * @brief Period (ATRLR) คู่กับ PWM_PRESCALER_FOR()
+ */
+#define PWM_PERIOD_FOR(hz) \
+    ((uint16_t)(PWM_TICKS_FOR(hz) / ((uint32_t)PWM_PRESCALER_FOR(hz) + 1) - 1))
+
+/**
+ * @brief Initializer ของ PWM_TimeBase สำหรับตาราง const
+ */
+#define PWM_TIMEBASE(hz)  { PWM_PRESCALER_FOR(hz), PWM_PERIOD_FOR(hz) }
+
+/**
+ * @brief แปลงเปอร์เซ็นต์คงที่เป็น Q16 ตอน compile
+ */
+#define PWM_PERCENT_TO_Q16(percent) \
+    ((uint16_t)((percent) >= 100 ? 0xFFFF : ((uint32_t)(percent) * 65536UL) / 100))
+
 /**
  * @brief แปลงเปอร์เซ็นต์เป็น raw value
  */
@@ -1,15 +1,23 @@
 /********************************** SimplePWR Library *******************************
  * File Name          : SimplePWR.c
  * Author             : SimpleHAL
- * Version            : V1.0.0
- * Date               : 2025-12-22
+ * Version            : V1.3.0
+ * Date               : 2026-10-14
  * Description        : Simple Power Management library implementation for CH32V003
  **********************************************************************************/
 #include "SimplePWR.h"
 #include "core_riscv.h"
+#include "SimpleClock.h"
 
 // Private variables
-static uint8_t pwr_initialized = 0;
+static uint16_t pwr_clocks = 0;  // Clock ที่ SimplePWR ถืออยู่
+static uint8_t pwr_awu_residue = 0;  // LSI counts ที่ยังไม่ครบ 1 ms (ยกไปรอบหน้า)
+
+// SimpleDelay (ถ้า link อยู่): เลื่อน millis หลังตื่นจาก standby
+extern void Timer_AdvanceMs(uint32_t ms) __attribute__((weak));
+
+// SimpleEnergy (ถ้า link อยู่): นับเวลาที่อยู่ในแต่ละ power state
+extern void Energy_SetState(uint8_t state) __attribute__((weak));
 
 /******************************************************************************/
 /*                              Private Functions                             */
@@ -21,11 +29,8 @@ static uint8_t pwr_initialized = 0;
  */
 static void PWR_Init(void)
 {
-    if (!pwr_initialized) {
-        // Enable PWR clock
-        RCC_APB1PeriphClockCmd(RCC_APB1Periph_PWR, ENABLE);
-        pwr_initialized = 1;
-    }
+    // Enable PWR clock (idempotent)
+    Clock_AcquireOnce(CLOCK_PWR, &pwr_clocks);
 }
 
 /**
@@ -50,6 +55,10 @@ static void PWR_SelectAWUParams(uint32_t timeout_ms, uint32_t *prescaler, uint8_
         PWR_AWU_PRESCALER_4096, PWR_AWU_PRESCALER_10240, PWR_AWU_PRESCALER_61440
     };
     
+    if (timeout_ms > PWR_AWU_MAX_TIMEOUT_MS) {
+        timeout_ms = PWR_AWU_MAX_TIMEOUT_MS;
+    }
+    
     // Find the smallest prescaler that can achieve the timeout
     for (int i = 0; i < 15; i++) {
         uint32_t calc_window = PWR_AWU_CALC_WINDOW(prescalers[i], timeout_ms);
@@ -66,6 +75,50 @@ static void PWR_SelectAWUParams(uint32_t timeout_ms, uint32_t *prescaler, uint8_
     *window = PWR_AWU_MAX_WINDOW;
 }
 
+/**
+ * @brief  Convert AWU prescaler constant to its division factor
+ */
+static uint32_t PWR_PrescalerValue(uint32_t prescaler)
+{
+    switch (prescaler) {
+        case PWR_AWU_PRESCALER_1:     return 1;
+        case PWR_AWU_PRESCALER_2:     return 2;
+        case PWR_AWU_PRESCALER_4:     return 4;
+        case PWR_AWU_PRESCALER_8:     return 8;
+        case PWR_AWU_PRESCALER_16:    return 16;
+        case PWR_AWU_PRESCALER_32:    return 32;
+        case PWR_AWU_PRESCALER_64:    return 64;
+        case PWR_AWU_PRESCALER_128:   return 128;
+        case PWR_AWU_PRESCALER_256:   return 256;
+        case PWR_AWU_PRESCALER_512:   return 512;
+        case PWR_AWU_PRESCALER_1024:  return 1024;
+        case PWR_AWU_PRESCALER_2048:  return 2048;
+        case PWR_AWU_PRESCALER_4096:  return 4096;
+        case PWR_AWU_PRESCALER_10240: return 10240;
+        case PWR_AWU_PRESCALER_61440: return 61440;
+        default: return 1;
+    }
+}
+
+/**
+ * @brief  Restore system clock saved before standby (wake-up runs on HSI)
+ */
+static void PWR_RestoreClock(uint32_t ctlr, uint32_t cfgr0)
+{
+    if (ctlr & RCC_HSEON) {
+        RCC->CTLR |= RCC_HSEON;
+        while (!(RCC->CTLR & RCC_HSERDY)) {}
+    }
+    if (ctlr & RCC_PLLON) {
+        RCC->CTLR |= RCC_PLLON;
+        while (!(RCC->CTLR & RCC_PLLRDY)) {}
+    }
+
+    // SW กลับเป็น source เดิม (SWS = SW << 2)
+    RCC->CFGR0 = cfgr0;
+    while ((RCC->CFGR0 & RCC_SWS) != ((cfgr0 & RCC_SW) << 2)) {}
+}
+
 /******************************************************************************/
 /*                              Basic API Functions                           */
 /******************************************************************************/
@@ -75,6 +128,8 @@ static void PWR_SelectAWUParams(uint32_t timeout_ms, uint32_t *prescaler, uint8_
  */
 void PWR_Sleep(void)
 {
+    // ปิด clock ของ peripheral ที่ไม่มีผู้ใช้แล้ว
+    Clock_GateIdle();
     PWR_EnterSleepMode(PWR_ENTRY_WFI);
 }
 
@@ -82,6 +137,14 @@ void PWR_Sleep(void)
  * @brief  Enter Standby Mode with auto wake-up timeout
  */
 void PWR_Standby(uint32_t timeout_ms)
+{
+    (void)PWR_StandbyTimed(timeout_ms);
+}
+
+/**
+ * @brief  Standby with AWU wake-up, then advance the timebase
+ */
+uint32_t PWR_StandbyTimed(uint32_t timeout_ms)
 {
     uint32_t prescaler;
     uint8_t window;
@@ -89,14 +152,80 @@ void PWR_Standby(uint32_t timeout_ms)
     // Initialize PWR if needed
     PWR_Init();
     
-    // Calculate best AWU parameters
+    // Calculate best AWU parameters (window ปัดลง: ไม่หลับเกิน timeout)
     PWR_SelectAWUParams(timeout_ms, &prescaler, &window);
+    if (window == 0) {
+        return 0;
+    }
+    
+    // AWU นับด้วย LSI
+    RCC_LSICmd(ENABLE);
+    while (RCC_GetFlagStatus(RCC_FLAG_LSIRDY) == RESET) {}
+    
+    // AWU ปลุกผ่าน EXTI line 9: event ปลุก WFE, pending flag บอกว่าตื่นเพราะ AWU
+    // (AWU_IRQn ใน PFIC ไม่ได้เปิด จึงไม่มี interrupt จริง)
+    EXTI->INTFR = EXTI_Line9;
+    EXTI->RTENR |= EXTI_Line9;
+    EXTI->EVENR |= EXTI_Line9;
+    EXTI->INTENR |= EXTI_Line9;
     
-    // Configure AWU
+    // เริ่มนับใหม่ทั้ง window (AWU ที่เปิดค้างไว้อาจนับไปแล้วบางส่วน)
+    PWR_AutoWakeUpCmd(DISABLE);
     PWR_ConfigureAWU(prescaler, window);
     
-    // Enter standby mode
-    PWR_EnterStandbyMode(PWR_ENTRY_WFI);
+    uint32_t ctlr = RCC->CTLR;
+    uint32_t cfgr0 = RCC->CFGR0;
+    
+    if (Energy_SetState) {
+        Energy_SetState(PWR_STATE_STANDBY);
+    }
+    
+    PWR_EnterStandbyMode(PWR_ENTRY_WFE);
+    
+    PWR_RestoreClock(ctlr, cfgr0);
+    PWR_AutoWakeUpCmd(DISABLE);
+    
+    uint32_t slept_ms = 0;
+    if (EXTI->INTFR & EXTI_Line9) {
+        // ครบ window: prescaler x window LSI counts (เศษไม่ถึง ms ยกไปรอบหน้า)
+        uint32_t counts = PWR_PrescalerValue(prescaler) * window + pwr_awu_residue;
+        slept_ms = counts / PWR_LSI_COUNTS_PER_MS;
+        pwr_awu_residue = (uint8_t)(counts - slept_ms * PWR_LSI_COUNTS_PER_MS);
+    }
+    
+    EXTI->INTENR &= ~EXTI_Line9;
+    EXTI->EVENR &= ~EXTI_Line9;
+    EXTI->RTENR &= ~EXTI_Line9;
+    EXTI->INTFR = EXTI_Line9;
+    
+    if (slept_ms && Timer_AdvanceMs) {
+        Timer_AdvanceMs(slept_ms);
+    }
+    // เวลาที่ชดเชยให้ millis นับเป็น standby
+    if (Energy_SetState) {
+        Energy_SetState(PWR_STATE_RUN);
+    }
+    return slept_ms;
+}
+
+/**
+ * @brief  Deepest feasible low-power wait for up to ms
+ */
+void PWR_IdleFor(uint32_t ms)
+{
+#if SIMPLE_PWR_STANDBY_MIN_MS
+    if (ms >= SIMPLE_PWR_STANDBY_MIN_MS) {
+        // ms = 0xFFFFFFFF (ไม่มี deadline) ก็หลับแค่ AWU สูงสุด แล้ว scheduler วนเรียกใหม่
+        if (ms > PWR_AWU_MAX_TIMEOUT_MS) {
+            ms = PWR_AWU_MAX_TIMEOUT_MS;
+        }
+        (void)PWR_StandbyTimed(ms);
+        return;
+    }
+#else
+    (void)ms;
+#endif
+    PWR_Sleep();
 }
 
 /**
@@ -126,11 +255,19 @@ void PWR_EnterSleepMode(uint8_t entry_method)
     // Clear SLEEPDEEP bit to enter Sleep mode (not Standby)
     NVIC->SCTLR &= ~(1 << 2);
     
+    if (Energy_SetState) {
+        Energy_SetState(PWR_STATE_SLEEP);
+    }
+    
     if (entry_method == PWR_ENTRY_WFE) {
         __WFE();  // Wait For Event
     } else {
         __WFI();  // Wait For Interrupt (default)
     }
+    
+    if (Energy_SetState) {
+        Energy_SetState(PWR_STATE_RUN);
+    }
 }
 
 /**
@@ -144,7 +281,7 @@ void PWR_EnterStandbyMode(uint8_t entry_method)
     // Enter standby mode using HAL function
     PWR_EnterSTANDBYMode(entry_method);
     
-    // This point should never be reached (system will reset on wake-up)
+    // ตื่นแล้วทำงานต่อจากตรงนี้ด้วย HSI (RAM ยังอยู่)
 }
 
 /**
@@ -215,26 +352,7 @@ uint8_t PWR_GetPVDStatus(void)
 uint32_t PWR_GetAWUTimeout(uint32_t prescaler, uint8_t window)
 {
     // Convert prescaler constant to actual value
-    uint32_t prescaler_val;
-    
-    switch (prescaler) {
-        case PWR_AWU_PRESCALER_1:     prescaler_val = 1; break;
-        case PWR_AWU_PRESCALER_2:     prescaler_val = 2; break;
-        case PWR_AWU_PRESCALER_4:     prescaler_val = 4; break;
-        case PWR_AWU_PRESCALER_8:     prescaler_val = 8; break;
-        case PWR_AWU_PRESCALER_16:    prescaler_val = 16; break;
-        case PWR_AWU_PRESCALER_32:    prescaler_val = 32; break;
-        case PWR_AWU_PRESCALER_64:    prescaler_val = 64; break;
-        case PWR_AWU_PRESCALER_128:   prescaler_val = 128; break;
-        case PWR_AWU_PRESCALER_256:   prescaler_val = 256; break;
-        case PWR_AWU_PRESCALER_512:   prescaler_val = 512; break;
-        case PWR_AWU_PRESCALER_1024:  prescaler_val = 1024; break;
-        case PWR_AWU_PRESCALER_2048:  prescaler_val = 2048; break;
-        case PWR_AWU_PRESCALER_4096:  prescaler_val = 4096; break;
-        case PWR_AWU_PRESCALER_10240: prescaler_val = 10240; break;
-        case PWR_AWU_PRESCALER_61440: prescaler_val = 61440; break;
-        default: prescaler_val = 1; break;
-    }
+    uint32_t prescaler_val = PWR_PrescalerValue(prescaler);
     
     return PWR_AWU_TIMEOUT_MS(prescaler_val, window);
 }
@@ -1,10 +1,11 @@
 /********************************** SimplePWR Library *******************************
  * File Name          : SimplePWR.h
  * Author             : SimpleHAL
- * Version            : V1.0.0
- * Date               : 2025-12-22
+ * Version            : V1.3.0
+ * Date               : 2026-10-14
  * Description        : Simple Power Management library for CH32V003
  *                      Easy-to-use Arduino-like API for Sleep, Standby, PVD, and AWU
+ *                      Timed standby keeps millis/SoftTimers running (SimpleDelay)
  **********************************************************************************/
 #ifndef __SIMPLE_PWR_H
 #define __SIMPLE_PWR_H
@@ -14,9 +15,20 @@ extern "C" {
 #endif
 
 #include <ch32v00x.h>
+#include "SimpleHAL_Config.h"
 #include "ch32v00x_pwr.h"
 #include "ch32v00x_rcc.h"
 
+/******************************************************************************/
+/*                              Configuration                                 */
+/******************************************************************************/
+
+// PWR_IdleFor(): use standby when at least this many ms remain (0 = sleep only)
+// Standby stops HSI/HSE and all peripherals (no UART/Timer/ADC while asleep)
+#ifndef SIMPLE_PWR_STANDBY_MIN_MS
+#define SIMPLE_PWR_STANDBY_MIN_MS   0
+#endif
+
 /******************************************************************************/
 /*                              Power Mode Constants                          */
 /******************************************************************************/
@@ -31,6 +43,12 @@ extern "C" {
 #define PWR_WAKEUP_AWU          0x02
 #define PWR_WAKEUP_RESET        0x03
 
+// Power states (reported to SimpleEnergy when linked)
+#define PWR_STATE_RUN           0
+#define PWR_STATE_SLEEP         1
+#define PWR_STATE_STANDBY       2
+#define PWR_STATE_COUNT         3
+
 /******************************************************************************/
 /*                              PVD Voltage Levels                            */
 /******************************************************************************/
@@ -81,10 +99,17 @@ extern "C" {
 #define PWR_AWU_TIMEOUT_MS(prescaler_val, window_val) \
     (((prescaler_val) * (window_val) * 1000UL) / PWR_LSI_FREQ)
 
+// LSI counts per millisecond (constant divisor: compiles to a shift at 128kHz)
+#define PWR_LSI_COUNTS_PER_MS   (PWR_LSI_FREQ / 1000UL)
+
+// Longest AWU timeout: prescaler 61440 x window 63 (30240 ms at 128kHz)
+#define PWR_AWU_MAX_TIMEOUT_MS  PWR_AWU_TIMEOUT_MS(61440UL, PWR_AWU_MAX_WINDOW)
+
 // Calculate AWU window value from desired timeout
-// Formula: window = (timeout_ms * LSI_FREQ) / (prescaler * 1000)
+// Formula: window = (timeout_ms * LSI_FREQ / 1000) / prescaler
+// (LSI counts per ms first: 32-bit safe up to 2^32 / 128 ms, ~9.3 h)
 #define PWR_AWU_CALC_WINDOW(prescaler_val, timeout_ms) \
-    (((timeout_ms) * PWR_LSI_FREQ) / ((prescaler_val) * 1000UL))
+    (((timeout_ms) * PWR_LSI_COUNTS_PER_MS) / (prescaler_val))
 
 /******************************************************************************/
 /*                              Basic API Functions                           */
@@ -94,6 +119,8 @@ extern "C" {
  * @brief  Enter Sleep Mode (CPU stops, peripherals continue)
  * @note   CPU will wake up on any interrupt
  * @note   Power consumption: ~1-2mA (depending on active peripherals)
+ * @note   Peripherals released via SimpleClock (e.g. TIM_End, SPI_End)
+ *         are clock-gated by Clock_GateIdle() before entering sleep
  * @retval None
  * 
  * Example:
@@ -103,23 +130,61 @@ void PWR_Sleep(void);
 
 /**
  * @brief  Enter Standby Mode with auto wake-up timeout
- * @param  timeout_ms: Wake-up timeout in milliseconds (1 - 30000ms)
+ * @param  timeout_ms: Wake-up timeout in milliseconds (1 - PWR_AWU_MAX_TIMEOUT_MS,
+ *                     longer values are clamped)
  * @note   This function automatically selects the best prescaler
- * @note   All RAM contents will be lost after wake-up
- * @note   System will reset after wake-up (main() will restart)
+ * @note   Same as PWR_StandbyTimed() without the return value:
+ *         RAM is kept, execution continues after the call, millis is compensated
  * @note   Power consumption: ~2-5uA in standby mode
  * @retval None
  * 
  * Example:
- *   PWR_Standby(5000);  // Sleep for 5 seconds, then reset
+ *   PWR_Standby(5000);  // Sleep for ~5 seconds, then continue
  */
 void PWR_Standby(uint32_t timeout_ms);
 
+/**
+ * @brief  Standby with AWU wake-up and timebase compensation
+ * @param  timeout_ms: Maximum sleep time in milliseconds (1 - 30000ms)
+ * @note   AWU window is rounded down: never sleeps longer than timeout_ms
+ *         (within LSI accuracy)
+ * @note   On AWU wake-up the elapsed time is computed from prescaler x window
+ *         LSI counts and passed to Timer_AdvanceMs() (if SimpleDelay is linked):
+ *         millis, Get_CurrentUs64(), SoftTimers and tick hooks continue as if
+ *         SysTick had kept running. Sub-ms remainders carry over to the next call
+ * @note   System clock is restored (HSE/PLL) before returning
+ * @note   Woken early by another event (EXTI event line): returns 0, nothing is
+ *         credited because the AWU counter cannot be read
+ * @note   LSI is an RC oscillator (~±25% over temperature/voltage): long standby
+ *         time drifts by the same ratio
+ * @retval Milliseconds credited to the timebase
+ * 
+ * Example:
+ *   uint32_t start = Get_CurrentMs();
+ *   PWR_StandbyTimed(1000);
+ *   uint32_t slept = Get_CurrentMs() - start;  // ~1000
+ */
+uint32_t PWR_StandbyTimed(uint32_t timeout_ms);
+
+/**
+ * @brief  Deepest feasible low-power wait for up to ms milliseconds
+ * @param  ms: Time until the next deadline (0xFFFFFFFF = none)
+ * @note   ms >= SIMPLE_PWR_STANDBY_MIN_MS (and the option enabled): timed standby
+ *         (capped at ~30 s, the caller loops); otherwise PWR_Sleep()
+ * @note   Signature matches TM_SetIdleHook() of SimpleTask
+ * @retval None
+ * 
+ * Example:
+ *   // -DSIMPLE_PWR_STANDBY_MIN_MS=20
+ *   TM_SetIdleHook(PWR_IdleFor);  // scheduler sleeps until its next task
+ */
+void PWR_IdleFor(uint32_t ms);
+
 /**
  * @brief  Enter Standby Mode until external interrupt
  * @note   Wake-up sources: External interrupt on PA0-PA7, PC0-PC7, PD0-PD7
- * @note   All RAM contents will be lost after wake-up
- * @note   System will reset after wake-up (main() will restart)
+ * @note   RAM is kept and execution continues on HSI (restore clocks if needed)
+ * @note   millis is not compensated (sleep time is unknown)
  * @retval None
  * 
  * Example:
@@ -0,0 +1,233 @@
+/**
+ * @file SimplePool.c
+ * @brief Fixed-block Memory Pool Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimplePool.h"
+
+/* ========== Private Definitions ========== */
+
+#define POOL_WORDS(size)  (((size) + 3) / 4)
+
+// ขนาด (words) และตำแหน่งเริ่ม (words) ของแต่ละ class ใน pool_memory
+#define POOL_W0  POOL_WORDS(SIMPLE_POOL_CLASS0_SIZE)
+#define POOL_W1  POOL_WORDS(SIMPLE_POOL_CLASS1_SIZE)
+#define POOL_W2  POOL_WORDS(SIMPLE_POOL_CLASS2_SIZE)
+#define POOL_W3  POOL_WORDS(SIMPLE_POOL_CLASS3_SIZE)
+
+#define POOL_OFF1  (POOL_W0 * SIMPLE_POOL_CLASS0_COUNT)
+#define POOL_OFF2  (POOL_OFF1 + POOL_W1 * SIMPLE_POOL_CLASS1_COUNT)
+#define POOL_OFF3  (POOL_OFF2 + POOL_W2 * SIMPLE_POOL_CLASS2_COUNT)
+#define POOL_TOTAL (POOL_OFF3 + POOL_W3 * SIMPLE_POOL_CLASS3_COUNT)
+
+#if POOL_TOTAL == 0
+#error "SimplePool: all classes are empty"
+#endif
+
+typedef struct {
+    uint32_t* free;       // block ว่างตัวแรก (word แรกของ block = block ว่างถัดไป)
+    uint8_t in_use;
+    uint8_t high_water;
+    uint16_t failed;
+} Pool_Class;
+
+/* ========== Private Variables ========== */
+
+static uint32_t pool_memory[POOL_TOTAL];
+
+static const uint16_t pool_offset[POOL_CLASS_COUNT + 1] = {
+    0, POOL_OFF1, POOL_OFF2, POOL_OFF3, POOL_TOTAL
+};
+static const uint8_t pool_words[POOL_CLASS_COUNT] = {POOL_W0, POOL_W1, POOL_W2, POOL_W3};
+static const uint8_t pool_count[POOL_CLASS_COUNT] = {
+    SIMPLE_POOL_CLASS0_COUNT, SIMPLE_POOL_CLASS1_COUNT,
+    SIMPLE_POOL_CLASS2_COUNT, SIMPLE_POOL_CLASS3_COUNT
+};
+
+static Pool_Class pool_class[POOL_CLASS_COUNT];
+static uint8_t pool_ready = 0;
+
+// Block storage + class state (SimpleHAL_RamReport())
+const uint16_t pool_ram_bytes = sizeof(pool_memory) + sizeof(pool_class);
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief ปิด IRQ และจำสถานะเดิม (เรียกจาก ISR ได้)
+ */
+static inline uint32_t Pool_Lock(void) {
+    uint32_t mstatus;
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+    return mstatus;
+}
+
+static inline void Pool_Unlock(uint32_t mstatus) {
+    if (mstatus & 0x8) {
+        __asm volatile ("csrsi mstatus, 0x8");
+    }
+}
+
+/**
+ * @brief ถอด block แรกจาก free list (ต้องถือ lock)
+ */
+static uint32_t* Pool_Take(uint8_t cls) {
+    Pool_Class* c = &pool_class[cls];
+    uint32_t* block = c->free;
+
+    if (block) {
+        c->free = (uint32_t*)*block;
+        if (++c->in_use > c->high_water) {
+            c->high_water = c->in_use;
+        }
+    }
+    return block;
+}
+
+/**
+ * @brief สร้าง free list ของทุก class ใหม่ (ต้องถือ lock)
+ */
+static void Pool_Reset(void) {
+    for (uint8_t cls = 0; cls < POOL_CLASS_COUNT; cls++) {
+        Pool_Class* c = &pool_class[cls];
+        uint32_t* block = &pool_memory[pool_offset[cls]];
+        uint32_t* next = NULL;
+
+        // ต่อ list จากท้าย: block แรกของ class อยู่หัว list
+        for (uint8_t i = pool_count[cls]; i > 0; i--) {
+            uint32_t* b = block + (uint16_t)(i - 1) * pool_words[cls];
+            *b = (uint32_t)next;
+            next = b;
+        }
+        c->free = next;
+        c->in_use = 0;
+        c->high_water = 0;
+        c->failed = 0;
+    }
+    pool_ready = 1;
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่มต้น pool
+ */
+void Pool_Init(void) {
+    uint32_t mstatus = Pool_Lock();
+    Pool_Reset();
+    Pool_Unlock(mstatus);
+}
+
+/**
+ * @brief จอง block จาก class ที่ระบุ
+ */
+void* Pool_AllocClass(uint8_t cls) {
+    if (cls >= POOL_CLASS_COUNT) return NULL;
+
+    uint32_t mstatus = Pool_Lock();
+    if (!pool_ready) Pool_Reset();  // init ครั้งแรกใต้ lock (ISR แทรกได้)
+    uint32_t* block = Pool_Take(cls);
+    if (!block && pool_count[cls] && pool_class[cls].failed != 0xFFFF) {
+        pool_class[cls].failed++;
+    }
+    Pool_Unlock(mstatus);
+
+    return block;
+}
+
+/**
+ * @brief จอง block ที่เล็กที่สุดที่ขนาด >= size
+ */
+void* Pool_Alloc(uint16_t size) {
+    uint8_t cls = 0;
+    uint16_t words = (uint16_t)POOL_WORDS((uint32_t)size);
+
+    while (cls < POOL_CLASS_COUNT && (pool_count[cls] == 0 || pool_words[cls] < words)) {
+        cls++;
+    }
+    if (cls >= POOL_CLASS_COUNT) return NULL;  // ใหญ่กว่าทุก class
+
+    uint32_t mstatus = Pool_Lock();
+    if (!pool_ready) Pool_Reset();
+    uint32_t* block = Pool_Take(cls);
+    if (!block) {
+        if (pool_class[cls].failed != 0xFFFF) pool_class[cls].failed++;
+#if SIMPLE_POOL_FALLBACK
+        for (uint8_t next = cls + 1; !block && next < POOL_CLASS_COUNT; next++) {
+            block = Pool_Take(next);
+        }
+#endif
+    }
+    Pool_Unlock(mstatus);
+
+    return block;
+}
+
+/**
+ * @brief Class ของ block
+ */
+uint8_t Pool_ClassOf(const void* block) {
+    const uint32_t* p = (const uint32_t*)block;
+
+    if (p < &pool_memory[0] || p >= &pool_memory[POOL_TOTAL]) return POOL_CLASS_NONE;
+
+    uint16_t offset = (uint16_t)(p - pool_memory);
+    uint8_t cls = 0;
+    while (offset >= pool_offset[cls + 1]) {
+        cls++;
+    }
+    // ต้องเป็นต้น block (base + k * block_size) ไม่ใช่ pointer กลาง block
+    if ((offset - pool_offset[cls]) % pool_words[cls] != 0) return POOL_CLASS_NONE;
+    return cls;
+}
+
+/**
+ * @brief ขนาดของ block
+ */
+uint16_t Pool_BlockSize(const void* block) {
+    uint8_t cls = Pool_ClassOf(block);
+    return (cls == POOL_CLASS_NONE) ? 0 : (uint16_t)(pool_words[cls] * 4);
+}
+
+/**
+ * @brief คืน block
+ */
+void Pool_Free(void* block) {
+    uint8_t cls = Pool_ClassOf(block);
+    if (cls == POOL_CLASS_NONE || !pool_ready) return;
+
+    uint32_t mstatus = Pool_Lock();
+    Pool_Class* c = &pool_class[cls];
+    *(uint32_t*)block = (uint32_t)c->free;
+    c->free = (uint32_t*)block;
+    if (c->in_use) c->in_use--;
+    Pool_Unlock(mstatus);
+}
+
+/**
+ * @brief อ่านสถิติของ class
+ */
+void Pool_GetStats(uint8_t cls, Pool_Stats* stats) {
+    if (cls >= POOL_CLASS_COUNT || !stats) return;
+
+    uint32_t mstatus = Pool_Lock();
+    stats->block_size = (uint16_t)(pool_words[cls] * 4);
+    stats->count = pool_count[cls];
+    stats->in_use = pool_class[cls].in_use;
+    stats->high_water = pool_class[cls].high_water;
+    stats->failed = pool_class[cls].failed;
+    Pool_Unlock(mstatus);
+}
+
+/**
+ * @brief ตั้ง high-water mark = in_use ปัจจุบัน และล้าง failed
+ */
+void Pool_ResetStats(void) {
+    uint32_t mstatus = Pool_Lock();
+    for (uint8_t cls = 0; cls < POOL_CLASS_COUNT; cls++) {
+        pool_class[cls].high_water = pool_class[cls].in_use;
+        pool_class[cls].failed = 0;
+    }
+    Pool_Unlock(mstatus);
+}
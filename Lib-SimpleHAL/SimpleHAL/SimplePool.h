@@ -0,0 +1,185 @@
+/**
+ * @file SimplePool.h
+ * @brief Fixed-block Memory Pool สำหรับ messages และ buffers บน CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * แทน heap ด้วย blocks ขนาดคงที่หลาย class (กำหนดตอน compile) ใน array เดียว
+ * ไม่มี fragmentation และ drivers ใช้ RAM ร่วมกันได้แทนการจอง buffer ขนาด worst case ถาวร
+ *
+ * **คุณสมบัติ:**
+ * - สูงสุด 4 classes (ขนาด block / จำนวน blocks ตั้งด้วย SIMPLE_POOL_CLASSn_*)
+ * - Pool_Alloc()/Pool_Free() O(1): free list เก็บ pointer ไว้ใน word แรกของ block ที่ว่าง
+ * - เรียกจาก ISR ได้ (ปิด IRQ แค่ไม่กี่ instructions)
+ * - Pool_Free() หา class จาก address เอง ไม่ต้องส่งขนาด
+ * - สถิติต่อ class: ใช้อยู่, high-water mark, จำนวนครั้งที่ alloc ไม่สำเร็จ
+ *
+ * @example
+ * uint8_t* msg = Pool_Alloc(24);        // ได้ block 32 bytes
+ * if (msg) {
+ *     build_packet(msg);
+ *     queue_send(msg);                   // ผู้รับเรียก Pool_Free(msg) เมื่อส่งเสร็จ
+ * }
+ *
+ * Pool_Stats s;
+ * Pool_GetStats(1, &s);
+ * printf("32B: %u/%u peak %u\r\n", s.in_use, s.count, s.high_water);
+ *
+ * @note ตั้ง SIMPLE_POOL_CLASSn_COUNT = 0 เพื่อปิด class ที่ไม่ใช้ (classes ต้องเรียงขนาดจากน้อยไปมาก)
+ * @note ไม่ตรวจ double free (block เดียวกันถูก free 2 ครั้งทำให้ free list เสีย)
+ */
+
+#ifndef __SIMPLE_POOL_H
+#define __SIMPLE_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief Class 0: ขนาด block (bytes, ปัดขึ้นเป็นทวีคูณของ 4) และจำนวน blocks (0-255)
+ */
+#ifndef SIMPLE_POOL_CLASS0_SIZE
+#define SIMPLE_POOL_CLASS0_SIZE 16
+#endif
+#ifndef SIMPLE_POOL_CLASS0_COUNT
+#define SIMPLE_POOL_CLASS0_COUNT 8
+#endif
+
+/**
+ * @brief Class 1
+ */
+#ifndef SIMPLE_POOL_CLASS1_SIZE
+#define SIMPLE_POOL_CLASS1_SIZE 32
+#endif
+#ifndef SIMPLE_POOL_CLASS1_COUNT
+#define SIMPLE_POOL_CLASS1_COUNT 4
+#endif
+
+/**
+ * @brief Class 2
+ */
+#ifndef SIMPLE_POOL_CLASS2_SIZE
+#define SIMPLE_POOL_CLASS2_SIZE 64
+#endif
+#ifndef SIMPLE_POOL_CLASS2_COUNT
+#define SIMPLE_POOL_CLASS2_COUNT 2
+#endif
+
+/**
+ * @brief Class 3 (ปิดไว้)
+ */
+#ifndef SIMPLE_POOL_CLASS3_SIZE
+#define SIMPLE_POOL_CLASS3_SIZE 128
+#endif
+#ifndef SIMPLE_POOL_CLASS3_COUNT
+#define SIMPLE_POOL_CLASS3_COUNT 0
+#endif
+
+/**
+ * @brief Pool_Alloc() ใช้ class ที่ใหญ่กว่าเมื่อ class ที่พอดีหมด (0 = คืน NULL)
+ */
+#ifndef SIMPLE_POOL_FALLBACK
+#define SIMPLE_POOL_FALLBACK 1
+#endif
+
+#if SIMPLE_POOL_CLASS0_COUNT > 255 || SIMPLE_POOL_CLASS1_COUNT > 255 || \
+    SIMPLE_POOL_CLASS2_COUNT > 255 || SIMPLE_POOL_CLASS3_COUNT > 255
+#error "SIMPLE_POOL_CLASSn_COUNT must be 0-255"
+#endif
+
+#if SIMPLE_POOL_CLASS0_SIZE < 4 || SIMPLE_POOL_CLASS1_SIZE < SIMPLE_POOL_CLASS0_SIZE || \
+    SIMPLE_POOL_CLASS2_SIZE < SIMPLE_POOL_CLASS1_SIZE || SIMPLE_POOL_CLASS3_SIZE < SIMPLE_POOL_CLASS2_SIZE
+#error "SIMPLE_POOL_CLASSn_SIZE must be >= 4 and sorted ascending"
+#endif
+
+#if SIMPLE_POOL_CLASS3_SIZE > 1020
+#error "SIMPLE_POOL_CLASSn_SIZE must be <= 1020"
+#endif
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief จำนวน classes
+ */
+#define POOL_CLASS_COUNT  4
+
+/**
+ * @brief ค่าคืนของ Pool_ClassOf() เมื่อ pointer ไม่ได้มาจาก pool
+ */
+#define POOL_CLASS_NONE   0xFF
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief สถิติของ class
+ */
+typedef struct {
+    uint16_t block_size;  /**< bytes ต่อ block */
+    uint8_t count;        /**< จำนวน blocks ทั้งหมด */
+    uint8_t in_use;       /**< blocks ที่ใช้อยู่ */
+    uint8_t high_water;   /**< in_use สูงสุดตั้งแต่ init/reset */
+    uint16_t failed;      /**< alloc ที่ได้ NULL เพราะ class นี้หมด */
+} Pool_Stats;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่มต้น pool (ทุก block ว่าง)
+ * @note Pool_Alloc() เรียกให้เองครั้งแรก เรียกซ้ำเพื่อคืนทุก block พร้อมกัน
+ */
+void Pool_Init(void);
+
+/**
+ * @brief จอง block ที่เล็กที่สุดที่ขนาด >= size
+ * @param size bytes ที่ต้องการ
+ * @return pointer (align 4 bytes) หรือ NULL ถ้าไม่มี block ว่าง
+ */
+void* Pool_Alloc(uint16_t size);
+
+/**
+ * @brief จอง block จาก class ที่ระบุ
+ * @param cls 0 - POOL_CLASS_COUNT-1
+ * @return pointer หรือ NULL
+ */
+void* Pool_AllocClass(uint8_t cls);
+
+/**
+ * @brief คืน block (NULL ได้)
+ * @note ไม่สนใจ pointer ที่ไม่ใช่ต้น block ของ pool
+ */
+void Pool_Free(void* block);
+
+/**
+ * @brief Class ของ block
+ * @return 0-3 หรือ POOL_CLASS_NONE (นอก pool หรือไม่ใช่ต้น block)
+ */
+uint8_t Pool_ClassOf(const void* block);
+
+/**
+ * @brief ขนาดของ block (bytes) หรือ 0 ถ้าไม่ได้มาจาก pool
+ */
+uint16_t Pool_BlockSize(const void* block);
+
+/**
+ * @brief อ่านสถิติของ class
+ */
+void Pool_GetStats(uint8_t cls, Pool_Stats* stats);
+
+/**
+ * @brief ตั้ง high-water mark = in_use ปัจจุบัน และล้าง failed
+ */
+void Pool_ResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_POOL_H
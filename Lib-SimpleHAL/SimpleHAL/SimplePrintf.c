@@ -0,0 +1,240 @@
+/**
+ * @file SimplePrintf.c
+ * @brief Lightweight printf Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimplePrintf.h"
+#include "SimpleFormat.h"
+#include "SimpleUSART.h"
+#include "debug.h"
+#include <stddef.h>
+
+/* ========== Private Definitions ========== */
+
+/* newlib write hook ใน debug.c (SDI ring buffer / mailbox) */
+int _write(int fd, char* buf, int size);
+
+/**
+ * @brief ปลายทางของ formatter: chunk ที่ส่งออกเป็นช่วงๆ หรือ buffer ของ snprintf
+ */
+typedef struct {
+    char* buf;
+    uint16_t size;
+    uint16_t pos;
+    Printf_Output output;  // NULL = snprintf
+    int total;
+} PrintfSink_t;
+
+/* ========== Private Variables ========== */
+
+static Printf_Output printf_output = Printf_OutputUSART;
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief เพิ่ม 1 ตัวอักษรลง sink (flush เมื่อ chunk เต็ม)
+ */
+static void sink_putc(PrintfSink_t* sink, char c) {
+    sink->total++;
+
+    if (sink->output) {
+        sink->buf[sink->pos++] = c;
+        if (sink->pos == sink->size) {
+            sink->output(sink->buf, sink->pos);
+            sink->pos = 0;
+        }
+    } else if (sink->pos + 1 < sink->size) {
+        sink->buf[sink->pos++] = c;
+    }
+}
+
+/**
+ * @brief เพิ่ม field พร้อม padding ตาม width
+ */
+static void sink_field(PrintfSink_t* sink, const char* str, uint16_t len,
+                       uint8_t width, char pad, uint8_t left) {
+    uint16_t fill = (width > len) ? width - len : 0;
+
+    // Zero pad ต้องวาง '-' ไว้หน้าเลข 0
+    if (pad == '0' && len && *str == '-') {
+        sink_putc(sink, *str++);
+        len--;
+    }
+
+    if (!left) {
+        while (fill--) sink_putc(sink, pad);
+    }
+    while (len--) sink_putc(sink, *str++);
+    if (left) {
+        while (fill--) sink_putc(sink, ' ');
+    }
+}
+
+/**
+ * @brief Formatter หลักที่ใช้ร่วมกันทุกฟังก์ชัน
+ */
+static void format_to_sink(PrintfSink_t* sink, const char* format, va_list args) {
+    char num[FORMAT_FIXED_SIZE];
+
+    while (*format) {
+        char c = *format++;
+        if (c != '%') {
+            sink_putc(sink, c);
+            continue;
+        }
+
+        // Flags
+        char pad = ' ';
+        uint8_t left = 0;
+        for (;; format++) {
+            if (*format == '0') pad = '0';
+            else if (*format == '-') left = 1;
+            else break;
+        }
+        if (left) pad = ' ';
+
+        // Width
+        uint8_t width = 0;
+        while (*format >= '0' && *format <= '9') {
+            width = (uint8_t)((width << 3) + (width << 1) + (*format++ - '0'));
+        }
+
+        // Precision (สำหรับ %.Nf)
+        uint8_t decimals = 0;
+        if (*format == '.') {
+            format++;
+            while (*format >= '0' && *format <= '9') {
+                decimals = (uint8_t)((decimals << 3) + (decimals << 1) + (*format++ - '0'));
+            }
+        }
+
+        while (*format == 'l') format++;
+
+        const char* str = num;
+        uint16_t len;
+
+        switch (c = *format++) {
+            case 'd':
+            case 'i':
+                len = Format_Int(num, va_arg(args, int32_t));
+                break;
+            case 'u':
+                len = Format_UInt(num, va_arg(args, uint32_t));
+                break;
+            case 'x':
+            case 'X': {
+                uint32_t v = va_arg(args, uint32_t);
+                uint8_t digits = 1;
+                for (uint32_t t = v >> 4; t; t >>= 4) digits++;
+                len = Format_Hex(num, v, digits, c == 'X');
+                break;
+            }
+            case 'f':
+                len = Format_Fixed(num, va_arg(args, int32_t), decimals);
+                break;
+            case 'c':
+                num[0] = (char)va_arg(args, int);
+                len = 1;
+                break;
+            case 's':
+                str = va_arg(args, const char*);
+                if (!str) str = "(null)";
+                for (len = 0; str[len]; len++);
+                pad = ' ';
+                break;
+            case '%':
+                num[0] = '%';
+                len = 1;
+                break;
+            case '\0':
+                return;
+            default:
+                // Specifier ที่ไม่รองรับ: แสดงตามต้นฉบับ
+                sink_putc(sink, '%');
+                num[0] = c;
+                len = 1;
+                break;
+        }
+
+        sink_field(sink, str, len, width, pad, left);
+    }
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief printf แบบเบา
+ */
+int SimpleHAL_printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = SimpleHAL_vprintf(format, args);
+    va_end(args);
+    return n;
+}
+
+/**
+ * @brief SimpleHAL_printf แบบรับ va_list
+ */
+int SimpleHAL_vprintf(const char* format, va_list args) {
+    char chunk[SIMPLE_PRINTF_CHUNK_SIZE];
+    PrintfSink_t sink = {chunk, SIMPLE_PRINTF_CHUNK_SIZE, 0, printf_output, 0};
+
+    if (!sink.output) return 0;
+
+    format_to_sink(&sink, format, args);
+    if (sink.pos) {
+        sink.output(chunk, sink.pos);
+    }
+    return sink.total;
+}
+
+/**
+ * @brief เขียนข้อความที่ format แล้วลง buffer
+ */
+int SimpleHAL_snprintf(char* buffer, uint16_t size, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = SimpleHAL_vsnprintf(buffer, size, format, args);
+    va_end(args);
+    return n;
+}
+
+/**
+ * @brief SimpleHAL_snprintf แบบรับ va_list
+ */
+int SimpleHAL_vsnprintf(char* buffer, uint16_t size, const char* format, va_list args) {
+    PrintfSink_t sink = {buffer, size, 0, NULL, 0};
+
+    format_to_sink(&sink, format, args);
+    if (size) {
+        buffer[sink.pos] = '\0';
+    }
+    return sink.total;
+}
+
+/**
+ * @brief เลือก output ของ SimpleHAL_printf
+ */
+void Printf_SetOutput(Printf_Output output) {
+    if (output == Printf_OutputSDI) {
+        SDI_Printf_Enable();
+    }
+    printf_output = output;
+}
+
+/**
+ * @brief Output ผ่าน SimpleUSART
+ */
+void Printf_OutputUSART(const char* data, uint16_t length) {
+    USART_WriteBytes((const uint8_t*)data, length);
+}
+
+/**
+ * @brief Output ผ่าน SDI debug link
+ */
+void Printf_OutputSDI(const char* data, uint16_t length) {
+    _write(1, (char*)data, length);
+}
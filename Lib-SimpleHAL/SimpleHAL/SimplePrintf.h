@@ -0,0 +1,117 @@
+/**
+ * @file SimplePrintf.h
+ * @brief Lightweight printf สำหรับ CH32V003 (ไม่ใช้ newlib stdio)
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * printf ขนาดเล็กที่ส่งข้อมูลตรงเข้า USART TX queue หรือ SDI (debug link)
+ * แทน printf ของ newlib ที่ผ่าน _write() และใช้ flash หลาย KB
+ *
+ * **Format ที่รองรับ:**
+ * - %d %i %u %x %X %c %s %%
+ * - Flags: '0' (zero pad), '-' (ชิดซ้าย), width เช่น %5d %08X %-10s
+ * - Length 'l' รับได้แต่ไม่มีผล (int และ long เป็น 32-bit)
+ * - %.Nf: **fixed-point จาก integer** อาร์กิวเมนต์เป็น int32_t ที่ scale ด้วย 10^N
+ *   เช่น SimpleHAL_printf("%.3f V", 3297) -> "3.297 V" (ห้ามส่ง float/double)
+ *
+ * **ประสิทธิภาพ:**
+ * - แปลงตัวเลขด้วย SimpleFormat (ไม่มีการหาร)
+ * - รวมข้อความเป็น chunk ก่อนส่ง (ไม่เรียก output ทีละตัวอักษร)
+ * - Output USART เป็น non-blocking เมื่อ SIMPLE_USART_TX_DMA = 1
+ *
+ * @example
+ * USART_SimpleInit(BAUD_115200, USART_PINS_DEFAULT);
+ * SimpleHAL_printf("ADC=%4u  V=%.3f  flags=0x%02X\r\n", raw, mv, flags);
+ *
+ * // ส่งออกทาง SDI (WCH-LinkE) แทน USART
+ * Printf_SetOutput(Printf_OutputSDI);
+ *
+ * @note ไม่ใส่ format attribute เพราะ %f ในที่นี้รับ integer
+ */
+
+#ifndef __SIMPLE_PRINTF_H
+#define __SIMPLE_PRINTF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdarg.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief ขนาด chunk buffer บน stack ที่ใช้รวมข้อความก่อนส่งออก
+ */
+#ifndef SIMPLE_PRINTF_CHUNK_SIZE
+#define SIMPLE_PRINTF_CHUNK_SIZE 32
+#endif
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief ฟังก์ชันส่งข้อมูลออก (USART, SDI หรือของผู้ใช้)
+ * @param data ข้อมูล
+ * @param length จำนวน bytes
+ */
+typedef void (*Printf_Output)(const char* data, uint16_t length);
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief printf แบบเบา ส่งออกทาง output ที่เลือกไว้ (ค่าเริ่มต้น USART)
+ * @param format format string
+ * @return จำนวนตัวอักษรที่ส่ง
+ */
+int SimpleHAL_printf(const char* format, ...);
+
+/**
+ * @brief SimpleHAL_printf แบบรับ va_list
+ */
+int SimpleHAL_vprintf(const char* format, va_list args);
+
+/**
+ * @brief เขียนข้อความที่ format แล้วลง buffer
+ * @param buffer buffer ปลายทาง (ปิดท้ายด้วย '\0' เสมอเมื่อ size > 0)
+ * @param size ขนาด buffer
+ * @param format format string
+ * @return ความยาวข้อความเต็ม (ถ้า >= size แปลว่าถูกตัด)
+ *
+ * @example
+ * char line[24];
+ * SimpleHAL_snprintf(line, sizeof(line), "T=%.1f C", temp_x10);
+ */
+int SimpleHAL_snprintf(char* buffer, uint16_t size, const char* format, ...);
+
+/**
+ * @brief SimpleHAL_snprintf แบบรับ va_list
+ */
+int SimpleHAL_vsnprintf(char* buffer, uint16_t size, const char* format, va_list args);
+
+/**
+ * @brief เลือก output ของ SimpleHAL_printf
+ * @param output Printf_OutputUSART, Printf_OutputSDI หรือฟังก์ชันของผู้ใช้
+ */
+void Printf_SetOutput(Printf_Output output);
+
+/**
+ * @brief Output ผ่าน SimpleUSART (TX FIFO + DMA)
+ * @note ต้องเรียก USART_SimpleInit() ก่อน
+ */
+void Printf_OutputUSART(const char* data, uint16_t length);
+
+/**
+ * @brief Output ผ่าน SDI debug link (WCH-LinkE) ไม่ใช้ขา GPIO
+ * @note ส่งผ่าน _write() ของ debug.c: ลง SDI ring buffer (ไม่รอ probe)
+ *       ตาม SDI_PRINT_BUFFER_SIZE / SDI_PRINT_OVERFLOW
+ */
+void Printf_OutputSDI(const char* data, uint16_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_PRINTF_H
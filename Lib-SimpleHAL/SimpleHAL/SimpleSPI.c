@@ -1,16 +1,127 @@
 /**
  * @file SimpleSPI.c
  * @brief Simple SPI Library Implementation
- * @version 1.0
- * @date 2025-12-12
+ * @version 1.4
+ * @date 2026-10-14
  */
 
 #include "SimpleSPI.h"
+#include "SimpleClock.h"
+#if SIMPLE_SYSCLOCK_RETIME
+#include "SimpleSysClock.h"
+#endif
 
 /* ========== Private Variables ========== */
 
 static GPIO_TypeDef* cs_port = GPIOC;
 static uint16_t cs_pin = GPIO_Pin_4;
+static uint16_t spi_clocks = 0;  // Clock ที่ SimpleSPI ถืออยู่
+
+/**
+ * @brief Bits ของ CTLR1 ที่ SPI_ApplyConfig() เปลี่ยน (CPHA, CPOL, LSBFIRST)
+ */
+#define SPI_CONFIG_BITS  (SPI_CPHA_2Edge | SPI_CPOL_High | SPI_FirstBit_LSB)
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief รอให้ SPI ส่งข้อมูลเสร็จ (TXE = 1 และ BSY = 0)
+ */
+static void SPI_WaitIdle(void) {
+    while(SPI_I2S_GetFlagStatus(SPI1, SPI_I2S_FLAG_TXE) == RESET);
+    while(SPI_I2S_GetFlagStatus(SPI1, SPI_I2S_FLAG_BSY) != RESET);
+}
+
+/**
+ * @brief Full-duplex แบบ pipeline: เขียน byte n+1 ทันทีที่ TXE ขึ้น แล้วเก็บ byte n
+ * @param tx ข้อมูลที่ส่ง (NULL = ส่ง dummy ทุก byte)
+ * @param dummy ค่าที่ส่งเมื่อ tx = NULL
+ * @param rx buffer รับข้อมูล (ต้องไม่เป็น NULL)
+ * @param len จำนวน bytes (> 0)
+ *
+ * @note มีข้อมูลค้างใน shift register + TX buffer 2 bytes จึงต้องอ่าน RX ภายใน 1 byte time
+ *       ช่วงนั้นปิด IRQ สั้นๆ กัน overrun แล้วคืนสถานะเดิมทุก byte
+ */
+static void SPI_Pipeline(const uint8_t* tx, uint8_t dummy, uint8_t* rx, uint16_t len) {
+    uint8_t step = 1;
+    uint32_t mstatus;
+    
+    if (tx == NULL) {
+        tx = &dummy;
+        step = 0;
+    }
+    
+    __asm volatile ("csrr %0, mstatus" : "=r"(mstatus));
+    (void)SPI1->DATAR;  // ทิ้ง RXNE ที่ค้างจาก transfer ก่อน
+    
+    SPI1->DATAR = *tx;
+    tx += step;
+    
+    for (uint16_t i = 1; i < len; i++) {
+        uint8_t out = *tx;
+        tx += step;
+        
+        while (!(SPI1->STATR & SPI_STATR_TXE));
+        __asm volatile ("csrci mstatus, 0x8");
+        SPI1->DATAR = out;
+        while (!(SPI1->STATR & SPI_STATR_RXNE));
+        *rx++ = (uint8_t)SPI1->DATAR;
+        if (mstatus & 0x8) {
+            __asm volatile ("csrsi mstatus, 0x8");
+        }
+    }
+    
+    while (!(SPI1->STATR & SPI_STATR_RXNE));
+    *rx = (uint8_t)SPI1->DATAR;
+}
+
+/**
+ * @brief ส่งอย่างเดียว: เติม TX buffer ทันทีที่ว่าง ไม่รอ RXNE
+ */
+static void SPI_WriteFast(const uint8_t* tx, uint16_t len) {
+    while (len--) {
+        while (!(SPI1->STATR & SPI_STATR_TXE));
+        SPI1->DATAR = *tx++;
+    }
+    
+    // รอ byte สุดท้ายออกจาก shift register แล้วล้าง RXNE/OVR ที่ไม่ได้อ่าน
+    while (SPI1->STATR & SPI_STATR_BSY);
+    (void)SPI1->DATAR;
+    (void)SPI1->STATR;
+}
+
+/**
+ * @brief เขียน CTLR1 ใหม่ (ต้อง disable SPI ก่อนเปลี่ยน CPOL/CPHA)
+ */
+static void SPI_WriteCtrl(uint16_t ctlr1) {
+    SPI_WaitIdle();
+    SPI1->CTLR1 = ctlr1 & (uint16_t)~SPI_CTLR1_SPE;
+    SPI1->CTLR1 = ctlr1;
+}
+
+#if SIMPLE_SYSCLOCK_RETIME
+static SysClock_Hook_t spi_sysclock_hook;
+
+/**
+ * @brief SimpleHAL_SetSysClock(): เลือก prescaler ที่ SCK ใกล้เดิมที่สุดโดยไม่เร็วกว่าเดิม
+ *        (device อาจรับความเร็วสูงกว่านี้ไม่ได้)
+ */
+static void SPI_SysClockChanged(SysClock_Phase phase, uint32_t old_hz, uint32_t new_hz) {
+    if (!SPI_IsEnabled()) return;
+
+    if (phase == SYSCLK_PHASE_PRE) {
+        SPI_WaitIdle();
+        return;
+    }
+    uint16_t ctlr1 = SPI1->CTLR1;
+    uint32_t sck = old_hz >> (((ctlr1 >> 3) & 0x07) + 1);
+    uint8_t br = 0;
+    while (br < 7 && (new_hz >> (br + 1)) > sck) {
+        br++;
+    }
+    SPI_WriteCtrl((ctlr1 & (uint16_t)~(0x07 << 3)) | (br << 3));
+}
+#endif
 
 /* ========== Public Functions ========== */
 
@@ -21,12 +132,9 @@ void SPI_SimpleInit(SPI_Mode mode, SPI_Speed speed, SPI_PinConfig pin_config) {
     GPIO_InitTypeDef GPIO_InitStructure = {0};
     SPI_InitTypeDef SPI_InitStructure = {0};
     
-    // 1. เปิด Clock
-    if(pin_config == SPI_PINS_DEFAULT) {
-        RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC | RCC_APB2Periph_SPI1, ENABLE);
-    } else {
-        RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC | RCC_APB2Periph_SPI1, ENABLE);
-    }
+    // 1. เปิด Clock (เรียก init ซ้ำไม่เพิ่ม refcount)
+    Clock_AcquireOnce(CLOCK_GPIOC, &spi_clocks);
+    Clock_AcquireOnce(CLOCK_SPI1, &spi_clocks);
     
     // 2. ตั้งค่า Pin Remapping และ GPIO
     switch(pin_config) {
@@ -54,6 +162,22 @@ void SPI_SimpleInit(SPI_Mode mode, SPI_Speed speed, SPI_PinConfig pin_config) {
             cs_pin = GPIO_Pin_4;
             break;
             
+        case SPI_PINS_DEFAULT_NO_CS:
+            // Default pins โดยไม่แตะ PC4 (ใช้เป็น GPIO อื่นได้)
+            GPIO_InitStructure.GPIO_Pin = GPIO_Pin_5 | GPIO_Pin_6;
+            GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_PP;
+            GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+            GPIO_Init(GPIOC, &GPIO_InitStructure);
+            
+            GPIO_InitStructure.GPIO_Pin = GPIO_Pin_7;
+            GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
+            GPIO_Init(GPIOC, &GPIO_InitStructure);
+            
+            // SPI_SetCS() เขียน mask 0 จึงไม่มีผล
+            cs_port = GPIOC;
+            cs_pin = 0;
+            break;
+            
         case SPI_PINS_REMAP:
             // Remap: SCK=PC6, MISO=PC8, MOSI=PC7, NSS=PC5
             GPIO_PinRemapConfig(GPIO_Remap_SPI1, ENABLE);
@@ -118,6 +242,10 @@ void SPI_SimpleInit(SPI_Mode mode, SPI_Speed speed, SPI_PinConfig pin_config) {
     
     // 5. ตั้งค่า CS เป็น HIGH (inactive)
     GPIO_SetBits(cs_port, cs_pin);
+    
+#if SIMPLE_SYSCLOCK_RETIME
+    SysClock_AddHook(&spi_sysclock_hook, SPI_SysClockChanged);
+#endif
 }
 
 /**
@@ -141,30 +269,37 @@ uint8_t SPI_Transfer(uint8_t data) {
  * @brief ส่งและรับข้อมูลหลาย bytes
  */
 void SPI_TransferBuffer(uint8_t* tx_data, uint8_t* rx_data, uint16_t len) {
-    for(uint16_t i = 0; i < len; i++) {
-        uint8_t tx_byte = (tx_data != NULL) ? tx_data[i] : 0x00;
-        uint8_t rx_byte = SPI_Transfer(tx_byte);
-        
-        if(rx_data != NULL) {
-            rx_data[i] = rx_byte;
+    if (len == 0) return;
+    
+    if (rx_data == NULL) {
+        if (tx_data != NULL) {
+            SPI_WriteFast(tx_data, len);
+        } else {
+            // ไม่มีทั้ง 2 ทิศ: ส่ง clock ด้วย 0x00 ตามเดิม
+            for (uint16_t i = 0; i < len; i++) {
+                (void)SPI_Transfer(0x00);
+            }
         }
+        return;
     }
+    
+    SPI_Pipeline(tx_data, 0x00, rx_data, len);
 }
 
 /**
  * @brief ส่งข้อมูลอย่างเดียว
  */
 void SPI_Write(uint8_t* data, uint16_t len) {
-    SPI_TransferBuffer(data, NULL, len);
+    if (data == NULL || len == 0) return;
+    SPI_WriteFast(data, len);
 }
 
 /**
  * @brief รับข้อมูลอย่างเดียว
  */
 void SPI_Read(uint8_t* data, uint16_t len, uint8_t dummy_byte) {
-    for(uint16_t i = 0; i < len; i++) {
-        data[i] = SPI_Transfer(dummy_byte);
-    }
+    if (data == NULL || len == 0) return;
+    SPI_Pipeline(NULL, dummy_byte, data, len);
 }
 
 /**
@@ -206,3 +341,98 @@ void SPI_SetSpeed(SPI_Speed speed) {
     
     SPI_Cmd(SPI1, ENABLE);
 }
+
+/**
+ * @brief เปลี่ยน SPI mode
+ */
+void SPI_SetMode(SPI_Mode mode) {
+    // CPHA = bit 0, CPOL = bit 1 ตรงกับค่าของ SPI_Mode
+    uint16_t ctlr1 = SPI1->CTLR1 & (uint16_t)~(SPI_CPHA_2Edge | SPI_CPOL_High);
+    SPI_WriteCtrl(ctlr1 | ((uint16_t)mode & 0x03));
+}
+
+/**
+ * @brief เปลี่ยนขนาด frame (8/16 bit)
+ */
+void SPI_SetDataSize(SPI_DataSize size) {
+    uint16_t ctlr1 = SPI1->CTLR1 & (uint16_t)~SPI_DataSize_16b;
+    
+    if (size == SPI_DATA_16BIT) {
+        ctlr1 |= SPI_DataSize_16b;
+    }
+    
+    if (ctlr1 != SPI1->CTLR1) {
+        SPI_WriteCtrl(ctlr1);
+    }
+}
+
+/**
+ * @brief ส่งและรับข้อมูล 1 frame แบบ 16-bit
+ */
+uint16_t SPI_Transfer16(uint16_t data) {
+    while (!(SPI1->STATR & SPI_STATR_TXE));
+    SPI1->DATAR = data;
+    while (!(SPI1->STATR & SPI_STATR_RXNE));
+    return SPI1->DATAR;
+}
+
+/**
+ * @brief ส่งข้อมูล 16-bit อย่างเดียว
+ */
+void SPI_Write16(const uint16_t* data, uint16_t count) {
+    if (data == NULL || count == 0) return;
+    
+    while (count--) {
+        while (!(SPI1->STATR & SPI_STATR_TXE));
+        SPI1->DATAR = *data++;
+    }
+    
+    while (SPI1->STATR & SPI_STATR_BSY);
+    (void)SPI1->DATAR;
+    (void)SPI1->STATR;
+}
+
+/**
+ * @brief ตรวจสอบว่า SPI1 เปิดใช้งานแล้วหรือไม่
+ */
+uint8_t SPI_IsEnabled(void) {
+    return (SPI1->CTLR1 & SPI_CTLR1_SPE) ? 1 : 0;
+}
+
+/**
+ * @brief ปิด SPI1 และคืน clock
+ */
+void SPI_End(void) {
+    if (SPI_IsEnabled()) {
+        SPI_WaitIdle();
+        SPI_Cmd(SPI1, DISABLE);
+    }
+    Clock_ReleaseAll(&spi_clocks);
+}
+
+/**
+ * @brief สลับ mode และ bit order ชั่วคราว
+ */
+uint16_t SPI_ApplyConfig(SPI_Mode mode, SPI_BitOrder order) {
+    uint16_t saved = SPI1->CTLR1;
+    uint16_t wanted = (saved & (uint16_t)~SPI_CONFIG_BITS) | ((uint16_t)mode & 0x03);
+    
+    if(order == SPI_LSB_FIRST) {
+        wanted |= SPI_FirstBit_LSB;
+    }
+    
+    if(wanted != saved) {
+        SPI_WriteCtrl(wanted);
+    }
+    
+    return saved;
+}
+
+/**
+ * @brief คืนค่า config ที่บันทึกไว้
+ */
+void SPI_RestoreConfig(uint16_t saved) {
+    if(SPI1->CTLR1 != saved) {
+        SPI_WriteCtrl(saved);
+    }
+}
@@ -1,8 +1,8 @@
 /**
  * @file SimpleSPI.h
  * @brief Simple SPI Library สำหรับ CH32V003 แบบ Arduino-style
- * @version 1.0
- * @date 2025-12-12
+ * @version 1.4
+ * @date 2026-10-14
  * 
  * @details
  * Library นี้ห่อหุ้ม Hardware SPI ให้ใช้งานง่ายแบบ Arduino
@@ -13,7 +13,10 @@
  * - รองรับ 2 pin configurations
  * - รองรับ SPI Mode 0-3
  * - ฟังก์ชัน transfer แบบ Arduino
- * - รองรับ buffer transfer
+ * - รองรับ buffer transfer แบบ pipeline (เขียน byte ถัดไปทันทีที่ TXE ขึ้น ไม่มีช่องว่างระหว่าง byte)
+ * - สลับ mode/bit order ชั่วคราวสำหรับ module อื่น (เช่น shiftOut ผ่าน SPI1)
+ * - 16-bit frame (pixel RGB565 ของ ST7735/ILI9341) ด้วย SPI_SetDataSize()
+ * - SimpleHAL_SetSysClock() เลือก prescaler ใหม่ให้ SCK ไม่เร็วกว่าเดิม
  * 
  * @example
  * // ตัวอย่างการใช้งาน
@@ -39,6 +42,7 @@ extern "C" {
 
 #include <ch32v00x_spi.h>
 #include <stdint.h>
+#include "SimpleHAL_Config.h"
 
 /* ========== Enumerations ========== */
 
@@ -78,12 +82,22 @@ typedef enum {
  * @details Pin mapping สำหรับ SPI1:
  * - SPI_PINS_DEFAULT: SCK=PC5, MISO=PC7, MOSI=PC6, NSS=PC4
  * - SPI_PINS_REMAP:   SCK=PC6, MISO=PC8, MOSI=PC7, NSS=PC5
+ * - SPI_PINS_DEFAULT_NO_CS: SCK=PC5, MISO=PC7, MOSI=PC6 (PC4 ไม่ถูกแตะ)
  */
 typedef enum {
-    SPI_PINS_DEFAULT = 0,  /**< Default pins */
-    SPI_PINS_REMAP   = 1   /**< Remapped pins */
+    SPI_PINS_DEFAULT = 0,       /**< Default pins */
+    SPI_PINS_REMAP   = 1,       /**< Remapped pins */
+    SPI_PINS_DEFAULT_NO_CS = 2  /**< Default pins ไม่มี CS (SPI_SetCS ไม่มีผล) */
 } SPI_PinConfig;
 
+/**
+ * @brief ขนาด frame ของ SPI
+ */
+typedef enum {
+    SPI_DATA_8BIT  = 0,  /**< 8-bit frame (ค่าเริ่มต้น) */
+    SPI_DATA_16BIT = 1   /**< 16-bit frame (MSB first ส่ง high byte ก่อน) */
+} SPI_DataSize;
+
 /**
  * @brief Bit Order
  */
@@ -129,6 +143,9 @@ uint8_t SPI_Transfer(uint8_t data);
  * @param rx_data pointer ไปยัง buffer สำหรับเก็บข้อมูลที่รับ (NULL = ไม่เก็บ)
  * @param len จำนวน bytes
  * 
+ * @note Pipeline: byte n+1 ถูกเขียนขณะ byte n ยัง shift อยู่ ได้ความเร็วใกล้ line rate
+ * @note rx_data = NULL ใช้ write-only loop เดียวกับ SPI_Write()
+ * 
  * @example
  * uint8_t tx[] = {0x01, 0x02, 0x03};
  * uint8_t rx[3];
@@ -141,6 +158,9 @@ void SPI_TransferBuffer(uint8_t* tx_data, uint8_t* rx_data, uint16_t len);
  * @param data pointer ไปยังข้อมูลที่ต้องการส่ง
  * @param len จำนวน bytes
  * 
+ * @note เติม TX buffer ทันทีที่ว่างโดยไม่อ่าน RX (เหมาะกับ display/flash burst)
+ *       คืนค่าเมื่อ byte สุดท้ายออกจากสายแล้ว (ยกเลิก CS ได้ทันที)
+ * 
  * @example
  * uint8_t data[] = {0x01, 0x02, 0x03};
  * SPI_Write(data, 3);
@@ -153,6 +173,8 @@ void SPI_Write(uint8_t* data, uint16_t len);
  * @param len จำนวน bytes
  * @param dummy_byte ค่าที่ส่งไปขณะรับข้อมูล (ปกติใช้ 0x00 หรือ 0xFF)
  * 
+ * @note Pipeline แบบเดียวกับ SPI_TransferBuffer() โดยไม่อ่าน buffer ส่ง
+ * 
  * @example
  * uint8_t buffer[10];
  * SPI_Read(buffer, 10, 0xFF);
@@ -190,6 +212,85 @@ void SPI_SetBitOrder(SPI_BitOrder order);
  */
 void SPI_SetSpeed(SPI_Speed speed);
 
+/**
+ * @brief เปลี่ยน SPI mode (CPOL/CPHA)
+ * @param mode SPI mode ใหม่ (0-3)
+ * 
+ * @example
+ * SPI_SetMode(SPI_MODE3);
+ */
+void SPI_SetMode(SPI_Mode mode);
+
+/**
+ * @brief เปลี่ยนขนาด frame (8/16 bit)
+ * @param size SPI_DATA_8BIT หรือ SPI_DATA_16BIT
+ * 
+ * @note รอให้ SPI ว่างก่อนเปลี่ยน (ไม่ทำอะไรถ้าขนาดเดิมตรงอยู่แล้ว)
+ * @note ฟังก์ชัน 8-bit (SPI_Transfer, SPI_Write, ...) ใช้ได้เฉพาะ SPI_DATA_8BIT
+ *       ฟังก์ชัน *16 ใช้ได้เฉพาะ SPI_DATA_16BIT
+ * 
+ * @example
+ * SPI_Write(cmd, 1);                  // คำสั่ง 8-bit
+ * SPI_SetDataSize(SPI_DATA_16BIT);
+ * SPI_Write16(pixels, 128);           // pixel RGB565
+ * SPI_SetDataSize(SPI_DATA_8BIT);
+ */
+void SPI_SetDataSize(SPI_DataSize size);
+
+/**
+ * @brief ส่งและรับข้อมูล 1 frame แบบ 16-bit
+ * @param data ข้อมูลที่ต้องการส่ง
+ * @return ข้อมูลที่รับได้
+ */
+uint16_t SPI_Transfer16(uint16_t data);
+
+/**
+ * @brief ส่งข้อมูล 16-bit อย่างเดียว (write-only loop แบบเดียวกับ SPI_Write)
+ * @param data pointer ไปยังข้อมูล
+ * @param count จำนวน frame (ไม่ใช่ bytes)
+ */
+void SPI_Write16(const uint16_t* data, uint16_t count);
+
+/**
+ * @brief ตรวจสอบว่า SPI1 ถูกเปิดใช้งานแล้วหรือไม่
+ * @return 1 = เปิดใช้งานแล้ว, 0 = ยังไม่ได้ init
+ */
+uint8_t SPI_IsEnabled(void);
+
+/**
+ * @brief ปิด SPI1 และคืน clock ให้ SimpleClock
+ * 
+ * @note Clock ถูกปิดจริงใน Clock_GateIdle() (เช่นก่อน PWR_Sleep())
+ * @note เรียก SPI_SimpleInit() ใหม่เพื่อใช้งานอีกครั้ง
+ * 
+ * @example
+ * SPI_End();
+ * PWR_Sleep();
+ */
+void SPI_End(void);
+
+/**
+ * @brief สลับ mode และ bit order ชั่วคราว
+ * @param mode SPI mode ที่ต้องการ
+ * @param order bit order ที่ต้องการ
+ * @return ค่า config เดิม (ส่งให้ SPI_RestoreConfig)
+ * 
+ * @note ถ้า config ตรงกับที่ต้องการอยู่แล้วจะไม่ disable/enable SPI
+ * @note รอให้ SPI ว่าง (BSY = 0) ก่อนเปลี่ยน
+ * 
+ * @example
+ * uint16_t saved = SPI_ApplyConfig(SPI_MODE0, SPI_LSB_FIRST);
+ * SPI_Transfer(0x55);
+ * SPI_RestoreConfig(saved);
+ */
+uint16_t SPI_ApplyConfig(SPI_Mode mode, SPI_BitOrder order);
+
+/**
+ * @brief คืนค่า config ที่บันทึกไว้จาก SPI_ApplyConfig()
+ * @param saved ค่าที่ได้จาก SPI_ApplyConfig()
+ */
+void SPI_RestoreConfig(uint16_t saved);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,224 @@
+/**
+ * @file SimpleSPI_Async.c
+ * @brief Asynchronous SPI Transaction Queue Implementation
+ * @version 1.1
+ * @date 2026-10-14
+ */
+
+#include "SimpleSPI_Async.h"
+#include "SimpleGPIO.h"
+
+/* ========== Private Definitions ========== */
+
+/**
+ * @brief Bits ของ CTLR1 ที่แต่ละ transaction กำหนด (CPHA, CPOL, BR[2:0], DFF)
+ */
+#define SPI_ASYNC_CONFIG_BITS  (SPI_CPHA_2Edge | SPI_CPOL_High | (0x07 << 3) | SPI_DataSize_16b)
+
+/* ========== Private Variables ========== */
+
+static SPI_Transaction* spi_queue_head = NULL;  // transaction ที่กำลังส่ง
+static SPI_Transaction* spi_queue_tail = NULL;
+static volatile uint8_t spi_queue_active = 0;
+
+static const uint16_t spi_dummy_tx = 0xFFFF;
+static uint16_t spi_dummy_rx;
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief ปิด IRQ และจำสถานะเดิม (submit จาก ISR/callback ได้)
+ */
+static inline uint32_t SPI_AsyncLock(void) {
+    uint32_t mstatus;
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+    return mstatus;
+}
+
+static inline void SPI_AsyncUnlock(uint32_t mstatus) {
+    if (mstatus & 0x8) {
+        __asm volatile ("csrsi mstatus, 0x8");
+    }
+}
+
+/**
+ * @brief ตั้ง address/ขนาดของ DMA channel
+ * @param buffer buffer ของ transaction (NULL = ใช้ dummy)
+ * @param increment 0 = อ่าน/เขียน address เดิมซ้ำ (dummy หรือ TX repeat)
+ */
+static void SPI_AsyncLoad(DMA_Channel channel, const void* buffer, const void* dummy,
+                          uint16_t length, uint8_t increment, uint8_t wide) {
+    DMA_Channel_TypeDef* ch = DMA_GetChannelBase(channel);
+    uint16_t cfgr;
+
+    DMA_Cmd(ch, DISABLE);
+
+    cfgr = ch->CFGR & (uint16_t)~(DMA_CFGR1_MINC | DMA_CFGR1_PSIZE | DMA_CFGR1_MSIZE);
+    if (buffer && increment) {
+        cfgr |= DMA_CFGR1_MINC;
+    }
+    if (wide) {
+        cfgr |= DMA_PeripheralDataSize_HalfWord | DMA_MemoryDataSize_HalfWord;
+    }
+
+    ch->CFGR = cfgr;
+    ch->MADDR = (uint32_t)(buffer ? buffer : dummy);
+    ch->CNTR = length;
+}
+
+/**
+ * @brief เริ่ม transaction (bus ว่างแล้ว)
+ */
+static void SPI_AsyncStart(SPI_Transaction* t) {
+    uint16_t ctlr1 = SPI1->CTLR1;
+    uint16_t wanted = (ctlr1 & (uint16_t)~SPI_ASYNC_CONFIG_BITS)
+                    | ((uint16_t)t->speed << 3) | ((uint16_t)t->mode & 0x03);
+    uint8_t wide = (t->flags & SPI_ASYNC_16BIT) ? 1 : 0;
+
+    if (wide) {
+        wanted |= SPI_DataSize_16b;
+    }
+
+    // เปลี่ยน mode/speed ได้เฉพาะตอน SPE = 0
+    if (wanted != ctlr1) {
+        SPI1->CTLR1 = wanted & (uint16_t)~SPI_CTLR1_SPE;
+        SPI1->CTLR1 = wanted;
+    }
+
+    t->state = SPI_ASYNC_ACTIVE;
+
+    if (t->cs_pin != SPI_ASYNC_NO_CS) {
+        digitalWriteFast(t->cs_pin, LOW);
+    }
+
+    // RX ก่อน TX เพื่อไม่พลาด byte แรก
+    SPI_AsyncLoad(SIMPLE_SPI_ASYNC_RX_DMA_CHANNEL, t->rx, &spi_dummy_rx, t->length, 1, wide);
+    SPI_AsyncLoad(SIMPLE_SPI_ASYNC_TX_DMA_CHANNEL, t->tx, &spi_dummy_tx, t->length,
+                  !(t->flags & SPI_ASYNC_TX_REPEAT), wide);
+    DMA_Start(SIMPLE_SPI_ASYNC_RX_DMA_CHANNEL);
+    DMA_Start(SIMPLE_SPI_ASYNC_TX_DMA_CHANNEL);
+}
+
+/**
+ * @brief RX transfer complete: byte สุดท้ายรับครบแล้ว ปล่อย CS และต่อ transaction ถัดไป
+ */
+static void SPI_AsyncComplete(DMA_Channel channel) {
+    (void)channel;
+    SPI_Transaction* t = spi_queue_head;
+    if (!t) return;
+
+    if (t->cs_pin != SPI_ASYNC_NO_CS) {
+        digitalWriteFast(t->cs_pin, HIGH);
+    }
+
+    spi_queue_head = t->next;
+    if (!spi_queue_head) {
+        spi_queue_tail = NULL;
+    }
+    t->next = NULL;
+
+    // เริ่มตัวถัดไปก่อนเรียก callback เพื่อให้ bus ไม่ว่างระหว่าง callback
+    if (spi_queue_head) {
+        SPI_AsyncStart(spi_queue_head);
+    } else {
+        spi_queue_active = 0;
+    }
+
+    t->state = SPI_ASYNC_DONE;
+    if (t->callback) {
+        t->callback(t);
+    }
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่มต้น DMA ของคิว
+ */
+uint8_t SPI_AsyncInit(void) {
+    if (!DMA_SPI_Init(SIMPLE_SPI_ASYNC_TX_DMA_CHANNEL, SIMPLE_SPI_ASYNC_RX_DMA_CHANNEL)) return 0;
+    DMA_SetTransferCompleteCallback(SIMPLE_SPI_ASYNC_RX_DMA_CHANNEL, SPI_AsyncComplete);
+
+    spi_queue_head = NULL;
+    spi_queue_tail = NULL;
+    spi_queue_active = 0;
+    return 1;
+}
+
+/**
+ * @brief กำหนดค่า device ของ transaction
+ */
+void SPI_AsyncSetup(SPI_Transaction* transaction, uint8_t cs_pin, SPI_Mode mode, SPI_Speed speed) {
+    if (!transaction) return;
+
+    transaction->cs_pin = cs_pin;
+    transaction->mode = mode;
+    transaction->speed = speed;
+    transaction->tx = NULL;
+    transaction->rx = NULL;
+    transaction->length = 0;
+    transaction->flags = 0;
+    transaction->callback = NULL;
+    transaction->context = NULL;
+    transaction->state = SPI_ASYNC_IDLE;
+    transaction->next = NULL;
+
+    if (cs_pin != SPI_ASYNC_NO_CS) {
+        digitalWrite(cs_pin, HIGH);
+        pinMode(cs_pin, PIN_MODE_OUTPUT);
+    }
+}
+
+/**
+ * @brief ใส่ transaction ท้ายคิว
+ */
+uint8_t SPI_AsyncSubmit(SPI_Transaction* transaction) {
+    if (!transaction || transaction->length == 0) return 0;
+
+    uint32_t mstatus = SPI_AsyncLock();
+
+    if (transaction->state == SPI_ASYNC_QUEUED || transaction->state == SPI_ASYNC_ACTIVE) {
+        SPI_AsyncUnlock(mstatus);
+        return 0;
+    }
+
+    transaction->next = NULL;
+    transaction->state = SPI_ASYNC_QUEUED;
+
+    if (spi_queue_tail) {
+        spi_queue_tail->next = transaction;
+    } else {
+        spi_queue_head = transaction;
+    }
+    spi_queue_tail = transaction;
+
+    if (!spi_queue_active) {
+        spi_queue_active = 1;
+        SPI_AsyncStart(transaction);
+    }
+
+    SPI_AsyncUnlock(mstatus);
+    return 1;
+}
+
+/**
+ * @brief ตรวจสอบว่า transaction เสร็จแล้วหรือไม่
+ */
+uint8_t SPI_AsyncIsDone(const SPI_Transaction* transaction) {
+    return (transaction && transaction->state == SPI_ASYNC_DONE) ? 1 : 0;
+}
+
+/**
+ * @brief รอจน transaction เสร็จ
+ */
+void SPI_AsyncWait(const SPI_Transaction* transaction) {
+    if (!transaction) return;
+    while (transaction->state == SPI_ASYNC_QUEUED || transaction->state == SPI_ASYNC_ACTIVE);
+}
+
+/**
+ * @brief ตรวจสอบว่าคิวกำลังใช้ bus อยู่หรือไม่
+ */
+uint8_t SPI_AsyncBusy(void) {
+    return spi_queue_active;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file SimpleSPI_Async.h
+ * @brief Asynchronous SPI Transaction Queue ผ่าน DMA สำหรับ CH32V003
+ * @version 1.1
+ * @date 2026-10-14
+ *
+ * @details
+ * คิวของ SPI transaction ที่ทำงานต่อกันจาก DMA transfer-complete interrupt
+ * ทำให้หลาย device (display, SPI flash, ...) ใช้ bus ร่วมกันโดย main loop ไม่ต้องรอ
+ *
+ * **แต่ละ transaction มี:**
+ * - CS pin ของตัวเอง (ดึงลงก่อนเริ่ม ปล่อยขึ้นเมื่อ byte สุดท้ายรับครบ)
+ * - SPI mode และ speed (เปลี่ยน CTLR1 เฉพาะเมื่อต่างจาก transaction ก่อนหน้า)
+ * - tx/rx buffer (NULL = ส่ง 0xFF / ทิ้งข้อมูลรับ)
+ * - Flags: 16-bit frame และ TX repeat (ส่งค่าเดียวซ้ำ เช่นเติมสีพื้นที่บนจอ)
+ * - Callback เมื่อเสร็จ (เรียกจาก DMA ISR หลังเริ่ม transaction ถัดไปแล้ว)
+ *
+ * **หน่วยความจำ:** transaction เป็น struct ของผู้เรียก (intrusive list)
+ * ไม่มี allocation และไม่จำกัดจำนวนในคิว
+ *
+ * @example
+ * static SPI_Transaction lcd_tx, flash_rd;
+ *
+ * void lcd_done(SPI_Transaction* t) {
+ *     // ส่ง frame ถัดไปได้
+ * }
+ *
+ * SPI_SimpleInit(SPI_MODE0, SPI_12MHZ, SPI_PINS_DEFAULT_NO_CS);
+ * SPI_AsyncInit();
+ * SPI_AsyncSetup(&lcd_tx, PC3, SPI_MODE0, SPI_12MHZ);
+ * SPI_AsyncSetup(&flash_rd, PC4, SPI_MODE3, SPI_8MHZ);
+ *
+ * lcd_tx.tx = framebuffer;
+ * lcd_tx.length = sizeof(framebuffer);
+ * lcd_tx.callback = lcd_done;
+ * SPI_AsyncSubmit(&lcd_tx);
+ *
+ * flash_rd.tx = read_cmd;   // ส่งต่อจาก lcd_tx อัตโนมัติ
+ * flash_rd.rx = read_buf;
+ * flash_rd.length = sizeof(read_buf);
+ * SPI_AsyncSubmit(&flash_rd);
+ *
+ * while (!SPI_AsyncIsDone(&flash_rd)) {
+ *     // ทำงานอื่น
+ * }
+ *
+ * @note ใช้ DMA CH3 (SPI1_TX) และ CH2 (SPI1_RX) ห้ามใช้ channel นี้กับงานอื่น
+ * @note ห้ามเรียก SPI_Transfer()/SPI_Write() ระหว่างที่คิวยังทำงานอยู่ (SPI_AsyncBusy())
+ * @note ใช้ bit order ปัจจุบันของ SPI1 (SPI_SetBitOrder)
+ *
+ * @code
+ * // เติมพื้นที่ 128x160 ด้วยสีเดียวใน DMA burst เดียว
+ * static const uint16_t red = 0xF800;
+ * fill.tx = (const uint8_t*)&red;
+ * fill.length = 128 * 160;
+ * fill.flags = SPI_ASYNC_16BIT | SPI_ASYNC_TX_REPEAT;
+ * SPI_AsyncSubmit(&fill);
+ * @endcode
+ */
+
+#ifndef __SIMPLE_SPI_ASYNC_H
+#define __SIMPLE_SPI_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleSPI.h"
+#include "SimpleDMA.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief DMA channel สำหรับ SPI1_TX (hardware กำหนดเป็น CH3)
+ */
+#ifndef SIMPLE_SPI_ASYNC_TX_DMA_CHANNEL
+#define SIMPLE_SPI_ASYNC_TX_DMA_CHANNEL DMA_CH3
+#endif
+
+/**
+ * @brief DMA channel สำหรับ SPI1_RX (hardware กำหนดเป็น CH2)
+ */
+#ifndef SIMPLE_SPI_ASYNC_RX_DMA_CHANNEL
+#define SIMPLE_SPI_ASYNC_RX_DMA_CHANNEL DMA_CH2
+#endif
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief ค่า cs_pin สำหรับ transaction ที่ไม่ใช้ CS (ผู้เรียกควบคุมเอง)
+ */
+#define SPI_ASYNC_NO_CS  0xFF
+
+/**
+ * @brief Flags ของ transaction
+ */
+#define SPI_ASYNC_16BIT      0x01  /**< 16-bit frame: tx/rx เป็น uint16_t, length = จำนวน frame */
+#define SPI_ASYNC_TX_REPEAT  0x02  /**< ส่ง tx[0] ซ้ำ length ครั้ง (DMA ไม่เพิ่ม address) */
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief สถานะของ transaction
+ */
+typedef enum {
+    SPI_ASYNC_IDLE = 0,  /**< ยังไม่เคยส่ง */
+    SPI_ASYNC_QUEUED,    /**< รออยู่ในคิว */
+    SPI_ASYNC_ACTIVE,    /**< DMA กำลังส่ง */
+    SPI_ASYNC_DONE       /**< เสร็จแล้ว (submit ซ้ำได้) */
+} SPI_AsyncState;
+
+typedef struct SPI_Transaction SPI_Transaction;
+
+/**
+ * @brief Callback เมื่อ transaction เสร็จ
+ * @param transaction transaction ที่เสร็จ (submit ซ้ำจากใน callback ได้)
+ *
+ * @note ถูกเรียกจาก DMA interrupt
+ */
+typedef void (*SPI_TransactionCallback)(SPI_Transaction* transaction);
+
+/**
+ * @brief SPI transaction 1 รายการ (ผู้เรียกเป็นเจ้าของ ต้องอยู่จนเสร็จ)
+ */
+struct SPI_Transaction {
+    uint8_t cs_pin;                     /**< CS pin (SPI_ASYNC_NO_CS = ไม่มี) */
+    SPI_Mode mode;                      /**< SPI mode ของ device */
+    SPI_Speed speed;                    /**< ความเร็วของ device */
+    const uint8_t* tx;                  /**< ข้อมูลส่ง (NULL = ส่ง 0xFF) */
+    uint8_t* rx;                        /**< buffer รับ (NULL = ทิ้ง) */
+    uint16_t length;                    /**< จำนวน frame (bytes ใน 8-bit mode) */
+    uint8_t flags;                      /**< SPI_ASYNC_16BIT, SPI_ASYNC_TX_REPEAT */
+    SPI_TransactionCallback callback;   /**< เรียกเมื่อเสร็จ (NULL = ไม่เรียก) */
+    void* context;                      /**< ข้อมูลของผู้ใช้ */
+    volatile uint8_t state;             /**< SPI_AsyncState */
+    SPI_Transaction* next;              /**< ใช้ภายในคิว */
+};
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่มต้น DMA ของคิว (เรียกหลัง SPI_SimpleInit())
+ * @return 1 = สำเร็จ, 0 = DMA CH2/CH3 ถูก module อื่นจองอยู่
+ */
+uint8_t SPI_AsyncInit(void);
+
+/**
+ * @brief กำหนดค่า device ของ transaction และตั้ง CS pin เป็น output HIGH
+ * @param transaction transaction ที่ต้องการตั้งค่า
+ * @param cs_pin CS pin หรือ SPI_ASYNC_NO_CS
+ * @param mode SPI mode
+ * @param speed ความเร็ว
+ *
+ * @note ล้าง tx/rx/length/flags/callback ผู้เรียกกำหนดเองก่อน submit
+ */
+void SPI_AsyncSetup(SPI_Transaction* transaction, uint8_t cs_pin, SPI_Mode mode, SPI_Speed speed);
+
+/**
+ * @brief ใส่ transaction ท้ายคิว (เริ่มทันทีถ้า bus ว่าง)
+ * @param transaction transaction ที่ต้องการส่ง
+ * @return 1 = เข้าคิวแล้ว, 0 = length เป็น 0 หรือ transaction ยังอยู่ในคิว
+ *
+ * @note เรียกได้จาก main loop, ISR หรือ callback ของ transaction อื่น
+ */
+uint8_t SPI_AsyncSubmit(SPI_Transaction* transaction);
+
+/**
+ * @brief ตรวจสอบว่า transaction เสร็จแล้วหรือไม่
+ * @return 1 = เสร็จ, 0 = ยังอยู่ในคิวหรือยังไม่เคยส่ง
+ */
+uint8_t SPI_AsyncIsDone(const SPI_Transaction* transaction);
+
+/**
+ * @brief รอจน transaction เสร็จ (blocking)
+ */
+void SPI_AsyncWait(const SPI_Transaction* transaction);
+
+/**
+ * @brief ตรวจสอบว่าคิวกำลังใช้ bus อยู่หรือไม่
+ * @return 1 = มี transaction กำลังทำงาน, 0 = bus ว่าง
+ */
+uint8_t SPI_AsyncBusy(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_SPI_ASYNC_H
@@ -0,0 +1,221 @@
+/**
+ * @file SimpleSPI_Soft.c
+ * @brief Software SPI (Bit-bang) Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleSPI_Soft.h"
+#if SIMPLE_SYSCLOCK_RETIME
+#include "SimpleSysClock.h"
+#endif
+
+/* ลำดับ Pin ส่วนตัว (resolve port/mask ครั้งเดียวตอน init) */
+static GPIO_TypeDef* _SCK_PORT = GPIOD;
+static GPIO_TypeDef* _MOSI_PORT = GPIOD;
+static GPIO_TypeDef* _MISO_PORT = GPIOD;
+static uint16_t _SCK_MASK;
+static uint16_t _MOSI_MASK;   // 0 = ไม่มี MOSI (เขียน BSHR ด้วย 0 ไม่มีผล)
+static uint16_t _MISO_MASK;   // 0 = ไม่มี MISO (อ่านได้ 0 เสมอ)
+
+/* Edge ของ SCK ตาม CPOL: leading = ออกจาก idle, trailing = กลับ idle */
+static volatile uint32_t* _SCK_LEAD;
+static volatile uint32_t* _SCK_TRAIL;
+
+static uint32_t _DELAY;        // รอบ Delay_Spin ต่อครึ่งคาบ (0 = ไม่หน่วง)
+static uint32_t _MAX_HZ;       // ความเร็วที่ init (0 = ไม่จำกัด)
+static uint8_t _LSB_FIRST;
+static uint8_t (*_BYTE_FN)(uint8_t);
+
+/**
+ * @brief กลับลำดับบิตใน byte (LSB first ใช้ bit loop เดียวกับ MSB first)
+ */
+static inline uint8_t SPI_Soft_Reverse(uint8_t b) {
+    b = (uint8_t)((b >> 4) | (b << 4));
+    b = (uint8_t)(((b & 0xCC) >> 2) | ((b & 0x33) << 2));
+    b = (uint8_t)(((b & 0xAA) >> 1) | ((b & 0x55) << 1));
+    return b;
+}
+
+/*
+ * Bit loop: copy state ลง local ก่อน เพราะ compiler ต้องโหลด static ใหม่
+ * หลังทุกการเขียน volatile register
+ */
+#define SPI_SOFT_LOCALS                                         \
+    volatile uint32_t* lead = _SCK_LEAD;                        \
+    volatile uint32_t* trail = _SCK_TRAIL;                      \
+    volatile uint32_t* mosi = &_MOSI_PORT->BSHR;                \
+    const volatile uint32_t* miso = &_MISO_PORT->INDR;          \
+    uint32_t sck = _SCK_MASK;                                   \
+    uint32_t mosi_set = _MOSI_MASK;                             \
+    uint32_t mosi_clr = (uint32_t)_MOSI_MASK << 16;             \
+    uint32_t miso_mask = _MISO_MASK;                            \
+    uint32_t delay = _DELAY;                                    \
+    uint32_t in = 0
+
+/* CPHA = 0: ตั้ง MOSI ก่อน leading edge, sample ที่ leading edge */
+#define SPI_SOFT_BIT_CPHA0(n)                                   \
+    *mosi = (out & (1u << (n))) ? mosi_set : mosi_clr;          \
+    if (delay) Delay_Spin(delay);                               \
+    *lead = sck;                                                \
+    in = (in << 1) | ((*miso & miso_mask) ? 1 : 0);             \
+    if (delay) Delay_Spin(delay);                               \
+    *trail = sck
+
+/* CPHA = 1: ตั้ง MOSI ที่ leading edge, sample ที่ trailing edge */
+#define SPI_SOFT_BIT_CPHA1(n)                                   \
+    *lead = sck;                                                \
+    *mosi = (out & (1u << (n))) ? mosi_set : mosi_clr;          \
+    if (delay) Delay_Spin(delay);                               \
+    *trail = sck;                                               \
+    in = (in << 1) | ((*miso & miso_mask) ? 1 : 0);             \
+    if (delay) Delay_Spin(delay)
+
+/**
+ * @brief 1 byte, MSB first, CPHA = 0 (mode 0/2)
+ */
+static uint8_t SPI_Soft_ByteCpha0(uint8_t out) {
+    SPI_SOFT_LOCALS;
+    SPI_SOFT_BIT_CPHA0(7); SPI_SOFT_BIT_CPHA0(6); SPI_SOFT_BIT_CPHA0(5); SPI_SOFT_BIT_CPHA0(4);
+    SPI_SOFT_BIT_CPHA0(3); SPI_SOFT_BIT_CPHA0(2); SPI_SOFT_BIT_CPHA0(1); SPI_SOFT_BIT_CPHA0(0);
+    return (uint8_t)in;
+}
+
+/**
+ * @brief 1 byte, MSB first, CPHA = 1 (mode 1/3)
+ */
+static uint8_t SPI_Soft_ByteCpha1(uint8_t out) {
+    SPI_SOFT_LOCALS;
+    SPI_SOFT_BIT_CPHA1(7); SPI_SOFT_BIT_CPHA1(6); SPI_SOFT_BIT_CPHA1(5); SPI_SOFT_BIT_CPHA1(4);
+    SPI_SOFT_BIT_CPHA1(3); SPI_SOFT_BIT_CPHA1(2); SPI_SOFT_BIT_CPHA1(1); SPI_SOFT_BIT_CPHA1(0);
+    return (uint8_t)in;
+}
+
+/**
+ * @brief คำนวณ _DELAY จาก SystemCoreClock ปัจจุบันและ _MAX_HZ
+ */
+static void SPI_Soft_SetTiming(void) {
+    // ครึ่งคาบเป็น cycles (0 = ไม่จำกัด)
+    _DELAY = 0;
+    if (_MAX_HZ) {
+        uint32_t half = SystemCoreClock / (_MAX_HZ * 2);
+        if (half > SIMPLE_SPI_SOFT_OVERHEAD_CYCLES) {
+            _DELAY = (half - SIMPLE_SPI_SOFT_OVERHEAD_CYCLES) / SIMPLE_SPI_SOFT_LOOP_CYCLES;
+        }
+    }
+}
+
+#if SIMPLE_SYSCLOCK_RETIME
+static SysClock_Hook_t spi_soft_sysclock_hook;
+
+static void SPI_Soft_SysClockChanged(SysClock_Phase phase, uint32_t old_hz, uint32_t new_hz) {
+    (void)old_hz;
+    (void)new_hz;
+    if (phase == SYSCLK_PHASE_POST) {
+        SPI_Soft_SetTiming();
+    }
+}
+#endif
+
+/**
+ * @brief เริ่มต้น Software SPI
+ */
+void SPI_Soft_Init(uint8_t sck_pin, uint8_t mosi_pin, uint8_t miso_pin,
+                   SPI_Mode mode, SPI_BitOrder order, uint32_t max_hz) {
+    _SCK_PORT = GPIO_PIN_PORT(sck_pin);
+    _SCK_MASK = GPIO_PIN_MASK(sck_pin);
+
+    if (mosi_pin != SPI_SOFT_PIN_NONE) {
+        _MOSI_PORT = GPIO_PIN_PORT(mosi_pin);
+        _MOSI_MASK = GPIO_PIN_MASK(mosi_pin);
+        pinMode(mosi_pin, PIN_MODE_OUTPUT);
+    } else {
+        _MOSI_MASK = 0;
+    }
+
+    if (miso_pin != SPI_SOFT_PIN_NONE) {
+        _MISO_PORT = GPIO_PIN_PORT(miso_pin);
+        _MISO_MASK = GPIO_PIN_MASK(miso_pin);
+        pinMode(miso_pin, PIN_MODE_INPUT_PULLUP);
+    } else {
+        _MISO_MASK = 0;
+    }
+
+    _MAX_HZ = max_hz;
+    SPI_Soft_SetTiming();
+#if SIMPLE_SYSCLOCK_RETIME
+    SysClock_AddHook(&spi_soft_sysclock_hook, SPI_Soft_SysClockChanged);
+#endif
+
+    SPI_Soft_SetBitOrder(order);
+    SPI_Soft_SetMode(mode);
+    pinMode(sck_pin, PIN_MODE_OUTPUT);
+}
+
+/**
+ * @brief เปลี่ยน SPI mode
+ */
+void SPI_Soft_SetMode(SPI_Mode mode) {
+    if (mode & 0x02) {
+        // CPOL = 1: idle HIGH, leading edge = falling
+        _SCK_LEAD = &_SCK_PORT->BCR;
+        _SCK_TRAIL = &_SCK_PORT->BSHR;
+    } else {
+        // CPOL = 0: idle LOW, leading edge = rising
+        _SCK_LEAD = &_SCK_PORT->BSHR;
+        _SCK_TRAIL = &_SCK_PORT->BCR;
+    }
+
+    *_SCK_TRAIL = _SCK_MASK;  // idle level
+    _BYTE_FN = (mode & 0x01) ? SPI_Soft_ByteCpha1 : SPI_Soft_ByteCpha0;
+}
+
+/**
+ * @brief เปลี่ยนลำดับบิต
+ */
+void SPI_Soft_SetBitOrder(SPI_BitOrder order) {
+    _LSB_FIRST = (order == SPI_LSB_FIRST) ? 1 : 0;
+}
+
+/**
+ * @brief ส่งและรับ 1 byte
+ */
+uint8_t SPI_Soft_Transfer(uint8_t data) {
+    if (_LSB_FIRST) {
+        return SPI_Soft_Reverse(_BYTE_FN(SPI_Soft_Reverse(data)));
+    }
+    return _BYTE_FN(data);
+}
+
+/**
+ * @brief ส่งข้อมูลหลาย bytes
+ */
+void SPI_Soft_Write(const uint8_t* data, uint16_t len) {
+    SPI_Soft_TransferBuffer(data, NULL, len);
+}
+
+/**
+ * @brief รับข้อมูลหลาย bytes
+ */
+void SPI_Soft_Read(uint8_t* data, uint16_t len) {
+    SPI_Soft_TransferBuffer(NULL, data, len);
+}
+
+/**
+ * @brief ส่งและรับข้อมูลหลาย bytes
+ */
+void SPI_Soft_TransferBuffer(const uint8_t* tx, uint8_t* rx, uint16_t len) {
+    uint8_t (*byte_fn)(uint8_t) = _BYTE_FN;
+    uint8_t lsb_first = _LSB_FIRST;
+
+    while (len--) {
+        uint8_t out = tx ? *tx++ : 0xFF;
+        if (lsb_first) out = SPI_Soft_Reverse(out);
+
+        uint8_t in = byte_fn(out);
+
+        if (rx) {
+            *rx++ = lsb_first ? SPI_Soft_Reverse(in) : in;
+        }
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file SimpleSPI_Soft.h
+ * @brief Software SPI (Bit-bang) Library for CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * SPI master แบบ bit-bang บน GPIO ใดก็ได้ สำหรับ bus ที่สอง
+ * (shift register, sensor) เมื่อ pin ของ SPI1 ไม่ว่างหรือไม่มีใน package
+ *
+ * **คุณสมบัติ:**
+ * - เขียน BSHR/BCR และอ่าน INDR ตรงจาก port/mask ที่ resolve ไว้ตอน init
+ * - Bit loop แบบ unroll 8 bits สำหรับ CPHA = 0 และ CPHA = 1
+ * - ครบ 4 modes (CPOL/CPHA) และ MSB/LSB first
+ * - ความเร็วสูงสุดหลาย Mbit/s ที่ 48 MHz หรือจำกัดความเร็วด้วย max_hz
+ * - MOSI หรือ MISO เป็น SPI_SOFT_PIN_NONE ได้ (write-only / read-only)
+ *
+ * @example
+ * // 74HC595: SCK=PC5, MOSI=PC6, ไม่มี MISO
+ * SPI_Soft_Init(PC5, PC6, SPI_SOFT_PIN_NONE, SPI_MODE0, SPI_MSB_FIRST, 0);
+ * digitalWrite(PC4, LOW);
+ * SPI_Soft_Transfer(0xA5);
+ * digitalWrite(PC4, HIGH);
+ *
+ * @note CS ควบคุมเองด้วย digitalWrite()/digitalWriteFast()
+ * @note SimpleHAL_SetSysClock() คำนวณ delay ใหม่ให้ ถ้าเปลี่ยน SystemCoreClock เองต้องเรียก
+ *       SPI_Soft_Init() ใหม่
+ */
+
+#ifndef __SIMPLE_SPI_SOFT_H
+#define __SIMPLE_SPI_SOFT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleGPIO.h"
+#include "SimpleSPI.h"
+#include "SimpleDelay.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief จำนวน CPU cycles ต่อรอบของ Delay_Spin (เหมือน SIMPLE_I2C_SOFT_LOOP_CYCLES)
+ */
+#ifndef SIMPLE_SPI_SOFT_LOOP_CYCLES
+#define SIMPLE_SPI_SOFT_LOOP_CYCLES SIMPLE_DELAY_LOOP_CYCLES
+#endif
+
+/**
+ * @brief Cycles ของการสลับขาต่อครึ่งคาบ (หักออกจาก delay เมื่อจำกัดความเร็ว)
+ */
+#ifndef SIMPLE_SPI_SOFT_OVERHEAD_CYCLES
+#define SIMPLE_SPI_SOFT_OVERHEAD_CYCLES 6
+#endif
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief ค่า pin สำหรับ MOSI หรือ MISO ที่ไม่ใช้
+ */
+#define SPI_SOFT_PIN_NONE  0xFF
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่มต้น Software SPI
+ * @param sck_pin Pin สำหรับ SCK
+ * @param mosi_pin Pin สำหรับ MOSI (SPI_SOFT_PIN_NONE = ไม่ใช้)
+ * @param miso_pin Pin สำหรับ MISO (SPI_SOFT_PIN_NONE = ไม่ใช้)
+ * @param mode SPI_MODE0 - SPI_MODE3
+ * @param order SPI_MSB_FIRST หรือ SPI_LSB_FIRST
+ * @param max_hz ความเร็วสูงสุดของ SCK (0 = เร็วที่สุดที่ทำได้)
+ */
+void SPI_Soft_Init(uint8_t sck_pin, uint8_t mosi_pin, uint8_t miso_pin,
+                   SPI_Mode mode, SPI_BitOrder order, uint32_t max_hz);
+
+/**
+ * @brief เปลี่ยน SPI mode (SCK กลับไป idle level ของ mode ใหม่)
+ */
+void SPI_Soft_SetMode(SPI_Mode mode);
+
+/**
+ * @brief เปลี่ยนลำดับบิต
+ */
+void SPI_Soft_SetBitOrder(SPI_BitOrder order);
+
+/**
+ * @brief ส่งและรับ 1 byte
+ * @param data ข้อมูลที่ส่ง
+ * @return ข้อมูลที่รับ (0 ถ้าไม่มี MISO)
+ */
+uint8_t SPI_Soft_Transfer(uint8_t data);
+
+/**
+ * @brief ส่งข้อมูลหลาย bytes (ทิ้งข้อมูลรับ)
+ */
+void SPI_Soft_Write(const uint8_t* data, uint16_t len);
+
+/**
+ * @brief รับข้อมูลหลาย bytes (ส่ง 0xFF)
+ */
+void SPI_Soft_Read(uint8_t* data, uint16_t len);
+
+/**
+ * @brief ส่งและรับข้อมูลหลาย bytes
+ * @param tx ข้อมูลส่ง (NULL = ส่ง 0xFF)
+ * @param rx buffer รับ (NULL = ทิ้ง)
+ * @param len จำนวน bytes
+ */
+void SPI_Soft_TransferBuffer(const uint8_t* tx, uint8_t* rx, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SIMPLE_SPI_SOFT_H
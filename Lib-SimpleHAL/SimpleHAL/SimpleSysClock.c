@@ -0,0 +1,187 @@
+/**
+ * @file SimpleSysClock.c
+ * @brief Runtime System Clock Scaling Implementation
+ * @version 1.0
+ * @date 2026-10-15
+ */
+
+#include "SimpleSysClock.h"
+#include "SimpleDelay.h"
+#include <stddef.h>
+
+/* ========== Private Definitions ========== */
+
+#define SYSTICK_CTLR_STE  (1UL << 0)  // SysTick นับ
+
+/**
+ * @brief ค่าของ CFGR0 และ flash latency ต่อความถี่
+ */
+typedef struct {
+    uint32_t hz;       // HCLK ที่คาดไว้ (แจ้ง hooks ใน PRE)
+    uint32_t hpre;     // RCC_HPRE_DIVx
+    uint8_t pll;       // 1 = SYSCLK จาก PLL
+} SysClock_Preset;
+
+static const SysClock_Preset sysclock_presets[SYSCLK_FREQ_COUNT] = {
+    {48000000, RCC_HPRE_DIV1, 1},
+    {24000000, RCC_HPRE_DIV1, 0},
+    {12000000, RCC_HPRE_DIV2, 0},
+    {8000000,  RCC_HPRE_DIV3, 0},
+    {6000000,  RCC_HPRE_DIV4, 0},
+    {3000000,  RCC_HPRE_DIV8, 0}
+};
+
+/* ========== Private Variables ========== */
+
+static SysClock_Hook_t* sysclock_hooks = NULL;
+
+// ระหว่าง POST: ความถี่ก่อน/หลัง (kHz) และ timers ที่ปรับแล้ว (bit 0 = TIM1, bit 1 = TIM2)
+static uint32_t sysclock_old_khz = 0;
+static uint32_t sysclock_new_khz = 0;
+static uint8_t sysclock_scaled = 0;
+
+/* ========== Private Functions ========== */
+
+static inline uint32_t sysclock_lock(void) {
+    uint32_t mstatus;
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+    return mstatus;
+}
+
+static inline void sysclock_unlock(uint32_t mstatus) {
+    if (mstatus & 0x8) {
+        __asm volatile ("csrsi mstatus, 0x8");
+    }
+}
+
+/**
+ * @brief เรียกทุก hook ตามลำดับใน list
+ */
+static void sysclock_notify(SysClock_Phase phase, uint32_t old_hz, uint32_t new_hz) {
+    for (SysClock_Hook_t* hook = sysclock_hooks; hook != NULL; hook = hook->next) {
+        hook->callback(phase, old_hz, new_hz);
+    }
+}
+
+/* ========== Public Functions ========== */
+
+uint8_t SimpleHAL_SetSysClock(SysClock_Freq freq) {
+    SIMPLE_CHECK(freq < SYSCLK_FREQ_COUNT, 0);
+
+    const SysClock_Preset* preset = &sysclock_presets[freq];
+    uint32_t sw = preset->pll ? RCC_SW_PLL : RCC_SW_HSI;
+    uint32_t cfgr0 = RCC->CFGR0;
+
+    if ((cfgr0 & (RCC_HPRE | RCC_SW)) == (preset->hpre | sw)) {
+        return 1;
+    }
+
+    uint32_t old_hz = SystemCoreClock;
+
+    // 1. Modules รอ transfer ที่ค้าง (ISR ยังทำงาน)
+    sysclock_notify(SYSCLK_PHASE_PRE, old_hz, preset->hz);
+
+    // 2. Oscillator ต้องพร้อมก่อนสลับ (รอนอก critical section)
+    if (!(RCC->CTLR & RCC_HSIRDY)) {
+        RCC->CTLR |= RCC_HSION;
+        while (!(RCC->CTLR & RCC_HSIRDY)) {}
+    }
+    if (preset->pll && !(RCC->CTLR & RCC_PLLRDY)) {
+        RCC->CFGR0 &= ~RCC_PLLSRC;   // PLL = HSI × 2
+        RCC->CTLR |= RCC_PLLON;
+        while (!(RCC->CTLR & RCC_PLLRDY)) {}
+    }
+
+    uint32_t mstatus = sysclock_lock();
+
+    // SysTick หยุดนับ: ticks ที่ค้างถูกคิดด้วยอัตราเดิมใน Timer_Retime()
+    SysTick->CTLR &= ~SYSTICK_CTLR_STE;
+
+    // 3. Flash wait state ต้องพอก่อน HCLK เร็วขึ้น และลดได้หลัง HCLK ช้าลง
+    if (preset->pll) {
+        FLASH->ACTLR = (FLASH->ACTLR & ~FLASH_ACTLR_LATENCY) | FLASH_ACTLR_LATENCY_1;
+    }
+    RCC->CFGR0 = (cfgr0 & ~(RCC_HPRE | RCC_SW)) | preset->hpre | sw;
+    while ((RCC->CFGR0 & RCC_SWS) != (sw << 2)) {}
+    if (!preset->pll) {
+        FLASH->ACTLR = (FLASH->ACTLR & ~FLASH_ACTLR_LATENCY) | FLASH_ACTLR_LATENCY_0;
+    }
+    SystemCoreClockUpdate();
+
+    // 4. SysTick ก่อน hooks: POST ของ module อื่นอ่านเวลาได้ถูกต้อง
+    Timer_Retime();
+
+    sysclock_old_khz = old_hz / 1000;
+    sysclock_new_khz = SystemCoreClock / 1000;
+    sysclock_scaled = 0;
+    sysclock_notify(SYSCLK_PHASE_POST, old_hz, SystemCoreClock);
+
+    sysclock_unlock(mstatus);
+
+    // PLL ไม่ถูกใช้แล้ว: ปิดลดกระแส
+    if (!preset->pll) {
+        RCC->CTLR &= ~RCC_PLLON;
+    }
+    return 1;
+}
+
+void SysClock_AddHook(SysClock_Hook_t* hook, SysClock_Callback callback) {
+    if (hook == NULL || callback == NULL) return;
+
+    SysClock_RemoveHook(hook);
+    hook->callback = callback;
+    hook->next = sysclock_hooks;
+    sysclock_hooks = hook;
+}
+
+void SysClock_RemoveHook(SysClock_Hook_t* hook) {
+    if (hook == NULL) return;
+
+    SysClock_Hook_t** link = &sysclock_hooks;
+    while (*link != NULL && *link != hook) {
+        link = &(*link)->next;
+    }
+    if (*link != NULL) {
+        *link = hook->next;
+    }
+}
+
+uint8_t SysClock_ScaleTimer(TIM_TypeDef* timer) {
+    uint8_t bit = (timer == TIM1) ? 0x01 : 0x02;
+    if (sysclock_scaled & bit) return 1;   // module อื่นปรับไปแล้วในการเปลี่ยนนี้
+    sysclock_scaled |= bit;
+
+    // Encoder / cascade นับจาก clock ภายนอก ไม่ขึ้นกับ HCLK
+    if (timer->SMCFGR & TIM_SMS) return 1;
+
+    uint32_t psc1 = (uint32_t)timer->PSC + 1;
+    uint32_t scaled = psc1 * sysclock_new_khz;   // ไม่เกิน 65536 × 48000
+    uint8_t exact = (scaled % sysclock_old_khz) == 0 && scaled / sysclock_old_khz <= 0x10000;
+
+    if (exact) {
+        timer->PSC = (uint16_t)(scaled / sysclock_old_khz - 1);
+    } else {
+        // HCLK cycles ต่อคาบที่ clock ใหม่ แล้วแบ่งเป็น PSC/ATRLR แบบ PWM_Init()
+        uint32_t arr1 = (uint32_t)timer->ATRLR + 1;
+        uint64_t cycles = (uint64_t)psc1 * arr1 * sysclock_new_khz / sysclock_old_khz;
+        if (cycles < 2) cycles = 2;
+        if (cycles > 0xFFFFFFFFULL) cycles = 0xFFFFFFFFULL;
+
+        uint32_t psc = ((uint32_t)cycles - 1) >> 16;
+        uint32_t new_arr1 = (uint32_t)cycles / (psc + 1);
+
+        // Compare ตามสัดส่วน: duty เท่าเดิม
+        volatile uint32_t* cvr = &timer->CH1CVR;   // CH1CVR - CH4CVR ต่อกัน
+        for (uint8_t ch = 0; ch < 4; ch++) {
+            cvr[ch] = cvr[ch] * new_arr1 / arr1;
+        }
+        timer->PSC = (uint16_t)psc;
+        timer->ATRLR = (uint16_t)(new_arr1 - 1);
+    }
+
+    // โหลด PSC ทันที: URS ทำให้ UG ไม่ตั้ง update flag / interrupt
+    timer->CTLR1 |= TIM_URS;
+    timer->SWEVGR = TIM_UG;
+    timer->CTLR1 &= ~TIM_URS;
+    return exact;
+}
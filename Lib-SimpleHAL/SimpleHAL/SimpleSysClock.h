@@ -0,0 +1,151 @@
+/**
+ * @file SimpleSysClock.h
+ * @brief เปลี่ยน system clock ขณะทำงาน พร้อมปรับ timing ของทุก module ที่ใช้อยู่
+ * @version 1.0
+ * @date 2026-10-15
+ *
+ * @details
+ * SimpleHAL คำนวณ timing จาก SystemCoreClock ครั้งเดียวตอน init (SysTick compare,
+ * USART BRR, prescaler ของ PWM/TIM, I2C CKCFGR, delay ของ soft I2C/SPI)
+ * SimpleHAL_SetSysClock() สลับ clock tree แล้วแจ้ง module ที่ลงทะเบียนไว้ให้คำนวณใหม่
+ * จึงวิ่ง 48 MHz ช่วงงานหนักแล้วลดเหลือ 8 MHz หรือต่ำกว่าตอนว่างได้ โดย protocol
+ * และเวลาไม่เพี้ยน
+ *
+ * **ลำดับการเปลี่ยน:**
+ * 1. SYSCLK_PHASE_PRE (interrupts เปิด): module รอ transfer ที่ค้างให้จบ (USART TX, SPI, I2C)
+ * 2. ปิด interrupts, หยุด SysTick, ตั้ง flash latency / HPRE / SW, SystemCoreClockUpdate()
+ * 3. SysTick คำนวณใหม่โดยคงเศษ ms เดิม (millis/micros ต่อเนื่อง)
+ * 4. SYSCLK_PHASE_POST (interrupts ยังปิด): module ตั้ง register ใหม่
+ *
+ * **Modules ที่ปรับให้เอง (SIMPLE_SYSCLOCK_RETIME = 1):**
+ * - SimpleDelay: SysTick, Delay_Us(), millis/micros
+ * - SimpleUSART: BRR จาก baud ปัจจุบัน (รวมค่าจาก USART_AutoBaud())
+ * - SimpleI2C: FREQ/CKCFGR จากความเร็วที่ init
+ * - SimpleSPI: prescaler ที่ SCK ไม่เร็วกว่าเดิม
+ * - SimplePWM / SimpleTIM: prescaler ให้ timer tick เท่าเดิม (ความถี่และ duty ไม่เปลี่ยน)
+ *   และ dead-time ของ TIM1
+ * - SimpleI2C_Soft / SimpleSPI_Soft: จำนวนรอบ delay
+ *
+ * **ต้อง init ใหม่เอง:** SimpleWS2812, SimpleTIM_Timestamp, SimpleTIM_Capture (timeout),
+ * ADC sample time และค่าคงที่ตอน compile (SIMPLE_DELAY_F_CPU ของ Delay_Ns(),
+ * PWM_TIMEBASE())
+ *
+ * @example
+ * SimpleHAL_SetSysClock(SYSCLK_HSI_48M);   // งานหนัก
+ * process_burst();
+ * SimpleHAL_SetSysClock(SYSCLK_HSI_8M);    // ว่าง: กระแส run mode ลดตามความถี่
+ *
+ * // Module ของผู้ใช้
+ * static SysClock_Hook_t my_hook;
+ * static void my_retime(SysClock_Phase phase, uint32_t old_hz, uint32_t new_hz) {
+ *     if (phase == SYSCLK_PHASE_POST) my_divider = new_hz / MY_RATE;
+ * }
+ * SysClock_AddHook(&my_hook, my_retime);
+ *
+ * @note CH32V003 เลือก SYSCLK ได้จาก HSI, HSE หรือ PLL เท่านั้น (LSI ใช้ได้แค่ IWDG/AWU)
+ *       ความถี่ต่ำสุดที่มีให้คือ HSI/8 = 3 MHz: ต่ำกว่านั้น SysTick interrupt ทุก 1 ms
+ *       กินเวลา CPU มากและ Delay_Us() ละเอียดไม่ถึง 1 cycle ต่อ µs
+ *       ใช้ PWR_Sleep()/PWR_StandbyTimed() เมื่อต้องการกระแสต่ำกว่านี้
+ * @note เรียกจาก main loop เท่านั้น (ไม่ใช่ interrupt) และไม่ระหว่างคิวของ SimpleSPI_Async
+ *       (SPI_AsyncBusy() = 0)
+ */
+
+#ifndef __SIMPLE_SYSCLOCK_H
+#define __SIMPLE_SYSCLOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <ch32v00x.h>
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief ความถี่ของ HCLK (= SystemCoreClock) ที่เลือกได้
+ */
+typedef enum {
+    SYSCLK_HSI_48M = 0,   /**< PLL (HSI × 2), flash 1 wait state */
+    SYSCLK_HSI_24M,       /**< HSI */
+    SYSCLK_HSI_12M,       /**< HSI / 2 */
+    SYSCLK_HSI_8M,        /**< HSI / 3 (ค่าหลัง reset) */
+    SYSCLK_HSI_6M,        /**< HSI / 4 */
+    SYSCLK_HSI_3M,        /**< HSI / 8 */
+    SYSCLK_FREQ_COUNT
+} SysClock_Freq;
+
+/**
+ * @brief ช่วงของการเปลี่ยน clock ที่ hook ถูกเรียก
+ */
+typedef enum {
+    SYSCLK_PHASE_PRE = 0,  /**< ก่อนเปลี่ยน (interrupts เปิด, ยังเป็น clock เดิม): รอ transfer ให้จบ */
+    SYSCLK_PHASE_POST      /**< หลังเปลี่ยน (interrupts ปิด, SystemCoreClock ใหม่แล้ว): ตั้ง register ใหม่ */
+} SysClock_Phase;
+
+/**
+ * @brief Callback ของ hook
+ * @param phase SYSCLK_PHASE_PRE หรือ SYSCLK_PHASE_POST
+ * @param old_hz SystemCoreClock ก่อนเปลี่ยน
+ * @param new_hz SystemCoreClock หลังเปลี่ยน (PRE: ค่าที่คาดไว้จาก HSI nominal)
+ *
+ * @note POST ทำงานขณะปิด interrupts: ห้ามรอ flag หรือเรียก Delay_Ms()
+ */
+typedef void (*SysClock_Callback)(SysClock_Phase phase, uint32_t old_hz, uint32_t new_hz);
+
+/**
+ * @brief Hook ที่ถูกเรียกเมื่อ clock เปลี่ยน (ผู้ใช้จองไว้ ห้ามแก้ field เอง)
+ */
+typedef struct SysClock_Hook {
+    struct SysClock_Hook* next;
+    SysClock_Callback callback;
+} SysClock_Hook_t;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เปลี่ยน system clock และปรับ timing ของทุก module ที่ลงทะเบียนไว้
+ * @param freq ความถี่ใหม่
+ * @return 1 = สำเร็จ (หรือเป็นความถี่นี้อยู่แล้ว), 0 = freq ไม่ถูกต้อง
+ *
+ * @note ใช้เวลาประมาณเวลาที่ USART/SPI/I2C ส่งข้อมูลที่ค้างจนจบ
+ *       บวก PLL lock (~µs) เมื่อขึ้น 48 MHz
+ * @note ปิด PLL ให้เองเมื่อลงไปใช้ HSI
+ */
+uint8_t SimpleHAL_SetSysClock(SysClock_Freq freq);
+
+/**
+ * @brief ลงทะเบียน hook
+ * @param hook struct ที่ผู้เรียกจองไว้ (ต้องอยู่ตลอดการใช้งาน)
+ * @param callback ถูกเรียกสองครั้งต่อการเปลี่ยน (PRE แล้ว POST)
+ *
+ * @note เรียกซ้ำกับ hook เดิมได้ (ไม่ถูกเพิ่มซ้ำ)
+ */
+void SysClock_AddHook(SysClock_Hook_t* hook, SysClock_Callback callback);
+
+/**
+ * @brief ยกเลิก hook
+ */
+void SysClock_RemoveHook(SysClock_Hook_t* hook);
+
+/**
+ * @brief ปรับ timer ให้นับด้วยอัตราเดิมหลัง clock เปลี่ยน (เรียกใน SYSCLK_PHASE_POST)
+ * @param timer TIM1 หรือ TIM2
+ * @return 1 = คาบเท่าเดิมทุก tick (เปลี่ยนแค่ PSC), 0 = ปรับ ATRLR/compare ตามสัดส่วน
+ *         (ความถี่ใกล้เคียง duty เท่าเดิม)
+ *
+ * @details ตั้ง PSC ใหม่ = (PSC + 1) × new / old เมื่อหารลงตัว เช่น timer ที่ tick 1 MHz
+ * ถูกต้องทุกความถี่ของ SysClock_Freq แล้วสร้าง update event (ไม่เรียก update interrupt)
+ * ให้ PSC มีผลทันที
+ *
+ * @note Timer ถูกปรับครั้งเดียวต่อการเปลี่ยน แม้หลาย module เรียก (เช่น SimplePWM + SimpleTIM)
+ * @note Timer ใน slave mode (encoder, cascade) ไม่ถูกแตะ
+ */
+uint8_t SysClock_ScaleTimer(TIM_TypeDef* timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_SYSCLOCK_H
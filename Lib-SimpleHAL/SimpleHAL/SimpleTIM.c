@@ -1,11 +1,17 @@
 /**
  * @file SimpleTIM.c
  * @brief Simple Timer Library Implementation
- * @version 1.0
- * @date 2025-12-21
+ * @version 1.5
+ * @date 2026-10-14
  */
 
 #include "SimpleTIM.h"
+#include "SimpleClock.h"
+#include "SimpleEvent.h"
+#include "SimpleISRStat.h"
+#if SIMPLE_SYSCLOCK_RETIME
+#include "SimpleSysClock.h"
+#endif
 
 /* ========== Internal Data ========== */
 
@@ -18,13 +24,24 @@ static TIM_TypeDef* const tim_peripherals[] = {
 };
 
 /**
- * @brief Timer RCC peripherals
+ * @brief Timer clocks (SimpleClock)
  */
-static const uint32_t tim_rcc[] = {
-    RCC_APB2Periph_TIM1,  // TIM_1
-    RCC_APB1Periph_TIM2   // TIM_2
+static const Clock_Periph tim_clock[] = {
+    CLOCK_TIM1,  // TIM_1
+    CLOCK_TIM2   // TIM_2
 };
 
+/**
+ * @brief Clock ที่ SimpleTIM ถืออยู่ (bitmask ของ Clock_Periph)
+ */
+static uint16_t tim_clocks = 0;
+
+/**
+ * @brief Timers ที่ต้องนับด้วยอัตราเดิมเมื่อ system clock เปลี่ยน (bit = TIM_Instance)
+ * @note PSC = 0 จาก TIM_AdvancedInit() คือนับ HCLK cycles ตรงๆ (Capture, Encoder) จึงไม่อยู่ใน mask
+ */
+static uint8_t tim_retime = 0;
+
 /**
  * @brief Timer IRQ channels
  */
@@ -38,6 +55,51 @@ static const uint8_t tim_irq[] = {
  */
 static void (*tim_callbacks[2])(void) = {NULL, NULL};
 
+/**
+ * @brief Timers ที่ update callback ถูกเรียกจาก Event_Dispatch() (bit = TIM_Instance)
+ */
+static volatile uint8_t tim_deferred = 0;
+
+/**
+ * @brief Capture/compare IRQ channels
+ */
+static const uint8_t tim_cc_irq[] = {
+    TIM1_CC_IRQn,  // TIM_1
+    TIM2_IRQn      // TIM_2 (ใช้ IRQ ร่วมกับ update)
+};
+
+/**
+ * @brief Capture/compare handlers (low-level)
+ */
+static TIM_CCHandler tim_cc_handlers[2] = {NULL, NULL};
+
+/**
+ * @brief Mask ของ capture/compare flags (CC1-CC4)
+ */
+#define TIM_CC_FLAGS_MASK  (TIM_IT_CC1 | TIM_IT_CC2 | TIM_IT_CC3 | TIM_IT_CC4)
+
+/**
+ * @brief Callbacks ต่อ channel และ context
+ */
+static TIM_ChannelCallback tim_ch_callbacks[2][4];
+static void* tim_ch_contexts[2][4];
+
+/**
+ * @brief CC flags ที่มี channel callback (ส่วนที่เหลือไป TIM_CCHandler)
+ */
+static uint16_t tim_ch_mask[2] = {0, 0};
+
+// Update/CC/channel callback tables (SimpleHAL_RamReport())
+const uint16_t tim_ram_bytes = sizeof(tim_callbacks) + sizeof(tim_cc_handlers) +
+                               sizeof(tim_ch_callbacks) + sizeof(tim_ch_contexts) +
+                               sizeof(tim_ch_mask);
+
+#if SIMPLE_TIM_ISR_IN_RAM
+#define TIM_ISR_SECTION  __attribute__((section(".highcode")))
+#else
+#define TIM_ISR_SECTION
+#endif
+
 /* ========== Internal Helper Functions ========== */
 
 /**
@@ -48,16 +110,88 @@ static TIM_TypeDef* getTIM(TIM_Instance timer) {
     return tim_peripherals[timer];
 }
 
+#if SIMPLE_SYSCLOCK_RETIME
+static SysClock_Hook_t tim_sysclock_hook;
+
+/**
+ * @brief SimpleHAL_SetSysClock(): ปรับ prescaler ให้ timer tick เท่าเดิม
+ */
+static void TIM_SysClockChanged(SysClock_Phase phase, uint32_t old_hz, uint32_t new_hz) {
+    (void)old_hz;
+    (void)new_hz;
+    if (phase != SYSCLK_PHASE_POST) return;
+
+    for (uint8_t timer = 0; timer < 2; timer++) {
+        if (tim_retime & (1u << timer)) {
+            SysClock_ScaleTimer(tim_peripherals[timer]);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief ตั้งว่า timer ต้องปรับตาม system clock หรือไม่
+ */
+static void setRetime(TIM_Instance timer, uint8_t enable) {
+    if (enable) {
+        tim_retime |= (uint8_t)(1u << timer);
+#if SIMPLE_SYSCLOCK_RETIME
+        SysClock_AddHook(&tim_sysclock_hook, TIM_SysClockChanged);
+#endif
+    } else {
+        tim_retime &= (uint8_t)~(1u << timer);
+    }
+}
+
 /**
  * @brief เปิด timer clock
  */
 static void enableTimerClock(TIM_Instance timer) {
     if (timer >= 2) return;
     
-    if (timer == TIM_1) {
-        RCC_APB2PeriphClockCmd(tim_rcc[timer], ENABLE);
-    } else {
-        RCC_APB2PeriphClockCmd(tim_rcc[timer], ENABLE);
+    Clock_AcquireOnce(tim_clock[timer], &tim_clocks);
+}
+
+/**
+ * @brief ปิด CC IRQ ถ้าไม่มีผู้ใช้เหลือ (TIM2 ใช้ IRQ ร่วมกับ update)
+ */
+static void releaseCCIrq(TIM_Instance timer) {
+    if (tim_cc_handlers[timer] || tim_ch_mask[timer]) return;
+    if (timer == TIM_2 && tim_callbacks[timer]) return;
+    
+    NVIC_InitTypeDef NVIC_InitStructure = {0};
+    NVIC_InitStructure.NVIC_IRQChannel = tim_cc_irq[timer];
+    NVIC_InitStructure.NVIC_IRQChannelCmd = DISABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+ * @brief เปิด CC IRQ
+ */
+static void enableCCIrq(TIM_Instance timer) {
+    NVIC_InitTypeDef NVIC_InitStructure = {0};
+    NVIC_InitStructure.NVIC_IRQChannel = tim_cc_irq[timer];
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 3;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+ * @brief เรียก callbacks ตาม CC flags ที่ clear แล้ว (อ่าน status มาครั้งเดียว)
+ */
+static inline __attribute__((always_inline))
+void dispatchCC(TIM_Instance timer, TIM_TypeDef* TIMx, uint16_t flags) {
+    uint16_t own = flags & tim_ch_mask[timer];
+    
+    if (own & TIM_IT_CC1) tim_ch_callbacks[timer][0](tim_ch_contexts[timer][0], (uint16_t)TIMx->CH1CVR);
+    if (own & TIM_IT_CC2) tim_ch_callbacks[timer][1](tim_ch_contexts[timer][1], (uint16_t)TIMx->CH2CVR);
+    if (own & TIM_IT_CC3) tim_ch_callbacks[timer][2](tim_ch_contexts[timer][2], (uint16_t)TIMx->CH3CVR);
+    if (own & TIM_IT_CC4) tim_ch_callbacks[timer][3](tim_ch_contexts[timer][3], (uint16_t)TIMx->CH4CVR);
+    
+    flags &= ~own;
+    if (flags && tim_cc_handlers[timer]) {
+        tim_cc_handlers[timer](flags);
     }
 }
 
@@ -67,21 +201,11 @@ static void enableTimerClock(TIM_Instance timer) {
 static void calculateTimerParams(uint32_t frequency_hz, uint16_t* prescaler, uint16_t* period) {
     uint32_t ticks = SystemCoreClock / frequency_hz;
     
-    if (ticks <= 65536) {
-        // ไม่ต้องใช้ prescaler
-        *prescaler = 0;
-        *period = ticks - 1;
-    } else {
-        // ต้องใช้ prescaler
-        *prescaler = (ticks / 65536);
-        *period = (ticks / (*prescaler + 1)) - 1;
-        
-        // ปรับให้ได้ความถี่ใกล้เคียงที่สุด
-        while (*period > 65535) {
-            (*prescaler)++;
-            *period = (ticks / (*prescaler + 1)) - 1;
-        }
-    }
+    // prescaler ต่ำสุดที่ period ไม่เกิน 16 bits: ceil(ticks / 65536) - 1
+    // (shift แทนการค้นหา ไม่ต้องใช้ prescaler = ไม่มีการหารเพิ่ม)
+    uint32_t psc = (ticks - 1) >> 16;
+    *prescaler = (uint16_t)psc;
+    *period = (uint16_t)((psc ? ticks / (psc + 1) : ticks) - 1);
 }
 
 /* ========== Public Functions ========== */
@@ -112,6 +236,7 @@ void TIM_SimpleInit(TIM_Instance timer, uint32_t frequency_hz) {
     
     // Clear update flag
     TIM_ClearFlag(TIMx, TIM_FLAG_Update);
+    setRetime(timer, 1);
 }
 
 /**
@@ -134,6 +259,23 @@ void TIM_Stop(TIM_Instance timer) {
     TIM_Cmd(TIMx, DISABLE);
 }
 
+/**
+ * @brief หยุด timer และคืน clock ให้ SimpleClock
+ */
+void TIM_End(TIM_Instance timer) {
+    TIM_TypeDef* TIMx = getTIM(timer);
+    if (!TIMx) return;
+    
+    TIM_Cmd(TIMx, DISABLE);
+    for (uint8_t channel = 1; channel <= 4; channel++) {
+        TIM_DetachChannelCallback(timer, channel);
+    }
+    TIM_DetachCCHandler(timer);
+    TIM_DetachInterrupt(timer);
+    setRetime(timer, 0);
+    Clock_ReleaseOnce(tim_clock[timer], &tim_clocks);
+}
+
 /**
  * @brief เปลี่ยนความถี่
  */
@@ -197,6 +339,7 @@ void TIM_AttachInterrupt(TIM_Instance timer, void (*callback)(void)) {
     if (!TIMx || !callback) return;
     
     // เก็บ callback
+    tim_deferred &= (uint8_t)~(1u << timer);
     tim_callbacks[timer] = callback;
     
     // เปิด update interrupt
@@ -211,6 +354,42 @@ void TIM_AttachInterrupt(TIM_Instance timer, void (*callback)(void)) {
     NVIC_Init(&NVIC_InitStructure);
 }
 
+/**
+ * @brief เรียก update callback ที่ถูก defer (จาก Event_Dispatch())
+ */
+static void tim_event_handler(uint16_t id, uint16_t arg) {
+    (void)arg;
+    uint8_t timer = EVENT_INDEX(id);
+    
+    if (timer < 2 && tim_callbacks[timer]) {
+        tim_callbacks[timer]();
+    }
+}
+
+/**
+ * @brief ตั้งค่า interrupt callback ที่ทำใน main loop
+ */
+void TIM_AttachInterruptDeferred(TIM_Instance timer, void (*callback)(void)) {
+    if (!getTIM(timer) || !callback) return;
+    
+    Event_SetHandler(EVENT_SOURCE_TIM, tim_event_handler);
+    TIM_AttachInterrupt(timer, callback);
+    tim_deferred |= (uint8_t)(1u << timer);
+}
+
+/**
+ * @brief เรียก update callback หรือ post ไปทำใน main loop (TIM IRQ ใช้ preemption priority 1)
+ */
+static inline __attribute__((always_inline)) void dispatchUpdate(TIM_Instance timer) {
+    if (!tim_callbacks[timer]) return;
+    
+    if (tim_deferred & (1u << timer)) {
+        Event_Defer(EVENT_RING_LOW, EVENT_ID(EVENT_SOURCE_TIM, timer), 0);
+    } else {
+        tim_callbacks[timer]();
+    }
+}
+
 /**
  * @brief ยกเลิก interrupt
  */
@@ -222,13 +401,94 @@ void TIM_DetachInterrupt(TIM_Instance timer) {
     TIM_ITConfig(TIMx, TIM_IT_Update, DISABLE);
     
     // ลบ callback
+    tim_deferred &= (uint8_t)~(1u << timer);
     tim_callbacks[timer] = NULL;
     
-    // ปิด NVIC
-    NVIC_InitTypeDef NVIC_InitStructure = {0};
-    NVIC_InitStructure.NVIC_IRQChannel = tim_irq[timer];
-    NVIC_InitStructure.NVIC_IRQChannelCmd = DISABLE;
-    NVIC_Init(&NVIC_InitStructure);
+    // ปิด NVIC (TIM2 ใช้ IRQ ร่วมกับ capture/compare)
+    if (timer == TIM_1 || (!tim_cc_handlers[timer] && !tim_ch_mask[timer])) {
+        NVIC_InitTypeDef NVIC_InitStructure = {0};
+        NVIC_InitStructure.NVIC_IRQChannel = tim_irq[timer];
+        NVIC_InitStructure.NVIC_IRQChannelCmd = DISABLE;
+        NVIC_Init(&NVIC_InitStructure);
+    }
+}
+
+/**
+ * @brief ตั้งค่า capture/compare handler
+ */
+void TIM_AttachCCHandler(TIM_Instance timer, TIM_CCHandler handler) {
+    TIM_TypeDef* TIMx = getTIM(timer);
+    if (!TIMx || !handler) return;
+    
+    tim_cc_handlers[timer] = handler;
+    
+    // ตั้งค่า NVIC (CC interrupt ของแต่ละ channel เปิดโดยผู้เรียก)
+    enableCCIrq(timer);
+}
+
+/**
+ * @brief ยกเลิก capture/compare handler
+ */
+void TIM_DetachCCHandler(TIM_Instance timer) {
+    TIM_TypeDef* TIMx = getTIM(timer);
+    if (!TIMx) return;
+    
+    // ปิด CC interrupts ที่ไม่มี channel callback
+    TIMx->DMAINTENR &= (uint16_t)~(TIM_CC_FLAGS_MASK & ~tim_ch_mask[timer]);
+    tim_cc_handlers[timer] = NULL;
+    
+    // TIM2 ใช้ IRQ ร่วมกับ update ห้ามปิด NVIC ถ้ายังมี update callback
+    releaseCCIrq(timer);
+}
+
+/* ========== Channel Callbacks ========== */
+
+/**
+ * @brief ตั้ง callback ของ capture/compare channel
+ */
+void TIM_AttachChannelCallback(TIM_Instance timer, uint8_t channel,
+                               TIM_ChannelCallback callback, void* context) {
+    TIM_TypeDef* TIMx = getTIM(timer);
+    if (!TIMx || !callback || channel < 1 || channel > 4) return;
+    
+    uint16_t flag = (uint16_t)(TIM_IT_CC1 << (channel - 1));
+    
+    // ปิด interrupt ของ channel ระหว่างเปลี่ยน callback/context
+    TIMx->DMAINTENR &= (uint16_t)~flag;
+    tim_ch_callbacks[timer][channel - 1] = callback;
+    tim_ch_contexts[timer][channel - 1] = context;
+    tim_ch_mask[timer] |= flag;
+    
+    TIMx->INTFR = (uint16_t)~flag;
+    TIMx->DMAINTENR |= flag;
+    enableCCIrq(timer);
+}
+
+/**
+ * @brief ยกเลิก callback ของ channel
+ */
+void TIM_DetachChannelCallback(TIM_Instance timer, uint8_t channel) {
+    TIM_TypeDef* TIMx = getTIM(timer);
+    if (!TIMx || channel < 1 || channel > 4) return;
+    
+    uint16_t flag = (uint16_t)(TIM_IT_CC1 << (channel - 1));
+    
+    TIMx->DMAINTENR &= (uint16_t)~flag;
+    tim_ch_mask[timer] &= (uint16_t)~flag;
+    tim_ch_callbacks[timer][channel - 1] = NULL;
+    tim_ch_contexts[timer][channel - 1] = NULL;
+    
+    releaseCCIrq(timer);
+}
+
+/**
+ * @brief ตั้งค่า compare ของ channel
+ */
+void Simple_TIM_SetCompare(TIM_Instance timer, uint8_t channel, uint16_t value) {
+    TIM_TypeDef* TIMx = getTIM(timer);
+    if (!TIMx || channel < 1 || channel > 4) return;
+    
+    (&TIMx->CH1CVR)[channel - 1] = value;
 }
 
 /* ========== Advanced Functions ========== */
@@ -252,6 +512,7 @@ void TIM_AdvancedInit(TIM_Instance timer, uint16_t prescaler, uint16_t period, T
     
     TIM_TimeBaseInit(TIMx, &TIM_TimeBaseStructure);
     TIM_ClearFlag(TIMx, TIM_FLAG_Update);
+    setRetime(timer, prescaler != 0);
 }
 
 /**
@@ -304,29 +565,56 @@ void TIM_GenerateUpdate(TIM_Instance timer) {
  */
 void TIM1_UP_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
 void TIM1_UP_IRQHandler(void) {
+    // Counter นับขึ้นจาก 0 ที่ update: CNT × (PSC + 1) = cycles หลัง event
+    ISR_STAT_ENTER_LATENCY(ISR_STAT_TIM1_UP, (uint32_t)TIM1->CNT * (TIM1->PSC + 1));
     if (TIM_GetITStatus(TIM1, TIM_IT_Update) != RESET) {
         // เรียก callback
-        if (tim_callbacks[TIM_1]) {
-            tim_callbacks[TIM_1]();
-        }
+        dispatchUpdate(TIM_1);
         
         // Clear flag
         TIM_ClearITPendingBit(TIM1, TIM_IT_Update);
     }
+    ISR_STAT_EXIT(ISR_STAT_TIM1_UP);
+}
+
+/**
+ * @brief TIM1 capture/compare interrupt handler
+ */
+void TIM1_CC_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast"))) TIM_ISR_SECTION;
+void TIM1_CC_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_TIM1_CC);
+    uint16_t flags = TIM1->INTFR & TIM1->DMAINTENR & TIM_CC_FLAGS_MASK;
+    
+    // Clear ก่อนเรียก handler เพื่อไม่ให้ทับ event ที่เกิดระหว่าง handler
+    TIM1->INTFR = (uint16_t)~flags;
+    
+    if (flags) {
+        dispatchCC(TIM_1, TIM1, flags);
+    }
+    ISR_STAT_EXIT(ISR_STAT_TIM1_CC);
 }
 
 /**
  * @brief TIM2 interrupt handler
  */
-void TIM2_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+void TIM2_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast"))) TIM_ISR_SECTION;
 void TIM2_IRQHandler(void) {
+    // Latency วัดได้เฉพาะเมื่อมี update ค้าง (capture/compare ไม่มีเวลาอ้างอิง)
+    ISR_STAT_ENTER_LATENCY(ISR_STAT_TIM2, (TIM2->INTFR & TIM_IT_Update)
+                                          ? (uint32_t)TIM2->CNT * (TIM2->PSC + 1) : 0);
+    uint16_t flags = TIM2->INTFR & TIM2->DMAINTENR & TIM_CC_FLAGS_MASK;
+    
+    if (flags) {
+        TIM2->INTFR = (uint16_t)~flags;
+        dispatchCC(TIM_2, TIM2, flags);
+    }
+    
     if (TIM_GetITStatus(TIM2, TIM_IT_Update) != RESET) {
         // เรียก callback
-        if (tim_callbacks[TIM_2]) {
-            tim_callbacks[TIM_2]();
-        }
+        dispatchUpdate(TIM_2);
         
         // Clear flag
         TIM_ClearITPendingBit(TIM2, TIM_IT_Update);
     }
+    ISR_STAT_EXIT(ISR_STAT_TIM2);
 }
@@ -1,8 +1,8 @@
 /**
  * @file SimpleTIM.h
  * @brief Simple Timer Library สำหรับ CH32V003 แบบ Arduino-style
- * @version 1.0
- * @date 2025-12-21
+ * @version 1.4
+ * @date 2026-10-14
  * 
  * @details
  * Library นี้ให้ API ง่ายๆ สำหรับการใช้งาน Timer peripherals
@@ -14,6 +14,8 @@
  * - Interrupt callback support
  * - Start/Stop timer control
  * - Counter reading/writing
+ * - Capture/compare handler สำหรับ module อื่น (เช่น pulseInCapture)
+ * - Callback ต่อ channel (CC1-CC4) พร้อม context: หลาย deadlines บน timer เดียว
  * 
  * **Timer Resources:**
  * - TIM1: Advanced timer (16-bit, 4 channels)
@@ -47,6 +49,27 @@ extern "C" {
 
 #include <ch32v00x_tim.h>
 #include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief วาง TIM1_CC/TIM2 IRQ handlers ใน RAM (.highcode)
+ *
+ * @details ตัดเวลารอ flash (wait state) ออกจาก dispatch ใช้ RAM เพิ่มราว 200 bytes
+ * callback ที่ต้องเร็วเท่ากันให้ประกาศด้วย TIM_RAMFUNC
+ */
+#ifndef SIMPLE_TIM_ISR_IN_RAM
+#define SIMPLE_TIM_ISR_IN_RAM 0
+#endif
+
+/**
+ * @brief วางฟังก์ชันใน RAM (section .highcode ที่ startup copy จาก flash)
+ *
+ * @example
+ * TIM_RAMFUNC void on_deadline(void* context, uint16_t value) { ... }
+ */
+#define TIM_RAMFUNC  __attribute__((section(".highcode"), noinline))
 
 /* ========== Timer Definitions ========== */
 
@@ -66,6 +89,19 @@ typedef enum {
     TIM_MODE_DOWN       /**< Count down mode */
 } TIM_Mode;
 
+/**
+ * @brief Capture/compare handler (low-level)
+ * @param flags CC flags ที่เกิดขึ้น (TIM_IT_CC1 - TIM_IT_CC4) ถูก clear แล้ว
+ */
+typedef void (*TIM_CCHandler)(uint16_t flags);
+
+/**
+ * @brief Callback ของ capture/compare channel
+ * @param context pointer ที่ให้ไว้ตอน attach
+ * @param value ค่า CHxCVR ตอนเกิด event (ค่าที่ capture หรือค่า compare)
+ */
+typedef void (*TIM_ChannelCallback)(void* context, uint16_t value);
+
 /* ========== Function Prototypes ========== */
 
 /**
@@ -75,6 +111,7 @@ typedef enum {
  * 
  * @note ฟังก์ชันนี้จะคำนวณ prescaler และ period อัตโนมัติ
  * @note Timer จะยังไม่เริ่มทำงาน ต้องเรียก TIM_Start() ก่อน
+ * @note ความถี่คงเดิมหลัง SimpleHAL_SetSysClock()
  * 
  * @example
  * TIM_SimpleInit(TIM_1, 1000);  // 1 kHz
@@ -100,6 +137,20 @@ void TIM_Start(TIM_Instance timer);
  */
 void TIM_Stop(TIM_Instance timer);
 
+/**
+ * @brief เลิกใช้ timer: หยุดนับ, ยกเลิก interrupts และคืน clock
+ * @param timer Timer instance (TIM_1 หรือ TIM_2)
+ * 
+ * @note Clock จะถูกปิดจริงใน Clock_GateIdle() (เช่นก่อน PWR_Sleep())
+ *       ถ้าไม่มี module อื่น (เช่น SimplePWM) ใช้ timer เดียวกันอยู่
+ * @note เรียก TIM_SimpleInit() ใหม่เพื่อใช้งานอีกครั้ง
+ * 
+ * @example
+ * TIM_End(TIM_2);
+ * PWR_Sleep();  // TIM2 clock ถูกปิดระหว่าง sleep
+ */
+void TIM_End(TIM_Instance timer);
+
 /**
  * @brief เปลี่ยนความถี่ของ timer
  * @param timer Timer instance (TIM_1 หรือ TIM_2)
@@ -158,6 +209,19 @@ uint16_t TIM_GetPeriod(TIM_Instance timer);
  */
 void TIM_AttachInterrupt(TIM_Instance timer, void (*callback)(void));
 
+/**
+ * @brief ตั้งค่า update callback ที่ทำใน main loop แทน ISR
+ * @param timer TIM_1 หรือ TIM_2
+ * @param callback เรียกจาก Event_Dispatch() (ISR แค่ post event ลง EVENT_RING_LOW)
+ *
+ * @note ต้องเรียก Event_Dispatch() ใน main loop (SimpleEvent.h)
+ * @note Updates ที่ค้างเกินขนาด queue ถูกทิ้ง (Event_Dropped())
+ *
+ * @example
+ * TIM_AttachInterruptDeferred(TIM_1, refresh_display);
+ */
+void TIM_AttachInterruptDeferred(TIM_Instance timer, void (*callback)(void));
+
 /**
  * @brief ยกเลิก update interrupt
  * @param timer Timer instance (TIM_1 หรือ TIM_2)
@@ -167,6 +231,80 @@ void TIM_AttachInterrupt(TIM_Instance timer, void (*callback)(void));
  */
 void TIM_DetachInterrupt(TIM_Instance timer);
 
+/**
+ * @brief ตั้งค่า capture/compare handler (low-level)
+ * @param timer Timer instance (TIM_1 หรือ TIM_2)
+ * @param handler ฟังก์ชันที่จะถูกเรียกจาก ISR พร้อม CC flags
+ * 
+ * @note ฟังก์ชันนี้เปิดเฉพาะ NVIC ผู้เรียกต้องเปิด CC interrupt ของ channel เอง
+ *       (เช่น TIM_ITConfig(TIM2, TIM_IT_CC1, ENABLE))
+ * @note TIM1 ใช้ TIM1_CC_IRQn, TIM2 ใช้ TIM2_IRQn ร่วมกับ update interrupt
+ * @note Timer หนึ่งตัวมี handler ได้ตัวเดียว
+ * 
+ * @example
+ * void my_cc_handler(uint16_t flags) {
+ *     if (flags & TIM_IT_CC1) {
+ *         uint16_t captured = TIM2->CH1CVR;
+ *     }
+ * }
+ * TIM_AttachCCHandler(TIM_2, my_cc_handler);
+ * TIM_ITConfig(TIM2, TIM_IT_CC1, ENABLE);
+ */
+void TIM_AttachCCHandler(TIM_Instance timer, TIM_CCHandler handler);
+
+/**
+ * @brief ยกเลิก capture/compare handler และปิด CC interrupts
+ * @param timer Timer instance (TIM_1 หรือ TIM_2)
+ * 
+ * @example
+ * TIM_DetachCCHandler(TIM_2);
+ */
+void TIM_DetachCCHandler(TIM_Instance timer);
+
+/* ========== Channel Callbacks ========== */
+
+/**
+ * @brief ตั้ง callback ของ capture/compare channel และเปิด interrupt ของ channel
+ * @param timer Timer instance (TIM_1 หรือ TIM_2)
+ * @param channel 1-4
+ * @param callback ฟังก์ชันที่ถูกเรียกจาก ISR
+ * @param context pointer ที่ส่งให้ callback (เช่น struct ของ driver)
+ *
+ * @details ISR อ่าน status register ครั้งเดียว clear แล้วเรียกเฉพาะ channel
+ * ที่มี flag ตั้งอยู่ channel ที่มี callback จะไม่ถูกส่งให้ TIM_CCHandler
+ *
+ * @note Channel ที่ไม่ได้ตั้งเป็น capture/PWM คือ output compare แบบ frozen
+ *       (ไม่ขับขา) จึงใช้เป็น deadline timer ได้ทันที
+ *
+ * @example
+ * // 2 deadlines อิสระบน TIM2 ที่ 1 MHz
+ * static void on_led(void* context, uint16_t value) {
+ *     Simple_TIM_SetCompare(TIM_2, 1, value + 500);    // อีก 500 us
+ * }
+ * static void on_sample(void* context, uint16_t value) {
+ *     Simple_TIM_SetCompare(TIM_2, 2, value + 125);    // 8 kHz
+ * }
+ * TIM_AdvancedInit(TIM_2, 47, 0xFFFF, TIM_MODE_UP);
+ * TIM_AttachChannelCallback(TIM_2, 1, on_led, NULL);
+ * TIM_AttachChannelCallback(TIM_2, 2, on_sample, &adc_state);
+ * TIM_Start(TIM_2);
+ */
+void TIM_AttachChannelCallback(TIM_Instance timer, uint8_t channel,
+                               TIM_ChannelCallback callback, void* context);
+
+/**
+ * @brief ยกเลิก callback และปิด interrupt ของ channel
+ */
+void TIM_DetachChannelCallback(TIM_Instance timer, uint8_t channel);
+
+/**
+ * @brief ตั้งค่า compare ของ channel (CHxCVR)
+ * @param timer Timer instance (TIM_1 หรือ TIM_2)
+ * @param channel 1-4
+ * @param value ค่า counter ที่จะเกิด compare event
+ */
+void Simple_TIM_SetCompare(TIM_Instance timer, uint8_t channel, uint16_t value);
+
 /* ========== Advanced Functions ========== */
 
 /**
@@ -178,6 +316,8 @@ void TIM_DetachInterrupt(TIM_Instance timer);
  * 
  * @note ใช้สำหรับการตั้งค่าแบบละเอียด
  * @note Actual frequency = SystemCoreClock / ((prescaler+1) * (period+1))
+ * @note prescaler > 0: SimpleHAL_SetSysClock() ปรับ prescaler ให้ tick เท่าเดิม
+ *       prescaler = 0: นับ HCLK cycles ตรงๆ และไม่ถูกปรับ (อ่านค่าเทียบกับ SystemCoreClock เอง)
  * 
  * @example
  * // 1 kHz @ 48MHz: prescaler=47, period=999
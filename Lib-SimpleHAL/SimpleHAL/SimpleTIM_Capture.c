@@ -0,0 +1,292 @@
+/**
+ * @file SimpleTIM_Capture.c
+ * @brief Hardware Input-Capture Meter Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleTIM_Capture.h"
+#include "SimpleClock.h"
+
+/* ========== Internal Data ========== */
+
+/**
+ * @brief State ของ meter ต่อ timer
+ */
+typedef struct {
+    volatile uint32_t overflows;    /**< overflow นับจากขอบขึ้นล่าสุด */
+    uint32_t width;                 /**< ความกว้าง pulse ของคาบปัจจุบัน (ticks) */
+    uint32_t sum_period;            /**< ผลรวมคาบที่กำลังเฉลี่ย */
+    uint32_t sum_width;
+    uint32_t limit;                 /**< overflows ที่ถือว่าสัญญาณหาย */
+    volatile uint32_t result_period;
+    volatile uint32_t result_width;
+    volatile uint8_t result_count;  /**< จำนวนคาบในผลวัด, 0 = ไม่มีสัญญาณ */
+    volatile uint8_t fresh;
+    uint8_t count;
+    uint8_t average;
+    uint8_t synced;                 /**< เห็นขอบขึ้นแล้ว (คาบถัดไปสมบูรณ์) */
+    uint8_t width_valid;
+    uint8_t input;
+} Capture_State;
+
+static Capture_State capture_state[2];
+
+/**
+ * @brief Pin ของแต่ละ input
+ */
+static const struct {
+    GPIO_TypeDef* port;
+    uint16_t pin;
+} capture_pins[4] = {
+    {GPIOD, GPIO_Pin_2},  // CAPTURE_TIM1_CH1
+    {GPIOA, GPIO_Pin_1},  // CAPTURE_TIM1_CH2
+    {GPIOD, GPIO_Pin_4},  // CAPTURE_TIM2_CH1
+    {GPIOD, GPIO_Pin_3}   // CAPTURE_TIM2_CH2
+};
+
+static TIM_TypeDef* const capture_timers[2] = {TIM1, TIM2};
+
+/**
+ * @brief GPIO clocks ที่ถืออยู่ (bitmask ของ Clock_Periph)
+ */
+static uint16_t capture_clocks = 0;
+
+/* ========== Internal Helper Functions ========== */
+
+static inline uint32_t Capture_Lock(void) {
+    uint32_t mstatus;
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+    return mstatus;
+}
+
+static inline void Capture_Unlock(uint32_t mstatus) {
+    if (mstatus & 0x8) {
+        __asm volatile ("csrsi mstatus, 0x8");
+    }
+}
+
+/**
+ * @brief ปิดผลวัดของคาบที่สะสมไว้
+ */
+static void Capture_Publish(Capture_State* s) {
+    s->result_period = s->sum_period;
+    s->result_width = s->sum_width;
+    s->result_count = s->count;
+    s->fresh = 1;
+
+    s->sum_period = 0;
+    s->sum_width = 0;
+    s->count = 0;
+}
+
+/**
+ * @brief Capture handler ร่วมของ TIM1/TIM2
+ */
+static void Capture_Handle(TIM_Instance timer, uint16_t flags) {
+    Capture_State* s = &capture_state[timer];
+    TIM_TypeDef* TIMx = capture_timers[timer];
+
+    // Input CH1: CC1 = คาบ, CC2 = ความกว้าง (CH2 สลับกัน)
+    uint8_t ch2 = s->input & 1;
+    uint16_t period_flag = ch2 ? TIM_IT_CC2 : TIM_IT_CC1;
+    uint16_t width_flag = ch2 ? TIM_IT_CC1 : TIM_IT_CC2;
+    volatile uint32_t* period_ccr = ch2 ? &TIMx->CH2CVR : &TIMx->CH1CVR;
+    volatile uint32_t* width_ccr = ch2 ? &TIMx->CH1CVR : &TIMx->CH2CVR;
+
+    // Overflow ที่ค้างอยู่พร้อม capture: จัดการที่นี่เพื่อรู้ลำดับก่อนหลัง
+    uint32_t ovf = s->overflows;
+    uint32_t wrapped = 0;
+    if (TIMx->INTFR & TIM_IT_Update) {
+        TIMx->INTFR = (uint16_t)~TIM_IT_Update;
+        wrapped = 1;
+    }
+
+    if (flags & width_flag) {
+        uint16_t cv = (uint16_t)*width_ccr;
+        // Capture ครึ่งล่าง = overflow เกิดก่อนขอบลง
+        s->width = ((ovf + ((wrapped && cv < 0x8000) ? 1 : 0)) << 16) | cv;
+        s->width_valid = 1;
+    }
+
+    if (flags & period_flag) {
+        uint16_t cv = (uint16_t)*period_ccr;
+        // Counter ถูก reset ที่ขอบขึ้น overflow ที่ค้างจึงเกิดก่อนเสมอ
+        uint32_t period = ((ovf + wrapped) << 16) | cv;
+
+        if (s->synced && s->width_valid) {
+            s->sum_period += period;
+            s->sum_width += s->width;
+            if (++s->count >= s->average || (s->sum_period & 0x80000000UL)) {
+                Capture_Publish(s);
+            }
+        }
+        s->synced = 1;
+        s->width_valid = 0;
+        ovf = 0;
+        wrapped = 0;
+    }
+
+    s->overflows = ovf + wrapped;
+}
+
+/**
+ * @brief นับ overflow และตรวจ timeout
+ */
+static void Capture_Overflow(TIM_Instance timer) {
+    Capture_State* s = &capture_state[timer];
+
+    if (s->overflows >= s->limit) return;  // หายไปแล้ว (รายงานไปครั้งเดียว)
+
+    if (++s->overflows >= s->limit) {
+        s->sum_period = 0;
+        s->sum_width = 0;
+        s->count = 0;
+        Capture_Publish(s);   // result_count = 0 → ไม่มีสัญญาณ
+        s->synced = 0;        // คาบถัดไปไม่สมบูรณ์
+        s->width_valid = 0;
+    }
+}
+
+static void Capture_TIM1_CC(uint16_t flags) { Capture_Handle(TIM_1, flags); }
+static void Capture_TIM2_CC(uint16_t flags) { Capture_Handle(TIM_2, flags); }
+static void Capture_TIM1_Update(void) { Capture_Overflow(TIM_1); }
+static void Capture_TIM2_Update(void) { Capture_Overflow(TIM_2); }
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่มวัดความถี่และ duty cycle
+ */
+void Capture_Init(Capture_Input input, uint8_t average) {
+    if (input > CAPTURE_TIM2_CH2) return;
+
+    TIM_Instance timer = CAPTURE_INPUT_TIMER(input);
+    TIM_TypeDef* TIMx = capture_timers[timer];
+    Capture_State* s = &capture_state[timer];
+
+    TIM_End(timer);
+    s->overflows = 0;
+    s->sum_period = 0;
+    s->sum_width = 0;
+    s->result_period = 0;
+    s->result_width = 0;
+    s->result_count = 0;
+    s->fresh = 0;
+    s->count = 0;
+    s->average = average ? average : 1;
+    s->synced = 0;
+    s->width_valid = 0;
+    s->input = (uint8_t)input;
+    s->limit = (((SystemCoreClock / 1000) * SIMPLE_CAPTURE_TIMEOUT_MS) >> 16) + 1;
+
+    Clock_AcquireOnce(Clock_GPIOPeriph(capture_pins[input].port), &capture_clocks);
+    GPIO_InitTypeDef GPIO_InitStructure = {0};
+    GPIO_InitStructure.GPIO_Pin = capture_pins[input].pin;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU;
+    GPIO_Init(capture_pins[input].port, &GPIO_InitStructure);
+
+    // Free-running 16-bit counter ที่ SystemCoreClock
+    TIM_AdvancedInit(timer, 0, 0xFFFF, TIM_MODE_UP);
+
+    // PWM input: capture ทั้งสองขอบจากขาเดียว
+    TIM_ICInitTypeDef TIM_ICInitStructure = {0};
+    TIM_ICInitStructure.TIM_Channel = (input & 1) ? TIM_Channel_2 : TIM_Channel_1;
+    TIM_ICInitStructure.TIM_ICPolarity = TIM_ICPolarity_Rising;
+    TIM_ICInitStructure.TIM_ICSelection = TIM_ICSelection_DirectTI;
+    TIM_ICInitStructure.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+    TIM_ICInitStructure.TIM_ICFilter = SIMPLE_CAPTURE_FILTER;
+    TIM_PWMIConfig(TIMx, &TIM_ICInitStructure);
+
+    // Reset counter ทุกขอบขึ้น และให้ update เกิดจาก overflow เท่านั้น
+    TIM_SelectInputTrigger(TIMx, (input & 1) ? TIM_TS_TI2FP2 : TIM_TS_TI1FP1);
+    TIM_SelectSlaveMode(TIMx, TIM_SlaveMode_Reset);
+    TIM_UpdateRequestConfig(TIMx, TIM_UpdateSource_Regular);
+
+    TIMx->INTFR = 0;
+    TIM_AttachCCHandler(timer, timer == TIM_1 ? Capture_TIM1_CC : Capture_TIM2_CC);
+    TIM_AttachInterrupt(timer, timer == TIM_1 ? Capture_TIM1_Update : Capture_TIM2_Update);
+    TIM_ITConfig(TIMx, TIM_IT_CC1 | TIM_IT_CC2, ENABLE);
+    TIM_Start(timer);
+}
+
+/**
+ * @brief หยุดวัดและคืน timer
+ */
+void Capture_End(Capture_Input input) {
+    if (input > CAPTURE_TIM2_CH2) return;
+
+    TIM_Instance timer = CAPTURE_INPUT_TIMER(input);
+    TIM_TypeDef* TIMx = capture_timers[timer];
+
+    TIM_SelectSlaveMode(TIMx, 0);
+    TIM_CCxCmd(TIMx, TIM_Channel_1, TIM_CCx_Disable);
+    TIM_CCxCmd(TIMx, TIM_Channel_2, TIM_CCx_Disable);
+    TIM_End(timer);
+    Clock_ReleaseOnce(Clock_GPIOPeriph(capture_pins[input].port), &capture_clocks);
+}
+
+/**
+ * @brief ตรวจสอบผลวัดใหม่
+ */
+uint8_t Capture_Available(Capture_Input input) {
+    if (input > CAPTURE_TIM2_CH2) return 0;
+    return capture_state[CAPTURE_INPUT_TIMER(input)].fresh;
+}
+
+/**
+ * @brief อ่านความถี่ × 100
+ */
+uint32_t Capture_GetFrequencyHz_x100(Capture_Input input) {
+    if (input > CAPTURE_TIM2_CH2) return 0;
+    Capture_State* s = &capture_state[CAPTURE_INPUT_TIMER(input)];
+
+    uint32_t mstatus = Capture_Lock();
+    uint32_t period = s->result_period;
+    uint8_t count = s->result_count;
+    s->fresh = 0;
+    Capture_Unlock(mstatus);
+
+    if (!count || !period) return 0;
+
+    // f × 100 = clock × 100 × N / ticks (64-bit: 48 MHz × 100 เกิน 32 bits)
+    return (uint32_t)(((uint64_t)SystemCoreClock * 100 * count + (period >> 1)) / period);
+}
+
+/**
+ * @brief อ่าน duty cycle × 10
+ */
+uint16_t Capture_GetDuty_x10(Capture_Input input) {
+    if (input > CAPTURE_TIM2_CH2) return 0;
+    Capture_State* s = &capture_state[CAPTURE_INPUT_TIMER(input)];
+
+    uint32_t mstatus = Capture_Lock();
+    uint32_t period = s->result_period;
+    uint32_t width = s->result_width;
+    uint8_t count = s->result_count;
+    s->fresh = 0;
+    Capture_Unlock(mstatus);
+
+    if (!count || !period) {
+        // ไม่มีสัญญาณ: ขาค้าง HIGH = 100%, LOW = 0%
+        return (capture_pins[input].port->INDR & capture_pins[input].pin) ? 1000 : 0;
+    }
+
+    uint32_t duty = (uint32_t)(((uint64_t)width * 1000 + (period >> 1)) / period);
+    return (uint16_t)(duty > 1000 ? 1000 : duty);
+}
+
+/**
+ * @brief อ่านคาบเฉลี่ยเป็น ticks
+ */
+uint32_t Capture_GetPeriodTicks(Capture_Input input) {
+    if (input > CAPTURE_TIM2_CH2) return 0;
+    Capture_State* s = &capture_state[CAPTURE_INPUT_TIMER(input)];
+
+    uint32_t mstatus = Capture_Lock();
+    uint32_t period = s->result_period;
+    uint8_t count = s->result_count;
+    Capture_Unlock(mstatus);
+
+    return count ? (period + (count >> 1)) / count : 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file SimpleTIM_Capture.h
+ * @brief Hardware Input-Capture Frequency / Duty Meter สำหรับ CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * วัดความถี่และ duty cycle ด้วย PWM-input mode ของ TIM1/TIM2:
+ * สัญญาณเข้าขาเดียว ใช้ 2 capture channels (ขอบขึ้น = คาบ, ขอบลง = ความกว้าง pulse)
+ * และ slave reset mode ล้าง counter ทุกขอบขึ้น hardware จึงจับเวลาทุกขอบเอง
+ * CPU ทำงานแค่ครั้งละ 1 interrupt ต่อคาบ (เทียบกับ EXTI ที่ต้องจับทุกขอบใน software)
+ *
+ * **คุณสมบัติ:**
+ * - ความละเอียด 1 timer tick (20.8 ns ที่ 48 MHz)
+ * - ขยาย counter เป็น 32 bits ด้วย overflow count: วัดได้ถึงต่ำกว่า 1 Hz
+ * - เฉลี่ยผลจาก N คาบ (ลด jitter ของ tacho/flow sensor และจำนวน interrupt ที่ต้องอ่าน)
+ * - คืนค่าเป็น fixed-point (Hz × 100, duty × 10) ไม่ใช้ float
+ * - Timeout: สัญญาณหาย → ความถี่ 0, duty = 0 หรือ 100% ตามระดับของขา
+ *
+ * **Input Pins (default mapping):**
+ * - CAPTURE_TIM1_CH1: PD2, CAPTURE_TIM1_CH2: PA1
+ * - CAPTURE_TIM2_CH1: PD4, CAPTURE_TIM2_CH2: PD3
+ *
+ * @example
+ * // Fan tacho (2 pulses/rev) บน PD4
+ * Capture_Init(CAPTURE_TIM2_CH1, 8);
+ *
+ * while (1) {
+ *     if (Capture_Available(CAPTURE_TIM2_CH1)) {
+ *         uint32_t hz_x100 = Capture_GetFrequencyHz_x100(CAPTURE_TIM2_CH1);
+ *         uint32_t rpm = hz_x100 * 60 / 200;
+ *         uint16_t duty = Capture_GetDuty_x10(CAPTURE_TIM2_CH1);  // 0-1000
+ *     }
+ * }
+ *
+ * @note ใช้ timer ทั้งตัว (ห้ามใช้ร่วมกับ SimplePWM/SimpleTIM บน timer เดียวกัน)
+ * @note ความถี่สูงสุดจำกัดด้วยเวลาของ ISR (ประมาณ 100-200 kHz ที่ 48 MHz)
+ */
+
+#ifndef __SIMPLE_TIM_CAPTURE_H
+#define __SIMPLE_TIM_CAPTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleTIM.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief เวลาที่ไม่มีขอบขึ้นแล้วถือว่าสัญญาณหาย (ms)
+ */
+#ifndef SIMPLE_CAPTURE_TIMEOUT_MS
+#define SIMPLE_CAPTURE_TIMEOUT_MS 1000
+#endif
+
+/**
+ * @brief Input filter ของ capture (ICxF, 0-15) กรอง glitch สั้นๆ
+ */
+#ifndef SIMPLE_CAPTURE_FILTER
+#define SIMPLE_CAPTURE_FILTER 0
+#endif
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief ขา input ของ meter (timer ละ 1 input)
+ */
+typedef enum {
+    CAPTURE_TIM1_CH1 = 0,  /**< PD2 */
+    CAPTURE_TIM1_CH2,      /**< PA1 */
+    CAPTURE_TIM2_CH1,      /**< PD4 */
+    CAPTURE_TIM2_CH2       /**< PD3 */
+} Capture_Input;
+
+/**
+ * @brief Timer ของ input
+ */
+#define CAPTURE_INPUT_TIMER(input)  ((TIM_Instance)((input) >> 1))
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่มวัดความถี่และ duty cycle
+ * @param input ขา input (CAPTURE_TIM1_CH1 - CAPTURE_TIM2_CH2)
+ * @param average จำนวนคาบที่เฉลี่ยต่อ 1 ผลวัด (1-255)
+ *
+ * @note Timer นับที่ SystemCoreClock (prescaler 1) ขาเป็น input pull-up
+ * @note ผลวัดแรกออกหลังคาบที่สมบูรณ์ครบ average คาบ (คาบแรกถูกทิ้ง)
+ * @note คาบยาวมาก (sum เกิน 2^31 ticks ≈ 44 s) ปิดผลวัดก่อนครบ average
+ *
+ * @example
+ * Capture_Init(CAPTURE_TIM1_CH1, 1);  // ทุกคาบ
+ */
+void Capture_Init(Capture_Input input, uint8_t average);
+
+/**
+ * @brief หยุดวัดและคืน timer
+ */
+void Capture_End(Capture_Input input);
+
+/**
+ * @brief ตรวจสอบว่ามีผลวัดใหม่หลังการอ่านครั้งก่อน
+ * @return 1 = มีผลใหม่ (หรือเพิ่งตรวจพบว่าสัญญาณหาย)
+ */
+uint8_t Capture_Available(Capture_Input input);
+
+/**
+ * @brief อ่านความถี่ × 100
+ * @return ความถี่ (Hz × 100) เช่น 5000 = 50.00 Hz, 0 = ไม่มีสัญญาณ
+ */
+uint32_t Capture_GetFrequencyHz_x100(Capture_Input input);
+
+/**
+ * @brief อ่าน duty cycle × 10
+ * @return 0-1000 (เช่น 253 = 25.3%)
+ */
+uint16_t Capture_GetDuty_x10(Capture_Input input);
+
+/**
+ * @brief อ่านคาบเฉลี่ยเป็น timer ticks (1 tick = 1/SystemCoreClock)
+ * @return ticks ต่อคาบ, 0 = ไม่มีสัญญาณ
+ */
+uint32_t Capture_GetPeriodTicks(Capture_Input input);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_TIM_CAPTURE_H
@@ -0,0 +1,194 @@
+/**
+ * @file SimpleTIM_Encoder.c
+ * @brief Hardware Quadrature Encoder Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleTIM_Encoder.h"
+#include "SimpleClock.h"
+#include "SimpleDelay.h"
+
+/* ========== Internal Data ========== */
+
+/**
+ * @brief State ของ encoder ต่อ timer
+ */
+typedef struct {
+    volatile int32_t high;    /**< ส่วนบนของตำแหน่ง (ทวีคูณของ 65536) */
+    int32_t last_count;       /**< ตำแหน่งตอนคำนวณความเร็วครั้งก่อน */
+    uint32_t last_us;
+    int32_t velocity;         /**< counts/s ล่าสุด */
+} Encoder_State;
+
+static Encoder_State encoder_state[2];
+
+static TIM_TypeDef* const encoder_timers[2] = {TIM1, TIM2};
+
+/**
+ * @brief Pin A/B ของแต่ละ timer
+ */
+static const struct {
+    GPIO_TypeDef* port;
+    uint16_t pin;
+} encoder_pins[2][2] = {
+    {{GPIOD, GPIO_Pin_2}, {GPIOA, GPIO_Pin_1}},  // TIM_1: PD2, PA1
+    {{GPIOD, GPIO_Pin_4}, {GPIOD, GPIO_Pin_3}}   // TIM_2: PD4, PD3
+};
+
+/**
+ * @brief GPIO clocks ที่ถืออยู่ (bitmask ของ Clock_Periph)
+ */
+static uint16_t encoder_clocks = 0;
+
+/* ========== Internal Helper Functions ========== */
+
+static inline uint32_t Encoder_Lock(void) {
+    uint32_t mstatus;
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+    return mstatus;
+}
+
+static inline void Encoder_Unlock(uint32_t mstatus) {
+    if (mstatus & 0x8) {
+        __asm volatile ("csrsi mstatus, 0x8");
+    }
+}
+
+/**
+ * @brief ทิศของ wrap จากค่า counter หลัง wrap
+ *
+ * @details ใช้ค่า counter แทน DIR bit เพราะทิศอาจกลับแล้วก่อน ISR ได้ทำงาน
+ * หลังล้นขึ้น counter อยู่ใกล้ 0, หลังล้นลงอยู่ใกล้ 0xFFFF
+ */
+static inline int32_t Encoder_WrapStep(uint16_t cnt) {
+    return (cnt < 0x8000) ? 0x10000 : -0x10000;
+}
+
+static void Encoder_Overflow(TIM_Instance timer) {
+    encoder_state[timer].high += Encoder_WrapStep((uint16_t)encoder_timers[timer]->CNT);
+}
+
+static void Encoder_TIM1_Update(void) { Encoder_Overflow(TIM_1); }
+static void Encoder_TIM2_Update(void) { Encoder_Overflow(TIM_2); }
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่มต้น encoder interface mode
+ */
+void Encoder_Init(TIM_Instance timer, uint8_t filter) {
+    if (timer > TIM_2) return;
+
+    TIM_TypeDef* TIMx = encoder_timers[timer];
+
+    TIM_End(timer);
+
+    for (uint8_t i = 0; i < 2; i++) {
+        Clock_AcquireOnce(Clock_GPIOPeriph(encoder_pins[timer][i].port), &encoder_clocks);
+        GPIO_InitTypeDef GPIO_InitStructure = {0};
+        GPIO_InitStructure.GPIO_Pin = encoder_pins[timer][i].pin;
+        GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU;
+        GPIO_Init(encoder_pins[timer][i].port, &GPIO_InitStructure);
+    }
+
+    // ARR เต็ม 16 bits: overflow/underflow ทุก 65536 counts
+    TIM_AdvancedInit(timer, 0, 0xFFFF, TIM_MODE_UP);
+    TIM_EncoderInterfaceConfig(TIMx, TIM_EncoderMode_TI12,
+                               TIM_ICPolarity_Rising, TIM_ICPolarity_Rising);
+
+    // Filter ทั้ง 2 ขา (IC1F, IC2F)
+    filter &= 0x0F;
+    TIMx->CHCTLR1 = (TIMx->CHCTLR1 & ~(TIM_IC1F | TIM_IC2F)) |
+                    ((uint16_t)filter << 4) | ((uint16_t)filter << 12);
+
+    TIMx->CNT = 0;
+    encoder_state[timer].high = 0;
+    encoder_state[timer].last_count = 0;
+    encoder_state[timer].last_us = Get_CurrentUs();
+    encoder_state[timer].velocity = 0;
+
+    TIM_ClearFlag(TIMx, TIM_FLAG_Update);
+    TIM_AttachInterrupt(timer, timer == TIM_1 ? Encoder_TIM1_Update : Encoder_TIM2_Update);
+    TIM_Start(timer);
+}
+
+/**
+ * @brief หยุด encoder และคืน timer
+ */
+void Encoder_End(TIM_Instance timer) {
+    if (timer > TIM_2) return;
+
+    TIM_SelectSlaveMode(encoder_timers[timer], 0);
+    TIM_End(timer);
+    for (uint8_t i = 0; i < 2; i++) {
+        Clock_ReleaseOnce(Clock_GPIOPeriph(encoder_pins[timer][i].port), &encoder_clocks);
+    }
+}
+
+/**
+ * @brief อ่านตำแหน่ง 32-bit
+ */
+int32_t Encoder_GetCount(TIM_Instance timer) {
+    if (timer > TIM_2) return 0;
+
+    TIM_TypeDef* TIMx = encoder_timers[timer];
+
+    uint32_t mstatus = Encoder_Lock();
+    int32_t high = encoder_state[timer].high;
+    uint16_t cnt = (uint16_t)TIMx->CNT;
+    if (TIMx->INTFR & TIM_IT_Update) {
+        // Wrap ที่ ISR ยังไม่ได้นับ (อาจเกิดหลังอ่าน CNT: อ่านใหม่)
+        cnt = (uint16_t)TIMx->CNT;
+        high += Encoder_WrapStep(cnt);
+    }
+    Encoder_Unlock(mstatus);
+
+    return high + cnt;
+}
+
+/**
+ * @brief ตั้งตำแหน่ง
+ */
+void Encoder_SetCount(TIM_Instance timer, int32_t count) {
+    if (timer > TIM_2) return;
+
+    TIM_TypeDef* TIMx = encoder_timers[timer];
+
+    uint32_t mstatus = Encoder_Lock();
+    TIMx->CNT = (uint16_t)count;
+    TIMx->INTFR = (uint16_t)~TIM_IT_Update;
+    encoder_state[timer].high = count - (int32_t)(uint16_t)count;
+    encoder_state[timer].last_count = count;
+    Encoder_Unlock(mstatus);
+}
+
+/**
+ * @brief ประมาณความเร็ว (counts/s)
+ */
+int32_t Encoder_GetVelocity(TIM_Instance timer) {
+    if (timer > TIM_2) return 0;
+
+    Encoder_State* s = &encoder_state[timer];
+    uint32_t now = Get_CurrentUs();
+    uint32_t elapsed = now - s->last_us;
+
+    if (elapsed >= SIMPLE_ENCODER_VELOCITY_MIN_US) {
+        int32_t count = Encoder_GetCount(timer);
+        int32_t delta = count - s->last_count;
+
+        s->velocity = (int32_t)(((int64_t)delta * 1000000) / (int32_t)elapsed);
+        s->last_count = count;
+        s->last_us = now;
+    }
+
+    return s->velocity;
+}
+
+/**
+ * @brief ทิศทางล่าสุด
+ */
+uint8_t Encoder_GetDirection(TIM_Instance timer) {
+    if (timer > TIM_2) return 0;
+    return (encoder_timers[timer]->CTLR1 & TIM_DIR) ? 1 : 0;
+}
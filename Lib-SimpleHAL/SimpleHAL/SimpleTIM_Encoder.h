@@ -0,0 +1,104 @@
+/**
+ * @file SimpleTIM_Encoder.h
+ * @brief Hardware Quadrature Encoder สำหรับ CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * ถอดรหัส rotary/motor encoder (A/B) ด้วย encoder interface mode ของ TIM1/TIM2:
+ * timer นับขึ้น/ลงเองทุกขอบของทั้งสองขา (x4) โดยไม่มี interrupt ต่อขอบ
+ * CPU ทำงานเฉพาะตอน counter 16-bit ล้น (ทุก 65536 counts) เพื่อขยายเป็น 32 bits
+ *
+ * **คุณสมบัติ:**
+ * - นับที่ความเร็วเต็มของ timer (หลาย MHz) ไม่หลุด count
+ * - ตำแหน่ง 32-bit แบบ signed (อ่านได้ทุกเวลา ไม่ขาดช่วงตอน overflow)
+ * - Hardware input filter กรอง contact bounce ของ encoder แบบกลไก
+ * - ประมาณความเร็ว (counts/s) จากตำแหน่งและ Get_CurrentUs()
+ *
+ * **Input Pins (default mapping):**
+ * - TIM_1: A = PD2 (CH1), B = PA1 (CH2)
+ * - TIM_2: A = PD4 (CH1), B = PD3 (CH2)
+ *
+ * @example
+ * Encoder_Init(TIM_2, 6);  // filter กลางๆ สำหรับ encoder แบบกลไก
+ *
+ * while (1) {
+ *     int32_t pos = Encoder_GetCount(TIM_2);
+ *     int32_t cps = Encoder_GetVelocity(TIM_2);
+ *     Delay_Ms(10);
+ * }
+ *
+ * @note ใช้ timer ทั้งตัว (ห้ามใช้ร่วมกับ SimplePWM/SimpleTIM_Capture บน timer เดียวกัน)
+ * @note ขาเป็น input pull-up (encoder แบบ open-collector/กลไกไม่ต้องมี resistor ภายนอก)
+ */
+
+#ifndef __SIMPLE_TIM_ENCODER_H
+#define __SIMPLE_TIM_ENCODER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleTIM.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief ช่วงเวลาต่ำสุดระหว่างการคำนวณความเร็ว (us)
+ *
+ * @details Encoder_GetVelocity() ที่เรียกถี่กว่านี้คืนค่าเดิม
+ * (ช่วงสั้นเกินไปทำให้ความละเอียดของความเร็วต่ำ)
+ */
+#ifndef SIMPLE_ENCODER_VELOCITY_MIN_US
+#define SIMPLE_ENCODER_VELOCITY_MIN_US 1000
+#endif
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่มต้น encoder interface mode
+ * @param timer TIM_1 หรือ TIM_2
+ * @param filter input filter ICxF (0 = ไม่กรอง, 1-15 = กรองมากขึ้น)
+ *
+ * @note นับ x4 (ทุกขอบของ A และ B) ตำแหน่งเริ่มที่ 0
+ * @note filter 15 = ต้องนิ่ง 8 samples ที่ fCK/32 (~5.3 us ที่ 48 MHz)
+ */
+void Encoder_Init(TIM_Instance timer, uint8_t filter);
+
+/**
+ * @brief หยุด encoder และคืน timer
+ */
+void Encoder_End(TIM_Instance timer);
+
+/**
+ * @brief อ่านตำแหน่ง 32-bit
+ * @return counts (x4) แบบ signed
+ */
+int32_t Encoder_GetCount(TIM_Instance timer);
+
+/**
+ * @brief ตั้งตำแหน่ง (เช่น 0 เมื่อถึง home switch)
+ */
+void Encoder_SetCount(TIM_Instance timer, int32_t count);
+
+/**
+ * @brief ประมาณความเร็วจากตำแหน่งที่เปลี่ยนตั้งแต่การเรียกครั้งก่อน
+ * @return counts ต่อวินาที (ลบ = หมุนกลับ)
+ *
+ * @note เรียกเป็นระยะสม่ำเสมอ (เช่นทุก 10 ms ใน control loop)
+ */
+int32_t Encoder_GetVelocity(TIM_Instance timer);
+
+/**
+ * @brief ทิศทางล่าสุดจาก hardware
+ * @return 1 = นับลง, 0 = นับขึ้น
+ */
+uint8_t Encoder_GetDirection(TIM_Instance timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_TIM_ENCODER_H
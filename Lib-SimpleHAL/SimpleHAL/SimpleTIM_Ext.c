@@ -1,22 +1,38 @@
 /**
  * @file SimpleTIM_Ext.c
  * @brief SimpleTIM Extensions Implementation
- * @version 1.0
- * @date 2025-12-21
+ * @version 1.3
+ * @date 2026-10-14
  */
 
 #include "SimpleTIM_Ext.h"
-#include <stdio.h>
+#include "SimpleInit.h"
+#include "SimpleFormat.h"
 
 /* ========== Internal State Variables ========== */
 
+/**
+ * @brief ตัวนับเวลาที่เก็บ HMS/BCD ไว้ล่วงหน้า (อัปเดตทีละ 1 ms ใน ISR)
+ *
+ * @details GetTime/GetTimeString แค่ copy field ไม่ต้องหารทุกครั้งที่ refresh
+ * การหารเกิดเฉพาะตอนตั้งเวลา (Init/Reset)
+ */
+typedef struct {
+    volatile uint32_t ms;        /**< เวลาทั้งหมด (milliseconds) */
+    volatile uint32_t seconds;   /**< ms / 1000 */
+    uint16_t sub;                /**< ms ภายในวินาที (0-999) */
+    Time_t hms;                  /**< normalized */
+    TimeBCD_t bcd;               /**< hms แบบ BCD */
+    volatile uint8_t changed;    /**< TIME_CHANGED_* ตั้งแต่อ่านครั้งก่อน */
+} TimeCounter_t;
+
 // Stopwatch state
-static volatile uint32_t stopwatch_ms = 0;           // เวลาที่ผ่านไป (milliseconds)
+static TimeCounter_t stopwatch;                      // เวลาที่ผ่านไป
 static volatile uint8_t stopwatch_running = 0;       // สถานะการทำงาน
 static uint32_t stopwatch_initial_ms = 0;            // เวลาเริ่มต้น (สำหรับ init)
 
 // Countdown state
-static volatile uint32_t countdown_ms = 0;           // เวลาที่เหลือ (milliseconds)
+static TimeCounter_t countdown;                      // เวลาที่เหลือ
 static uint32_t countdown_initial_ms = 0;            // เวลาเริ่มต้น
 static volatile uint8_t countdown_running = 0;       // สถานะการทำงาน
 static volatile uint8_t countdown_finished = 0;      // สถานะหมดเวลา
@@ -24,86 +40,283 @@ static void (*countdown_alarm_callback)(void) = NULL; // Alarm callback
 
 /* ========== Internal Helper Functions ========== */
 
+static inline uint32_t time_lock(void) {
+    uint32_t mstatus;
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+    return mstatus;
+}
+
+static inline void time_unlock(uint32_t mstatus) {
+    if (mstatus & 0x8) {
+        __asm volatile ("csrsi mstatus, 0x8");
+    }
+}
+
 /**
- * @brief Timer callback - เรียกทุก 1ms
+ * @brief BCD + 1 (ทด 9 → 0 ไปหลักถัดไป)
  */
-static void timer_ext_callback(void) {
-    // Update stopwatch
-    if (stopwatch_running) {
-        stopwatch_ms++;
+static uint16_t bcd_inc(uint16_t x) {
+    for (uint16_t one = 0x0001; one; one <<= 4) {
+        uint16_t nib = (one << 4) - one;   // 0x000F, 0x00F0, ...
+        if ((x & nib) != (one << 3) + one) return x + one;
+        x &= ~nib;
+    }
+    return x;
+}
+
+/**
+ * @brief BCD - 1 (ยืม 0 → 9 จากหลักถัดไป)
+ */
+static uint16_t bcd_dec(uint16_t x) {
+    for (uint16_t one = 0x0001; one; one <<= 4) {
+        uint16_t nib = (one << 4) - one;
+        if (x & nib) return x - one;
+        x |= (one << 3) + one;
+    }
+    return x;
+}
+
+/**
+ * @brief แปลง binary เป็น BCD (ใช้ตอนตั้งเวลาเท่านั้น)
+ */
+static uint16_t bin_to_bcd(uint16_t value) {
+    uint16_t bcd = 0;
+    for (uint8_t shift = 0; value && shift < 16; shift += 4) {
+        uint16_t q = value / 10;
+        bcd |= (uint16_t)(value - q * 10) << shift;
+        value = q;
     }
+    return bcd;
+}
+
+/**
+ * @brief แยกวินาทีเป็น ชั่วโมง/นาที/วินาที
+ * 
+ * @note ใช้การหาร 2 ครั้ง (เศษคำนวณจากการคูณค่าคงที่ซึ่ง compiler แปลงเป็น shift)
+ *       แทน / และ % 4 ครั้ง เพราะ RV32EC ไม่มีคำสั่งหาร
+ */
+static void seconds_to_time(uint32_t total_seconds, Time_t* time) {
+    uint32_t total_minutes = total_seconds / 60;
+    uint16_t hours = total_minutes / 60;
     
-    // Update countdown
-    if (countdown_running && countdown_ms > 0) {
-        countdown_ms--;
-        
-        // Check if finished
-        if (countdown_ms == 0) {
-            countdown_running = 0;
-            countdown_finished = 1;
-            
-            // Call alarm callback
-            if (countdown_alarm_callback != NULL) {
-                countdown_alarm_callback();
-            }
+    time->hours = hours;
+    time->minutes = total_minutes - (uint32_t)hours * 60;
+    time->seconds = total_seconds - total_minutes * 60;
+}
+
+/**
+ * @brief ตั้งตัวนับจาก milliseconds
+ */
+static void time_counter_set(TimeCounter_t* c, uint32_t ms) {
+    uint32_t seconds = ms / 1000;
+    Time_t hms;
+    seconds_to_time(seconds, &hms);
+    
+    uint32_t mstatus = time_lock();
+    c->ms = ms;
+    c->seconds = seconds;
+    c->sub = (uint16_t)(ms - seconds * 1000);
+    c->hms = hms;
+    c->bcd.hours = bin_to_bcd(hms.hours);
+    c->bcd.minutes = (uint8_t)bin_to_bcd(hms.minutes);
+    c->bcd.seconds = (uint8_t)bin_to_bcd(hms.seconds);
+    c->changed = TIME_CHANGED_ALL;
+    time_unlock(mstatus);
+}
+
+/**
+ * @brief นับขึ้น 1 ms (เรียกจาก ISR)
+ */
+static void time_counter_up(TimeCounter_t* c) {
+    c->ms++;
+    if (++c->sub < 1000) return;
+    
+    c->sub = 0;
+    c->seconds++;
+    
+    uint8_t changed = TIME_CHANGED_SECONDS;
+    if (++c->hms.seconds < 60) {
+        c->bcd.seconds = (uint8_t)bcd_inc(c->bcd.seconds);
+    } else {
+        c->hms.seconds = 0;
+        c->bcd.seconds = 0;
+        changed |= TIME_CHANGED_MINUTES;
+        if (++c->hms.minutes < 60) {
+            c->bcd.minutes = (uint8_t)bcd_inc(c->bcd.minutes);
+        } else {
+            c->hms.minutes = 0;
+            c->bcd.minutes = 0;
+            c->hms.hours++;
+            c->bcd.hours = bcd_inc(c->bcd.hours);
+            changed |= TIME_CHANGED_HOURS;
         }
     }
+    c->changed |= changed;
 }
 
 /**
- * @brief แปลง milliseconds เป็น Time_t (normalized mode)
+ * @brief นับลง 1 ms (เรียกจาก ISR เมื่อ ms > 0)
  */
-static void ms_to_time_normalized(uint32_t ms, Time_t* time) {
-    uint32_t total_seconds = ms / 1000;
+static void time_counter_down(TimeCounter_t* c) {
+    c->ms--;
+    if (c->sub) {
+        c->sub--;
+        return;
+    }
+    
+    // ยืมจากวินาที: ms เหลือ N×1000 - 1 → แสดง N - 1 วินาที (ปัดลงเหมือนเดิม)
+    c->sub = 999;
+    c->seconds--;
     
-    time->hours = total_seconds / 3600;
-    time->minutes = (total_seconds % 3600) / 60;
-    time->seconds = total_seconds % 60;
+    uint8_t changed = TIME_CHANGED_SECONDS;
+    if (c->hms.seconds) {
+        c->hms.seconds--;
+        c->bcd.seconds = (uint8_t)bcd_dec(c->bcd.seconds);
+    } else {
+        c->hms.seconds = 59;
+        c->bcd.seconds = 0x59;
+        changed |= TIME_CHANGED_MINUTES;
+        if (c->hms.minutes) {
+            c->hms.minutes--;
+            c->bcd.minutes = (uint8_t)bcd_dec(c->bcd.minutes);
+        } else {
+            c->hms.minutes = 59;
+            c->bcd.minutes = 0x59;
+            c->hms.hours--;
+            c->bcd.hours = bcd_dec(c->bcd.hours);
+            changed |= TIME_CHANGED_HOURS;
+        }
+    }
+    c->changed |= changed;
 }
 
 /**
- * @brief แปลง milliseconds เป็น Time_t (raw mode สำหรับ SS format)
+ * @brief เขียน BCD เป็นตัวเลขอย่างน้อย min_digits หลัก (ตัด 0 นำหน้า)
  */
-static void ms_to_time_raw_ss(uint32_t ms, Time_t* time) {
-    time->hours = 0;
-    time->minutes = 0;
-    time->seconds = ms / 1000;  // ไม่จำกัดค่า
+static char* put_bcd(char* p, uint16_t bcd, uint8_t min_digits) {
+    uint8_t digits = 4;
+    while (digits > min_digits && !(bcd >> ((digits - 1) * 4))) {
+        digits--;
+    }
+    while (digits--) {
+        *p++ = (char)('0' + ((bcd >> (digits * 4)) & 0x0F));
+    }
+    return p;
 }
 
 /**
- * @brief แปลง milliseconds เป็น Time_t (raw mode สำหรับ MMSS format)
+ * @brief สร้าง string จาก snapshot ของตัวนับ
  */
-static void ms_to_time_raw_mmss(uint32_t ms, Time_t* time) {
-    uint32_t total_seconds = ms / 1000;
+static void time_counter_string(TimeCounter_t* c, char* buffer, TimeFormat_t format, TimeDisplayMode_t mode) {
+    uint32_t mstatus = time_lock();
+    TimeBCD_t bcd = c->bcd;
+    Time_t hms = c->hms;
+    uint32_t seconds = c->seconds;
+    time_unlock(mstatus);
+    
+    // Normalized: field แรก zero-padded 2 หลัก, Raw: ไม่จำกัดหลัก
+    uint8_t lead_width = (mode == TIME_DISPLAY_NORMALIZED) ? 2 : 1;
+    char* p = buffer;
     
-    time->hours = 0;
-    time->minutes = total_seconds / 60;  // ไม่จำกัดค่า
-    time->seconds = total_seconds % 60;
+    switch (format) {
+        case TIME_FORMAT_HHMMSS:
+            p = put_bcd(p, bcd.hours, lead_width);
+            *p++ = ':';
+            p = put_bcd(p, bcd.minutes, 2);
+            *p++ = ':';
+            p = put_bcd(p, bcd.seconds, 2);
+            break;
+            
+        case TIME_FORMAT_MMSS:
+            if (mode == TIME_DISPLAY_NORMALIZED) {
+                p = put_bcd(p, bcd.minutes, 2);
+            } else {
+                // Raw: นาทีรวมชั่วโมง (ไม่ค่อยใช้ จึงคำนวณตอนอ่าน)
+                p += Format_UInt(p, (uint32_t)hms.hours * 60 + hms.minutes);
+            }
+            *p++ = ':';
+            p = put_bcd(p, bcd.seconds, 2);
+            break;
+            
+        case TIME_FORMAT_SS:
+            if (mode == TIME_DISPLAY_NORMALIZED) {
+                p = put_bcd(p, bcd.seconds, 1);
+            } else {
+                p += Format_UInt(p, seconds);
+            }
+            break;
+    }
+    *p = '\0';
 }
 
 /**
- * @brief แปลง milliseconds เป็น Time_t (raw mode สำหรับ HHMMSS format)
+ * @brief Copy HMS / BCD / flags ของตัวนับ
  */
-static void ms_to_time_raw_hhmmss(uint32_t ms, Time_t* time) {
-    uint32_t total_seconds = ms / 1000;
-    
-    time->hours = total_seconds / 3600;  // ไม่จำกัดค่า
-    time->minutes = (total_seconds % 3600) / 60;
-    time->seconds = total_seconds % 60;
+static void time_counter_get(TimeCounter_t* c, Time_t* time) {
+    uint32_t mstatus = time_lock();
+    *time = c->hms;
+    time_unlock(mstatus);
 }
 
-/* ========== Stopwatch Functions ========== */
+static void time_counter_get_bcd(TimeCounter_t* c, TimeBCD_t* bcd) {
+    uint32_t mstatus = time_lock();
+    *bcd = c->bcd;
+    time_unlock(mstatus);
+}
 
-void Stopwatch_Init(void) {
-    // Initialize timer at 1000Hz (1ms)
+static uint8_t time_counter_changed(TimeCounter_t* c) {
+    uint32_t mstatus = time_lock();
+    uint8_t changed = c->changed;
+    c->changed = 0;
+    time_unlock(mstatus);
+    return changed;
+}
+
+/**
+ * @brief Timer callback - เรียกทุก 1ms
+ */
+static void timer_ext_callback(void) {
+    // Update stopwatch
+    if (stopwatch_running) {
+        time_counter_up(&stopwatch);
+    }
+    
+    // Update countdown
+    if (countdown_running && countdown.ms > 0) {
+        time_counter_down(&countdown);
+        
+        // Check if finished
+        if (countdown.ms == 0) {
+            countdown_running = 0;
+            countdown_finished = 1;
+            
+            // Call alarm callback
+            if (countdown_alarm_callback != NULL) {
+                countdown_alarm_callback();
+            }
+        }
+    }
+}
+
+/**
+ * @brief เริ่ม TIM2 ที่ 1000Hz (1ms) ใช้ร่วมกันระหว่าง Stopwatch และ Countdown
+ */
+static void timer_ext_hw_init(void) {
     TIM_SimpleInit(TIM_2, 1000);
     TIM_AttachInterrupt(TIM_2, timer_ext_callback);
     TIM_Start(TIM_2);
+}
+
+/* ========== Stopwatch Functions ========== */
+
+void Stopwatch_Init(void) {
+    // Initialize timer if not already done
+    SimpleInit_Ensure(SIMPLE_INIT_TIM_EXT, timer_ext_hw_init);
     
     // Reset state
-    stopwatch_ms = 0;
     stopwatch_running = 0;
     stopwatch_initial_ms = 0;
+    time_counter_set(&stopwatch, 0);
 }
 
 void Stopwatch_Start(void) {
@@ -116,47 +329,34 @@ void Stopwatch_Stop(void) {
 
 void Stopwatch_Reset(void) {
     stopwatch_running = 0;
-    stopwatch_ms = stopwatch_initial_ms;
+    time_counter_set(&stopwatch, stopwatch_initial_ms);
 }
 
 void Stopwatch_GetTime(Time_t* time) {
     if (time == NULL) return;
-    ms_to_time_normalized(stopwatch_ms, time);
+    time_counter_get(&stopwatch, time);
+}
+
+void Stopwatch_GetTimeBCD(TimeBCD_t* bcd) {
+    if (bcd == NULL) return;
+    time_counter_get_bcd(&stopwatch, bcd);
 }
 
 void Stopwatch_GetTimeString(char* buffer, TimeFormat_t format, TimeDisplayMode_t mode) {
     if (buffer == NULL) return;
-    
-    Time_t time;
-    
-    // แปลงตาม mode
-    if (mode == TIME_DISPLAY_NORMALIZED) {
-        ms_to_time_normalized(stopwatch_ms, &time);
-    } else {
-        // RAW mode - แปลงตาม format
-        switch (format) {
-            case TIME_FORMAT_SS:
-                ms_to_time_raw_ss(stopwatch_ms, &time);
-                break;
-            case TIME_FORMAT_MMSS:
-                ms_to_time_raw_mmss(stopwatch_ms, &time);
-                break;
-            case TIME_FORMAT_HHMMSS:
-                ms_to_time_raw_hhmmss(stopwatch_ms, &time);
-                break;
-        }
-    }
-    
-    // Format string
-    Time_ToString(&time, buffer, format, mode);
+    time_counter_string(&stopwatch, buffer, format, mode);
+}
+
+uint8_t Stopwatch_GetChanged(void) {
+    return time_counter_changed(&stopwatch);
 }
 
 uint32_t Stopwatch_GetTotalSeconds(void) {
-    return stopwatch_ms / 1000;
+    return stopwatch.seconds;
 }
 
 uint32_t Stopwatch_GetTotalMilliseconds(void) {
-    return stopwatch_ms;
+    return stopwatch.ms;
 }
 
 uint8_t Stopwatch_IsRunning(void) {
@@ -167,39 +367,21 @@ uint8_t Stopwatch_IsRunning(void) {
 
 void Countdown_Init(uint16_t hours, uint8_t minutes, uint8_t seconds) {
     // แปลงเป็น milliseconds
-    countdown_initial_ms = ((uint32_t)hours * 3600 + (uint32_t)minutes * 60 + seconds) * 1000;
-    countdown_ms = countdown_initial_ms;
-    countdown_running = 0;
-    countdown_finished = 0;
-    
-    // Initialize timer if not already done
-    static uint8_t timer_initialized = 0;
-    if (!timer_initialized) {
-        TIM_SimpleInit(TIM_2, 1000);
-        TIM_AttachInterrupt(TIM_2, timer_ext_callback);
-        TIM_Start(TIM_2);
-        timer_initialized = 1;
-    }
+    Countdown_InitFromSeconds((uint32_t)hours * 3600 + (uint32_t)minutes * 60 + seconds);
 }
 
 void Countdown_InitFromSeconds(uint32_t total_seconds) {
     countdown_initial_ms = total_seconds * 1000;
-    countdown_ms = countdown_initial_ms;
     countdown_running = 0;
     countdown_finished = 0;
+    time_counter_set(&countdown, countdown_initial_ms);
     
     // Initialize timer if not already done
-    static uint8_t timer_initialized = 0;
-    if (!timer_initialized) {
-        TIM_SimpleInit(TIM_2, 1000);
-        TIM_AttachInterrupt(TIM_2, timer_ext_callback);
-        TIM_Start(TIM_2);
-        timer_initialized = 1;
-    }
+    SimpleInit_Ensure(SIMPLE_INIT_TIM_EXT, timer_ext_hw_init);
 }
 
 void Countdown_Start(void) {
-    if (countdown_ms > 0) {
+    if (countdown.ms > 0) {
         countdown_running = 1;
         countdown_finished = 0;
     }
@@ -211,40 +393,27 @@ void Countdown_Stop(void) {
 
 void Countdown_Reset(void) {
     countdown_running = 0;
-    countdown_ms = countdown_initial_ms;
+    time_counter_set(&countdown, countdown_initial_ms);
     countdown_finished = 0;
 }
 
 void Countdown_GetTime(Time_t* time) {
     if (time == NULL) return;
-    ms_to_time_normalized(countdown_ms, time);
+    time_counter_get(&countdown, time);
+}
+
+void Countdown_GetTimeBCD(TimeBCD_t* bcd) {
+    if (bcd == NULL) return;
+    time_counter_get_bcd(&countdown, bcd);
 }
 
 void Countdown_GetTimeString(char* buffer, TimeFormat_t format, TimeDisplayMode_t mode) {
     if (buffer == NULL) return;
-    
-    Time_t time;
-    
-    // แปลงตาม mode
-    if (mode == TIME_DISPLAY_NORMALIZED) {
-        ms_to_time_normalized(countdown_ms, &time);
-    } else {
-        // RAW mode - แปลงตาม format
-        switch (format) {
-            case TIME_FORMAT_SS:
-                ms_to_time_raw_ss(countdown_ms, &time);
-                break;
-            case TIME_FORMAT_MMSS:
-                ms_to_time_raw_mmss(countdown_ms, &time);
-                break;
-            case TIME_FORMAT_HHMMSS:
-                ms_to_time_raw_hhmmss(countdown_ms, &time);
-                break;
-        }
-    }
-    
-    // Format string
-    Time_ToString(&time, buffer, format, mode);
+    time_counter_string(&countdown, buffer, format, mode);
+}
+
+uint8_t Countdown_GetChanged(void) {
+    return time_counter_changed(&countdown);
 }
 
 uint8_t Countdown_IsFinished(void) {
@@ -256,7 +425,7 @@ void Countdown_SetAlarmCallback(void (*callback)(void)) {
 }
 
 uint32_t Countdown_GetRemainingSeconds(void) {
-    return countdown_ms / 1000;
+    return countdown.seconds;
 }
 
 uint8_t Countdown_IsRunning(void) {
@@ -268,30 +437,29 @@ uint8_t Countdown_IsRunning(void) {
 void Time_ToString(Time_t* time, char* buffer, TimeFormat_t format, TimeDisplayMode_t mode) {
     if (time == NULL || buffer == NULL) return;
     
+    // Normalized: field แรก zero-padded 2 หลัก ("02:30:45", "30:45")
+    // Raw: field แรกไม่จำกัดหลัก ("2:30:45", "146:30")
+    uint8_t lead_width = (mode == TIME_DISPLAY_NORMALIZED) ? 2 : 0;
+    char* p = buffer;
+    
     switch (format) {
         case TIME_FORMAT_HHMMSS:
-            if (mode == TIME_DISPLAY_NORMALIZED) {
-                // Normalized: "02:30:45" (zero-padded)
-                sprintf(buffer, "%02u:%02u:%02u", time->hours, time->minutes, time->seconds);
-            } else {
-                // Raw: hours ไม่จำกัด, minutes และ seconds zero-padded
-                sprintf(buffer, "%u:%02u:%02u", time->hours, time->minutes, time->seconds);
-            }
+            p += Format_UIntPad(p, time->hours, lead_width, '0');
+            *p++ = ':';
+            p += Format_UIntPad(p, time->minutes, 2, '0');
+            *p++ = ':';
+            Format_UIntPad(p, time->seconds, 2, '0');
             break;
             
         case TIME_FORMAT_MMSS:
-            if (mode == TIME_DISPLAY_NORMALIZED) {
-                // Normalized: "30:45" (zero-padded)
-                sprintf(buffer, "%02u:%02u", time->minutes, time->seconds);
-            } else {
-                // Raw: minutes ไม่จำกัด, seconds zero-padded
-                sprintf(buffer, "%u:%02u", time->minutes, time->seconds);
-            }
+            p += Format_UIntPad(p, time->minutes, lead_width, '0');
+            *p++ = ':';
+            Format_UIntPad(p, time->seconds, 2, '0');
             break;
             
         case TIME_FORMAT_SS:
             // SS format: แสดงเป็นตัวเลขเท่านั้น
-            sprintf(buffer, "%u", time->seconds);
+            Format_UInt(p, time->seconds);
             break;
     }
 }
@@ -301,9 +469,7 @@ void Time_FromSeconds(uint32_t total_seconds, Time_t* time, TimeDisplayMode_t mo
     
     if (mode == TIME_DISPLAY_NORMALIZED) {
         // Normalized: แปลงตามปกติ
-        time->hours = total_seconds / 3600;
-        time->minutes = (total_seconds % 3600) / 60;
-        time->seconds = total_seconds % 60;
+        seconds_to_time(total_seconds, time);
     } else {
         // Raw: เก็บค่าทั้งหมดใน seconds
         // (ผู้ใช้ต้องเลือก format ที่เหมาะสมเอง)
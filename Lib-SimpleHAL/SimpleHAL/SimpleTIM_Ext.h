@@ -1,8 +1,8 @@
 /**
  * @file SimpleTIM_Ext.h
  * @brief SimpleTIM Extensions - Stopwatch และ Countdown Timer Library
- * @version 1.0
- * @date 2025-12-21
+ * @version 1.1
+ * @date 2026-10-14
  * 
  * @details
  * Library นี้เพิ่มฟังก์ชันการจับเวลาระดับสูงให้กับ SimpleTIM
@@ -15,6 +15,8 @@
  * - 2 โหมดแสดงผล: NORMALIZED และ RAW
  * - Pause/Resume/Reset functionality
  * - Alarm callback สำหรับ countdown
+ * - HMS/BCD อัปเดตทีละขั้นใน tick: GetTime/GetTimeString ไม่มีการหาร
+ * - Changed flags (วินาที/นาที/ชั่วโมง) วาดใหม่เฉพาะหลักที่เปลี่ยน
  * 
  * **Time Formats:**
  * - HH:MM:SS: ชั่วโมง:นาที:วินาที (เช่น 02:30:45)
@@ -55,6 +57,7 @@
 extern "C" {
 #endif
 
+#include "SimpleHAL_Config.h"
 #include "SimpleTIM.h"
 #include <stdint.h>
 #include <string.h>
@@ -87,6 +90,30 @@ typedef struct {
     uint8_t seconds;     /**< วินาที (0-59 normalized, 0-255 raw) */
 } Time_t;
 
+/**
+ * @brief เวลาแบบ BCD (4 bits ต่อหลัก) สำหรับ 7-segment/LCD
+ *
+ * @example
+ * // 02:30:45 → hours = 0x0002, minutes = 0x30, seconds = 0x45
+ * digit[0] = bcd.minutes >> 4;
+ * digit[1] = bcd.minutes & 0x0F;
+ */
+typedef struct {
+    uint16_t hours;      /**< 0x0000-0x9999 */
+    uint8_t minutes;     /**< 0x00-0x59 */
+    uint8_t seconds;     /**< 0x00-0x59 */
+} TimeBCD_t;
+
+/* ========== Changed Flags ========== */
+
+/**
+ * @brief Field ที่เปลี่ยนตั้งแต่อ่าน flags ครั้งก่อน (Stopwatch_GetChanged)
+ */
+#define TIME_CHANGED_SECONDS  0x01
+#define TIME_CHANGED_MINUTES  0x02
+#define TIME_CHANGED_HOURS    0x04
+#define TIME_CHANGED_ALL      0x07   /**< หลัง Init/Reset: วาดใหม่ทั้งหมด */
+
 /* ========== Buffer Size Recommendations ========== */
 
 /**
@@ -152,6 +179,28 @@ void Stopwatch_Reset(void);
  */
 void Stopwatch_GetTime(Time_t* time);
 
+/**
+ * @brief อ่านเวลาปัจจุบันของ stopwatch แบบ BCD (normalized)
+ * @param bcd Pointer ไปยัง TimeBCD_t structure
+ */
+void Stopwatch_GetTimeBCD(TimeBCD_t* bcd);
+
+/**
+ * @brief อ่านและล้าง changed flags ของ stopwatch
+ * @return TIME_CHANGED_* ที่เกิดขึ้นตั้งแต่เรียกครั้งก่อน (0 = ไม่ต้องวาดใหม่)
+ *
+ * @example
+ * uint8_t changed = Stopwatch_GetChanged();
+ * if (changed) {
+ *     TimeBCD_t t;
+ *     Stopwatch_GetTimeBCD(&t);
+ *     draw_seconds(t.seconds);
+ *     if (changed & TIME_CHANGED_MINUTES) draw_minutes(t.minutes);
+ *     if (changed & TIME_CHANGED_HOURS) draw_hours(t.hours);
+ * }
+ */
+uint8_t Stopwatch_GetChanged(void);
+
 /**
  * @brief อ่านเวลาเป็น string ตามรูปแบบที่กำหนด
  * @param buffer Buffer สำหรับเก็บ string (ดูขนาดที่แนะนำใน TIME_BUFFER_SIZE_*)
@@ -261,6 +310,17 @@ void Countdown_Reset(void);
  */
 void Countdown_GetTime(Time_t* time);
 
+/**
+ * @brief อ่านเวลาที่เหลือแบบ BCD (normalized)
+ */
+void Countdown_GetTimeBCD(TimeBCD_t* bcd);
+
+/**
+ * @brief อ่านและล้าง changed flags ของ countdown
+ * @return TIME_CHANGED_* ที่เกิดขึ้นตั้งแต่เรียกครั้งก่อน
+ */
+uint8_t Countdown_GetChanged(void);
+
 /**
  * @brief อ่านเวลาที่เหลือเป็น string
  * @param buffer Buffer สำหรับเก็บ string
@@ -0,0 +1,138 @@
+/**
+ * @file SimpleTIM_Timestamp.c
+ * @brief 32-bit Cascaded Timestamp Counter Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleTIM_Timestamp.h"
+#include "SimpleClock.h"
+
+/* ========== Internal Data ========== */
+
+/**
+ * @brief Clock ที่ถืออยู่ (bitmask ของ Clock_Periph)
+ */
+static uint16_t timestamp_clocks = 0;
+
+static uint32_t timestamp_hz = 0;
+
+/**
+ * @brief Fixed-point scale (value × 2^shift) คำนวณตอน init
+ */
+typedef struct {
+    uint32_t scale;
+    uint8_t shift;
+} Timestamp_Scale;
+
+static Timestamp_Scale timestamp_ns;   /**< ns ต่อ tick */
+static Timestamp_Scale timestamp_us;   /**< us ต่อ tick */
+static Timestamp_Scale timestamp_tpu;  /**< ticks ต่อ us */
+
+/* ========== Internal Helper Functions ========== */
+
+/**
+ * @brief หา num / den เป็น fixed-point ที่ shift มากสุดที่ยังพอดี 32 bits
+ */
+static void Timestamp_MakeScale(uint32_t num, uint32_t den, Timestamp_Scale* out) {
+    uint8_t shift = 31;
+    uint64_t scale;
+
+    while ((scale = ((uint64_t)num << shift) / den) > 0xFFFFFFFFULL) {
+        shift--;
+    }
+    out->scale = (uint32_t)scale;
+    out->shift = shift;
+}
+
+static inline uint32_t Timestamp_Apply(uint32_t value, const Timestamp_Scale* s) {
+    return (uint32_t)(((uint64_t)value * s->scale) >> s->shift);
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่ม counter 32-bit
+ */
+void Timestamp_Init(uint32_t prescaler) {
+    if (prescaler < 1) prescaler = 1;
+    if (prescaler > 65536) prescaler = 65536;
+
+    Clock_AcquireOnce(CLOCK_TIM1, &timestamp_clocks);
+    Clock_AcquireOnce(CLOCK_TIM2, &timestamp_clocks);
+
+    TIM_Cmd(TIM1, DISABLE);
+    TIM_Cmd(TIM2, DISABLE);
+
+    // TIM1: ครึ่งล่าง, TRGO ทุก update (overflow)
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure = {0};
+    TIM_TimeBaseStructure.TIM_Period = 0xFFFF;
+    TIM_TimeBaseStructure.TIM_Prescaler = (uint16_t)(prescaler - 1);
+    TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+    TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseInit(TIM1, &TIM_TimeBaseStructure);
+    TIM_SelectOutputTrigger(TIM1, TIM_TRGOSource_Update);
+    TIM_UpdateRequestConfig(TIM1, TIM_UpdateSource_Regular);
+
+    // TIM2: ครึ่งบน นับ TRGO ของ TIM1
+    TIM_TimeBaseStructure.TIM_Prescaler = 0;
+    TIM_TimeBaseInit(TIM2, &TIM_TimeBaseStructure);
+    TIM_ITRxExternalClockConfig(TIM2, SIMPLE_TIMESTAMP_ITR);
+
+    TIM1->CNT = 0;
+    TIM2->CNT = 0;
+    TIM1->INTFR = 0;
+    TIM2->INTFR = 0;
+
+    // Slave ก่อน master: ไม่พลาด update แรก
+    TIM_Cmd(TIM2, ENABLE);
+    TIM_Cmd(TIM1, ENABLE);
+
+    // Fixed-point conversion: หารครั้งเดียวตอน init
+    timestamp_hz = SystemCoreClock / prescaler;
+    Timestamp_MakeScale(1000000000UL, timestamp_hz, &timestamp_ns);
+    Timestamp_MakeScale(1000000UL, timestamp_hz, &timestamp_us);
+    Timestamp_MakeScale(timestamp_hz, 1000000UL, &timestamp_tpu);
+}
+
+/**
+ * @brief หยุด counter และคืน timers
+ */
+void Timestamp_End(void) {
+    TIM_Cmd(TIM1, DISABLE);
+    TIM_Cmd(TIM2, DISABLE);
+    TIM_SelectSlaveMode(TIM2, 0);
+    TIM_SelectOutputTrigger(TIM1, 0);
+
+    Clock_ReleaseOnce(CLOCK_TIM1, &timestamp_clocks);
+    Clock_ReleaseOnce(CLOCK_TIM2, &timestamp_clocks);
+    timestamp_hz = 0;
+}
+
+/**
+ * @brief ความถี่ของ counter
+ */
+uint32_t Timestamp_GetHz(void) {
+    return timestamp_hz;
+}
+
+/**
+ * @brief แปลง ticks เป็น nanoseconds
+ */
+uint32_t Timestamp_ToNs(uint32_t ticks) {
+    return Timestamp_Apply(ticks, &timestamp_ns);
+}
+
+/**
+ * @brief แปลง ticks เป็น microseconds
+ */
+uint32_t Timestamp_ToUs(uint32_t ticks) {
+    return Timestamp_Apply(ticks, &timestamp_us);
+}
+
+/**
+ * @brief แปลง microseconds เป็น ticks
+ */
+uint32_t Timestamp_FromUs(uint32_t us) {
+    return Timestamp_Apply(us, &timestamp_tpu);
+}
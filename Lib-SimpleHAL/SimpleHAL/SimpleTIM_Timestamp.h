@@ -0,0 +1,115 @@
+/**
+ * @file SimpleTIM_Timestamp.h
+ * @brief 32-bit Timestamp Counter จาก TIM1 + TIM2 แบบ cascade สำหรับ CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * ต่อ TIM2 เป็น slave นับ update event ของ TIM1 (TRGO → ITR0, external clock mode 1)
+ * ได้ counter 32 bits ที่ SystemCoreClock หรือความถี่หาร ทำงานใน hardware ล้วน:
+ * ไม่มี interrupt และไม่ขึ้นกับ SysTick
+ *
+ * **คุณสมบัติ:**
+ * - ความละเอียด 20.8 ns ที่ 48 MHz (prescaler 1), wrap ทุก 89 วินาที
+ * - อ่านแบบ atomic ด้วย double-read (ไม่ต้องปิด interrupt)
+ * - แปลง ticks ↔ ns/us แบบ fixed-point (หารครั้งเดียวตอน init)
+ * - ใช้เป็น timebase ของ module อื่นได้ (edge capture, trace log) ผ่าน Timestamp_Read()
+ *
+ * | prescaler | resolution @48 MHz | wrap |
+ * |-----------|--------------------|------|
+ * | 1         | 20.8 ns            | 89 s |
+ * | 48        | 1 us               | 71.6 นาที |
+ * | 4800      | 100 us             | 4.97 วัน |
+ *
+ * @example
+ * Timestamp_Init(1);
+ *
+ * uint32_t t0 = Timestamp_Read();
+ * do_work();
+ * uint32_t ns = Timestamp_ToNs(Timestamp_Read() - t0);
+ *
+ * @note ใช้ทั้ง TIM1 และ TIM2 (ห้ามใช้ร่วมกับ SimplePWM/SimpleTIM/capture/encoder)
+ */
+
+#ifndef __SIMPLE_TIM_TIMESTAMP_H
+#define __SIMPLE_TIM_TIMESTAMP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <ch32v00x.h>
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief Internal trigger ของ TIM2 ที่ต่อกับ TRGO ของ TIM1
+ */
+#ifndef SIMPLE_TIMESTAMP_ITR
+#define SIMPLE_TIMESTAMP_ITR TIM_TS_ITR0
+#endif
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่ม counter 32-bit (เริ่มนับจาก 0 ทันที)
+ * @param prescaler ตัวหาร clock (1-65536) เช่น 1 = SystemCoreClock, 48 = 1 MHz ที่ 48 MHz
+ */
+void Timestamp_Init(uint32_t prescaler);
+
+/**
+ * @brief หยุด counter และคืน TIM1/TIM2
+ */
+void Timestamp_End(void);
+
+/**
+ * @brief อ่าน timestamp 32-bit
+ * @return ticks นับจาก Timestamp_Init() (wrap ที่ 2^32)
+ *
+ * @details อ่าน TIM2 → TIM1 → TIM2 จนกว่าค่า TIM2 จะตรงกัน
+ * ครึ่งบนกับครึ่งล่างจึงมาจากจังหวะเดียวกันเสมอ (เรียกจาก ISR ได้)
+ */
+static inline uint32_t Timestamp_Read(void) {
+    uint16_t high, low;
+    do {
+        high = (uint16_t)TIM2->CNT;
+        low = (uint16_t)TIM1->CNT;
+    } while (high != (uint16_t)TIM2->CNT);
+    return ((uint32_t)high << 16) | low;
+}
+
+/**
+ * @brief เวลาที่ผ่านไป (ticks) จาก timestamp ก่อนหน้า (ถูกต้องข้าม wrap)
+ */
+static inline uint32_t Timestamp_Elapsed(uint32_t since) {
+    return Timestamp_Read() - since;
+}
+
+/**
+ * @brief ความถี่ของ counter (Hz)
+ */
+uint32_t Timestamp_GetHz(void);
+
+/**
+ * @brief แปลง ticks เป็น nanoseconds
+ * @note ผลเกิน 32 bits ถูกตัด (ช่วงที่ใช้ได้ ≈ 4.29 วินาที)
+ */
+uint32_t Timestamp_ToNs(uint32_t ticks);
+
+/**
+ * @brief แปลง ticks เป็น microseconds
+ */
+uint32_t Timestamp_ToUs(uint32_t ticks);
+
+/**
+ * @brief แปลง microseconds เป็น ticks (สำหรับเทียบ deadline)
+ */
+uint32_t Timestamp_FromUs(uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_TIM_TIMESTAMP_H
@@ -0,0 +1,215 @@
+/**
+ * @file SimpleTaskWDG.c
+ * @brief Software Task Watchdog Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleTaskWDG.h"
+#include "SimpleDelay.h"
+#include "SimpleIWDG.h"
+#include "SimpleWWDG.h"
+
+/* ========== Private Definitions ========== */
+
+#define TASKWDG_MAGIC  0x57444754UL  // "WDGT"
+
+/**
+ * @brief Record ที่อยู่รอดหลัง reset (check = ~(magic ^ ข้อมูล))
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t running;
+    uint8_t overdue;
+    uint16_t reserved;
+    uint32_t check;
+} TaskWDG_Record;
+
+/* ========== Private Variables ========== */
+
+static TaskWDG_Record taskwdg_record __attribute__((section(SIMPLE_TASKWDG_NOINIT_SECTION)));
+
+static uint32_t taskwdg_expire[SIMPLE_TASKWDG_MAX_TASKS];    // Get_CurrentMs() ที่เลย deadline
+static uint32_t taskwdg_deadline[SIMPLE_TASKWDG_MAX_TASKS];
+static uint32_t taskwdg_live = 0;                            // bit = id ที่ลงทะเบียน
+static uint8_t taskwdg_failed = TASKWDG_NONE;
+
+static uint8_t taskwdg_use_wwdg = 0;
+static uint8_t taskwdg_wwdg_counter = 0x7F;
+static uint8_t taskwdg_wwdg_window = 0x7F;
+
+// Deadline tables + no-init record (SimpleHAL_RamReport())
+const uint16_t taskwdg_ram_bytes = sizeof(taskwdg_expire) + sizeof(taskwdg_deadline) +
+                                   sizeof(taskwdg_record);
+
+static TaskWDG_ResetInfo taskwdg_previous = {TASKWDG_NONE, TASKWDG_NONE};
+static uint8_t taskwdg_previous_valid = 0;
+static uint8_t taskwdg_started = 0;          // record ของ boot ก่อนหน้าถูกเก็บแล้ว
+
+/* ========== Private Functions ========== */
+
+static uint32_t record_check(const TaskWDG_Record* r) {
+    return ~(r->magic ^ r->running ^ ((uint32_t)r->overdue << 8));
+}
+
+static uint8_t record_valid(void) {
+    return taskwdg_record.magic == TASKWDG_MAGIC &&
+           taskwdg_record.check == record_check(&taskwdg_record);
+}
+
+static void record_write(uint8_t running, uint8_t overdue) {
+    taskwdg_record.magic = TASKWDG_MAGIC;
+    taskwdg_record.running = running;
+    taskwdg_record.overdue = overdue;
+    taskwdg_record.reserved = 0;
+    taskwdg_record.check = record_check(&taskwdg_record);
+}
+
+/**
+ * @brief เก็บ record ของ boot ก่อนหน้า (ก่อนถูกเขียนทับ)
+ */
+static void latch_previous(void) {
+    if (taskwdg_started) return;
+
+    taskwdg_previous_valid = record_valid();
+    if (taskwdg_previous_valid) {
+        taskwdg_previous.running = taskwdg_record.running;
+        taskwdg_previous.overdue = taskwdg_record.overdue;
+    }
+    taskwdg_started = 1;
+}
+
+/**
+ * @brief เริ่ม record ใหม่ของ boot นี้
+ */
+static void start_record(void) {
+    latch_previous();
+    taskwdg_failed = TASKWDG_NONE;
+    record_write(TASKWDG_NONE, TASKWDG_NONE);
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่ม supervisor บน IWDG
+ */
+void TaskWDG_InitIWDG(uint16_t timeout_ms) {
+    start_record();
+    taskwdg_use_wwdg = 0;
+    IWDG_SimpleInit(timeout_ms);
+}
+
+/**
+ * @brief เริ่ม supervisor บน WWDG
+ */
+void TaskWDG_InitWWDG(uint8_t counter, uint8_t window) {
+    start_record();
+    taskwdg_use_wwdg = 1;
+    taskwdg_wwdg_counter = counter;
+    taskwdg_wwdg_window = window;
+    WWDG_SimpleInit(counter, window);
+}
+
+/**
+ * @brief Record จาก boot ก่อนหน้า
+ */
+uint8_t TaskWDG_GetResetInfo(TaskWDG_ResetInfo* info) {
+    latch_previous();
+    if (info) *info = taskwdg_previous;
+    return taskwdg_previous_valid;
+}
+
+/**
+ * @brief ลงทะเบียน task
+ */
+void TaskWDG_Register(uint8_t id, uint32_t deadline_ms) {
+    if (id >= SIMPLE_TASKWDG_MAX_TASKS) return;
+
+    taskwdg_deadline[id] = deadline_ms;
+    taskwdg_expire[id] = Get_CurrentMs() + deadline_ms;
+    taskwdg_live |= 1UL << id;
+}
+
+/**
+ * @brief หยุดติดตาม task
+ */
+void TaskWDG_Unregister(uint8_t id) {
+    if (id >= SIMPLE_TASKWDG_MAX_TASKS) return;
+    taskwdg_live &= ~(1UL << id);
+}
+
+/**
+ * @brief Task ทำงานปกติ
+ */
+void TaskWDG_CheckIn(uint8_t id) {
+    if (id >= SIMPLE_TASKWDG_MAX_TASKS) return;
+    taskwdg_expire[id] = Get_CurrentMs() + taskwdg_deadline[id];  // store เดียว: ไม่ต้อง lock
+}
+
+/**
+ * @brief Check-in โดยกำหนดเวลาทำงานรอบถัดไป
+ */
+void TaskWDG_CheckInAt(uint8_t id, uint32_t when_ms) {
+    if (id >= SIMPLE_TASKWDG_MAX_TASKS) return;
+    taskwdg_expire[id] = when_ms + taskwdg_deadline[id];
+}
+
+/**
+ * @brief บันทึกว่ากำลังเข้า task
+ */
+void TaskWDG_Enter(uint8_t id) {
+    record_write(id, taskwdg_failed);
+}
+
+/**
+ * @brief ออกจาก task
+ */
+void TaskWDG_Leave(void) {
+    record_write(TASKWDG_NONE, taskwdg_failed);
+}
+
+/**
+ * @brief Bitmask ของ tasks ที่เลย deadline
+ */
+uint32_t TaskWDG_Overdue(void) {
+    uint32_t now = Get_CurrentMs();
+    uint32_t live = taskwdg_live;
+    uint32_t overdue = 0;
+
+    for (uint8_t id = 0; live; id++, live >>= 1) {
+        if ((live & 1) && (int32_t)(now - taskwdg_expire[id]) > 0) {
+            overdue |= 1UL << id;
+        }
+    }
+    return overdue;
+}
+
+/**
+ * @brief ตรวจทุก task และ feed watchdog
+ */
+uint8_t TaskWDG_Service(void) {
+    if (taskwdg_failed == TASKWDG_NONE) {
+        uint32_t overdue = TaskWDG_Overdue();
+        if (overdue) {
+            uint8_t id = 0;
+            while (!(overdue & 1)) {
+                overdue >>= 1;
+                id++;
+            }
+            // หยุด feed ถาวร: reset ตาม timeout ของ hardware
+            taskwdg_failed = id;
+            record_write(taskwdg_record.running, id);
+        }
+    }
+    if (taskwdg_failed != TASKWDG_NONE) return taskwdg_failed;
+
+    if (taskwdg_use_wwdg) {
+        // Refresh ก่อน window = reset ทันที
+        if ((WWDG->CTLR & 0x7F) < taskwdg_wwdg_window) {
+            WWDG_Refresh(taskwdg_wwdg_counter);
+        }
+    } else {
+        IWDG_Feed();
+    }
+    return TASKWDG_NONE;
+}
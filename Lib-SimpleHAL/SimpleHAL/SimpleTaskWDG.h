@@ -0,0 +1,168 @@
+/**
+ * @file SimpleTaskWDG.h
+ * @brief Software Task Watchdog บน IWDG/WWDG สำหรับ CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * Supervisor ตัวเดียว feed hardware watchdog เฉพาะเมื่อทุก task ที่ลงทะเบียนไว้
+ * check-in ทันเวลา ถ้า task ใดค้างหรือหยุดทำงาน watchdog จะ reset ระบบ
+ * และ id ของ task นั้นถูกเก็บใน RAM ที่ไม่ถูกล้างตอน reset ไว้ตรวจหลัง boot
+ *
+ * **คุณสมบัติ:**
+ * - สูงสุด SIMPLE_TASKWDG_MAX_TASKS tasks แต่ละตัวมี deadline ของตัวเอง
+ * - TaskWDG_Service() feed IWDG ทุกครั้ง หรือ WWDG เมื่อ counter อยู่ใน window
+ * - บันทึก task ที่กำลังทำงานตอน reset (TaskWDG_Enter/Leave) และ task ที่พลาด deadline
+ * - Scheduler ของ Lib-Simple_Task เรียกทั้งหมดให้เองเมื่อ TM_WATCHDOG = 1
+ *
+ * @example
+ * TaskWDG_ResetInfo info;
+ * if (TaskWDG_GetResetInfo(&info) && IWDG_WasResetCause()) {
+ *     printf("stuck: %u, late: %u\r\n", info.running, info.overdue);
+ * }
+ *
+ * TaskWDG_InitIWDG(1000);
+ * TaskWDG_Register(0, 200);   // task 0 ต้อง check-in ทุก 200 ms
+ * TaskWDG_Register(1, 2000);
+ *
+ * while (1) {
+ *     if (read_sensor()) TaskWDG_CheckIn(0);
+ *     if (send_report()) TaskWDG_CheckIn(1);
+ *     TaskWDG_Service();
+ * }
+ *
+ * @note RAM ที่ไม่ถูกล้างใช้ section SIMPLE_TASKWDG_NOINIT_SECTION ซึ่ง Link.ld ของ SDK
+ *       ไม่มี: linker วางไว้ต่อจาก .bss (startup ไม่ล้าง) แต่ heap เริ่มที่ _end = _ebss
+ *       ถ้าใช้ malloc ให้เพิ่มใน Link.ld หลัง .bss:
+ *       .noinit (NOLOAD) : { . = ALIGN(4); *(.noinit*) . = ALIGN(4); } >RAM
+ *       และเลื่อน PROVIDE(_end = .) ไปไว้หลัง section นี้
+ */
+
+#ifndef __SIMPLE_TASKWDG_H
+#define __SIMPLE_TASKWDG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <ch32v00x.h>
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief จำนวน task ids สูงสุด (1-32)
+ */
+#ifndef SIMPLE_TASKWDG_MAX_TASKS
+#define SIMPLE_TASKWDG_MAX_TASKS 16
+#endif
+
+#if SIMPLE_TASKWDG_MAX_TASKS < 1 || SIMPLE_TASKWDG_MAX_TASKS > 32
+#error "SIMPLE_TASKWDG_MAX_TASKS must be 1-32"
+#endif
+
+/**
+ * @brief Section ของ reset record (ไม่ถูกล้างตอน startup)
+ */
+#ifndef SIMPLE_TASKWDG_NOINIT_SECTION
+#define SIMPLE_TASKWDG_NOINIT_SECTION ".noinit"
+#endif
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief ไม่มี task (ใน TaskWDG_ResetInfo และค่าคืนของ TaskWDG_Service())
+ */
+#define TASKWDG_NONE  0xFF
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief ข้อมูลจาก boot ก่อนหน้า
+ */
+typedef struct {
+    uint8_t running;  /**< task ที่กำลังทำงานตอน reset (ค้างอยู่ใน task), TASKWDG_NONE = ไม่มี */
+    uint8_t overdue;  /**< task แรกที่พลาด deadline จน supervisor หยุด feed */
+} TaskWDG_ResetInfo;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่ม supervisor บน IWDG
+ * @param timeout_ms timeout ของ IWDG (ต้องนานกว่าช่วงห่างของ TaskWDG_Service())
+ */
+void TaskWDG_InitIWDG(uint16_t timeout_ms);
+
+/**
+ * @brief เริ่ม supervisor บน WWDG (prescaler 8 เหมือน WWDG_SimpleInit())
+ * @param counter ค่า counter หลัง refresh (0x41-0x7F)
+ * @param window refresh ได้เมื่อ counter < window
+ *
+ * @note TaskWDG_Service() refresh เฉพาะเมื่อ counter อยู่ใน window จึงเรียกถี่ได้
+ *       แต่ต้องเรียกก่อน counter ถึง 0x3F (ไม่กี่สิบ ms)
+ */
+void TaskWDG_InitWWDG(uint8_t counter, uint8_t window);
+
+/**
+ * @brief Record จาก boot ก่อนหน้า (อ่านได้ทั้งก่อนและหลัง Init)
+ * @param info ผลลัพธ์
+ * @return 1 = มี record ที่ถูกต้อง, 0 = power-on หรือ RAM ไม่ตรง checksum
+ *
+ * @note ใช้คู่กับ IWDG_WasResetCause() หรือ RCC_FLAG_WWDGRST เพื่อรู้ว่า reset เพราะ watchdog
+ */
+uint8_t TaskWDG_GetResetInfo(TaskWDG_ResetInfo* info);
+
+/**
+ * @brief ลงทะเบียน task ให้ supervisor ติดตาม (นับ deadline จากตอนนี้)
+ * @param id 0 - SIMPLE_TASKWDG_MAX_TASKS-1
+ * @param deadline_ms ต้อง check-in ภายในเวลานี้หลัง check-in ครั้งก่อน
+ */
+void TaskWDG_Register(uint8_t id, uint32_t deadline_ms);
+
+/**
+ * @brief หยุดติดตาม task (เช่น task ถูกปิด)
+ */
+void TaskWDG_Unregister(uint8_t id);
+
+/**
+ * @brief Task ทำงานปกติ: deadline ถัดไป = ตอนนี้ + deadline_ms
+ * @note เรียกจาก ISR ได้
+ */
+void TaskWDG_CheckIn(uint8_t id);
+
+/**
+ * @brief Check-in โดยกำหนดเวลาที่คาดว่าจะ check-in ครั้งถัดไป (deadline = when + deadline_ms)
+ * @param id task id
+ * @param when_ms เวลา (Get_CurrentMs()) ที่ task ควรทำงานรอบถัดไป
+ */
+void TaskWDG_CheckInAt(uint8_t id, uint32_t when_ms);
+
+/**
+ * @brief บันทึกว่ากำลังเข้า task (ถ้า reset ระหว่างนี้ id จะอยู่ใน info.running)
+ */
+void TaskWDG_Enter(uint8_t id);
+
+/**
+ * @brief ออกจาก task
+ */
+void TaskWDG_Leave(void);
+
+/**
+ * @brief ตรวจทุก task และ feed watchdog ถ้าไม่มีตัวใดเลย deadline
+ * @return TASKWDG_NONE = feed แล้ว (หรือรอ window ของ WWDG), อื่นๆ = id ของ task ที่เลย deadline
+ *
+ * @note เมื่อพบ task ที่เลย deadline จะไม่ feed อีกเลยจน reset
+ */
+uint8_t TaskWDG_Service(void);
+
+/**
+ * @brief Bitmask ของ tasks ที่เลย deadline ตอนนี้ (bit = id)
+ */
+uint32_t TaskWDG_Overdue(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_TASKWDG_H
@@ -0,0 +1,119 @@
+/**
+ * @file SimpleTrace.c
+ * @brief Deferred Binary Trace Logging Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleTrace.h"
+#include "SimpleDelay.h"
+
+/* ========== Private Definitions ========== */
+
+#define TRACE_MASK (SIMPLE_TRACE_BUFFER_SIZE - 1)
+
+/* ========== Private Variables ========== */
+
+static Trace_Entry_t trace_buffer[SIMPLE_TRACE_BUFFER_SIZE];
+static volatile uint16_t trace_head = 0;      // เขียนโดย Trace_Log (ทุก context)
+static volatile uint16_t trace_tail = 0;      // เขียนโดย Trace_Drain (main loop)
+static volatile uint16_t trace_overruns = 0;
+static uint16_t trace_synced_overruns = 0;    // ค่า overruns ใน sync record ล่าสุด
+static uint8_t trace_need_sync = 1;
+
+// Trace ring (SimpleHAL_RamReport())
+const uint16_t trace_ram_bytes = sizeof(trace_buffer);
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่มต้น trace buffer
+ */
+void Trace_Init(void) {
+    Timer_EnsureInit();
+
+    __disable_irq();
+    trace_head = 0;
+    trace_tail = 0;
+    trace_overruns = 0;
+    __enable_irq();
+
+    trace_synced_overruns = 0;
+    trace_need_sync = 1;
+}
+
+/**
+ * @brief บันทึก event ลง ring buffer
+ */
+void Trace_Log(uint16_t id, uint32_t arg0, uint32_t arg1) {
+    uint32_t mstatus;
+
+    // ปิด IRQ และจำสถานะเดิม (เรียกจาก ISR ได้โดยไม่เปิด IRQ ก่อนเวลา)
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus));
+
+    uint16_t head = trace_head;
+    if ((uint16_t)(head - trace_tail) < SIMPLE_TRACE_BUFFER_SIZE) {
+        Trace_Entry_t* e = &trace_buffer[head & TRACE_MASK];
+        uint32_t ticks;
+        e->id = id;
+        // นับ ms ที่ SysTick ยังค้างอยู่ให้ (ใช้ได้ทั้งโหมด 1 ms และ tickless)
+        e->ms = Get_CurrentMsTicks(&ticks);
+        e->ticks = (uint16_t)ticks;
+        e->arg0 = arg0;
+        e->arg1 = arg1;
+        trace_head = head + 1;
+    } else {
+        trace_overruns++;
+    }
+
+    if (mstatus & 0x8) {
+        __asm volatile ("csrsi mstatus, 0x8");
+    }
+}
+
+/**
+ * @brief ส่ง trace entries ที่ค้างอยู่ออกแบบ binary
+ */
+uint8_t Trace_Drain(Printf_Output output, uint8_t max_entries) {
+    if (!output) return 0;
+
+    uint16_t overruns = trace_overruns;
+    if (trace_need_sync || overruns != trace_synced_overruns) {
+        Trace_Entry_t sync;
+        sync.id = TRACE_ID_SYNC;
+        sync.ticks = TRACE_SYNC_MAGIC;
+        sync.ms = Get_CurrentMs();
+        sync.arg0 = Get_TicksPerMs();
+        sync.arg1 = overruns;
+        output((const char*)&sync, sizeof(sync));
+
+        trace_synced_overruns = overruns;
+        trace_need_sync = 0;
+    }
+
+    uint8_t sent = 0;
+    uint16_t tail = trace_tail;
+
+    while (sent < max_entries && tail != trace_head) {
+        output((const char*)&trace_buffer[tail & TRACE_MASK], sizeof(Trace_Entry_t));
+        tail++;
+        trace_tail = tail;  // คืนช่องหลังส่ง (output อาจ copy ไปยัง TX FIFO แล้ว)
+        sent++;
+    }
+
+    return sent;
+}
+
+/**
+ * @brief จำนวน entry ที่รอส่ง
+ */
+uint16_t Trace_Available(void) {
+    return (uint16_t)(trace_head - trace_tail);
+}
+
+/**
+ * @brief จำนวน event ที่ถูกทิ้งเพราะ buffer เต็ม
+ */
+uint16_t Trace_Overruns(void) {
+    return trace_overruns;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file SimpleTrace.h
+ * @brief Deferred Binary Trace Logging สำหรับ CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * บันทึก event แบบ binary ลง RAM ring buffer โดยใช้เวลาน้อยมาก (ใช้ใน ISR ได้)
+ * แล้วค่อยส่งออกทีหลังจาก main loop เพื่อหา timing bug โดยไม่รบกวน timing
+ *
+ * **หลักการทำงาน:**
+ * - Trace_Log() เก็บ log ID + timestamp + argument 2 ตัว (16 bytes/entry)
+ * - Timestamp เป็นค่า raw (millis + ticks ภายใน ms จาก Get_CurrentMsTicks()) ไม่มีการหาร
+ *   (Get_CurrentUs() ใช้การหารหลายร้อย cycles จึงไม่ใช้ใน fast path)
+ * - Trace_Drain() ส่ง entry แบบ binary ผ่าน USART TX queue หรือ SDI
+ * - Host decoder (Examples/Trace/trace_decode.py) แปลง ID เป็นข้อความ
+ *   จาก string table ใน header ของ application
+ *
+ * **Fast path:** Get_CurrentMsTicks() + เขียน 4 words ระหว่างปิด IRQ สั้นๆ
+ *
+ * **การกำหนด event:**
+ * @code
+ * // trace_events.h (decoder อ่านไฟล์นี้เพื่อสร้าง string table)
+ * #define TRACE_EVENTS(X) \
+ *     X(TR_BOOT,     "boot") \
+ *     X(TR_ADC_DONE, "adc done value=%u ch=%u") \
+ *     X(TR_TX_START, "tx start len=%u")
+ *
+ * TRACE_DEFINE_IDS(TRACE_EVENTS)
+ * @endcode
+ *
+ * @example
+ * Trace_Init();
+ * TRACE0(TR_BOOT);
+ *
+ * void ADC1_IRQHandler(void) {
+ *     TRACE2(TR_ADC_DONE, ADC1->RDATAR, 3);
+ * }
+ *
+ * while (1) {
+ *     Trace_Drain(Printf_OutputUSART, 4);  // ส่งสูงสุด 4 entries ต่อรอบ
+ * }
+ *
+ * @note ตั้ง SIMPLE_TRACE_ENABLE = 0 เพื่อตัด TRACEx() ออกทั้งหมดใน release build
+ */
+
+#ifndef __SIMPLE_TRACE_H
+#define __SIMPLE_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <ch32v00x.h>
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimplePrintf.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief เปิด/ปิด TRACEx() macros (0 = compile ออกทั้งหมด)
+ */
+#ifndef SIMPLE_TRACE_ENABLE
+#define SIMPLE_TRACE_ENABLE 1
+#endif
+
+/**
+ * @brief จำนวน entry ใน ring buffer (ต้องเป็นเลขยกกำลัง 2, ใช้ RAM 16 bytes/entry)
+ */
+#ifndef SIMPLE_TRACE_BUFFER_SIZE
+#define SIMPLE_TRACE_BUFFER_SIZE 32
+#endif
+
+#if (SIMPLE_TRACE_BUFFER_SIZE & (SIMPLE_TRACE_BUFFER_SIZE - 1)) != 0
+#error "SIMPLE_TRACE_BUFFER_SIZE must be a power of 2"
+#endif
+
+/* ========== Definitions ========== */
+
+/**
+ * @brief ID ของ sync record (ห้ามใช้เป็น event ID)
+ */
+#define TRACE_ID_SYNC     0xFFFF
+
+/**
+ * @brief ค่าในช่อง ticks ของ sync record ให้ decoder หาจุดเริ่ม record
+ */
+#define TRACE_SYNC_MAGIC  0xA55A
+
+/**
+ * @brief สร้าง enum ของ event ID จากรายการ X-macro
+ * @param list macro ที่รับ X(name, "format")
+ */
+#define TRACE_ENUM_ENTRY(name, fmt) name,
+#define TRACE_DEFINE_IDS(list) \
+    typedef enum { list(TRACE_ENUM_ENTRY) TRACE_ID_COUNT } Trace_Id;
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief 1 trace record (16 bytes, little-endian ตามที่ส่งออก)
+ *
+ * @details เวลาจริง (us) = ms * 1000 + ticks * 1000 / ticks_per_ms
+ * ticks_per_ms ส่งมาใน arg0 ของ sync record
+ */
+typedef struct {
+    uint16_t id;     /**< Event ID (TRACE_ID_SYNC = sync record) */
+    uint16_t ticks;  /**< SysTick ticks ภายใน ms ปัจจุบัน (Get_CurrentMsTicks()) */
+    uint32_t ms;     /**< millis ขณะบันทึก */
+    uint32_t arg0;   /**< Argument ที่ 1 */
+    uint32_t arg1;   /**< Argument ที่ 2 */
+} Trace_Entry_t;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่มต้น trace buffer (ล้างข้อมูลเก่าและเริ่ม SysTick timebase)
+ *
+ * @note Drain ครั้งแรกหลัง Init จะส่ง sync record ก่อนเสมอ
+ */
+void Trace_Init(void);
+
+/**
+ * @brief บันทึก event ลง ring buffer (fast path ใช้ใน ISR ได้)
+ * @param id Event ID
+ * @param arg0 Argument ที่ 1
+ * @param arg1 Argument ที่ 2
+ *
+ * @note เมื่อ buffer เต็ม event ใหม่จะถูกทิ้งและนับใน Trace_Overruns()
+ */
+void Trace_Log(uint16_t id, uint32_t arg0, uint32_t arg1);
+
+/**
+ * @brief ส่ง trace entries ที่ค้างอยู่ออกแบบ binary
+ * @param output ปลายทาง (Printf_OutputUSART, Printf_OutputSDI หรือของผู้ใช้)
+ * @param max_entries จำนวน entry สูงสุดที่ส่งในการเรียกครั้งนี้
+ * @return จำนวน entry ที่ส่ง (ไม่รวม sync record)
+ *
+ * @note ส่ง sync record (ticks_per_ms, overruns) ก่อนเมื่อเริ่มใหม่หรือหลังมี event หาย
+ * @note เรียกจาก main loop เท่านั้น
+ */
+uint8_t Trace_Drain(Printf_Output output, uint8_t max_entries);
+
+/**
+ * @brief จำนวน entry ที่รอส่ง
+ * @return จำนวน entry
+ */
+uint16_t Trace_Available(void);
+
+/**
+ * @brief จำนวน event ที่ถูกทิ้งเพราะ buffer เต็ม
+ * @return จำนวน event ที่หาย (นับตั้งแต่ Trace_Init)
+ */
+uint16_t Trace_Overruns(void);
+
+/* ========== Trace Macros ========== */
+
+#if SIMPLE_TRACE_ENABLE
+#define TRACE0(id)          Trace_Log((id), 0, 0)
+#define TRACE1(id, a)       Trace_Log((id), (uint32_t)(a), 0)
+#define TRACE2(id, a, b)    Trace_Log((id), (uint32_t)(a), (uint32_t)(b))
+#else
+#define TRACE0(id)          ((void)0)
+#define TRACE1(id, a)       ((void)0)
+#define TRACE2(id, a, b)    ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_TRACE_H
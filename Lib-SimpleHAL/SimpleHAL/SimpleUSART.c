@@ -1,63 +1,218 @@
 /**
  * @file SimpleUSART.c
  * @brief Simple USART Library Implementation
- * @version 1.0
- * @date 2025-12-12
+ * @version 1.6
+ * @date 2026-10-14
  */
 
 #include "SimpleUSART.h"
+#include "SimpleClock.h"
+#include "SimpleDelay.h"
+#include "SimpleFormat.h"
+#include "SimpleISRStat.h"
+#if SIMPLE_SYSCLOCK_RETIME
+#include "SimpleSysClock.h"
+#endif
 #include <string.h>
 
+/* ========== Private Variables ========== */
+
+static uint16_t usart_clocks = 0;  // Clock ที่ SimpleUSART ถืออยู่
+static uint16_t usart_rx_pin = GPIO_Pin_6;  // ขา RX บน GPIOD (ใช้โดย auto-baud)
+
+#if SIMPLE_USART_RX_INTERRUPT
+#define USART_RX_MASK (SIMPLE_USART_RX_BUFFER_SIZE - 1)
+
+static volatile uint8_t rx_buffer[SIMPLE_USART_RX_BUFFER_SIZE];
+static volatile uint16_t rx_head = 0;       // เขียนโดย ISR
+static volatile uint16_t rx_tail = 0;       // เขียนโดย main
+#endif
+static volatile uint16_t rx_high_water = 0;
+static volatile uint16_t rx_overflows = 0;
+
+#if SIMPLE_USART_TX_DMA
+#define USART_TX_MASK (SIMPLE_USART_TX_BUFFER_SIZE - 1)
+
+static uint8_t tx_buffer[SIMPLE_USART_TX_BUFFER_SIZE];
+static volatile uint16_t tx_head = 0;       // เขียนโดย main
+static volatile uint16_t tx_tail = 0;       // เขียนโดย DMA ISR
+static volatile uint16_t tx_dma_len = 0;    // ขนาด chunk ที่ DMA กำลังส่ง (0 = idle)
+static DMA_Channel tx_dma = DMA_CH_NONE;    // CH4 เมื่อจองได้, DMA_CH_NONE = ส่งแบบ polling
+#endif
+
+// RX/TX ring buffers (SimpleHAL_RamReport())
+const uint16_t usart_ram_bytes =
+#if SIMPLE_USART_RX_INTERRUPT
+    sizeof(rx_buffer) +
+#endif
+#if SIMPLE_USART_TX_DMA
+    sizeof(tx_buffer) +
+#endif
+    0;
+
+#if SIMPLE_USART_FRAME_RX
+// Idle-line frame reception (circular DMA + IDLE interrupt)
+static uint8_t* frame_buffer = NULL;
+static uint16_t frame_size = 0;
+static volatile uint16_t frame_pos = 0;     // ตำแหน่งเริ่มของ frame ถัดไป
+static volatile USART_FrameCallback frame_callback = NULL;
+#endif
+
+// USART1_IRQHandler ใช้ทั้ง RXNE ring buffer และ IDLE ของ frame reception
+#define USART_HAS_IRQ (SIMPLE_USART_RX_INTERRUPT || SIMPLE_USART_FRAME_RX)
+
 /* ========== Private Helper Functions ========== */
 
+#if SIMPLE_USART_TX_DMA
+
 /**
- * @brief ส่ง 1 character ผ่าน USART (internal)
+ * @brief เริ่ม DMA สำหรับ chunk ถัดไปที่ต่อเนื่องกันใน TX FIFO
+ * @note ต้องเรียกขณะปิด interrupt หรือจาก DMA ISR
  */
-static void USART_SendChar(char ch) {
-    while(USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-    USART_SendData(USART1, (uint8_t)ch);
+static void USART_TxStartChunk(void) {
+    uint16_t tail = tx_tail;
+    uint16_t head = tx_head;
+    
+    if (head == tail) {
+        tx_dma_len = 0;
+        return;
+    }
+    
+    // ส่งถึงปลาย buffer ก่อน ส่วนที่วนกลับจะเป็น chunk ถัดไป
+    uint16_t len = (head > tail) ? (head - tail) : (SIMPLE_USART_TX_BUFFER_SIZE - tail);
+    tx_dma_len = len;
+    DMA_USART_Transmit(SIMPLE_USART_TX_DMA_CHANNEL, &tx_buffer[tail], len);
+}
+
+/**
+ * @brief DMA transfer complete: ปลด chunk ที่ส่งแล้วและต่อ chunk ถัดไปทันที
+ */
+static void USART_TxDmaComplete(DMA_Channel channel) {
+    (void)channel;
+    tx_tail = (tx_tail + tx_dma_len) & USART_TX_MASK;
+    USART_TxStartChunk();
 }
 
 /**
- * @brief แปลงตัวเลขเป็น string (internal)
+ * @brief ส่ง TX FIFO ทีละ byte เมื่อจอง DMA channel ไม่ได้ (main loop เท่านั้น)
  */
-static void Int32ToString(int32_t num, char* str) {
-    int i = 0;
-    int is_negative = 0;
+static void USART_TxDrainPolled(void) {
+    uint16_t tail = tx_tail;
     
-    if (num == 0) {
-        str[i++] = '0';
-        str[i] = '\0';
-        return;
+    while (tail != tx_head) {
+        while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
+        USART_SendData(USART1, tx_buffer[tail]);
+        tail = (tail + 1) & USART_TX_MASK;
+        tx_tail = tail;
     }
-    
-    if (num < 0) {
-        is_negative = 1;
-        num = -num;
+}
+
+/**
+ * @brief เริ่ม DMA ถ้ายังไม่ได้ทำงาน
+ */
+static inline void USART_TxKick(void) {
+    if (tx_dma == DMA_CH_NONE) {
+        USART_TxDrainPolled();
+        return;
     }
-    
-    while (num != 0) {
-        str[i++] = (num % 10) + '0';
-        num = num / 10;
+    __disable_irq();
+    if (tx_dma_len == 0) {
+        USART_TxStartChunk();
     }
+    __enable_irq();
+}
+
+/**
+ * @brief เพิ่มข้อมูลลง TX FIFO (รอเฉพาะเมื่อ FIFO เต็ม)
+ */
+static void USART_TxEnqueue(const uint8_t* data, uint16_t length) {
+    uint16_t head = tx_head;
     
-    if (is_negative) {
-        str[i++] = '-';
+    while (length--) {
+        uint16_t next = (head + 1) & USART_TX_MASK;
+        
+        if (next == tx_tail) {
+            // FIFO เต็ม: ประกาศข้อมูลที่เขียนแล้ว ให้ DMA ส่งจนมีที่ว่าง
+            tx_head = head;
+            USART_TxKick();
+            while (next == tx_tail);
+        }
+        
+        tx_buffer[head] = *data++;
+        head = next;
     }
     
-    str[i] = '\0';
+    tx_head = head;
+    USART_TxKick();
+}
+
+#endif  // SIMPLE_USART_TX_DMA
+
+#if USART_HAS_IRQ
+/**
+ * @brief เปิด USART1 IRQ ใน NVIC
+ */
+static void USART_EnableIRQ(void) {
+    NVIC_InitTypeDef NVIC_InitStructure = {0};
+    NVIC_InitStructure.NVIC_IRQChannel = USART1_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+#endif
+
+/**
+ * @brief ส่ง 1 character ผ่าน USART (internal)
+ */
+static void USART_SendChar(char ch) {
+#if SIMPLE_USART_TX_DMA
+    USART_TxEnqueue((const uint8_t*)&ch, 1);
+#else
+    while(USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
+    USART_SendData(USART1, (uint8_t)ch);
+#endif
+}
+
+/**
+ * @brief รอ edge ได้นานสุด 2 bit ที่ baud ต่ำสุด (BRR = 0xFFFF cycles ต่อ bit)
+ */
+#define USART_AUTOBAUD_WAIT_TICKS  (2UL * 0xFFFF)
+
+/**
+ * @brief รอให้ขา RX เป็นระดับที่ต้องการแล้วจับเวลา
+ * @param sw stopwatch ของการวัด (poll ในลูปนี้จึงนับได้แม้ปิด interrupt หลาย ms)
+ * @param stamp [out] ticks ของ stopwatch เมื่อถึงระดับ
+ * @return 1 = สำเร็จ, 0 = ไม่มี edge ภายใน USART_AUTOBAUD_WAIT_TICKS
+ */
+static uint8_t USART_WaitRxLevel(Timer_Stopwatch_t* sw, uint8_t high, uint32_t* stamp) {
+    uint32_t start = Timer_StopwatchRead(sw);
     
-    // Reverse string
-    int start = 0;
-    int end = i - 1;
-    while (start < end) {
-        char temp = str[start];
-        str[start] = str[end];
-        str[end] = temp;
-        start++;
-        end--;
+    while (((GPIOD->INDR & usart_rx_pin) != 0) != high) {
+        if (Timer_StopwatchRead(sw) - start >= USART_AUTOBAUD_WAIT_TICKS) return 0;
+    }
+    *stamp = Timer_StopwatchRead(sw);
+    return 1;
+}
+
+#if SIMPLE_SYSCLOCK_RETIME
+static SysClock_Hook_t usart_sysclock_hook;
+
+/**
+ * @brief SimpleHAL_SetSysClock(): ส่งที่ค้างให้จบ แล้วปรับ BRR ตามสัดส่วน (baud เท่าเดิม)
+ */
+static void USART_SysClockChanged(SysClock_Phase phase, uint32_t old_hz, uint32_t new_hz) {
+    if (!(USART1->CTLR1 & USART_CTLR1_UE)) return;
+
+    if (phase == SYSCLK_PHASE_PRE) {
+        USART_FlushTx();
+        return;
     }
+    // BRR มาจาก USART_Init() หรือ USART_AutoBaud(): คิดจาก BRR เดิมครอบคลุมทั้งสองกรณี
+    uint32_t old_khz = old_hz / 1000;
+    USART1->BRR = (uint16_t)((USART1->BRR * (new_hz / 1000) + old_khz / 2) / old_khz);
 }
+#endif
 
 /* ========== Public Functions ========== */
 
@@ -69,7 +224,8 @@ void USART_SimpleInit(USART_BaudRate baud, USART_PinConfig pin_config) {
     USART_InitTypeDef USART_InitStructure = {0};
     
     // 1. เปิด Clock สำหรับ USART1 และ GPIOD
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOD | RCC_APB2Periph_USART1, ENABLE);
+    Clock_AcquireOnce(CLOCK_GPIOD, &usart_clocks);
+    Clock_AcquireOnce(CLOCK_USART1, &usart_clocks);
     
     // 2. ตั้งค่า Pin Remapping และ GPIO
     switch(pin_config) {
@@ -86,6 +242,7 @@ void USART_SimpleInit(USART_BaudRate baud, USART_PinConfig pin_config) {
             GPIO_InitStructure.GPIO_Pin = GPIO_Pin_6;
             GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
             GPIO_Init(GPIOD, &GPIO_InitStructure);
+            usart_rx_pin = GPIO_Pin_6;
             break;
             
         case USART_PINS_REMAP1:
@@ -102,6 +259,7 @@ void USART_SimpleInit(USART_BaudRate baud, USART_PinConfig pin_config) {
             GPIO_InitStructure.GPIO_Pin = GPIO_Pin_1;
             GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
             GPIO_Init(GPIOD, &GPIO_InitStructure);
+            usart_rx_pin = GPIO_Pin_1;
             break;
             
         case USART_PINS_REMAP2:
@@ -118,6 +276,7 @@ void USART_SimpleInit(USART_BaudRate baud, USART_PinConfig pin_config) {
             GPIO_InitStructure.GPIO_Pin = GPIO_Pin_5;
             GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
             GPIO_Init(GPIOD, &GPIO_InitStructure);
+            usart_rx_pin = GPIO_Pin_5;
             break;
     }
     
@@ -131,56 +290,289 @@ void USART_SimpleInit(USART_BaudRate baud, USART_PinConfig pin_config) {
     
     USART_Init(USART1, &USART_InitStructure);
     
-    // 4. เปิดใช้งาน USART
+#if SIMPLE_USART_TX_DMA
+    // 4. TX FIFO ผ่าน DMA (chunk ถัดไปเริ่มจาก transfer-complete callback)
+    USART_FlushTx();
+    tx_head = 0;
+    tx_tail = 0;
+    tx_dma_len = 0;
+    if (tx_dma == DMA_CH_NONE) {
+        tx_dma = DMA_AllocChannel(DMA_REQ_USART1_TX);
+    }
+    if (tx_dma != DMA_CH_NONE) {
+        DMA_USART_InitTx(SIMPLE_USART_TX_DMA_CHANNEL, tx_buffer, 0);
+        DMA_SetTransferCompleteCallback(SIMPLE_USART_TX_DMA_CHANNEL, USART_TxDmaComplete);
+    }
+#endif
+    
+#if SIMPLE_USART_RX_INTERRUPT
+    // 5. เปิด RXNE interrupt สำหรับ ring buffer
+    rx_head = 0;
+    rx_tail = 0;
+    USART_ITConfig(USART1, USART_IT_RXNE, ENABLE);
+    USART_EnableIRQ();
+#endif
+    
+    // 6. เปิดใช้งาน USART
     USART_Cmd(USART1, ENABLE);
+    
+#if SIMPLE_SYSCLOCK_RETIME
+    SysClock_AddHook(&usart_sysclock_hook, USART_SysClockChanged);
+#endif
+}
+
+/**
+ * @brief ตรวจจับ baud rate จาก sync byte 0x55
+ */
+uint32_t USART_AutoBaud(uint32_t timeout_ms) {
+    uint32_t edge[5];
+    Timer_Stopwatch_t sw;
+    
+    Timer_EnsureInit();
+    uint32_t start_ms = Get_CurrentMs();
+    
+    while ((Get_CurrentMs() - start_ms) < timeout_ms) {
+        // Falling edge แรก (interrupt ยังเปิด ถ้าโดนขัดจะไม่ผ่านการตรวจด้านล่าง)
+        Timer_StopwatchStart(&sw);
+        if (!USART_WaitRxLevel(&sw, 1, &edge[0]) || !USART_WaitRxLevel(&sw, 0, &edge[0])) {
+            continue;
+        }
+        
+        // Falling edge ที่เหลือ 4 ครั้ง (ทุก 2 bit) stopwatch นับข้ามขอบ ms เองระหว่างปิด IRQ
+        uint8_t ok = 1;
+        __disable_irq();
+        for (uint8_t i = 1; i < 5 && ok; i++) {
+            ok = USART_WaitRxLevel(&sw, 1, &edge[i]) && USART_WaitRxLevel(&sw, 0, &edge[i]);
+        }
+        __enable_irq();
+        if (!ok) continue;
+        
+        // ทุกช่วงต้องเป็น 1/4 ของทั้งหมด (คลาดได้ 1/8) จึงจะเป็น 0x55
+        uint32_t total = edge[4] - edge[0];
+        for (uint8_t i = 0; i < 4 && ok; i++) {
+            uint32_t quad = (edge[i + 1] - edge[i]) << 2;
+            uint32_t error = (quad > total) ? (quad - total) : (total - quad);
+            ok = (error <= (total >> 3));
+        }
+        
+        // 16x oversampling: BRR = HCLK cycles ต่อ 1 bit = total / 8
+        uint32_t brr = (total + 4) >> 3;
+        if (!ok || brr < 16 || brr > 0xFFFF) continue;
+        
+        while (USART_GetFlagStatus(USART1, USART_FLAG_TC) == RESET);
+        USART1->BRR = brr;
+        (void)USART1->DATAR;  // ทิ้ง byte ที่รับผิด baud และล้าง overrun
+        USART_Flush();
+        
+        return SystemCoreClock / brr;
+    }
+    
+    return 0;
 }
 
 /**
  * @brief ส่งข้อความแบบ string
  */
 void USART_Print(const char* str) {
+#if SIMPLE_USART_TX_DMA
+    USART_TxEnqueue((const uint8_t*)str, (uint16_t)strlen(str));
+#else
     while(*str) {
         USART_SendChar(*str++);
     }
+#endif
 }
 
 /**
  * @brief ส่งตัวเลขแบบ decimal
  */
 void USART_PrintNum(int32_t num) {
-    char buffer[12];  // เพียงพอสำหรับ int32_t
-    Int32ToString(num, buffer);
-    USART_Print(buffer);
+    char buffer[FORMAT_INT_SIZE];
+    uint8_t len = Format_Int(buffer, num);
+    USART_WriteBytes((const uint8_t*)buffer, len);
 }
 
 /**
  * @brief ส่งตัวเลขแบบ hexadecimal
  */
 void USART_PrintHex(uint32_t num, uint8_t uppercase) {
-    char buffer[11];  // "0x" + 8 hex digits + null
-    const char* hex_chars = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    char buffer[2 + FORMAT_HEX_SIZE];  // "0x" + 8 hex digits + null
     
     buffer[0] = '0';
     buffer[1] = 'x';
+    Format_Hex(&buffer[2], num, 8, uppercase);
     
-    // แปลงเป็น hex (8 digits)
-    for(int i = 9; i >= 2; i--) {
-        buffer[i] = hex_chars[num & 0x0F];
-        num >>= 4;
-    }
-    
-    buffer[10] = '\0';
-    USART_Print(buffer);
+    USART_WriteBytes((const uint8_t*)buffer, 10);
+}
+
+/**
+ * @brief ส่งตัวเลข fixed-point พร้อมจุดทศนิยม
+ */
+void USART_PrintFixed(int32_t value, uint8_t decimals) {
+    char buffer[FORMAT_FIXED_SIZE];
+    uint8_t len = Format_Fixed(buffer, value, decimals);
+    USART_WriteBytes((const uint8_t*)buffer, len);
 }
 
 /**
  * @brief ส่ง 1 byte
  */
 void USART_WriteByte(uint8_t data) {
-    while(USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-    USART_SendData(USART1, data);
+    USART_SendChar((char)data);
+}
+
+/**
+ * @brief ส่งข้อมูลหลาย bytes
+ */
+void USART_WriteBytes(const uint8_t* data, uint16_t length) {
+    if (!data) return;
+    
+#if SIMPLE_USART_TX_DMA
+    USART_TxEnqueue(data, length);
+#else
+    while (length--) {
+        USART_SendChar((char)*data++);
+    }
+#endif
+}
+
+#if SIMPLE_USART_TX_DMA
+/**
+ * @brief จองพื้นที่ใน TX FIFO
+ */
+uint8_t USART_TxReserve(uint16_t length, USART_TxSpan_t* span) {
+    if (length >= SIMPLE_USART_TX_BUFFER_SIZE) return 0;
+    
+    // รอจนมีที่ว่างพอ (เหลือ 1 ช่องเสมอเพื่อแยก full กับ empty)
+    while ((uint16_t)(USART_TX_MASK - ((tx_head - tx_tail) & USART_TX_MASK)) < length) {
+        USART_TxKick();
+    }
+    
+    uint16_t head = tx_head;
+    uint16_t first = SIMPLE_USART_TX_BUFFER_SIZE - head;
+    
+    span->data = &tx_buffer[head];
+    if (length <= first) {
+        span->length = length;
+        span->data2 = NULL;
+        span->length2 = 0;
+    } else {
+        span->length = first;
+        span->data2 = tx_buffer;
+        span->length2 = length - first;
+    }
+    return 1;
+}
+
+/**
+ * @brief ส่งข้อมูลที่เขียนลงพื้นที่ที่จองไว้
+ */
+void USART_TxCommit(uint16_t length) {
+    tx_head = (tx_head + length) & USART_TX_MASK;
+    USART_TxKick();
+}
+#endif
+
+/**
+ * @brief รอจนข้อมูลใน TX FIFO ถูกส่งออกจนหมด
+ */
+void USART_FlushTx(void) {
+#if SIMPLE_USART_TX_DMA
+    while (tx_head != tx_tail || tx_dma_len != 0);
+#endif
+    // USART ยังไม่เคยเปิด: ไม่มีอะไรต้องรอ
+    if (!(USART1->CTLR1 & USART_CTLR1_UE)) return;
+    while (USART_GetFlagStatus(USART1, USART_FLAG_TC) == RESET);
+}
+
+/**
+ * @brief จำนวน bytes ที่รอส่งใน TX FIFO
+ */
+uint16_t USART_TxPending(void) {
+#if SIMPLE_USART_TX_DMA
+    return (tx_head - tx_tail) & USART_TX_MASK;
+#else
+    return 0;
+#endif
+}
+
+#if SIMPLE_USART_RX_INTERRUPT
+
+/**
+ * @brief จำนวน bytes ใน ring buffer
+ */
+static inline uint16_t USART_RxCount(void) {
+    return (rx_head - rx_tail) & USART_RX_MASK;
+}
+
+/**
+ * @brief ตรวจสอบว่ามีข้อมูลรอรับหรือไม่
+ */
+uint8_t USART_Available(void) {
+    uint16_t count = USART_RxCount();
+    return (count > 255) ? 255 : (uint8_t)count;
+}
+
+/**
+ * @brief อ่านข้อมูล 1 byte (blocking)
+ */
+uint8_t USART_Read(void) {
+    // รอจนกว่าจะมีข้อมูล
+    while(rx_head == rx_tail);
+    
+    uint16_t tail = rx_tail;
+    uint8_t data = rx_buffer[tail];
+    rx_tail = (tail + 1) & USART_RX_MASK;
+    return data;
+}
+
+/**
+ * @brief ดู byte ถัดไปโดยไม่นำออกจาก buffer
+ */
+int16_t USART_Peek(void) {
+    if (rx_head == rx_tail) return -1;
+    return rx_buffer[rx_tail];
+}
+
+/**
+ * @brief อ่านข้อมูลจนถึง terminator (non-blocking)
+ */
+uint16_t USART_ReadUntil(uint8_t* buffer, uint16_t length, uint8_t terminator) {
+    if (!buffer || length == 0) return 0;
+    
+    uint16_t tail = rx_tail;
+    uint16_t count = USART_RxCount();
+    uint16_t scan = (count < length) ? count : length;
+    
+    // หา terminator ก่อน copy เพื่อไม่ให้ข้อมูลค้างครึ่ง packet
+    uint16_t n = 0;
+    while (n < scan && rx_buffer[(tail + n) & USART_RX_MASK] != terminator) {
+        n++;
+    }
+    
+    if (n < scan) {
+        // พบ terminator: copy ข้อมูลก่อนหน้า แล้วข้าม terminator
+        for (uint16_t i = 0; i < n; i++) {
+            buffer[i] = rx_buffer[(tail + i) & USART_RX_MASK];
+        }
+        rx_tail = (tail + n + 1) & USART_RX_MASK;
+        return n;
+    }
+    
+    if (count >= length) {
+        // ยาวเกิน buffer โดยไม่พบ terminator: คืนข้อมูลเต็ม buffer
+        for (uint16_t i = 0; i < length; i++) {
+            buffer[i] = rx_buffer[(tail + i) & USART_RX_MASK];
+        }
+        rx_tail = (tail + length) & USART_RX_MASK;
+        return length;
+    }
+    
+    return 0;
 }
 
+#else  // !SIMPLE_USART_RX_INTERRUPT
+
 /**
  * @brief ตรวจสอบว่ามีข้อมูลรอรับหรือไม่
  */
@@ -197,6 +589,34 @@ uint8_t USART_Read(void) {
     return (uint8_t)USART_ReceiveData(USART1);
 }
 
+/**
+ * @brief ดู byte ถัดไปโดยไม่นำออกจาก buffer
+ */
+int16_t USART_Peek(void) {
+    // ไม่มี buffer: peek ได้เฉพาะตอนที่ยังไม่อ่าน DATAR
+    if (USART_GetFlagStatus(USART1, USART_FLAG_RXNE) == RESET) return -1;
+    return (int16_t)(USART1->DATAR & 0xFF);
+}
+
+/**
+ * @brief อ่านข้อมูลจนถึง terminator
+ */
+uint16_t USART_ReadUntil(uint8_t* buffer, uint16_t length, uint8_t terminator) {
+    uint16_t count = 0;
+    
+    if (!buffer) return 0;
+    
+    while (count < length && USART_Available()) {
+        uint8_t data = USART_Read();
+        if (data == terminator) break;
+        buffer[count++] = data;
+    }
+    
+    return count;
+}
+
+#endif  // SIMPLE_USART_RX_INTERRUPT
+
 /**
  * @brief อ่านข้อมูลหลาย bytes
  */
@@ -214,8 +634,199 @@ uint16_t USART_ReadBytes(uint8_t* buffer, uint16_t length) {
  * @brief ล้างข้อมูลใน receive buffer
  */
 void USART_Flush(void) {
+#if SIMPLE_USART_RX_INTERRUPT
+    rx_tail = rx_head;
+#else
     // อ่านข้อมูลทิ้งจนกว่าจะหมด
     while(USART_Available()) {
         (void)USART_ReceiveData(USART1);
     }
+#endif
+}
+
+/**
+ * @brief จำนวน bytes สูงสุดที่เคยค้างใน receive buffer
+ */
+uint16_t USART_GetRxHighWater(void) {
+    return rx_high_water;
+}
+
+/**
+ * @brief จำนวน bytes ที่หายเพราะ buffer เต็มหรือ hardware overrun
+ */
+uint16_t USART_GetRxOverflows(void) {
+    return rx_overflows;
+}
+
+/**
+ * @brief รีเซ็ต high-water mark และตัวนับ overflow
+ */
+void USART_ResetRxStats(void) {
+    rx_high_water = 0;
+    rx_overflows = 0;
+}
+
+/* ========== Idle-line Frame Reception ========== */
+
+#if SIMPLE_USART_FRAME_RX
+
+/**
+ * @brief ส่ง frame ที่รับได้ตั้งแต่ frame_pos ถึงตำแหน่ง DMA ปัจจุบันให้ callback
+ */
+static void USART_FrameDeliver(void) {
+    uint16_t pos = frame_size - DMA_GetRemainingCount(SIMPLE_USART_RX_DMA_CHANNEL);
+    if (pos >= frame_size) pos = 0;  // CNTR reload พอดี
+    
+    uint16_t start = frame_pos;
+    if (pos == start) return;
+    
+    USART_Frame_t frame;
+    frame.data = &frame_buffer[start];
+    if (pos > start) {
+        frame.length = pos - start;
+        frame.data2 = NULL;
+        frame.length2 = 0;
+    } else {
+        // Frame คร่อมปลาย circular buffer
+        frame.length = frame_size - start;
+        frame.data2 = frame_buffer;
+        frame.length2 = pos;
+    }
+    
+    frame_pos = pos;
+    frame_callback(&frame);
+}
+
+/**
+ * @brief เริ่มรับ frame แบบ idle-line
+ */
+uint8_t USART_BeginFrameRx(uint8_t* buffer, uint16_t size, USART_FrameCallback callback) {
+    if (!buffer || size == 0 || !callback) return 0;
+    
+    // เริ่มใหม่ระหว่างรับอยู่: ถือ CH5 อยู่แล้ว
+    if (!frame_callback && DMA_AllocChannel(DMA_REQ_USART1_RX) == DMA_CH_NONE) return 0;
+    
+    // RXNE interrupt จะแย่ง byte จาก DMA จึงต้องปิดก่อน
+    USART_ITConfig(USART1, USART_IT_RXNE, DISABLE);
+    USART_ITConfig(USART1, USART_IT_IDLE, DISABLE);
+    
+    frame_buffer = buffer;
+    frame_size = size;
+    frame_pos = 0;
+    
+    DMA_USART_InitRx(SIMPLE_USART_RX_DMA_CHANNEL, buffer, size, 1);
+    DMA_Start(SIMPLE_USART_RX_DMA_CHANNEL);
+    
+    // ล้าง IDLE ที่ค้างอยู่ (อ่าน STATR แล้ว DATAR)
+    (void)USART1->STATR;
+    (void)USART1->DATAR;
+    
+    frame_callback = callback;
+    USART_ITConfig(USART1, USART_IT_IDLE, ENABLE);
+    USART_EnableIRQ();
+    return 1;
+}
+
+/**
+ * @brief หยุดรับ frame และกลับไปใช้ receive ring buffer
+ */
+void USART_EndFrameRx(void) {
+    USART_ITConfig(USART1, USART_IT_IDLE, DISABLE);
+    if (!frame_callback) return;
+    frame_callback = NULL;
+    
+    DMA_Stop(SIMPLE_USART_RX_DMA_CHANNEL);
+    USART_DMACmd(USART1, USART_DMAReq_Rx, DISABLE);
+    DMA_FreeChannel(SIMPLE_USART_RX_DMA_CHANNEL);
+    
+#if SIMPLE_USART_RX_INTERRUPT
+    rx_tail = rx_head;
+    USART_ITConfig(USART1, USART_IT_RXNE, ENABLE);
+#endif
+}
+
+/**
+ * @brief ส่งข้อมูลที่รับแล้วให้ frame callback โดยไม่รอสายว่าง
+ */
+void USART_PollFrameRx(void) {
+    if (!frame_callback) return;
+    
+    // กัน IDLE interrupt เข้ามาส่ง frame ซ้อนระหว่างนี้
+    USART_ITConfig(USART1, USART_IT_IDLE, DISABLE);
+    USART_FrameDeliver();
+    USART_ITConfig(USART1, USART_IT_IDLE, ENABLE);
+}
+#endif  // SIMPLE_USART_FRAME_RX
+
+/**
+ * @brief Copy frame (ทั้ง 2 ส่วน) ไปยัง buffer ปลายทาง
+ */
+uint16_t USART_FrameCopy(const USART_Frame_t* frame, uint8_t* dest, uint16_t max_length) {
+    if (!frame || !dest) return 0;
+    
+    uint16_t n1 = (frame->length < max_length) ? frame->length : max_length;
+    memcpy(dest, frame->data, n1);
+    
+    uint16_t n2 = max_length - n1;
+    if (n2 > frame->length2) n2 = frame->length2;
+    if (n2) {
+        memcpy(dest + n1, frame->data2, n2);
+    }
+    
+    return n1 + n2;
+}
+
+/* ========== Interrupt Handler ========== */
+
+#if USART_HAS_IRQ
+
+void USART1_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+
+/**
+ * @brief USART1 interrupt: IDLE frame (โหมด frame) หรือย้าย byte จาก DATAR ลง ring buffer
+ */
+void USART1_IRQHandler(void) {
+    ISR_STAT_ENTER(ISR_STAT_USART);
+    uint16_t status = USART1->STATR;
+    
+#if SIMPLE_USART_FRAME_RX
+    if (frame_callback) {
+        // โหมด frame: DMA เป็นผู้อ่าน DATAR ISR จัดการเฉพาะ IDLE
+        if (status & USART_FLAG_IDLE) {
+            (void)USART1->DATAR;  // clear IDLE
+            USART_FrameDeliver();
+        }
+        ISR_STAT_EXIT(ISR_STAT_USART);
+        return;
+    }
+#endif
+    
+#if SIMPLE_USART_RX_INTERRUPT
+    // อ่าน STATR แล้ว DATAR จะ clear RXNE และ ORE พร้อมกัน
+    while (status & (USART_FLAG_RXNE | USART_FLAG_ORE)) {
+        uint8_t data = (uint8_t)USART1->DATAR;
+        
+        if (status & USART_FLAG_ORE) {
+            rx_overflows++;
+        }
+        
+        uint16_t head = rx_head;
+        uint16_t next = (head + 1) & USART_RX_MASK;
+        if (next == rx_tail) {
+            rx_overflows++;
+        } else {
+            rx_buffer[head] = data;
+            rx_head = next;
+            
+            uint16_t used = (next - rx_tail) & USART_RX_MASK;
+            if (used > rx_high_water) {
+                rx_high_water = used;
+            }
+        }
+        
+        status = USART1->STATR;
+    }
+#endif
+    ISR_STAT_EXIT(ISR_STAT_USART);
 }
+#endif  // USART_HAS_IRQ
@@ -1,8 +1,8 @@
 /**
  * @file SimpleUSART.h
  * @brief Simple USART Library สำหรับ CH32V003 แบบ Arduino-style
- * @version 1.0
- * @date 2025-12-12
+ * @version 1.5
+ * @date 2026-10-14
  * 
  * @details
  * Library นี้ห่อหุ้ม Hardware USART ให้ใช้งานง่ายแบบ Arduino
@@ -13,6 +13,10 @@
  * - รองรับ 3 pin configurations
  * - ฟังก์ชัน print แบบ Arduino
  * - รองรับการอ่านแบบ blocking และ non-blocking
+ * - รับข้อมูลด้วย RXNE interrupt ลง ring buffer (ไม่หลุด byte ขณะ main loop ทำงานอื่น)
+ * - ส่งข้อมูลผ่าน TX FIFO + DMA (USART_Print* คืนค่าทันที ไม่รอ TXE)
+ * - รับ packet ความยาวไม่คงที่ด้วย circular DMA + IDLE interrupt (zero-copy)
+ * - Auto-baud: วัดความกว้าง bit ของ sync byte 0x55 แล้วตั้ง BRR ให้ตรงกับอีกฝั่ง
  * 
  * @example
  * // ตัวอย่างการใช้งาน
@@ -33,6 +37,9 @@
  * }
  * 
  * @note ต้องเรียก SystemCoreClockUpdate() และ Delay_Init() ก่อนใช้งาน
+ * @note เมื่อ SIMPLE_USART_TX_DMA = 1 จะจอง DMA CH4 (USART1_TX) ผ่าน DMA_AllocChannel() ตอน init
+ *       ถ้าถูกจองอยู่ TX FIFO จะถูกส่งแบบ polling แทน
+ * @note SimpleHAL_SetSysClock() รอ TX ที่ค้างแล้วปรับ BRR ให้ baud เท่าเดิม
  */
 
 #ifndef __SIMPLE_USART_H
@@ -44,6 +51,60 @@ extern "C" {
 
 #include <ch32v00x_usart.h>
 #include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleDMA.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief 1 = รับข้อมูลผ่าน RXNE interrupt + ring buffer, 0 = poll RXNE โดยตรง (แบบเดิม)
+ */
+#ifndef SIMPLE_USART_RX_INTERRUPT
+#define SIMPLE_USART_RX_INTERRUPT 1
+#endif
+
+/**
+ * @brief ขนาด receive ring buffer (ต้องเป็นเลขยกกำลัง 2, สูงสุด 256)
+ */
+#ifndef SIMPLE_USART_RX_BUFFER_SIZE
+#define SIMPLE_USART_RX_BUFFER_SIZE 64
+#endif
+
+#if (SIMPLE_USART_RX_BUFFER_SIZE & (SIMPLE_USART_RX_BUFFER_SIZE - 1)) != 0 || SIMPLE_USART_RX_BUFFER_SIZE > 256
+#error "SIMPLE_USART_RX_BUFFER_SIZE must be a power of 2 (max 256)"
+#endif
+
+/**
+ * @brief 1 = ส่งผ่าน TX FIFO ที่ DMA ดึงออกเอง (non-blocking), 0 = รอ TXE ทีละ byte (แบบเดิม)
+ */
+#ifndef SIMPLE_USART_TX_DMA
+#define SIMPLE_USART_TX_DMA 1
+#endif
+
+/**
+ * @brief ขนาด TX FIFO (ต้องเป็นเลขยกกำลัง 2)
+ */
+#ifndef SIMPLE_USART_TX_BUFFER_SIZE
+#define SIMPLE_USART_TX_BUFFER_SIZE 128
+#endif
+
+/**
+ * @brief DMA channel สำหรับ USART1_TX (hardware กำหนดเป็น CH4)
+ */
+#ifndef SIMPLE_USART_TX_DMA_CHANNEL
+#define SIMPLE_USART_TX_DMA_CHANNEL DMA_CH4
+#endif
+
+/**
+ * @brief DMA channel สำหรับ USART1_RX (hardware กำหนดเป็น CH5)
+ */
+#ifndef SIMPLE_USART_RX_DMA_CHANNEL
+#define SIMPLE_USART_RX_DMA_CHANNEL DMA_CH5
+#endif
+
+#if (SIMPLE_USART_TX_BUFFER_SIZE & (SIMPLE_USART_TX_BUFFER_SIZE - 1)) != 0
+#error "SIMPLE_USART_TX_BUFFER_SIZE must be a power of 2"
+#endif
 
 /* ========== Enumerations ========== */
 
@@ -57,7 +118,9 @@ typedef enum {
     BAUD_57600  = 57600,     /**< 57600 baud */
     BAUD_115200 = 115200,    /**< 115200 baud (แนะนำ) */
     BAUD_230400 = 230400,    /**< 230400 baud */
-    BAUD_460800 = 460800     /**< 460800 baud */
+    BAUD_460800 = 460800,    /**< 460800 baud */
+    BAUD_921600 = 921600,    /**< 921600 baud */
+    BAUD_1M     = 1000000    /**< 1 Mbaud (48 MHz / 16 / 3 ไม่มี error) */
 } USART_BaudRate;
 
 /**
@@ -74,6 +137,37 @@ typedef enum {
     USART_PINS_REMAP2  = 2   /**< Remap 2: TX=PD6, RX=PD5 */
 } USART_PinConfig;
 
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief Frame ที่รับได้จาก idle-line reception
+ * 
+ * @details ชี้ตรงเข้าไปใน circular buffer (ไม่มีการ copy)
+ * ถ้า frame คร่อมปลาย buffer ข้อมูลส่วนที่สองอยู่ที่ data2/length2
+ */
+typedef struct {
+    const uint8_t* data;     /**< ส่วนแรกของ frame */
+    uint16_t length;         /**< ความยาวส่วนแรก */
+    const uint8_t* data2;    /**< ส่วนที่วนกลับต้น buffer (NULL ถ้าไม่มี) */
+    uint16_t length2;        /**< ความยาวส่วนที่สอง (0 ถ้าไม่มี) */
+} USART_Frame_t;
+
+/**
+ * @brief Callback เมื่อได้รับ frame ครบ (เรียกจาก interrupt)
+ * @param frame ข้อมูล frame (ใช้ได้เฉพาะภายใน callback)
+ */
+typedef void (*USART_FrameCallback)(const USART_Frame_t* frame);
+
+/**
+ * @brief พื้นที่ว่างใน TX FIFO ที่จองไว้ (อาจแบ่งเป็น 2 ส่วนเมื่อวนรอบ buffer)
+ */
+typedef struct {
+    uint8_t* data;           /**< ส่วนแรก (ต่อจาก head) */
+    uint16_t length;         /**< ความยาวส่วนแรก */
+    uint8_t* data2;          /**< ส่วนที่วนกลับต้น buffer (NULL ถ้าไม่มี) */
+    uint16_t length2;        /**< ความยาวส่วนที่สอง */
+} USART_TxSpan_t;
+
 /* ========== Function Prototypes ========== */
 
 /**
@@ -92,10 +186,37 @@ typedef enum {
  */
 void USART_SimpleInit(USART_BaudRate baud, USART_PinConfig pin_config);
 
+/**
+ * @brief ตรวจจับ baud rate จาก sync byte 0x55 ('U') แล้วตั้ง BRR ให้ตรงกัน
+ * @param timeout_ms เวลารอสูงสุด (ms)
+ * @return baud rate ที่ตั้งแล้ว หรือ 0 ถ้าหมดเวลา (BRR เดิมไม่เปลี่ยน)
+ * 
+ * @details 0x55 แบบ 8N1 มี falling edge ทุก 2 bit (start, bit 1, 3, 5, 7)
+ *          ระยะจาก edge แรกถึง edge ที่ 5 = 8 bit พอดี จับเวลาด้วย SysTick (HCLK)
+ *          ดังนั้น BRR = cycles / 8 (shift ไม่มีการหาร) และตรวจว่าทุกช่วงเท่ากัน
+ *          เพื่อไม่รับ byte อื่นที่ไม่ใช่ sync
+ * 
+ * @note เรียกหลัง USART_SimpleInit() (ใช้ขา RX ตาม pin_config)
+ * @note อีกฝั่งควรส่ง 'U' ซ้ำจนได้รับการตอบกลับ ส่ง 'U' ต่อกันโดยไม่มีช่วงว่างก็ได้
+ * @note รองรับ SystemCoreClock / 65535 ถึง SystemCoreClock / 16 baud (BRR 16-0xFFFF:
+ *       ~733 baud ถึง 3 Mbaud ที่ 48 MHz) ปิด interrupt ระหว่างวัด 8 bit (~11 ms ที่ 733 baud)
+ * @note Receive buffer ถูกล้างหลังตั้ง BRR แต่ 'U' ที่ตามมายังอาจเข้ามาได้
+ * 
+ * @example
+ * USART_SimpleInit(BAUD_115200, USART_PINS_DEFAULT);
+ * if (USART_AutoBaud(2000)) {
+ *     USART_Print("OK\r\n");
+ * }
+ */
+uint32_t USART_AutoBaud(uint32_t timeout_ms);
+
 /**
  * @brief ส่งข้อความแบบ string
  * @param str pointer ไปยัง null-terminated string
  * 
+ * @note เมื่อ SIMPLE_USART_TX_DMA = 1 ข้อมูลถูก copy ลง TX FIFO แล้วคืนค่าทันที
+ *       (รอเฉพาะเมื่อ FIFO เต็ม)
+ * 
  * @example
  * USART_Print("Hello World!\r\n");
  */
@@ -122,6 +243,17 @@ void USART_PrintNum(int32_t num);
  */
 void USART_PrintHex(uint32_t num, uint8_t uppercase);
 
+/**
+ * @brief ส่งตัวเลข fixed-point พร้อมจุดทศนิยม (แทน printf("%.2f") โดยไม่ใช้ float)
+ * @param value ค่าที่ scale ด้วย 10^decimals แล้ว
+ * @param decimals จำนวนหลักหลังจุด (0-9)
+ * 
+ * @example
+ * USART_PrintFixed(3297, 3);   // ส่ง "3.297" (mV -> V)
+ * USART_PrintFixed(-125, 1);   // ส่ง "-12.5"
+ */
+void USART_PrintFixed(int32_t value, uint8_t decimals);
+
 /**
  * @brief ส่ง 1 byte
  * @param data ข้อมูล 1 byte ที่ต้องการส่ง
@@ -131,9 +263,70 @@ void USART_PrintHex(uint32_t num, uint8_t uppercase);
  */
 void USART_WriteByte(uint8_t data);
 
+/**
+ * @brief ส่งข้อมูลหลาย bytes
+ * @param data pointer ไปยังข้อมูล
+ * @param length จำนวน bytes
+ * 
+ * @note ข้อมูลถูก copy ลง TX FIFO จึงใช้ buffer ชั่วคราวได้
+ * 
+ * @example
+ * uint8_t packet[4] = {0xAA, 0x01, 0x02, 0x55};
+ * USART_WriteBytes(packet, 4);
+ */
+void USART_WriteBytes(const uint8_t* data, uint16_t length);
+
+/**
+ * @brief รอจนข้อมูลใน TX FIFO ถูกส่งออกจนหมด (blocking)
+ * 
+ * @note รอจน stop bit ของ byte สุดท้ายออกจาก pin (USART TC flag)
+ * @note ใช้ก่อนเข้า sleep/standby หรือก่อนเปลี่ยน baud rate
+ * 
+ * @example
+ * USART_Print("Going to sleep\r\n");
+ * USART_FlushTx();
+ * PWR_Standby(1000);
+ */
+void USART_FlushTx(void);
+
+/**
+ * @brief จำนวน bytes ที่รอส่งใน TX FIFO
+ * @return จำนวน bytes (0 = ส่งหมดแล้ว)
+ */
+uint16_t USART_TxPending(void);
+
+#if SIMPLE_USART_TX_DMA
+/**
+ * @brief จองพื้นที่ใน TX FIFO เพื่อเขียนข้อมูลลงไปโดยตรง (zero-copy)
+ * @param length จำนวน bytes ที่ต้องการ (สูงสุด SIMPLE_USART_TX_BUFFER_SIZE - 1)
+ * @param span รับ pointer ของพื้นที่ที่จอง
+ * @return 1 = สำเร็จ, 0 = length ใหญ่กว่า FIFO
+ * 
+ * @note รอจนกว่า DMA จะส่งข้อมูลเก่าจนมีที่ว่างพอ
+ * @note ต้องตามด้วย USART_TxCommit() ก่อนเขียน TX ด้วยฟังก์ชันอื่น
+ *       (ห้ามเรียก USART_Print* จาก ISR ระหว่างนี้)
+ * 
+ * @example
+ * USART_TxSpan_t span;
+ * if (USART_TxReserve(4, &span)) {
+ *     // เขียนลง span.data / span.data2
+ *     USART_TxCommit(4);
+ * }
+ */
+uint8_t USART_TxReserve(uint16_t length, USART_TxSpan_t* span);
+
+/**
+ * @brief ส่งข้อมูลที่เขียนลงพื้นที่ที่จองไว้
+ * @param length จำนวน bytes ที่เขียนจริง (ไม่เกินที่จอง)
+ */
+void USART_TxCommit(uint16_t length);
+#endif
+
 /**
  * @brief ตรวจสอบว่ามีข้อมูลรอรับหรือไม่
- * @return 1 = มีข้อมูล, 0 = ไม่มีข้อมูล
+ * @return จำนวน bytes ใน receive buffer (0 = ไม่มีข้อมูล)
+ * 
+ * @note เมื่อ SIMPLE_USART_RX_INTERRUPT = 0 คืนค่าได้แค่ 1 หรือ 0
  * 
  * @example
  * if(USART_Available()) {
@@ -165,6 +358,104 @@ uint8_t USART_Read(void);
  */
 uint16_t USART_ReadBytes(uint8_t* buffer, uint16_t length);
 
+/**
+ * @brief ดู byte ถัดไปโดยไม่นำออกจาก buffer
+ * @return byte ถัดไป (0-255) หรือ -1 ถ้าไม่มีข้อมูล
+ * 
+ * @example
+ * if(USART_Peek() == '$') {
+ *     // เริ่มต้น packet
+ * }
+ */
+int16_t USART_Peek(void);
+
+/**
+ * @brief อ่านข้อมูลจนถึง terminator (non-blocking)
+ * @param buffer pointer ไปยัง buffer สำหรับเก็บข้อมูล (ไม่รวม terminator)
+ * @param length ขนาดสูงสุดของ buffer
+ * @param terminator byte สิ้นสุด เช่น '\n'
+ * @return จำนวน bytes ที่อ่านได้, 0 = ยังไม่มีข้อมูลครบ 1 ชุด
+ * 
+ * @note อ่านเฉพาะเมื่อพบ terminator ใน buffer แล้ว (terminator ถูกนำออกแต่ไม่ถูก copy)
+ * @note ถ้ามีข้อมูลครบ length bytes โดยไม่พบ terminator จะคืน length bytes
+ * @note เมื่อ SIMPLE_USART_RX_INTERRUPT = 0 จะอ่านแบบ byte-by-byte จนพบ terminator
+ * 
+ * @example
+ * char line[32];
+ * uint16_t n = USART_ReadUntil((uint8_t*)line, sizeof(line) - 1, '\n');
+ * if(n) {
+ *     line[n] = '\0';
+ * }
+ */
+uint16_t USART_ReadUntil(uint8_t* buffer, uint16_t length, uint8_t terminator);
+
+#if SIMPLE_USART_FRAME_RX
+/**
+ * @brief เริ่มรับ packet แบบ idle-line (circular DMA + USART IDLE interrupt)
+ * @param buffer circular buffer ที่ DMA เขียนลง
+ * @param size ขนาด buffer (ต้องใหญ่กว่า frame ยาวสุด)
+ * @param callback ฟังก์ชันที่ถูกเรียกเมื่อสายว่างหลังรับ frame (จาก interrupt)
+ * @return 1 = สำเร็จ, 0 = parameter ไม่ถูกต้อง หรือ DMA CH5 ถูกจองอยู่
+ * 
+ * @note จอง DMA CH5 (USART1_RX) จนถึง USART_EndFrameRx() และปิด RXNE ring buffer ระหว่างใช้งาน
+ * @note Frame ถูกตัดเมื่อสายว่าง 1 character time (เหมาะกับ Modbus RTU และ protocol แบบ burst)
+ * @note ต้องประมวลผล frame ใน callback (หรือ copy ออก) ก่อน DMA วนกลับมาเขียนทับ
+ * 
+ * @example
+ * static uint8_t rx_dma_buf[128];
+ * 
+ * void on_frame(const USART_Frame_t* frame) {
+ *     uint8_t packet[64];
+ *     uint16_t n = USART_FrameCopy(frame, packet, sizeof(packet));
+ *     handle_packet(packet, n);
+ * }
+ * 
+ * USART_SimpleInit(BAUD_115200, USART_PINS_DEFAULT);
+ * USART_BeginFrameRx(rx_dma_buf, sizeof(rx_dma_buf), on_frame);
+ */
+uint8_t USART_BeginFrameRx(uint8_t* buffer, uint16_t size, USART_FrameCallback callback);
+
+/**
+ * @brief หยุดรับแบบ frame และกลับไปใช้ receive ring buffer
+ */
+void USART_EndFrameRx(void);
+
+/**
+ * @brief ส่งข้อมูลที่รับแล้วให้ frame callback ทันทีโดยไม่รอสายว่าง
+ * 
+ * @note ใช้เมื่อข้อมูลไหลต่อเนื่องจนไม่เกิด IDLE (เช่น stream ที่ 1 Mbaud)
+ *       ควรเรียกบ่อยพอให้ DMA ไม่วนมาเขียนทับข้อมูลที่ยังไม่ได้อ่าน
+ * @note callback อาจได้ข้อมูลเพียงบางส่วนของ packet (เหมาะกับ decoder แบบ streaming)
+ */
+void USART_PollFrameRx(void);
+#endif  // SIMPLE_USART_FRAME_RX
+
+/**
+ * @brief Copy frame (รวมส่วนที่วนกลับ) ไปยัง buffer ปลายทาง
+ * @param frame frame จาก callback
+ * @param dest buffer ปลายทาง
+ * @param max_length ขนาด buffer ปลายทาง
+ * @return จำนวน bytes ที่ copy
+ */
+uint16_t USART_FrameCopy(const USART_Frame_t* frame, uint8_t* dest, uint16_t max_length);
+
+/**
+ * @brief จำนวน bytes สูงสุดที่เคยค้างใน receive buffer
+ * @return high-water mark (ใช้ปรับขนาด SIMPLE_USART_RX_BUFFER_SIZE)
+ */
+uint16_t USART_GetRxHighWater(void);
+
+/**
+ * @brief จำนวน bytes ที่หายเพราะ buffer เต็มหรือ hardware overrun
+ * @return จำนวน bytes ที่หาย
+ */
+uint16_t USART_GetRxOverflows(void);
+
+/**
+ * @brief รีเซ็ต high-water mark และตัวนับ overflow
+ */
+void USART_ResetRxStats(void);
+
 /**
  * @brief ล้างข้อมูลใน receive buffer
  * 
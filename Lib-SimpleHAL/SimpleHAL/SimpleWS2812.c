@@ -0,0 +1,207 @@
+/**
+ * @file SimpleWS2812.c
+ * @brief WS2812/NeoPixel Driver Implementation
+ * @version 1.0
+ * @date 2026-10-14
+ */
+
+#include "SimpleWS2812.h"
+#include "SimpleDelay.h"
+
+/* ========== Definitions ========== */
+
+#define WS2812_BITS_PER_PIXEL 24
+#define WS2812_HALF_LENGTH    (SIMPLE_WS2812_CHUNK_PIXELS * WS2812_BITS_PER_PIXEL)
+
+/**
+ * @brief สถานะการส่ง
+ */
+typedef enum {
+    WS2812_STATE_IDLE = 0,
+    WS2812_STATE_SENDING,
+    WS2812_STATE_LATCH       /**< จบ frame แล้ว รอครบ reset time */
+} WS2812_State;
+
+/* ========== Private Variables ========== */
+
+static uint16_t ws2812_buffer[2 * WS2812_HALF_LENGTH];  // ping-pong ค่า compare
+static DMA_Stream_t ws2812_stream;
+
+static TIM_TypeDef* ws2812_timer;
+static volatile uint32_t* ws2812_ccr;
+static DMA_Channel ws2812_dma = DMA_CH_NONE;
+static uint16_t ws2812_t0;                  // compare ของ bit 0
+static uint16_t ws2812_t1;                  // compare ของ bit 1
+
+static const uint8_t* ws2812_data;          // byte ถัดไปที่จะแปลง
+static uint16_t ws2812_remaining;           // bytes ที่ยังไม่แปลง
+static uint8_t ws2812_zero_half;            // bit 0/1 = ครึ่งนั้นเป็น 0 ทั้งหมด
+static volatile uint8_t ws2812_state = WS2812_STATE_IDLE;
+static volatile uint32_t ws2812_latch_start;
+
+// Ping-pong compare buffer + DMA stream (SimpleHAL_RamReport())
+const uint16_t ws2812_ram_bytes = sizeof(ws2812_buffer) + sizeof(ws2812_stream);
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief แปลง pixels ถัดไปลงครึ่ง buffer (ที่เหลือเติม 0 = line low)
+ * @return 1 = มีข้อมูล, 0 = เป็น 0 ทั้งหมด
+ */
+static uint8_t ws2812_fill(uint16_t* out) {
+    uint16_t bytes = SIMPLE_WS2812_CHUNK_PIXELS * 3;
+    uint16_t remaining = ws2812_remaining;
+    uint16_t* end = out + WS2812_HALF_LENGTH;
+    uint8_t has_data = remaining ? 1 : 0;
+
+    if (bytes > remaining) bytes = remaining;
+    ws2812_remaining = remaining - bytes;
+
+    const uint8_t* data = ws2812_data;
+    uint16_t t0 = ws2812_t0;
+    uint16_t t1 = ws2812_t1;
+
+    while (bytes--) {
+        uint8_t b = *data++;
+        for (uint8_t mask = 0x80; mask; mask >>= 1) {
+            *out++ = (b & mask) ? t1 : t0;
+        }
+    }
+    ws2812_data = data;
+
+    while (out < end) {
+        *out++ = 0;
+    }
+    return has_data;
+}
+
+/**
+ * @brief จบ frame: หยุด DMA request แล้วเริ่มนับ reset time
+ */
+static void ws2812_finish(void) {
+    ws2812_timer->DMAINTENR &= ~TIM_DMA_Update;
+    DMA_StreamStop(&ws2812_stream);
+    *ws2812_ccr = 0;
+    ws2812_latch_start = Get_CurrentUs();
+    ws2812_state = WS2812_STATE_LATCH;
+}
+
+/**
+ * @brief DMA อ่านครึ่ง buffer หมดแล้ว: เติมครึ่งนั้นใหม่
+ */
+static void ws2812_on_half(void* data, uint16_t length) {
+    (void)length;  // ครึ่ง buffer ยาว WS2812_HALF_LENGTH เสมอ
+    uint8_t bit = (data == ws2812_buffer) ? 0x01 : 0x02;
+
+    // ครึ่งที่เป็น 0 ส่งครบ = bit สุดท้ายออกไปแล้วและ line อยู่ที่ low
+    if (ws2812_zero_half & bit) {
+        ws2812_finish();
+        return;
+    }
+
+    if (!ws2812_fill((uint16_t*)data)) {
+        ws2812_zero_half |= bit;
+    }
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่มต้น PWM 800 kHz และจอง DMA channel
+ */
+WS2812_Status WS2812_Init(PWM_Channel channel) {
+    if (channel > PWM2_CH4) return WS2812_ERROR_CHANNEL;
+
+    WS2812_Deinit();
+
+    uint8_t tim2 = (channel >= PWM2_CH1);
+    ws2812_dma = DMA_AllocChannel(tim2 ? DMA_REQ_TIM2_UP : DMA_REQ_TIM1_UP);
+    if (ws2812_dma == DMA_CH_NONE) return WS2812_ERROR_DMA;
+
+    // คาบ 1.25 us, bit 0 ≈ 1/3 คาบ, bit 1 ≈ 2/3 คาบ
+    uint16_t period = (uint16_t)(SystemCoreClock / 800000);
+    ws2812_t0 = (uint16_t)((period + 2) / 3);
+    ws2812_t1 = (uint16_t)((period * 2 + 2) / 3);
+
+    ws2812_timer = tim2 ? TIM2 : TIM1;
+    ws2812_ccr = &ws2812_timer->CH1CVR + (channel & 0x03);
+
+    PWM_AdvancedInit(channel, 0, period - 1, 0);
+    PWM_Start(channel);
+
+    DMA_Config_t config = {
+        .channel = ws2812_dma,
+        .direction = DMA_DIR_MEM_TO_PERIPH,
+        .priority = DMA_PRIORITY_HIGH,
+        .data_size = DMA_SIZE_HALFWORD,
+        .mode = DMA_MODE_CIRCULAR,
+        .mem_increment = 1,
+        .periph_increment = 0,
+        .periph_addr = (uint32_t)ws2812_ccr,
+        .mem_addr = (uint32_t)ws2812_buffer,
+        .buffer_size = 2 * WS2812_HALF_LENGTH
+    };
+    DMA_SimpleInit(&config);
+
+    return WS2812_OK;
+}
+
+/**
+ * @brief ส่ง frame แบบ non-blocking
+ */
+void WS2812_Show(const uint8_t* grb, uint16_t count) {
+    if (ws2812_dma == DMA_CH_NONE || grb == NULL || count == 0) return;
+
+    WS2812_Wait();
+
+    ws2812_data = grb;
+    ws2812_remaining = count * 3;
+    ws2812_zero_half = 0;
+    if (!ws2812_fill(ws2812_buffer)) ws2812_zero_half |= 0x01;
+    if (!ws2812_fill(ws2812_buffer + WS2812_HALF_LENGTH)) ws2812_zero_half |= 0x02;
+
+    ws2812_state = WS2812_STATE_SENDING;
+
+    // DMA request ทุก update event: ค่าที่เขียนลง preload ออกในคาบถัดไป
+    DMA_StreamStart(&ws2812_stream, ws2812_dma, ws2812_buffer, 2 * WS2812_HALF_LENGTH,
+                    ws2812_on_half);
+    ws2812_timer->DMAINTENR |= TIM_DMA_Update;
+}
+
+/**
+ * @brief ตรวจสอบว่ากำลังส่งหรือยังอยู่ใน reset time
+ */
+uint8_t WS2812_Busy(void) {
+    uint8_t state = ws2812_state;
+
+    if (state == WS2812_STATE_SENDING) return 1;
+    if (state == WS2812_STATE_LATCH) {
+        if ((Get_CurrentUs() - ws2812_latch_start) < SIMPLE_WS2812_RESET_US) return 1;
+        ws2812_state = WS2812_STATE_IDLE;
+    }
+    return 0;
+}
+
+/**
+ * @brief รอจนส่ง frame เสร็จ
+ */
+void WS2812_Wait(void) {
+    while (WS2812_Busy()) {
+    }
+}
+
+/**
+ * @brief หยุดส่งและคืน DMA channel
+ */
+void WS2812_Deinit(void) {
+    if (ws2812_dma == DMA_CH_NONE) return;
+
+    if (ws2812_state == WS2812_STATE_SENDING) {
+        ws2812_timer->DMAINTENR &= ~TIM_DMA_Update;
+        DMA_StreamStop(&ws2812_stream);
+        *ws2812_ccr = 0;
+    }
+    DMA_FreeChannel(ws2812_dma);
+    ws2812_dma = DMA_CH_NONE;
+    ws2812_state = WS2812_STATE_IDLE;
+}
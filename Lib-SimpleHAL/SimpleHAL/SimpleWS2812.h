@@ -0,0 +1,130 @@
+/**
+ * @file SimpleWS2812.h
+ * @brief WS2812/NeoPixel Driver ผ่าน TIM PWM + DMA สำหรับ CH32V003
+ * @version 1.0
+ * @date 2026-10-14
+ *
+ * @details
+ * ส่งข้อมูล LED แบบ WS2812 (800 kHz) โดย DMA เขียนค่า compare ของ PWM channel
+ * ทุก update event ของ timer CPU ไม่ต้องปิด interrupt ระหว่างส่ง
+ *
+ * **หลักการ:**
+ * - 1 bit = 1 คาบ PWM (1.25 us): compare ~0.4 us = bit 0, ~0.8 us = bit 1
+ * - แปลง pixel GRB ทีละ SIMPLE_WS2812_CHUNK_PIXELS ลง ping-pong buffer เล็กๆ
+ *   (DMA_StreamStart()) ขณะ DMA ส่งอีกครึ่ง แทนการขยายทั้ง strip ลง RAM
+ * - จบ frame ด้วยครึ่ง buffer ที่เป็น 0 แล้ว line ค้าง low ตลอด reset time
+ *
+ * **RAM:** 2 × SIMPLE_WS2812_CHUNK_PIXELS × 48 bytes (default 192 bytes) ไม่ขึ้นกับความยาว strip
+ *
+ * **DMA channel (request ตายตัวของ CH32V003):**
+ * - PWM1_CHx: TIM1_UP → DMA CH5 (ชนกับ USART1 RX DMA)
+ * - PWM2_CHx: TIM2_UP → DMA CH2 (ชนกับ SPI1 RX DMA)
+ *
+ * @example
+ * static uint8_t leds[8 * 3];  // GRB
+ *
+ * WS2812_Init(PWM2_CH1);       // PD4
+ * leds[0] = 0x20;              // pixel 0: G
+ * WS2812_Show(leds, 8);        // คืนทันที ส่งใน background
+ * WS2812_Wait();
+ *
+ * @note ทั้ง timer ทำงานที่ 800 kHz: channel อื่นบน timer เดียวกันใช้ PWM ความถี่อื่นไม่ได้
+ * @note Interrupt อื่นต้องไม่ค้างนานกว่าการส่งครึ่ง buffer (CHUNK × 30 us)
+ */
+
+#ifndef __SIMPLE_WS2812_H
+#define __SIMPLE_WS2812_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <ch32v00x.h>
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimplePWM.h"
+#include "SimpleDMA.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief จำนวน pixels ต่อครึ่ง buffer (เพิ่มถ้ามี interrupt อื่นที่ใช้เวลานาน)
+ */
+#ifndef SIMPLE_WS2812_CHUNK_PIXELS
+#define SIMPLE_WS2812_CHUNK_PIXELS 2
+#endif
+
+/**
+ * @brief เวลาที่ line ค้าง low หลังจบ frame (us) ก่อนส่ง frame ถัดไปได้
+ *
+ * @details WS2812B รุ่นใหม่ต้องการ > 280 us, รุ่นเก่า > 50 us
+ */
+#ifndef SIMPLE_WS2812_RESET_US
+#define SIMPLE_WS2812_RESET_US 300
+#endif
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief ผลลัพธ์ของ WS2812_Init()
+ */
+typedef enum {
+    WS2812_OK = 0,          /**< สำเร็จ */
+    WS2812_ERROR_CHANNEL,   /**< PWM channel ไม่ถูกต้อง */
+    WS2812_ERROR_DMA        /**< DMA channel ของ timer ถูกใช้อยู่ */
+} WS2812_Status;
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่มต้น PWM 800 kHz และจอง DMA channel ของ timer
+ * @param channel PWM channel ที่ต่อกับ DIN ของ strip (PWM1_CH1 - PWM2_CH4)
+ * @return WS2812_OK หรือ error
+ *
+ * @note เรียกใหม่หลังเปลี่ยน SystemCoreClock (timing คำนวณจาก clock ตอน init)
+ */
+WS2812_Status WS2812_Init(PWM_Channel channel);
+
+/**
+ * @brief ส่ง frame แบบ non-blocking
+ * @param grb pixels แบบ GRB 3 bytes ต่อ pixel
+ * @param count จำนวน pixels
+ *
+ * @note รอ frame ก่อนหน้า (รวม reset time) ให้จบก่อนเริ่ม
+ * @warning ห้ามแก้ grb จนกว่า WS2812_Busy() = 0 (อ่านทีละ chunk ระหว่างส่ง)
+ */
+void WS2812_Show(const uint8_t* grb, uint16_t count);
+
+/**
+ * @brief ตรวจสอบว่ากำลังส่งหรือยังอยู่ใน reset time
+ * @return 1 = busy, 0 = พร้อมส่ง frame ถัดไป
+ */
+uint8_t WS2812_Busy(void);
+
+/**
+ * @brief รอจนส่ง frame เสร็จและครบ reset time
+ */
+void WS2812_Wait(void);
+
+/**
+ * @brief หยุดส่งทันทีและคืน DMA channel (line ค้าง low)
+ */
+void WS2812_Deinit(void);
+
+/* ========== Helper Functions ========== */
+
+/**
+ * @brief ใส่สีของ pixel ลง buffer GRB
+ */
+static inline void WS2812_SetPixel(uint8_t* grb, uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    uint8_t* p = grb + index * 3;
+    p[0] = g;
+    p[1] = r;
+    p[2] = b;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_WS2812_H
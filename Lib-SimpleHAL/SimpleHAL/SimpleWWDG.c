@@ -1,17 +1,20 @@
 /********************************** SimpleWWDG Library *******************************
  * File Name          : SimpleWWDG.c
  * Author             : SimpleHAL
- * Version            : V1.0.0
- * Date               : 2025-12-21
+ * Version            : V1.1.0
+ * Date               : 2026-10-14
  * Description        : Simple Window Watchdog (WWDG) library for CH32V003
  **********************************************************************************/
 #include "SimpleWWDG.h"
+#include "SimpleClock.h"
+#include "SimpleISRStat.h"
 
 /******************************************************************************/
 /*                              Private Variables                             */
 /******************************************************************************/
 
 static void (*WWDG_Callback)(void) = 0;
+static uint16_t wwdg_clocks = 0;  // Clock ที่ SimpleWWDG ถืออยู่
 
 /******************************************************************************/
 /*                              Basic API Functions                           */
@@ -59,7 +62,7 @@ void WWDG_Init(uint8_t counter, uint8_t window, uint32_t prescaler)
     if(window > WWDG_WINDOW_MAX) window = WWDG_WINDOW_MAX;
     
     // Enable WWDG clock
-    RCC_APB1PeriphClockCmd(RCC_APB1Periph_WWDG, ENABLE);
+    Clock_AcquireOnce(CLOCK_WWDG, &wwdg_clocks);
     
     // Set prescaler
     WWDG_SetPrescaler(prescaler);
@@ -85,7 +88,7 @@ void WWDG_InitWithInterrupt(uint8_t counter, uint8_t window, uint32_t prescaler)
     if(window > WWDG_WINDOW_MAX) window = WWDG_WINDOW_MAX;
     
     // Enable WWDG clock
-    RCC_APB1PeriphClockCmd(RCC_APB1Periph_WWDG, ENABLE);
+    Clock_AcquireOnce(CLOCK_WWDG, &wwdg_clocks);
     
     // Configure NVIC for WWDG interrupt
     NVIC_InitStructure.NVIC_IRQChannel = WWDG_IRQn;
@@ -165,6 +168,7 @@ void WWDG_ClearInterruptFlag(void)
 void WWDG_Disable(void)
 {
     WWDG_DeInit();
+    Clock_ReleaseOnce(CLOCK_WWDG, &wwdg_clocks);
 }
 
 /******************************************************************************/
@@ -176,6 +180,7 @@ void WWDG_Disable(void)
  */
 void WWDG_IRQHandler_Callback(void)
 {
+    ISR_STAT_ENTER(ISR_STAT_WWDG);
     if(WWDG_GetFlagStatus() == SET)
     {
         // Clear interrupt flag
@@ -187,4 +192,5 @@ void WWDG_IRQHandler_Callback(void)
             WWDG_Callback();
         }
     }
+    ISR_STAT_EXIT(ISR_STAT_WWDG);
 }
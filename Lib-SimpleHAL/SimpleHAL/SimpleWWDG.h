@@ -16,6 +16,7 @@ extern "C" {
 #include "ch32v00x.h"
 #include "ch32v00x_wwdg.h"
 #include "ch32v00x_rcc.h"
+#include "SimpleHAL_Config.h"
 
 /******************************************************************************/
 /*                              Prescaler Constants                           */
@@ -0,0 +1,411 @@
+/**
+ * @file SimpleZeroCross.c
+ * @brief Comparator Zero-crossing Detector Implementation
+ * @version 1.0
+ * @date 2026-10-15
+ */
+
+#include "SimpleZeroCross.h"
+#include "SimpleClock.h"
+#include <stddef.h>
+
+/* ========== Private Definitions ========== */
+
+#define ZC_TICK_HZ        1000000UL   // 1 tick = 1 µs
+#define ZC_MIN_PERIOD_Q4  ((ZC_TICK_HZ << 4) / SIMPLE_ZEROCROSS_MAX_HZ)
+#define ZC_MAX_PERIOD_Q4  ((ZC_TICK_HZ << 4) / SIMPLE_ZEROCROSS_MIN_HZ)
+
+// Overflow (65.536 ms) ที่ไม่มีจุดตัดแล้วถือว่าสัญญาณหาย: 2 คาบที่ความถี่ต่ำสุด
+#define ZC_IDLE_OVERFLOWS  (uint8_t)(((2 * ZC_TICK_HZ / SIMPLE_ZEROCROSS_MIN_HZ) >> 16) + 2)
+
+#define ZC_OC3M_MASK      0x0070      // OC3M ใน CHCTLR2
+
+/* ========== Private Variables ========== */
+
+static volatile uint16_t zc_high = 0;       // bits 16-31 ของ timebase (นับ overflow)
+static uint8_t zc_idle = 0;                 // overflows นับจากจุดตัดล่าสุด
+
+static uint32_t zc_last_edge = 0;           // ขอบล่าสุดที่รับ (ก่อนชดเชย)
+static uint32_t zc_last_same[2];            // ขอบล่าสุดแยกตามทิศ [0] = ลง, [1] = ขึ้น
+static uint8_t zc_have_same = 0;            // bit 0/1: zc_last_same[] ใช้ได้
+static uint8_t zc_last_rising = 0xFF;       // 0xFF = ยังไม่มีขอบ
+
+static uint32_t zc_period_q4;               // คาบที่กรองแล้ว (µs × 16)
+static uint32_t zc_prev_period = 0;         // คาบก่อนหน้า (µs) ใช้ตอนยังไม่ lock
+static int32_t zc_skew_q4 = 0;              // offset ของ comparator (µs × 16)
+static uint8_t zc_good = 0;                 // คาบต่อเนื่องที่ตรงกัน
+static volatile uint8_t zc_locked = 0;
+
+static volatile uint32_t zc_crossing = 0;   // จุดตัดล่าสุด (หลังชดเชย)
+static volatile uint32_t zc_rise_zero = 0;  // จุดตัดขาขึ้นล่าสุด
+static volatile uint8_t zc_crossing_rising = 0;
+
+static uint16_t zc_comp_us = 0;
+static volatile uint16_t zc_fire_delay = 0;
+static volatile uint16_t zc_fire_width = 0;
+static volatile uint8_t zc_fire_mode = ZEROCROSS_FIRE_OFF;
+
+static ZeroCross_Callback zc_callback = NULL;
+static uint16_t zc_clocks = 0;
+
+const uint16_t zerocross_ram_bytes = sizeof(zc_high) + sizeof(zc_idle) + sizeof(zc_last_edge) +
+                                     sizeof(zc_last_same) + sizeof(zc_have_same) +
+                                     sizeof(zc_last_rising) + sizeof(zc_period_q4) +
+                                     sizeof(zc_prev_period) + sizeof(zc_skew_q4) +
+                                     sizeof(zc_good) + sizeof(zc_locked) + sizeof(zc_crossing) +
+                                     sizeof(zc_rise_zero) + sizeof(zc_crossing_rising) +
+                                     sizeof(zc_comp_us) + sizeof(zc_fire_delay) +
+                                     sizeof(zc_fire_width) + sizeof(zc_fire_mode) +
+                                     sizeof(zc_callback) + sizeof(zc_clocks);
+
+/* ========== Private Functions ========== */
+
+/**
+ * @brief ตั้ง OC3M (output compare mode ของ CH3)
+ */
+static inline void ZeroCross_SetOC3(uint16_t mode) {
+    TIM2->CHCTLR2 = (uint16_t)((TIM2->CHCTLR2 & ~ZC_OC3M_MASK) | mode);
+}
+
+/**
+ * @brief ล้าง tracker (สัญญาณหายหรือเริ่มใหม่)
+ */
+static void ZeroCross_Unlock(void) {
+    zc_locked = 0;
+    zc_good = 0;
+    zc_have_same = 0;
+    zc_prev_period = 0;
+    zc_last_rising = 0xFF;
+    zc_period_q4 = ZC_MIN_PERIOD_Q4;   // blanking สั้นสุดจนกว่าจะวัดคาบได้
+    ZeroCross_SetOC3(TIM_ForcedAction_InActive);
+}
+
+/**
+ * @brief Overflow ของ counter: ขยาย timebase และตรวจสัญญาณหาย
+ */
+static void ZeroCross_Overflow(void) {
+    zc_high++;
+    if (zc_idle < ZC_IDLE_OVERFLOWS && ++zc_idle >= ZC_IDLE_OVERFLOWS) {
+        ZeroCross_Unlock();
+    }
+}
+
+/**
+ * @brief นัด pulse ของ CH3 ที่ delay หลังจุดตัด
+ */
+static void ZeroCross_ScheduleFire(uint32_t zero, uint8_t rising) {
+    uint8_t mode = zc_fire_mode;
+    if (mode == ZEROCROSS_FIRE_OFF || (mode == ZEROCROSS_FIRE_RISING && !rising)) return;
+
+    uint32_t delay = zc_fire_delay;
+    if (delay + zc_fire_width >= (zc_period_q4 >> 5)) return;   // ล้ำครึ่งคาบถัดไป
+
+    uint16_t at = (uint16_t)(zero + delay);
+
+    if ((int16_t)(at - (uint16_t)TIM2->CNT) <= 0) {
+        // ISR มาช้ากว่าเวลายิง: เริ่ม pulse ทันที ความกว้างยังนับด้วย hardware
+        ZeroCross_SetOC3(TIM_ForcedAction_Active);
+        TIM2->CH3CVR = (uint16_t)(TIM2->CNT + zc_fire_width);
+        ZeroCross_SetOC3(TIM_OCMode_Inactive);
+        return;
+    }
+
+    TIM2->CH3CVR = at;
+    ZeroCross_SetOC3(TIM_OCMode_Active);
+}
+
+/**
+ * @brief รับขอบหนึ่งขอบจาก capture
+ * @param rising 1 = CH1 (ขอบขึ้น), 0 = CH2 (ขอบลง)
+ * @param cv ค่า capture (16 bits ล่าง)
+ */
+static void ZeroCross_Edge(uint8_t rising, uint16_t cv) {
+    uint16_t high = zc_high;
+
+    // Overflow ที่ค้างอยู่พร้อม capture: capture ครึ่งล่าง = เกิดหลัง overflow
+    if (TIM2->INTFR & TIM_IT_Update) {
+        TIM2->INTFR = (uint16_t)~TIM_IT_Update;
+        ZeroCross_Overflow();
+        if (cv < 0x8000) high++;
+    }
+
+    uint32_t edge = ((uint32_t)high << 16) | cv;
+
+    // Blanking: ต้องสลับทิศ และห่างจากขอบก่อนหน้าอย่างน้อย 3/4 ของครึ่งคาบ
+    uint32_t since = edge - zc_last_edge;
+    if (zc_last_rising != 0xFF) {
+        if (rising == zc_last_rising) return;
+        if (since < ((zc_period_q4 >> 5) * 3) / 4) return;
+    }
+
+    zc_idle = 0;
+    zc_last_edge = edge;
+    zc_last_rising = rising;
+
+    // คาบจากขอบทิศเดียวกัน: offset ของ comparator หักล้างกันเอง
+    uint8_t bit = (uint8_t)(1u << rising);
+    uint32_t period = edge - zc_last_same[rising];
+    uint8_t measured = (zc_have_same & bit) &&
+                       period >= (ZC_MIN_PERIOD_Q4 >> 4) && period <= (ZC_MAX_PERIOD_Q4 >> 4);
+    zc_last_same[rising] = edge;
+    zc_have_same |= bit;
+
+    if (measured) {
+        uint32_t period_q4 = period << 4;
+
+        if (zc_locked) {
+            uint32_t diff = period_q4 > zc_period_q4 ? period_q4 - zc_period_q4
+                                                     : zc_period_q4 - period_q4;
+            if (diff > (zc_period_q4 >> 3)) {
+                // เริ่ม acquire ใหม่จากขอบนี้
+                ZeroCross_Unlock();
+                zc_last_edge = edge;
+                zc_last_rising = rising;
+                zc_last_same[rising] = edge;
+                zc_have_same = bit;
+                return;
+            }
+            zc_period_q4 += (int32_t)(period_q4 - zc_period_q4) >> SIMPLE_ZEROCROSS_AVG_SHIFT;
+        } else {
+            // ยังไม่ lock: ใช้คาบล่าสุดตรงๆ (acquire เร็ว) นับเฉพาะคาบที่ตรงกับคาบก่อน
+            uint32_t diff = period > zc_prev_period ? period - zc_prev_period
+                                                    : zc_prev_period - period;
+            zc_good = (diff <= (period >> 3)) ? (uint8_t)(zc_good + 1) : 0;
+            zc_prev_period = period;
+            zc_period_q4 = period_q4;
+            if (zc_good >= SIMPLE_ZEROCROSS_LOCK_COUNT) {
+                zc_locked = 1;
+            }
+        }
+
+        // ครึ่งคาบจากขอบลงถึงขอบขึ้น = T/2 + 2d, ขอบขึ้นถึงขอบลง = T/2 - 2d
+        int32_t half_q4 = (int32_t)(zc_period_q4 >> 1);
+        int32_t skew = ((int32_t)(since << 4) - half_q4) / 2;
+        if (!rising) skew = -skew;
+        zc_skew_q4 += (skew - zc_skew_q4) >> SIMPLE_ZEROCROSS_AVG_SHIFT;
+    }
+
+    // ขอบขึ้นช้ากว่าจุดตัดจริง d, ขอบลงเร็วกว่า d (+ delay คงที่ทั้งสองทิศ)
+    int32_t skew_us = zc_skew_q4 / 16;
+    uint32_t zero = edge - zc_comp_us - (uint32_t)(rising ? skew_us : -skew_us);
+
+    zc_crossing = zero;
+    zc_crossing_rising = rising;
+    if (rising) zc_rise_zero = zero;
+
+    if (zc_locked) {
+        ZeroCross_ScheduleFire(zero, rising);
+    }
+
+    if (zc_callback) {
+        zc_callback(zero, rising);
+    }
+}
+
+/**
+ * @brief ขอบของ pulse ที่นัดไว้ผ่านไป: ขอบขึ้น -> นัดขอบลง
+ */
+static void ZeroCross_FireEdge(void* context, uint16_t value) {
+    (void)context;
+    if ((TIM2->CHCTLR2 & ZC_OC3M_MASK) == TIM_OCMode_Active) {
+        TIM2->CH3CVR = (uint16_t)(value + zc_fire_width);
+        ZeroCross_SetOC3(TIM_OCMode_Inactive);
+    }
+}
+
+static void ZeroCross_Rising(void* context, uint16_t value) {
+    (void)context;
+    ZeroCross_Edge(1, value);
+}
+
+static void ZeroCross_Falling(void* context, uint16_t value) {
+    (void)context;
+    ZeroCross_Edge(0, value);
+}
+
+/* ========== Public Functions ========== */
+
+/**
+ * @brief เริ่มตรวจจุดตัด
+ */
+void ZeroCross_Init(OPAMP_Channel_Positive pos, OPAMP_Channel_Negative neg) {
+    TIM_End(TIM_2);
+
+    zc_high = 0;
+    zc_idle = 0;
+    zc_skew_q4 = 0;
+    zc_crossing = 0;
+    zc_rise_zero = 0;
+
+    OPAMP_ConfigComparator(pos, neg);
+    OPAMP_Enable();
+
+    // PD4 = OPAMP output = TIM2_CH1 (input ดิจิทัล), PC0 = TIM2_CH3 (pulse)
+    Clock_AcquireOnce(CLOCK_GPIOD, &zc_clocks);
+    Clock_AcquireOnce(CLOCK_GPIOC, &zc_clocks);
+
+    GPIO_InitTypeDef GPIO_InitStructure = {0};
+    GPIO_InitStructure.GPIO_Pin = GPIO_Pin_4;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
+    GPIO_Init(GPIOD, &GPIO_InitStructure);
+
+    GPIO_InitStructure.GPIO_Pin = GPIO_Pin_0;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_PP;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_30MHz;
+    GPIO_Init(GPIOC, &GPIO_InitStructure);
+
+    // Free-running 16-bit counter ที่ 1 MHz
+    TIM_AdvancedInit(TIM_2, (uint16_t)(SystemCoreClock / ZC_TICK_HZ - 1), 0xFFFF, TIM_MODE_UP);
+
+    // TI1 เข้า CH1 (ขอบขึ้น) และ CH2 (ขอบลง, indirect) พร้อมกัน
+    TIM_ICInitTypeDef TIM_ICInitStructure = {0};
+    TIM_ICInitStructure.TIM_Channel = TIM_Channel_1;
+    TIM_ICInitStructure.TIM_ICPolarity = TIM_ICPolarity_Rising;
+    TIM_ICInitStructure.TIM_ICSelection = TIM_ICSelection_DirectTI;
+    TIM_ICInitStructure.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+    TIM_ICInitStructure.TIM_ICFilter = SIMPLE_ZEROCROSS_FILTER;
+    TIM_PWMIConfig(TIM2, &TIM_ICInitStructure);
+
+    // CH3: output compare ที่เริ่มจาก forced LOW
+    TIM_OCInitTypeDef TIM_OCInitStructure = {0};
+    TIM_OCInitStructure.TIM_OCMode = TIM_OCMode_Timing;
+    TIM_OCInitStructure.TIM_OutputState = TIM_OutputState_Enable;
+    TIM_OCInitStructure.TIM_OCPolarity = TIM_OCPolarity_High;
+    TIM_OC3Init(TIM2, &TIM_OCInitStructure);
+    TIM_OC3PreloadConfig(TIM2, TIM_OCPreload_Disable);
+
+    ZeroCross_Unlock();
+
+    TIM2->INTFR = 0;
+    TIM_AttachChannelCallback(TIM_2, 1, ZeroCross_Rising, NULL);
+    TIM_AttachChannelCallback(TIM_2, 2, ZeroCross_Falling, NULL);
+    TIM_AttachChannelCallback(TIM_2, 3, ZeroCross_FireEdge, NULL);
+    TIM_AttachInterrupt(TIM_2, ZeroCross_Overflow);
+    TIM_Start(TIM_2);
+}
+
+/**
+ * @brief หยุดและคืน TIM2
+ */
+void ZeroCross_End(void) {
+    ZeroCross_SetOC3(TIM_ForcedAction_InActive);
+    TIM_CCxCmd(TIM2, TIM_Channel_1, TIM_CCx_Disable);
+    TIM_CCxCmd(TIM2, TIM_Channel_2, TIM_CCx_Disable);
+    TIM_CCxCmd(TIM2, TIM_Channel_3, TIM_CCx_Disable);
+    TIM_End(TIM_2);
+
+    zc_locked = 0;
+    Clock_ReleaseOnce(CLOCK_GPIOD, &zc_clocks);
+    Clock_ReleaseOnce(CLOCK_GPIOC, &zc_clocks);
+}
+
+/**
+ * @brief ตั้ง callback ต่อจุดตัด
+ */
+void ZeroCross_AttachCallback(ZeroCross_Callback callback) {
+    zc_callback = callback;
+}
+
+/**
+ * @brief ตั้งเวลาชดเชย delay คงที่
+ */
+void ZeroCross_SetDelayCompUs(uint16_t us) {
+    zc_comp_us = us;
+}
+
+/**
+ * @brief ตั้ง pulse หลังจุดตัด
+ */
+uint8_t ZeroCross_SetFiring(uint16_t delay_us, uint16_t width_us, ZeroCross_FireMode mode) {
+    if (mode != ZEROCROSS_FIRE_OFF && width_us == 0) return 0;
+
+    zc_fire_mode = ZEROCROSS_FIRE_OFF;   // ISR ไม่เห็นค่าครึ่งเก่าครึ่งใหม่
+    zc_fire_delay = delay_us;
+    zc_fire_width = width_us;
+    zc_fire_mode = (uint8_t)mode;
+
+    if (mode == ZEROCROSS_FIRE_OFF) {
+        ZeroCross_SetOC3(TIM_ForcedAction_InActive);
+    }
+
+    return 1;
+}
+
+/**
+ * @brief ตรวจว่า lock แล้ว
+ */
+uint8_t ZeroCross_IsLocked(void) {
+    return zc_locked;
+}
+
+/**
+ * @brief คาบที่กรองแล้ว (µs)
+ */
+uint32_t ZeroCross_GetPeriodUs(void) {
+    if (!zc_locked) return 0;
+    return (zc_period_q4 + 8) >> 4;
+}
+
+/**
+ * @brief ความถี่ × 100
+ */
+uint32_t ZeroCross_GetFrequencyHz_x100(void) {
+    uint32_t period_q4 = zc_period_q4;
+    if (!zc_locked || !period_q4) return 0;
+
+    // Hz × 100 = 10^6 × 100 × 16 / period_q4 (1.6e9 ยังอยู่ใน 32 bits)
+    return (ZC_TICK_HZ * 100 * 16 + (period_q4 >> 1)) / period_q4;
+}
+
+/**
+ * @brief Offset ของ comparator ที่วัดได้ (µs)
+ */
+int16_t ZeroCross_GetSkewUs(void) {
+    return (int16_t)(zc_skew_q4 / 16);
+}
+
+/**
+ * @brief เวลาของจุดตัดล่าสุด
+ */
+uint32_t ZeroCross_LastCrossingUs(uint8_t* rising) {
+    uint32_t t;
+    uint8_t r;
+
+    do {
+        t = zc_crossing;
+        r = zc_crossing_rising;
+    } while (t != zc_crossing);
+
+    if (rising) *rising = r;
+    return t;
+}
+
+/**
+ * @brief เวลาปัจจุบันใน timebase ของ capture
+ * @note อ่านซ้ำจน zc_high ไม่เปลี่ยน และนับ overflow ที่ ISR ยังไม่ได้จัดการ
+ *       (เรียกขณะปิด interrupt ได้)
+ */
+uint32_t ZeroCross_NowUs(void) {
+    uint16_t high, low;
+    uint8_t pending;
+
+    do {
+        high = zc_high;
+        low = (uint16_t)TIM2->CNT;
+        pending = (TIM2->INTFR & TIM_IT_Update) != 0;
+    } while (high != zc_high);
+
+    if (pending && low < 0x8000) high++;
+    return ((uint32_t)high << 16) | low;
+}
+
+/**
+ * @brief มุมของสัญญาณ ณ เวลา t
+ */
+uint16_t ZeroCross_PhaseAt(uint32_t t_us) {
+    uint32_t period_q4 = zc_period_q4;
+    if (!zc_locked || !period_q4) return 0;
+
+    uint32_t since_q4 = ((t_us - zc_rise_zero) << 4) % period_q4;
+    return (uint16_t)(((uint64_t)since_q4 << 16) / period_q4);
+}
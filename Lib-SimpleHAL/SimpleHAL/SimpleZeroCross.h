@@ -0,0 +1,188 @@
+/**
+ * @file SimpleZeroCross.h
+ * @brief Zero-crossing detector: OPAMP comparator + TIM2 input capture (timestamp µs)
+ * @version 1.0
+ * @date 2026-10-15
+ *
+ * @details
+ * OPAMP ในโหมด comparator ขับ output ที่ PD4 ซึ่งเป็นขา TIM2_CH1 ด้วย
+ * module นี้จึงให้ hardware capture ทุกขอบของ comparator (CH1 = ขอบขึ้น,
+ * CH2 = ขอบลงจาก TI1 เดียวกัน) เป็น timestamp 32-bit หน่วย µs โดยไม่ต้อง poll
+ * และไม่ขึ้นกับ interrupt latency
+ *
+ * **Hysteresis / noise:**
+ * - Input filter ของ timer (SIMPLE_ZEROCROSS_FILTER) ตัด glitch สั้นๆ
+ * - Blanking: หลังขอบที่รับแล้ว ขอบถัดไปต้องสลับทิศ และห่างอย่างน้อย 3/4 ของครึ่งคาบ
+ *   (comparator ที่สั่นรอบจุดตัดให้ผลแค่ขอบแรก)
+ * - Offset ของ comparator ทำให้ครึ่งคาบบวก/ลบยาวไม่เท่ากัน: module วัดความต่างแล้ว
+ *   ชดเชยให้เวลาของจุดตัดทั้งสองทิศห่างกันครึ่งคาบพอดี
+ * - Delay คงที่ (filter + hysteresis ภายนอก) ตั้งชดเชยด้วย ZeroCross_SetDelayCompUs()
+ *
+ * **Period / phase tracker:**
+ * - คาบวัดจากขอบทิศเดียวกัน (ไม่ขึ้นกับ offset) กรองด้วย IIR (SIMPLE_ZEROCROSS_AVG_SHIFT)
+ * - Lock เมื่อคาบต่อเนื่อง SIMPLE_ZEROCROSS_LOCK_COUNT ครั้งตรงกันภายใน 1/8
+ * - Phase = มุมจากจุดตัดขาขึ้นล่าสุด (0-65535 = 0-360°)
+ *
+ * **Triac / phase-angle firing (TIM2_CH3 = PC0):**
+ * - ZeroCross_SetFiring() ตั้ง pulse ที่ delay หลังจุดตัด: compare ของ CH3 คำนวณจาก
+ *   ค่า capture ของขอบ (ไม่ใช่เวลาที่ ISR ทำงาน) ขอบของ pulse จึงตรงตาม hardware
+ *
+ * @example
+ * // Dimmer 50 Hz: gate pulse 100 us ที่ 5 ms หลังทุกจุดตัด (~50% power)
+ * ZeroCross_Init(OPAMP_CHP0, OPAMP_CHN0);   // PA2 = สัญญาณ AC (ลดทอน), PA1 = Vref
+ * ZeroCross_SetFiring(5000, 100, ZEROCROSS_FIRE_BOTH);
+ *
+ * while (1) {
+ *     if (ZeroCross_IsLocked()) {
+ *         uint32_t hz_x100 = ZeroCross_GetFrequencyHz_x100();   // 5000 = 50.00 Hz
+ *     }
+ * }
+ *
+ * @note ใช้ TIM2 ทั้งตัว (ห้ามใช้ร่วมกับ SimplePWM/SimpleTIM/Capture บน TIM2)
+ * @note PD4 เป็น input (ไม่ใช่ analog) เพื่อให้ timer อ่านระดับของ comparator ได้
+ */
+
+#ifndef __SIMPLE_ZEROCROSS_H
+#define __SIMPLE_ZEROCROSS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "SimpleHAL_Config.h"
+#include "SimpleOPAMP.h"
+#include "SimpleTIM.h"
+
+/* ========== Configuration ========== */
+
+/**
+ * @brief Input filter ของ capture (ICxF, 0-15): 15 = 8 samples ที่ 1.5 MHz (~5.3 µs)
+ */
+#ifndef SIMPLE_ZEROCROSS_FILTER
+#define SIMPLE_ZEROCROSS_FILTER 15
+#endif
+
+/**
+ * @brief ช่วงความถี่ของสัญญาณ (Hz) นอกช่วงนี้ไม่นับเป็นคาบ
+ */
+#ifndef SIMPLE_ZEROCROSS_MIN_HZ
+#define SIMPLE_ZEROCROSS_MIN_HZ 40
+#endif
+
+#ifndef SIMPLE_ZEROCROSS_MAX_HZ
+#define SIMPLE_ZEROCROSS_MAX_HZ 70
+#endif
+
+/**
+ * @brief log2 ของค่าคงที่ IIR ของคาบและ offset (3 = ~8 คาบ)
+ */
+#ifndef SIMPLE_ZEROCROSS_AVG_SHIFT
+#define SIMPLE_ZEROCROSS_AVG_SHIFT 3
+#endif
+
+/**
+ * @brief จำนวนคาบที่ต้องตรงกันก่อน lock
+ */
+#ifndef SIMPLE_ZEROCROSS_LOCK_COUNT
+#define SIMPLE_ZEROCROSS_LOCK_COUNT 4
+#endif
+
+/* ========== Type Definitions ========== */
+
+/**
+ * @brief จุดตัดที่ใช้ยิง pulse
+ */
+typedef enum {
+    ZEROCROSS_FIRE_OFF = 0,   /**< ไม่ยิง (PC0 = LOW) */
+    ZEROCROSS_FIRE_RISING,    /**< เฉพาะจุดตัดขาขึ้น (ครั้งต่อคาบ) */
+    ZEROCROSS_FIRE_BOTH       /**< ทุกจุดตัด (ทุกครึ่งคาบ เช่น triac) */
+} ZeroCross_FireMode;
+
+/**
+ * @brief Callback ทุกจุดตัดที่รับ (เรียกจาก interrupt)
+ * @param zero_us เวลาของจุดตัดหลังชดเชย (timebase เดียวกับ ZeroCross_NowUs())
+ * @param rising 1 = ขาขึ้น, 0 = ขาลง
+ */
+typedef void (*ZeroCross_Callback)(uint32_t zero_us, uint8_t rising);
+
+/* ========== Function Prototypes ========== */
+
+/**
+ * @brief เริ่มตรวจจุดตัด: OPAMP comparator (pos > neg = HIGH) + TIM2 capture ที่ 1 MHz
+ * @param pos input ของสัญญาณ
+ * @param neg input ของแรงดันอ้างอิง (จุดตัด)
+ */
+void ZeroCross_Init(OPAMP_Channel_Positive pos, OPAMP_Channel_Negative neg);
+
+/**
+ * @brief หยุดและคืน TIM2 (OPAMP ยังเปิดอยู่)
+ */
+void ZeroCross_End(void);
+
+/**
+ * @brief ตั้ง callback ต่อจุดตัด (NULL = ยกเลิก)
+ */
+void ZeroCross_AttachCallback(ZeroCross_Callback callback);
+
+/**
+ * @brief ตั้งเวลาชดเชย delay คงที่ของ comparator/filter/hysteresis ภายนอก
+ * @param us เวลาที่ขอบเกิดช้ากว่าจุดตัดจริง (µs)
+ */
+void ZeroCross_SetDelayCompUs(uint16_t us);
+
+/**
+ * @brief ตั้ง pulse ที่ PC0 (TIM2_CH3) หลังจุดตัด
+ * @param delay_us เวลาจากจุดตัดถึงขอบขึ้นของ pulse
+ * @param width_us ความกว้าง pulse
+ * @param mode ZEROCROSS_FIRE_OFF / RISING / BOTH
+ * @return 1 = สำเร็จ, 0 = width เป็น 0
+ *
+ * @note ยิงเฉพาะตอน lock และเมื่อ delay + width สั้นกว่าครึ่งคาบ
+ * @note เปลี่ยนค่าได้ตลอด (มีผลที่จุดตัดถัดไป) เช่น dimmer ปรับ delay ตามความสว่าง
+ */
+uint8_t ZeroCross_SetFiring(uint16_t delay_us, uint16_t width_us, ZeroCross_FireMode mode);
+
+/**
+ * @brief ตรวจว่า tracker lock กับสัญญาณแล้ว
+ */
+uint8_t ZeroCross_IsLocked(void);
+
+/**
+ * @brief คาบที่กรองแล้ว (µs), 0 = ยังไม่ lock
+ */
+uint32_t ZeroCross_GetPeriodUs(void);
+
+/**
+ * @brief ความถี่ × 100 (5000 = 50.00 Hz), 0 = ยังไม่ lock
+ */
+uint32_t ZeroCross_GetFrequencyHz_x100(void);
+
+/**
+ * @brief Offset ของ comparator ที่วัดได้ (µs ที่ขอบขาขึ้นช้ากว่าจุดตัด, ขาลงเร็วกว่า)
+ */
+int16_t ZeroCross_GetSkewUs(void);
+
+/**
+ * @brief เวลาของจุดตัดล่าสุด (หลังชดเชย)
+ * @param rising ทิศของจุดตัด (NULL = ไม่ต้องการ)
+ */
+uint32_t ZeroCross_LastCrossingUs(uint8_t* rising);
+
+/**
+ * @brief เวลาปัจจุบันใน timebase ของ capture (µs, wrap ที่ 2^32)
+ */
+uint32_t ZeroCross_NowUs(void);
+
+/**
+ * @brief มุมของสัญญาณ ณ เวลา t
+ * @param t_us เวลาใน timebase ของ ZeroCross_NowUs()
+ * @return 0-65535 = 0-360° จากจุดตัดขาขึ้น (0 ถ้ายังไม่ lock)
+ */
+uint16_t ZeroCross_PhaseAt(uint32_t t_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SIMPLE_ZEROCROSS_H
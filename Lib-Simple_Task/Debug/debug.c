@@ -11,12 +11,16 @@
  *******************************************************************************/
 #include <debug.h>
 
-static uint8_t p_us = 0;
-static uint16_t p_ms = 0;
-
 #define DEBUG_DATA0_ADDRESS ((volatile uint32_t *)0xE00000F4)
 #define DEBUG_DATA1_ADDRESS ((volatile uint32_t *)0xE00000F8)
 
+#if TM_TIMEBASE_SIMPLEHAL
+// SysTick, millis and Delay_Us/Delay_Ms come from SimpleDelay
+void Delay_Init(void) { Timer_Init(); }
+#else
+static uint8_t p_us = 0;
+static uint16_t p_ms = 0;
+
 volatile uint32_t g_millis = 0;
 
 void Delay_Init(void) {
@@ -61,6 +65,7 @@ void Delay_Ms(uint32_t n) {
   while ((g_millis - start) < n)
     ;
 }
+#endif
 
 /*********************************************************************
  * @fn      USART_Printf_Init
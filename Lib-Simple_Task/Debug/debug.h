@@ -38,10 +38,26 @@ extern "C" {
 #define SDI_PRINT SDI_PR_CLOSE
 #endif
 
+/* Timebase Definition
+ * 1 = use SimpleDelay (Lib-SimpleHAL) as the only SysTick owner: no second
+ *     SysTick_Handler/millis here, Delay_Init() starts Timer_Init(). Read time
+ *     with TM_Millis()/Get_CurrentMs() (millis() is not provided).
+ * 0 = private 1 ms SysTick below (Lib-Simple_Task on its own)
+ * Define it for every file of the project (e.g. -DTM_TIMEBASE_SIMPLEHAL=1).
+ */
+#ifndef TM_TIMEBASE_SIMPLEHAL
+#define TM_TIMEBASE_SIMPLEHAL 0
+#endif
+
+#if TM_TIMEBASE_SIMPLEHAL
+#include "SimpleDelay.h"
+void Delay_Init(void);
+#else
 void Delay_Init(void);
 void Delay_Us(uint32_t n);
 void Delay_Ms(uint32_t n);
 uint32_t millis(void);
+#endif
 void USART_Printf_Init(uint32_t baudrate);
 void SDI_Printf_Enable(void);
 
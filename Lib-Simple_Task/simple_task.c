@@ -16,6 +16,379 @@ void TM_Init(void) {
 /**
  * @brief  Get current millis
  */
-uint32_t TM_Millis(void) { return millis(); }
+uint32_t TM_Millis(void) {
+#if TM_TIMEBASE_SIMPLEHAL
+  return Get_CurrentMs();
+#else
+  return millis();
+#endif
+}
 
 // No ISR required here anymore, logic moved to debug.c SysTick_Handler
+
+/* ========== Phase-locked Periods ========== */
+
+/**
+ * @brief  Next deadline after a run that was due at 'due' and started at 'now'
+ */
+static uint32_t tm_next_due(uint32_t due, uint32_t now, uint32_t period,
+                            uint8_t policy, uint16_t *missed) {
+  uint32_t late = now - due;
+  uint32_t behind;
+
+  if (policy == TM_PERIOD_DRIFT)
+    return now + period;
+  if (late < period)
+    return due + period; // on time: stay on the grid
+
+  // Whole periods that passed without a run (only computed on overrun)
+  behind = late / period;
+  switch (policy) {
+  case TM_PERIOD_CATCHUP:
+    if (behind <= TM_CATCHUP_MAX)
+      return due + period; // owed runs follow back-to-back
+    due += (behind - TM_CATCHUP_MAX) * period;
+    behind -= TM_CATCHUP_MAX;
+    break;
+  case TM_PERIOD_RESYNC:
+    due = now;
+    break;
+  default: // TM_PERIOD_SKIP
+    due += behind * period;
+    break;
+  }
+
+  *missed = (*missed + behind > 0xFFFF) ? 0xFFFF : (uint16_t)(*missed + behind);
+  return due + period;
+}
+
+/**
+ * @brief  Check and advance a phase-locked period
+ */
+uint8_t TM_PeriodDue(TM_Period *p, uint32_t ms, TM_Policy policy) {
+  uint32_t now = TM_Millis();
+
+  if (!p->started) {
+    p->started = 1;
+    p->due = now + ms;
+    return 0;
+  }
+  if ((int32_t)(now - p->due) < 0)
+    return 0;
+
+  p->due = tm_next_due(p->due, now, ms, policy, &p->missed);
+  return 1;
+}
+
+/* ========== Cooperative Scheduler ========== */
+
+// Min-heap of scheduled tasks, root = earliest deadline
+static TM_Task *tm_heap[TM_MAX_TASKS];
+static uint8_t tm_heap_size = 0;
+static void (*tm_idle_hook)(uint32_t ms_to_next) = 0;
+static TM_Task *tm_current = 0;
+
+#if TM_PROFILE || TM_WATCHDOG
+static TM_Task *tm_table = 0;
+static uint8_t tm_table_count = 0;
+#endif
+
+#if TM_WATCHDOG
+/**
+ * @brief  Watchdog id = table index, TASKWDG_NONE outside the table (unsupervised)
+ */
+static uint8_t tm_wdg_id(const TM_Task *task) {
+  if (task < tm_table || task >= tm_table + tm_table_count)
+    return TASKWDG_NONE;
+  return (uint8_t)(task - tm_table);
+}
+
+/**
+ * @brief  Expect the task to start by due + TM_WATCHDOG_MARGIN_MS
+ */
+static void tm_wdg_arm(const TM_Task *task) {
+  uint8_t id = tm_wdg_id(task);
+  TaskWDG_Register(id, TM_WATCHDOG_MARGIN_MS);
+  TaskWDG_CheckInAt(id, task->due);
+}
+#endif
+
+#if TM_PROFILE
+#include <stdio.h>
+
+static uint64_t tm_busy_ticks = 0;
+static uint64_t tm_window_ticks = 0;
+static uint32_t tm_last_ticks = 0;
+
+/**
+ * @brief  Extend the load window (call more often than the tick source wraps)
+ */
+static void tm_profile_window(void) {
+  uint32_t now = TM_PROFILE_TICKS();
+  tm_window_ticks += (uint32_t)(now - tm_last_ticks);
+  tm_last_ticks = now;
+}
+
+static void tm_profile_record(TM_Task *task, uint32_t late, uint32_t ticks) {
+  TM_TaskStats *s = &task->stats;
+  s->runs++;
+  s->ticks_total += ticks;
+  if (ticks > s->ticks_max)
+    s->ticks_max = ticks;
+  s->late_total += late;
+  if (late > s->late_max)
+    s->late_max = late;
+  tm_busy_ticks += ticks;
+}
+#endif
+
+/**
+ * @brief  a runs before b (wrap-safe deadline, then priority)
+ */
+static inline uint8_t tm_before(const TM_Task *a, const TM_Task *b) {
+  int32_t diff = (int32_t)(a->due - b->due);
+  if (diff != 0)
+    return diff < 0;
+  return a->priority < b->priority;
+}
+
+static inline void tm_place(TM_Task *task, uint8_t slot) {
+  tm_heap[slot] = task;
+  task->slot = slot;
+}
+
+static void tm_sift_up(uint8_t slot) {
+  TM_Task *task = tm_heap[slot];
+  while (slot > 0) {
+    uint8_t parent = (uint8_t)((slot - 1) >> 1);
+    if (!tm_before(task, tm_heap[parent]))
+      break;
+    tm_place(tm_heap[parent], slot);
+    slot = parent;
+  }
+  tm_place(task, slot);
+}
+
+static void tm_sift_down(uint8_t slot) {
+  TM_Task *task = tm_heap[slot];
+  for (;;) {
+    uint8_t child = (uint8_t)(slot * 2 + 1);
+    if (child >= tm_heap_size)
+      break;
+    if (child + 1 < tm_heap_size && tm_before(tm_heap[child + 1], tm_heap[child]))
+      child++;
+    if (!tm_before(tm_heap[child], task))
+      break;
+    tm_place(tm_heap[child], slot);
+    slot = child;
+  }
+  tm_place(task, slot);
+}
+
+static void tm_push(TM_Task *task) {
+  if (tm_heap_size >= TM_MAX_TASKS)
+    return;
+  tm_place(task, tm_heap_size++);
+  tm_sift_up(task->slot);
+#if TM_WATCHDOG
+  tm_wdg_arm(task);
+#endif
+}
+
+static void tm_remove(TM_Task *task) {
+  uint8_t slot = task->slot;
+  TM_Task *last = tm_heap[--tm_heap_size];
+  task->slot = 0xFF;
+#if TM_WATCHDOG
+  TaskWDG_Unregister(tm_wdg_id(task));
+#endif
+  if (last == task)
+    return;
+
+  // Move the last entry into the hole, then restore order in either direction
+  tm_place(last, slot);
+  if (slot > 0 && tm_before(last, tm_heap[(slot - 1) >> 1]))
+    tm_sift_up(slot);
+  else
+    tm_sift_down(slot);
+}
+
+/**
+ * @brief  Load a static task table
+ */
+void TM_SchedulerInit(TM_Task *table, uint8_t count) {
+  uint32_t now = TM_Millis();
+
+  tm_heap_size = 0;
+  if (count > TM_MAX_TASKS)
+    count = TM_MAX_TASKS;
+#if TM_PROFILE || TM_WATCHDOG
+  tm_table = table;
+  tm_table_count = count;
+#endif
+#if TM_PROFILE
+  TM_ResetStats();
+#endif
+
+  for (uint8_t i = 0; i < count; i++) {
+    table[i].slot = 0xFF;
+    if (table[i].fn) {
+      table[i].due = now + table[i].offset;
+      tm_push(&table[i]);
+    }
+  }
+}
+
+/**
+ * @brief  Run all due tasks
+ */
+uint32_t TM_RunPending(void) {
+#if TM_PROFILE
+  tm_profile_window();
+#endif
+  while (tm_heap_size > 0) {
+    TM_Task *task = tm_heap[0];
+    uint32_t now = TM_Millis();
+    int32_t wait = (int32_t)(task->due - now);
+
+    if (wait > 0) {
+#if TM_WATCHDOG
+      TaskWDG_Service();
+#endif
+      return (uint32_t)wait;
+    }
+
+    // Reschedule before the call so the task may stop/restart itself
+    if (task->period) {
+      task->due = tm_next_due(task->due, now, task->period, task->policy, &task->missed);
+      tm_sift_down(0);
+#if TM_WATCHDOG
+      tm_wdg_arm(task);
+#endif
+    } else {
+      tm_remove(task);
+    }
+    tm_current = task;
+#if TM_WATCHDOG
+    TaskWDG_Enter(tm_wdg_id(task));
+#endif
+#if TM_PROFILE
+    uint32_t start = TM_PROFILE_TICKS();
+    task->fn(task->ctx);
+    tm_profile_record(task, (uint32_t)-wait, TM_PROFILE_TICKS() - start);
+#else
+    task->fn(task->ctx);
+#endif
+#if TM_WATCHDOG
+    TaskWDG_Leave();
+#endif
+    tm_current = 0;
+  }
+#if TM_WATCHDOG
+  TaskWDG_Service();
+#endif
+  return TM_NO_DEADLINE;
+}
+
+/**
+ * @brief  One scheduler pass
+ */
+void TM_Run(void) {
+  uint32_t next = TM_RunPending();
+  if (!next)
+    return;
+#if TM_TIMEBASE_SIMPLEHAL
+  SimpleHAL_Idle();
+#endif
+  if (tm_idle_hook)
+    tm_idle_hook(next);
+}
+
+/**
+ * @brief  Install the idle hook
+ */
+void TM_SetIdleHook(void (*hook)(uint32_t ms_to_next)) { tm_idle_hook = hook; }
+
+/**
+ * @brief  (Re)schedule a task
+ */
+void TM_TaskStart(TM_Task *task, uint32_t delay_ms) {
+  if (!task || !task->fn)
+    return;
+  if (task->slot != 0xFF)
+    tm_remove(task);
+  task->due = TM_Millis() + delay_ms;
+  tm_push(task);
+}
+
+/**
+ * @brief  Task currently being run
+ */
+TM_Task *TM_Current(void) { return tm_current; }
+
+/**
+ * @brief  Delay the next run of the current task
+ */
+void TM_Delay(uint32_t ms) { TM_TaskStart(tm_current, ms); }
+
+/**
+ * @brief  Remove a task from the schedule
+ */
+void TM_TaskStop(TM_Task *task) {
+  if (task && task->slot != 0xFF)
+    tm_remove(task);
+}
+
+#if TM_PROFILE
+/**
+ * @brief  Clear all task statistics
+ */
+void TM_ResetStats(void) {
+  for (uint8_t i = 0; i < tm_table_count; i++) {
+    TM_TaskStats *s = &tm_table[i].stats;
+    s->runs = 0;
+    s->ticks_max = 0;
+    s->ticks_total = 0;
+    s->late_max = 0;
+    s->late_total = 0;
+  }
+  tm_busy_ticks = 0;
+  tm_window_ticks = 0;
+  tm_last_ticks = TM_PROFILE_TICKS();
+}
+
+/**
+ * @brief  CPU load since the last reset (0.1 %)
+ */
+uint16_t TM_CpuLoad_x10(void) {
+  tm_profile_window();
+  if (tm_window_ticks == 0)
+    return 0;
+  return (uint16_t)(tm_busy_ticks * 1000 / tm_window_ticks);
+}
+
+/**
+ * @brief  Print per-task statistics
+ */
+void TM_DumpStats(void) {
+  uint32_t per_us = TM_PROFILE_TICKS_PER_US;
+  if (per_us == 0)
+    per_us = 1;
+
+  printf("task  runs  avg_us  max_us  late_avg  late_max\r\n");
+  for (uint8_t i = 0; i < tm_table_count; i++) {
+    const TM_TaskStats *s = &tm_table[i].stats;
+    uint32_t avg_us = 0, late_avg = 0;
+    if (s->runs) {
+      avg_us = (uint32_t)(s->ticks_total / s->runs / per_us);
+      late_avg = s->late_total / s->runs;
+    }
+    printf("%4u %5lu %7lu %7lu %9lu %9lu\r\n", i, (unsigned long)s->runs,
+           (unsigned long)avg_us, (unsigned long)(s->ticks_max / per_us),
+           (unsigned long)late_avg, (unsigned long)s->late_max);
+  }
+
+  uint16_t load = TM_CpuLoad_x10();
+  printf("cpu %u.%u%%\r\n", load / 10, load % 10);
+}
+#endif
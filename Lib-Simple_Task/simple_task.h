@@ -41,4 +41,330 @@ uint32_t TM_Millis(void);
   if (!_done_##__LINE__ && (TM_Millis() - _start_##__LINE__ >= ms) &&          \
       (_done_##__LINE__ = 1))
 
+/* ========== Phase-locked Periods ========== */
+
+/**
+ * @brief  What a periodic job does after it missed one or more deadlines
+ */
+typedef enum {
+  TM_PERIOD_DRIFT = 0, // next = start of this run + period (RUN_EVERY behaviour)
+  TM_PERIOD_SKIP,      // stay on the grid, drop the missed runs
+  TM_PERIOD_CATCHUP,   // stay on the grid, run missed periods back-to-back (capped)
+  TM_PERIOD_RESYNC     // run once, then restart the grid from now
+} TM_Policy;
+
+/**
+ * @brief  Max back-to-back runs owed by TM_PERIOD_CATCHUP (extra ones are dropped)
+ */
+#ifndef TM_CATCHUP_MAX
+#define TM_CATCHUP_MAX 4
+#endif
+
+/**
+ * @brief  State of a phase-locked period (zero-initialize)
+ */
+typedef struct {
+  uint32_t due;    // next deadline on the grid
+  uint16_t missed; // periods dropped (never run), saturates at 65535
+  uint8_t started;
+} TM_Period;
+
+/**
+ * @brief  Check a phase-locked period and advance it by exactly one period
+ * @param  p:      Period state
+ * @param  ms:     Period in milliseconds
+ * @param  policy: Overrun policy (TM_Policy)
+ * @return 1 if the job should run now
+ * @note   The first call starts the grid; the first run is ms later
+ */
+uint8_t TM_PeriodDue(TM_Period *p, uint32_t ms, TM_Policy policy);
+
+#define TM_CONCAT_(a, b) a##b
+#define TM_CONCAT(a, b) TM_CONCAT_(a, b)
+
+/**
+ * @brief  RUN_EVERY that does not drift: deadlines advance by exactly ms
+ * @param  ms:     Interval in milliseconds
+ * @param  policy: TM_PERIOD_SKIP / TM_PERIOD_CATCHUP / TM_PERIOD_RESYNC
+ *
+ * @example
+ *   RUN_EVERY_FIXED(10, TM_PERIOD_SKIP) { pid_step(); }   // exact 100 Hz
+ *
+ * @note   Use TM_PeriodDue() with your own TM_Period to read the missed counter
+ */
+#define RUN_EVERY_FIXED(ms, policy)                                            \
+  static TM_Period TM_CONCAT(_period_, __LINE__);                              \
+  if (TM_PeriodDue(&TM_CONCAT(_period_, __LINE__), (ms), (policy)))
+
+/* ========== Cooperative Scheduler ========== */
+
+/**
+ * @brief  Max tasks in the scheduler table (heap storage is static)
+ */
+#ifndef TM_MAX_TASKS
+#define TM_MAX_TASKS 16
+#endif
+
+/**
+ * @brief  No deadline pending (returned by TM_RunPending)
+ */
+#define TM_NO_DEADLINE 0xFFFFFFFFUL
+
+/**
+ * @brief  Per-task profiling (run count, execution time, start lateness, CPU load)
+ * @note   Adds 24 bytes per task and two SysTick reads per run
+ */
+#ifndef TM_PROFILE
+#define TM_PROFILE 0
+#endif
+
+#if TM_PROFILE
+/**
+ * @brief  Free-running tick source for execution time (default SysTick CNT, HCLK/8)
+ * @note   May be overridden, e.g. Timestamp_Read() with TM_PROFILE_TICKS_PER_US 48
+ */
+#if TM_TIMEBASE_SIMPLEHAL
+// SimpleDelay reloads SysTick every 1 ms: time in microseconds instead
+#ifndef TM_PROFILE_TICKS
+#define TM_PROFILE_TICKS() Get_CurrentUs()
+#endif
+
+#ifndef TM_PROFILE_TICKS_PER_US
+#define TM_PROFILE_TICKS_PER_US 1
+#endif
+#else
+#ifndef TM_PROFILE_TICKS
+#define TM_PROFILE_TICKS() (SysTick->CNT)
+#endif
+
+#ifndef TM_PROFILE_TICKS_PER_US
+#define TM_PROFILE_TICKS_PER_US (SystemCoreClock / 8000000)
+#endif
+#endif
+
+typedef struct {
+  uint32_t runs;
+  uint32_t ticks_max;   // longest run
+  uint64_t ticks_total; // all runs
+  uint32_t late_max;    // worst start delay after the deadline (ms)
+  uint32_t late_total;  // sum of start delays (ms)
+} TM_TaskStats;
+#endif
+
+/**
+ * @brief  Supervise scheduled tasks with SimpleTaskWDG (needs TM_TIMEBASE_SIMPLEHAL)
+ * @note   Task id = index in the TM_SchedulerInit() table. A task that starts
+ *         more than TM_WATCHDOG_MARGIN_MS after its deadline stops the
+ *         hardware watchdog feed; a task that never returns is recorded as
+ *         running. Call TaskWDG_InitIWDG()/TaskWDG_InitWWDG() first and keep
+ *         the idle hook sleep shorter than the hardware timeout.
+ */
+#ifndef TM_WATCHDOG
+#define TM_WATCHDOG 0
+#endif
+
+#if TM_WATCHDOG
+#if !TM_TIMEBASE_SIMPLEHAL
+#error "TM_WATCHDOG requires TM_TIMEBASE_SIMPLEHAL=1"
+#endif
+#include "SimpleTaskWDG.h"
+
+#ifndef TM_WATCHDOG_MARGIN_MS
+#define TM_WATCHDOG_MARGIN_MS 100
+#endif
+#endif
+
+typedef void (*TM_TaskFn)(void *ctx);
+
+/**
+ * @brief  Task table entry
+ * @note   Fill period/offset/priority/fn/ctx (TM_TASK), the rest is
+ *         owned by the scheduler.
+ */
+typedef struct {
+  uint32_t period;   // ms between runs, 0 = one-shot
+  uint32_t offset;   // ms from TM_SchedulerInit() to the first run
+  uint8_t priority;  // lower runs first when deadlines tie
+  TM_TaskFn fn;
+  void *ctx;
+
+  uint32_t due;      // next deadline (millis)
+  uint8_t slot;      // heap position, 0xFF = not scheduled
+  uint8_t policy;    // TM_Policy for periodic tasks
+  uint16_t missed;   // periods dropped by the overrun policy
+#if TM_PROFILE
+  TM_TaskStats stats;
+#endif
+} TM_Task;
+
+/**
+ * @brief  Static initializer for a task table entry
+ */
+#define TM_TASK(period, offset, priority, fn, ctx)                             \
+  { (period), (offset), (priority), (fn), (ctx), 0, 0xFF, TM_PERIOD_DRIFT, 0 }
+
+/**
+ * @brief  Task entry that stays on its period grid (no drift)
+ * @param  policy: Overrun policy (TM_PERIOD_SKIP / CATCHUP / RESYNC)
+ *
+ * @example
+ *   TM_TASK_FIXED(10, 0, 0, TM_PERIOD_CATCHUP, control_loop, &pid)
+ */
+#define TM_TASK_FIXED(period, offset, priority, policy, fn, ctx)               \
+  { (period), (offset), (priority), (fn), (ctx), 0, 0xFF, (policy), 0 }
+
+/**
+ * @brief  Load a static task table and schedule every entry
+ * @param  table: Task array (must stay valid)
+ * @param  count: Number of entries (<= TM_MAX_TASKS)
+ *
+ * @example
+ *   static TM_Task tasks[] = {
+ *     TM_TASK(1000, 0,  1, blink, NULL),
+ *     TM_TASK(100,  50, 0, read_adc, &adc),   // staggered by 50 ms
+ *   };
+ *   TM_SchedulerInit(tasks, 2);
+ *   TM_SetIdleHook(sleep_until);
+ *   while (1) TM_Run();
+ */
+void TM_SchedulerInit(TM_Task *table, uint8_t count);
+
+/**
+ * @brief  Run every task that is due (earliest deadline first)
+ * @return ms until the next deadline, TM_NO_DEADLINE if nothing is scheduled
+ * @note   Selection is O(log n) through a binary heap keyed on deadline
+ */
+uint32_t TM_RunPending(void);
+
+/**
+ * @brief  One scheduler pass: TM_RunPending() then the idle hook
+ * @note   The idle hook is only called when the next deadline is in the future
+ * @note   TM_TIMEBASE_SIMPLEHAL = 1: SimpleHAL_IdleHook runs first, at the same point
+ */
+void TM_Run(void);
+
+/**
+ * @brief  Install the idle hook
+ * @param  hook: Receives ms until the next deadline (TM_NO_DEADLINE = none),
+ *               e.g. to sleep until then instead of spinning
+ */
+void TM_SetIdleHook(void (*hook)(uint32_t ms_to_next));
+
+/**
+ * @brief  (Re)schedule a task to run after delay_ms
+ */
+void TM_TaskStart(TM_Task *task, uint32_t delay_ms);
+
+/**
+ * @brief  Remove a task from the schedule (it stays in the table)
+ */
+void TM_TaskStop(TM_Task *task);
+
+/**
+ * @brief  Check if a task is scheduled
+ */
+#define TM_TaskActive(task) ((task)->slot != 0xFF)
+
+/**
+ * @brief  Task currently being run by TM_RunPending (NULL outside a task)
+ */
+TM_Task *TM_Current(void);
+
+/**
+ * @brief  Delay the next run of the current task by ms (overrides period once)
+ */
+void TM_Delay(uint32_t ms);
+
+#if TM_PROFILE
+/**
+ * @brief  Clear all task statistics and restart the CPU load window
+ */
+void TM_ResetStats(void);
+
+/**
+ * @brief  Time spent in tasks since the last reset, in 0.1 % units
+ * @note   The window is sampled on every TM_RunPending(); with the default
+ *         SysTick source call it at least every ~11 minutes (CNT wraps)
+ */
+uint16_t TM_CpuLoad_x10(void);
+
+/**
+ * @brief  Print per-task statistics with printf (USART_Printf_Init first)
+ *
+ * @example
+ *   RUN_EVERY(10000) { TM_DumpStats(); TM_ResetStats(); }
+ *   // task  runs  avg_us  max_us  late_avg  late_max
+ *   //    0    10      12      15         0         1
+ *   //    1   100     410     980         2        12
+ *   // cpu 4.1%
+ */
+void TM_DumpStats(void);
+#endif
+
+/* ========== Coroutines (protothreads) ========== */
+
+/**
+ * @brief  Coroutine state: resume line, 0 = start (2 bytes per task)
+ *
+ * @note   Switch-based: locals do not survive a wait (keep them in ctx or
+ *         static), the body must not contain its own switch statement and
+ *         each wait must be on its own source line.
+ * @note   Runs inside a scheduler task. Waits return to the scheduler;
+ *         TASK_WAIT_MS reschedules the task, TASK_YIELD/TASK_WAIT_UNTIL
+ *         resume on the task's next periodic run (period = poll rate).
+ *
+ * @example
+ *   static TM_Coroutine ds_co;
+ *   static void ds18b20_task(void *ctx) {
+ *     TASK_BEGIN(&ds_co);
+ *     Sensor_StartConversion();
+ *     TASK_WAIT_MS(&ds_co, 750);
+ *     temperature = Sensor_Read();
+ *     TASK_WAIT_UNTIL(&ds_co, uart_ready());
+ *     Send(temperature);
+ *     TASK_END(&ds_co);   // restart from TASK_BEGIN on the next run
+ *   }
+ *   static TM_Task tasks[] = { TM_TASK(5000, 0, 0, ds18b20_task, NULL) };
+ */
+typedef uint16_t TM_Coroutine;
+
+#define TASK_BEGIN(co)                                                         \
+  switch (*(co)) {                                                             \
+  case 0:
+
+#define TASK_YIELD(co)                                                         \
+  do {                                                                         \
+    *(co) = __LINE__;                                                          \
+    return;                                                                    \
+  case __LINE__:;                                                              \
+  } while (0)
+
+#define TASK_WAIT_UNTIL(co, cond)                                              \
+  do {                                                                         \
+    *(co) = __LINE__;                                                          \
+    __attribute__((fallthrough));                                              \
+  case __LINE__:                                                               \
+    if (!(cond))                                                               \
+      return;                                                                  \
+  } while (0)
+
+#define TASK_WAIT_MS(co, ms)                                                   \
+  do {                                                                         \
+    TM_Delay(ms);                                                              \
+    TASK_YIELD(co);                                                            \
+  } while (0)
+
+/**
+ * @brief  Leave the coroutine early; the next run starts from TASK_BEGIN
+ */
+#define TASK_EXIT(co)                                                          \
+  do {                                                                         \
+    *(co) = 0;                                                                 \
+    return;                                                                    \
+  } while (0)
+
+#define TASK_END(co)                                                           \
+  }                                                                            \
+  *(co) = 0
+
 #endif